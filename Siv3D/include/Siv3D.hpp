@@ -174,6 +174,9 @@
 // kd 木 | kd-tree
 # include <Siv3D/KDTree.hpp>
 
+// 動的 kd 木 | Dynamic kd-tree
+# include <Siv3D/DynamicKDTree.hpp>
+
 // Disjoint-set (Union-find) | Disjoint-set (Union–find)
 # include <Siv3D/DisjointSet.hpp>
 
@@ -348,6 +351,12 @@
 // プロファイラー | Profiler
 # include <Siv3D/Profiler.hpp>
 
+// プロファイラーのゾーン | Profiler zone
+# include <Siv3D/ProfilerZone.hpp>
+
+// フレーム時間の分布 | Frame time histogram
+# include <Siv3D/FrameTimeHistogram.hpp>
+
 // 処理にかかった時間の測定 | Clock counter in milliseconds
 # include <Siv3D/MillisecClock.hpp>
 
@@ -474,6 +483,9 @@
 // CSV データの読み書き | CSV reader/writer
 # include <Siv3D/CSV.hpp>
 
+// メモリマップトファイル上の CSV の列ごとの読み込み | Memory-mapped columnar CSV reader
+# include <Siv3D/CSVTable.hpp>
+
 // INI データの読み書き | INI reader/writer
 # include <Siv3D/INI.hpp>
 
@@ -510,6 +522,9 @@
 // ロガー | Logger
 # include <Siv3D/Logger.hpp>
 
+// エンジンのトレース | Engine trace
+# include <Siv3D/EngineTrace.hpp>
+
 // ライセンス情報 | License information
 # include <Siv3D/LicenseInfo.hpp>
 
@@ -1128,12 +1143,18 @@
 // ボックスフィルタ | Box filter
 # include <Siv3D/BoxFilterSize.hpp>
 
+// ミップマップ生成の設定 | Mipmap generation config
+# include <Siv3D/MipmapConfig.hpp>
+
 // 画像 | Image
 # include <Siv3D/Image.hpp>
 
 // 追加の画像処理 | Extra image processing
 # include <Siv3D/ImageProcessing.hpp>
 
+// 画像のピクセル処理のパイプライン | Image pixel operation pipeline
+# include <Siv3D/ImageOps.hpp>
+
 // カスケード分類器 | Cascade classifier
 # include <Siv3D/CascadeClassifier.hpp>
 
@@ -1268,6 +1289,7 @@
 
 # include <Siv3D/AudioFormat.hpp>
 # include <Siv3D/IAudioDecoder.hpp>
+# include <Siv3D/IAudioStreamDecoder.hpp>
 # include <Siv3D/IAudioEncoder.hpp>
 # include <Siv3D/AudioDecoder.hpp>
 # include <Siv3D/AudioEncoder.hpp>
@@ -1417,6 +1439,8 @@
 
 # include <Siv3D/Asset.hpp>
 
+# include <Siv3D/AssetLoader.hpp>
+
 # include <Siv3D/AudioAssetData.hpp>
 
 # include <Siv3D/AudioAsset.hpp>
@@ -1623,6 +1647,7 @@
 # include <Siv3D/FontStyle.hpp>
 # include <Siv3D/GlyphInfo.hpp>
 # include <Siv3D/GlyphCluster.hpp>
+# include <Siv3D/GlyphCacheStats.hpp>
 # include <Siv3D/OutlineGlyph.hpp>
 # include <Siv3D/BitmapGlyph.hpp>
 # include <Siv3D/PolygonGlyph.hpp>
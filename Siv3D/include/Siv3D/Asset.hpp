@@ -10,11 +10,13 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
 # include "Common.hpp"
 # include "String.hpp"
 # include "Array.hpp"
 # include "AssetState.hpp"
 # include "AssetInfo.hpp"
+# include "AsyncTask.hpp"
 
 namespace s3d
 {
@@ -48,6 +50,29 @@ namespace s3d
 		[[nodiscard]]
 		bool isFinished() const;
 
+		/// @brief 非同期ロードの優先度を返します。
+		/// @return 非同期ロードの優先度。値が大きいほど先にロードされます。
+		[[nodiscard]]
+		int32 getLoadPriority() const;
+
+		/// @brief 非同期ロードの優先度を設定します。
+		/// @param priority 非同期ロードの優先度。値が大きいほど先にロードされます。
+		/// @remark ロード待ちに入る前に設定する必要があります。
+		void setLoadPriority(int32 priority);
+
+		/// @brief アセットの作成に使われるファイルの一覧を返します。
+		/// @return ファイルの一覧。ファイルから作成されないアセットの場合は空の配列
+		/// @remark ホットリロードが有効な場合、これらのファイルの変更を監視します。
+		[[nodiscard]]
+		virtual Array<FilePath> getSourcePaths() const;
+
+		/// @brief アセットを別のインスタンスに再ロードし、差し替える関数を返します。
+		/// @param hint ヒント
+		/// @return 再ロードに成功した場合はアセットを差し替える関数、それ以外の場合は空の関数
+		/// @remark ホットリロードの際に非同期ロードのスレッドから呼ばれます。返された関数はメインスレッドで呼ばれます。
+		[[nodiscard]]
+		virtual std::function<void()> prepareReload(const String& hint);
+
 	protected:
 
 		[[nodiscard]]
@@ -58,6 +83,25 @@ namespace s3d
 
 		void setState(AssetState state);
 
+		/// @brief アセットをこの場でロードします。
+		/// @param task 非同期ロードのタスク
+		/// @param load ロード処理。成功した場合 true を返します。
+		/// @return ロード済みである場合 true, それ以外の場合は false
+		/// @remark ロード待ちの非同期ロードは取り消して、この場でロードします。実行中の非同期ロードは完了を待ちます。
+		bool loadImpl(AsyncTask<void>& task, const std::function<bool()>& load);
+
+		/// @brief アセットの非同期ロードを要求します。
+		/// @param task 非同期ロードのタスクの格納先
+		/// @param load ロード処理。成功した場合 true を返します。
+		/// @remark ロード開始前に取り消された場合、アセットは未ロードの状態に戻ります。
+		void loadAsyncImpl(AsyncTask<void>& task, std::function<bool()> load);
+
+		/// @brief アセットを解放します。
+		/// @param task 非同期ロードのタスク
+		/// @param release 解放処理
+		/// @remark ロード待ちの非同期ロードは取り消し、実行中の非同期ロードは完了を待ってから解放します。
+		void releaseImpl(AsyncTask<void>& task, const std::function<void()>& release);
+
 	private:
 
 		class IAssetDetail;
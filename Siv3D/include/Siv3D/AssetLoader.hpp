@@ -0,0 +1,93 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "StringView.hpp"
+
+namespace s3d
+{
+	/// @brief アセットの非同期ロードの進捗
+	struct AssetLoadProgress
+	{
+		/// @brief ロード待ちのアセットの数
+		size_t queued = 0;
+
+		/// @brief ロード中のアセットの数
+		size_t loading = 0;
+
+		/// @brief ロードに成功したアセットの数
+		size_t succeeded = 0;
+
+		/// @brief ロードに失敗したアセットの数
+		size_t failed = 0;
+
+		/// @brief ロード開始前に取り消されたアセットの数
+		size_t canceled = 0;
+
+		/// @brief ロード待ち・ロード中のアセットが無いかを返します。
+		/// @return ロード待ち・ロード中のアセットが無い場合 true, それ以外の場合は false
+		[[nodiscard]]
+		constexpr bool isDone() const noexcept
+		{
+			return ((queued == 0) && (loading == 0));
+		}
+
+		/// @brief ロードが（成否にかかわらず）完了した割合を返します。
+		/// @return ロードが完了した割合 [0.0, 1.0]
+		[[nodiscard]]
+		constexpr double progress() const noexcept
+		{
+			const size_t finished = (succeeded + failed);
+			const size_t total = (queued + loading + finished);
+			return ((total == 0) ? 1.0 : (static_cast<double>(finished) / total));
+		}
+	};
+
+	namespace AssetLoader
+	{
+		/// @brief 非同期ロードを同時に実行するスレッドの最大数を設定します。
+		/// @param maxConcurrency 同時に実行するスレッドの最大数
+		/// @remark ファイルハンドルやデコード後のデータが同時に保持される量の上限になります。
+		void SetMaxConcurrency(size_t maxConcurrency);
+
+		/// @brief 非同期ロードを同時に実行するスレッドの最大数を返します。
+		/// @return 同時に実行するスレッドの最大数
+		[[nodiscard]]
+		size_t GetMaxConcurrency();
+
+		/// @brief 非同期ロードの進捗を返します。
+		/// @return 非同期ロードの進捗
+		[[nodiscard]]
+		AssetLoadProgress GetProgress();
+
+		/// @brief 非同期ロードの進捗の累計（成功・失敗・取り消し）を 0 にリセットします。
+		void ResetProgress();
+
+		/// @brief ロード待ちのすべての非同期ロードを取り消します。
+		/// @remark 取り消されたアセットは未ロードの状態に戻ります。実行中のロードは取り消されません。
+		void CancelAll();
+
+		/// @brief アセットのホットリロードを有効にします。
+		/// @param directory 監視するディレクトリ
+		/// @return 監視を開始できた場合 true, それ以外の場合は false
+		/// @remark ディレクトリ内のファイルが変更されると、そのファイルから作成されたロード済みのアセットを非同期で再ロードし、完了後のフレームで差し替えます。複数のディレクトリを監視できます。
+		bool EnableHotReload(FilePathView directory);
+
+		/// @brief アセットのホットリロードを無効にし、すべてのディレクトリの監視を終了します。
+		void DisableHotReload();
+
+		/// @brief アセットのホットリロードが有効であるかを返します。
+		/// @return ホットリロードが有効である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsHotReloadEnabled();
+	}
+}
@@ -27,13 +27,13 @@ namespace s3d
 
 	namespace SimpleHTTP
 	{
-		AsyncHTTPTask GetAsync(URLView url, const HashTable<String, String>& headers, FilePathView filePath);
+		AsyncHTTPTask GetAsync(URLView url, const HashTable<String, String>& headers, FilePathView filePath, int32 priority = 0);
 
-		AsyncHTTPTask GetAsync(URLView url, const HashTable<String, String>& headers);
+		AsyncHTTPTask GetAsync(URLView url, const HashTable<String, String>& headers, int32 priority = 0);
 
-		AsyncHTTPTask PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView filePath);
+		AsyncHTTPTask PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView filePath, int32 priority = 0);
 
-		AsyncHTTPTask PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size);
+		AsyncHTTPTask PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, int32 priority = 0);
 	}
 
 # if SIV3D_PLATFORM(WEB)
@@ -144,21 +144,21 @@ namespace s3d
 
 	private:
 
-		AsyncHTTPTask(URLView url, const HashTable<String, String>& headers, FilePathView path);
+		AsyncHTTPTask(URLView url, const HashTable<String, String>& headers, FilePathView path, int32 priority);
 
-		AsyncHTTPTask(URLView url, const HashTable<String, String>& headers);
+		AsyncHTTPTask(URLView url, const HashTable<String, String>& headers, int32 priority);
 
-		AsyncHTTPTask(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView path);
+		AsyncHTTPTask(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView path, int32 priority);
 
-		AsyncHTTPTask(URLView url, const HashTable<String, String>& headers, const void* src, size_t size);
+		AsyncHTTPTask(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, int32 priority);
 
-		friend AsyncHTTPTask SimpleHTTP::GetAsync(URLView url, const HashTable<String, String>& headers, FilePathView filePath);
+		friend AsyncHTTPTask SimpleHTTP::GetAsync(URLView url, const HashTable<String, String>& headers, FilePathView filePath, int32 priority);
 
-		friend AsyncHTTPTask SimpleHTTP::GetAsync(URLView url, const HashTable<String, String>& headers);
+		friend AsyncHTTPTask SimpleHTTP::GetAsync(URLView url, const HashTable<String, String>& headers, int32 priority);
 
-		friend AsyncHTTPTask SimpleHTTP::PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView filePath);
+		friend AsyncHTTPTask SimpleHTTP::PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView filePath, int32 priority);
 
-		friend AsyncHTTPTask SimpleHTTP::PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size);
+		friend AsyncHTTPTask SimpleHTTP::PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, int32 priority);
 
 	# if SIV3D_PLATFORM(WEB)
 		friend AsyncTask<HTTPResponse> Platform::Web::SimpleHTTP::CreateAsyncTask(AsyncHTTPTask& httpTask);
@@ -82,7 +82,9 @@ namespace s3d
 
 		static bool Load(AssetNameView name);
 
-		static void LoadAsync(AssetNameView name);
+		static void LoadAsync(AssetNameView name, int32 priority = 0);
+
+		static void LoadAsyncByTag(const AssetTag& tag, int32 priority = 0);
 
 		static void Wait(AssetNameView name);
 
@@ -66,6 +66,12 @@ namespace s3d
 
 		void release() override;
 
+		[[nodiscard]]
+		Array<FilePath> getSourcePaths() const override;
+
+		[[nodiscard]]
+		std::function<void()> prepareReload(const String& hint) override;
+
 		static bool DefaultLoad(AudioAssetData& asset, const String& hint);
 
 		static void DefaultRelease(AudioAssetData& asset);
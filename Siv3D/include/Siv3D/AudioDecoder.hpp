@@ -53,6 +53,13 @@ namespace s3d
 		[[nodiscard]]
 		Wave Decode(IReader& reader, StringView decoderName);
 
+		/// @brief 音声ファイルを少しずつデコードするストリームを作成します。
+		/// @param path 音声ファイルのパス
+		/// @param audioFormat 音声のフォーマット。不明の場合は `AudioFormat::Unknown`
+		/// @return 作成したストリーム。ファイルが開けないか、デコーダがストリーミングに対応しない場合は nullptr
+		[[nodiscard]]
+		std::unique_ptr<IAudioStreamDecoder> CreateStreamDecoder(FilePathView path, AudioFormat audioFormat = AudioFormat::Unknown);
+
 		/// @brief エンジンに新しいカスタム音声デコーダを追加します。
 		/// @param decoder 追加するデコーダ
 		/// @return 追加に成功した場合 true, それ以外の場合は false
@@ -54,6 +54,12 @@ namespace s3d
 		[[nodiscard]]
 		Wave decode(IReader& reader, FilePathView pathHint = {}) const override;
 
+		/// @brief Ogg Vorbis 形式の音声データを少しずつデコードするストリームを作成します。
+		/// @param reader 音声データの IReader インタフェース
+		/// @return 作成したストリーム。データが不正な場合は nullptr
+		[[nodiscard]]
+		std::unique_ptr<IAudioStreamDecoder> createStreamDecoder(std::unique_ptr<IReader>&& reader) const override;
+
 		/// @brief Ogg Vorbis 形式の音声ファイルから LOOPSTART / LOOPLENGTH タグの情報を取得します。
 		/// @param path 音声ファイルのパス
 		/// @return ループの情報
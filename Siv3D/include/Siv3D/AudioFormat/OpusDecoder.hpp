@@ -52,5 +52,11 @@ namespace s3d
 		/// @return 作成した Wave
 		[[nodiscard]]
 		Wave decode(IReader& reader, FilePathView pathHint = {}) const override;
+
+		/// @brief Opus 形式の音声データを少しずつデコードするストリームを作成します。
+		/// @param reader 音声データの IReader インタフェース
+		/// @return 作成したストリーム。データが不正な場合は nullptr
+		[[nodiscard]]
+		std::unique_ptr<IAudioStreamDecoder> createStreamDecoder(std::unique_ptr<IReader>&& reader) const override;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,205 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <string_view>
+# include "Common.hpp"
+# include "String.hpp"
+# include "Array.hpp"
+# include "Optional.hpp"
+# include "PredefinedYesNo.hpp"
+# include "MemoryMappedFileView.hpp"
+
+namespace s3d
+{
+	/// @brief メモリマップトファイル上の CSV を列ごとに参照するテーブル
+	/// @remark UTF-8 の CSV ファイルに対応します。セルの値はファイルの内容を直接参照し、値の変換はアクセス時に行います。
+	/// @remark 大きなファイルはスレッドプールを使って並列に解析されます。クオートで囲まれたセル内の改行にも対応します。
+	class CSVTable
+	{
+	public:
+
+		class Column;
+
+		SIV3D_NODISCARD_CXX20
+		CSVTable() = default;
+
+		/// @brief CSV ファイルを開きます。
+		/// @param path ファイルパス
+		/// @param hasHeader 先頭の行を列名として扱う場合 `HasHeader::Yes`
+		/// @param separator 要素のセパレータ（ASCII 文字）
+		/// @param quote クオーテーション記号（ASCII 文字）
+		/// @param escape エスケープ記号（ASCII 文字）。quote と同じ場合、クオート内の 2 連続のクオーテーション記号をエスケープとして扱います。
+		SIV3D_NODISCARD_CXX20
+		explicit CSVTable(FilePathView path, HasHeader hasHeader = HasHeader::No, char32 separator = U',', char32 quote = U'\"', char32 escape = U'\\');
+
+		/// @brief CSV ファイルを開きます。
+		/// @param path ファイルパス
+		/// @param hasHeader 先頭の行を列名として扱う場合 `HasHeader::Yes`
+		/// @param separator 要素のセパレータ（ASCII 文字）
+		/// @param quote クオーテーション記号（ASCII 文字）
+		/// @param escape エスケープ記号（ASCII 文字）。quote と同じ場合、クオート内の 2 連続のクオーテーション記号をエスケープとして扱います。
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		bool load(FilePathView path, HasHeader hasHeader = HasHeader::No, char32 separator = U',', char32 quote = U'\"', char32 escape = U'\\');
+
+		void clear() noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief 行数を返します。列名の行は含みません。
+		/// @return 行数
+		[[nodiscard]]
+		size_t rows() const noexcept;
+
+		/// @brief 列数（最も要素が多い行の要素数）を返します。
+		/// @return 列数
+		[[nodiscard]]
+		size_t columns() const noexcept;
+
+		/// @brief 指定した行の要素数を返します。
+		/// @param row 行
+		/// @return 指定した行の要素数
+		[[nodiscard]]
+		size_t columns(size_t row) const noexcept;
+
+		/// @brief 列名の一覧を返します。
+		/// @return 列名の一覧。`HasHeader::No` で読み込んだ場合は空
+		[[nodiscard]]
+		const Array<String>& columnNames() const noexcept;
+
+		/// @brief 指定した名前の列のインデックスを返します。
+		/// @param name 列名
+		/// @return 列のインデックス。見つからない場合は none
+		[[nodiscard]]
+		Optional<size_t> findColumn(StringView name) const noexcept;
+
+		/// @brief 指定した列を返します。
+		/// @param column 列
+		/// @return 列
+		[[nodiscard]]
+		Column column(size_t column) const;
+
+		/// @brief 指定した位置のセルの UTF-8 文字列を、ファイルの内容を参照する形で返します。
+		/// @param row 行
+		/// @param column 列
+		/// @return セルの UTF-8 文字列。セルを囲むクオーテーション記号は含まず、エスケープは処理されません。
+		[[nodiscard]]
+		std::string_view getView(size_t row, size_t column) const noexcept;
+
+		/// @brief 指定した位置のセルの文字列を返します。
+		/// @param row 行
+		/// @param column 列
+		/// @return セルの文字列。範囲外の場合は空の文字列
+		[[nodiscard]]
+		String getString(size_t row, size_t column) const;
+
+		/// @brief 指定した位置のセルを整数として読み取ります。
+		/// @param row 行
+		/// @param column 列
+		/// @return 読み取った値。失敗した場合は none
+		[[nodiscard]]
+		Optional<int64> getInt64(size_t row, size_t column) const;
+
+		/// @brief 指定した位置のセルを浮動小数点数として読み取ります。
+		/// @param row 行
+		/// @param column 列
+		/// @return 読み取った値。失敗した場合は none
+		[[nodiscard]]
+		Optional<double> getDouble(size_t row, size_t column) const;
+
+		/// @brief CSV の列
+		class Column
+		{
+		public:
+
+			SIV3D_NODISCARD_CXX20
+			Column() = default;
+
+			[[nodiscard]]
+			size_t size() const noexcept;
+
+			[[nodiscard]]
+			std::string_view getView(size_t row) const noexcept;
+
+			[[nodiscard]]
+			String getString(size_t row) const;
+
+			[[nodiscard]]
+			Optional<int64> getInt64(size_t row) const;
+
+			[[nodiscard]]
+			Optional<double> getDouble(size_t row) const;
+
+			/// @brief 列のすべてのセルを整数として読み取ります。
+			/// @param defaultValue 読み取りに失敗したセルの値
+			/// @return 読み取った値の配列
+			[[nodiscard]]
+			Array<int64> parseInt64(int64 defaultValue = 0) const;
+
+			/// @brief 列のすべてのセルを浮動小数点数として読み取ります。
+			/// @param defaultValue 読み取りに失敗したセルの値
+			/// @return 読み取った値の配列
+			[[nodiscard]]
+			Array<double> parseDouble(double defaultValue = 0.0) const;
+
+		private:
+
+			friend CSVTable;
+
+			const CSVTable* m_table = nullptr;
+
+			size_t m_column = 0;
+
+			SIV3D_NODISCARD_CXX20
+			Column(const CSVTable* table, size_t column) noexcept;
+		};
+
+	private:
+
+		struct Cell
+		{
+			/// @brief ファイル先頭からのオフセット
+			uint64 offset = 0;
+
+			uint32 length = 0;
+
+			/// @brief セルの状態を表すフラグ
+			uint32 flags = 0;
+		};
+
+		MemoryMappedFileView m_file;
+
+		/// @brief 列ごとのセル
+		Array<Array<Cell>> m_columns;
+
+		/// @brief 行ごとの要素数
+		Array<uint32> m_rowColumns;
+
+		Array<String> m_columnNames;
+
+		char m_quote = '\"';
+
+		char m_escape = '\\';
+
+		[[nodiscard]]
+		const Cell* getCell(size_t row, size_t column) const noexcept;
+
+		[[nodiscard]]
+		std::string_view getView(const Cell& cell) const noexcept;
+
+		[[nodiscard]]
+		String decode(const Cell& cell) const;
+	};
+}
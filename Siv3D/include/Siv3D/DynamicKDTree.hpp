@@ -0,0 +1,236 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "KDTree.hpp"
+
+namespace s3d
+{
+	/// @brief 要素の追加・削除・移動に対応する kd-tree
+	/// @tparam DatasetAdapter kd-tree 用のアダプタ型
+	/// @remark 各ノードは子孫の要素を囲む AABB を持ちます。要素が移動した場合は `update()` または `refit()` で、ツリーを再構築せずに追従できます。
+	/// @remark 変更の累計がツリーの構築時の要素数を超えると、自動で再構築されます。
+	template <class DatasetAdapter>
+	class DynamicKDTree
+	{
+	public:
+
+		using point_type	= typename DatasetAdapter::point_type;
+
+		using element_type	= typename DatasetAdapter::element_type;
+
+		using dataset_type	= typename DatasetAdapter::dataset_type;
+
+		static constexpr int32 Dimensions = DatasetAdapter::Dimensions;
+
+		/// @brief `knnSearchAll()` で、見つからなかった要素に格納されるインデックス
+		static constexpr size_t InvalidIndex = static_cast<size_t>(-1);
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		DynamicKDTree() = default;
+
+		/// @brief データセットのすべての要素を含む kd-tree を構築します。
+		/// @param dataset データセット
+		/// @remark データセットは kd-tree より長く存在する必要があります。
+		SIV3D_NODISCARD_CXX20
+		explicit DynamicKDTree(const dataset_type& dataset);
+
+		/// @brief 現在含まれている要素から、ツリーを再構築します。
+		void rebuildIndex();
+
+		/// @brief データセットの要素をツリーに追加します。
+		/// @param index 追加する要素のインデックス
+		/// @remark すでに含まれている場合は何もしません。
+		void insert(size_t index);
+
+		/// @brief 要素をツリーから削除します。
+		/// @param index 削除する要素のインデックス
+		/// @remark データセットから要素を削除する必要はありません。
+		void remove(size_t index);
+
+		/// @brief 座標が変更された要素をツリーに反映します。
+		/// @param index 座標が変更された要素のインデックス
+		void update(size_t index);
+
+		/// @brief すべての要素の座標が変更されたときに、ノードの AABB を計算し直します。
+		/// @remark 多くの要素が移動した場合、要素ごとに `update()` を呼ぶよりも高速です。計算量は O(n) です。
+		void refit();
+
+		/// @brief 要素がツリーに含まれているかを返します。
+		/// @param index 要素のインデックス
+		/// @return 要素がツリーに含まれている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool contains(size_t index) const noexcept;
+
+		/// @brief ツリーに含まれている要素の個数を返します。
+		/// @return ツリーに含まれている要素の個数
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		/// @brief ツリーが空であるかを返します。
+		/// @return ツリーが空である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		/// @brief kd-tree を消去し、メモリから解放します。
+		void release();
+
+		/// @brief kd-tree が消費しているメモリのサイズ（バイト）を返します。
+		/// @return kd-tree が消費しているメモリのサイズ（バイト）
+		[[nodiscard]]
+		size_t usedMemory() const;
+
+		/// @brief 指定した座標から最も近い k 個の要素を検索して返します。
+		/// @param k 検索する個数
+		/// @param point 座標
+		/// @return 見つかった要素一覧
+		[[nodiscard]]
+		Array<size_t> knnSearch(size_t k, const point_type& point) const;
+
+		/// @brief 指定した座標から最も近い k 個の要素を検索して取得します。
+		/// @param results 結果を格納する配列
+		/// @param k 検索する個数
+		/// @param point 中心座標
+		void knnSearch(Array<size_t>& results, size_t k, const point_type& point) const;
+
+		/// @brief 指定した座標から最も近い k 個の要素を検索して取得します。
+		/// @param results 結果を格納する配列
+		/// @param distanceSqResults それぞれの要素について、中心からの距離を格納する配列
+		/// @param k 検索する個数
+		/// @param point 中心座標
+		void knnSearch(Array<size_t>& results, Array<element_type>& distanceSqResults, size_t k, const point_type& point) const;
+
+		/// @brief 指定した座標から指定した半径以内にある要素一覧を検索して返します。
+		/// @param point 中心座標
+		/// @param radius 半径
+		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
+		/// @return 指定した位置から指定した半径以内にある要素一覧
+		[[nodiscard]]
+		Array<size_t> radiusSearch(const point_type& point, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+		/// @brief 指定した座標から指定した半径以内にある要素一覧を検索して取得します。
+		/// @param results 結果を格納する配列
+		/// @param point 中心座標
+		/// @param radius 半径
+		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
+		void radiusSearch(Array<size_t>& results, const point_type& point, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+		/// @brief 複数の座標について、それぞれ最も近い k 個の要素を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`points.size() * k` 個に resize され、i 番目の座標の結果は `[i * k, (i + 1) * k)` に近い順に格納されます。
+		/// @param k 検索する個数
+		/// @param points 中心座標の一覧
+		/// @remark 要素数が k 未満の場合、見つからなかった分には `InvalidIndex` が格納されます。
+		void knnSearchAll(Array<size_t>& results, size_t k, const Array<point_type>& points) const;
+
+		/// @brief 複数の座標について、それぞれ最も近い k 個の要素を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`points.size() * k` 個に resize され、i 番目の座標の結果は `[i * k, (i + 1) * k)` に近い順に格納されます。
+		/// @param distanceSqResults それぞれの要素について、中心からの距離の二乗を格納する配列
+		/// @param k 検索する個数
+		/// @param points 中心座標の一覧
+		/// @remark 要素数が k 未満の場合、見つからなかった分には `InvalidIndex` が格納されます。
+		void knnSearchAll(Array<size_t>& results, Array<element_type>& distanceSqResults, size_t k, const Array<point_type>& points) const;
+
+		/// @brief 複数の座標について、それぞれ指定した半径以内にある要素一覧を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`points.size()` 個に resize され、i 番目の座標の結果は `results[i]` に格納されます。
+		/// @param points 中心座標の一覧
+		/// @param radius 半径
+		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
+		/// @remark `results` の各配列は再利用されるため、毎フレーム同じ配列を渡すとメモリの確保が起こりません。
+		void radiusSearchAll(Array<Array<size_t>>& results, const Array<point_type>& points, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+	private:
+
+		using distance_type = double;
+
+		using bounds_type = std::array<element_type, Dimensions>;
+
+		/// @brief 葉ノードに格納する要素の個数の目安。葉ノードの要素数がこの 2 倍を超えると分割する
+		static constexpr size_t LeafSize = 16;
+
+		/// @brief ツリーに含まれていない要素を表す葉ノードのインデックス
+		static constexpr uint32 NotInserted = static_cast<uint32>(-1);
+
+		struct Node
+		{
+			/// @brief 子孫のすべての要素を囲む AABB
+			bounds_type boundsMin;
+
+			bounds_type boundsMax;
+
+			/// @brief 子ノードのインデックス（葉ノードの場合は 0）
+			uint32 child1 = 0;
+
+			uint32 child2 = 0;
+
+			/// @brief 要素を追加するときに子ノードを選ぶための分割軸と値
+			int32 splitDim = 0;
+
+			element_type splitValue{};
+
+			/// @brief 葉ノードに含まれる要素のインデックス
+			Array<size_t> indices;
+
+			[[nodiscard]]
+			bool isLeaf() const noexcept
+			{
+				return (child1 == 0);
+			}
+		};
+
+		const dataset_type* m_dataset = nullptr;
+
+		Array<Node> m_nodes;
+
+		/// @brief 要素が属する葉ノードのインデックス
+		Array<uint32> m_leafIndices;
+
+		size_t m_size = 0;
+
+		size_t m_sizeAtBuild = 0;
+
+		size_t m_modificationCount = 0;
+
+		[[nodiscard]]
+		element_type getElement(size_t index, size_t dim) const;
+
+		uint32 build(size_t* first, size_t* last);
+
+		void splitLeaf(uint32 nodeIndex);
+
+		void insertImpl(size_t index);
+
+		void removeImpl(size_t index);
+
+		void onModified();
+
+		void computeBounds(Node& node, const size_t* first, const size_t* last) const;
+
+		[[nodiscard]]
+		int32 chooseSplitDim(const Node& node) const;
+
+		template <class ResultSet>
+		void search(ResultSet& resultSet, const element_type* query) const;
+
+		template <class ResultSet>
+		void searchNode(ResultSet& resultSet, const element_type* query, uint32 nodeIndex) const;
+
+		[[nodiscard]]
+		static distance_type DistanceSqToBounds(const Node& node, const element_type* query) noexcept;
+
+		static void SetEmptyBounds(Node& node) noexcept;
+	};
+}
+
+# include "detail/DynamicKDTree.ipp"
@@ -15,27 +15,38 @@
 # include "StringView.hpp"
 # include "String.hpp"
 # include "FormatLiteral.hpp"
+# include "EngineTrace.hpp"
 # include "detail/EngineLog.ipp"
 
-# if SIV3D_BUILD(DEBUG)
+// ログの引数は、現在のログレベルで出力される場合にのみ評価されます。
+// LOG_TRACE, LOG_VERBOSE はリリースビルドでも無効化されず、Logger.setLogLevel() で出力できます。
 
-#	define LOG_TEST(S)		s3d::Internal::OutputEngineLog(s3d::LogType::App,		S)
-#	define LOG_ERROR(S)		s3d::Internal::OutputEngineLog(s3d::LogType::Error,		S)
-#	define LOG_FAIL(S)		s3d::Internal::OutputEngineLog(s3d::LogType::Fail,		S)
-#	define LOG_WARNING(S)	s3d::Internal::OutputEngineLog(s3d::LogType::Warning,	S)
-#	define LOG_INFO(S)		s3d::Internal::OutputEngineLog(s3d::LogType::Info,		S)
-#	define LOG_TRACE(S)		s3d::Internal::OutputEngineLog(s3d::LogType::Trace,		S)
-#	define LOG_VERBOSE(S)	s3d::Internal::OutputEngineLog(s3d::LogType::Verbose,	S)
-#	define LOG_SCOPED_TRACE(S)	const s3d::Internal::ScopedEngineLog s3d_scoped_trace{s3d::LogType::Trace, S}
+# define SIV3D_PRIVATE_ENGINE_LOG(TYPE, S) (s3d::Internal::IsEngineLogEnabled(TYPE) ? s3d::Internal::OutputEngineLog(TYPE, S) : void())
 
-# else
+# if SIV3D_BUILD(DEBUG)
+#	define LOG_TEST(S)		SIV3D_PRIVATE_ENGINE_LOG(s3d::LogType::App,		S)
+# endif
 
-#	define LOG_ERROR(S)		s3d::Internal::OutputEngineLog(s3d::LogType::Error,		S)
-#	define LOG_FAIL(S)		s3d::Internal::OutputEngineLog(s3d::LogType::Fail,		S)
-#	define LOG_WARNING(S)	s3d::Internal::OutputEngineLog(s3d::LogType::Warning,	S)
-#	define LOG_INFO(S)		s3d::Internal::OutputEngineLog(s3d::LogType::Info,		S)
-#	define LOG_TRACE(S)		((void)0)
-#	define LOG_VERBOSE(S)	((void)0)
-#	define LOG_SCOPED_TRACE(S)	((void)0)
+# define LOG_ERROR(S)		SIV3D_PRIVATE_ENGINE_LOG(s3d::LogType::Error,	S)
+# define LOG_FAIL(S)		SIV3D_PRIVATE_ENGINE_LOG(s3d::LogType::Fail,	S)
+# define LOG_WARNING(S)		SIV3D_PRIVATE_ENGINE_LOG(s3d::LogType::Warning,	S)
+# define LOG_INFO(S)		SIV3D_PRIVATE_ENGINE_LOG(s3d::LogType::Info,	S)
+# define LOG_TRACE(S)		SIV3D_PRIVATE_ENGINE_LOG(s3d::LogType::Trace,	S)
+# define LOG_VERBOSE(S)		SIV3D_PRIVATE_ENGINE_LOG(s3d::LogType::Verbose,	S)
+# define LOG_SCOPED_TRACE(S)	const s3d::Internal::ScopedEngineLog s3d_scoped_trace{ s3d::LogType::Trace, (s3d::Internal::IsEngineLogEnabled(s3d::LogType::Trace) ? s3d::String{ S } : s3d::String{}) }
 
-# endif
+/// @brief 書式と数値の引数を記録します。
+/// @remark トレースのログが出力される場合は LOG_TRACE と同様に整形して出力し、EngineTrace が有効な場合は文字列を作らずに、イベントの ID と引数をバイナリで記録します。
+/// @remark FORMAT は `{}` を含む UTF-32 の文字列リテラル、引数は数値、bool, または void ポインタである必要があります。
+# define LOG_TRACE_EVENT(FORMAT, ...) [](const auto&... s3d_trace_args)\
+	{\
+		if (s3d::Internal::IsEngineLogEnabled(s3d::LogType::Trace))\
+		{\
+			s3d::Internal::OutputEngineLog(s3d::LogType::Trace, s3d::Fmt(FORMAT)(s3d_trace_args...));\
+		}\
+		if (s3d::EngineTrace::detail::IsEnabledFast())\
+		{\
+			static const s3d::uint16 s3d_trace_event_id = s3d::EngineTrace::detail::RegisterEvent<std::decay_t<decltype(s3d_trace_args)>...>(FORMAT, __FILE__, __LINE__);\
+			s3d::EngineTrace::detail::Record(s3d_trace_event_id, s3d_trace_args...);\
+		}\
+	}(__VA_ARGS__)
@@ -78,6 +78,18 @@ namespace s3d
 			/// @brief リファレンスドライバーを使用
 			Reference
 		};
+
+		/// @brief 非グラフィックスモードでの 2D 描画の処理方法
+		/// @remark `EngineOption::Renderer::Headless` を指定した場合にのみ有効です。
+		enum class HeadlessRenderer : uint8
+		{
+			/// @brief 描画を行わない
+			Null,
+
+			/// @brief CPU で描画する
+			/// @remark 2D 描画の結果は `ScreenCapture` や `RenderTexture::readAsImage()` で取得できます。カスタムシェーダと 3D 描画には対応していません。
+			Software,
+		};
 	};
 
 	struct EngineOptions
@@ -87,6 +99,8 @@ namespace s3d
 		EngineOption::Renderer renderer			= EngineOption::Renderer::PlatformDefault;
 
 		EngineOption::D3D11Driver d3d11Driver	= EngineOption::D3D11Driver::Hardware;
+
+		EngineOption::HeadlessRenderer headlessRenderer = EngineOption::HeadlessRenderer::Null;
 	};
 
 	namespace detail
@@ -94,6 +108,7 @@ namespace s3d
 		int SetEngineOption(EngineOption::DebugHeap) noexcept;
 		int SetEngineOption(EngineOption::Renderer) noexcept;
 		int SetEngineOption(EngineOption::D3D11Driver) noexcept;
+		int SetEngineOption(EngineOption::HeadlessRenderer) noexcept;
 	}
 
 	extern EngineOptions g_engineOptions;
@@ -0,0 +1,60 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <atomic>
+# include <cstring>
+# include <type_traits>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "String.hpp"
+
+namespace s3d
+{
+	/// @brief エンジン内部のバイナリ形式のトレース
+	/// @remark `LOG_TRACE_EVENT` で記録されたイベントは、文字列に整形されずに、イベントの ID と引数の値のみが固定長のリングバッファに記録されます。
+	/// @remark リングバッファがいっぱいになると古いイベントから上書きされるため、本番環境でも常に有効にしておくことができます。
+	/// @remark `Save()` で保存したファイルは、`Decode()` で別のプロセスから文字列に戻すことができます。
+	namespace EngineTrace
+	{
+		/// @brief 1 つのイベントに記録できる引数の最大数
+		inline constexpr size_t MaxArgs = 6;
+
+		/// @brief リングバッファに保持するイベントの数
+		inline constexpr size_t Capacity = 16384;
+
+		/// @brief イベントの記録を有効にするかを設定します。
+		/// @param enabled イベントを記録する場合 true, それ以外の場合は false
+		void SetEnabled(bool enabled) noexcept;
+
+		/// @brief イベントの記録が有効であるかを返します。
+		/// @return イベントの記録が有効である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsEnabled() noexcept;
+
+		/// @brief 記録されたイベントをすべて消去します。
+		void Clear() noexcept;
+
+		/// @brief リングバッファに残っているイベントを、登録されたイベントの書式とともにファイルに保存します。
+		/// @param path ファイルパス
+		/// @return 保存に成功した場合 true, それ以外の場合は false
+		bool Save(FilePathView path);
+
+		/// @brief `Save()` で保存したファイルを読み込み、各イベントを文字列に整形して返します。
+		/// @param path ファイルパス
+		/// @return 整形したイベントの一覧。読み込みに失敗した場合は空の配列
+		[[nodiscard]]
+		Array<String> Decode(FilePathView path);
+	}
+}
+
+# include "detail/EngineTrace.ipp"
@@ -19,6 +19,8 @@
 # include "Typeface.hpp"
 # include "TextStyle.hpp"
 # include "Glyph.hpp"
+# include "GlyphCacheStats.hpp"
+# include "AsyncTask.hpp"
 # include "PredefinedYesNo.hpp"
 
 namespace s3d
@@ -177,6 +179,24 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness() const;
 
+		/// @brief キャッシュテクスチャのページ数の上限を設定します。
+		/// @param maxPages ページ数の上限
+		/// @remark デフォルト値は 4 です。
+		/// @remark 上限に達すると、現在のフレームで描画に使われていないページのうち最も長く使われていないものを破棄して再利用します。
+		/// @remark 現在のフレームで描画に使われたページが上限を超える場合は一時的にページを追加し、次のフレーム以降に解放します。
+		/// @return *this
+		const Font& setMaxGlyphCachePages(size_t maxPages) const;
+
+		/// @brief キャッシュテクスチャのページ数の上限を返します。
+		/// @return キャッシュテクスチャのページ数の上限
+		[[nodiscard]]
+		size_t getMaxGlyphCachePages() const;
+
+		/// @brief グリフキャッシュの統計情報を返します。
+		/// @return グリフキャッシュの統計情報
+		[[nodiscard]]
+		GlyphCacheStats getGlyphCacheStats() const;
+
 		/// @brief 指定した文字のグリフを持つかを返します。
 		/// @param ch 文字
 		/// @return グリフを持つ場合 true, それ以外の場合は false
@@ -405,11 +425,25 @@ namespace s3d
 		/// @return 事前生成に成功した場合 true, それ以外の場合は false
 		bool preload(StringView chars) const;
 
+		/// @brief 指定した文字列のためのグリフを、ワーカースレッドで非同期に事前生成します。
+		/// @param chars 文字列
+		/// @remark グリフのレンダリングはワーカースレッドで並列に行われ、キャッシュテクスチャへの書き込みは、次にメインスレッドでこのフォントが使われたときに行われます。
+		/// @return 事前生成が完了すると、成功した場合 true, それ以外の場合は false を返すタスク
+		[[nodiscard]]
+		AsyncTask<bool> preloadAsync(StringView chars) const;
+
 		/// @brief フォントの内部でキャッシュされているテクスチャを返します。
+		/// @remark キャッシュテクスチャが複数のページに分かれている場合は、最初のページを返します。すべてのページを取得するには `getTexture(size_t)` を使います。
 		/// @return フォントの内部でキャッシュされているテクスチャ
 		[[nodiscard]]
 		const Texture& getTexture() const;
 
+		/// @brief フォントの内部でキャッシュされているテクスチャの、指定したページを返します。
+		/// @param page ページのインデックス。`getGlyphCacheStats().pageCount` 未満の値
+		/// @return キャッシュテクスチャのページ。ページが存在しない場合は空のテクスチャ
+		[[nodiscard]]
+		const Texture& getTexture(size_t page) const;
+
 		/// @brief 指定した文字の描画用のグリフを返します。
 		/// @param ch 文字
 		/// @return 描画用グリフ
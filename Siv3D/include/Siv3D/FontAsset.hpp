@@ -58,7 +58,9 @@ namespace s3d
 
 		static bool Load(AssetNameView name, StringView preloadText = U"");
 
-		static void LoadAsync(AssetNameView name, StringView preloadText = U"");
+		static void LoadAsync(AssetNameView name, StringView preloadText = U"", int32 priority = 0);
+
+		static void LoadAsyncByTag(const AssetTag& tag, StringView preloadText = U"", int32 priority = 0);
 
 		/// @brief 指定したフォントアセットのロードが完了するまで待機します。
 		/// @param name フォントアセット名
@@ -54,6 +54,12 @@ namespace s3d
 
 		void release() override;
 
+		[[nodiscard]]
+		Array<FilePath> getSourcePaths() const override;
+
+		[[nodiscard]]
+		std::function<void()> prepareReload(const String& hint) override;
+
 		static bool DefaultLoad(FontAssetData& asset, const String& hint);
 
 		static void DefaultRelease(FontAssetData& asset);
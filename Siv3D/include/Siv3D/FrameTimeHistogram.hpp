@@ -0,0 +1,55 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief 直近のフレームの、フレーム時間の分布
+	struct FrameTimeHistogram
+	{
+		/// @brief 集計するフレームの数
+		static constexpr size_t WindowSize = 600;
+
+		/// @brief 1 つのバケットの幅（ミリ秒）
+		static constexpr double BucketWidthMillisec = 1.0;
+
+		/// @brief バケットの数
+		/// @remark 最後のバケットには、それより長いフレームもすべて含まれます。
+		static constexpr size_t BucketCount = 100;
+
+		/// @brief 各バケットのフレーム数。`counts[i]` は、フレーム時間が [i, i + 1) ミリ秒のフレームの数です。
+		std::array<uint32, BucketCount> counts{};
+
+		/// @brief 集計したフレームの数
+		uint32 frameCount = 0;
+
+		/// @brief 最短のフレーム時間（ミリ秒）
+		double minMillisec = 0.0;
+
+		/// @brief 最長のフレーム時間（ミリ秒）
+		double maxMillisec = 0.0;
+
+		/// @brief フレーム時間の平均（ミリ秒）
+		double meanMillisec = 0.0;
+
+		/// @brief フレーム時間の中央値（ミリ秒）
+		double p50Millisec = 0.0;
+
+		/// @brief フレーム時間の 95 パーセンタイル（ミリ秒）
+		double p95Millisec = 0.0;
+
+		/// @brief フレーム時間の 99 パーセンタイル（ミリ秒）
+		double p99Millisec = 0.0;
+	};
+}
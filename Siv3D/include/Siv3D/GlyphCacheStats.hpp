@@ -0,0 +1,50 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief フォントのグリフキャッシュの統計情報 | Glyph cache statistics of a font
+	struct GlyphCacheStats
+	{
+		/// @brief キャッシュテクスチャのページ数
+		size_t pageCount = 0;
+
+		/// @brief キャッシュテクスチャのページ数の上限
+		size_t maxPageCount = 0;
+
+		/// @brief キャッシュされているグリフの数
+		size_t glyphCount = 0;
+
+		/// @brief キャッシュにグリフが見つかった回数
+		uint64 hitCount = 0;
+
+		/// @brief キャッシュにグリフが無く、新たにレンダリングした回数
+		uint64 missCount = 0;
+
+		/// @brief ページを再利用するために破棄されたページの数
+		uint64 evictionCount = 0;
+
+		/// @brief テクスチャに転送されたピクセル数の累計
+		uint64 uploadedPixels = 0;
+
+		/// @brief キャッシュのヒット率を返します。
+		/// @return キャッシュのヒット率。グリフが一度も参照されていない場合は 0.0
+		[[nodiscard]]
+		constexpr double hitRate() const noexcept
+		{
+			const uint64 total = (hitCount + missCount);
+			return (total ? (static_cast<double>(hitCount) / total) : 0.0);
+		}
+	};
+}
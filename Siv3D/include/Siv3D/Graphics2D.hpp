@@ -126,6 +126,30 @@ namespace s3d
 		/// @param count 描画する三角形の個数
 		void DrawTriangles(uint32 count);
 
+		/// @brief 複数の長方形をまとめて描画します。
+		/// @param rects 長方形の配列
+		/// @param color 色
+		/// @remark 状態の確認と描画コマンドの発行をまとめて行うため、`RectF::draw()` を繰り返し呼ぶよりも高速です。
+		void DrawRects(const Array<RectF>& rects, const ColorF& color = Palette::White);
+
+		/// @brief 複数の長方形を、それぞれの色でまとめて描画します。
+		/// @param rects 長方形の配列
+		/// @param colors 各長方形の色の配列
+		/// @remark `rects` と `colors` の要素数が異なる場合は、少ないほうに合わせます。
+		void DrawRects(const Array<RectF>& rects, const Array<ColorF>& colors);
+
+		/// @brief 複数の円をまとめて描画します。
+		/// @param circles 円の配列
+		/// @param color 色
+		/// @remark 状態の確認と描画コマンドの発行をまとめて行うため、`Circle::draw()` を繰り返し呼ぶよりも高速です。
+		void DrawCircles(const Array<Circle>& circles, const ColorF& color = Palette::White);
+
+		/// @brief 複数の円を、それぞれの色でまとめて描画します。
+		/// @param circles 円の配列
+		/// @param colors 各円の色の配列
+		/// @remark `circles` と `colors` の要素数が異なる場合は、少ないほうに合わせます。
+		void DrawCircles(const Array<Circle>& circles, const Array<ColorF>& colors);
+
 		/// @brief SDF 描画用のパラメータを設定します。
 		/// @param textStyle テキストスタイル
 		void SetSDFParameters(const TextStyle& textStyle);
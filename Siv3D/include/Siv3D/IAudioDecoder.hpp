@@ -15,6 +15,7 @@
 # include "BinaryReader.hpp"
 # include "AudioFormat.hpp"
 # include "Wave.hpp"
+# include "IAudioStreamDecoder.hpp"
 
 namespace s3d
 {
@@ -39,6 +40,13 @@ namespace s3d
 
 		[[nodiscard]]
 		virtual Wave decode(IReader& reader, FilePathView pathHint) const = 0;
+
+		/// @brief 音声データを少しずつデコードするストリームを作成します。
+		/// @param reader 音声データの IReader インタフェース。ストリームが破棄されるまで使われます。
+		/// @return 作成したストリーム。ストリーミングに対応しない場合は nullptr
+		/// @remark デフォルトの実装は nullptr を返します。
+		[[nodiscard]]
+		virtual std::unique_ptr<IAudioStreamDecoder> createStreamDecoder(std::unique_ptr<IReader>&& reader) const;
 	};
 }
 
@@ -0,0 +1,48 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Number.hpp"
+# include "Utility.hpp"
+# include "WaveSample.hpp"
+
+namespace s3d
+{
+	/// @brief 音声データを先頭から少しずつデコードするストリームのインタフェース
+	/// @remark `Audio{ Audio::Stream, path }` で、音声全体をメモリ上に展開せずに再生するために使われます。
+	struct IAudioStreamDecoder
+	{
+		virtual ~IAudioStreamDecoder() = default;
+
+		/// @brief サンプリングレートを返します。
+		/// @return サンプリングレート
+		[[nodiscard]]
+		virtual uint32 sampleRate() const = 0;
+
+		/// @brief 音声の長さ（サンプル数）を返します。
+		/// @return 音声の長さ（サンプル数）
+		[[nodiscard]]
+		virtual uint64 lengthSample() const = 0;
+
+		/// @brief 現在の位置から続きをデコードします。
+		/// @param dst 書き込み先
+		/// @param samples 書き込む最大のサンプル数
+		/// @return 書き込んだサンプル数。終端に達したか、デコードに失敗した場合は 0
+		[[nodiscard]]
+		virtual size_t read(WaveSample* dst, size_t samples) = 0;
+
+		/// @brief デコードする位置を変更します。
+		/// @param samplePos 新しい位置（サンプル）
+		/// @return 成功した場合 true, それ以外の場合は false
+		virtual bool seek(uint64 samplePos) = 0;
+	};
+}
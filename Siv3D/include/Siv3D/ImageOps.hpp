@@ -0,0 +1,133 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "Color.hpp"
+# include "PredefinedYesNo.hpp"
+
+namespace s3d
+{
+	class Image;
+	struct ImageROI;
+
+	/// @brief 画像に対するピクセル単位の処理を記録し、まとめて適用するパイプライン
+	/// @remark 記録した処理は、画像をタイルに分割して 1 回の走査で適用されます。大きな画像では複数のスレッドで並列に処理します。
+	/// @remark 連続する `negate()`, `posterize()`, `brighten()`, `gammaCorrect()` は 1 つのルックアップテーブルに合成されます。
+	/// @remark 結果は `Image` の同名のメンバ関数を順に呼んだ場合と一致します。
+	class ImageOps
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		ImageOps() = default;
+
+		/// @brief 色を反転する処理を追加します。
+		/// @return *this
+		ImageOps& negate();
+
+		/// @brief グレースケールに変換する処理を追加します。
+		/// @return *this
+		ImageOps& grayscale();
+
+		/// @brief セピア調に変換する処理を追加します。
+		/// @return *this
+		ImageOps& sepia();
+
+		/// @brief 色数を減らす処理を追加します。
+		/// @param level 各色の階調数
+		/// @return *this
+		ImageOps& posterize(int32 level);
+
+		/// @brief 明るさを変更する処理を追加します。
+		/// @param level 明るさの変化量
+		/// @return *this
+		ImageOps& brighten(int32 level);
+
+		/// @brief ガンマ補正をする処理を追加します。
+		/// @param gamma ガンマ値
+		/// @return *this
+		ImageOps& gammaCorrect(double gamma);
+
+		/// @brief 二値化する処理を追加します。
+		/// @param threshold 閾値
+		/// @param invertColor 色を反転する場合 `InvertColor::Yes`, それ以外の場合は `InvertColor::No`
+		/// @return *this
+		ImageOps& threshold(uint8 threshold, InvertColor invertColor = InvertColor::No);
+
+		/// @brief 処理が 1 つも記録されていないかを返します。
+		/// @return 処理が 1 つも記録されていない場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		/// @brief 合成後の処理の段数を返します。
+		/// @return 合成後の処理の段数
+		[[nodiscard]]
+		size_t num_stages() const noexcept;
+
+		/// @brief 記録した処理をすべて消去します。
+		void clear();
+
+		/// @brief 記録した処理を画像に適用します。
+		/// @param image 画像
+		void apply(Image& image) const;
+
+		/// @brief 記録した処理を適用した結果を、別の画像に書き込みます。
+		/// @param src 入力画像
+		/// @param dst 出力先の画像。`src` と同じサイズに変更されます。
+		/// @remark `dst` のサイズが `src` と同じか、容量が足りていればメモリの再確保は発生しません。
+		void apply(const Image& src, Image& dst) const;
+
+		/// @brief 記録した処理を画像の一部の領域に適用します。
+		/// @param roi 処理を適用する領域
+		void apply(const ImageROI& roi) const;
+
+		/// @brief 記録した処理を適用した画像を返します。
+		/// @param src 入力画像
+		/// @return 記録した処理を適用した画像
+		[[nodiscard]]
+		Image applied(const Image& src) const;
+
+	private:
+
+		enum class StageType : uint8
+		{
+			/// @brief R, G, B にルックアップテーブルを適用する
+			Table,
+
+			Grayscale,
+
+			Sepia,
+
+			Threshold,
+		};
+
+		struct Stage
+		{
+			StageType type = StageType::Table;
+
+			uint8 threshold = 0;
+
+			bool invertColor = false;
+
+			std::array<uint8, 256> table{};
+		};
+
+		Array<Stage> m_stages;
+
+		void addTable(const std::array<uint8, 256>& table);
+
+		/// @brief 連続した count 個のピクセルに、記録したすべての段を適用する
+		void applyStages(const Color* pIn, Color* pOut, size_t count) const;
+	};
+}
@@ -14,6 +14,7 @@
 # include "Array.hpp"
 # include "Image.hpp"
 # include "EdgePreservingFilterType.hpp"
+# include "MipmapConfig.hpp"
 
 namespace s3d
 {
@@ -39,6 +40,22 @@ namespace s3d
 		[[nodiscard]]
 		Array<Image> GenerateMips(const Image& src, size_t maxLevel);
 
+		/// @brief 画像から、設定に従ってミップマップ画像を作成します。
+		/// @param src 画像
+		/// @param config ミップマップ生成の設定
+		/// @return ミップマップ画像
+		[[nodiscard]]
+		Array<Image> GenerateMips(const Image& src, const MipmapConfig& config);
+
+		/// @brief 画像から、設定に従ってミップマップ画像を作成します。
+		/// @param src 画像
+		/// @param maxLevel ミップマップの最大個数（この値が 2 の場合、一辺の大きさが 1/2 と 1/4 のミップマップが生成される）
+		/// @param config ミップマップ生成の設定
+		/// @return ミップマップ画像
+		/// @remark 大きな画像は行ごとのタイルに分割して、タスクスケジューラのスレッドで並列に処理します。
+		[[nodiscard]]
+		Array<Image> GenerateMips(const Image& src, size_t maxLevel, const MipmapConfig& config);
+
 		void Sobel(const Image& src, Image& dst, int32 dx = 1, int32 dy = 1, int32 apertureSize = 3);
 
 		void Laplacian(const Image& src, Image& dst, int32 apertureSize = 3);
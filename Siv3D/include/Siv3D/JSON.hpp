@@ -229,6 +229,66 @@ namespace s3d
 		JSONIterationProxy m_end;
 	};
 
+	/// @brief JSON::Visit で JSON を先頭から走査する際に、値が現れるたびに呼ばれる関数を持つ基底クラス
+	/// @remark JSON オブジェクトを構築しないため、巨大な JSON から一部の値だけを取り出す場合に適しています。
+	/// @remark 各関数が false を返すと、走査を中断します。
+	class JSONVisitor
+	{
+	public:
+
+		virtual ~JSONVisitor() = default;
+
+		/// @brief null が現れたときに呼ばれます。
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onNull() { return true; }
+
+		/// @brief 真偽値が現れたときに呼ばれます。
+		/// @param value 値
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onBool([[maybe_unused]] bool value) { return true; }
+
+		/// @brief 符号付き整数が現れたときに呼ばれます。
+		/// @param value 値
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onInt([[maybe_unused]] int64 value) { return true; }
+
+		/// @brief 符号無し整数が現れたときに呼ばれます。
+		/// @param value 値
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onUint([[maybe_unused]] uint64 value) { return true; }
+
+		/// @brief 浮動小数点数が現れたときに呼ばれます。
+		/// @param value 値
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onFloat([[maybe_unused]] double value) { return true; }
+
+		/// @brief 文字列が現れたときに呼ばれます。
+		/// @param value UTF-8 文字列。関数から戻った後は無効になります。
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onString([[maybe_unused]] std::string_view value) { return true; }
+
+		/// @brief オブジェクトのキーが現れたときに呼ばれます。
+		/// @param key UTF-8 のキー。関数から戻った後は無効になります。
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onKey([[maybe_unused]] std::string_view key) { return true; }
+
+		/// @brief オブジェクトの開始時に呼ばれます。
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onObjectBegin() { return true; }
+
+		/// @brief オブジェクトの終了時に呼ばれます。
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onObjectEnd() { return true; }
+
+		/// @brief 配列の開始時に呼ばれます。
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onArrayBegin() { return true; }
+
+		/// @brief 配列の終了時に呼ばれます。
+		/// @return 走査を続ける場合 true, 中断する場合 false
+		virtual bool onArrayEnd() { return true; }
+	};
+
 	/// @brief JSON 形式のデータの読み書き
 	class JSON
 	{
@@ -685,6 +745,34 @@ namespace s3d
 		[[nodiscard]]
 		static JSON Parse(StringView str, AllowExceptions allowExceptions = AllowExceptions::No);
 
+		/// @brief UTF-8 の JSON 文字列をパースして JSON オブジェクトを返します。
+		/// @param [in] str UTF-8 文字列
+		/// @param [in] allowExceptions 例外を発生させるか
+		/// @return JSON オブジェクト
+		[[nodiscard]]
+		static JSON ParseUTF8(std::string_view str, AllowExceptions allowExceptions = AllowExceptions::No);
+
+		/// @brief JSON オブジェクトを構築せずに JSON ファイルを先頭から走査し、値が現れるたびに visitor の関数を呼びます。
+		/// @param [in] path ファイルパス
+		/// @param [in] visitor 値が現れたときに呼ばれる関数を持つオブジェクト
+		/// @param [in] allowExceptions 例外を発生させるか
+		/// @return 最後まで走査できた場合 true, ファイルを開けなかったか、パースに失敗したか、visitor が走査を中断した場合 false
+		static bool Visit(FilePathView path, JSONVisitor& visitor, AllowExceptions allowExceptions = AllowExceptions::No);
+
+		/// @brief JSON オブジェクトを構築せずに JSON データを先頭から走査し、値が現れるたびに visitor の関数を呼びます。
+		/// @param [in] reader IReader
+		/// @param [in] visitor 値が現れたときに呼ばれる関数を持つオブジェクト
+		/// @param [in] allowExceptions 例外を発生させるか
+		/// @return 最後まで走査できた場合 true, データを読み込めなかったか、パースに失敗したか、visitor が走査を中断した場合 false
+		static bool Visit(std::unique_ptr<IReader>&& reader, JSONVisitor& visitor, AllowExceptions allowExceptions = AllowExceptions::No);
+
+		/// @brief JSON オブジェクトを構築せずに UTF-8 の JSON 文字列を先頭から走査し、値が現れるたびに visitor の関数を呼びます。
+		/// @param [in] str UTF-8 文字列
+		/// @param [in] visitor 値が現れたときに呼ばれる関数を持つオブジェクト
+		/// @param [in] allowExceptions 例外を発生させるか
+		/// @return 最後まで走査できた場合 true, パースに失敗したか、visitor が走査を中断した場合 false
+		static bool VisitUTF8(std::string_view str, JSONVisitor& visitor, AllowExceptions allowExceptions = AllowExceptions::No);
+
 		/// @brief BSON 形式のデータから JSON オブジェクトをデシリアライズします。
 		/// @param [in] bson BSON データ
 		/// @param [in] allowExceptions 例外を発生させるか
@@ -14,6 +14,7 @@
 # include "Array.hpp"
 # include "YesNo.hpp"
 # include "PredefinedYesNo.hpp"
+# include "Threading.hpp"
 # include <ThirdParty/nanoflann/nanoflann.hpp>
 
 namespace s3d
@@ -53,6 +54,13 @@ namespace s3d
 
 			const dataset_type& m_dataset;
 		};
+
+		/// @brief 複数の座標についての検索を、スレッドプールで並列に実行します。
+		/// @tparam Fty `f(size_t first, size_t last)` の形で呼び出せる関数の型
+		/// @param count 座標の個数
+		/// @param f [first, last) の範囲の座標について検索する関数
+		template <class Fty>
+		void KDParallelQuery(size_t count, Fty f);
 	}
 
 	/// @brief kd-tree
@@ -72,6 +80,9 @@ namespace s3d
 
 		static constexpr int32 Dimensions = adapter_type::Dimensions;
 
+		/// @brief `knnSearchAll()` で、見つからなかった要素に格納されるインデックス
+		static constexpr size_t InvalidIndex = static_cast<size_t>(-1);
+
 		/// @brief デフォルトコンストラクタ
 		KDTree() = default;
 
@@ -125,11 +136,38 @@ namespace s3d
 		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
 		void radiusSearch(Array<size_t>& results, const point_type& point, element_type radius, const SortByDistance sortByDistance = SortByDistance::No) const;
 
+		/// @brief 複数の座標について、それぞれ最も近い k 個の要素を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`points.size() * k` 個に resize され、i 番目の座標の結果は `[i * k, (i + 1) * k)` に近い順に格納されます。
+		/// @param k 検索する個数
+		/// @param points 中心座標の一覧
+		/// @remark 要素数が k 未満の場合、見つからなかった分には `InvalidIndex` が格納されます。
+		void knnSearchAll(Array<size_t>& results, size_t k, const Array<point_type>& points) const;
+
+		/// @brief 複数の座標について、それぞれ最も近い k 個の要素を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`points.size() * k` 個に resize され、i 番目の座標の結果は `[i * k, (i + 1) * k)` に近い順に格納されます。
+		/// @param distanceSqResults それぞれの要素について、中心からの距離の二乗を格納する配列
+		/// @param k 検索する個数
+		/// @param points 中心座標の一覧
+		/// @remark 要素数が k 未満の場合、見つからなかった分には `InvalidIndex` が格納されます。
+		void knnSearchAll(Array<size_t>& results, Array<element_type>& distanceSqResults, size_t k, const Array<point_type>& points) const;
+
+		/// @brief 複数の座標について、それぞれ指定した半径以内にある要素一覧を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`points.size()` 個に resize され、i 番目の座標の結果は `results[i]` に格納されます。
+		/// @param points 中心座標の一覧
+		/// @param radius 半径
+		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
+		/// @remark `results` の各配列は再利用されるため、毎フレーム同じ配列を渡すとメモリの確保が起こりません。
+		void radiusSearchAll(Array<Array<size_t>>& results, const Array<point_type>& points, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
 	private:
 
+		using index_type = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<element_type, adapter_type, double>, adapter_type, Dimensions, size_t>;
+
+		using distance_type = typename index_type::DistanceType;
+
 		adapter_type m_adapter;
 
-		nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<element_type, adapter_type, double>, adapter_type, Dimensions, size_t> m_index;
+		index_type m_index;
 	};
 
 	template <class Dataset, class PointType, class ElementType = typename PointType::value_type, int32 Dim = PointType::Dimension>
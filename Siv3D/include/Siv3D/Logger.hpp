@@ -14,9 +14,22 @@
 # include "Common.hpp"
 # include "Format.hpp"
 # include "Formatter.hpp"
+# include "LogLevel.hpp"
 
 namespace s3d
 {
+	/// @brief ログファイルの形式
+	enum class LogFileFormat : uint8
+	{
+		/// @brief コンソールへの出力と同じ形式の UTF-8 テキスト
+		Text,
+
+		/// @brief 構造化されたバイナリ形式
+		/// @remark ファイルの先頭に 8 バイトの識別子 `SIV3DLOG` と uint32 のバージョン (1) が書き込まれ、
+		/// 以降、各ログについて int64 のタイムスタンプ（ミリ秒）、uint8 の LogType, uint32 のバイト数、UTF-8 の本文がリトルエンディアンで続きます。
+		Binary,
+	};
+
 	namespace detail
 	{
 		struct LoggerBuffer
@@ -105,6 +118,32 @@ namespace s3d
 
 			/// @brief ログ出力を有効化します
 			void enable() const;
+
+			/// @brief エンジンが出力するログの詳細度を設定します。
+			/// @param logLevel ログの詳細度
+			/// @remark `LogLevel::Release` ではトレースのログを出力しません。出力されないログの文字列は作成されません。
+			/// @remark デフォルトでは、デバッグビルドでは `LogLevel::Verbose`, リリースビルドでは `LogLevel::Release` です。
+			void setLogLevel(LogLevel logLevel) const;
+
+			/// @brief エンジンが出力するログの詳細度を返します。
+			/// @return ログの詳細度
+			[[nodiscard]]
+			LogLevel getLogLevel() const;
+
+			/// @brief ログをファイルにも出力します。
+			/// @param path ファイルパス
+			/// @param format ファイルの形式
+			/// @param maxFileSize ファイルの最大サイズ（バイト）。超えた場合、既存のファイルを `path.1`, `path.2`, ... にずらして新しいファイルに書き込みます。0 の場合は制限しません。
+			/// @param maxBackupFiles ローテーションで残す古いファイルの数
+			/// @return ファイルを開けた場合 true, それ以外の場合は false
+			bool setOutputFile(FilePathView path, LogFileFormat format = LogFileFormat::Text, size_t maxFileSize = 0, size_t maxBackupFiles = 3) const;
+
+			/// @brief ログファイルへの出力を終了します。
+			void closeOutputFile() const;
+
+			/// @brief それまでに出力したログがすべて書き出されるまで待機します。
+			/// @remark ログはバックグラウンドのスレッドでまとめて書き出されます。
+			void flush() const;
 		};
 	}
 
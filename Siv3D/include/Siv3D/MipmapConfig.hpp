@@ -0,0 +1,44 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief ミップマップの縮小に使うフィルタ
+	enum class MipmapFilter : uint8
+	{
+		/// @brief ボックスフィルタ（縮小元の範囲の面積平均）
+		Box,
+
+		/// @brief カイザー窓を掛けた sinc フィルタ
+		/// @remark ボックスフィルタよりもシャープですが、低速です。
+		Kaiser,
+	};
+
+	/// @brief ミップマップ生成の設定
+	struct MipmapConfig
+	{
+		/// @brief 縮小に使うフィルタ
+		MipmapFilter filter = MipmapFilter::Box;
+
+		/// @brief RGB を sRGB カーブを除去したリニアな値でフィルタするか
+		/// @remark `TextureDesc::MippedSRGB` のテクスチャに使うミップマップでは true にします。アルファは常にリニアとして扱います。
+		bool sRGB = false;
+
+		/// @brief アルファテストを通過するピクセルの割合を、元の画像と同じになるよう各レベルのアルファを調整するか
+		bool preserveAlphaCoverage = false;
+
+		/// @brief アルファテストの閾値（`preserveAlphaCoverage` が true の場合に使用）
+		uint8 alphaCoverageThreshold = 128;
+	};
+}
@@ -11,7 +11,11 @@
 
 # pragma once
 # include "Common.hpp"
+# include "Array.hpp"
+# include "StringView.hpp"
 # include "ProfilerStat.hpp"
+# include "ProfilerZone.hpp"
+# include "FrameTimeHistogram.hpp"
 
 namespace s3d
 {
@@ -29,5 +33,41 @@ namespace s3d
 
 		[[nodiscard]]
 		const ProfilerStat& GetStat();
+
+		/// @brief ゾーンの記録を有効にするかを設定します。
+		/// @param enabled ゾーンを記録する場合 true, それ以外の場合は false
+		/// @remark デフォルトでは無効です。無効の間、`SIV3D_PROFILE_ZONE` のコストはフラグの確認 1 回だけです。
+		void EnableZoneRecording(bool enabled) noexcept;
+
+		/// @brief ゾーンの記録が有効であるかを返します。
+		/// @return ゾーンの記録が有効である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsZoneRecordingEnabled() noexcept;
+
+		/// @brief 呼び出したスレッドの名前を設定します。
+		/// @param name スレッドの名前
+		/// @remark 名前は `SaveChromeTrace()` で保存するトレースに表示されます。
+		void SetThreadName(StringView name);
+
+		/// @brief 直前のフレームと重なるゾーンの一覧を返します。
+		/// @remark ゾーンはスレッド番号、開始時刻の順に並んでいます。
+		/// @return 直前のフレームと重なるゾーンの一覧
+		[[nodiscard]]
+		Array<ProfilerZoneRecord> GetLastFrameZones();
+
+		/// @brief 直近 `FrameTimeHistogram::WindowSize` フレームの、フレーム時間の分布を返します。
+		/// @remark フレーム時間は、ゾーンの記録が無効でも常に記録されています。
+		/// @return フレーム時間の分布
+		[[nodiscard]]
+		FrameTimeHistogram GetFrameTimeHistogram();
+
+		/// @brief 記録されたゾーンをすべて消去します。
+		void ClearZones();
+
+		/// @brief 各スレッドのリングバッファに残っているゾーンと直近のフレームを、Chrome のトレース形式 (JSON) で保存します。
+		/// @param path ファイルパス
+		/// @remark 保存したファイルは chrome://tracing や Perfetto で開くことができます。
+		/// @return 保存に成功した場合 true, それ以外の場合は false
+		bool SaveChromeTrace(FilePathView path);
 	}
 }
@@ -20,6 +20,9 @@ namespace s3d
 
 		uint32 triangleCount = 0;
 
+		/// @brief 2D 描画で 1 フレームに GPU へ転送した頂点・インデックスのバイト数
+		uint32 uploadedBytes = 0;
+
 		uint32 textureCount = 0;
 
 		uint32 fontCount = 0;
@@ -0,0 +1,110 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief プロファイラーのゾーンの記録
+	struct ProfilerZoneRecord
+	{
+		/// @brief ゾーンの名前
+		const char32* name = nullptr;
+
+		/// @brief ゾーンを記録したスレッドの番号
+		/// @remark 0 から、スレッドが最初にゾーンを記録した順に割り当てられます。
+		uint32 threadIndex = 0;
+
+		/// @brief 同じスレッドで、このゾーンを囲んでいるゾーンの数
+		uint32 depth = 0;
+
+		/// @brief ゾーンの開始時刻（アプリケーションが起動してからの経過時間、ナノ秒）
+		uint64 beginNanosec = 0;
+
+		/// @brief ゾーンの終了時刻（アプリケーションが起動してからの経過時間、ナノ秒）
+		uint64 endNanosec = 0;
+
+		/// @brief ゾーンの長さをミリ秒で返します。
+		/// @return ゾーンの長さ（ミリ秒）
+		[[nodiscard]]
+		constexpr double durationMillisec() const noexcept
+		{
+			return ((endNanosec - beginNanosec) / 1'000'000.0);
+		}
+	};
+
+	namespace detail
+	{
+		extern std::atomic<bool> g_profilerZoneEnabled;
+
+		[[nodiscard]]
+		inline bool IsProfilerZoneEnabledFast() noexcept
+		{
+			return g_profilerZoneEnabled.load(std::memory_order_relaxed);
+		}
+
+		/// @brief 呼び出したスレッドでゾーンを開始し、開始時刻を返します。
+		[[nodiscard]]
+		uint64 BeginProfilerZone() noexcept;
+
+		/// @brief 呼び出したスレッドで最後に開始したゾーンを終了し、記録します。
+		void EndProfilerZone(const char32* name, uint64 beginNanosec) noexcept;
+	}
+
+	/// @brief スコープに入ってから出るまでを、プロファイラーのゾーンとして記録するクラス
+	/// @remark `Profiler::EnableZoneRecording(true)` のときだけ記録されます。通常は `SIV3D_PROFILE_ZONE` マクロから使います。
+	class ProfilerScopedZone
+	{
+	public:
+
+		/// @brief ゾーンを開始します。
+		/// @param name ゾーンの名前。文字列リテラルなど、アプリケーションの終了まで有効な文字列である必要があります。
+		explicit ProfilerScopedZone(const char32* name) noexcept
+			: m_name{ name }
+		{
+			if (detail::IsProfilerZoneEnabledFast())
+			{
+				m_beginNanosec = detail::BeginProfilerZone();
+				m_active = true;
+			}
+		}
+
+		ProfilerScopedZone(const ProfilerScopedZone&) = delete;
+
+		ProfilerScopedZone& operator =(const ProfilerScopedZone&) = delete;
+
+		/// @brief ゾーンを終了します。
+		~ProfilerScopedZone()
+		{
+			if (m_active)
+			{
+				detail::EndProfilerZone(m_name, m_beginNanosec);
+			}
+		}
+
+	private:
+
+		const char32* m_name = nullptr;
+
+		uint64 m_beginNanosec = 0;
+
+		bool m_active = false;
+	};
+}
+
+# define SIV3D_PRIVATE_PROFILE_ZONE_CONCAT_(A, B) A##B
+# define SIV3D_PRIVATE_PROFILE_ZONE_CONCAT(A, B) SIV3D_PRIVATE_PROFILE_ZONE_CONCAT_(A, B)
+
+/// @brief 現在のスコープの終わりまでを、プロファイラーのゾーンとして記録します。
+/// @param NAME ゾーンの名前（文字列リテラル）
+# define SIV3D_PROFILE_ZONE(NAME) const s3d::ProfilerScopedZone SIV3D_PRIVATE_PROFILE_ZONE_CONCAT(s3d_profiler_zone_, __LINE__){ NAME }
@@ -94,6 +94,16 @@ namespace s3d
 		[[nodiscard]]
 		static AngelScript::asIScriptEngine* GetEngine();
 
+		/// @brief `ScriptCompileOption::UseBytecodeCache` を指定したときにバイトコードを保存するディレクトリを設定します。
+		/// @param directory ディレクトリのパス
+		/// @remark デフォルトではユーザーごとのキャッシュディレクトリ（`FileSystem::GetFolderPath(SpecialFolder::LocalAppData)`）の `Siv3D/<バージョン>/script/` です。
+		static void SetBytecodeCacheDirectory(FilePathView directory);
+
+		/// @brief `ScriptCompileOption::UseBytecodeCache` を指定したときにバイトコードを保存するディレクトリを返します。
+		/// @return バイトコードを保存するディレクトリのフルパス
+		[[nodiscard]]
+		static const FilePath& GetBytecodeCacheDirectory();
+
 	protected:
 
 		const std::shared_ptr<ScriptModule>& _getModule() const;
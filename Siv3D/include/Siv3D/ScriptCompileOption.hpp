@@ -21,6 +21,10 @@ namespace s3d
 		Default = 0b00,
 
 		BuildWithLineCues = 0b01,
+
+		/// @brief コンパイル結果のバイトコードをキャッシュディレクトリに保存し、次回以降はソースが変更されていなければキャッシュからロードします。
+		/// @remark キャッシュディレクトリは `Script::SetBytecodeCacheDirectory()` で変更できます。
+		UseBytecodeCache = 0b10,
 	};
 	DEFINE_BITMASK_OPERATORS(ScriptCompileOption);
 }
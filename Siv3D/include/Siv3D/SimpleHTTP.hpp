@@ -101,32 +101,36 @@ namespace s3d
 		/// @brief 指定した URL からファイルをダウンロードします。
 		/// @param url URL
 		/// @param filePath ダウンロードしたファイルを保存するパス
+		/// @param priority 優先度。値が大きいほど先に転送を開始します。
 		/// @return 非同期ダウンロードを管理するオブジェクト
 		[[nodiscard]]
-		AsyncHTTPTask SaveAsync(URLView url, FilePathView filePath);
+		AsyncHTTPTask SaveAsync(URLView url, FilePathView filePath, int32 priority = 0);
 
 		/// @brief 指定した URL からファイルをダウンロードします。
 		/// @param url URL
+		/// @param priority 優先度。値が大きいほど先に転送を開始します。
 		/// @return 非同期ダウンロードを管理するオブジェクト
 		/// @remark ダウンロード内容はメモリに保存されます。ダウンロード完了後、`AsyncHTTPTask::getBlob()` または `AsyncHTTPTask::getBlobReader()` で取得します。
 		[[nodiscard]]
-		AsyncHTTPTask LoadAsync(URLView url);
+		AsyncHTTPTask LoadAsync(URLView url, int32 priority = 0);
 
 		/// @brief GET メソッドで Web サーバにリクエストを送ります。
 		/// @param url URL
 		/// @param headers ヘッダ
 		/// @param filePath ダウンロードしたファイルを保存するパス
+		/// @param priority 優先度。値が大きいほど先に転送を開始します。
 		/// @return 非同期ダウンロードを管理するオブジェクト
 		[[nodiscard]]
-		AsyncHTTPTask GetAsync(URLView url, const HashTable<String, String>& headers, FilePathView filePath);
+		AsyncHTTPTask GetAsync(URLView url, const HashTable<String, String>& headers, FilePathView filePath, int32 priority);
 
 		/// @brief GET メソッドで Web サーバにリクエストを送ります。
 		/// @param url URL
 		/// @param headers ヘッダ
+		/// @param priority 優先度。値が大きいほど先に転送を開始します。
 		/// @return 非同期ダウンロードを管理するオブジェクト
 		/// @remark ダウンロード内容はメモリに保存されます。ダウンロード完了後、`AsyncHTTPTask::getBlob()` または `AsyncHTTPTask::getBlobReader()` で取得します。
 		[[nodiscard]]
-		AsyncHTTPTask GetAsync(URLView url, const HashTable<String, String>& headers);
+		AsyncHTTPTask GetAsync(URLView url, const HashTable<String, String>& headers, int32 priority);
 
 		/// @brief POST メソッドで Web サーバにリクエストを送ります。
 		/// @param url URL
@@ -134,18 +138,31 @@ namespace s3d
 		/// @param src 送信するデータの先頭ポインタ
 		/// @param size 送信するデータのサイズ（バイト）
 		/// @param filePath ダウンロードしたファイルを保存するパス
+		/// @param priority 優先度。値が大きいほど先に転送を開始します。
 		/// @return 非同期ダウンロードを管理するオブジェクト
 		[[nodiscard]]
-		AsyncHTTPTask PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView filePath);
+		AsyncHTTPTask PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView filePath, int32 priority);
 
 		/// @brief POST メソッドで Web サーバにリクエストを送ります。
 		/// @param url URL
 		/// @param headers ヘッダ
 		/// @param src 送信するデータの先頭ポインタ
 		/// @param size 送信するデータのサイズ（バイト）
+		/// @param priority 優先度。値が大きいほど先に転送を開始します。
 		/// @return 非同期ダウンロードを管理するオブジェクト
 		/// @remark ダウンロード内容はメモリに保存されます。ダウンロード完了後、`AsyncHTTPTask::getBlob()` または `AsyncHTTPTask::getBlobReader()` で取得します。
 		[[nodiscard]]
-		AsyncHTTPTask PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size);
+		AsyncHTTPTask PostAsync(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, int32 priority);
+
+		/// @brief 同時に転送するリクエストの数の上限を設定します。
+		/// @param maxConcurrency 同時に転送するリクエストの数の上限。デフォルトは 8 です。
+		/// @remark 上限を超えたリクエストは、優先度の高い順、同じ優先度の場合は要求した順に転送を開始します。
+		/// @remark すべてのリクエストは 1 つのスレッドで処理され、同じホストへの接続は再利用されます。
+		void SetMaxConcurrency(size_t maxConcurrency);
+
+		/// @brief 同時に転送するリクエストの数の上限を返します。
+		/// @return 同時に転送するリクエストの数の上限
+		[[nodiscard]]
+		size_t GetMaxConcurrency();
 	}
 }
@@ -12,6 +12,8 @@
 # pragma once
 # include <memory>
 # include "Common.hpp"
+# include "Array.hpp"
+# include "Byte.hpp"
 # include "Concepts.hpp"
 # include "TCPError.hpp"
 
@@ -67,6 +69,17 @@ namespace s3d
 		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
 		bool send(const TriviallyCopyable& from);
 
+		/// @brief データの先頭にサイズ (4 バイト) を付けて、1 つのメッセージとして送信します。
+		/// @param data 送信するデータの先頭ポインタ
+		/// @param size 送信するデータのサイズ（バイト）。最大 16 MiB
+		/// @return 送信を開始した場合 true, それ以外の場合は false
+		bool sendMessage(const void* data, size_t size);
+
+		/// @brief sendMessage() で送られたメッセージを、すべて揃っている場合に 1 つ取り出します。
+		/// @param message メッセージの格納先
+		/// @return メッセージを取り出した場合 true, それ以外の場合は false
+		bool tryReceiveMessage(Array<Byte>& message);
+
 	private:
 
 		class TCPClientDetail;
@@ -13,6 +13,7 @@
 # include <memory>
 # include "Common.hpp"
 # include "Array.hpp"
+# include "Byte.hpp"
 # include "Optional.hpp"
 # include "Unspecified.hpp"
 
@@ -28,6 +29,11 @@ namespace s3d
 		SIV3D_NODISCARD_CXX20
 		TCPServer();
 
+		/// @brief 通信を処理するスレッドの数を指定して TCP サーバを作成します。
+		/// @param ioThreadCount 通信を処理するスレッドの数。セッションは各スレッドに順番に割り当てられます。
+		SIV3D_NODISCARD_CXX20
+		explicit TCPServer(size_t ioThreadCount);
+
 		~TCPServer();
 
 		void startAccept(uint16 port);
@@ -76,6 +82,26 @@ namespace s3d
 		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
 		bool send(const TriviallyCopyable& to, const Optional<TCPSessionID>& id = unspecified);
 
+		/// @brief データの先頭にサイズ (4 バイト) を付けて、1 つのメッセージとして送信します。
+		/// @param data 送信するデータの先頭ポインタ
+		/// @param size 送信するデータのサイズ（バイト）。最大 16 MiB
+		/// @param id 送信先のセッション ID. 省略した場合は最も古いセッション
+		/// @return 送信を開始した場合 true, それ以外の場合は false
+		bool sendMessage(const void* data, size_t size, const Optional<TCPSessionID>& id = unspecified);
+
+		/// @brief sendMessage() で送られたメッセージを、すべて揃っている場合に 1 つ取り出します。
+		/// @param message メッセージの格納先
+		/// @param id 受信元のセッション ID. 省略した場合は最も古いセッション
+		/// @return メッセージを取り出した場合 true, それ以外の場合は false
+		bool tryReceiveMessage(Array<Byte>& message, const Optional<TCPSessionID>& id = unspecified);
+
+		/// @brief いずれかのセッションに届いたメッセージを、届いた順に 1 つ取り出します。
+		/// @param id メッセージの受信元のセッション ID の格納先
+		/// @param message メッセージの格納先
+		/// @return メッセージを取り出した場合 true, 揃ったメッセージが無い場合は false
+		/// @remark セッションごとに available() を調べる必要はありません。
+		bool tryReceiveAnyMessage(TCPSessionID& id, Array<Byte>& message);
+
 	private:
 
 		class TCPServerDetail;
@@ -30,6 +30,7 @@ namespace s3d
 	struct TextureRegion;
 	struct TexturedQuad;
 	struct TexturedRoundRect;
+	struct Mat3x2;
 
 	/// @brief テクスチャ
 	/// @remark 描画できる画像です。
@@ -203,6 +204,18 @@ namespace s3d
 
 		RectF drawAtClipped(const Vec2& pos, const RectF& clipRect, const ColorF& diffuse = Palette::White) const;
 
+		/// @brief テクスチャを、それぞれの座標変換を適用してまとめて描画します。
+		/// @param transforms 各インスタンスの座標変換。テクスチャの左上が原点になります。
+		/// @param diffuse 描画時に乗算する色
+		/// @remark 同じテクスチャを多数描画する場合、`draw()` を繰り返し呼ぶよりも高速です。
+		void drawInstanced(const Array<Mat3x2>& transforms, const ColorF& diffuse = Palette::White) const;
+
+		/// @brief テクスチャを、それぞれの座標変換と色を適用してまとめて描画します。
+		/// @param transforms 各インスタンスの座標変換。テクスチャの左上が原点になります。
+		/// @param colors 各インスタンスの乗算する色
+		/// @remark `transforms` と `colors` の要素数が異なる場合は、少ないほうに合わせます。
+		void drawInstanced(const Array<Mat3x2>& transforms, const Array<ColorF>& colors) const;
+
 		[[nodiscard]]
 		TextureRegion operator ()(double x, double y, double w, double h) const;
 
@@ -73,7 +73,13 @@ namespace s3d
 
 		/// @brief 指定したテクスチャアセットの非同期ロードを開始します。
 		/// @param name テクスチャアセット名
-		static void LoadAsync(AssetNameView name);
+		/// @param priority ロードの優先度。値が大きいほど先にロードされます。
+		static void LoadAsync(AssetNameView name, int32 priority = 0);
+
+		/// @brief 指定したタグを持つすべてのテクスチャアセットの非同期ロードを開始します。
+		/// @param tag タグ
+		/// @param priority ロードの優先度。値が大きいほど先にロードされます。
+		static void LoadAsyncByTag(const AssetTag& tag, int32 priority = 0);
 
 		/// @brief 指定したテクスチャアセットのロードが完了するまで待機します。
 		/// @param name テクスチャアセット名
@@ -10,6 +10,15 @@
 //-----------------------------------------------
 
 # pragma once
+# include "Common.hpp"
+# ifndef SIV3D_NO_CONCURRENT_API
+#	include <atomic>
+#	include <mutex>
+#	include <condition_variable>
+#	include <exception>
+#	include <functional>
+#	include <type_traits>
+# endif
 
 namespace s3d
 {
@@ -19,5 +28,73 @@ namespace s3d
 		/// @return サポートされるスレッド数 | Number of concurrent threads supported
 		[[nodiscard]]
 		size_t GetConcurrency() noexcept;
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		/// @brief エンジンが管理するタスクスケジューラのワーカースレッド数を返します。 | Returns the number of worker threads owned by the engine's task scheduler.
+		/// @return ワーカースレッド数 | Number of worker threads
+		[[nodiscard]]
+		size_t GetWorkerCount() noexcept;
+
+		/// @brief エンジンのスレッドプールで実行されるタスクのグループ | A group of tasks executed on the engine's thread pool
+		/// @remark `wait()` を呼んだスレッドは、待機中に未実行のタスクを処理するため、タスクの中で別の `TaskGroup` を待機しても安全です。
+		class TaskGroup
+		{
+		public:
+
+			SIV3D_NODISCARD_CXX20
+			TaskGroup() = default;
+
+			TaskGroup(const TaskGroup&) = delete;
+
+			TaskGroup& operator =(const TaskGroup&) = delete;
+
+			/// @brief すべてのタスクの完了を待ってから破棄します。
+			~TaskGroup();
+
+			/// @brief タスクを追加し、スレッドプールで実行します。
+			/// @tparam Fty タスクの関数の型
+			/// @param f タスクの関数
+			template <class Fty, std::enable_if_t<std::is_invocable_v<Fty>>* = nullptr>
+			void run(Fty&& f);
+
+			/// @brief すべてのタスクの完了を待ちます。
+			/// @remark タスクが例外を送出していた場合、最初の例外を再送出します。
+			void wait();
+
+			/// @brief すべてのタスクが完了しているかを返します。
+			/// @return すべてのタスクが完了している場合 true, それ以外の場合は false
+			[[nodiscard]]
+			bool isDone() const noexcept;
+
+		private:
+
+			std::atomic<size_t> m_pendingCount{ 0 };
+
+			std::mutex m_mutex;
+
+			std::condition_variable m_condition;
+
+			std::exception_ptr m_exception;
+
+			void submit(std::function<void()> task);
+
+			void waitPending();
+		};
+
+		/// @brief [first, last) の範囲のインデックスについて、関数をスレッドプールで並列に実行します。
+		/// @tparam Fty 関数の型。`f(size_t i)` または `f(size_t chunkFirst, size_t chunkLast)` の形で呼び出せる必要があります。
+		/// @param first 範囲の開始インデックス
+		/// @param last 範囲の終端インデックス
+		/// @param f 関数
+		/// @param grainSize 1 つのタスクで処理するインデックスの最小数。0 の場合は自動で決定します。
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t> || std::is_invocable_v<Fty, size_t, size_t>>* = nullptr>
+		void ParallelFor(size_t first, size_t last, Fty f, size_t grainSize = 0);
+
+	# endif
 	}
 }
+
+# ifndef SIV3D_NO_CONCURRENT_API
+#	include "detail/Threading.ipp"
+# endif
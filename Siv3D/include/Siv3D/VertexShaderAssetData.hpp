@@ -64,6 +64,12 @@ namespace s3d
 
 		void release() override;
 
+		[[nodiscard]]
+		Array<FilePath> getSourcePaths() const override;
+
+		[[nodiscard]]
+		std::function<void()> prepareReload(const String& hint) override;
+
 		static bool DefaultLoad(VertexShaderAssetData& asset, const String& hint);
 
 		static void DefaultRelease(VertexShaderAssetData& asset);
@@ -1554,7 +1554,7 @@ namespace s3d
 			return 0;
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
+		const size_t numThreads = (Threading::GetWorkerCount() + 1);
 
 		if (numThreads <= 1)
 		{
@@ -1563,7 +1563,9 @@ namespace s3d
 
 		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
 
-		Array<std::future<std::ptrdiff_t>> futures;
+		Array<size_t> counts(numThreads - 1, 0);
+
+		Threading::TaskGroup group;
 
 		auto it = begin();
 		size_t countLeft = size();
@@ -1577,10 +1579,10 @@ namespace s3d
 				break;
 			}
 
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
+			group.run([=, &f, &counts]()
 			{
-				return std::count_if(it, it + n, f);
-			}));
+				counts[i] = std::count_if(it, it + n, f);
+			});
 
 			it += n;
 			countLeft -= n;
@@ -1593,9 +1595,11 @@ namespace s3d
 			result = std::count_if(it, it + countLeft, f);
 		}
 
-		for (auto& future : futures)
+		group.wait();
+
+		for (const auto& count : counts)
 		{
-			result += future.get();
+			result += count;
 		}
 
 		return result;
@@ -1618,16 +1622,17 @@ namespace s3d
 			return;
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
+		const size_t numThreads = (Threading::GetWorkerCount() + 1);
 
 		if (numThreads <= 1)
 		{
-			return each(f);
+			each(f);
+			return;
 		}
 
 		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
 
-		Array<std::future<std::ptrdiff_t>> futures;
+		Threading::TaskGroup group;
 
 		auto it = begin();
 		size_t countLeft = size();
@@ -1641,10 +1646,10 @@ namespace s3d
 				break;
 			}
 
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
+			group.run([=, &f]()
 			{
 				std::for_each(it, it + n, f);
-			}));
+			});
 
 			it += n;
 			countLeft -= n;
@@ -1655,10 +1660,7 @@ namespace s3d
 			std::for_each(it, it + countLeft, f);
 		}
 
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+		group.wait();
 
 	# endif
 	}
@@ -1678,16 +1680,17 @@ namespace s3d
 			return;
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
+		const size_t numThreads = (Threading::GetWorkerCount() + 1);
 
 		if (numThreads <= 1)
 		{
-			return each(f);
+			each(f);
+			return;
 		}
 
 		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
 
-		Array<std::future<std::ptrdiff_t>> futures;
+		Threading::TaskGroup group;
 
 		auto it = begin();
 		size_t countLeft = size();
@@ -1701,10 +1704,10 @@ namespace s3d
 				break;
 			}
 
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
+			group.run([=, &f]()
 			{
 				std::for_each(it, it + n, f);
-			}));
+			});
 
 			it += n;
 			countLeft -= n;
@@ -1715,10 +1718,7 @@ namespace s3d
 			std::for_each(it, it + countLeft, f);
 		}
 
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+		group.wait();
 
 	# endif
 	}
@@ -1734,7 +1734,7 @@ namespace s3d
 			return Array<Ret>{};
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
+		const size_t numThreads = (Threading::GetWorkerCount() + 1);
 
 		if (numThreads <= 1)
 		{
@@ -1745,7 +1745,7 @@ namespace s3d
 
 		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
 
-		Array<std::future<void>> futures;
+		Threading::TaskGroup group;
 
 		auto itDst = new_array.begin();
 		auto itSrc = begin();
@@ -1760,7 +1760,7 @@ namespace s3d
 				break;
 			}
 
-			futures.emplace_back(std::async(std::launch::async, [=, &f]() mutable
+			group.run([=, &f]() mutable
 			{
 				const auto itSrcEnd = itSrc + n;
 
@@ -1768,7 +1768,7 @@ namespace s3d
 				{
 					*itDst++ = f(*itSrc++);
 				}
-			}));
+			});
 
 			itDst += n;
 			itSrc += n;
@@ -1785,10 +1785,7 @@ namespace s3d
 			}
 		}
 
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+		group.wait();
 
 		return new_array;
 	}
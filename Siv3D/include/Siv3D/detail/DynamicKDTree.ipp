@@ -0,0 +1,647 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class DatasetAdapter>
+	inline DynamicKDTree<DatasetAdapter>::DynamicKDTree(const dataset_type& dataset)
+		: m_dataset{ &dataset }
+	{
+		const size_t count = std::size(dataset);
+
+		// 葉ノードのインデックスは rebuildIndex() で設定される
+		m_leafIndices.assign(count, 0);
+
+		m_size = count;
+
+		rebuildIndex();
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::rebuildIndex()
+	{
+		Array<size_t> indices;
+		indices.reserve(m_size);
+
+		for (size_t i = 0; i < m_leafIndices.size(); ++i)
+		{
+			if (m_leafIndices[i] != NotInserted)
+			{
+				indices.push_back(i);
+			}
+		}
+
+		m_nodes.clear();
+		m_sizeAtBuild = m_size;
+		m_modificationCount = 0;
+
+		if (indices.isEmpty())
+		{
+			return;
+		}
+
+		m_nodes.reserve((indices.size() / LeafSize) * 2 + 1);
+
+		build(indices.data(), (indices.data() + indices.size()));
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::insert(const size_t index)
+	{
+		if (contains(index))
+		{
+			return;
+		}
+
+		if (m_leafIndices.size() <= index)
+		{
+			m_leafIndices.resize((index + 1), NotInserted);
+		}
+
+		insertImpl(index);
+
+		++m_size;
+
+		onModified();
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::remove(const size_t index)
+	{
+		if (not contains(index))
+		{
+			return;
+		}
+
+		removeImpl(index);
+
+		--m_size;
+
+		onModified();
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::update(const size_t index)
+	{
+		if (not contains(index))
+		{
+			return;
+		}
+
+		// 属している葉ノードの AABB の中にとどまっていれば、ツリーを変更する必要はない
+		{
+			const Node& leaf = m_nodes[m_leafIndices[index]];
+
+			bool inside = true;
+
+			for (int32 dim = 0; dim < Dimensions; ++dim)
+			{
+				const element_type value = getElement(index, dim);
+
+				if ((value < leaf.boundsMin[dim]) || (leaf.boundsMax[dim] < value))
+				{
+					inside = false;
+					break;
+				}
+			}
+
+			if (inside)
+			{
+				return;
+			}
+		}
+
+		removeImpl(index);
+
+		insertImpl(index);
+
+		onModified();
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::refit()
+	{
+		// 子ノードは常に親ノードより後ろにあるため、後ろから順に計算すればよい
+		for (size_t i = m_nodes.size(); i-- > 0;)
+		{
+			Node& node = m_nodes[i];
+
+			if (node.isLeaf())
+			{
+				computeBounds(node, node.indices.data(), (node.indices.data() + node.indices.size()));
+				continue;
+			}
+
+			const Node& child1 = m_nodes[node.child1];
+			const Node& child2 = m_nodes[node.child2];
+
+			for (int32 dim = 0; dim < Dimensions; ++dim)
+			{
+				node.boundsMin[dim] = Min(child1.boundsMin[dim], child2.boundsMin[dim]);
+				node.boundsMax[dim] = Max(child1.boundsMax[dim], child2.boundsMax[dim]);
+			}
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline bool DynamicKDTree<DatasetAdapter>::contains(const size_t index) const noexcept
+	{
+		return ((index < m_leafIndices.size())
+			&& (m_leafIndices[index] != NotInserted));
+	}
+
+	template <class DatasetAdapter>
+	inline size_t DynamicKDTree<DatasetAdapter>::size() const noexcept
+	{
+		return m_size;
+	}
+
+	template <class DatasetAdapter>
+	inline bool DynamicKDTree<DatasetAdapter>::isEmpty() const noexcept
+	{
+		return (m_size == 0);
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::release()
+	{
+		m_nodes.release();
+		m_leafIndices.release();
+		m_size = 0;
+		m_sizeAtBuild = 0;
+		m_modificationCount = 0;
+	}
+
+	template <class DatasetAdapter>
+	inline size_t DynamicKDTree<DatasetAdapter>::usedMemory() const
+	{
+		size_t result = ((m_nodes.capacity() * sizeof(Node)) + (m_leafIndices.capacity() * sizeof(uint32)));
+
+		for (const auto& node : m_nodes)
+		{
+			result += (node.indices.capacity() * sizeof(size_t));
+		}
+
+		return result;
+	}
+
+	template <class DatasetAdapter>
+	inline Array<size_t> DynamicKDTree<DatasetAdapter>::knnSearch(const size_t k, const point_type& point) const
+	{
+		Array<size_t> results;
+
+		knnSearch(results, k, point);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearch(Array<size_t>& results, const size_t k, const point_type& point) const
+	{
+		results.resize(k);
+
+		Array<distance_type> distanceSqs(k);
+
+		nanoflann::KNNResultSet<distance_type, size_t> resultSet{ k };
+		resultSet.init(results.data(), distanceSqs.data());
+
+		search(resultSet, DatasetAdapter::GetPointer(point));
+
+		results.resize(resultSet.size());
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearch(Array<size_t>& results, Array<element_type>& distanceSqResults, const size_t k, const point_type& point) const
+	{
+		results.resize(k);
+
+		Array<distance_type> distanceSqs(k);
+
+		nanoflann::KNNResultSet<distance_type, size_t> resultSet{ k };
+		resultSet.init(results.data(), distanceSqs.data());
+
+		search(resultSet, DatasetAdapter::GetPointer(point));
+
+		const size_t found = resultSet.size();
+
+		results.resize(found);
+		distanceSqResults.resize(found);
+
+		for (size_t i = 0; i < found; ++i)
+		{
+			distanceSqResults[i] = static_cast<element_type>(distanceSqs[i]);
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline Array<size_t> DynamicKDTree<DatasetAdapter>::radiusSearch(const point_type& point, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		Array<size_t> results;
+
+		radiusSearch(results, point, radius, sortByDistance);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::radiusSearch(Array<size_t>& results, const point_type& point, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		const distance_type radiusSq = (static_cast<distance_type>(radius) * radius);
+
+		if (sortByDistance)
+		{
+			std::vector<std::pair<size_t, distance_type>> matches;
+
+			nanoflann::RadiusResultSet<distance_type, size_t> resultSet{ radiusSq, matches };
+
+			search(resultSet, DatasetAdapter::GetPointer(point));
+
+			std::sort(matches.begin(), matches.end(), nanoflann::IndexDist_Sorter());
+
+			results.resize(matches.size());
+
+			for (size_t i = 0; i < matches.size(); ++i)
+			{
+				results[i] = matches[i].first;
+			}
+		}
+		else
+		{
+			detail::RadiusResultsAdapter<distance_type> resultSet{ radiusSq, results };
+
+			search(resultSet, DatasetAdapter::GetPointer(point));
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearchAll(Array<size_t>& results, const size_t k, const Array<point_type>& points) const
+	{
+		results.resize(points.size() * k);
+
+		if (k == 0)
+		{
+			return;
+		}
+
+		detail::KDParallelQuery(points.size(), [&](const size_t first, const size_t last)
+			{
+				Array<distance_type> distanceSqs(k);
+
+				for (size_t i = first; i < last; ++i)
+				{
+					size_t* const pResults = (results.data() + (i * k));
+
+					nanoflann::KNNResultSet<distance_type, size_t> resultSet{ k };
+					resultSet.init(pResults, distanceSqs.data());
+
+					search(resultSet, DatasetAdapter::GetPointer(points[i]));
+
+					detail::FillKNNResults(pResults, static_cast<element_type*>(nullptr), distanceSqs.data(), resultSet.size(), k);
+				}
+			});
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearchAll(Array<size_t>& results, Array<element_type>& distanceSqResults, const size_t k, const Array<point_type>& points) const
+	{
+		results.resize(points.size() * k);
+		distanceSqResults.resize(points.size() * k);
+
+		if (k == 0)
+		{
+			return;
+		}
+
+		detail::KDParallelQuery(points.size(), [&](const size_t first, const size_t last)
+			{
+				Array<distance_type> distanceSqs(k);
+
+				for (size_t i = first; i < last; ++i)
+				{
+					size_t* const pResults = (results.data() + (i * k));
+
+					nanoflann::KNNResultSet<distance_type, size_t> resultSet{ k };
+					resultSet.init(pResults, distanceSqs.data());
+
+					search(resultSet, DatasetAdapter::GetPointer(points[i]));
+
+					detail::FillKNNResults(pResults, (distanceSqResults.data() + (i * k)), distanceSqs.data(), resultSet.size(), k);
+				}
+			});
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::radiusSearchAll(Array<Array<size_t>>& results, const Array<point_type>& points, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		results.resize(points.size());
+
+		detail::KDParallelQuery(points.size(), [&](const size_t first, const size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					radiusSearch(results[i], points[i], radius, sortByDistance);
+				}
+			});
+	}
+
+	template <class DatasetAdapter>
+	inline typename DynamicKDTree<DatasetAdapter>::element_type DynamicKDTree<DatasetAdapter>::getElement(const size_t index, const size_t dim) const
+	{
+		return DatasetAdapter::GetElement(*m_dataset, index, dim);
+	}
+
+	template <class DatasetAdapter>
+	inline uint32 DynamicKDTree<DatasetAdapter>::build(size_t* first, size_t* last)
+	{
+		const uint32 nodeIndex = static_cast<uint32>(m_nodes.size());
+
+		m_nodes.emplace_back();
+
+		computeBounds(m_nodes.back(), first, last);
+
+		const size_t count = (last - first);
+
+		if (count <= LeafSize)
+		{
+			Node& node = m_nodes.back();
+
+			node.indices.assign(first, last);
+
+			for (const size_t* it = first; it != last; ++it)
+			{
+				m_leafIndices[*it] = nodeIndex;
+			}
+
+			return nodeIndex;
+		}
+
+		const int32 splitDim = chooseSplitDim(m_nodes.back());
+		size_t* const middle = (first + (count / 2));
+
+		std::nth_element(first, middle, last, [this, splitDim](const size_t a, const size_t b)
+			{
+				return (getElement(a, splitDim) < getElement(b, splitDim));
+			});
+
+		const element_type splitValue = getElement(*middle, splitDim);
+
+		// build() は m_nodes に追加するため、参照を保持しない
+		const uint32 child1 = build(first, middle);
+		const uint32 child2 = build(middle, last);
+
+		Node& node = m_nodes[nodeIndex];
+		node.child1 = child1;
+		node.child2 = child2;
+		node.splitDim = splitDim;
+		node.splitValue = splitValue;
+
+		return nodeIndex;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::splitLeaf(const uint32 nodeIndex)
+	{
+		Array<size_t> indices = std::move(m_nodes[nodeIndex].indices);
+		m_nodes[nodeIndex].indices.clear();
+
+		size_t* const first = indices.data();
+		size_t* const last = (first + indices.size());
+		size_t* const middle = (first + (indices.size() / 2));
+
+		const int32 splitDim = chooseSplitDim(m_nodes[nodeIndex]);
+
+		std::nth_element(first, middle, last, [this, splitDim](const size_t a, const size_t b)
+			{
+				return (getElement(a, splitDim) < getElement(b, splitDim));
+			});
+
+		const element_type splitValue = getElement(*middle, splitDim);
+
+		const uint32 child1 = build(first, middle);
+		const uint32 child2 = build(middle, last);
+
+		Node& node = m_nodes[nodeIndex];
+		node.child1 = child1;
+		node.child2 = child2;
+		node.splitDim = splitDim;
+		node.splitValue = splitValue;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::insertImpl(const size_t index)
+	{
+		if (m_nodes.isEmpty())
+		{
+			m_nodes.emplace_back();
+
+			SetEmptyBounds(m_nodes.back());
+		}
+
+		uint32 nodeIndex = 0;
+
+		for (;;)
+		{
+			Node& node = m_nodes[nodeIndex];
+
+			for (int32 dim = 0; dim < Dimensions; ++dim)
+			{
+				const element_type value = getElement(index, dim);
+				node.boundsMin[dim] = Min(node.boundsMin[dim], value);
+				node.boundsMax[dim] = Max(node.boundsMax[dim], value);
+			}
+
+			if (node.isLeaf())
+			{
+				break;
+			}
+
+			nodeIndex = ((getElement(index, node.splitDim) < node.splitValue) ? node.child1 : node.child2);
+		}
+
+		Node& leaf = m_nodes[nodeIndex];
+		leaf.indices.push_back(index);
+		m_leafIndices[index] = nodeIndex;
+
+		if ((LeafSize * 2) < leaf.indices.size())
+		{
+			splitLeaf(nodeIndex);
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::removeImpl(const size_t index)
+	{
+		// 葉ノードの AABB は縮めない（`refit()` または再構築で縮む）
+		Array<size_t>& indices = m_nodes[m_leafIndices[index]].indices;
+
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			if (indices[i] == index)
+			{
+				indices[i] = indices.back();
+				indices.pop_back();
+				break;
+			}
+		}
+
+		m_leafIndices[index] = NotInserted;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::onModified()
+	{
+		// 変更を重ねるとツリーの偏りや AABB の重なりが大きくなるため、構築時の要素数に比例する回数ごとに再構築する
+		if (Max(m_sizeAtBuild, LeafSize) < ++m_modificationCount)
+		{
+			rebuildIndex();
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::computeBounds(Node& node, const size_t* first, const size_t* last) const
+	{
+		SetEmptyBounds(node);
+
+		for (const size_t* it = first; it != last; ++it)
+		{
+			for (int32 dim = 0; dim < Dimensions; ++dim)
+			{
+				const element_type value = getElement(*it, dim);
+				node.boundsMin[dim] = Min(node.boundsMin[dim], value);
+				node.boundsMax[dim] = Max(node.boundsMax[dim], value);
+			}
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline int32 DynamicKDTree<DatasetAdapter>::chooseSplitDim(const Node& node) const
+	{
+		int32 splitDim = 0;
+		element_type maxExtent = (node.boundsMax[0] - node.boundsMin[0]);
+
+		for (int32 dim = 1; dim < Dimensions; ++dim)
+		{
+			if (const element_type extent = (node.boundsMax[dim] - node.boundsMin[dim]);
+				maxExtent < extent)
+			{
+				splitDim = dim;
+				maxExtent = extent;
+			}
+		}
+
+		return splitDim;
+	}
+
+	template <class DatasetAdapter>
+	template <class ResultSet>
+	inline void DynamicKDTree<DatasetAdapter>::search(ResultSet& resultSet, const element_type* query) const
+	{
+		if (m_nodes.isEmpty())
+		{
+			return;
+		}
+
+		if (DistanceSqToBounds(m_nodes.front(), query) < resultSet.worstDist())
+		{
+			searchNode(resultSet, query, 0);
+		}
+	}
+
+	template <class DatasetAdapter>
+	template <class ResultSet>
+	inline void DynamicKDTree<DatasetAdapter>::searchNode(ResultSet& resultSet, const element_type* query, const uint32 nodeIndex) const
+	{
+		const Node& node = m_nodes[nodeIndex];
+
+		if (node.isLeaf())
+		{
+			for (const size_t index : node.indices)
+			{
+				distance_type distanceSq = 0;
+
+				for (int32 dim = 0; dim < Dimensions; ++dim)
+				{
+					const distance_type diff = (static_cast<distance_type>(query[dim]) - getElement(index, dim));
+					distanceSq += (diff * diff);
+				}
+
+				if (distanceSq < resultSet.worstDist())
+				{
+					resultSet.addPoint(distanceSq, index);
+				}
+			}
+
+			return;
+		}
+
+		// 近い子ノードから探索し、遠い子ノードは結果が更新された後の最悪距離で枝刈りする
+		const distance_type distanceSq1 = DistanceSqToBounds(m_nodes[node.child1], query);
+		const distance_type distanceSq2 = DistanceSqToBounds(m_nodes[node.child2], query);
+
+		if (distanceSq1 <= distanceSq2)
+		{
+			if (distanceSq1 < resultSet.worstDist())
+			{
+				searchNode(resultSet, query, node.child1);
+			}
+
+			if (distanceSq2 < resultSet.worstDist())
+			{
+				searchNode(resultSet, query, node.child2);
+			}
+		}
+		else
+		{
+			if (distanceSq2 < resultSet.worstDist())
+			{
+				searchNode(resultSet, query, node.child2);
+			}
+
+			if (distanceSq1 < resultSet.worstDist())
+			{
+				searchNode(resultSet, query, node.child1);
+			}
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline typename DynamicKDTree<DatasetAdapter>::distance_type DynamicKDTree<DatasetAdapter>::DistanceSqToBounds(const Node& node, const element_type* query) noexcept
+	{
+		distance_type distanceSq = 0;
+
+		for (int32 dim = 0; dim < Dimensions; ++dim)
+		{
+			const distance_type value = query[dim];
+
+			if (value < node.boundsMin[dim])
+			{
+				const distance_type diff = (node.boundsMin[dim] - value);
+				distanceSq += (diff * diff);
+			}
+			else if (node.boundsMax[dim] < value)
+			{
+				const distance_type diff = (value - node.boundsMax[dim]);
+				distanceSq += (diff * diff);
+			}
+		}
+
+		return distanceSq;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::SetEmptyBounds(Node& node) noexcept
+	{
+		node.boundsMin.fill(std::numeric_limits<element_type>::max());
+		node.boundsMax.fill(std::numeric_limits<element_type>::lowest());
+	}
+}
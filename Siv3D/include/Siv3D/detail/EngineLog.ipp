@@ -10,11 +10,24 @@
 //-----------------------------------------------
 
 # pragma once
+# include <atomic>
 
 namespace s3d
 {
 	namespace Internal
 	{
+		/// @brief 現在のログレベルで出力されるログの種類の上限（LogType の値）
+		extern std::atomic<uint8> g_engineLogTypeLimit;
+
+		/// @brief 指定した種類のログが、現在のログレベルで出力されるかを返します。
+		/// @param type ログの種類
+		/// @return 出力される場合 true, それ以外の場合は false
+		[[nodiscard]]
+		inline bool IsEngineLogEnabled(const LogType type) noexcept
+		{
+			return (static_cast<uint8>(type) <= g_engineLogTypeLimit.load(std::memory_order_relaxed));
+		}
+
 		void OutputEngineLog(LogType type, StringView s);
 
 		class ScopedEngineLog
@@ -27,6 +40,7 @@ namespace s3d
 
 		public:
 
+			/// @param s ログの内容。空の場合は何も出力しません。
 			ScopedEngineLog(LogType type, String s);
 
 			~ScopedEngineLog();
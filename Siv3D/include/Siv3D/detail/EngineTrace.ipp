@@ -0,0 +1,126 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	namespace EngineTrace
+	{
+		namespace detail
+		{
+			/// @brief 記録される引数の型
+			enum class ArgType : uint8
+			{
+				Int,
+
+				UInt,
+
+				Float,
+
+				Boolean,
+
+				Pointer,
+			};
+
+			/// @brief イベントの書式
+			struct EventDesc
+			{
+				/// @brief `{}` を含む書式文字列（静的な文字列リテラル）
+				const char32* format = nullptr;
+
+				const char* file = nullptr;
+
+				uint32 line = 0;
+
+				uint8 argCount = 0;
+
+				std::array<ArgType, MaxArgs> argTypes{};
+			};
+
+			extern std::atomic<bool> g_enabled;
+
+			[[nodiscard]]
+			inline bool IsEnabledFast() noexcept
+			{
+				return g_enabled.load(std::memory_order_relaxed);
+			}
+
+			/// @brief イベントの書式を登録し、イベントの ID を返します。
+			[[nodiscard]]
+			uint16 RegisterEvent(const EventDesc& desc);
+
+			void RecordEvent(uint16 id, const uint64* args, size_t argCount) noexcept;
+
+			template <class Type>
+			[[nodiscard]]
+			inline constexpr ArgType GetArgType() noexcept
+			{
+				if constexpr (std::is_same_v<Type, bool>)
+				{
+					return ArgType::Boolean;
+				}
+				else if constexpr (std::is_floating_point_v<Type>)
+				{
+					return ArgType::Float;
+				}
+				else if constexpr (std::is_pointer_v<Type>)
+				{
+					static_assert(std::is_void_v<std::remove_pointer_t<Type>>, "LOG_TRACE_EVENT() only accepts void pointers");
+					return ArgType::Pointer;
+				}
+				else
+				{
+					static_assert(std::is_integral_v<Type>, "LOG_TRACE_EVENT() only accepts arithmetic and void pointer arguments");
+					return (std::is_signed_v<Type> ? ArgType::Int : ArgType::UInt);
+				}
+			}
+
+			template <class Type>
+			[[nodiscard]]
+			inline uint64 ToRawArg(const Type value) noexcept
+			{
+				if constexpr (std::is_floating_point_v<Type>)
+				{
+					const double d = static_cast<double>(value);
+					uint64 raw;
+					std::memcpy(&raw, &d, sizeof(raw));
+					return raw;
+				}
+				else if constexpr (std::is_pointer_v<Type>)
+				{
+					return static_cast<uint64>(reinterpret_cast<std::uintptr_t>(value));
+				}
+				else
+				{
+					return static_cast<uint64>(value);
+				}
+			}
+
+			template <class... Args>
+			[[nodiscard]]
+			uint16 RegisterEvent(const char32* format, const char* file, const uint32 line)
+			{
+				static_assert(sizeof...(Args) <= MaxArgs, "Too many arguments for LOG_TRACE_EVENT()");
+
+				return RegisterEvent(EventDesc{ format, file, line, static_cast<uint8>(sizeof...(Args)), { GetArgType<Args>()... } });
+			}
+
+			template <class... Args>
+			inline void Record(const uint16 id, const Args&... args) noexcept
+			{
+				const uint64 rawArgs[sizeof...(Args) + 1] = { ToRawArg(args)..., 0 };
+
+				RecordEvent(id, rawArgs, sizeof...(Args));
+			}
+		}
+	}
+}
@@ -24,4 +24,9 @@ namespace s3d
 
 		return decode(reader, path);
 	}
+
+	inline std::unique_ptr<IAudioStreamDecoder> IAudioDecoder::createStreamDecoder(std::unique_ptr<IReader>&&) const
+	{
+		return nullptr;
+	}
 }
@@ -27,6 +27,7 @@ namespace s3d
 	class JSONConstIterator;
 	class JSONIterationProxy;
 	class JSONArrayView;
+	class JSONVisitor;
 	class JSON;
 	struct JSONItem;
 	struct JSONPointer;
@@ -96,6 +96,37 @@ namespace s3d
 				return m_radius;
 			}
 		};
+
+		template <class Fty>
+		inline void KDParallelQuery(const size_t count, Fty f)
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			// 1 回の検索は短いため、ある程度まとめてタスクにする
+			Threading::ParallelFor(0, count, f, 256);
+
+		# else
+
+			f(0, count);
+
+		# endif
+		}
+
+		template <class ElementType, class DistanceType>
+		inline void FillKNNResults(size_t* results, ElementType* distanceSqResults, const DistanceType* distanceSqs, const size_t found, const size_t k)
+		{
+			if (distanceSqResults)
+			{
+				for (size_t i = 0; i < found; ++i)
+				{
+					distanceSqResults[i] = static_cast<ElementType>(distanceSqs[i]);
+				}
+
+				std::fill(distanceSqResults + found, distanceSqResults + k, std::numeric_limits<ElementType>::max());
+			}
+
+			std::fill(results + found, results + k, static_cast<size_t>(-1));
+		}
 	}
 
 	template <class DatasetAdapter>
@@ -204,4 +235,69 @@ namespace s3d
 			m_index.radiusSearchCustomCallback(adapter_type::GetPointer(point), resultSet, searchParams);
 		}
 	}
+
+	template <class DatasetAdapter>
+	inline void KDTree<DatasetAdapter>::knnSearchAll(Array<size_t>& results, const size_t k, const Array<point_type>& points) const
+	{
+		results.resize(points.size() * k);
+
+		if (k == 0)
+		{
+			return;
+		}
+
+		detail::KDParallelQuery(points.size(), [&](const size_t first, const size_t last)
+			{
+				Array<distance_type> distanceSqs(k);
+
+				for (size_t i = first; i < last; ++i)
+				{
+					size_t* const pResults = (results.data() + (i * k));
+
+					const size_t found = m_index.knnSearch(adapter_type::GetPointer(points[i]), k, pResults, distanceSqs.data());
+
+					detail::FillKNNResults(pResults, static_cast<element_type*>(nullptr), distanceSqs.data(), found, k);
+				}
+			});
+	}
+
+	template <class DatasetAdapter>
+	inline void KDTree<DatasetAdapter>::knnSearchAll(Array<size_t>& results, Array<element_type>& distanceSqResults, const size_t k, const Array<point_type>& points) const
+	{
+		results.resize(points.size() * k);
+		distanceSqResults.resize(points.size() * k);
+
+		if (k == 0)
+		{
+			return;
+		}
+
+		detail::KDParallelQuery(points.size(), [&](const size_t first, const size_t last)
+			{
+				Array<distance_type> distanceSqs(k);
+
+				for (size_t i = first; i < last; ++i)
+				{
+					size_t* const pResults = (results.data() + (i * k));
+
+					const size_t found = m_index.knnSearch(adapter_type::GetPointer(points[i]), k, pResults, distanceSqs.data());
+
+					detail::FillKNNResults(pResults, (distanceSqResults.data() + (i * k)), distanceSqs.data(), found, k);
+				}
+			});
+	}
+
+	template <class DatasetAdapter>
+	inline void KDTree<DatasetAdapter>::radiusSearchAll(Array<Array<size_t>>& results, const Array<point_type>& points, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		results.resize(points.size());
+
+		detail::KDParallelQuery(points.size(), [&](const size_t first, const size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					radiusSearch(results[i], points[i], radius, sortByDistance);
+				}
+			});
+	}
 }
@@ -1048,11 +1048,13 @@ namespace s3d
 		N num_processed = 0;
 		const N num_all = count_;
 
-		Array<std::future<std::size_t>> futures;
+		std::atomic<size_t> t_results{ 0 };
+
+		Threading::TaskGroup group;
 
 		for (; num_processed < num_all - n; num_processed += n)
 		{
-			futures.emplace_back(std::async(std::launch::async, [=, &f]() mutable
+			group.run([=, &f, &t_results]() mutable
 				{
 					size_t t_result = 0;
 
@@ -1063,8 +1065,8 @@ namespace s3d
 						value += step_;
 					}
 
-					return t_result;
-				}));
+					t_results.fetch_add(t_result, std::memory_order_relaxed);
+				});
 
 			value += static_cast<T>(n * step_);
 		}
@@ -1076,10 +1078,9 @@ namespace s3d
 			value += step_;
 		}
 
-		for (auto& future : futures)
-		{
-			result += future.get();
-		}
+		group.wait();
+
+		result += static_cast<N>(t_results.load(std::memory_order_relaxed));
 
 		return result;
 	}
@@ -1104,11 +1105,11 @@ namespace s3d
 		N num_processed = 0;
 		const N num_all = count_;
 
-		Array<std::future<void>> futures;
+		Threading::TaskGroup group;
 
 		for (; num_processed < num_all - n; num_processed += n)
 		{
-			futures.emplace_back(std::async(std::launch::async, [=, &f]() mutable
+			group.run([=, &f]() mutable
 				{
 					for (N i = 0; i < n; ++i)
 					{
@@ -1116,7 +1117,7 @@ namespace s3d
 
 						value += step_;
 					}
-				}));
+				});
 
 			value += static_cast<T>(n * step_);
 		}
@@ -1128,10 +1129,7 @@ namespace s3d
 			value += step_;
 		}
 
-		for (auto& future : futures)
-		{
-			future.wait();
-		}
+		group.wait();
 	}
 
 	// parallel_map
@@ -0,0 +1,95 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	namespace Threading
+	{
+		inline TaskGroup::~TaskGroup()
+		{
+			waitPending();
+		}
+
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty>>*>
+		inline void TaskGroup::run(Fty&& f)
+		{
+			submit(std::function<void()>{ std::forward<Fty>(f) });
+		}
+
+		inline bool TaskGroup::isDone() const noexcept
+		{
+			return (m_pendingCount.load(std::memory_order_acquire) == 0);
+		}
+
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t> || std::is_invocable_v<Fty, size_t, size_t>>*>
+		inline void ParallelFor(const size_t first, const size_t last, Fty f, size_t grainSize)
+		{
+			if (last <= first)
+			{
+				return;
+			}
+
+			const auto invokeRange = [&f](const size_t chunkFirst, const size_t chunkLast)
+			{
+				if constexpr (std::is_invocable_v<Fty, size_t, size_t>)
+				{
+					f(chunkFirst, chunkLast);
+				}
+				else
+				{
+					for (size_t i = chunkFirst; i < chunkLast; ++i)
+					{
+						f(i);
+					}
+				}
+			};
+
+			const size_t count = (last - first);
+			const size_t numThreads = (GetWorkerCount() + 1);
+
+			if (grainSize == 0)
+			{
+				// スレッドあたり 4 チャンクに分割して負荷を分散する
+				grainSize = ((count + (numThreads * 4 - 1)) / (numThreads * 4));
+			}
+
+			grainSize = ((grainSize < 1) ? 1 : grainSize);
+
+			if ((numThreads <= 1) || (count <= grainSize))
+			{
+				invokeRange(first, last);
+				return;
+			}
+
+			TaskGroup group;
+
+			size_t chunkFirst = first;
+
+			while ((last - chunkFirst) > grainSize)
+			{
+				const size_t chunkLast = (chunkFirst + grainSize);
+
+				group.run([=, &invokeRange]()
+				{
+					invokeRange(chunkFirst, chunkLast);
+				});
+
+				chunkFirst = chunkLast;
+			}
+
+			invokeRange(chunkFirst, last);
+
+			group.wait();
+		}
+	}
+}
@@ -13,6 +13,8 @@
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/AudioCodec/IAudioCodec.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
+# include <Siv3D/AudioFormat/MP3/MP3StreamDecoder.hpp>
+# include <Siv3D/AudioFormat/AudioStreamDecoderCommon.hpp>
 
 namespace s3d
 {
@@ -56,4 +58,9 @@ namespace s3d
 
 		return SIV3D_ENGINE(AudioCodec)->decode(reader, AudioFormat::MP3);
 	}
+
+	std::unique_ptr<IAudioStreamDecoder> MP3Decoder::createStreamDecoder(std::unique_ptr<IReader>&& reader) const
+	{
+		return detail::CreateStreamDecoder<MP3StreamDecoder>(std::move(reader));
+	}
 }
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <filesystem>
+# include <unistd.h>
 # include "DirectoryWatcherDetail.hpp"
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/EngineLog.hpp>
@@ -30,25 +31,31 @@ namespace s3d
 
 		m_buffer.resize(EventBufferSize);
 
-		m_thread = std::thread(DirectoryWatcherDetail::watch, this);
+		if (not init())
+		{
+			return;
+		}
 
-		while (not m_initCalled)
+		// 監視スレッドは作らず、すべての DirectoryWatcher で共有するリアクターに登録する
+		if (not DirectoryWatcherReactor::Get().add(this))
 		{
-			::usleep(1000);
+			dispose();
+			return;
 		}
 
-		m_isActive = (true);
+		m_isActive = true;
 	}
 
 	DirectoryWatcher::DirectoryWatcherDetail::~DirectoryWatcherDetail()
 	{
-		m_abort = true;
-
-		if (m_thread.joinable())
+		if (not m_isActive)
 		{
-			m_thread.join();
+			dispose();
+			return;
 		}
 
+		DirectoryWatcherReactor::Get().remove(this);
+
 		dispose();
 
 		LOG_INFO(U"ℹ️ DirectoryWatcher: Monitoring `{}` is deactivated"_fmt(m_targetDirectory));
@@ -63,7 +70,7 @@ namespace s3d
 	{
 		std::lock_guard lock{ m_changesMutex };
 
-		fileChanges.assign(m_fileChanges.begin(), m_fileChanges.end());
+		fileChanges.swap(m_fileChanges);
 
 		m_fileChanges.clear();
 	}
@@ -72,6 +79,8 @@ namespace s3d
 	{
 		std::lock_guard lock{ m_changesMutex };
 
+		m_pendingChanges.clear();
+
 		m_fileChanges.clear();
 	}
 
@@ -80,25 +89,43 @@ namespace s3d
 		return m_targetDirectory;
 	}
 
-	void DirectoryWatcher::DirectoryWatcherDetail::watch(DirectoryWatcherDetail* watcher)
+	int DirectoryWatcher::DirectoryWatcherDetail::getFileDescriptor() const noexcept
 	{
-		if (not watcher->init())
-		{
-			watcher->m_initCalled = true;
-			return;
-		}
+		return m_fd;
+	}
+
+	Optional<DirectoryWatcher::DirectoryWatcherDetail::Clock::time_point> DirectoryWatcher::DirectoryWatcherDetail::flushChanges(const Clock::time_point now)
+	{
+		std::lock_guard lock{ m_changesMutex };
 
-		watcher->m_initCalled = true;
+		Optional<Clock::time_point> nextDeadline;
 
-		while (not watcher->m_abort)
+		auto it = m_pendingChanges.begin();
+
+		while (it != m_pendingChanges.end())
 		{
-			watcher->update();
+			if (it->deadline <= now)
+			{
+				m_fileChanges.push_back(FileChange{ std::move(it->path), it->action });
+				it = m_pendingChanges.erase(it);
+			}
+			else
+			{
+				if ((not nextDeadline) || (it->deadline < *nextDeadline))
+				{
+					nextDeadline = it->deadline;
+				}
+
+				++it;
+			}
 		}
+
+		return nextDeadline;
 	}
 
 	bool DirectoryWatcher::DirectoryWatcherDetail::init()
 	{
-		m_fd = inotify_init();
+		m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
 		if (m_fd < 0)
 		{
 			LOG_FAIL(U"❌ DirectoryWatcher: inotify_init() failed. `{}`"_fmt(m_targetDirectory));
@@ -151,32 +178,32 @@ namespace s3d
 		return true;
 	}
 
-	void DirectoryWatcher::DirectoryWatcherDetail::update()
+	void DirectoryWatcher::DirectoryWatcherDetail::onReadable()
 	{
-		fd_set watch_set;
-		FD_ZERO(&watch_set);
-		FD_SET(m_fd, &watch_set);
-
-		struct timeval timeout;
-		timeout.tv_sec = 0;
-		timeout.tv_usec = 10000; // 10ms
+		for (;;)
+		{
+			const ssize_t length = read(m_fd, m_buffer.data(), EventBufferSize);
 
-		int ret = select(m_fd + 1, &watch_set, NULL, NULL, &timeout);
-		if (ret <= 0)
-			return;
+			if (length <= 0)
+			{
+				if ((length < 0) && (errno != EAGAIN) && (errno != EINTR))
+				{
+					LOG_FAIL(U"❌ DirectoryWatcher: read() failed. `{}`"_fmt(m_targetDirectory));
+				}
 
-		if (!FD_ISSET(m_fd, &watch_set))
-			return;
+				return;
+			}
 
-		int length = read(m_fd, m_buffer.data(), EventBufferSize);
-		if (length < 0)
-		{
-			LOG_FAIL(U"❌ DirectoryWatcher: read() failed. `{}`"_fmt(m_targetDirectory));
-			return;
+			parseEvents(static_cast<size_t>(length));
 		}
+	}
+
+	void DirectoryWatcher::DirectoryWatcherDetail::parseEvents(const size_t length)
+	{
+		const Clock::time_point now = Clock::now();
 
 		struct inotify_event* event;
-		for (int i = 0; i < length; i += (EventSize + event->len))
+		for (size_t i = 0; i < length; i += (EventSize + event->len))
 		{
 			event = (struct inotify_event*)&m_buffer[i];
 
@@ -186,18 +213,26 @@ namespace s3d
 			if (event->wd == -1 || event->mask & IN_Q_OVERFLOW)
 			{
 				LOG_FAIL(U"❌ DirectoryWatcher: inotify event buffer overflowed. `{}`"_fmt(m_targetDirectory));
+				continue;
+			}
+
+			const auto watched = m_watched_directories.left.find(event->wd);
+
+			if (watched == m_watched_directories.left.end())
+			{
+				continue;
 			}
 
 			if (event->mask & IN_MODIFY)
 			{
-				event_path = m_watched_directories.left.at(event->wd) + Unicode::Widen(event->name);
+				event_path = watched->second + Unicode::Widen(event->name);
 				action = FileAction::Modified;
 
 				//LOG_INFO(U"ℹ️ DirectoryWatcher: file modified. `{}`"_fmt(event_path));
 			}
 			else if (event->mask & IN_CREATE || event->mask & IN_MOVED_TO)
 			{
-				current_path = m_watched_directories.left.at(event->wd);
+				current_path = watched->second;
 				event_path = FileSystem::FullPath(current_path + Unicode::Widen(event->name));
 
 				action = FileAction::Added;
@@ -230,13 +265,13 @@ namespace s3d
 				if (event->mask & IN_ISDIR)
 				{
 					// この時点でevent_pathのディレクトリは存在しないのでFilesystem::FullPath()はうまく動かない
-					event_path = m_watched_directories.left.at(event->wd) + Unicode::Widen(event->name) + U'/';
+					event_path = watched->second + Unicode::Widen(event->name) + U'/';
 
 					//LOG_INFO(U"ℹ️ DirectoryWatcher: directory deleted. `{}`"_fmt(event_path));
 				}
 				else
 				{
-					event_path = m_watched_directories.left.at(event->wd) + Unicode::Widen(event->name);
+					event_path = watched->second + Unicode::Widen(event->name);
 
 					//LOG_INFO(U"ℹ️ DirectoryWatcher: file deleted. `{}`"_fmt(event_path));
 				}
@@ -248,7 +283,7 @@ namespace s3d
 			}
 			else if (event->mask & IN_IGNORED)
 			{
-				event_path = m_watched_directories.left.at(event->wd);
+				event_path = watched->second;
 				m_watched_directories.left.erase(event->wd);
 				if (event_path == m_targetDirectory)
 				{
@@ -260,11 +295,44 @@ namespace s3d
 					continue; // m_changesに追加しない
 			}
 
+			addChange(std::move(event_path), action, now);
+		}
+	}
+
+	void DirectoryWatcher::DirectoryWatcherDetail::addChange(FilePath&& path, const FileAction action, const Clock::time_point now)
+	{
+		std::lock_guard lock{ m_changesMutex };
+
+		// 待機時間内の同じファイルへの変更は 1 つにまとめる
+		for (auto it = m_pendingChanges.begin(); it != m_pendingChanges.end(); ++it)
+		{
+			if (it->path != path)
+			{
+				continue;
+			}
+
+			if ((it->action == FileAction::Added) && (action == FileAction::Removed))
 			{
-				std::lock_guard lock{ m_changesMutex };
-				m_fileChanges.push_back(FileChange{ std::move(event_path), action });
+				// 作成されてすぐに削除された一時ファイル
+				m_pendingChanges.erase(it);
+				return;
 			}
+
+			if ((it->action == FileAction::Removed) && (action == FileAction::Added))
+			{
+				// 削除と作成による置き換え（アトミックな保存）
+				it->action = FileAction::Modified;
+			}
+			else if (not ((it->action == FileAction::Added) && (action == FileAction::Modified)))
+			{
+				it->action = action;
+			}
+
+			it->deadline = (now + DebounceDuration);
+			return;
 		}
+
+		m_pendingChanges.push_back(PendingChange{ std::move(path), action, (now + DebounceDuration) });
 	}
 
 	void DirectoryWatcher::DirectoryWatcherDetail::dispose()
@@ -282,6 +350,7 @@ namespace s3d
         if (m_fd != -1)
         {
 		    close(m_fd);
+			m_fd = -1;
         }
 	}
 }
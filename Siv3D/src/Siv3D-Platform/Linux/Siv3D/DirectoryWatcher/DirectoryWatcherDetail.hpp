@@ -11,19 +11,23 @@
 
 # pragma once
 # include <climits>
+# include <chrono>
+# include <mutex>
 # include <Siv3D/DirectoryWatcher.hpp>
+# include <Siv3D/Optional.hpp>
 # include <sys/inotify.h>
 # include <boost/bimap.hpp>
+# include "DirectoryWatcherReactor.hpp"
 
 namespace s3d
 {
-	class DirectoryWatcher::DirectoryWatcherDetail
+	class DirectoryWatcher::DirectoryWatcherDetail final : public DirectoryWatcherReactor::Watcher
 	{
 	public:
 
 		explicit DirectoryWatcherDetail(FilePathView directory);
 
-		~DirectoryWatcherDetail();
+		~DirectoryWatcherDetail() override;
 
 		bool isActive() const;
 
@@ -33,8 +37,21 @@ namespace s3d
 
 		const FilePath& directory() const noexcept;
 
+		using Clock = DirectoryWatcherReactor::Clock;
+
+		int getFileDescriptor() const noexcept override;
+
+		/// @brief 読み取り可能になった inotify のイベントをすべて処理します。
+		/// @remark 共有のリアクタースレッドから呼ばれます。
+		void onReadable() override;
+
+		Optional<Clock::time_point> flushChanges(Clock::time_point now) override;
+
 	private:
 
+		/// @brief 同じファイルへの連続した変更をまとめるための待機時間
+		constexpr static Clock::duration DebounceDuration = std::chrono::milliseconds{ 50 };
+
 		constexpr static size_t EventSize = sizeof(inotify_event);
 		constexpr static size_t EventBufferSize = ((EventSize + NAME_MAX + 1) * 4096);
 		constexpr static size_t WatchMask = (IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MODIFY | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
@@ -43,10 +60,6 @@ namespace s3d
 
 		Array<uint8_t> m_buffer;
 
-		std::thread m_thread;
-
-		std::atomic<bool> m_initCalled = false;
-
 		bool m_isActive = false;
 
 		bool m_disposed = false;
@@ -57,17 +70,28 @@ namespace s3d
 		using bimap_value_t = bimap_t::value_type;
 		bimap_t m_watched_directories;
 
-		std::atomic<bool> m_abort = false;
+		struct PendingChange
+		{
+			FilePath path;
+
+			FileAction action = FileAction::Unknown;
+
+			Clock::time_point deadline;
+		};
 
 		std::mutex m_changesMutex;
-		
-		Array<FileChange> m_fileChanges;	
 
-		static void watch(DirectoryWatcherDetail* watcher);
+		/// @brief 待機時間が経過していない変更
+		Array<PendingChange> m_pendingChanges;
+
+		/// @brief 確定した変更
+		Array<FileChange> m_fileChanges;
 
 		bool init();
 
-		void update();
+		void parseEvents(size_t length);
+
+		void addChange(FilePath&& path, FileAction action, Clock::time_point now);
 
 		void dispose();
 	};
@@ -0,0 +1,181 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <unistd.h>
+# include <sys/epoll.h>
+# include <sys/eventfd.h>
+# include <Siv3D/EngineLog.hpp>
+# include "DirectoryWatcherReactor.hpp"
+
+namespace s3d
+{
+	DirectoryWatcherReactor::DirectoryWatcherReactor()
+	{
+		m_epollFD = ::epoll_create1(EPOLL_CLOEXEC);
+		m_wakeFD = ::eventfd(0, (EFD_NONBLOCK | EFD_CLOEXEC));
+
+		if ((m_epollFD < 0) || (m_wakeFD < 0))
+		{
+			LOG_FAIL(U"❌ DirectoryWatcher: Failed to create epoll or eventfd");
+			return;
+		}
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.ptr = nullptr;
+
+		if (::epoll_ctl(m_epollFD, EPOLL_CTL_ADD, m_wakeFD, &event) != 0)
+		{
+			LOG_FAIL(U"❌ DirectoryWatcher: epoll_ctl() failed");
+			return;
+		}
+
+		m_thread = std::thread{ [this]() { run(); } };
+	}
+
+	DirectoryWatcherReactor::~DirectoryWatcherReactor()
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+			m_stop = true;
+		}
+
+		wake();
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+		if (m_wakeFD != -1)
+		{
+			::close(m_wakeFD);
+		}
+
+		if (m_epollFD != -1)
+		{
+			::close(m_epollFD);
+		}
+	}
+
+	bool DirectoryWatcherReactor::add(Watcher* watcher)
+	{
+		if (not m_thread.joinable())
+		{
+			return false;
+		}
+
+		std::lock_guard lock{ m_mutex };
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.ptr = watcher;
+
+		if (::epoll_ctl(m_epollFD, EPOLL_CTL_ADD, watcher->getFileDescriptor(), &event) != 0)
+		{
+			LOG_FAIL(U"❌ DirectoryWatcher: epoll_ctl() failed");
+			return false;
+		}
+
+		m_watchers.insert(watcher);
+
+		return true;
+	}
+
+	void DirectoryWatcherReactor::remove(Watcher* watcher)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		if (m_watchers.erase(watcher))
+		{
+			::epoll_ctl(m_epollFD, EPOLL_CTL_DEL, watcher->getFileDescriptor(), nullptr);
+		}
+	}
+
+	DirectoryWatcherReactor& DirectoryWatcherReactor::Get()
+	{
+		static DirectoryWatcherReactor reactor;
+		return reactor;
+	}
+
+	void DirectoryWatcherReactor::run()
+	{
+		constexpr int32 MaxEvents = 64;
+
+		epoll_event events[MaxEvents];
+
+		int timeoutMillisec = -1;
+
+		for (;;)
+		{
+			// 確定待ちの変更が無い間は、イベントが来るまで無期限に待機する
+			const int count = ::epoll_wait(m_epollFD, events, MaxEvents, timeoutMillisec);
+
+			std::lock_guard lock{ m_mutex };
+
+			if (m_stop)
+			{
+				return;
+			}
+
+			for (int i = 0; i < count; ++i)
+			{
+				if (events[i].data.ptr == nullptr)
+				{
+					uint64 value;
+					[[maybe_unused]] const auto result = ::read(m_wakeFD, &value, sizeof(value));
+					continue;
+				}
+
+				// remove() 済みのイベントは無視する
+				Watcher* watcher = static_cast<Watcher*>(events[i].data.ptr);
+
+				if (m_watchers.contains(watcher))
+				{
+					watcher->onReadable();
+				}
+			}
+
+			const auto now = Clock::now();
+			Optional<Clock::time_point> nextDeadline;
+
+			for (auto& watcher : m_watchers)
+			{
+				if (const auto deadline = watcher->flushChanges(now))
+				{
+					if ((not nextDeadline) || (*deadline < *nextDeadline))
+					{
+						nextDeadline = deadline;
+					}
+				}
+			}
+
+			if (nextDeadline)
+			{
+				const auto wait = std::chrono::ceil<std::chrono::milliseconds>(*nextDeadline - now);
+				timeoutMillisec = Max(static_cast<int>(wait.count()), 1);
+			}
+			else
+			{
+				timeoutMillisec = -1;
+			}
+		}
+	}
+
+	void DirectoryWatcherReactor::wake()
+	{
+		if (m_wakeFD != -1)
+		{
+			const uint64 value = 1;
+			[[maybe_unused]] const auto result = ::write(m_wakeFD, &value, sizeof(value));
+		}
+	}
+}
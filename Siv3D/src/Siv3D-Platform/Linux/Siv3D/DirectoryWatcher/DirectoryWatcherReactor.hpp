@@ -0,0 +1,85 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <mutex>
+# include <chrono>
+# include <thread>
+# include <Siv3D/HashSet.hpp>
+# include <Siv3D/Optional.hpp>
+
+namespace s3d
+{
+	/// @brief すべての DirectoryWatcher の inotify を 1 つの epoll で待機するスレッド
+	/// @remark 変更が無い間はスレッドは epoll_wait() でブロックし、CPU を消費しません。
+	class DirectoryWatcherReactor
+	{
+	public:
+
+		using Clock = std::chrono::steady_clock;
+
+		/// @brief リアクターに登録する監視対象
+		class Watcher
+		{
+		public:
+
+			virtual ~Watcher() = default;
+
+			/// @brief epoll で待機するファイルディスクリプタを返します。
+			[[nodiscard]]
+			virtual int getFileDescriptor() const noexcept = 0;
+
+			/// @brief ファイルディスクリプタが読み取り可能になったときに呼ばれます。
+			virtual void onReadable() = 0;
+
+			/// @brief 待機時間が経過した変更を確定します。
+			/// @param now 現在の時刻
+			/// @return 次に確定する変更がある場合はその時刻、それ以外の場合は none
+			virtual Optional<Clock::time_point> flushChanges(Clock::time_point now) = 0;
+		};
+
+		~DirectoryWatcherReactor();
+
+		/// @brief 監視を開始します。
+		/// @param watcher 監視するディレクトリ
+		/// @return 監視を開始できた場合 true, それ以外の場合は false
+		bool add(Watcher* watcher);
+
+		/// @brief 監視を終了します。
+		/// @param watcher 監視を終了するディレクトリ
+		/// @remark この関数から戻った後、watcher のメンバ関数がリアクタースレッドから呼ばれることはありません。
+		void remove(Watcher* watcher);
+
+		[[nodiscard]]
+		static DirectoryWatcherReactor& Get();
+
+	private:
+
+		DirectoryWatcherReactor();
+
+		int m_epollFD = -1;
+
+		/// @brief 監視対象の変更や終了をスレッドに通知するための eventfd
+		int m_wakeFD = -1;
+
+		std::thread m_thread;
+
+		std::mutex m_mutex;
+
+		HashSet<Watcher*> m_watchers;
+
+		bool m_stop = false;
+
+		void run();
+
+		void wake();
+	};
+}
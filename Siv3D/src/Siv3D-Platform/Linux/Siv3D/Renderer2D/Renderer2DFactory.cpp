@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineOptions.hpp>
 # include <Siv3D/Renderer2D/Null/CRenderer2D_Null.hpp>
+# include <Siv3D/Renderer2D/Software/CRenderer2D_Software.hpp>
 # include <Siv3D/Renderer2D/GL4/CRenderer2D_GL4.hpp>
 # include <Siv3D/Renderer2D/GLES3/CRenderer2D_GLES3.hpp>
 
@@ -20,6 +21,11 @@ namespace s3d
 	{
 		if (g_engineOptions.renderer == EngineOption::Renderer::Headless)
 		{
+			if (g_engineOptions.headlessRenderer == EngineOption::HeadlessRenderer::Software)
+			{
+				return new CRenderer2D_Software;
+			}
+
 			return new CRenderer2D_Null;
 		}
 		else if (g_engineOptions.renderer == EngineOption::Renderer::WebGL2)
@@ -40,6 +40,8 @@ namespace s3d
 
 	GL4Vertex2DBatch::~GL4Vertex2DBatch()
 	{
+		releasePersistentRing();
+
 		if (m_indexBuffer)
 		{
 			::glDeleteBuffers(1, &m_indexBuffer);
@@ -89,11 +91,37 @@ namespace s3d
 		}
 		::glBindVertexArray(0);
 
+		m_currentVAO = m_vao;
+		m_currentVertexBuffer = m_vertexBuffer;
+
+		if (initPersistentRing())
+		{
+			LOG_INFO(U"ℹ️ GL4Vertex2DBatch: persistent mapped ring buffer enabled");
+		}
+		else
+		{
+			LOG_INFO(U"ℹ️ GL4Vertex2DBatch: persistent mapped ring buffer is not available. Falling back to glMapBufferRange");
+		}
+
 		return true;
 	}
 
 	Vertex2DBufferPointer GL4Vertex2DBatch::requestBuffer(const uint16 vertexSize, const uint32 indexSize, GL4Renderer2DCommandManager& commandManager)
 	{
+		// 最初のバッチはリングバッファに直接書き込む
+		if (hasPersistentRing() && (m_batches.size() == 1))
+		{
+			if (const auto& firstBatch = m_batches.front();
+				(((firstBatch.vertexPos + vertexSize) <= VertexBufferSize) && ((firstBatch.indexPos + indexSize) <= IndexBufferSize))) SIV3D_LIKELY
+			{
+				return requestPersistentBuffer(vertexSize, indexSize);
+			}
+
+			// 収まらない場合、2 つ目以降のバッチは従来どおり配列に書き込み、updateBuffers() でコピーする
+			commandManager.pushUpdateBuffers(1);
+			m_batches.emplace_back();
+		}
+
 		// VB
 		if (const uint32 vertexArrayWritePosTarget = m_vertexArrayWritePos + vertexSize;
 			m_vertexArray.size() < vertexArrayWritePosTarget) SIV3D_UNLIKELY
@@ -104,7 +132,7 @@ namespace s3d
 			}
 
 			const size_t newVertexArraySize = detail::CalculateNewArraySize(m_vertexArray.size(), vertexArrayWritePosTarget);
-			LOG_TRACE(U"ℹ️ Resized GL4Vertex2DBatch::m_vertexArray (size: {} -> {})"_fmt(m_vertexArray.size(), newVertexArraySize));
+			LOG_TRACE_EVENT(U"ℹ️ Resized GL4Vertex2DBatch::m_vertexArray (size: {} -> {})", m_vertexArray.size(), newVertexArraySize);
 			m_vertexArray.resize(newVertexArraySize);
 		}
 
@@ -118,7 +146,7 @@ namespace s3d
 			}
 
 			const size_t newIndexArraySize = detail::CalculateNewArraySize(m_indexArray.size(), indexArrayWritePosTarget);
-			LOG_TRACE(U"ℹ️ Resized GL4Vertex2DBatch::m_indexArray (size: {} -> {})"_fmt(m_indexArray.size(), newIndexArraySize));
+			LOG_TRACE_EVENT(U"ℹ️ Resized GL4Vertex2DBatch::m_indexArray (size: {} -> {})", m_indexArray.size(), newIndexArraySize);
 			m_indexArray.resize(newIndexArraySize);
 		}
 
@@ -147,6 +175,14 @@ namespace s3d
 
 	void GL4Vertex2DBatch::reset()
 	{
+		if (hasPersistentRing() && m_ring.segmentAcquired)
+		{
+			// この区画を使う描画コマンドはすべて発行済み
+			m_ring.fences[m_ring.segmentIndex] = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			m_ring.segmentIndex = ((m_ring.segmentIndex + 1) % m_ring.fences.size());
+			m_ring.segmentAcquired = false;
+		}
+
 		m_batches.clear();
 		m_batches.emplace_back();
 
@@ -156,28 +192,46 @@ namespace s3d
 
 	void GL4Vertex2DBatch::setBuffers()
 	{
-		::glBindVertexArray(m_vao);
-		::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+		::glBindVertexArray(m_currentVAO);
+		::glBindBuffer(GL_ARRAY_BUFFER, m_currentVertexBuffer);
 	}
 
 	BatchInfo2D GL4Vertex2DBatch::updateBuffers(const size_t batchIndex)
 	{
 		assert(batchIndex < m_batches.size());
 
+		BatchInfo2D batchInfo;
+		const auto& currentBatch = m_batches[batchIndex];
+
+		if (hasPersistentRing() && (batchIndex == 0))
+		{
+			// 頂点とインデックスは requestBuffer() の時点でリングバッファに書き込まれている
+			m_currentVAO = m_ring.vao;
+			m_currentVertexBuffer = m_ring.vertexBuffer;
+			::glBindVertexArray(m_currentVAO);
+			::glBindBuffer(GL_ARRAY_BUFFER, m_currentVertexBuffer);
+
+			batchInfo.indexCount = currentBatch.indexPos;
+			batchInfo.startIndexLocation = (m_ring.segmentIndex * IndexBufferSize);
+			batchInfo.baseVertexLocation = (m_ring.segmentIndex * VertexBufferSize);
+			batchInfo.uploadedBytes = static_cast<uint32>((sizeof(Vertex2D) * currentBatch.vertexPos) + (sizeof(Vertex2D::IndexType) * currentBatch.indexPos));
+			return batchInfo;
+		}
+
 		size_t vertexArrayReadPos = 0;
 		size_t indexArrayReadPos = 0;
 
-		for (size_t i = 0; i < batchIndex; ++i)
+		// リングバッファを使う場合、最初のバッチは配列に含まれない
+		for (size_t i = (hasPersistentRing() ? 1 : 0); i < batchIndex; ++i)
 		{
 			vertexArrayReadPos += m_batches[i].vertexPos;
 			indexArrayReadPos += m_batches[i].indexPos;
 		}
 
-		::glBindVertexArray(m_vao);
-		::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
-
-		BatchInfo2D batchInfo;
-		const auto& currentBatch = m_batches[batchIndex];
+		m_currentVAO = m_vao;
+		m_currentVertexBuffer = m_vertexBuffer;
+		::glBindVertexArray(m_currentVAO);
+		::glBindBuffer(GL_ARRAY_BUFFER, m_currentVertexBuffer);
 
 		// VB
 		if (const uint16 vertexSize = currentBatch.vertexPos)
@@ -198,6 +252,7 @@ namespace s3d
 			::glUnmapBuffer(GL_ARRAY_BUFFER);
 
 			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(Vertex2D) * vertexSize);
 			m_vertexBufferWritePos += vertexSize;
 		}
 
@@ -221,6 +276,7 @@ namespace s3d
 
 			batchInfo.indexCount = indexSize;
 			batchInfo.startIndexLocation = m_indexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(Vertex2D::IndexType) * indexSize);
 			m_indexBufferWritePos += indexSize;
 		}
 
@@ -232,4 +288,131 @@ namespace s3d
 		m_vertexArrayWritePos	+= vertexSize;
 		m_indexArrayWritePos	+= indexSize;
 	}
+
+	bool GL4Vertex2DBatch::initPersistentRing()
+	{
+		if (not (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage))
+		{
+			return false;
+		}
+
+		const size_t segmentCount = m_ring.fences.size();
+		const GLsizeiptr vertexBufferSize = (sizeof(Vertex2D) * VertexBufferSize * segmentCount);
+		const GLsizeiptr indexBufferSize = (sizeof(Vertex2D::IndexType) * IndexBufferSize * segmentCount);
+		constexpr GLbitfield Flags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+		::glGenVertexArrays(1, &m_ring.vao);
+		::glGenBuffers(1, &m_ring.vertexBuffer);
+		::glGenBuffers(1, &m_ring.indexBuffer);
+
+		::glBindVertexArray(m_ring.vao);
+		{
+			::glBindBuffer(GL_ARRAY_BUFFER, m_ring.vertexBuffer);
+			::glBufferStorage(GL_ARRAY_BUFFER, vertexBufferSize, nullptr, Flags);
+			m_ring.pVertex = static_cast<Vertex2D*>(::glMapBufferRange(GL_ARRAY_BUFFER, 0, vertexBufferSize, Flags));
+
+			::glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 32, (const GLubyte*)0);	// Vertex2D::pos
+			::glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 32, (const GLubyte*)8);	// Vertex2D::tex
+			::glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 32, (const GLubyte*)16);	// Vertex2D::color
+
+			::glEnableVertexAttribArray(0);
+			::glEnableVertexAttribArray(1);
+			::glEnableVertexAttribArray(2);
+
+			::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ring.indexBuffer);
+			::glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, indexBufferSize, nullptr, Flags);
+			m_ring.pIndex = static_cast<Vertex2D::IndexType*>(::glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, indexBufferSize, Flags));
+		}
+		::glBindVertexArray(0);
+
+		if ((not m_ring.pVertex) || (not m_ring.pIndex))
+		{
+			LOG_FAIL(U"❌ GL4Vertex2DBatch: glMapBufferRange() for the persistent mapped ring buffer failed");
+			releasePersistentRing();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool GL4Vertex2DBatch::hasPersistentRing() const noexcept
+	{
+		return (m_ring.pVertex != nullptr);
+	}
+
+	Vertex2DBufferPointer GL4Vertex2DBatch::requestPersistentBuffer(const uint16 vertexSize, const uint32 indexSize)
+	{
+		if (not m_ring.segmentAcquired)
+		{
+			// 前回この区画を使った描画（3 回前の flush）の完了を待つ
+			if (GLsync& fence = m_ring.fences[m_ring.segmentIndex])
+			{
+				while (::glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000'000) == GL_TIMEOUT_EXPIRED) {}
+
+				::glDeleteSync(fence);
+				fence = nullptr;
+			}
+
+			m_ring.segmentAcquired = true;
+		}
+
+		auto& firstBatch = m_batches.front();
+		Vertex2D* const pVertex = (m_ring.pVertex + (m_ring.segmentIndex * VertexBufferSize) + firstBatch.vertexPos);
+		Vertex2D::IndexType* const pIndex = (m_ring.pIndex + (m_ring.segmentIndex * IndexBufferSize) + firstBatch.indexPos);
+		const auto indexOffset = firstBatch.vertexPos;
+
+		firstBatch.advance(vertexSize, indexSize);
+
+		return{ pVertex, pIndex, indexOffset };
+	}
+
+	void GL4Vertex2DBatch::releasePersistentRing()
+	{
+		for (auto& fence : m_ring.fences)
+		{
+			if (fence)
+			{
+				::glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+
+		if (m_ring.vao)
+		{
+			::glBindVertexArray(m_ring.vao);
+
+			if (m_ring.pIndex)
+			{
+				::glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+				m_ring.pIndex = nullptr;
+			}
+
+			if (m_ring.pVertex)
+			{
+				::glBindBuffer(GL_ARRAY_BUFFER, m_ring.vertexBuffer);
+				::glUnmapBuffer(GL_ARRAY_BUFFER);
+				m_ring.pVertex = nullptr;
+			}
+
+			::glBindVertexArray(0);
+		}
+
+		if (m_ring.indexBuffer)
+		{
+			::glDeleteBuffers(1, &m_ring.indexBuffer);
+			m_ring.indexBuffer = 0;
+		}
+
+		if (m_ring.vertexBuffer)
+		{
+			::glDeleteBuffers(1, &m_ring.vertexBuffer);
+			m_ring.vertexBuffer = 0;
+		}
+
+		if (m_ring.vao)
+		{
+			::glDeleteVertexArrays(1, &m_ring.vao);
+			m_ring.vao = 0;
+		}
+	}
 }
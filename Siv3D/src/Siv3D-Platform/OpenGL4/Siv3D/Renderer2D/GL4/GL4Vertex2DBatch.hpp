@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <array>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Common/OpenGL.hpp>
 # include <Siv3D/Vertex2D.hpp>
@@ -53,6 +54,37 @@ namespace s3d
 
 		Array<BatchBufferPos> m_batches;
 
+		/// @brief 永続マップされたリングバッファ（OpenGL 4.4 または ARB_buffer_storage が必要）
+		/// @remark 各フレームの最初のバッチは、リングの 1 区画に直接書き込まれ、コピーを必要としません。
+		struct PersistentRing
+		{
+			GLuint vao = 0;
+
+			GLuint vertexBuffer = 0;
+
+			GLuint indexBuffer = 0;
+
+			Vertex2D* pVertex = nullptr;
+
+			Vertex2D::IndexType* pIndex = nullptr;
+
+			/// @brief 各区画を使った描画の完了を示すフェンス
+			std::array<GLsync, 3> fences{};
+
+			/// @brief 現在の区画
+			uint32 segmentIndex = 0;
+
+			/// @brief 現在の区画の GPU による使用が完了していることを確認済みであるか
+			bool segmentAcquired = false;
+		};
+
+		PersistentRing m_ring;
+
+		/// @brief 現在のバッチの頂点配列オブジェクトと頂点バッファ
+		GLuint m_currentVAO = 0;
+
+		GLuint m_currentVertexBuffer = 0;
+
 		static constexpr uint32 InitialVertexArraySize	= 4096;
 		static constexpr uint32 InitialIndexArraySize	= (4096 * 8); // 32,768
 
@@ -64,6 +96,17 @@ namespace s3d
 
 		void advanceArrayWritePos(uint16 vertexSize, uint32 indexSize) noexcept;
 
+		[[nodiscard]]
+		bool initPersistentRing();
+
+		[[nodiscard]]
+		bool hasPersistentRing() const noexcept;
+
+		[[nodiscard]]
+		Vertex2DBufferPointer requestPersistentBuffer(uint16 vertexSize, uint32 indexSize);
+
+		void releasePersistentRing();
+
 	public:
 
 		GL4Vertex2DBatch();
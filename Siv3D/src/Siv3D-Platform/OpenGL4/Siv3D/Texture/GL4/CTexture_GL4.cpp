@@ -14,6 +14,7 @@
 # include <Siv3D/ImageProcessing.hpp>
 # include <Siv3D/System.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Texture/TextureCommon.hpp>
 
 namespace s3d
@@ -116,6 +117,8 @@ namespace s3d
 			return pushRequest(image, {}, desc);
 		}
 
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		auto texture = std::make_unique<GL4Texture>(image, desc);
 
 		if (not texture->isInitialized())
@@ -140,6 +143,8 @@ namespace s3d
 			return pushRequest(image, mips, desc);
 		}
 
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		auto texture = std::make_unique<GL4Texture>(image, mips, desc);
 
 		if (not texture->isInitialized())
@@ -336,11 +341,15 @@ namespace s3d
 
 	bool CTexture_GL4::fill(const Texture::IDType handleID, const void* src, uint32 stride, const bool wait)
 	{
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		return m_textures[handleID]->fill(src, stride, wait);
 	}
 
 	bool CTexture_GL4::fillRegion(const Texture::IDType handleID, const void* src, const uint32 stride, const Rect& rect, const bool wait)
 	{
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		return m_textures[handleID]->fillRegion(src, stride, rect, wait);
 	}
 
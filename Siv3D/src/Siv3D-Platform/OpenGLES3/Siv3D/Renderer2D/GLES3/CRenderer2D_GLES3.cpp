@@ -14,6 +14,7 @@
 # include <Siv3D/Resource.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/ScopeGuard.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
@@ -111,12 +112,6 @@ namespace s3d
 			}
 		}
 
-		// バッファ作成関数を作成
-		m_bufferCreator = [this](Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize)
-		{
-			return m_batches[m_drawCount % 2].requestBuffer(vertexSize, indexSize, m_commandManager);
-		};
-
 		// シャドウ画像を作成
 		{
 			const Image boxShadowImage{ Resource(U"engine/texture/box-shadow/256.png") };
@@ -199,7 +194,7 @@ namespace s3d
 
 	void CRenderer2D_GLES3::addTriangle(const Float2(&points)[3], const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_bufferCreator, points, color))
+		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_batchBufferCreator, points, color))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -217,7 +212,7 @@ namespace s3d
 
 	void CRenderer2D_GLES3::addTriangle(const Float2(&points)[3], const Float4(&colors)[3])
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_bufferCreator, points, colors))
+		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_batchBufferCreator, points, colors))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -235,7 +230,7 @@ namespace s3d
 
 	void CRenderer2D_GLES3::addRect(const FloatRect& rect, const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_bufferCreator, rect, color))
+		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_batchBufferCreator, rect, color))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -253,7 +248,7 @@ namespace s3d
 
 	void CRenderer2D_GLES3::addRect(const FloatRect& rect, const Float4(&colors)[4])
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_bufferCreator, rect, colors))
+		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_batchBufferCreator, rect, colors))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -433,7 +428,7 @@ namespace s3d
 
 	void CRenderer2D_GLES3::addQuad(const FloatQuad& quad, const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, color))
+		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_batchBufferCreator, quad, color))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -451,7 +446,7 @@ namespace s3d
 
 	void CRenderer2D_GLES3::addQuad(const FloatQuad& quad, const Float4(&colors)[4])
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, colors))
+		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_batchBufferCreator, quad, colors))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -659,7 +654,7 @@ namespace s3d
 
 	void CRenderer2D_GLES3::addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTextureRegion(m_bufferCreator, rect, uv, color))
+		if (const auto indexCount = Vertex2DBuilder::BuildTextureRegion(m_batchBufferCreator, rect, uv, color))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -678,7 +673,7 @@ namespace s3d
 
 	void CRenderer2D_GLES3::addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTextureRegion(m_bufferCreator, rect, uv, colors))
+		if (const auto indexCount = Vertex2DBuilder::BuildTextureRegion(m_batchBufferCreator, rect, uv, colors))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -716,7 +711,7 @@ namespace s3d
 
 	void CRenderer2D_GLES3::addTexturedQuad(const Texture& texture, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTexturedQuad(m_bufferCreator, quad, uv, color))
+		if (const auto indexCount = Vertex2DBuilder::BuildTexturedQuad(m_batchBufferCreator, quad, uv, color))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -828,7 +823,7 @@ namespace s3d
 		}
 	}
 
-	void CRenderer2D_GLES3::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+	void CRenderer2D_GLES3::addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
 	{
@@ -849,6 +844,89 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_GLES3::addRects(const RectF* rects, const ColorF* colors, const size_t count, const Float4& color)
+	{
+		// 状態の確認とコマンドの発行は、バッファ要求 1 回につき 1 度だけ行う
+		for (size_t i = 0; i < count; i += Vertex2DBuilder::MaxBulkQuadCount)
+		{
+			const size_t n = Min((count - i), Vertex2DBuilder::MaxBulkQuadCount);
+			const auto indexCount = Vertex2DBuilder::BuildRects(m_bufferCreator, (rects + i), (colors ? (colors + i) : nullptr), n, color);
+
+			if (not indexCount)
+			{
+				return;
+			}
+
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_GLES3::addCircles(const Circle* circles, const ColorF* colors, const size_t count, const Float4& color)
+	{
+		const float scale = getMaxScaling();
+
+		for (size_t i = 0; i < count;)
+		{
+			size_t n = 0;
+			const auto indexCount = Vertex2DBuilder::BuildCircles(m_bufferCreator, (circles + i), (colors ? (colors + i) : nullptr), (count - i), color, scale, n);
+
+			if (not indexCount)
+			{
+				return;
+			}
+
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+			i += n;
+		}
+	}
+
+	void CRenderer2D_GLES3::addTexturedQuads(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Mat3x2* transforms, const ColorF* colors, const size_t count, const Float4& color)
+	{
+		for (size_t i = 0; i < count; i += Vertex2DBuilder::MaxBulkQuadCount)
+		{
+			const size_t n = Min((count - i), Vertex2DBuilder::MaxBulkQuadCount);
+			const auto indexCount = Vertex2DBuilder::BuildTexturedQuads(m_bufferCreator, rect, uv, (transforms + i), (colors ? (colors + i) : nullptr), n, color);
+
+			if (not indexCount)
+			{
+				return;
+			}
+
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->textureID);
+			}
+
+			m_commandManager.pushPSTexture(0, texture);
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
 	Float4 CRenderer2D_GLES3::getColorMul() const
 	{
 		return m_commandManager.getCurrentColorMul();
@@ -1090,6 +1168,8 @@ namespace s3d
 
 	void CRenderer2D_GLES3::flush()
 	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
 		GLES3Vertex2DBatch& batch = m_batches[m_drawCount % 2];
 
 		ScopeGuard cleanUp = [this, &batch]()
@@ -1141,6 +1221,7 @@ namespace s3d
 			case GLES3Renderer2DCommandType::UpdateBuffers:
 				{
 					batchInfo = batch.updateBuffers(command.index);
+					m_stat.uploadedBytes += batchInfo.uploadedBytes;
 
 					LOG_COMMAND(U"UpdateBuffers[{}] BatchInfo(indexCount = {}, startIndexLocation = {}, baseVertexLocation = {})"_fmt(
 						command.index, batchInfo.indexCount, batchInfo.startIndexLocation, batchInfo.baseVertexLocation));
@@ -104,7 +104,7 @@ namespace s3d
 			}
 
 			const size_t newVertexArraySize = detail::CalculateNewArraySize(m_vertexArray.size(), vertexArrayWritePosTarget);
-			LOG_TRACE(U"ℹ️ Resized GLES3Vertex2DBatch::m_vertexArray (size: {} -> {})"_fmt(m_vertexArray.size(), newVertexArraySize));
+			LOG_TRACE_EVENT(U"ℹ️ Resized GLES3Vertex2DBatch::m_vertexArray (size: {} -> {})", m_vertexArray.size(), newVertexArraySize);
 			m_vertexArray.resize(newVertexArraySize);
 		}
 
@@ -118,7 +118,7 @@ namespace s3d
 			}
 
 			const size_t newIndexArraySize = detail::CalculateNewArraySize(m_indexArray.size(), indexArrayWritePosTarget);
-			LOG_TRACE(U"ℹ️ Resized GLES3Vertex2DBatch::m_indexArray (size: {} -> {})"_fmt(m_indexArray.size(), newIndexArraySize));
+			LOG_TRACE_EVENT(U"ℹ️ Resized GLES3Vertex2DBatch::m_indexArray (size: {} -> {})", m_indexArray.size(), newIndexArraySize);
 			m_indexArray.resize(newIndexArraySize);
 		}
 
@@ -200,6 +200,7 @@ namespace s3d
 			::glUnmapBuffer(GL_ARRAY_BUFFER);
 
 			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(Vertex2D) * vertexSize);
 			m_vertexBufferWritePos += vertexSize;
 		}
 
@@ -224,6 +225,7 @@ namespace s3d
 
 			batchInfo.indexCount = indexSize;
 			batchInfo.startIndexLocation = m_indexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(Vertex2D::IndexType) * indexSize);
 			m_indexBufferWritePos += indexSize;
 		}
 
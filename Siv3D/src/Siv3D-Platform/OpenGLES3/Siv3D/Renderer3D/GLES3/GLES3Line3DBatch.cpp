@@ -99,7 +99,7 @@ namespace s3d
 			}
 
 			const size_t newVertexArraySize = detail::CalculateNewArraySize(m_vertexArray.size(), vertexArrayWritePosTarget);
-			LOG_TRACE(U"ℹ️ Resized GLES3Line3DBatch::m_vertexArray (size: {} -> {})"_fmt(m_vertexArray.size(), newVertexArraySize));
+			LOG_TRACE_EVENT(U"ℹ️ Resized GLES3Line3DBatch::m_vertexArray (size: {} -> {})", m_vertexArray.size(), newVertexArraySize);
 			m_vertexArray.resize(newVertexArraySize);
 		}
 
@@ -113,7 +113,7 @@ namespace s3d
 			}
 
 			const size_t newIndexArraySize = detail::CalculateNewArraySize(m_indexArray.size(), indexArrayWritePosTarget);
-			LOG_TRACE(U"ℹ️ Resized GLES3Line3DBatch::m_indexArray (size: {} -> {})"_fmt(m_indexArray.size(), newIndexArraySize));
+			LOG_TRACE_EVENT(U"ℹ️ Resized GLES3Line3DBatch::m_indexArray (size: {} -> {})", m_indexArray.size(), newIndexArraySize);
 			m_indexArray.resize(newIndexArraySize);
 		}
 
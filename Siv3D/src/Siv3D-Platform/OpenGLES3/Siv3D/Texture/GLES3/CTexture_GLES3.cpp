@@ -14,6 +14,7 @@
 # include <Siv3D/ImageProcessing.hpp>
 # include <Siv3D/System.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Texture/TextureCommon.hpp>
 
 namespace s3d
@@ -108,7 +109,10 @@ namespace s3d
 		// [Siv3D ToDo] GPU でミップマップを生成する
 		if (detail::HasMipMap(desc))
 		{
-			return create(image, ImageProcessing::GenerateMips(image), desc);
+			MipmapConfig config;
+			config.sRGB = detail::IsSRGB(desc);
+
+			return create(image, ImageProcessing::GenerateMips(image, config), desc);
 		}
 
 		if (not image)
@@ -122,6 +126,8 @@ namespace s3d
 			return pushRequest(image, {}, desc);
 		}
 
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		auto texture = std::make_unique<GLES3Texture>(image, desc);
 
 		if (not texture->isInitialized())
@@ -146,6 +152,8 @@ namespace s3d
 			return pushRequest(image, mips, desc);
 		}
 
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		auto texture = std::make_unique<GLES3Texture>(image, mips, desc);
 
 		if (not texture->isInitialized())
@@ -342,11 +350,15 @@ namespace s3d
 
 	bool CTexture_GLES3::fill(const Texture::IDType handleID, const void* src, uint32 stride, const bool wait)
 	{
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		return m_textures[handleID]->fill(src, stride, wait);
 	}
 
 	bool CTexture_GLES3::fillRegion(const Texture::IDType handleID, const void* src, const uint32 stride, const Rect& rect, const bool wait)
 	{
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		return m_textures[handleID]->fillRegion(src, stride, rect, wait);
 	}
 
@@ -74,7 +74,8 @@ namespace s3d
 		return pImpl->getResponse();
 	}
 
-	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers, const FilePathView path)
+	// Web 版ではブラウザがリクエストの順序を決めるため、priority は使わない
+	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers, const FilePathView path, int32)
 		: pImpl{ std::make_shared<AsyncHTTPTaskDetail>(url, headers, path) } 
 	{
 		pImpl->send(none);
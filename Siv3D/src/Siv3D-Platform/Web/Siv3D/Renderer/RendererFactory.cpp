@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineOptions.hpp>
 # include <Siv3D/Renderer/Null/CRenderer_Null.hpp>
+# include <Siv3D/Renderer/Software/CRenderer_Software.hpp>
 # include <Siv3D/Renderer/GLES3/CRenderer_GLES3.hpp>
 # include <Siv3D/Renderer/WebGPU/CRenderer_WebGPU.hpp>
 
@@ -20,6 +21,11 @@ namespace s3d
 	{
 		if (g_engineOptions.renderer == EngineOption::Renderer::Headless)
 		{
+			if (g_engineOptions.headlessRenderer == EngineOption::HeadlessRenderer::Software)
+			{
+				return new CRenderer_Software;
+			}
+
 			return new CRenderer_Null;
 		}
 		else if (g_engineOptions.renderer == EngineOption::Renderer::WebGPU)
@@ -234,42 +234,55 @@ namespace s3d
 			}
 		}
 
-		AsyncHTTPTask SaveAsync(const URLView url, const FilePathView filePath)
+		AsyncHTTPTask SaveAsync(const URLView url, const FilePathView filePath, const int32 priority)
 		{
-			return GetAsync(url, {}, filePath);
+			return GetAsync(url, {}, filePath, priority);
 		}
 
-		AsyncHTTPTask LoadAsync(const URLView url)
+		AsyncHTTPTask LoadAsync(const URLView url, const int32 priority)
 		{
-			return GetAsync(url, {});
+			return GetAsync(url, {}, priority);
 		}
 
-		AsyncHTTPTask GetAsync(const URLView url, const HashTable<String, String>& headers, const FilePathView filePath)
+		AsyncHTTPTask GetAsync(const URLView url, const HashTable<String, String>& headers, const FilePathView filePath, const int32 priority)
 		{
 			SIV3D_ENGINE(Network)->init();
 
-			return AsyncHTTPTask{ url, headers, filePath };
+			return AsyncHTTPTask{ url, headers, filePath, priority };
 		}
 
-		AsyncHTTPTask GetAsync(const URLView url, const HashTable<String, String>& headers)
+		AsyncHTTPTask GetAsync(const URLView url, const HashTable<String, String>& headers, const int32 priority)
 		{
 			SIV3D_ENGINE(Network)->init();
 
-			return AsyncHTTPTask{ url, headers };
+			return AsyncHTTPTask{ url, headers, priority };
 		}
 
-		AsyncHTTPTask PostAsync(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const FilePathView filePath)
+		AsyncHTTPTask PostAsync(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const FilePathView filePath, const int32 priority)
 		{
 			SIV3D_ENGINE(Network)->init();
 
-			return AsyncHTTPTask{ url, headers, src, size, filePath };
+			return AsyncHTTPTask{ url, headers, src, size, filePath, priority };
 		}
 
-		AsyncHTTPTask PostAsync(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size)
+		AsyncHTTPTask PostAsync(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const int32 priority)
 		{
 			SIV3D_ENGINE(Network)->init();
 
-			return AsyncHTTPTask{ url, headers, src, size };
+			return AsyncHTTPTask{ url, headers, src, size, priority };
+		}
+
+		// Web 版ではブラウザが接続を管理するため、同時に転送する数の上限は記録するだけ
+		static size_t g_maxConcurrency = 8;
+
+		void SetMaxConcurrency(const size_t maxConcurrency)
+		{
+			g_maxConcurrency = Max<size_t>(maxConcurrency, 1);
+		}
+
+		size_t GetMaxConcurrency()
+		{
+			return g_maxConcurrency;
 		}
 	}
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Resource/IResource.hpp>
 # include <Siv3D/Profiler/IProfiler.hpp>
@@ -146,9 +147,15 @@ namespace s3d
 		
 		SIV3D_ENGINE(Addon)->draw();
 		SIV3D_ENGINE(Print)->draw();
-		SIV3D_ENGINE(Renderer)->flush();
+		{
+			SIV3D_PROFILE_ZONE(U"Renderer::flush");
+			SIV3D_ENGINE(Renderer)->flush();
+		}
 		SIV3D_ENGINE(Profiler)->endFrame();
-		SIV3D_ENGINE(Renderer)->present();
+		{
+			SIV3D_PROFILE_ZONE(U"Renderer::present");
+			SIV3D_ENGINE(Renderer)->present();
+		}
 		SIV3D_ENGINE(ScreenCapture)->update();
 		SIV3D_ENGINE(Addon)->postPresent();
 
@@ -171,15 +178,21 @@ namespace s3d
 		SIV3D_ENGINE(Scene)->update();
 		SIV3D_ENGINE(Window)->update();
 		SIV3D_ENGINE(Renderer)->clear();
-		SIV3D_ENGINE(Asset)->update();
-		SIV3D_ENGINE(Cursor)->update();
-		SIV3D_ENGINE(Keyboard)->update();
-		SIV3D_ENGINE(Mouse)->update();
-		SIV3D_ENGINE(XInput)->update(false);
-		SIV3D_ENGINE(Gamepad)->update();
-		SIV3D_ENGINE(Pentablet)->update();
-		SIV3D_ENGINE(TextInput)->update();
-		SIV3D_ENGINE(DragDrop)->update();
+		{
+			SIV3D_PROFILE_ZONE(U"Asset::update");
+			SIV3D_ENGINE(Asset)->update();
+		}
+		{
+			SIV3D_PROFILE_ZONE(U"Input::update");
+			SIV3D_ENGINE(Cursor)->update();
+			SIV3D_ENGINE(Keyboard)->update();
+			SIV3D_ENGINE(Mouse)->update();
+			SIV3D_ENGINE(XInput)->update(false);
+			SIV3D_ENGINE(Gamepad)->update();
+			SIV3D_ENGINE(Pentablet)->update();
+			SIV3D_ENGINE(TextInput)->update();
+			SIV3D_ENGINE(DragDrop)->update();
+		}
 		SIV3D_ENGINE(Effect)->update();
 		if (not SIV3D_ENGINE(Addon)->update())
 		{
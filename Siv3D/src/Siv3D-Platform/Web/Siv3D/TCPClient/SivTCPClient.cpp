@@ -78,4 +78,14 @@ namespace s3d
 	{
 		return pImpl->send(data, size);
 	}
+
+	bool TCPClient::sendMessage(const void* data, const size_t size)
+	{
+		return pImpl->sendMessage(data, size);
+	}
+
+	bool TCPClient::tryReceiveMessage(Array<Byte>& message)
+	{
+		return pImpl->tryReceiveMessage(message);
+	}
 }
@@ -15,6 +15,7 @@
 # include <Siv3D/Byte.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Network/TCPBuffer.hpp>
 # include <Siv3D/PseudoThread/PseudoThread.hpp>
 
 # define _WINSOCK_DEPRECATED_NO_WARNINGS
@@ -338,6 +339,73 @@ namespace s3d
 
 				return true;
 			}
+
+			bool readMessage(Array<Byte>& message)
+			{
+				if (!m_isActive)
+				{
+					return false;
+				}
+
+				{
+					std::lock_guard lock{ m_mutexReceivedBuffer };
+
+					uint32 messageSize;
+
+					if (m_receivedBuffer.size() < TCPMessageHeaderSize)
+					{
+						return false;
+					}
+
+					std::memcpy(&messageSize, m_receivedBuffer.data(), TCPMessageHeaderSize);
+
+					if (m_receivedBuffer.size() < (TCPMessageHeaderSize + messageSize))
+					{
+						return false;
+					}
+
+					message.assign((m_receivedBuffer.begin() + TCPMessageHeaderSize), (m_receivedBuffer.begin() + TCPMessageHeaderSize + messageSize));
+
+					m_receivedBuffer.pop_front_N(TCPMessageHeaderSize + messageSize);
+				}
+
+				return true;
+			}
+
+			bool sendMessage(const void* data, const size_t size)
+			{
+				if (!m_isActive)
+				{
+					return false;
+				}
+
+				if (TCPMaxMessageSize < size)
+				{
+					LOG_FAIL(U"TCPClient: sendMessage() failed: the message size ({} bytes) exceeds the limit"_fmt(size));
+					return false;
+				}
+
+				{
+					std::lock_guard lock{ m_mutexSendingBuffer };
+
+					const uint32 messageSize = static_cast<uint32>(size);
+
+					Array<Byte> buffer(TCPMessageHeaderSize + size);
+
+					std::memcpy(buffer.data(), &messageSize, TCPMessageHeaderSize);
+
+					std::memcpy((buffer.data() + TCPMessageHeaderSize), data, size);
+
+					m_sendingBuffer.push_back(std::move(buffer));
+
+					if (!m_isSending)
+					{
+						send_internal();
+					}
+				}
+
+				return true;
+			}
 		};
 	}
 
@@ -394,5 +462,9 @@ namespace s3d
 		bool read(void* dst, size_t size);
 
 		bool send(const void* data, size_t size);
+
+		bool sendMessage(const void* data, size_t size);
+
+		bool tryReceiveMessage(Array<Byte>& message);
 	};
 }
@@ -96,7 +96,21 @@ namespace s3d
 
 		Array<WebGPUVertex2DBatch> m_batches;
 		WebGPURenderer2DCommandManager m_commandManager;
-		BufferCreatorFunc m_bufferCreator;
+		/// @brief 描画バッチから頂点バッファ・インデックスバッファの領域を確保する関数オブジェクト
+		struct BatchBufferCreator
+		{
+			CRenderer2D_WebGPU* pRenderer2D = nullptr;
+
+			[[nodiscard]]
+			Vertex2DBufferPointer operator ()(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize) const
+			{
+				return pRenderer2D->m_batches[pRenderer2D->m_drawCount % 2].requestBuffer(vertexSize, indexSize, pRenderer2D->m_commandManager);
+			}
+		};
+
+		BatchBufferCreator m_batchBufferCreator{ this };
+
+		BufferCreatorFunc m_bufferCreator{ m_batchBufferCreator };
 
 		Optional<VertexShader> m_currentCustomVS;
 		Optional<PixelShader> m_currentCustomPS;
@@ -196,10 +210,16 @@ namespace s3d
 
 		void addRoundRectShadow(const RoundRect& roundRect, float blur, const Float4& color, bool fill) override;
 
-		void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+		void addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles,
 			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) override;
 
+		void addRects(const RectF* rects, const ColorF* colors, size_t count, const Float4& color) override;
+
+		void addCircles(const Circle* circles, const ColorF* colors, size_t count, const Float4& color) override;
+
+		void addTexturedQuads(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Mat3x2* transforms, const ColorF* colors, size_t count, const Float4& color) override;
+
 
 		Float4 getColorMul() const override;
 
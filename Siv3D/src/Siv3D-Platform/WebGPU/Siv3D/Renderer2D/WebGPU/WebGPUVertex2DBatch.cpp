@@ -79,7 +79,7 @@ namespace s3d
 			}
 
 			const size_t newVertexArraySize = detail::CalculateNewArraySize(m_vertexArray.size(), vertexArrayWritePosTarget);
-			LOG_TRACE(U"ℹ️ Resized WebGPUVertex2DBatch::m_vertexArray (size: {} -> {})"_fmt(m_vertexArray.size(), newVertexArraySize));
+			LOG_TRACE_EVENT(U"ℹ️ Resized WebGPUVertex2DBatch::m_vertexArray (size: {} -> {})", m_vertexArray.size(), newVertexArraySize);
 			m_vertexArray.resize(newVertexArraySize);
 		}
 
@@ -93,7 +93,7 @@ namespace s3d
 			}
 
 			const size_t newIndexArraySize = detail::CalculateNewArraySize(m_indexArray.size(), indexArrayWritePosTarget);
-			LOG_TRACE(U"ℹ️ Resized WebGPUVertex2DBatch::m_indexArray (size: {} -> {})"_fmt(m_indexArray.size(), newIndexArraySize));
+			LOG_TRACE_EVENT(U"ℹ️ Resized WebGPUVertex2DBatch::m_indexArray (size: {} -> {})", m_indexArray.size(), newIndexArraySize);
 			m_indexArray.resize(newIndexArraySize);
 		}
 
@@ -184,6 +184,7 @@ namespace s3d
 			// m_vertexBuffer.Unmap();
 
 			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(Vertex2D) * vertexSize);
 			m_vertexBufferWritePos += vertexSize;
 		}
 
@@ -216,6 +217,7 @@ namespace s3d
 
 			batchInfo.indexCount = indexSize;
 			batchInfo.startIndexLocation = m_indexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(Vertex2D::IndexType) * indexSize);
 			m_indexBufferWritePos += alignedIndexSize;
 		}
 
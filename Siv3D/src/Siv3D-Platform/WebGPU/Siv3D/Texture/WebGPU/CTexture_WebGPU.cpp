@@ -14,6 +14,7 @@
 # include <Siv3D/ImageProcessing.hpp>
 # include <Siv3D/System.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Texture/TextureCommon.hpp>
 
 namespace s3d
@@ -111,7 +112,10 @@ namespace s3d
 		// [Siv3D ToDo] GPU でミップマップを生成する
 		if (detail::HasMipMap(desc))
 		{
-			return create(image, ImageProcessing::GenerateMips(image), desc);
+			MipmapConfig config;
+			config.sRGB = detail::IsSRGB(desc);
+
+			return create(image, ImageProcessing::GenerateMips(image, config), desc);
 		}
 
 		if (not image)
@@ -125,6 +129,8 @@ namespace s3d
 			return pushRequest(image, {}, desc);
 		}
 
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		auto texture = std::make_unique<WebGPUTexture>(m_device, image, desc);
 
 		if (not texture->isInitialized())
@@ -149,6 +155,8 @@ namespace s3d
 			return pushRequest(image, mips, desc);
 		}
 
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		auto texture = std::make_unique<WebGPUTexture>(m_device, image, mips, desc);
 
 		if (not texture->isInitialized())
@@ -345,11 +353,15 @@ namespace s3d
 
 	bool CTexture_WebGPU::fill(const Texture::IDType handleID, const void* src, uint32 stride, const bool wait)
 	{
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		return m_textures[handleID]->fill(m_device, src, stride, wait);
 	}
 
 	bool CTexture_WebGPU::fillRegion(const Texture::IDType handleID, const void* src, const uint32 stride, const Rect& rect, const bool wait)
 	{
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		return m_textures[handleID]->fillRegion(m_device, src, stride, rect, wait);
 	}
 
@@ -13,6 +13,8 @@
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/AudioCodec/IAudioCodec.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
+# include <Siv3D/AudioFormat/FLAC/FLACStreamDecoder.hpp>
+# include <Siv3D/AudioFormat/AudioStreamDecoderCommon.hpp>
 
 namespace s3d
 {
@@ -54,4 +56,9 @@ namespace s3d
 
 		return SIV3D_ENGINE(AudioCodec)->decode(reader, AudioFormat::FLAC);
 	}
+
+	std::unique_ptr<IAudioStreamDecoder> FLACDecoder::createStreamDecoder(std::unique_ptr<IReader>&& reader) const
+	{
+		return detail::CreateStreamDecoder<FLACStreamDecoder>(std::move(reader));
+	}
 }
@@ -9,31 +9,18 @@
 //
 //-----------------------------------------------
 
-# include <array>
 # include <Siv3D/Windows/Windows.hpp>
-# include <Siv3D/String.hpp>
-# include <Siv3D/FormatLiteral.hpp>
-# include <Siv3D/Utility.hpp>
-# include <Siv3D/Time.hpp>
+# include <Siv3D/Unicode.hpp>
 # include "CLogger.hpp"
 
 namespace s3d
 {
-	namespace detail
-	{
-		constexpr std::array<StringView, 7> LogTypeNames =
-		{
-			U"[error]   "_sv,
-			U"[fail]    "_sv,
-			U"[warning] "_sv,
-			U""_sv,
-			U"[info]    "_sv,
-			U"[trace]   "_sv,
-			U"[verbose] "_sv,
-		};
-	}
-
-	CLogger::CLogger() = default;
+	CLogger::CLogger()
+		: m_writer{ [](const std::string_view text)
+			{
+				const std::wstring output = Unicode::FromUTF8(text).toWstr();
+				::OutputDebugStringW(output.c_str());
+			} } {}
 
 	CLogger::~CLogger() = default;
 
@@ -44,19 +31,26 @@ namespace s3d
 			return;
 		}
 
-		const int64 timeStamp = Time::GetMillisec();
-		const StringView logTypeName = detail::LogTypeNames[FromEnum(type)];
-		const String text = U"{}: {}"_fmt(timeStamp, logTypeName) + s + U'\n';
-		const std::wstring output = text.toWstr();
-
-		std::lock_guard lock{ m_mutex };
-		{
-			::OutputDebugStringW(output.c_str());
-		}
+		m_writer.write(type, s);
 	}
 
 	void CLogger::setEnabled(const bool enabled)
 	{
 		m_enabled = enabled;
 	}
+
+	bool CLogger::setOutputFile(const StringView path, const LogFileFormat format, const size_t maxFileSize, const size_t maxBackupFiles)
+	{
+		return m_writer.setOutputFile(path, format, maxFileSize, maxBackupFiles);
+	}
+
+	void CLogger::closeOutputFile()
+	{
+		m_writer.closeOutputFile();
+	}
+
+	void CLogger::flush()
+	{
+		m_writer.flush();
+	}
 }
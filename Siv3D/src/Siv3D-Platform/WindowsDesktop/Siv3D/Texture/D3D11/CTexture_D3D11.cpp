@@ -15,6 +15,7 @@
 # include <Siv3D/ImageProcessing.hpp>
 # include <Siv3D/HalfFloat.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Texture/TextureCommon.hpp>
 
@@ -117,6 +118,8 @@ namespace s3d
 			return Texture::IDType::NullAsset();
 		}
 
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		auto texture = std::make_unique<D3D11Texture>(m_device, image, desc);
 
 		if (not texture->isInitialized())
@@ -140,6 +143,8 @@ namespace s3d
 			return Texture::IDType::NullAsset();
 		}
 
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		auto texture = std::make_unique<D3D11Texture>(m_device, image, mips, desc);
 
 		if (not texture->isInitialized())
@@ -362,11 +367,15 @@ namespace s3d
 
 	bool CTexture_D3D11::fill(const Texture::IDType handleID, const void* src, uint32 stride, const bool wait)
 	{
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		return m_textures[handleID]->fill(m_context, src, stride, wait);
 	}
 
 	bool CTexture_D3D11::fillRegion(const Texture::IDType handleID, const void* src, const uint32 stride, const Rect& rect, const bool wait)
 	{
+		SIV3D_PROFILE_ZONE(U"Texture::upload");
+
 		return m_textures[handleID]->fillRegion(m_context, src, stride, rect, wait);
 	}
 
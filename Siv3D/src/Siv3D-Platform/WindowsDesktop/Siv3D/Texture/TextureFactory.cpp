@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineOptions.hpp>
 # include <Siv3D/Texture/Null/CTexture_Null.hpp>
+# include <Siv3D/Texture/Software/CTexture_Software.hpp>
 # include <Siv3D/Texture/GL4/CTexture_GL4.hpp>
 # include <Siv3D/Texture/D3D11/CTexture_D3D11.hpp>
 
@@ -20,6 +21,11 @@ namespace s3d
 	{
 		if (g_engineOptions.renderer == EngineOption::Renderer::Headless)
 		{
+			if (g_engineOptions.headlessRenderer == EngineOption::HeadlessRenderer::Software)
+			{
+				return new CTexture_Software;
+			}
+
 			return new CTexture_Null;
 		}
 		else if (g_engineOptions.renderer == EngineOption::Renderer::PlatformDefault
@@ -14,6 +14,8 @@
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/AudioCodec/CAudioCodec.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
+# include <Siv3D/AudioFormat/FLAC/FLACStreamDecoder.hpp>
+# include <Siv3D/AudioFormat/AudioStreamDecoderCommon.hpp>
 
 namespace s3d
 {
@@ -75,4 +77,9 @@ namespace s3d
 			return result;
 		}
 	}
+
+	std::unique_ptr<IAudioStreamDecoder> FLACDecoder::createStreamDecoder(std::unique_ptr<IReader>&& reader) const
+	{
+		return detail::CreateStreamDecoder<FLACStreamDecoder>(std::move(reader));
+	}
 }
@@ -14,6 +14,8 @@
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/AudioCodec/CAudioCodec.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
+# include <Siv3D/AudioFormat/MP3/MP3StreamDecoder.hpp>
+# include <Siv3D/AudioFormat/AudioStreamDecoderCommon.hpp>
 
 namespace s3d
 {
@@ -77,4 +79,9 @@ namespace s3d
 			return result;
 		}
 	}
+
+	std::unique_ptr<IAudioStreamDecoder> MP3Decoder::createStreamDecoder(std::unique_ptr<IReader>&& reader) const
+	{
+		return detail::CreateStreamDecoder<MP3StreamDecoder>(std::move(reader));
+	}
 }
@@ -11,6 +11,7 @@
 
 # include <Siv3D/EngineOptions.hpp>
 # include <Siv3D/Renderer/Null/CRenderer_Null.hpp>
+# include <Siv3D/Renderer/Software/CRenderer_Software.hpp>
 # include <Siv3D/Renderer/GL4/CRenderer_GL4.hpp>
 # include <Siv3D/Renderer/Metal/CRenderer_Metal.hpp>
 
@@ -29,6 +30,11 @@ namespace s3d
 		}
 		else
 		{
+			if (g_engineOptions.headlessRenderer == EngineOption::HeadlessRenderer::Software)
+			{
+				return new CRenderer_Software;
+			}
+
 			return new CRenderer_Null;
 		}
 	}
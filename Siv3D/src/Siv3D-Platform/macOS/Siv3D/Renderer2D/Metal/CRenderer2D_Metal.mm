@@ -14,6 +14,7 @@
 # include <Siv3D/Resource.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/ScopeGuard.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
@@ -109,12 +110,6 @@ namespace s3d
 			}
 		}
 
-		// バッファ作成関数を作成
-		m_bufferCreator = [this](Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize)
-		{
-			return m_batches.requestBuffer(vertexSize, indexSize, m_commandManager);
-		};
-
 		// シャドウ画像を作成
 		{
 			const Image boxShadowImage{ Resource(U"engine/texture/box-shadow/256.png") };
@@ -178,7 +173,7 @@ namespace s3d
 
 	void CRenderer2D_Metal::addTriangle(const Float2(&points)[3], const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_bufferCreator, points, color))
+		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_batchBufferCreator, points, color))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -196,7 +191,7 @@ namespace s3d
 
 	void CRenderer2D_Metal::addTriangle(const Float2(&points)[3], const Float4(&colors)[3])
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_bufferCreator, points, colors))
+		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_batchBufferCreator, points, colors))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -214,7 +209,7 @@ namespace s3d
 
 	void CRenderer2D_Metal::addRect(const FloatRect& rect, const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_bufferCreator, rect, color))
+		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_batchBufferCreator, rect, color))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -232,7 +227,7 @@ namespace s3d
 
 	void CRenderer2D_Metal::addRect(const FloatRect& rect, const Float4(&colors)[4])
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_bufferCreator, rect, colors))
+		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_batchBufferCreator, rect, colors))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -412,7 +407,7 @@ namespace s3d
 
 	void CRenderer2D_Metal::addQuad(const FloatQuad& quad, const Float4& color)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, color))
+		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_batchBufferCreator, quad, color))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -430,7 +425,7 @@ namespace s3d
 
 	void CRenderer2D_Metal::addQuad(const FloatQuad& quad, const Float4(&colors)[4])
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, colors))
+		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_batchBufferCreator, quad, colors))
 		{
 			if (not m_currentCustomVS)
 			{
@@ -681,13 +676,74 @@ namespace s3d
 
 	}
 
-	void CRenderer2D_Metal::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+	void CRenderer2D_Metal::addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
 	{
 
 	}
 
+	void CRenderer2D_Metal::addRects(const RectF* rects, const ColorF* colors, const size_t count, const Float4& color)
+	{
+		// 状態の確認とコマンドの発行は、バッファ要求 1 回につき 1 度だけ行う
+		for (size_t i = 0; i < count; i += Vertex2DBuilder::MaxBulkQuadCount)
+		{
+			const size_t n = Min((count - i), Vertex2DBuilder::MaxBulkQuadCount);
+			const auto indexCount = Vertex2DBuilder::BuildRects(m_bufferCreator, (rects + i), (colors ? (colors + i) : nullptr), n, color);
+
+			if (not indexCount)
+			{
+				return;
+			}
+
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Metal::addCircles(const Circle* circles, const ColorF* colors, const size_t count, const Float4& color)
+	{
+		const float scale = getMaxScaling();
+
+		for (size_t i = 0; i < count;)
+		{
+			size_t n = 0;
+			const auto indexCount = Vertex2DBuilder::BuildCircles(m_bufferCreator, (circles + i), (colors ? (colors + i) : nullptr), (count - i), color, scale, n);
+
+			if (not indexCount)
+			{
+				return;
+			}
+
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+			i += n;
+		}
+	}
+
+	void CRenderer2D_Metal::addTexturedQuads(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Mat3x2* transforms, const ColorF* colors, const size_t count, const Float4& color)
+	{
+
+	}
+
 
 	Float4 CRenderer2D_Metal::getColorMul() const
 	{
@@ -884,6 +940,8 @@ namespace s3d
 
 	void CRenderer2D_Metal::flush(id<MTLCommandBuffer> commandBuffer)
 	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
 		ScopeGuard cleanUp = [this]()
 		{
 			m_commandManager.reset();
@@ -956,6 +1014,7 @@ namespace s3d
 							{
 								viBatchIndex = command.index;
 								batchInfo = m_batches.updateBuffers(viBatchIndex);
+								m_stat.uploadedBytes += batchInfo.uploadedBytes;
 								
 								[sceneCommandEncoder setVertexBuffer:m_batches.getCurrentVertexBuffer(viBatchIndex)
 												offset:0
@@ -133,6 +133,7 @@ namespace s3d
 		
 		const auto& currentVIBuffer = m_viBuffers[m_currentVIBufferIndex][batchIndex];
 		
-		return{ currentVIBuffer.indexBufferWritePos, 0, 0 };
+		return{ currentVIBuffer.indexBufferWritePos, 0, 0,
+			static_cast<uint32>((sizeof(Vertex2D) * currentVIBuffer.vertexBufferWritePos) + (sizeof(Vertex2D::IndexType) * currentVIBuffer.indexBufferWritePos)) };
 	}
 }
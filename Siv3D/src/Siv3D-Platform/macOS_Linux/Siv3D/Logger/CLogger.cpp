@@ -9,37 +9,24 @@
 //
 //-----------------------------------------------
 
-# include <array>
-# include <Siv3D/String.hpp>
-# include <Siv3D/FormatLiteral.hpp>
-# include <Siv3D/Time.hpp>
+# include <iostream>
 # include "CLogger.hpp"
 
 namespace s3d
 {
-	namespace detail
-	{
-		constexpr std::array<StringView, 7> LogTypeNames =
-		{
-			U"[error]   "_sv,
-			U"[fail]    "_sv,
-			U"[warning] "_sv,
-			U""_sv,
-			U"[info]    "_sv,
-			U"[trace]   "_sv,
-			U"[verbose] "_sv,
-		};
-	}
-
 	CLogger::CLogger()
-	{
-
-	}
-
-	CLogger::~CLogger()
-	{
-	
-	}
+		: m_writer{ [](const std::string_view text)
+			{
+			# if SIV3D_PLATFORM(WEB)
+				std::cout.write(text.data(), text.size());
+				std::cout.flush();
+			# else
+				std::clog.write(text.data(), text.size());
+				std::clog.flush();
+			# endif
+			} } {}
+
+	CLogger::~CLogger() = default;
 
 	void CLogger::write(const LogType type, const StringView s)
 	{
@@ -48,23 +35,26 @@ namespace s3d
 			return;
 		}
 
-		const int64 timeStamp = Time::GetMillisec();
-		const StringView logTypeName = detail::LogTypeNames[FromEnum(type)];
-		const String text = U"{}: {}"_fmt(timeStamp, logTypeName) + s;
-		const std::string output = text.narrow();
-
-		std::lock_guard lock{ m_mutex };
-		{
-		# if SIV3D_PLATFORM(WEB)
-			std::cout << output << std::endl;
-		# else
-			std::clog << output << std::endl;
-		# endif
-		}
+		m_writer.write(type, s);
 	}
 
 	void CLogger::setEnabled(const bool enabled)
 	{
 		m_enabled = enabled;
-	}	
+	}
+
+	bool CLogger::setOutputFile(const StringView path, const LogFileFormat format, const size_t maxFileSize, const size_t maxBackupFiles)
+	{
+		return m_writer.setOutputFile(path, format, maxFileSize, maxBackupFiles);
+	}
+
+	void CLogger::closeOutputFile()
+	{
+		m_writer.closeOutputFile();
+	}
+
+	void CLogger::flush()
+	{
+		m_writer.flush();
+	}
 }
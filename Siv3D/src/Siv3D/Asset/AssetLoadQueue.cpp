@@ -0,0 +1,271 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "AssetLoadQueue.hpp"
+
+namespace s3d
+{
+	AssetLoadQueue::AssetLoadQueue()
+	{
+		// デコード後のデータやファイルハンドルを同時に保持しすぎないよう上限を設ける
+		m_maxConcurrency = Clamp<size_t>(Threading::GetConcurrency(), 2, 8);
+	}
+
+	AssetLoadQueue::~AssetLoadQueue()
+	{
+		LOG_SCOPED_TRACE(U"AssetLoadQueue::~AssetLoadQueue()");
+
+		cancelAll();
+
+		{
+			std::lock_guard lock{ m_mutex };
+			m_stop = true;
+		}
+
+		m_condition.notify_all();
+
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	AsyncTask<void> AssetLoadQueue::enqueue(const IAsset* asset, const int32 priority, LoadFunction load, CancelFunction onCancel)
+	{
+		Request request{ priority, 0, asset, std::move(load), std::move(onCancel), std::promise<void>{} };
+		AsyncTask<void> task{ request.promise.get_future() };
+
+	# if SIV3D_PLATFORM(WEB) && !defined(__EMSCRIPTEN_PTHREADS__)
+
+		// スレッドを使えない環境では即座にロードする
+		if (request.load())
+		{
+			++m_succeededCount;
+		}
+		else
+		{
+			++m_failedCount;
+		}
+
+		request.promise.set_value();
+
+	# else
+
+		{
+			std::lock_guard lock{ m_mutex };
+
+			request.sequence = m_sequence++;
+			m_requests.push_back(std::move(request));
+			std::push_heap(m_requests.begin(), m_requests.end(), RequestCompare{});
+
+			joinRetiredThreadsLocked();
+			spawnThreadsLocked();
+		}
+
+		m_condition.notify_one();
+
+	# endif
+
+		return task;
+	}
+
+	bool AssetLoadQueue::cancel(const IAsset* asset)
+	{
+		Request request;
+		{
+			std::lock_guard lock{ m_mutex };
+
+			auto it = std::find_if(m_requests.begin(), m_requests.end(), [=](const Request& r) { return (r.asset == asset); });
+
+			if (it == m_requests.end())
+			{
+				return false;
+			}
+
+			request = std::move(*it);
+			m_requests.erase(it);
+			std::make_heap(m_requests.begin(), m_requests.end(), RequestCompare{});
+			++m_canceledCount;
+		}
+
+		Cancel(request);
+
+		return true;
+	}
+
+	void AssetLoadQueue::cancelAll()
+	{
+		Array<Request> requests;
+		{
+			std::lock_guard lock{ m_mutex };
+			m_canceledCount += m_requests.size();
+			requests.swap(m_requests);
+		}
+
+		for (auto& request : requests)
+		{
+			Cancel(request);
+		}
+	}
+
+	void AssetLoadQueue::setMaxConcurrency(const size_t maxConcurrency)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_maxConcurrency = Max<size_t>(1, maxConcurrency);
+
+		joinRetiredThreadsLocked();
+		spawnThreadsLocked();
+
+		// スレッド数が上限を超えている場合は、余分なスレッドが現在のロードを終えた後に終了する
+		m_condition.notify_all();
+	}
+
+	size_t AssetLoadQueue::getMaxConcurrency() const
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return m_maxConcurrency;
+	}
+
+	AssetLoadProgress AssetLoadQueue::getProgress() const
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return{ m_requests.size(), m_loadingCount, m_succeededCount, m_failedCount, m_canceledCount };
+	}
+
+	void AssetLoadQueue::resetProgress()
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_succeededCount = 0;
+		m_failedCount = 0;
+		m_canceledCount = 0;
+	}
+
+	void AssetLoadQueue::run()
+	{
+		for (;;)
+		{
+			Request request;
+			{
+				std::unique_lock lock{ m_mutex };
+
+				m_condition.wait(lock, [this]()
+				{
+					return (m_stop
+						|| (m_maxConcurrency < m_runningCount)
+						|| ((not m_requests.isEmpty()) && (m_loadingCount < m_maxConcurrency)));
+				});
+
+				if (m_stop)
+				{
+					return;
+				}
+
+				// 上限が引き下げられた場合は、余分なスレッドを終了する
+				if (m_maxConcurrency < m_runningCount)
+				{
+					--m_runningCount;
+					m_retiredThreads.push_back(std::this_thread::get_id());
+					return;
+				}
+
+				std::pop_heap(m_requests.begin(), m_requests.end(), RequestCompare{});
+				request = std::move(m_requests.back());
+				m_requests.pop_back();
+				++m_loadingCount;
+			}
+
+			bool succeeded = false;
+
+			std::exception_ptr exception;
+
+			try
+			{
+				succeeded = request.load();
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+
+			{
+				std::lock_guard lock{ m_mutex };
+
+				--m_loadingCount;
+
+				if (succeeded)
+				{
+					++m_succeededCount;
+				}
+				else
+				{
+					++m_failedCount;
+				}
+			}
+
+			// 例外は AsyncTask::get() で再送出される
+			if (exception)
+			{
+				request.promise.set_exception(exception);
+			}
+			else
+			{
+				request.promise.set_value();
+			}
+
+			// 上限により待機していたスレッドを起こす
+			m_condition.notify_one();
+		}
+	}
+
+	void AssetLoadQueue::spawnThreadsLocked()
+	{
+		// ロード待ちの要求に対してスレッドが足りなければ追加する
+		while ((m_runningCount < m_maxConcurrency)
+			&& (m_runningCount < (m_loadingCount + m_requests.size())))
+		{
+			m_threads.emplace_back([this]() { run(); });
+			++m_runningCount;
+		}
+	}
+
+	void AssetLoadQueue::joinRetiredThreadsLocked()
+	{
+		// 終了したスレッドは m_mutex を解放済みなので、ロックしたまま join できる
+		for (const auto& id : m_retiredThreads)
+		{
+			auto it = std::find_if(m_threads.begin(), m_threads.end(), [=](const std::thread& t) { return (t.get_id() == id); });
+
+			if (it != m_threads.end())
+			{
+				it->join();
+				m_threads.erase(it);
+			}
+		}
+
+		m_retiredThreads.clear();
+	}
+
+	void AssetLoadQueue::Cancel(Request& request)
+	{
+		if (request.onCancel)
+		{
+			request.onCancel();
+		}
+
+		request.promise.set_value();
+	}
+}
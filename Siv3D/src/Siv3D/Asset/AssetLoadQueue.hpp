@@ -0,0 +1,127 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <mutex>
+# include <thread>
+# include <future>
+# include <functional>
+# include <condition_variable>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Asset.hpp>
+# include <Siv3D/AssetLoader.hpp>
+# include <Siv3D/AsyncTask.hpp>
+
+namespace s3d
+{
+	/// @brief アセットの非同期ロード要求を優先度順に、上限付きのスレッド数で処理するキュー
+	class AssetLoadQueue
+	{
+	public:
+
+		/// @brief ロード処理。成功した場合 true を返す
+		using LoadFunction = std::function<bool()>;
+
+		/// @brief ロード開始前に取り消されたときの処理
+		using CancelFunction = std::function<void()>;
+
+		AssetLoadQueue();
+
+		~AssetLoadQueue();
+
+		[[nodiscard]]
+		AsyncTask<void> enqueue(const IAsset* asset, int32 priority, LoadFunction load, CancelFunction onCancel);
+
+		bool cancel(const IAsset* asset);
+
+		void cancelAll();
+
+		void setMaxConcurrency(size_t maxConcurrency);
+
+		[[nodiscard]]
+		size_t getMaxConcurrency() const;
+
+		[[nodiscard]]
+		AssetLoadProgress getProgress() const;
+
+		void resetProgress();
+
+	private:
+
+		struct Request
+		{
+			int32 priority = 0;
+
+			uint64 sequence = 0;
+
+			const IAsset* asset = nullptr;
+
+			LoadFunction load;
+
+			CancelFunction onCancel;
+
+			std::promise<void> promise;
+		};
+
+		/// @brief 優先度が高く、先に要求されたものを先頭にするヒープの比較
+		struct RequestCompare
+		{
+			[[nodiscard]]
+			bool operator ()(const Request& a, const Request& b) const noexcept
+			{
+				if (a.priority != b.priority)
+				{
+					return (a.priority < b.priority);
+				}
+
+				return (b.sequence < a.sequence);
+			}
+		};
+
+		mutable std::mutex m_mutex;
+
+		std::condition_variable m_condition;
+
+		Array<Request> m_requests;
+
+		Array<std::thread> m_threads;
+
+		/// @brief 上限の引き下げにより終了し、join 待ちのスレッド
+		Array<std::thread::id> m_retiredThreads;
+
+		/// @brief 終了していないスレッドの数
+		size_t m_runningCount = 0;
+
+		size_t m_maxConcurrency = 1;
+
+		uint64 m_sequence = 0;
+
+		size_t m_loadingCount = 0;
+
+		size_t m_succeededCount = 0;
+
+		size_t m_failedCount = 0;
+
+		size_t m_canceledCount = 0;
+
+		bool m_stop = false;
+
+		void run();
+
+		/// @brief スレッドが足りなければ追加する（m_mutex をロックした状態で呼ぶ）
+		void spawnThreadsLocked();
+
+		/// @brief 終了したスレッドを join する（m_mutex をロックした状態で呼ぶ）
+		void joinRetiredThreadsLocked();
+
+		static void Cancel(Request& request);
+	};
+}
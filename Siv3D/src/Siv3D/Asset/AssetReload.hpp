@@ -0,0 +1,45 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <functional>
+# include <Siv3D/String.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 作成パラメータをコピーした別のインスタンスにアセットをロードし、差し替える関数を返します。
+		/// @tparam AssetData アセットデータの型
+		/// @tparam Resource 差し替えるメンバの型
+		/// @param asset 再ロードするアセット
+		/// @param staging 作成パラメータをコピーした別のインスタンス
+		/// @param resource 差し替えるメンバ
+		/// @param hint ヒント
+		/// @return ロードに成功した場合はアセットを差し替える関数、それ以外の場合は空の関数
+		template <class AssetData, class Resource>
+		[[nodiscard]]
+		std::function<void()> PrepareReload(AssetData& asset, std::shared_ptr<AssetData> staging, Resource AssetData::* resource, const String& hint)
+		{
+			if (not asset.onLoad(*staging, hint))
+			{
+				return{};
+			}
+
+			// 差し替え前のリソースは、差し替える関数とともにメインスレッドで破棄される
+			return [&asset, staging = std::move(staging), resource]()
+				{
+					std::swap((asset.*resource), ((*staging).*resource));
+				};
+		}
+	}
+}
@@ -9,7 +9,10 @@
 //
 //-----------------------------------------------
 
+# include <thread>
 # include "CAsset.hpp"
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/HashSet.hpp>
 # include <Siv3D/Texture/ITexture.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/EngineLog.hpp>
@@ -45,8 +48,18 @@ namespace s3d
 	{
 		LOG_SCOPED_TRACE(U"CAsset::~CAsset()");
 
+		// ロード待ちの要求は実行せずに取り消す
+		m_loader.cancelAll();
+
 		SIV3D_ENGINE(Texture)->updateAsyncTextureLoad(Largest<size_t>);
 
+		for (auto& hotReload : m_hotReloads)
+		{
+			WaitHotReload(hotReload);
+		}
+
+		m_hotReloads.clear();
+
 		// wait for all
 		for (auto& assetList : m_assetLists)
 		{
@@ -60,6 +73,8 @@ namespace s3d
 	void CAsset::update()
 	{
 		SIV3D_ENGINE(Texture)->updateAsyncTextureLoad(4);
+
+		updateHotReload();
 	}
 
 	bool CAsset::registerAsset(const AssetType assetType, const AssetNameView name, std::unique_ptr<IAsset>&& asset)
@@ -127,7 +142,7 @@ namespace s3d
 		return it->second->load(String{ hint });
 	}
 
-	void CAsset::loadAsync(const AssetType assetType, const AssetNameView name, const StringView hint)
+	void CAsset::loadAsync(const AssetType assetType, const AssetNameView name, const StringView hint, const int32 priority)
 	{
 		auto& assetList = m_assetLists[FromEnum(assetType)];
 		const auto it = assetList.find(name);
@@ -138,9 +153,36 @@ namespace s3d
 			return;
 		}
 
+		it->second->setLoadPriority(priority);
+
 		it->second->loadAsync(String{ hint });
 	}
 
+	void CAsset::loadAsyncByTag(const AssetType assetType, const AssetTag& tag, const StringView hint, const int32 priority)
+	{
+		auto& assetList = m_assetLists[FromEnum(assetType)];
+
+		const String hintString{ hint };
+
+		size_t count = 0;
+
+		for (auto&& [name, asset] : assetList)
+		{
+			if (not asset->getTags().contains(tag))
+			{
+				continue;
+			}
+
+			asset->setLoadPriority(priority);
+
+			asset->loadAsync(hintString);
+
+			++count;
+		}
+
+		LOG_TRACE(U"ℹ️ {}Asset: {} assets tagged `{}` requested"_fmt(detail::GetAssetTypeName(assetType), count, tag));
+	}
+
 	void CAsset::wait(const AssetType assetType, const AssetNameView name)
 	{
 		auto& assetList = m_assetLists[FromEnum(assetType)];
@@ -180,6 +222,8 @@ namespace s3d
 			return;
 		}
 
+		cancelHotReload(it->second.get());
+
 		it->second->release();
 
 		LOG_TRACE(U"ℹ️ {}Asset: `{}` released"_fmt(detail::GetAssetTypeName(assetType), name));
@@ -187,6 +231,8 @@ namespace s3d
 
 	void CAsset::releaseAll(const AssetType assetType)
 	{
+		cancelHotReloadAll(assetType);
+
 		auto& assetList = m_assetLists[FromEnum(assetType)];
 
 		for (auto&&[name, asset] : assetList)
@@ -208,6 +254,8 @@ namespace s3d
 			return;
 		}
 
+		cancelHotReload(it->second.get());
+
 		it->second->release();
 
 		assetList.erase(it);
@@ -217,6 +265,8 @@ namespace s3d
 
 	void CAsset::unregisterAll(const AssetType assetType)
 	{
+		cancelHotReloadAll(assetType);
+
 		auto& assetList = m_assetLists[FromEnum(assetType)];
 
 		for (auto&& [name, asset] : assetList)
@@ -244,4 +294,223 @@ namespace s3d
 
 		return result;
 	}
+
+	AssetLoadQueue& CAsset::getLoader()
+	{
+		return m_loader;
+	}
+
+	bool CAsset::enableHotReload(const FilePathView directory)
+	{
+		const FilePath fullPath = FileSystem::FullPath(directory);
+
+		if (m_watchers.any([&](const DirectoryWatcher& watcher) { return (watcher.directory() == fullPath); }))
+		{
+			return true;
+		}
+
+		DirectoryWatcher watcher{ fullPath };
+
+		if (not watcher)
+		{
+			LOG_FAIL(U"❌ Asset: Failed to watch `{}` for hot reload"_fmt(fullPath));
+			return false;
+		}
+
+		m_watchers << std::move(watcher);
+
+		LOG_INFO(U"ℹ️ Asset: Hot reload enabled for `{}`"_fmt(fullPath));
+
+		return true;
+	}
+
+	void CAsset::disableHotReload()
+	{
+		m_watchers.clear();
+
+		for (auto& hotReload : m_hotReloads)
+		{
+			m_loader.cancel(hotReload.asset);
+
+			WaitHotReload(hotReload);
+		}
+
+		m_hotReloads.clear();
+	}
+
+	bool CAsset::isHotReloadEnabled() const
+	{
+		return (not m_watchers.isEmpty());
+	}
+
+	void CAsset::updateHotReload()
+	{
+		// 再ロード中にファイルが再び変更されたアセット
+		Array<std::tuple<AssetType, AssetName, IAsset*>> dirtyReloads;
+
+		// 完了した再ロードを反映する
+		for (auto it = m_hotReloads.begin(); it != m_hotReloads.end();)
+		{
+			if (not it->task.isReady())
+			{
+				++it;
+				continue;
+			}
+
+			it->task.get();
+
+			if (*it->commit && it->asset->getState() == AssetState::Loaded)
+			{
+				(*it->commit)();
+
+				LOG_INFO(U"ℹ️ {}Asset: `{}` reloaded"_fmt(detail::GetAssetTypeName(it->assetType), it->name));
+			}
+			else
+			{
+				LOG_FAIL(U"❌ {}Asset: Failed to reload `{}`"_fmt(detail::GetAssetTypeName(it->assetType), it->name));
+			}
+
+			if (it->dirty)
+			{
+				dirtyReloads.emplace_back(it->assetType, it->name, it->asset);
+			}
+
+			it = m_hotReloads.erase(it);
+		}
+
+		for (const auto& [assetType, name, asset] : dirtyReloads)
+		{
+			requestHotReload(assetType, name, asset);
+		}
+
+		if (m_watchers.isEmpty())
+		{
+			return;
+		}
+
+		HashSet<FilePath> changedPaths;
+
+		for (const auto& watcher : m_watchers)
+		{
+			for (auto&& [path, action] : watcher.retrieveChanges())
+			{
+				if ((action == FileAction::Added)
+					|| (action == FileAction::Modified))
+				{
+					changedPaths.insert(FileSystem::FullPath(path));
+				}
+			}
+		}
+
+		if (changedPaths.empty())
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < m_assetLists.size(); ++i)
+		{
+			const AssetType assetType = ToEnum<AssetType>(static_cast<int32>(i));
+
+			for (auto&& [name, asset] : m_assetLists[i])
+			{
+				// ロード済みのアセットのみを差し替える
+				if (asset->getState() != AssetState::Loaded)
+				{
+					continue;
+				}
+
+				const bool changed = asset->getSourcePaths().any([&](const FilePath& path)
+					{
+						return changedPaths.contains(FileSystem::FullPath(path));
+					});
+
+				if (changed)
+				{
+					requestHotReload(assetType, name, asset.get());
+				}
+			}
+		}
+	}
+
+	void CAsset::requestHotReload(const AssetType assetType, const AssetName& name, IAsset* asset)
+	{
+		if (auto it = std::find_if(m_hotReloads.begin(), m_hotReloads.end(),
+			[=](const HotReload& hotReload) { return (hotReload.asset == asset); });
+			it != m_hotReloads.end())
+		{
+			// 再ロード中であれば、完了後にもう一度再ロードする
+			it->dirty = true;
+			return;
+		}
+
+		HotReload hotReload{ asset, assetType, name, {}, std::make_unique<std::function<void()>>() };
+
+		std::function<void()>* commit = hotReload.commit.get();
+
+		hotReload.task = m_loader.enqueue(asset, asset->getLoadPriority(),
+			[asset, commit]()
+			{
+				*commit = asset->prepareReload(String{});
+				return static_cast<bool>(*commit);
+			},
+			[]() {});
+
+		m_hotReloads << std::move(hotReload);
+
+		LOG_TRACE(U"ℹ️ {}Asset: `{}` changed. Reloading"_fmt(detail::GetAssetTypeName(assetType), name));
+	}
+
+	void CAsset::cancelHotReload(const IAsset* asset)
+	{
+		for (auto it = m_hotReloads.begin(); it != m_hotReloads.end(); ++it)
+		{
+			if (it->asset == asset)
+			{
+				m_loader.cancel(asset);
+
+				WaitHotReload(*it);
+
+				m_hotReloads.erase(it);
+
+				return;
+			}
+		}
+	}
+
+	void CAsset::cancelHotReloadAll(const AssetType assetType)
+	{
+		for (auto it = m_hotReloads.begin(); it != m_hotReloads.end();)
+		{
+			if (it->assetType == assetType)
+			{
+				m_loader.cancel(it->asset);
+
+				WaitHotReload(*it);
+
+				it = m_hotReloads.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	void CAsset::WaitHotReload(HotReload& hotReload)
+	{
+		if (not hotReload.task.isValid())
+		{
+			return;
+		}
+
+		// OpenGL ではテクスチャの作成がメインスレッドで行われるため、処理しながら待つ
+		while (not hotReload.task.isReady())
+		{
+			SIV3D_ENGINE(Texture)->updateAsyncTextureLoad(Largest<size_t>);
+
+			std::this_thread::yield();
+		}
+
+		hotReload.task.get();
+	}
 }
@@ -12,7 +12,9 @@
 # pragma once
 # include <Siv3D/HashTable.hpp>
 # include <Siv3D/String.hpp>
+# include <Siv3D/DirectoryWatcher.hpp>
 # include "IAsset.hpp"
+# include "AssetLoadQueue.hpp"
 
 namespace s3d
 {
@@ -34,7 +36,9 @@ namespace s3d
 
 		bool load(AssetType assetType, AssetNameView name, StringView hint) override;
 
-		void loadAsync(AssetType assetType, AssetNameView name, StringView hint) override;
+		void loadAsync(AssetType assetType, AssetNameView name, StringView hint, int32 priority) override;
+
+		void loadAsyncByTag(AssetType assetType, const AssetTag& tag, StringView hint, int32 priority) override;
 
 		void wait(AssetType assetType, AssetNameView name) override;
 
@@ -50,8 +54,51 @@ namespace s3d
 
 		HashTable<AssetName, AssetInfo> enumerate(AssetType assetType) override;
 
+		AssetLoadQueue& getLoader() override;
+
+		bool enableHotReload(FilePathView directory) override;
+
+		void disableHotReload() override;
+
+		bool isHotReloadEnabled() const override;
+
 	private:
 
+		/// @brief 実行中のホットリロード
+		struct HotReload
+		{
+			IAsset* asset = nullptr;
+
+			AssetType assetType = AssetType::Texture;
+
+			AssetName name;
+
+			AsyncTask<void> task;
+
+			/// @brief 再ロードしたアセットを差し替える関数（ロードのスレッドが書き込む）
+			std::unique_ptr<std::function<void()>> commit;
+
+			/// @brief 再ロード中にファイルが再び変更された
+			bool dirty = false;
+		};
+
 		std::array<HashTable<String, std::unique_ptr<IAsset>>, 5> m_assetLists;
+
+		Array<DirectoryWatcher> m_watchers;
+
+		Array<HotReload> m_hotReloads;
+
+		void updateHotReload();
+
+		void requestHotReload(AssetType assetType, const AssetName& name, IAsset* asset);
+
+		void cancelHotReload(const IAsset* asset);
+
+		void cancelHotReloadAll(AssetType assetType);
+
+		static void WaitHotReload(HotReload& hotReload);
+
+		// アセットより先に破棄され、ロード待ちの要求は取り消される
+		AssetLoadQueue m_loader;
 	};
 }
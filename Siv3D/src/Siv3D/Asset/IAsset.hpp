@@ -16,6 +16,8 @@
 
 namespace s3d
 {
+	class AssetLoadQueue;
+
 	enum class AssetType
 	{
 		Audio,
@@ -47,7 +49,9 @@ namespace s3d
 
 		virtual bool load(AssetType assetType, AssetNameView name, StringView hint) = 0;
 
-		virtual void loadAsync(AssetType assetType, AssetNameView name, StringView hint) = 0;
+		virtual void loadAsync(AssetType assetType, AssetNameView name, StringView hint, int32 priority) = 0;
+
+		virtual void loadAsyncByTag(AssetType assetType, const AssetTag& tag, StringView hint, int32 priority) = 0;
 
 		virtual void wait(AssetType assetType, AssetNameView name) = 0;
 
@@ -62,5 +66,13 @@ namespace s3d
 		virtual void unregisterAll(AssetType assetType) = 0;
 
 		virtual HashTable<AssetName, AssetInfo> enumerate(AssetType assetType) = 0;
+
+		virtual AssetLoadQueue& getLoader() = 0;
+
+		virtual bool enableHotReload(FilePathView directory) = 0;
+
+		virtual void disableHotReload() = 0;
+
+		virtual bool isHotReloadEnabled() const = 0;
 	};
 }
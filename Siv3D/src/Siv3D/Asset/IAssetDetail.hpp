@@ -32,10 +32,17 @@ namespace s3d
 		[[nodiscard]]
 		const Array<AssetTag>& getTags() const;
 
+		[[nodiscard]]
+		int32 getLoadPriority() const;
+
+		void setLoadPriority(int32 priority);
+
 	private:
 
 		Array<String> m_tags;
 
 		std::atomic<AssetState> m_state = AssetState::Uninitialized;
+
+		int32 m_loadPriority = 0;
 	};
 }
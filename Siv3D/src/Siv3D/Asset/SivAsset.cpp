@@ -10,10 +10,27 @@
 //-----------------------------------------------
 
 # include <Siv3D/Asset.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
 # include "IAssetDetail.hpp"
+# include "IAsset.hpp"
+# include "AssetLoadQueue.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief ロード待ちの非同期ロードを取り消し、実行中であれば完了を待つ
+		static void CancelAndWait(const IAsset* asset, AsyncTask<void>& task)
+		{
+			SIV3D_ENGINE(Asset)->getLoader().cancel(asset);
+
+			if (task.isValid())
+			{
+				task.get();
+			}
+		}
+	}
+
 	IAsset::IAsset()
 		: pImpl{ std::make_shared<IAssetDetail>() } {}
 
@@ -45,6 +62,26 @@ namespace s3d
 			|| (state == AssetState::Failed));
 	}
 
+	int32 IAsset::getLoadPriority() const
+	{
+		return pImpl->getLoadPriority();
+	}
+
+	void IAsset::setLoadPriority(const int32 priority)
+	{
+		pImpl->setLoadPriority(priority);
+	}
+
+	Array<FilePath> IAsset::getSourcePaths() const
+	{
+		return{};
+	}
+
+	std::function<void()> IAsset::prepareReload(const String&)
+	{
+		return{};
+	}
+
 	bool IAsset::isUninitialized() const
 	{
 		return (pImpl->getState() == AssetState::Uninitialized);
@@ -59,4 +96,61 @@ namespace s3d
 	{
 		pImpl->setState(state);
 	}
+
+	bool IAsset::loadImpl(AsyncTask<void>& task, const std::function<bool()>& load)
+	{
+		if (isAsyncLoading())
+		{
+			// ロード待ちであれば取り消されて未ロードの状態に戻り、この場でロードする
+			detail::CancelAndWait(this, task);
+		}
+
+		if (isUninitialized())
+		{
+			const bool result = load();
+			setState(result ? AssetState::Loaded : AssetState::Failed);
+			return result;
+		}
+
+		return isLoaded();
+	}
+
+	void IAsset::loadAsyncImpl(AsyncTask<void>& task, std::function<bool()> load)
+	{
+		if (not isUninitialized())
+		{
+			return;
+		}
+
+		setState(AssetState::AsyncLoading);
+
+		task = SIV3D_ENGINE(Asset)->getLoader().enqueue(this, getLoadPriority(),
+			[this, load = std::move(load)]()
+			{
+				const bool result = load();
+				setState(result ? AssetState::Loaded : AssetState::Failed);
+				return result;
+			},
+			[this]()
+			{
+				setState(AssetState::Uninitialized);
+			});
+	}
+
+	void IAsset::releaseImpl(AsyncTask<void>& task, const std::function<void()>& release)
+	{
+		if (isAsyncLoading())
+		{
+			detail::CancelAndWait(this, task);
+		}
+
+		if (isUninitialized())
+		{
+			return;
+		}
+
+		release();
+
+		setState(AssetState::Uninitialized);
+	}
 }
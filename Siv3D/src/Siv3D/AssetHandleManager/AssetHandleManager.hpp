@@ -10,10 +10,14 @@
 //-----------------------------------------------
 
 # pragma once
+# include <bit>
 # include <memory>
 # include <mutex>
+# include <atomic>
+# include <utility>
+# include <iterator>
 # include <Siv3D/Common.hpp>
-# include <Siv3D/HashTable.hpp>
+# include <Siv3D/Array.hpp>
 # include <Siv3D/String.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
@@ -21,44 +25,190 @@
 
 namespace s3d
 {
+	/// @brief アセットの ID とデータを管理する世代付きスロットマップ
+	/// @remark アセット ID の下位ビットをスロット番号、上位ビットを世代として使います。
+	/// @remark スロットはチャンク単位で確保され再配置されないため、`operator[]` はロックを取らずに wait-free で参照できます。
+	/// @remark `add()` / `erase()` はミューテックスで保護され、空きスロットのリストにより O(1) で実行されます。
 	template <class IDType, class Data>
 	class AssetHandleManager
 	{
-	private:
+	public:
 
-		using MapType = HashTable<IDType, std::unique_ptr<Data>>;
+		using value_type = typename IDType::value_type;
 
-		MapType m_data;
+		/// @brief スロット番号に使うビット数（32-bit 環境では 20 ビット、それ以外では 32 ビット）
+		static constexpr uint32 IndexBits = ((sizeof(value_type) < 8) ? 20 : 32);
 
-		String m_assetTypeName;
+		/// @brief 世代に使うビット数
+		static constexpr uint32 GenerationBits = static_cast<uint32>(sizeof(value_type) * 8 - IndexBits);
 
-		typename IDType::value_type m_idCount = 0;
+		static constexpr value_type IndexMask = ((value_type{ 1 } << IndexBits) - 1);
 
-		bool m_idFilled = false;
+		static constexpr value_type GenerationMask = ((value_type{ 1 } << GenerationBits) - 1);
 
-		std::mutex m_mutex;
+		/// @brief 作成できるスロット番号の上限（すべてのビットが 1 の ID は Invalid として予約）
+		static constexpr value_type MaxIndex = IndexMask;
 
-	public:
+		class iterator
+		{
+		public:
+
+			using iterator_category	= std::forward_iterator_tag;
+			using value_type		= std::pair<IDType, Data*>;
+			using difference_type	= std::ptrdiff_t;
+			using pointer			= const value_type*;
+			using reference			= const value_type&;
+
+			SIV3D_NODISCARD_CXX20
+			iterator() = default;
+
+			SIV3D_NODISCARD_CXX20
+			iterator(const AssetHandleManager* manager, const typename AssetHandleManager::value_type index) noexcept
+				: m_manager{ manager }
+				, m_index{ index }
+			{
+				skipVacant();
+			}
+
+			iterator& operator ++() noexcept
+			{
+				++m_index;
+				skipVacant();
+				return *this;
+			}
+
+			iterator operator ++(int) noexcept
+			{
+				iterator tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			[[nodiscard]]
+			reference operator *() const noexcept
+			{
+				return m_current;
+			}
+
+			[[nodiscard]]
+			pointer operator ->() const noexcept
+			{
+				return &m_current;
+			}
+
+			[[nodiscard]]
+			bool operator ==(const iterator& other) const noexcept
+			{
+				return (m_index == other.m_index);
+			}
+
+			[[nodiscard]]
+			bool operator !=(const iterator& other) const noexcept
+			{
+				return (m_index != other.m_index);
+			}
+
+		private:
+
+			const AssetHandleManager* m_manager = nullptr;
+
+			typename AssetHandleManager::value_type m_index = 0;
+
+			value_type m_current{ IDType::NullAsset(), nullptr };
+
+			void skipVacant() noexcept
+			{
+				const auto last = m_manager->m_nextIndex;
+
+				for (; m_index < last; ++m_index)
+				{
+					const Slot& slot = m_manager->getSlot(m_index);
+
+					if (Data* data = slot.data.load(std::memory_order_acquire))
+					{
+						m_current = { MakeID(m_index, slot.generation.load(std::memory_order_relaxed)), data };
+						return;
+					}
+				}
+
+				m_index = last;
+			}
+		};
 
-		using iterator = typename MapType::iterator;
-		using const_iterator = typename MapType::const_iterator;
+		using const_iterator = iterator;
 
 		explicit AssetHandleManager(const String& name)
 			: m_assetTypeName{ name } {}
 
+		AssetHandleManager(const AssetHandleManager&) = delete;
+
+		AssetHandleManager& operator =(const AssetHandleManager&) = delete;
+
+		~AssetHandleManager()
+		{
+			for (value_type i = 0; i < m_nextIndex; ++i)
+			{
+				delete getSlot(i).data.load(std::memory_order_relaxed);
+			}
+
+			for (auto& chunk : m_chunks)
+			{
+				delete[] chunk.load(std::memory_order_relaxed);
+			}
+		}
+
 		void setNullData(std::unique_ptr<Data>&& data)
 		{
-			m_data.emplace(IDType::NullAsset(), std::move(data));
+			std::lock_guard lock{ m_mutex };
+
+			if (m_nextIndex == 0)
+			{
+				allocateSlot();
+			}
+
+			Slot& slot = getSlot(0);
+
+			delete slot.data.exchange(data.release(), std::memory_order_acq_rel);
+
+			m_size.fetch_add(1, std::memory_order_relaxed);
 
 			LOG_TRACE(U"💠 Created {0}[0(null)]"_fmt(m_assetTypeName));
 		}
 
+		/// @brief ID に対応するデータを返します。
+		/// @param id アセット ID
+		/// @return ID に対応するデータ。既に解放された ID や無効な ID の場合は nullptr
+		/// @remark ロックを取らずに参照します。
 		[[nodiscard]]
-		Data* operator [](const IDType id)
+		Data* operator [](const IDType id) const noexcept
 		{
-			std::lock_guard lock{ m_mutex };
+			const value_type index = (id.value() & IndexMask);
+
+			const Slot* chunk;
+			size_t offset;
+
+			if (not locate(index, chunk, offset))
+			{
+				return nullptr;
+			}
+
+			const Slot& slot = chunk[offset];
+			const value_type generation = GenerationOf(id);
+
+			if (slot.generation.load(std::memory_order_acquire) != generation)
+			{
+				return nullptr;
+			}
 
-			return m_data[id].get();
+			Data* data = slot.data.load(std::memory_order_acquire);
+
+			// 読み取りの間にスロットが解放・再利用されていないかを確認する
+			if (slot.generation.load(std::memory_order_acquire) != generation)
+			{
+				return nullptr;
+			}
+
+			return data;
 		}
 
 		[[nodiscard]]
@@ -66,43 +216,43 @@ namespace s3d
 		{
 			std::lock_guard lock{ m_mutex };
 
-			if (++m_idCount == IDType::InvalidID)
+			value_type index;
+
+			if (m_freeIndices)
 			{
-				m_idFilled = true;
-				m_idCount = 0;
+				index = m_freeIndices.back();
+				m_freeIndices.pop_back();
 			}
-
-			if (not m_idFilled)
+			else if (m_nextIndex == 0)
 			{
-				m_data.emplace(m_idCount, std::move(data));
-
-				LOG_TRACE(U"💠 Created {0}[{1}] {2}"_fmt(m_assetTypeName, m_idCount, info));
-
-				return IDType(m_idCount);
+				// スロット 0 は Null アセット用に予約する
+				allocateSlot();
+				index = allocateSlot();
+			}
+			else if (m_nextIndex < MaxIndex)
+			{
+				index = allocateSlot();
 			}
 			else
 			{
-				if (m_data.size() == (IDType::InvalidID - 1))
-				{
-					LOG_FAIL(U"❌ No more {0}s can be created"_fmt(m_assetTypeName));
+				LOG_FAIL(U"❌ No more {0}s can be created"_fmt(m_assetTypeName));
 
-					return IDType::NullAsset();
-				}
+				return IDType::NullAsset();
+			}
 
-				while (++m_idCount < IDType::InvalidID)
-				{
-					if (m_data.find(IDType(++m_idCount)) == m_data.end())
-					{
-						m_data.emplace(m_idCount, std::move(data));
+			Slot& slot = getSlot(index);
+			const value_type generation = slot.generation.load(std::memory_order_relaxed);
 
-						LOG_TRACE(U"💠 Created {0}[{1}] {2}"_fmt(m_assetTypeName, m_idCount, info));
+			slot.data.store(data.release(), std::memory_order_release);
 
-						return IDType(m_idCount);
-					}
-				}
+			// データの書き込みを公開する
+			slot.generation.store(generation, std::memory_order_release);
 
-				return IDType::NullAsset();
-			}
+			m_size.fetch_add(1, std::memory_order_relaxed);
+
+			LOG_TRACE(U"💠 Created {0}[{1}] {2}"_fmt(m_assetTypeName, index, info));
+
+			return MakeID(index, generation);
 		}
 
 		void erase(const IDType id)
@@ -112,15 +262,45 @@ namespace s3d
 				return;
 			}
 
-			std::lock_guard lock{ m_mutex };
+			std::unique_ptr<Data> data;
+
+			{
+				std::lock_guard lock{ m_mutex };
+
+				const value_type index = (id.value() & IndexMask);
+
+				assert(index < m_nextIndex);
+
+				if (m_nextIndex <= index)
+				{
+					return;
+				}
+
+				Slot& slot = getSlot(index);
+
+				assert(slot.generation.load(std::memory_order_relaxed) == GenerationOf(id));
+
+				// 既に解放された ID の場合、スロットを再利用している別のアセットを解放しない
+				if (slot.generation.load(std::memory_order_relaxed) != GenerationOf(id))
+				{
+					return;
+				}
+
+				// 先に世代を進め、古い ID による参照を無効にする
+				slot.generation.store(((GenerationOf(id) + 1) & GenerationMask), std::memory_order_release);
 
-			const auto it = m_data.find(id);
+				data.reset(slot.data.exchange(nullptr, std::memory_order_acq_rel));
 
-			assert(it != m_data.end());
+				assert(data);
 
-			LOG_TRACE(U"♻️ Released {0}[{1}]"_fmt(m_assetTypeName, id.value()));
+				m_freeIndices.push_back(index);
 
-			m_data.erase(it);
+				m_size.fetch_sub(1, std::memory_order_relaxed);
+
+				LOG_TRACE(U"♻️ Released {0}[{1}]"_fmt(m_assetTypeName, index));
+			}
+
+			data.reset();
 
 			SIV3D_ENGINE(AssetMonitor)->released();
 		}
@@ -129,50 +309,146 @@ namespace s3d
 		{
 			std::lock_guard lock{ m_mutex };
 
-			for (const auto& data : m_data)
+			for (value_type index = 0; index < m_nextIndex; ++index)
 			{
-				if (const auto id = data.first; !id.isNull())
+				Slot& slot = getSlot(index);
+
+				Data* data = slot.data.exchange(nullptr, std::memory_order_acq_rel);
+
+				if (not data)
 				{
-					LOG_TRACE(U"♻️ Released {0}[{1}]"_fmt(m_assetTypeName, id.value()));
+					continue;
+				}
+
+				if (index != 0)
+				{
+					LOG_TRACE(U"♻️ Released {0}[{1}]"_fmt(m_assetTypeName, index));
+
+					slot.generation.store(((slot.generation.load(std::memory_order_relaxed) + 1) & GenerationMask), std::memory_order_release);
+
+					m_freeIndices.push_back(index);
 				}
 				else
 				{
 					LOG_TRACE(U"♻️ Released {0}[0(null)]"_fmt(m_assetTypeName));
 				}
+
+				delete data;
 			}
 
-			m_data.clear();
+			m_size.store(0, std::memory_order_relaxed);
 		}
 
 		[[nodiscard]]
-		iterator begin()
+		iterator begin() const noexcept
 		{
-			return m_data.begin();
+			return iterator{ this, 0 };
 		}
 
 		[[nodiscard]]
-		iterator end()
+		iterator end() const noexcept
 		{
-			return m_data.end();
+			return iterator{ this, m_nextIndex };
 		}
 
 		[[nodiscard]]
-		const_iterator begin() const
+		size_t size() const noexcept
 		{
-			return m_data.cbegin();
+			return m_size.load(std::memory_order_relaxed);
 		}
 
+	private:
+
+		struct Slot
+		{
+			std::atomic<Data*> data{ nullptr };
+
+			std::atomic<value_type> generation{ 0 };
+		};
+
+		/// @brief 最初のチャンクのスロット数の log2
+		static constexpr uint32 BaseChunkShift = 8;
+
+		/// @brief チャンク k のスロット数は (1 << (BaseChunkShift + k))
+		static constexpr uint32 MaxChunks = (IndexBits - BaseChunkShift + 1);
+
+		std::atomic<Slot*> m_chunks[MaxChunks] = {};
+
+		Array<value_type> m_freeIndices;
+
+		String m_assetTypeName;
+
+		value_type m_nextIndex = 0;
+
+		std::atomic<size_t> m_size{ 0 };
+
+		std::mutex m_mutex;
+
 		[[nodiscard]]
-		const_iterator end() const
+		static constexpr IDType MakeID(const value_type index, const value_type generation) noexcept
 		{
-			return m_data.cend();
+			return IDType{ ((generation << IndexBits) | index) };
 		}
 
 		[[nodiscard]]
-		size_t size() const noexcept
+		static constexpr value_type GenerationOf(const IDType id) noexcept
+		{
+			return ((id.value() >> IndexBits) & GenerationMask);
+		}
+
+		[[nodiscard]]
+		static constexpr uint32 ChunkIndex(const value_type index) noexcept
 		{
-			return m_data.size();
+			return static_cast<uint32>(std::bit_width(index + (value_type{ 1 } << BaseChunkShift)) - 1 - BaseChunkShift);
+		}
+
+		[[nodiscard]]
+		static constexpr size_t ChunkOffset(const value_type index, const uint32 chunkIndex) noexcept
+		{
+			return static_cast<size_t>((index + (value_type{ 1 } << BaseChunkShift)) - (value_type{ 1 } << (BaseChunkShift + chunkIndex)));
+		}
+
+		[[nodiscard]]
+		bool locate(const value_type index, const Slot*& chunk, size_t& offset) const noexcept
+		{
+			if (MaxIndex <= index)
+			{
+				return false;
+			}
+
+			const uint32 chunkIndex = ChunkIndex(index);
+
+			if (not (chunk = m_chunks[chunkIndex].load(std::memory_order_acquire)))
+			{
+				return false;
+			}
+
+			offset = ChunkOffset(index, chunkIndex);
+
+			return true;
+		}
+
+		[[nodiscard]]
+		Slot& getSlot(const value_type index) const noexcept
+		{
+			const uint32 chunkIndex = ChunkIndex(index);
+
+			return m_chunks[chunkIndex].load(std::memory_order_acquire)[ChunkOffset(index, chunkIndex)];
+		}
+
+		value_type allocateSlot()
+		{
+			const value_type index = m_nextIndex;
+			const uint32 chunkIndex = ChunkIndex(index);
+
+			if (not m_chunks[chunkIndex].load(std::memory_order_relaxed))
+			{
+				m_chunks[chunkIndex].store(new Slot[size_t{ 1 } << (BaseChunkShift + chunkIndex)], std::memory_order_release);
+			}
+
+			++m_nextIndex;
+
+			return index;
 		}
 	};
 }
-
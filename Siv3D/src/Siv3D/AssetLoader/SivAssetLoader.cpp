@@ -0,0 +1,61 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/AssetLoader.hpp>
+# include <Siv3D/Asset/IAsset.hpp>
+# include <Siv3D/Asset/AssetLoadQueue.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+namespace s3d
+{
+	namespace AssetLoader
+	{
+		void SetMaxConcurrency(const size_t maxConcurrency)
+		{
+			SIV3D_ENGINE(Asset)->getLoader().setMaxConcurrency(maxConcurrency);
+		}
+
+		size_t GetMaxConcurrency()
+		{
+			return SIV3D_ENGINE(Asset)->getLoader().getMaxConcurrency();
+		}
+
+		AssetLoadProgress GetProgress()
+		{
+			return SIV3D_ENGINE(Asset)->getLoader().getProgress();
+		}
+
+		void ResetProgress()
+		{
+			SIV3D_ENGINE(Asset)->getLoader().resetProgress();
+		}
+
+		void CancelAll()
+		{
+			SIV3D_ENGINE(Asset)->getLoader().cancelAll();
+		}
+
+		bool EnableHotReload(const FilePathView directory)
+		{
+			return SIV3D_ENGINE(Asset)->enableHotReload(directory);
+		}
+
+		void DisableHotReload()
+		{
+			SIV3D_ENGINE(Asset)->disableHotReload();
+		}
+
+		bool IsHotReloadEnabled()
+		{
+			return SIV3D_ENGINE(Asset)->isHotReloadEnabled();
+		}
+	}
+}
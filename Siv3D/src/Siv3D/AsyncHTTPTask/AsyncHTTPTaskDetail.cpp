@@ -12,71 +12,34 @@
 # include <Siv3D/Common.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Network/INetwork.hpp>
+# include <Siv3D/Network/HTTPClient.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
 # include "AsyncHTTPTaskDetail.hpp"
 
-# define CURL_STATICLIB
-# if SIV3D_PLATFORM(WINDOWS) | SIV3D_PLATFORM(WEB)
-#	include <ThirdParty-prebuilt/curl/curl.h>
-# else
-#	include <curl/curl.h>
-# endif
-
 namespace s3d
 {
-	namespace detail
-	{
-		static size_t WriteAsyncCallback(const char* ptr, const size_t size, const size_t nmemb, IWriter* pWriter)
-		{
-			const size_t size_bytes = (size * nmemb);
-
-			pWriter->write(ptr, size_bytes);
-
-			return size_bytes;
-		}
-
-		static size_t HeaderAsyncCallback(const char* buffer, const size_t size, const size_t nitems, std::string* userData)
-		{
-			const size_t size_bytes = (size * nitems);
-
-			userData->append(buffer, size_bytes);
-
-			return size_bytes;
-		}
-
-		static int ProgressCallback(AsyncHTTPTaskDetail* progress, const curl_off_t dlTotal, const curl_off_t dlNow, const curl_off_t ulTotal, const curl_off_t ulNow)
-		{
-			progress->updateProgress(dlTotal, dlNow, ulTotal, ulNow);
-
-			if (progress->isAborted())
-			{
-				return CURLE_ABORTED_BY_CALLBACK;
-			}
-
-			return 0;
-		}
-	}
-
 	AsyncHTTPTaskDetail::AsyncHTTPTaskDetail() {}
 
-	AsyncHTTPTaskDetail::AsyncHTTPTaskDetail(const URLView url, const HashTable<String, String>& headers, const FilePathView path)
+	AsyncHTTPTaskDetail::AsyncHTTPTaskDetail(const URLView url, const HashTable<String, String>& headers, const FilePathView path, const int32 priority)
 		: m_url{ url }
 		, m_writer{ BinaryWriter{ path }, {}, {}, true }
 		, m_headers{ headers }
 	{
 		m_writer.path = m_writer.file.path();
 
-		m_task = Async(&AsyncHTTPTaskDetail::runGet, this);
+		submit(false, priority);
 	}
 
-	AsyncHTTPTaskDetail::AsyncHTTPTaskDetail(const URLView url, const HashTable<String, String>& headers)
+	AsyncHTTPTaskDetail::AsyncHTTPTaskDetail(const URLView url, const HashTable<String, String>& headers, const int32 priority)
 		: m_url{ url }
 		, m_writer{ {}, {}, {}, false }
 		, m_headers{ headers }
 	{
-		m_task = Async(&AsyncHTTPTaskDetail::runGet, this);
+		submit(false, priority);
 	}
 
-	AsyncHTTPTaskDetail::AsyncHTTPTaskDetail(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const FilePathView path)
+	AsyncHTTPTaskDetail::AsyncHTTPTaskDetail(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const FilePathView path, const int32 priority)
 		: m_url{ url }
 		, m_writer{ BinaryWriter{ path }, {}, {}, true }
 		, m_headers{ headers }
@@ -84,26 +47,22 @@ namespace s3d
 	{
 		m_writer.path = m_writer.file.path();
 
-		m_task = Async(&AsyncHTTPTaskDetail::runPost, this);
+		submit(true, priority);
 	}
 
-	AsyncHTTPTaskDetail::AsyncHTTPTaskDetail(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size)
+	AsyncHTTPTaskDetail::AsyncHTTPTaskDetail(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const int32 priority)
 		: m_url{ url }
 		, m_writer{ {}, {}, {}, false }
 		, m_headers{ headers }
 		, m_blob{ src, size }
 	{
-		m_task = Async(&AsyncHTTPTaskDetail::runPost, this);
+		submit(true, priority);
 	}
 
 	AsyncHTTPTaskDetail::~AsyncHTTPTaskDetail()
 	{
-		if (getStatus() == HTTPAsyncStatus::Downloading)
-		{
-			m_abort = true;
-
-			m_task.wait();
-		}
+		// 転送待ち・転送中のリクエストは this を参照しているので、完了を待つ
+		cancel();
 	}
 
 	bool AsyncHTTPTaskDetail::isEmpty() const noexcept
@@ -118,10 +77,12 @@ namespace s3d
 
 	void AsyncHTTPTaskDetail::cancel()
 	{
-		if (m_task.isValid())
+		if (m_task.isValid() && (not m_task.isReady()))
 		{
 			m_abort = true;
 
+			SIV3D_ENGINE(Network)->getHTTPClient().notifyAbort();
+
 			m_task.wait();
 		}
 	}
@@ -207,164 +168,71 @@ namespace s3d
 		m_blob.release();
 	}
 
-	HTTPResponse AsyncHTTPTaskDetail::runGet()
+	void AsyncHTTPTaskDetail::submit(const bool isPost, const int32 priority)
 	{
+		m_task = m_promise.get_future();
+
 		if (m_writer.isFile && (not m_writer.file))
 		{
 			setStatus(HTTPAsyncStatus::Failed);
-			return{};
+			m_promise.set_value({});
+			return;
 		}
 
-		::CURL* curl = ::curl_easy_init();
-		{
-			if (not curl)
-			{
-				setStatus(HTTPAsyncStatus::Failed);
-				close();
-				return{};
-			}
-		}
+		HTTPClient::Request request;
+		request.url = m_url.toUTF8();
 
 		// ヘッダの追加
-		::curl_slist* header_slist = nullptr;
+		for (auto&& [key, value] : m_headers)
 		{
-			for (auto&& [key, value] : m_headers)
-			{
-				const std::string header = (key.toUTF8() + ": " + value.toUTF8());
-				header_slist = ::curl_slist_append(header_slist, header.c_str());
-			}
+			request.headers.push_back(key.toUTF8() + ": " + value.toUTF8());
 		}
 
-		setStatus(HTTPAsyncStatus::Downloading);
-
-		const std::string urlUTF8 = m_url.toUTF8();
-		::curl_easy_setopt(curl, ::CURLOPT_URL, urlUTF8.c_str());
-		::curl_easy_setopt(curl, ::CURLOPT_FOLLOWLOCATION, 1L);
-		::curl_easy_setopt(curl, ::CURLOPT_HTTPHEADER, header_slist);
-		::curl_easy_setopt(curl, ::CURLOPT_WRITEFUNCTION, detail::WriteAsyncCallback);
-		::curl_easy_setopt(curl, ::CURLOPT_WRITEDATA, m_writer.getIWriter());
-		::curl_easy_setopt(curl, ::CURLOPT_XFERINFOFUNCTION, detail::ProgressCallback);
-		::curl_easy_setopt(curl, ::CURLOPT_XFERINFODATA, this);
-		::curl_easy_setopt(curl, ::CURLOPT_NOPROGRESS, 0L);
-
-		// レスポンスヘッダーの設定
-		std::string responseHeaders;
+		if (isPost)
 		{
-			::curl_easy_setopt(curl, ::CURLOPT_HEADERFUNCTION, detail::HeaderAsyncCallback);
-			::curl_easy_setopt(curl, ::CURLOPT_HEADERDATA, &responseHeaders);
+			request.isPost = true;
+			request.postData = m_blob.data();
+			request.postSize = m_blob.size_bytes();
 		}
 
-		const ::CURLcode result = ::curl_easy_perform(curl);
-		::curl_easy_cleanup(curl);
-		::curl_slist_free_all(header_slist);
-
-		close();
-
-		if (result != ::CURLE_OK)
-		{
-			LOG_FAIL(U"curl failed (CURLcode: {})"_fmt(FromEnum(result)));
-
-			if (result == ::CURLE_ABORTED_BY_CALLBACK)
+		request.writer = m_writer.getIWriter();
+		request.priority = priority;
+		request.abort = &m_abort;
+		request.onProgress = [this](const int64 dlTotal, const int64 dlNow, const int64 ulTotal, const int64 ulNow)
 			{
-				setStatus(HTTPAsyncStatus::Canceled);
-			}
-			else
-			{
-				setStatus(HTTPAsyncStatus::Failed);
-			}
-
-			if (m_writer.path)
+				updateProgress(dlTotal, dlNow, ulTotal, ulNow);
+			};
+		request.onComplete = [this](const HTTPAsyncStatus status, std::string&& responseHeaders)
 			{
-				FileSystem::Remove(m_writer.path);
-			}
+				onComplete(status, std::move(responseHeaders));
+			};
 
-			return{};
-		}
-
-		setStatus(HTTPAsyncStatus::Succeeded);
+		// 転送の開始を待っている間もダウンロード中として扱う
+		setStatus(HTTPAsyncStatus::Downloading);
 
-		return HTTPResponse{ responseHeaders };
+		SIV3D_ENGINE(Network)->getHTTPClient().submit(std::move(request));
 	}
 
-	HTTPResponse AsyncHTTPTaskDetail::runPost()
+	void AsyncHTTPTaskDetail::onComplete(const HTTPAsyncStatus status, std::string&& responseHeaders)
 	{
-		if (m_writer.isFile && (not m_writer.file))
-		{
-			setStatus(HTTPAsyncStatus::Failed);
-			return{};
-		}
-
-		::CURL* curl = ::curl_easy_init();
-		{
-			if (not curl)
-			{
-				setStatus(HTTPAsyncStatus::Failed);
-				close();
-				return{};
-			}
-		}
-
-		// ヘッダの追加
-		::curl_slist* header_slist = nullptr;
-		{
-			for (auto&& [key, value] : m_headers)
-			{
-				const std::string header = (key.toUTF8() + ": " + value.toUTF8());
-				header_slist = ::curl_slist_append(header_slist, header.c_str());
-			}
-		}
-
-		setStatus(HTTPAsyncStatus::Downloading);
-
-		const std::string urlUTF8 = m_url.toUTF8();
-		::curl_easy_setopt(curl, ::CURLOPT_URL, urlUTF8.c_str());
-		::curl_easy_setopt(curl, ::CURLOPT_FOLLOWLOCATION, 1L);
-		::curl_easy_setopt(curl, ::CURLOPT_HTTPHEADER, header_slist);
-		::curl_easy_setopt(curl, ::CURLOPT_POST, 1L);
-		::curl_easy_setopt(curl, ::CURLOPT_POSTFIELDS, const_cast<char*>(static_cast<const char*>(static_cast<const void*>(m_blob.data()))));
-		::curl_easy_setopt(curl, ::CURLOPT_POSTFIELDSIZE, static_cast<long>(m_blob.size_bytes()));
-		::curl_easy_setopt(curl, ::CURLOPT_WRITEFUNCTION, detail::WriteAsyncCallback);
-		::curl_easy_setopt(curl, ::CURLOPT_WRITEDATA, m_writer.getIWriter());
-		::curl_easy_setopt(curl, ::CURLOPT_XFERINFOFUNCTION, detail::ProgressCallback);
-		::curl_easy_setopt(curl, ::CURLOPT_XFERINFODATA, this);
-		::curl_easy_setopt(curl, ::CURLOPT_NOPROGRESS, 0L);
-
-		// レスポンスヘッダーの設定
-		std::string responseHeaders;
-		{
-			::curl_easy_setopt(curl, ::CURLOPT_HEADERFUNCTION, detail::HeaderAsyncCallback);
-			::curl_easy_setopt(curl, ::CURLOPT_HEADERDATA, &responseHeaders);
-		}
-
-		const ::CURLcode result = ::curl_easy_perform(curl);
-		::curl_easy_cleanup(curl);
-		::curl_slist_free_all(header_slist);
-
 		close();
 
-		if (result != ::CURLE_OK)
+		if (status != HTTPAsyncStatus::Succeeded)
 		{
-			LOG_FAIL(U"curl failed (CURLcode: {})"_fmt(FromEnum(result)));
-
-			if (result == ::CURLE_ABORTED_BY_CALLBACK)
-			{
-				setStatus(HTTPAsyncStatus::Canceled);
-			}
-			else
-			{
-				setStatus(HTTPAsyncStatus::Failed);
-			}
+			setStatus(status);
 
 			if (m_writer.path)
 			{
 				FileSystem::Remove(m_writer.path);
 			}
 
-			return{};
+			m_promise.set_value({});
+
+			return;
 		}
 
 		setStatus(HTTPAsyncStatus::Succeeded);
 
-		return HTTPResponse{ responseHeaders };
+		m_promise.set_value(HTTPResponse{ responseHeaders });
 	}
 }
@@ -12,6 +12,7 @@
 # pragma once
 # include <atomic>
 # include <mutex>
+# include <future>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/AsyncTask.hpp>
 # include <Siv3D/URLView.hpp>
@@ -34,16 +35,16 @@ namespace s3d
 		AsyncHTTPTaskDetail();
 
 		SIV3D_NODISCARD_CXX20
-		AsyncHTTPTaskDetail(URLView url, const HashTable<String, String>& headers, FilePathView path);
+		AsyncHTTPTaskDetail(URLView url, const HashTable<String, String>& headers, FilePathView path, int32 priority);
 
 		SIV3D_NODISCARD_CXX20
-		AsyncHTTPTaskDetail(URLView url, const HashTable<String, String>& headers);
+		AsyncHTTPTaskDetail(URLView url, const HashTable<String, String>& headers, int32 priority);
 
 		SIV3D_NODISCARD_CXX20
-		AsyncHTTPTaskDetail(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView path);
+		AsyncHTTPTaskDetail(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, FilePathView path, int32 priority);
 
 		SIV3D_NODISCARD_CXX20
-		AsyncHTTPTaskDetail(URLView url, const HashTable<String, String>& headers, const void* src, size_t size);
+		AsyncHTTPTaskDetail(URLView url, const HashTable<String, String>& headers, const void* src, size_t size, int32 priority);
 
 		~AsyncHTTPTaskDetail();
 
@@ -84,9 +85,11 @@ namespace s3d
 
 		void close();
 
-		HTTPResponse runGet();
+		/// @brief エンジンの HTTPClient にリクエストを追加します。
+		void submit(bool isPost, int32 priority);
 
-		HTTPResponse runPost();
+		/// @brief HTTPClient のスレッドから、転送の完了時に呼ばれます。
+		void onComplete(HTTPAsyncStatus status, std::string&& responseHeaders);
 
 		////
 		//
@@ -128,6 +131,8 @@ namespace s3d
 
 		Blob m_blob;
 
+		std::promise<HTTPResponse> m_promise;
+
 		AsyncTask<HTTPResponse> m_task;
 
 		HTTPResponse m_response;
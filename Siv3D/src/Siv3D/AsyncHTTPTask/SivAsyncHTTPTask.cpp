@@ -114,15 +114,15 @@ namespace s3d
 		}
 	}
 
-	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers, const FilePathView path)
-		: pImpl{ std::make_shared<AsyncHTTPTaskDetail>(url, headers, path) } {}
+	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers, const FilePathView path, const int32 priority)
+		: pImpl{ std::make_shared<AsyncHTTPTaskDetail>(url, headers, path, priority) } {}
 
-	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers)
-		: pImpl{ std::make_shared<AsyncHTTPTaskDetail>(url, headers) } {}
+	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers, const int32 priority)
+		: pImpl{ std::make_shared<AsyncHTTPTaskDetail>(url, headers, priority) } {}
 
-	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const FilePathView path)
-		: pImpl{ std::make_shared<AsyncHTTPTaskDetail>(url, headers, src, size, path) } {}
+	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const FilePathView path, const int32 priority)
+		: pImpl{ std::make_shared<AsyncHTTPTaskDetail>(url, headers, src, size, path, priority) } {}
 
-	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size)
-		: pImpl{ std::make_shared<AsyncHTTPTaskDetail>(url, headers, src, size) } {}
+	AsyncHTTPTask::AsyncHTTPTask(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const int32 priority)
+		: pImpl{ std::make_shared<AsyncHTTPTaskDetail>(url, headers, src, size, priority) } {}
 }
\ No newline at end of file
@@ -21,6 +21,7 @@
 # include <ThirdParty/soloud/include/soloud_wavstream.h>
 # include <ThirdParty/soloud/include/soloud_speech.h>
 # include "DynamicAudioSource.hpp"
+# include "StreamingAudioSource.hpp"
 
 namespace s3d
 {
@@ -180,6 +181,27 @@ namespace s3d
 		m_initialized	= true;
 	}
 
+	AudioData::AudioData(SoLoud::Soloud* pSoloud, AudioStreamWorker* pWorker, const FilePathView path, const AudioFormat audioFormat, std::unique_ptr<IAudioStreamDecoder>&& decoder, const Optional<uint64>& loopBegin)
+		: m_pSoloud{ pSoloud }
+		, m_isStreaming{ true }
+		, m_loop{ loopBegin.has_value() }
+	{
+		m_sampleRate	= decoder->sampleRate();
+		m_lengthSample	= static_cast<uint32>(Min<uint64>(decoder->lengthSample(), UINT32_MAX));
+
+		std::unique_ptr<StreamingAudioSource> source = std::make_unique<StreamingAudioSource>(pWorker, path, audioFormat, std::move(decoder));
+		m_streamingSource = source.get();
+		m_audioSource	= std::move(source);
+
+		if (loopBegin)
+		{
+			m_loopTiming = { *loopBegin, 0 };
+			m_streamingSource->setStreamLoop(true, *loopBegin);
+		}
+
+		m_initialized	= true;
+	}
+
 	AudioData::AudioData(Dynamic, SoLoud::Soloud* pSoloud, const std::shared_ptr<IAudioStream>& pAudioStream, const Arg::sampleRate_<uint32> sampleRate)
 		: m_pSoloud{ pSoloud }
 		, m_isStreaming{ true }
@@ -292,14 +314,30 @@ namespace s3d
 			return;
 		}
 
-		m_audioSource->setLooping(loop);
+		if (m_streamingSource)
+		{
+			m_streamingSource->setStreamLoop(loop, m_loopTiming.beginPos);
+		}
+		else
+		{
+			m_audioSource->setLooping(loop);
+		}
+
 		m_loop = loop;
 	}
 	
 	void AudioData::setLoopPoint(const Duration& loopBegin)
 	{
-		m_audioSource->setLoopPoint(loopBegin.count());
-		m_loopTiming.beginPos = static_cast<uint64>(loopBegin.count() / m_sampleRate);
+		m_loopTiming.beginPos = static_cast<uint64>(loopBegin.count() * m_sampleRate);
+
+		if (m_streamingSource)
+		{
+			m_streamingSource->setStreamLoop(m_loop, m_loopTiming.beginPos);
+		}
+		else
+		{
+			m_audioSource->setLoopPoint(loopBegin.count());
+		}
 	}
 
 	void AudioData::play(const size_t busIndex)
@@ -15,11 +15,15 @@
 # include <Siv3D/Wave.hpp>
 # include <Siv3D/Audio.hpp>
 # include <Siv3D/KlattTTSParameters.hpp>
+# include <Siv3D/IAudioStreamDecoder.hpp>
 # include "AudioResourceHolder.hpp"
 # include <ThirdParty/soloud/include/soloud.h>
 
 namespace s3d
 {
+	class AudioStreamWorker;
+	class StreamingAudioSource;
+
 	class AudioData
 	{
 	public:
@@ -40,6 +44,8 @@ namespace s3d
 
 		AudioData(SoLoud::Soloud* pSoloud, FilePathView path, uint64 loopBegin);
 
+		AudioData(SoLoud::Soloud* pSoloud, AudioStreamWorker* pWorker, FilePathView path, AudioFormat audioFormat, std::unique_ptr<IAudioStreamDecoder>&& decoder, const Optional<uint64>& loopBegin);
+
 		AudioData(Dynamic, SoLoud::Soloud* pSoloud, const std::shared_ptr<IAudioStream>& pAudioStream, Arg::sampleRate_<uint32> sampleRate);
 
 		AudioData(TextToSpeech, SoLoud::Soloud* pSoloud, StringView text, const KlattTTSParameters& param);
@@ -150,6 +156,9 @@ namespace s3d
 
 		std::unique_ptr<SoLoud::AudioSource> m_audioSource;
 
+		/// @brief m_audioSource が StreamingAudioSource である場合、そのポインタ
+		StreamingAudioSource* m_streamingSource = nullptr;
+
 		SoLoud::Soloud* m_pSoloud = nullptr;
 
 		Wave m_wave;
@@ -0,0 +1,305 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <chrono>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Profiler.hpp>
+# include "AudioStreamWorker.hpp"
+
+namespace s3d
+{
+	static_assert((AudioFileStream::BufferSamples & (AudioFileStream::BufferSamples - 1)) == 0);
+
+	static_assert((AudioFileStream::MaxLoopMarks & (AudioFileStream::MaxLoopMarks - 1)) == 0);
+
+	AudioFileStream::AudioFileStream(std::unique_ptr<IAudioStreamDecoder>&& decoder, const std::shared_ptr<const AudioStreamLoop>& loop)
+		: m_decoder{ std::move(decoder) }
+		, m_loop{ loop }
+		, m_buffer{ std::make_unique<WaveSample[]>(BufferSamples) }
+		, m_sampleRate{ m_decoder->sampleRate() }
+		, m_lengthSample{ m_decoder->lengthSample() } {}
+
+	AudioFileStream::~AudioFileStream()
+	{
+		LOG_TRACE_EVENT(U"AudioFileStream: decoded {} samples in {} us (underruns: {})",
+			m_decodedSamples, (m_decodeTimeNanosec / 1000), m_underrunCount.load());
+	}
+
+	void AudioFileStream::getAudio(float* left, float* right, const size_t samplesToWrite)
+	{
+		uint32 loopCount = 0;
+		const size_t samplesRead = read(left, right, samplesToWrite, loopCount);
+
+		if (samplesRead < samplesToWrite)
+		{
+			std::fill(left + samplesRead, left + samplesToWrite, 0.0f);
+			std::fill(right + samplesRead, right + samplesToWrite, 0.0f);
+
+			if ((not m_decoderEnded.load(std::memory_order_acquire))
+				&& (not isSeekPending()))
+			{
+				++m_underrunCount;
+			}
+		}
+	}
+
+	bool AudioFileStream::hasEnded()
+	{
+		if (isSeekPending())
+		{
+			return false;
+		}
+
+		return (m_decoderEnded.load(std::memory_order_acquire)
+			&& (m_readPos.load(std::memory_order_relaxed) == m_writePos.load(std::memory_order_acquire)));
+	}
+
+	void AudioFileStream::rewind()
+	{
+		seek(0);
+	}
+
+	size_t AudioFileStream::read(float* left, float* right, const size_t samples, uint32& loopCount) noexcept
+	{
+		// 古い位置の音声は fill() が捨てるので、それまでは何も読み出さない
+		if (isSeekPending())
+		{
+			return 0;
+		}
+
+		const uint64 startPos = m_readPos.load(std::memory_order_relaxed);
+		const uint64 endPos = Min<uint64>(m_writePos.load(std::memory_order_acquire), (startPos + samples));
+		uint64 markReadPos = m_loopMarkReadPos.load(std::memory_order_relaxed);
+		const uint64 markWritePos = m_loopMarkWritePos.load(std::memory_order_acquire);
+
+		for (uint64 readPos = startPos; readPos < endPos; ++readPos)
+		{
+			const WaveSample& sample = m_buffer[readPos & (BufferSamples - 1)];
+			*left++ = sample.left;
+			*right++ = sample.right;
+		}
+
+		// 読み出した範囲にあるループの境界を数える
+		while ((markReadPos < markWritePos)
+			&& (m_loopMarks[markReadPos & (MaxLoopMarks - 1)].load(std::memory_order_relaxed) < endPos))
+		{
+			++markReadPos;
+			++loopCount;
+		}
+
+		m_loopMarkReadPos.store(markReadPos, std::memory_order_release);
+		m_readPos.store(endPos, std::memory_order_release);
+
+		return static_cast<size_t>(endPos - startPos);
+	}
+
+	void AudioFileStream::seek(const uint64 samplePos) noexcept
+	{
+		m_seekTarget.store(samplePos, std::memory_order_relaxed);
+		m_seekRequested.fetch_add(1, std::memory_order_release);
+	}
+
+	void AudioFileStream::fill()
+	{
+		const uint64 seekRequested = m_seekRequested.load(std::memory_order_acquire);
+
+		if (seekRequested != m_seekApplied.load(std::memory_order_relaxed))
+		{
+			m_decoder->seek(m_seekTarget.load(std::memory_order_relaxed));
+			m_decoderEnded.store(false, std::memory_order_relaxed);
+
+			// read() は止まっているので、読み出し位置をここで進めて古い位置の音声を捨てる
+			m_readPos.store(m_writePos.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			m_loopMarkReadPos.store(m_loopMarkWritePos.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+			// 再生がすぐに始まるよう、少しだけデコードしてから読み出しを再開させる
+			decode(ChunkSamples);
+
+			m_seekApplied.store(seekRequested, std::memory_order_release);
+		}
+
+		decode(BufferSamples);
+	}
+
+	uint32 AudioFileStream::sampleRate() const noexcept
+	{
+		return m_sampleRate;
+	}
+
+	uint64 AudioFileStream::lengthSample() const noexcept
+	{
+		return m_lengthSample;
+	}
+
+	bool AudioFileStream::isSeekPending() const noexcept
+	{
+		return (m_seekApplied.load(std::memory_order_acquire) != m_seekRequested.load(std::memory_order_acquire));
+	}
+
+	void AudioFileStream::decode(const size_t maxSamples)
+	{
+		if (m_decoderEnded.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		const auto startTime = std::chrono::steady_clock::now();
+
+		uint64 writePos = m_writePos.load(std::memory_order_relaxed);
+		size_t samplesFilled = 0;
+		bool loopedWithoutData = false;
+
+		while (samplesFilled < maxSamples)
+		{
+			const size_t freeSamples = static_cast<size_t>(BufferSamples - (writePos - m_readPos.load(std::memory_order_acquire)));
+
+			if (freeSamples == 0)
+			{
+				break;
+			}
+
+			const size_t index = static_cast<size_t>(writePos & (BufferSamples - 1));
+			const size_t count = Min({ freeSamples, (BufferSamples - index), (maxSamples - samplesFilled) });
+			const size_t samplesRead = m_decoder->read(&m_buffer[index], count);
+
+			if (samplesRead == 0)
+			{
+				// ループする場合は、ループ開始位置に戻ってデコードを続ける
+				if ((not loopedWithoutData)
+					&& m_loop->enabled.load(std::memory_order_relaxed))
+				{
+					const uint64 markWritePos = m_loopMarkWritePos.load(std::memory_order_relaxed);
+
+					// 境界を記録できない場合は、読み出しが進むのを待つ
+					if ((markWritePos - m_loopMarkReadPos.load(std::memory_order_acquire)) == MaxLoopMarks)
+					{
+						break;
+					}
+
+					if (m_decoder->seek(m_loop->beginSample.load(std::memory_order_relaxed)))
+					{
+						m_loopMarks[markWritePos & (MaxLoopMarks - 1)].store(writePos, std::memory_order_relaxed);
+						m_loopMarkWritePos.store((markWritePos + 1), std::memory_order_release);
+						loopedWithoutData = true;
+						continue;
+					}
+				}
+
+				m_decoderEnded.store(true, std::memory_order_release);
+				break;
+			}
+
+			loopedWithoutData = false;
+			writePos += samplesRead;
+			samplesFilled += samplesRead;
+			m_writePos.store(writePos, std::memory_order_release);
+		}
+
+		m_decodeTimeNanosec += static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+		m_decodedSamples += samplesFilled;
+	}
+
+	AudioStreamWorker::~AudioStreamWorker()
+	{
+		shutdown();
+	}
+
+	void AudioStreamWorker::add(const std::shared_ptr<AudioFileStream>& stream)
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+
+			if (not m_thread.joinable())
+			{
+				LOG_TRACE(U"AudioStreamWorker: starting the decode thread");
+				m_abort = false;
+				m_thread = std::thread{ &AudioStreamWorker::run, this };
+			}
+
+			m_streams << stream;
+		}
+
+		m_condition.notify_one();
+	}
+
+	void AudioStreamWorker::remove(const AudioFileStream* stream)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_streams.remove_if([stream](const std::shared_ptr<AudioFileStream>& s) { return (s.get() == stream); });
+	}
+
+	void AudioStreamWorker::wake()
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+
+			m_wake = true;
+		}
+
+		m_condition.notify_one();
+	}
+
+	void AudioStreamWorker::shutdown()
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+
+			m_abort = true;
+		}
+
+		m_condition.notify_one();
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+		m_streams.clear();
+	}
+
+	void AudioStreamWorker::run()
+	{
+		Profiler::SetThreadName(U"AudioStream");
+
+		Array<std::shared_ptr<AudioFileStream>> streams;
+
+		std::unique_lock lock{ m_mutex };
+
+		while (not m_abort)
+		{
+			if (m_streams.isEmpty())
+			{
+				m_condition.wait(lock, [this]() { return (m_abort || (not m_streams.isEmpty())); });
+				continue;
+			}
+
+			streams = m_streams;
+			lock.unlock();
+
+			{
+				SIV3D_PROFILE_ZONE(U"Audio::decode");
+
+				for (const auto& stream : streams)
+				{
+					stream->fill();
+				}
+			}
+
+			// ストリームの破棄はロックの外で行う
+			streams.clear();
+
+			lock.lock();
+			m_condition.wait_for(lock, std::chrono::milliseconds{ PollIntervalMillisec }, [this]() { return (m_abort || m_wake); });
+			m_wake = false;
+		}
+	}
+}
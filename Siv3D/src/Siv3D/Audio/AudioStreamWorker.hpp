@@ -0,0 +1,173 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <atomic>
+# include <condition_variable>
+# include <mutex>
+# include <thread>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/IAudioStream.hpp>
+# include <Siv3D/IAudioStreamDecoder.hpp>
+
+namespace s3d
+{
+	/// @brief ストリーミング再生のループ設定（Audio と再生中のボイスで共有）
+	struct AudioStreamLoop
+	{
+		std::atomic<bool> enabled{ false };
+
+		std::atomic<uint64> beginSample{ 0 };
+	};
+
+	/// @brief 1 つのボイスが再生する音声を、デコーダから先読みしておくリングバッファ
+	/// @remark AudioStreamWorker のスレッドが `fill()` で書き込み、オーディオスレッドが `read()` で読み出します。
+	/// デコーダに触れるのは `fill()` だけなので、オーディオスレッドがデコードを待つことはありません。
+	class AudioFileStream : public IAudioStream
+	{
+	public:
+
+		/// @brief リングバッファのサンプル数（2 の累乗）
+		static constexpr size_t BufferSamples = 16384;
+
+		/// @brief 1 回の `fill()` でデコードする最大のサンプル数
+		static constexpr size_t ChunkSamples = 4096;
+
+		/// @brief バッファ内に保持できるループの境界の数（2 の累乗）
+		static constexpr size_t MaxLoopMarks = 64;
+
+		AudioFileStream(std::unique_ptr<IAudioStreamDecoder>&& decoder, const std::shared_ptr<const AudioStreamLoop>& loop);
+
+		~AudioFileStream() override;
+
+		/// @brief バッファの音声を読み出します。足りない分は無音で埋めます。
+		void getAudio(float* left, float* right, size_t samplesToWrite) override;
+
+		/// @brief 音声の終端まで再生し終えたかを返します。
+		[[nodiscard]]
+		bool hasEnded() override;
+
+		/// @brief 先頭に戻ります。
+		void rewind() override;
+
+		/// @brief バッファの音声を読み出します。
+		/// @param loopCount ループ開始位置に戻った回数を格納する変数
+		/// @return 読み出したサンプル数
+		[[nodiscard]]
+		size_t read(float* left, float* right, size_t samples, uint32& loopCount) noexcept;
+
+		/// @brief デコードする位置の変更を要求し、すぐに戻ります。
+		/// @remark 次の `fill()` が新しい位置からデコードするまで、`read()` は何も読み出しません。`read()` と同じスレッドから呼ぶ必要があります。
+		void seek(uint64 samplePos) noexcept;
+
+		/// @brief 位置の変更が要求されていれば適用し、バッファの空きをデコードした音声で埋めます。
+		void fill();
+
+		[[nodiscard]]
+		uint32 sampleRate() const noexcept;
+
+		[[nodiscard]]
+		uint64 lengthSample() const noexcept;
+
+	private:
+
+		std::unique_ptr<IAudioStreamDecoder> m_decoder;
+
+		std::shared_ptr<const AudioStreamLoop> m_loop;
+
+		std::unique_ptr<WaveSample[]> m_buffer;
+
+		std::atomic<uint64> m_writePos{ 0 };
+
+		std::atomic<uint64> m_readPos{ 0 };
+
+		std::atomic<bool> m_decoderEnded{ false };
+
+		/// @brief ループ開始位置に戻った箇所の書き込み位置
+		std::array<std::atomic<uint64>, MaxLoopMarks> m_loopMarks{};
+
+		std::atomic<uint64> m_loopMarkWritePos{ 0 };
+
+		std::atomic<uint64> m_loopMarkReadPos{ 0 };
+
+		/// @brief `seek()` で要求された位置
+		std::atomic<uint64> m_seekTarget{ 0 };
+
+		/// @brief `seek()` が呼ばれた回数
+		std::atomic<uint64> m_seekRequested{ 0 };
+
+		/// @brief `fill()` が適用した `seek()` の回数
+		std::atomic<uint64> m_seekApplied{ 0 };
+
+		uint32 m_sampleRate = 0;
+
+		uint64 m_lengthSample = 0;
+
+		/// @brief 計測用: デコードにかかった時間の合計
+		uint64 m_decodeTimeNanosec = 0;
+
+		/// @brief 計測用: デコードしたサンプル数の合計
+		uint64 m_decodedSamples = 0;
+
+		/// @brief 計測用: バッファが空で無音を出力した回数
+		std::atomic<uint32> m_underrunCount{ 0 };
+
+		/// @brief 要求された位置へのデコードがまだ済んでいないかを返します。
+		[[nodiscard]]
+		bool isSeekPending() const noexcept;
+
+		void decode(size_t maxSamples);
+	};
+
+	/// @brief すべてのストリーミング再生中のボイスのバッファを、1 つのバックグラウンドスレッドで埋める
+	class AudioStreamWorker
+	{
+	public:
+
+		AudioStreamWorker() = default;
+
+		~AudioStreamWorker();
+
+		/// @brief ストリームを登録します。最初の登録時にスレッドを開始します。
+		void add(const std::shared_ptr<AudioFileStream>& stream);
+
+		/// @brief ストリームの登録を解除します。
+		void remove(const AudioFileStream* stream);
+
+		/// @brief 次の確認の時間を待たずに、すぐにバッファを埋めさせます。
+		void wake();
+
+		/// @brief スレッドを終了します。
+		void shutdown();
+
+	private:
+
+		/// @brief バッファを確認する間隔 [ミリ秒]
+		/// @remark BufferSamples は 48 kHz で約 341 ミリ秒分
+		static constexpr int32 PollIntervalMillisec = 10;
+
+		std::mutex m_mutex;
+
+		std::condition_variable m_condition;
+
+		Array<std::shared_ptr<AudioFileStream>> m_streams;
+
+		std::thread m_thread;
+
+		bool m_abort = false;
+
+		bool m_wake = false;
+
+		void run();
+	};
+}
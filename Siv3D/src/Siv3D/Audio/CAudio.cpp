@@ -18,6 +18,8 @@
 # include <Siv3D/AudioDecoder.hpp>
 # include <Siv3D/KlattTTSParameters.hpp>
 # include <Siv3D/DLL.hpp>
+# include <Siv3D/AudioDecoder/IAudioDecoder.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
 # include "CAudio.hpp"
 
 namespace s3d
@@ -61,6 +63,8 @@ namespace s3d
 			m_soloud.reset();
 		}
 
+		m_streamWorker.shutdown();
+
 	# if SIV3D_PLATFORM(WINDOWS) || SIV3D_PLATFORM(MACOS)
 
 		DLL::Unload(m_soundTouch);
@@ -233,54 +237,12 @@ namespace s3d
 
 	Audio::IDType CAudio::createStreamingNonLoop(const FilePathView path)
 	{
-		// ストリーミングに対応しない形式の場合のフォールバック
-		if (const AudioFormat format = AudioDecoder::GetAudioFormat(path);
-			(format != AudioFormat::WAVE)
-			&& (format != AudioFormat::MP3)
-			&& (format != AudioFormat::OggVorbis)
-			&& (format != AudioFormat::FLAC))
-		{
-			return create(Wave{ path }, none);
-		}
-
-		// Audio を作成
-		auto audio = std::make_unique<AudioData>(m_soloud.get(), path);
-
-		if (not audio->isInitialized()) // もし作成に失敗していたら
-		{
-			return Audio::IDType::NullAsset();
-		}
-
-		const String info = detail::ToInfo(audio);
-
-		// Audio を管理に登録
-		return m_audios.add(std::move(audio), info);
+		return createStreaming(path, none);
 	}
 
 	Audio::IDType CAudio::createStreamingLoop(const FilePathView path, const uint64 loopBegin)
 	{
-		// ストリーミングに対応しない形式の場合のフォールバック
-		if (const AudioFormat format = AudioDecoder::GetAudioFormat(path);
-			(format != AudioFormat::WAVE)
-			&& (format != AudioFormat::MP3)
-			&& (format != AudioFormat::OggVorbis)
-			&& (format != AudioFormat::FLAC))
-		{
-			return create(Wave{ path }, AudioLoopTiming{ loopBegin, 0 });
-		}
-
-		// Audio を作成
-		auto audio = std::make_unique<AudioData>(m_soloud.get(), path, loopBegin);
-
-		if (not audio->isInitialized()) // もし作成に失敗していたら
-		{
-			return Audio::IDType::NullAsset();
-		}
-
-		const String info = detail::ToInfo(audio);
-
-		// Audio を管理に登録
-		return m_audios.add(std::move(audio), info);
+		return createStreaming(path, loopBegin);
 	}
 
 	Audio::IDType CAudio::createDynamic(const std::shared_ptr<IAudioStream>& pAudioStream, const Arg::sampleRate_<uint32> sampleRate)
@@ -759,4 +721,52 @@ namespace s3d
 
 		m_speech->stop();
 	}
+
+	Audio::IDType CAudio::createStreaming(const FilePathView path, const Optional<uint64>& loopBegin)
+	{
+		const AudioFormat format = AudioDecoder::GetAudioFormat(path);
+		std::unique_ptr<AudioData> audio;
+
+		if (auto decoder = SIV3D_ENGINE(AudioDecoder)->createStreamDecoder(path, format))
+		{
+			// デコーダがストリーミングに対応する形式は、共有のスレッドで先読みしながら再生する
+			audio = std::make_unique<AudioData>(m_soloud.get(), &m_streamWorker, path, format, std::move(decoder), loopBegin);
+		}
+		else if ((format == AudioFormat::WAVE)
+			|| (format == AudioFormat::MP3)
+			|| (format == AudioFormat::OggVorbis)
+			|| (format == AudioFormat::FLAC))
+		{
+			// WAVE と、ストリーム用のデコーダを作成できなかった形式は SoLoud の WavStream で再生する
+			if (loopBegin)
+			{
+				audio = std::make_unique<AudioData>(m_soloud.get(), path, *loopBegin);
+			}
+			else
+			{
+				audio = std::make_unique<AudioData>(m_soloud.get(), path);
+			}
+		}
+		else // ストリーミングに対応しない形式の場合のフォールバック
+		{
+			if (loopBegin)
+			{
+				return create(Wave{ path }, AudioLoopTiming{ *loopBegin, 0 });
+			}
+			else
+			{
+				return create(Wave{ path }, none);
+			}
+		}
+
+		if (not audio->isInitialized()) // もし作成に失敗していたら
+		{
+			return Audio::IDType::NullAsset();
+		}
+
+		const String info = detail::ToInfo(audio);
+
+		// Audio を管理に登録
+		return m_audios.add(std::move(audio), info);
+	}
 }
@@ -14,6 +14,7 @@
 # include "IAudio.hpp"
 # include "AudioData.hpp"
 # include "AudioBus.hpp"
+# include "AudioStreamWorker.hpp"
 # include "SoundTouchFunctions.hpp"
 # include <Siv3D/DLL.hpp>
 
@@ -197,5 +198,11 @@ namespace s3d
 		SoundTouchFunctions m_soundTouchFunctions;
 
 		std::unique_ptr<AudioData> m_speech;
+
+		/// @brief ストリーミング再生のデコードを行うスレッド
+		AudioStreamWorker m_streamWorker;
+
+		[[nodiscard]]
+		Audio::IDType createStreaming(FilePathView path, const Optional<uint64>& loopBegin);
 	};
 }
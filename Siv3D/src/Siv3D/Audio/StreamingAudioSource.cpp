@@ -0,0 +1,155 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AudioDecoder/IAudioDecoder.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+# include "StreamingAudioSource.hpp"
+
+namespace s3d
+{
+	class StreamingAudioInstance : public SoLoud::AudioSourceInstance
+	{
+	public:
+
+		StreamingAudioInstance(StreamingAudioSource* aParent, std::unique_ptr<IAudioStreamDecoder>&& decoder)
+			: mParent{ aParent }
+		{
+			mChannels = 2;
+
+			if (decoder)
+			{
+				m_stream = std::make_shared<AudioFileStream>(std::move(decoder), mParent->m_loop);
+
+				// 再生がすぐに始まるよう、最初のバッファはこのスレッドで埋める
+				m_stream->fill();
+
+				mParent->m_pWorker->add(m_stream);
+			}
+		}
+
+		~StreamingAudioInstance() override
+		{
+			if (m_stream)
+			{
+				mParent->m_pWorker->remove(m_stream.get());
+			}
+		}
+
+		unsigned int getAudio(float* aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize) override
+		{
+			if (not m_stream)
+			{
+				return 0;
+			}
+
+			uint32 loopCount = 0;
+			const size_t samplesRead = m_stream->read(aBuffer, (aBuffer + aBufferSize), aSamplesToRead, loopCount);
+
+			// ループはデコードするスレッドで処理済みなので、再生位置とループ回数だけを更新する
+			if (loopCount)
+			{
+				mLoopCount += loopCount;
+				mStreamPosition = (static_cast<double>(mParent->m_loop->beginSample.load(std::memory_order_relaxed)) / m_stream->sampleRate());
+			}
+
+			// 終端に達していない場合は、デコードが間に合わなくても無音で埋めて再生を続ける
+			if ((samplesRead < aSamplesToRead) && (not m_stream->hasEnded()))
+			{
+				m_stream->getAudio((aBuffer + samplesRead), (aBuffer + aBufferSize + samplesRead), (aSamplesToRead - samplesRead));
+
+				return aSamplesToRead;
+			}
+
+			return static_cast<unsigned int>(samplesRead);
+		}
+
+		bool hasEnded() override
+		{
+			return ((not m_stream) || m_stream->hasEnded());
+		}
+
+		SoLoud::result seek(SoLoud::time aSeconds, float*, unsigned int) override
+		{
+			if (not m_stream)
+			{
+				return SoLoud::NOT_IMPLEMENTED;
+			}
+
+			// ミキサーのロック中に呼ばれるため、デコードはワーカーのスレッドに任せる
+			m_stream->seek(static_cast<uint64>(aSeconds * m_stream->sampleRate()));
+			mParent->m_pWorker->wake();
+			mStreamPosition = aSeconds;
+
+			return SoLoud::SO_NO_ERROR;
+		}
+
+		SoLoud::result rewind() override
+		{
+			if (not m_stream)
+			{
+				return SoLoud::NOT_IMPLEMENTED;
+			}
+
+			m_stream->rewind();
+			mParent->m_pWorker->wake();
+			mStreamPosition = 0.0;
+
+			return SoLoud::SO_NO_ERROR;
+		}
+
+	private:
+
+		StreamingAudioSource* mParent;
+
+		std::shared_ptr<AudioFileStream> m_stream;
+	};
+
+	StreamingAudioSource::StreamingAudioSource(AudioStreamWorker* pWorker, const FilePathView path, const AudioFormat audioFormat, std::unique_ptr<IAudioStreamDecoder>&& decoder)
+		: m_pWorker{ pWorker }
+		, m_path{ path }
+		, m_audioFormat{ audioFormat }
+		, m_firstDecoder{ std::move(decoder) }
+	{
+		mChannels = 2;
+		mBaseSamplerate = static_cast<float>(m_firstDecoder->sampleRate());
+	}
+
+	StreamingAudioSource::~StreamingAudioSource()
+	{
+		stop();
+	}
+
+	SoLoud::AudioSourceInstance* StreamingAudioSource::createInstance()
+	{
+		std::unique_ptr<IAudioStreamDecoder> decoder = std::move(m_firstDecoder);
+
+		if (not decoder)
+		{
+			decoder = SIV3D_ENGINE(AudioDecoder)->createStreamDecoder(m_path, m_audioFormat);
+		}
+
+		if (not decoder)
+		{
+			LOG_FAIL(U"StreamingAudioSource::createInstance(): Failed to open `{}`"_fmt(m_path));
+		}
+
+		return new StreamingAudioInstance(this, std::move(decoder));
+	}
+
+	void StreamingAudioSource::setStreamLoop(const bool loop, const uint64 loopBeginSample)
+	{
+		m_loop->beginSample.store(loopBeginSample, std::memory_order_relaxed);
+		m_loop->enabled.store(loop, std::memory_order_relaxed);
+		setLooping(loop);
+		setLoopPoint(static_cast<double>(loopBeginSample) / mBaseSamplerate);
+	}
+}
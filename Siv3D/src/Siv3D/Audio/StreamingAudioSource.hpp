@@ -0,0 +1,47 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/AudioFormat.hpp>
+# include <Siv3D/IAudioStreamDecoder.hpp>
+# include "AudioStreamWorker.hpp"
+# include <ThirdParty/soloud/include/soloud.h>
+
+namespace s3d
+{
+	/// @brief 音声ファイルを少しずつデコードしながら再生する AudioSource
+	/// @remark 再生ごとにデコーダを作成し、AudioStreamWorker のスレッドがバッファを先読みします。
+	class StreamingAudioSource : public SoLoud::AudioSource
+	{
+	public:
+
+		StreamingAudioSource(AudioStreamWorker* pWorker, FilePathView path, AudioFormat audioFormat, std::unique_ptr<IAudioStreamDecoder>&& decoder);
+
+		virtual ~StreamingAudioSource();
+
+		virtual SoLoud::AudioSourceInstance* createInstance();
+
+		void setStreamLoop(bool loop, uint64 loopBeginSample);
+
+		AudioStreamWorker* m_pWorker = nullptr;
+
+		FilePath m_path;
+
+		AudioFormat m_audioFormat = AudioFormat::Unknown;
+
+		/// @brief 最初の再生で使うデコーダ（長さの取得のために作成済みのもの）
+		std::unique_ptr<IAudioStreamDecoder> m_firstDecoder;
+
+		std::shared_ptr<AudioStreamLoop> m_loop = std::make_shared<AudioStreamLoop>();
+	};
+}
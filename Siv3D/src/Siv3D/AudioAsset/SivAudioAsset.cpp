@@ -240,9 +240,14 @@ namespace s3d
 		return SIV3D_ENGINE(Asset)->load(AssetType::Audio, name, {});
 	}
 
-	void AudioAsset::LoadAsync(const AssetNameView name)
+	void AudioAsset::LoadAsync(const AssetNameView name, const int32 priority)
 	{
-		SIV3D_ENGINE(Asset)->loadAsync(AssetType::Audio, name, {});
+		SIV3D_ENGINE(Asset)->loadAsync(AssetType::Audio, name, {}, priority);
+	}
+
+	void AudioAsset::LoadAsyncByTag(const AssetTag& tag, const int32 priority)
+	{
+		SIV3D_ENGINE(Asset)->loadAsyncByTag(AssetType::Audio, tag, {}, priority);
 	}
 
 	void AudioAsset::Wait(const AssetNameView name)
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/AudioAssetData.hpp>
+# include <Siv3D/Asset/AssetReload.hpp>
 
 namespace s3d
 {
@@ -42,39 +43,12 @@ namespace s3d
 
 	bool AudioAssetData::load(const String& hint)
 	{
-		if (isUninitialized())
-		{
-			if (onLoad(*this, hint))
-			{
-				setState(AssetState::Loaded);
-				return true;
-			}
-			else
-			{
-				setState(AssetState::Failed);
-				return false;
-			}
-		}
-
-		if (isAsyncLoading())
-		{
-			wait();
-		}
-
-		return isLoaded();
+		return loadImpl(m_task, [this, &hint]() { return onLoad(*this, hint); });
 	}
 
 	void AudioAssetData::loadAsync(const String& hint)
 	{
-		if (isUninitialized())
-		{
-			setState(AssetState::AsyncLoading);
-
-			m_task = Async([this, hint = hint]()
-				{
-					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
-				});
-		}
+		loadAsyncImpl(m_task, [this, hint = hint]() { return onLoad(*this, hint); });
 	}
 
 	void AudioAssetData::wait()
@@ -87,19 +61,33 @@ namespace s3d
 
 	void AudioAssetData::release()
 	{
-		if (isUninitialized())
-		{
-			return;
-		}
+		releaseImpl(m_task, [this]() { onRelease(*this); });
+	}
 
-		if (isAsyncLoading())
+	Array<FilePath> AudioAssetData::getSourcePaths() const
+	{
+		if (not path)
 		{
-			wait();
+			return{};
 		}
 
-		onRelease(*this);
+		return{ path };
+	}
 
-		setState(AssetState::Uninitialized);
+	std::function<void()> AudioAssetData::prepareReload(const String& hint)
+	{
+		auto staging = std::make_shared<AudioAssetData>();
+		staging->path = path;
+		staging->loopTiming = loopTiming;
+		staging->streaming = streaming;
+		staging->instrument = instrument;
+		staging->key = key;
+		staging->noteOn = noteOn;
+		staging->noteOff = noteOff;
+		staging->velocity = velocity;
+		staging->sampleRate = sampleRate;
+
+		return detail::PrepareReload(*this, std::move(staging), &AudioAssetData::audio, hint);
 	}
 
 	bool AudioAssetData::DefaultLoad(AudioAssetData& asset, const String&)
@@ -11,6 +11,7 @@
 
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/IReader.hpp>
+# include <Siv3D/BinaryReader.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include "CAudioDecoder.hpp"
 # include <Siv3D/AudioFormat/WAVEDecoder.hpp>
@@ -124,6 +125,34 @@ namespace s3d
 		return (*it)->decode(reader, {});
 	}
 
+	std::unique_ptr<IAudioStreamDecoder> CAudioDecoder::createStreamDecoder(const FilePathView path, const AudioFormat audioFormat)
+	{
+		LOG_SCOPED_TRACE(U"CAudioDecoder::createStreamDecoder()");
+
+		auto reader = std::make_unique<BinaryReader>(path);
+
+		if (not reader->isOpen())
+		{
+			return nullptr;
+		}
+
+		auto it = findDecoder(audioFormat);
+
+		if (it == m_decoders.end())
+		{
+			it = findDecoder(*reader, path);
+
+			if (it == m_decoders.end())
+			{
+				return nullptr;
+			}
+		}
+
+		LOG_TRACE(U"Audio decoder name: {}"_fmt((*it)->name()));
+
+		return (*it)->createStreamDecoder(std::move(reader));
+	}
+
 	bool CAudioDecoder::add(std::unique_ptr<IAudioDecoder>&& decoder)
 	{
 		const StringView name = decoder->name();
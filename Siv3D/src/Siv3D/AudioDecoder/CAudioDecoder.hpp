@@ -33,6 +33,8 @@ namespace s3d
 
 		Wave decode(IReader& reader, StringView decoderName) override;
 
+		std::unique_ptr<IAudioStreamDecoder> createStreamDecoder(FilePathView path, AudioFormat audioFormat) override;
+
 		bool add(std::unique_ptr<IAudioDecoder>&& decoder) override;
 
 		void remove(StringView name) override;
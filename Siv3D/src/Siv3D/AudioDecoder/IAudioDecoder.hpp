@@ -38,6 +38,8 @@ namespace s3d
 
 		virtual Wave decode(IReader& reader, StringView decoderName) = 0;
 
+		virtual std::unique_ptr<IAudioStreamDecoder> createStreamDecoder(FilePathView path, AudioFormat audioFormat) = 0;
+
 		virtual bool add(std::unique_ptr<IAudioDecoder>&& decoder) = 0;
 
 		virtual void remove(StringView name) = 0;
@@ -74,6 +74,11 @@ namespace s3d
 			return SIV3D_ENGINE(AudioDecoder)->decode(reader, decoderName);
 		}
 
+		std::unique_ptr<IAudioStreamDecoder> CreateStreamDecoder(const FilePathView path, const AudioFormat audioFormat)
+		{
+			return SIV3D_ENGINE(AudioDecoder)->createStreamDecoder(path, audioFormat);
+		}
+
 		bool Add(std::unique_ptr<IAudioDecoder>&& decoder)
 		{
 			return SIV3D_ENGINE(AudioDecoder)->add(std::move(decoder));
@@ -0,0 +1,44 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/IReader.hpp>
+# include <Siv3D/IAudioStreamDecoder.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 各 AudioDecoder の createStreamDecoder() の共通の処理です。
+		/// @tparam StreamDecoder `IReader` を受け取るコンストラクタと `isValid()` を持つストリームデコーダ
+		/// @param reader 音声データのリーダー
+		/// @return 作成したストリームデコーダ。開けなかった場合は nullptr
+		template <class StreamDecoder>
+		[[nodiscard]]
+		std::unique_ptr<IAudioStreamDecoder> CreateStreamDecoder(std::unique_ptr<IReader>&& reader)
+		{
+			if ((not reader) || (not reader->isOpen()))
+			{
+				return nullptr;
+			}
+
+			auto decoder = std::make_unique<StreamDecoder>(std::move(reader));
+
+			if (not decoder->isValid())
+			{
+				return nullptr;
+			}
+
+			return decoder;
+		}
+	}
+}
@@ -0,0 +1,101 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "FLACStreamDecoder.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static size_t ReadFLAC_Callback(void* pUserData, void* pBufferOut, const size_t bytesToRead)
+		{
+			IReader* reader = static_cast<IReader*>(pUserData);
+
+			return static_cast<size_t>(reader->read(pBufferOut, static_cast<int64>(bytesToRead)));
+		}
+
+		static ::drflac_bool32 SeekFLAC_Callback(void* pUserData, const int offset, const ::drflac_seek_origin origin)
+		{
+			IReader* reader = static_cast<IReader*>(pUserData);
+
+			const int64 pos = (((origin == ::drflac_seek_origin_current) ? reader->getPos() : 0) + offset);
+
+			// dr_flac は終端より後ろへのシークを失敗として扱う必要がある
+			if (reader->size() < pos)
+			{
+				return false;
+			}
+
+			return reader->setPos(pos);
+		}
+	}
+
+	FLACStreamDecoder::FLACStreamDecoder(std::unique_ptr<IReader>&& reader)
+		: m_reader{ std::move(reader) }
+	{
+		m_flac = ::drflac_open(detail::ReadFLAC_Callback, detail::SeekFLAC_Callback, m_reader.get(), nullptr);
+	}
+
+	FLACStreamDecoder::~FLACStreamDecoder()
+	{
+		if (m_flac)
+		{
+			::drflac_close(m_flac);
+		}
+	}
+
+	bool FLACStreamDecoder::isValid() const noexcept
+	{
+		return (m_flac
+			&& ((m_flac->channels == 1) || (m_flac->channels == 2)));
+	}
+
+	uint32 FLACStreamDecoder::sampleRate() const
+	{
+		return m_flac->sampleRate;
+	}
+
+	uint64 FLACStreamDecoder::lengthSample() const
+	{
+		return m_flac->totalPCMFrameCount;
+	}
+
+	size_t FLACStreamDecoder::read(WaveSample* dst, const size_t samples)
+	{
+		const size_t channels = m_flac->channels;
+		const size_t samplesToRead = Min(samples, (m_buffer.size() / channels));
+		const size_t samplesRead = static_cast<size_t>(::drflac_read_pcm_frames_f32(m_flac, samplesToRead, m_buffer.data()));
+		const float* pSrc = m_buffer.data();
+
+		if (channels == 1)
+		{
+			for (size_t i = 0; i < samplesRead; ++i)
+			{
+				*dst++ = WaveSample{ *pSrc++ };
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < samplesRead; ++i)
+			{
+				*dst++ = WaveSample{ pSrc[0], pSrc[1] };
+				pSrc += 2;
+			}
+		}
+
+		return samplesRead;
+	}
+
+	bool FLACStreamDecoder::seek(const uint64 samplePos)
+	{
+		return ::drflac_seek_to_pcm_frame(m_flac, samplePos);
+	}
+}
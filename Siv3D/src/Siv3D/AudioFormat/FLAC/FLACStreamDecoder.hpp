@@ -0,0 +1,53 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/IReader.hpp>
+# include <Siv3D/IAudioStreamDecoder.hpp>
+# include <ThirdParty/soloud/src/audiosource/wav/dr_flac.h>
+
+namespace s3d
+{
+	/// @brief SoLoud に含まれる dr_flac で、FLAC 形式の音声データを少しずつデコードするストリーム
+	/// @remark 各プラットフォームの FLACDecoder の createStreamDecoder() から使われます。
+	class FLACStreamDecoder final : public IAudioStreamDecoder
+	{
+	public:
+
+		explicit FLACStreamDecoder(std::unique_ptr<IReader>&& reader);
+
+		~FLACStreamDecoder() override;
+
+		[[nodiscard]]
+		bool isValid() const noexcept;
+
+		[[nodiscard]]
+		uint32 sampleRate() const override;
+
+		[[nodiscard]]
+		uint64 lengthSample() const override;
+
+		[[nodiscard]]
+		size_t read(WaveSample* dst, size_t samples) override;
+
+		bool seek(uint64 samplePos) override;
+
+	private:
+
+		std::unique_ptr<IReader> m_reader;
+
+		::drflac* m_flac = nullptr;
+
+		std::array<float, 4096> m_buffer;
+	};
+}
@@ -0,0 +1,109 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "MP3StreamDecoder.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static size_t ReadMP3_Callback(void* pUserData, void* pBufferOut, const size_t bytesToRead)
+		{
+			IReader* reader = static_cast<IReader*>(pUserData);
+
+			return static_cast<size_t>(reader->read(pBufferOut, static_cast<int64>(bytesToRead)));
+		}
+
+		static ::drmp3_bool32 SeekMP3_Callback(void* pUserData, const int offset, const ::drmp3_seek_origin origin)
+		{
+			IReader* reader = static_cast<IReader*>(pUserData);
+
+			const int64 base = ((origin == ::drmp3_seek_origin_current) ? reader->getPos() : 0);
+
+			return reader->setPos(base + offset);
+		}
+	}
+
+	MP3StreamDecoder::MP3StreamDecoder(std::unique_ptr<IReader>&& reader)
+		: m_reader{ std::move(reader) }
+	{
+		if (not ::drmp3_init(&m_mp3, detail::ReadMP3_Callback, detail::SeekMP3_Callback, m_reader.get(), nullptr))
+		{
+			return;
+		}
+
+		m_opened = true;
+
+		if ((m_mp3.channels != 1) && (m_mp3.channels != 2))
+		{
+			return;
+		}
+
+		// ファイル全体を 1 度走査して長さを求める
+		m_lengthSample = ::drmp3_get_pcm_frame_count(&m_mp3);
+	}
+
+	MP3StreamDecoder::~MP3StreamDecoder()
+	{
+		if (m_opened)
+		{
+			::drmp3_uninit(&m_mp3);
+		}
+	}
+
+	bool MP3StreamDecoder::isValid() const noexcept
+	{
+		return (m_opened
+			&& ((m_mp3.channels == 1) || (m_mp3.channels == 2)));
+	}
+
+	uint32 MP3StreamDecoder::sampleRate() const
+	{
+		return m_mp3.sampleRate;
+	}
+
+	uint64 MP3StreamDecoder::lengthSample() const
+	{
+		return m_lengthSample;
+	}
+
+	size_t MP3StreamDecoder::read(WaveSample* dst, const size_t samples)
+	{
+		const size_t channels = m_mp3.channels;
+		const size_t samplesToRead = Min(samples, (m_buffer.size() / channels));
+		const size_t samplesRead = static_cast<size_t>(::drmp3_read_pcm_frames_f32(&m_mp3, samplesToRead, m_buffer.data()));
+		const float* pSrc = m_buffer.data();
+
+		if (channels == 1)
+		{
+			for (size_t i = 0; i < samplesRead; ++i)
+			{
+				*dst++ = WaveSample{ *pSrc++ };
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < samplesRead; ++i)
+			{
+				*dst++ = WaveSample{ pSrc[0], pSrc[1] };
+				pSrc += 2;
+			}
+		}
+
+		return samplesRead;
+	}
+
+	bool MP3StreamDecoder::seek(const uint64 samplePos)
+	{
+		// dr_mp3 のシークテーブルはサンプル単位で正確ではないため使わない（後方へのシークは先頭からデコードし直す）
+		return ::drmp3_seek_to_pcm_frame(&m_mp3, samplePos);
+	}
+}
@@ -0,0 +1,57 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/IReader.hpp>
+# include <Siv3D/IAudioStreamDecoder.hpp>
+# include <ThirdParty/soloud/src/audiosource/wav/dr_mp3.h>
+
+namespace s3d
+{
+	/// @brief SoLoud に含まれる dr_mp3 で、MP3 形式の音声データを少しずつデコードするストリーム
+	/// @remark 各プラットフォームの MP3Decoder の createStreamDecoder() から使われます。
+	class MP3StreamDecoder final : public IAudioStreamDecoder
+	{
+	public:
+
+		explicit MP3StreamDecoder(std::unique_ptr<IReader>&& reader);
+
+		~MP3StreamDecoder() override;
+
+		[[nodiscard]]
+		bool isValid() const noexcept;
+
+		[[nodiscard]]
+		uint32 sampleRate() const override;
+
+		[[nodiscard]]
+		uint64 lengthSample() const override;
+
+		[[nodiscard]]
+		size_t read(WaveSample* dst, size_t samples) override;
+
+		bool seek(uint64 samplePos) override;
+
+	private:
+
+		std::unique_ptr<IReader> m_reader;
+
+		::drmp3 m_mp3{};
+
+		std::array<float, 4096> m_buffer;
+
+		uint64 m_lengthSample = 0;
+
+		bool m_opened = false;
+	};
+}
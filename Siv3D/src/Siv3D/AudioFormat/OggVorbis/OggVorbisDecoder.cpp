@@ -13,6 +13,7 @@
 # include <Siv3D/Optional.hpp>
 # include <Siv3D/Parse.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AudioFormat/AudioStreamDecoderCommon.hpp>
 
 # if SIV3D_PLATFORM(WINDOWS) | SIV3D_PLATFORM(MACOS) | SIV3D_PLATFORM(WEB)
 #	include <ThirdParty-prebuilt/vorbis/vorbisenc.h>
@@ -89,6 +90,122 @@ namespace s3d
 
 			return static_cast<long>(reader->getPos());
 		}
+
+		class OggVorbisStreamDecoder final : public IAudioStreamDecoder
+		{
+		public:
+
+			explicit OggVorbisStreamDecoder(std::unique_ptr<IReader>&& reader)
+				: m_reader{ std::move(reader) }
+			{
+				ov_callbacks callbacks;
+				callbacks.read_func = ReadOgg_Callback;
+				callbacks.seek_func = SeekOgg_Callback;
+				callbacks.close_func = CloseOgg_Callback;
+				callbacks.tell_func = TellOgg_Callback;
+
+				if (::ov_open_callbacks(m_reader.get(), &m_vf, nullptr, -1, callbacks) != 0)
+				{
+					return;
+				}
+
+				m_opened = true;
+
+				const vorbis_info* vi = ::ov_info(&m_vf, -1);
+
+				if ((not vi)
+					|| ((vi->channels != 1) && (vi->channels != 2)))
+				{
+					return;
+				}
+
+				m_channels = vi->channels;
+				m_sampleRate = (vi->rate ? static_cast<uint32>(vi->rate) : Wave::DefaultSampleRate);
+				m_lengthSample = static_cast<uint64>(Max<ogg_int64_t>(::ov_pcm_total(&m_vf, -1), 0));
+			}
+
+			~OggVorbisStreamDecoder() override
+			{
+				if (m_opened)
+				{
+					::ov_clear(&m_vf);
+				}
+			}
+
+			[[nodiscard]]
+			bool isValid() const noexcept
+			{
+				return (m_channels != 0);
+			}
+
+			uint32 sampleRate() const override
+			{
+				return m_sampleRate;
+			}
+
+			uint64 lengthSample() const override
+			{
+				return m_lengthSample;
+			}
+
+			size_t read(WaveSample* dst, const size_t samples) override
+			{
+				const size_t bytesPerSample = (m_channels * sizeof(int16));
+				const int32 bytesToRead = static_cast<int32>(Min(m_buffer.size(), (samples * bytesPerSample)));
+				int current_sec = 0;
+
+				// 1 回の ov_read() は最大 1 パケット分しか返さないため、呼び出し側は繰り返し呼ぶ
+				const long bytes_read = ::ov_read(&m_vf, m_buffer.data(), bytesToRead, 0, 2, 1, &current_sec);
+
+				if (bytes_read <= 0)
+				{
+					return 0;
+				}
+
+				const size_t samples_read = (static_cast<size_t>(bytes_read) / bytesPerSample);
+				const int16* pSrc = static_cast<const int16*>(static_cast<const void*>(m_buffer.data()));
+
+				if (m_channels == 1)
+				{
+					for (size_t i = 0; i < samples_read; ++i)
+					{
+						*dst++ = WaveSampleS16(*pSrc++).asWaveSample();
+					}
+				}
+				else
+				{
+					for (size_t i = 0; i < samples_read; ++i)
+					{
+						const int16 left = *pSrc++;
+						const int16 right = *pSrc++;
+						*dst++ = WaveSample::FromInt16(left, right);
+					}
+				}
+
+				return samples_read;
+			}
+
+			bool seek(const uint64 samplePos) override
+			{
+				return (::ov_pcm_seek(&m_vf, static_cast<ogg_int64_t>(samplePos)) == 0);
+			}
+
+		private:
+
+			std::unique_ptr<IReader> m_reader;
+
+			OggVorbis_File m_vf{};
+
+			std::array<char, 4096> m_buffer;
+
+			uint64 m_lengthSample = 0;
+
+			uint32 m_sampleRate = 0;
+
+			int32 m_channels = 0;
+
+			bool m_opened = false;
+		};
 	}
 
 	StringView OggVorbisDecoder::name() const
@@ -241,6 +358,11 @@ namespace s3d
 		return wave;
 	}
 
+	std::unique_ptr<IAudioStreamDecoder> OggVorbisDecoder::createStreamDecoder(std::unique_ptr<IReader>&& reader) const
+	{
+		return detail::CreateStreamDecoder<detail::OggVorbisStreamDecoder>(std::move(reader));
+	}
+
 	AudioLoopTiming OggVorbisDecoder::getLoopInfo(const FilePathView path) const
 	{
 		BinaryReader reader{ path };
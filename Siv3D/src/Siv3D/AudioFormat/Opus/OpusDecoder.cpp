@@ -11,6 +11,7 @@
 
 # include <Siv3D/AudioFormat/OpusDecoder.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AudioFormat/AudioStreamDecoderCommon.hpp>
 
 # if SIV3D_PLATFORM(WINDOWS) | SIV3D_PLATFORM(MACOS) | SIV3D_PLATFORM(WEB)
 #	include <ThirdParty-prebuilt/ogg/ogg.h>
@@ -26,6 +27,120 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		static int ReadOpus_Callback(void* stream, unsigned char* ptr, const int nbytes)
+		{
+			IReader* reader = static_cast<IReader*>(stream);
+
+			return static_cast<int>(reader->read(ptr, nbytes));
+		}
+
+		static int SeekOpus_Callback(void* stream, const opus_int64 offset, const int whence)
+		{
+			IReader* reader = static_cast<IReader*>(stream);
+			int64 pos = 0;
+
+			switch (whence)
+			{
+			case SEEK_CUR:
+				pos = (reader->getPos() + offset);
+				break;
+			case SEEK_END:
+				pos = (reader->size() + offset);
+				break;
+			case SEEK_SET:
+				pos = offset;
+				break;
+			default:
+				return -1;
+			}
+
+			if ((pos < 0) || (reader->size() < pos))
+			{
+				return -1;
+			}
+
+			return (reader->setPos(pos) ? 0 : -1);
+		}
+
+		static opus_int64 TellOpus_Callback(void* stream)
+		{
+			IReader* reader = static_cast<IReader*>(stream);
+
+			return reader->getPos();
+		}
+
+		class OpusStreamDecoder final : public IAudioStreamDecoder
+		{
+		public:
+
+			/// @brief opusfile は常に 48 kHz でデコードする
+			static constexpr uint32 OutputSampleRate = 48000;
+
+			explicit OpusStreamDecoder(std::unique_ptr<IReader>&& reader)
+				: m_reader{ std::move(reader) }
+			{
+				const OpusFileCallbacks callbacks{ ReadOpus_Callback, SeekOpus_Callback, TellOpus_Callback, nullptr };
+
+				int err;
+				m_of = ::op_open_callbacks(m_reader.get(), &callbacks, nullptr, 0, &err);
+
+				if (not m_of)
+				{
+					return;
+				}
+
+				m_lengthSample = static_cast<uint64>(Max<ogg_int64_t>(::op_pcm_total(m_of, -1), 0));
+			}
+
+			~OpusStreamDecoder() override
+			{
+				if (m_of)
+				{
+					::op_free(m_of);
+				}
+			}
+
+			[[nodiscard]]
+			bool isValid() const noexcept
+			{
+				return (m_of != nullptr);
+			}
+
+			uint32 sampleRate() const override
+			{
+				return OutputSampleRate;
+			}
+
+			uint64 lengthSample() const override
+			{
+				return m_lengthSample;
+			}
+
+			size_t read(WaveSample* dst, const size_t samples) override
+			{
+				// モノラルや 3 チャンネル以上の音声も、ステレオに変換して出力される
+				const int32 result = ::op_read_float_stereo(m_of, &dst->left, static_cast<int32>(Min<size_t>((samples * 2), INT32_MAX)));
+
+				return ((0 < result) ? static_cast<size_t>(result) : 0);
+			}
+
+			bool seek(const uint64 samplePos) override
+			{
+				return (::op_pcm_seek(m_of, static_cast<ogg_int64_t>(samplePos)) == 0);
+			}
+
+		private:
+
+			std::unique_ptr<IReader> m_reader;
+
+			OggOpusFile* m_of = nullptr;
+
+			uint64 m_lengthSample = 0;
+		};
+	}
+
 	StringView OpusDecoder::name() const
 	{
 		return U"Opus"_sv;
@@ -149,4 +264,9 @@ namespace s3d
 
 		return wave;
 	}
+
+	std::unique_ptr<IAudioStreamDecoder> OpusDecoder::createStreamDecoder(std::unique_ptr<IReader>&& reader) const
+	{
+		return detail::CreateStreamDecoder<detail::OpusStreamDecoder>(std::move(reader));
+	}
 }
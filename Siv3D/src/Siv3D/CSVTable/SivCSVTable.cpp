@@ -0,0 +1,707 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <charconv>
+# include <ThirdParty/fast_float/fast_float.h>
+# include <Siv3D/CSVTable.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/Char.hpp>
+# include <Siv3D/Utility.hpp>
+# include <Siv3D/Threading.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief この大きさ未満のファイルは分割せずに解析する
+		constexpr size_t CSVParallelParseThreshold = (1 << 20);
+
+		/// @brief 並列解析時の 1 チャンクあたりの最小バイト数
+		constexpr size_t CSVMinChunkSize = (256 << 10);
+
+		/// @brief 列の値を並列に変換する際の 1 タスクあたりの行数
+		constexpr size_t CSVParseGrainSize = 4096;
+
+		constexpr size_t CSVNoRecord = static_cast<size_t>(-1);
+
+		/// @brief セルが存在する
+		constexpr uint32 CSVCellPresent = (1u << 0);
+
+		/// @brief クオートやエスケープを含み、文字列にする際に変換が必要
+		constexpr uint32 CSVCellNeedsDecode = (1u << 1);
+
+		struct CSVSyntax
+		{
+			char separator;
+
+			char quote;
+
+			char escape;
+
+			[[nodiscard]]
+			constexpr bool hasEscape() const noexcept
+			{
+				// エスケープ記号とクオーテーション記号が同じ場合 ("" 形式)、クオートの開閉だけで状態を追跡できる
+				return (escape != quote);
+			}
+		};
+
+		struct CSVChunkScan
+		{
+			/// @brief チャンク先頭でクオート外 [0] / クオート内 [1] だった場合の、チャンク末尾の状態
+			bool endInQuote[2] = { false, true };
+
+			/// @brief チャンク先頭でクオート外 [0] / クオート内 [1] だった場合の、最初のレコードの開始位置
+			size_t firstRecord[2] = { CSVNoRecord, CSVNoRecord };
+		};
+
+		struct CSVChunkResult
+		{
+			Array<uint64> cellOffsets;
+
+			Array<uint32> cellLengths;
+
+			Array<uint32> cellFlags;
+
+			Array<uint32> rowColumns;
+		};
+
+		/// @brief 直前のエスケープ記号にエスケープされていない位置まで pos を進めます。
+		[[nodiscard]]
+		static size_t AlignToUnescaped(const char* data, const size_t first, size_t pos, const size_t last, const CSVSyntax& syntax) noexcept
+		{
+			if (not syntax.hasEscape())
+			{
+				return pos;
+			}
+
+			while (pos < last)
+			{
+				size_t run = 0;
+
+				while (((first + run) < pos) && (data[pos - run - 1] == syntax.escape))
+				{
+					++run;
+				}
+
+				if ((run % 2) == 0)
+				{
+					break;
+				}
+
+				++pos;
+			}
+
+			return pos;
+		}
+
+		/// @brief チャンク先頭の状態がクオート外・クオート内のそれぞれの場合について、チャンクを走査します。
+		[[nodiscard]]
+		static CSVChunkScan ScanChunk(const char* data, const size_t first, const size_t last, const CSVSyntax& syntax) noexcept
+		{
+			CSVChunkScan result;
+
+			for (int32 hypothesis = 0; hypothesis < 2; ++hypothesis)
+			{
+				bool inQuote = (hypothesis == 1);
+
+				for (size_t i = first; i < last; ++i)
+				{
+					const char ch = data[i];
+
+					if (syntax.hasEscape() && (ch == syntax.escape))
+					{
+						++i;
+					}
+					else if (ch == syntax.quote)
+					{
+						inQuote = (not inQuote);
+					}
+					else if ((ch == '\n') && (not inQuote) && (result.firstRecord[hypothesis] == CSVNoRecord))
+					{
+						result.firstRecord[hypothesis] = (i + 1);
+					}
+				}
+
+				result.endInQuote[hypothesis] = inQuote;
+			}
+
+			return result;
+		}
+
+		/// @brief レコードの先頭から始まる [first, last) の範囲を解析します。
+		static void ParseRecords(const char* data, const size_t first, const size_t last, const CSVSyntax& syntax, CSVChunkResult& result)
+		{
+			size_t i = first;
+
+			while (i < last)
+			{
+				uint32 columns = 0;
+
+				for (;;)
+				{
+					const size_t cellBegin = i;
+					size_t quoteCount = 0;
+					bool escaped = false;
+					bool inQuote = false;
+
+					for (; i < last; ++i)
+					{
+						const char ch = data[i];
+
+						if (syntax.hasEscape() && (ch == syntax.escape))
+						{
+							escaped = true;
+							++i;
+						}
+						else if (ch == syntax.quote)
+						{
+							inQuote = (not inQuote);
+							++quoteCount;
+						}
+						else if ((not inQuote) && ((ch == syntax.separator) || (ch == '\n')))
+						{
+							break;
+						}
+					}
+
+					i = Min(i, last);
+
+					size_t cellEnd = i;
+					const bool endOfRecord = ((last <= i) || (data[i] == '\n'));
+
+					if (endOfRecord && (cellBegin < cellEnd) && (data[cellEnd - 1] == '\r'))
+					{
+						--cellEnd;
+					}
+
+					size_t offset = cellBegin;
+					size_t length = (cellEnd - cellBegin);
+					uint32 flags = CSVCellPresent;
+
+					if (escaped || (quoteCount != 0))
+					{
+						if ((not escaped) && (quoteCount == 2) && (2 <= length)
+							&& (data[cellBegin] == syntax.quote) && (data[cellEnd - 1] == syntax.quote))
+						{
+							// "..." の形式であれば、クオートを除いた範囲をそのまま参照できる
+							offset += 1;
+							length -= 2;
+						}
+						else
+						{
+							flags |= CSVCellNeedsDecode;
+						}
+					}
+
+					result.cellOffsets << offset;
+					result.cellLengths << static_cast<uint32>(length);
+					result.cellFlags << flags;
+					++columns;
+
+					if (i < last)
+					{
+						++i;
+					}
+
+					if (endOfRecord)
+					{
+						break;
+					}
+				}
+
+				result.rowColumns << columns;
+			}
+		}
+
+		[[nodiscard]]
+		static std::string_view TrimASCIISpaces(std::string_view s) noexcept
+		{
+			while ((not s.empty()) && IsSpace(static_cast<unsigned char>(s.front())))
+			{
+				s.remove_prefix(1);
+			}
+
+			while ((not s.empty()) && IsSpace(static_cast<unsigned char>(s.back())))
+			{
+				s.remove_suffix(1);
+			}
+
+			return s;
+		}
+
+		[[nodiscard]]
+		static Optional<int64> ParseInt64(std::string_view s) noexcept
+		{
+			s = TrimASCIISpaces(s);
+
+			if ((not s.empty()) && (s.front() == '+'))
+			{
+				s.remove_prefix(1);
+			}
+
+			int64 result;
+			const auto [p, ec] = std::from_chars(s.data(), (s.data() + s.size()), result);
+
+			if ((ec != std::errc{}) || (p != (s.data() + s.size())))
+			{
+				return none;
+			}
+
+			return result;
+		}
+
+		[[nodiscard]]
+		static Optional<double> ParseDouble(std::string_view s) noexcept
+		{
+			s = TrimASCIISpaces(s);
+
+			if ((not s.empty()) && (s.front() == '+'))
+			{
+				s.remove_prefix(1);
+			}
+
+			double result;
+			const auto [p, ec] = fast_float::from_chars(s.data(), (s.data() + s.size()), result);
+
+			if ((ec != std::errc{}) || (p != (s.data() + s.size())))
+			{
+				return none;
+			}
+
+			return result;
+		}
+
+		template <class Fty>
+		static void ParallelFor(const size_t count, Fty f, const size_t grainSize)
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			Threading::ParallelFor(0, count, f, grainSize);
+
+		# else
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				f(i);
+			}
+
+		# endif
+		}
+	}
+
+	CSVTable::CSVTable(const FilePathView path, const HasHeader hasHeader, const char32 separator, const char32 quote, const char32 escape)
+	{
+		load(path, hasHeader, separator, quote, escape);
+	}
+
+	bool CSVTable::load(const FilePathView path, const HasHeader hasHeader, const char32 separator, const char32 quote, const char32 escape)
+	{
+		clear();
+
+		if ((not IsASCII(separator)) || (not IsASCII(quote)) || (not IsASCII(escape))
+			|| (separator == quote) || (separator == U'\n') || (quote == U'\n'))
+		{
+			return false;
+		}
+
+		if (not m_file.open(path, MapAll::Yes))
+		{
+			return false;
+		}
+
+		const detail::CSVSyntax syntax{ static_cast<char>(separator), static_cast<char>(quote), static_cast<char>(escape) };
+		m_quote = syntax.quote;
+		m_escape = syntax.escape;
+
+		const char* data = static_cast<const char*>(static_cast<const void*>(m_file.data()));
+		const size_t size = (data ? m_file.mappedSize() : 0);
+		size_t first = 0;
+
+		if ((3 <= size) && (data[0] == '\xEF') && (data[1] == '\xBB') && (data[2] == '\xBF'))
+		{
+			first = 3;
+		}
+
+		if (size <= first)
+		{
+			return true;
+		}
+
+		// 1. ファイルをチャンクに分割する
+		Array<size_t> chunkBegins = { first };
+		{
+			size_t numChunks = 1;
+
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			if (detail::CSVParallelParseThreshold <= (size - first))
+			{
+				numChunks = Clamp<size_t>(((size - first) / detail::CSVMinChunkSize), 1, ((Threading::GetWorkerCount() + 1) * 4));
+			}
+
+		# endif
+
+			for (size_t i = 1; i < numChunks; ++i)
+			{
+				const size_t begin = detail::AlignToUnescaped(data, first, (first + (size - first) * i / numChunks), size, syntax);
+
+				if (chunkBegins.back() < begin)
+				{
+					chunkBegins << begin;
+				}
+			}
+		}
+
+		const size_t numChunks = chunkBegins.size();
+		const auto chunkEnd = [&](const size_t i) { return (((i + 1) < numChunks) ? chunkBegins[i + 1] : size); };
+
+		// 2. 各チャンクの先頭がクオート内かどうかが分からないため、両方の場合を並列に走査する
+		Array<detail::CSVChunkScan> scans(numChunks);
+
+		if (1 < numChunks)
+		{
+			detail::ParallelFor(numChunks, [&](const size_t i)
+			{
+				scans[i] = detail::ScanChunk(data, chunkBegins[i], chunkEnd(i), syntax);
+			}, 1);
+		}
+
+		// 3. 先頭から状態を確定させ、レコードの境界で区切られた範囲を求める
+		Array<std::pair<size_t, size_t>> ranges;
+		{
+			size_t rangeBegin = first;
+			bool inQuote = scans[0].endInQuote[0];
+
+			for (size_t i = 1; i < numChunks; ++i)
+			{
+				const size_t recordBegin = scans[i].firstRecord[inQuote];
+				inQuote = scans[i].endInQuote[inQuote];
+
+				if (recordBegin == detail::CSVNoRecord)
+				{
+					continue;
+				}
+
+				ranges.emplace_back(rangeBegin, recordBegin);
+				rangeBegin = recordBegin;
+			}
+
+			ranges.emplace_back(rangeBegin, size);
+		}
+
+		// 4. 各範囲を並列に解析する
+		Array<detail::CSVChunkResult> results(ranges.size());
+
+		detail::ParallelFor(ranges.size(), [&](const size_t i)
+		{
+			detail::ParseRecords(data, ranges[i].first, ranges[i].second, syntax, results[i]);
+		}, 1);
+
+		// 5. 列ごとのセルの配列に並べ替える
+		const size_t headerRows = ((hasHeader && results.front().rowColumns) ? 1 : 0);
+		Array<size_t> rowOffsets(results.size());
+		size_t totalRows = 0;
+		size_t columnCount = 0;
+
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			rowOffsets[i] = totalRows;
+			totalRows += results[i].rowColumns.size();
+
+			for (const auto columns : results[i].rowColumns)
+			{
+				columnCount = Max<size_t>(columnCount, columns);
+			}
+		}
+
+		if (headerRows)
+		{
+			const auto& result = results.front();
+
+			for (uint32 i = 0; i < result.rowColumns.front(); ++i)
+			{
+				m_columnNames << decode(Cell{ result.cellOffsets[i], result.cellLengths[i], result.cellFlags[i] });
+			}
+		}
+
+		totalRows -= headerRows;
+		m_rowColumns.resize(totalRows);
+		m_columns.resize(columnCount);
+
+		for (auto& column : m_columns)
+		{
+			column.resize(totalRows);
+		}
+
+		detail::ParallelFor(results.size(), [&](const size_t i)
+		{
+			const auto& result = results[i];
+			size_t cellIndex = 0;
+
+			for (size_t row = 0; row < result.rowColumns.size(); ++row)
+			{
+				const uint32 columns = result.rowColumns[row];
+				const size_t globalRow = (rowOffsets[i] + row);
+
+				if (globalRow < headerRows)
+				{
+					cellIndex += columns;
+					continue;
+				}
+
+				const size_t dstRow = (globalRow - headerRows);
+				m_rowColumns[dstRow] = columns;
+
+				for (uint32 column = 0; column < columns; ++column, ++cellIndex)
+				{
+					m_columns[column][dstRow] = Cell{ result.cellOffsets[cellIndex], result.cellLengths[cellIndex], result.cellFlags[cellIndex] };
+				}
+			}
+		}, 1);
+
+		return true;
+	}
+
+	void CSVTable::clear() noexcept
+	{
+		m_columns.clear();
+		m_rowColumns.clear();
+		m_columnNames.clear();
+		m_file.close();
+	}
+
+	bool CSVTable::isEmpty() const noexcept
+	{
+		return m_rowColumns.isEmpty();
+	}
+
+	CSVTable::operator bool() const noexcept
+	{
+		return (not isEmpty());
+	}
+
+	size_t CSVTable::rows() const noexcept
+	{
+		return m_rowColumns.size();
+	}
+
+	size_t CSVTable::columns() const noexcept
+	{
+		return m_columns.size();
+	}
+
+	size_t CSVTable::columns(const size_t row) const noexcept
+	{
+		if (m_rowColumns.size() <= row)
+		{
+			return 0;
+		}
+
+		return m_rowColumns[row];
+	}
+
+	const Array<String>& CSVTable::columnNames() const noexcept
+	{
+		return m_columnNames;
+	}
+
+	Optional<size_t> CSVTable::findColumn(const StringView name) const noexcept
+	{
+		for (size_t i = 0; i < m_columnNames.size(); ++i)
+		{
+			if (m_columnNames[i] == name)
+			{
+				return i;
+			}
+		}
+
+		return none;
+	}
+
+	CSVTable::Column CSVTable::column(const size_t column) const
+	{
+		return Column{ this, column };
+	}
+
+	std::string_view CSVTable::getView(const size_t row, const size_t column) const noexcept
+	{
+		if (const Cell* cell = getCell(row, column))
+		{
+			return getView(*cell);
+		}
+
+		return{};
+	}
+
+	String CSVTable::getString(const size_t row, const size_t column) const
+	{
+		if (const Cell* cell = getCell(row, column))
+		{
+			return decode(*cell);
+		}
+
+		return{};
+	}
+
+	Optional<int64> CSVTable::getInt64(const size_t row, const size_t column) const
+	{
+		if (const Cell* cell = getCell(row, column))
+		{
+			if (cell->flags & detail::CSVCellNeedsDecode)
+			{
+				return detail::ParseInt64(Unicode::ToUTF8(decode(*cell)));
+			}
+
+			return detail::ParseInt64(getView(*cell));
+		}
+
+		return none;
+	}
+
+	Optional<double> CSVTable::getDouble(const size_t row, const size_t column) const
+	{
+		if (const Cell* cell = getCell(row, column))
+		{
+			if (cell->flags & detail::CSVCellNeedsDecode)
+			{
+				return detail::ParseDouble(Unicode::ToUTF8(decode(*cell)));
+			}
+
+			return detail::ParseDouble(getView(*cell));
+		}
+
+		return none;
+	}
+
+	const CSVTable::Cell* CSVTable::getCell(const size_t row, const size_t column) const noexcept
+	{
+		if ((m_rowColumns.size() <= row) || (m_rowColumns[row] <= column))
+		{
+			return nullptr;
+		}
+
+		return &m_columns[column][row];
+	}
+
+	std::string_view CSVTable::getView(const Cell& cell) const noexcept
+	{
+		const char* data = static_cast<const char*>(static_cast<const void*>(m_file.data()));
+
+		return{ (data + cell.offset), cell.length };
+	}
+
+	String CSVTable::decode(const Cell& cell) const
+	{
+		const std::string_view view = getView(cell);
+
+		if (not (cell.flags & detail::CSVCellNeedsDecode))
+		{
+			return Unicode::FromUTF8(view);
+		}
+
+		std::string s;
+		s.reserve(view.size());
+
+		bool inQuote = false;
+
+		for (size_t i = 0; i < view.size(); ++i)
+		{
+			const char ch = view[i];
+
+			if ((m_escape != m_quote) && (ch == m_escape))
+			{
+				if ((i + 1) < view.size())
+				{
+					const char next = view[++i];
+					s.push_back((next == 'n') ? '\n' : next);
+				}
+			}
+			else if (ch == m_quote)
+			{
+				if ((m_escape == m_quote) && inQuote && ((i + 1) < view.size()) && (view[i + 1] == m_quote))
+				{
+					s.push_back(m_quote);
+					++i;
+				}
+				else
+				{
+					inQuote = (not inQuote);
+				}
+			}
+			else
+			{
+				s.push_back(ch);
+			}
+		}
+
+		return Unicode::FromUTF8(s);
+	}
+
+	CSVTable::Column::Column(const CSVTable* table, const size_t column) noexcept
+		: m_table{ table }
+		, m_column{ column } {}
+
+	size_t CSVTable::Column::size() const noexcept
+	{
+		return (m_table ? m_table->rows() : 0);
+	}
+
+	std::string_view CSVTable::Column::getView(const size_t row) const noexcept
+	{
+		return (m_table ? m_table->getView(row, m_column) : std::string_view{});
+	}
+
+	String CSVTable::Column::getString(const size_t row) const
+	{
+		return (m_table ? m_table->getString(row, m_column) : String{});
+	}
+
+	Optional<int64> CSVTable::Column::getInt64(const size_t row) const
+	{
+		return (m_table ? m_table->getInt64(row, m_column) : none);
+	}
+
+	Optional<double> CSVTable::Column::getDouble(const size_t row) const
+	{
+		return (m_table ? m_table->getDouble(row, m_column) : none);
+	}
+
+	Array<int64> CSVTable::Column::parseInt64(const int64 defaultValue) const
+	{
+		Array<int64> results(size(), defaultValue);
+
+		detail::ParallelFor(results.size(), [&](const size_t row)
+		{
+			if (const auto value = getInt64(row))
+			{
+				results[row] = *value;
+			}
+		}, detail::CSVParseGrainSize);
+
+		return results;
+	}
+
+	Array<double> CSVTable::Column::parseDouble(const double defaultValue) const
+	{
+		Array<double> results(size(), defaultValue);
+
+		detail::ParallelFor(results.size(), [&](const size_t row)
+		{
+			if (const auto value = getDouble(row))
+			{
+				results[row] = *value;
+			}
+		}, detail::CSVParseGrainSize);
+
+		return results;
+	}
+}
@@ -18,6 +18,16 @@ namespace s3d
 {
 	namespace Internal
 	{
+	# if SIV3D_BUILD(DEBUG)
+
+		std::atomic<uint8> g_engineLogTypeLimit{ static_cast<uint8>(LogType::Verbose) };
+
+	# else
+
+		std::atomic<uint8> g_engineLogTypeLimit{ static_cast<uint8>(LogType::Info) };
+
+	# endif
+
 		void OutputEngineLog(const LogType type, const StringView s)
 		{
 			if (Siv3DEngine::isActive())
@@ -30,7 +40,7 @@ namespace s3d
 			: m_type{ type }
 			, m_s{ std::move(s) }
 		{
-			if (Siv3DEngine::isActive())
+			if (m_s && Siv3DEngine::isActive())
 			{
 				SIV3D_ENGINE(Logger)->write(m_type, m_s + U" ---"_s);
 			}
@@ -38,7 +48,7 @@ namespace s3d
 
 		ScopedEngineLog::~ScopedEngineLog()
 		{
-			if (Siv3DEngine::isActive())
+			if (m_s && Siv3DEngine::isActive())
 			{
 				SIV3D_ENGINE(Logger)->write(m_type, U"--- "_s + m_s);
 			}
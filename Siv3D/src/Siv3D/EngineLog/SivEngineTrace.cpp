@@ -0,0 +1,454 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <algorithm>
+# include <chrono>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <Siv3D/EngineTrace.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+
+namespace s3d
+{
+	namespace
+	{
+		constexpr char TraceFileMagic[8] = { 'S', '3', 'D', 'T', 'R', 'A', 'C', 'E' };
+
+		constexpr uint32 TraceFileVersion = 1;
+
+		/// @brief リングバッファの 1 イベント
+		/// @remark 書き込み中のイベントを読み飛ばすため、sequence には書き込み開始時に奇数、完了時に偶数を格納します。
+		struct TraceRecord
+		{
+			std::atomic<uint64> sequence{ 0 };
+
+			std::atomic<uint64> timeNanosec{ 0 };
+
+			/// @brief イベント ID (16 bit), 引数の数 (8 bit), スレッド ID (32 bit)
+			std::atomic<uint64> header{ 0 };
+
+			std::array<std::atomic<uint64>, EngineTrace::MaxArgs> args{};
+		};
+
+		/// @brief ファイルに保存するイベント
+		struct SavedRecord
+		{
+			uint64 timeNanosec = 0;
+
+			uint16 id = 0;
+
+			uint8 argCount = 0;
+
+			uint8 unused = 0;
+
+			uint32 threadID = 0;
+
+			std::array<uint64, EngineTrace::MaxArgs> args{};
+		};
+
+		class TraceBuffer
+		{
+		public:
+
+			TraceBuffer()
+				: m_records(std::make_unique<TraceRecord[]>(EngineTrace::Capacity))
+				, m_startTime{ std::chrono::steady_clock::now() } {}
+
+			[[nodiscard]]
+			uint16 registerEvent(const EngineTrace::detail::EventDesc& desc)
+			{
+				std::lock_guard lock{ m_eventMutex };
+
+				if (m_events.size() == Largest<uint16>)
+				{
+					return 0;
+				}
+
+				m_events << desc;
+
+				return static_cast<uint16>(m_events.size());
+			}
+
+			void record(const uint16 id, const uint64* args, const size_t argCount) noexcept
+			{
+				const uint64 position = m_writePosition.fetch_add(1, std::memory_order_relaxed);
+				TraceRecord& record = m_records[position % EngineTrace::Capacity];
+
+				record.sequence.store(((position * 2) + 1), std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+
+				const uint64 time = static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime).count());
+				record.timeNanosec.store(time, std::memory_order_relaxed);
+				record.header.store((static_cast<uint64>(id) | (static_cast<uint64>(argCount) << 16) | (static_cast<uint64>(GetThreadID()) << 32)), std::memory_order_relaxed);
+
+				for (size_t i = 0; i < argCount; ++i)
+				{
+					record.args[i].store(args[i], std::memory_order_relaxed);
+				}
+
+				record.sequence.store(((position * 2) + 2), std::memory_order_release);
+			}
+
+			void clear() noexcept
+			{
+				// 書き込み中のイベントは、位置が一致しなくなるため保存時に読み飛ばされる
+				m_writePosition.store(0, std::memory_order_relaxed);
+
+				for (size_t i = 0; i < EngineTrace::Capacity; ++i)
+				{
+					m_records[i].sequence.store(0, std::memory_order_relaxed);
+				}
+			}
+
+			[[nodiscard]]
+			Array<EngineTrace::detail::EventDesc> getEvents() const
+			{
+				std::lock_guard lock{ m_eventMutex };
+
+				return m_events;
+			}
+
+			[[nodiscard]]
+			Array<SavedRecord> snapshot() const
+			{
+				const uint64 end = m_writePosition.load(std::memory_order_acquire);
+				const uint64 begin = ((EngineTrace::Capacity < end) ? (end - EngineTrace::Capacity) : 0);
+
+				Array<SavedRecord> results(Arg::reserve = static_cast<size_t>(end - begin));
+
+				for (uint64 position = begin; position < end; ++position)
+				{
+					const TraceRecord& record = m_records[position % EngineTrace::Capacity];
+					const uint64 expected = ((position * 2) + 2);
+
+					if (record.sequence.load(std::memory_order_acquire) != expected)
+					{
+						continue;
+					}
+
+					SavedRecord saved;
+					saved.timeNanosec = record.timeNanosec.load(std::memory_order_relaxed);
+					const uint64 header = record.header.load(std::memory_order_relaxed);
+					saved.id = static_cast<uint16>(header & 0xFFFF);
+					saved.argCount = static_cast<uint8>(Min<uint64>(((header >> 16) & 0xFF), EngineTrace::MaxArgs));
+					saved.threadID = static_cast<uint32>(header >> 32);
+
+					for (size_t i = 0; i < saved.argCount; ++i)
+					{
+						saved.args[i] = record.args[i].load(std::memory_order_relaxed);
+					}
+
+					std::atomic_thread_fence(std::memory_order_acquire);
+
+					// 読み取り中に上書きされたイベントは捨てる
+					if (record.sequence.load(std::memory_order_relaxed) != expected)
+					{
+						continue;
+					}
+
+					results << saved;
+				}
+
+				return results;
+			}
+
+		private:
+
+			std::unique_ptr<TraceRecord[]> m_records;
+
+			std::atomic<uint64> m_writePosition{ 0 };
+
+			const std::chrono::steady_clock::time_point m_startTime;
+
+			mutable std::mutex m_eventMutex;
+
+			Array<EngineTrace::detail::EventDesc> m_events;
+
+			[[nodiscard]]
+			static uint32 GetThreadID() noexcept
+			{
+				thread_local const uint32 threadID = static_cast<uint32>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+				return threadID;
+			}
+		};
+
+		[[nodiscard]]
+		static TraceBuffer& GetTraceBuffer()
+		{
+			static TraceBuffer buffer;
+
+			return buffer;
+		}
+
+		static void WriteString(BinaryWriter& writer, const std::string& s)
+		{
+			writer.write(static_cast<uint32>(s.size()));
+			writer.write(s.data(), s.size());
+		}
+
+		[[nodiscard]]
+		static bool ReadString(BinaryReader& reader, std::string& s)
+		{
+			uint32 length = 0;
+
+			if ((not reader.read(length))
+				|| ((reader.size() - reader.getPos()) < length))
+			{
+				return false;
+			}
+
+			s.resize(length);
+
+			return (reader.read(s.data(), length) == length);
+		}
+
+		/// @brief 読み込んだイベントの書式
+		struct DecodedEvent
+		{
+			String format;
+
+			String location;
+
+			uint8 argCount = 0;
+
+			std::array<EngineTrace::detail::ArgType, EngineTrace::MaxArgs> argTypes{};
+		};
+
+		[[nodiscard]]
+		static bool IsValidArgType(const EngineTrace::detail::ArgType type) noexcept
+		{
+			return (FromEnum(type) <= FromEnum(EngineTrace::detail::ArgType::Pointer));
+		}
+
+		[[nodiscard]]
+		static String FormatRecord(const DecodedEvent& event, const SavedRecord& record)
+		{
+			using EngineTrace::detail::ArgType;
+
+			using Context = fmt::buffer_context<char32>;
+
+			std::array<fmt::basic_format_arg<Context>, EngineTrace::MaxArgs> formatArgs;
+			const size_t argCount = Min<size_t>({ event.argCount, record.argCount, EngineTrace::MaxArgs });
+
+			// 数値の引数は値として保持されるため、一時オブジェクトから作成してもよい
+			const auto makeArg = [](auto value)
+			{
+				return fmt::basic_format_args<Context>{ fmt::make_format_args<Context>(value) }.get(0);
+			};
+
+			for (size_t i = 0; i < argCount; ++i)
+			{
+				const uint64 raw = record.args[i];
+
+				switch (event.argTypes[i])
+				{
+				case ArgType::Int:
+					formatArgs[i] = makeArg(static_cast<int64>(raw));
+					break;
+				case ArgType::UInt:
+					formatArgs[i] = makeArg(raw);
+					break;
+				case ArgType::Float:
+					{
+						double d;
+						std::memcpy(&d, &raw, sizeof(d));
+						formatArgs[i] = makeArg(d);
+						break;
+					}
+				case ArgType::Boolean:
+					formatArgs[i] = makeArg(raw != 0);
+					break;
+				case ArgType::Pointer:
+					formatArgs[i] = makeArg(reinterpret_cast<const void*>(static_cast<std::uintptr_t>(raw)));
+					break;
+				}
+			}
+
+			try
+			{
+				const std::u32string s = fmt::vformat(fmt::basic_string_view<char32>{ event.format.data(), event.format.size() }, fmt::basic_format_args<Context>{ formatArgs.data(), static_cast<int32>(argCount) });
+
+				return String{ s.data(), s.size() };
+			}
+			catch (const fmt::format_error&)
+			{
+				return event.format;
+			}
+		}
+	}
+
+	namespace EngineTrace
+	{
+		namespace detail
+		{
+			std::atomic<bool> g_enabled{ true };
+
+			uint16 RegisterEvent(const EventDesc& desc)
+			{
+				return GetTraceBuffer().registerEvent(desc);
+			}
+
+			void RecordEvent(const uint16 id, const uint64* args, const size_t argCount) noexcept
+			{
+				if (id == 0)
+				{
+					return;
+				}
+
+				GetTraceBuffer().record(id, args, Min(argCount, MaxArgs));
+			}
+		}
+
+		void SetEnabled(const bool enabled) noexcept
+		{
+			detail::g_enabled.store(enabled, std::memory_order_relaxed);
+		}
+
+		bool IsEnabled() noexcept
+		{
+			return detail::g_enabled.load(std::memory_order_relaxed);
+		}
+
+		void Clear() noexcept
+		{
+			GetTraceBuffer().clear();
+		}
+
+		bool Save(const FilePathView path)
+		{
+			const TraceBuffer& buffer = GetTraceBuffer();
+			const Array<SavedRecord> records = buffer.snapshot();
+			const Array<detail::EventDesc> events = buffer.getEvents();
+
+			BinaryWriter writer{ path };
+
+			if (not writer)
+			{
+				return false;
+			}
+
+			writer.write(TraceFileMagic, sizeof(TraceFileMagic));
+			writer.write(TraceFileVersion);
+			writer.write(static_cast<uint32>(events.size()));
+
+			for (const auto& event : events)
+			{
+				writer.write(event.line);
+				writer.write(event.argCount);
+				writer.write(event.argTypes);
+				WriteString(writer, std::string{ event.file });
+				WriteString(writer, Unicode::ToUTF8(StringView{ event.format }));
+			}
+
+			writer.write(static_cast<uint32>(records.size()));
+			writer.write(records.data(), (records.size() * sizeof(SavedRecord)));
+
+			return true;
+		}
+
+		Array<String> Decode(const FilePathView path)
+		{
+			BinaryReader reader{ path };
+
+			if (not reader)
+			{
+				return{};
+			}
+
+			char magic[sizeof(TraceFileMagic)];
+			uint32 version = 0;
+			uint32 eventCount = 0;
+
+			if ((reader.read(magic, sizeof(magic)) != sizeof(magic))
+				|| (std::memcmp(magic, TraceFileMagic, sizeof(magic)) != 0)
+				|| (not reader.read(version))
+				|| (version != TraceFileVersion)
+				|| (not reader.read(eventCount)))
+			{
+				return{};
+			}
+
+			// 1 つのイベントの書式は少なくとも (line, argCount, argTypes, 2 つの文字列の長さ) を含む
+			constexpr int64 MinEventSize = (sizeof(uint32) + sizeof(uint8) + MaxArgs + (sizeof(uint32) * 2));
+
+			if (((reader.size() - reader.getPos()) / MinEventSize) < eventCount)
+			{
+				return{};
+			}
+
+			Array<DecodedEvent> events(Arg::reserve = eventCount);
+
+			for (uint32 i = 0; i < eventCount; ++i)
+			{
+				uint32 line = 0;
+				DecodedEvent event;
+				std::string file, format;
+
+				if ((not reader.read(line))
+					|| (not reader.read(event.argCount))
+					|| (not reader.read(event.argTypes))
+					|| (not ReadString(reader, file))
+					|| (not ReadString(reader, format)))
+				{
+					return{};
+				}
+
+				// 壊れたファイルの引数の数と型で、整形時に配列の範囲外へアクセスしないようにする
+				if ((MaxArgs < event.argCount)
+					|| (not std::all_of(event.argTypes.begin(), event.argTypes.end(), IsValidArgType)))
+				{
+					return{};
+				}
+
+				event.format = Unicode::FromUTF8(format);
+				event.location = U"{}:{}"_fmt(Unicode::FromUTF8(file), line);
+				events << std::move(event);
+			}
+
+			uint32 recordCount = 0;
+
+			if ((not reader.read(recordCount))
+				|| ((reader.size() - reader.getPos()) < static_cast<int64>(recordCount * sizeof(SavedRecord))))
+			{
+				return{};
+			}
+
+			Array<SavedRecord> records(recordCount);
+			reader.read(records.data(), (records.size() * sizeof(SavedRecord)));
+
+			for (auto& record : records)
+			{
+				record.argCount = Min<uint8>(record.argCount, static_cast<uint8>(MaxArgs));
+			}
+
+			Array<String> results(Arg::reserve = records.size());
+
+			for (const auto& record : records)
+			{
+				if ((record.id == 0) || (events.size() < record.id))
+				{
+					continue;
+				}
+
+				const DecodedEvent& event = events[record.id - 1];
+
+				results << U"[{:.3f}us] [{:08X}] {} ({})"_fmt((record.timeNanosec / 1000.0), record.threadID, FormatRecord(event, record), event.location);
+			}
+
+			return results;
+		}
+	}
+}
@@ -34,5 +34,11 @@ namespace s3d
 			g_engineOptions.d3d11Driver = value;
 			return 0;
 		}
+
+		int SetEngineOption(const EngineOption::HeadlessRenderer value) noexcept
+		{
+			g_engineOptions.headlessRenderer = value;
+			return 0;
+		}
 	}
 }
@@ -248,6 +248,21 @@ namespace s3d
 		return m_fonts[handleID]->getGlyphCache().getBufferWidth();
 	}
 
+	void CFont::setMaxGlyphCachePages(const Font::IDType handleID, const size_t maxPages)
+	{
+		m_fonts[handleID]->getGlyphCache().setMaxPages(maxPages);
+	}
+
+	size_t CFont::getMaxGlyphCachePages(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getGlyphCache().getMaxPages();
+	}
+
+	GlyphCacheStats CFont::getGlyphCacheStats(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getGlyphCache().getStats();
+	}
+
 	bool CFont::hasGlyph(const Font::IDType handleID, StringView ch)
 	{
 		return m_fonts[handleID]->hasGlyph(ch);
@@ -352,9 +367,16 @@ namespace s3d
 		return font->getGlyphCache().preload(*font, chars);
 	}
 
-	const Texture& CFont::getTexture(const Font::IDType handleID)
+	AsyncTask<bool> CFont::preloadAsync(const Font::IDType handleID, const StringView chars)
+	{
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().preloadAsync(*font, chars);
+	}
+
+	const Texture& CFont::getTexture(const Font::IDType handleID, const size_t page)
 	{
-		return m_fonts[handleID]->getGlyphCache().getTexture();
+		return m_fonts[handleID]->getGlyphCache().getTexture(page);
 	}
 
 	Glyph CFont::getGlyph(const Font::IDType handleID, const StringView ch)
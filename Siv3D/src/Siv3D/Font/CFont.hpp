@@ -71,6 +71,12 @@ namespace s3d
 
 		int32 getBufferThickness(Font::IDType handleID) override;
 
+		void setMaxGlyphCachePages(Font::IDType handleID, size_t maxPages) override;
+
+		size_t getMaxGlyphCachePages(Font::IDType handleID) override;
+
+		GlyphCacheStats getGlyphCacheStats(Font::IDType handleID) override;
+
 		bool hasGlyph(Font::IDType handleID, StringView ch) override;
 
 		GlyphIndex getGlyphIndex(Font::IDType handleID, StringView ch) override;
@@ -107,7 +113,9 @@ namespace s3d
 	
 		bool preload(Font::IDType handleID, StringView chars) override;
 
-		const Texture& getTexture(Font::IDType handleID) override;
+		AsyncTask<bool> preloadAsync(Font::IDType handleID, StringView chars) override;
+
+		const Texture& getTexture(Font::IDType handleID, size_t page) override;
 
 		Glyph getGlyph(Font::IDType handleID, StringView ch) override;
 
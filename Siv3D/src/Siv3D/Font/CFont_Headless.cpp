@@ -16,12 +16,82 @@
 # include <Siv3D/MeshGlyph.hpp>
 # include <Siv3D/Resource.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Graphics2D.hpp>
+# include <Siv3D/Uncopyable.hpp>
+# include <Siv3D/EngineOptions.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+# include <Siv3D/Renderer2D/IRenderer2D.hpp>
+# include <Siv3D/Renderer2D/Software/CRenderer2D_Software.hpp>
 # include "CFont_Headless.hpp"
 # include "GlyphCache/IGlyphCache.hpp"
 # include "FontCommon.hpp"
 
 namespace s3d
 {
+	namespace
+	{
+		[[nodiscard]]
+		static SoftwarePixelShaderType GetSoftwareFontShader(const FontMethod method, const TextStyle::Type type, const HasColor hasColor) noexcept
+		{
+			if (hasColor)
+			{
+				return SoftwarePixelShaderType::Texture;
+			}
+
+			if (method == FontMethod::Bitmap)
+			{
+				return SoftwarePixelShaderType::BitmapFont;
+			}
+
+			const bool sdf = (method == FontMethod::SDF);
+
+			switch (type)
+			{
+			case TextStyle::Type::Outline:
+				return (sdf ? SoftwarePixelShaderType::SDFFontOutline : SoftwarePixelShaderType::MSDFFontOutline);
+			case TextStyle::Type::Shadow:
+				return (sdf ? SoftwarePixelShaderType::SDFFontShadow : SoftwarePixelShaderType::MSDFFontShadow);
+			case TextStyle::Type::OutlineShadow:
+				return (sdf ? SoftwarePixelShaderType::SDFFontOutlineShadow : SoftwarePixelShaderType::MSDFFontOutlineShadow);
+			default: // カスタムシェーダは使えないため、通常のシェーダで描く
+				return (sdf ? SoftwarePixelShaderType::SDFFont : SoftwarePixelShaderType::MSDFFont);
+			}
+		}
+
+		/// @brief ソフトウェアレンダラーでフォント用のピクセルシェーダを一時的に使うためのクラス
+		class ScopedSoftwareFontShader : Uncopyable
+		{
+		public:
+
+			ScopedSoftwareFontShader(CRenderer2D_Software& renderer2D, const FontData& font, const TextStyle& textStyle, const HasColor hasColor)
+				: m_renderer2D{ renderer2D }
+			{
+				if (textStyle.type != TextStyle::Type::Default && (not hasColor))
+				{
+					if (font.getMethod() == FontMethod::SDF)
+					{
+						Graphics2D::SetSDFParameters(textStyle);
+					}
+					else
+					{
+						Graphics2D::SetMSDFParameters(textStyle);
+					}
+				}
+
+				m_renderer2D.setPixelShaderOverride(GetSoftwareFontShader(font.getMethod(), textStyle.type, hasColor));
+			}
+
+			~ScopedSoftwareFontShader()
+			{
+				m_renderer2D.setPixelShaderOverride(none);
+			}
+
+		private:
+
+			CRenderer2D_Software& m_renderer2D;
+		};
+	}
+
 	CFont_Headless::CFont_Headless()
 	{
 		// do nothing
@@ -97,6 +167,13 @@ namespace s3d
 		}
 
 		m_emptyPixelShader = std::make_unique<PixelShader>();
+
+		// ソフトウェアレンダラーを使う場合は、テキストを実際に描画する
+		if ((g_engineOptions.renderer == EngineOption::Renderer::Headless)
+			&& (g_engineOptions.headlessRenderer == EngineOption::HeadlessRenderer::Software))
+		{
+			m_pSoftwareRenderer2D = static_cast<CRenderer2D_Software*>(SIV3D_ENGINE(Renderer2D));
+		}
 	}
 
 	size_t CFont_Headless::getFontCount() const
@@ -164,6 +241,21 @@ namespace s3d
 		return m_fonts[handleID]->getGlyphCache().getBufferWidth();
 	}
 
+	void CFont_Headless::setMaxGlyphCachePages(const Font::IDType handleID, const size_t maxPages)
+	{
+		m_fonts[handleID]->getGlyphCache().setMaxPages(maxPages);
+	}
+
+	size_t CFont_Headless::getMaxGlyphCachePages(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getGlyphCache().getMaxPages();
+	}
+
+	GlyphCacheStats CFont_Headless::getGlyphCacheStats(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getGlyphCache().getStats();
+	}
+
 	bool CFont_Headless::hasGlyph(const Font::IDType handleID, StringView ch)
 	{
 		return m_fonts[handleID]->hasGlyph(ch);
@@ -268,9 +360,16 @@ namespace s3d
 		return font->getGlyphCache().preload(*font, chars);
 	}
 
-	const Texture& CFont_Headless::getTexture(const Font::IDType handleID)
+	AsyncTask<bool> CFont_Headless::preloadAsync(const Font::IDType handleID, const StringView chars)
 	{
-		return m_fonts[handleID]->getGlyphCache().getTexture();
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().preloadAsync(*font, chars);
+	}
+
+	const Texture& CFont_Headless::getTexture(const Font::IDType handleID, const size_t page)
+	{
+		return m_fonts[handleID]->getGlyphCache().getTexture(page);
 	}
 
 	Glyph CFont_Headless::getGlyph(const Font::IDType handleID, const StringView ch)
@@ -326,48 +425,80 @@ namespace s3d
 		}
 	}
 
-	RectF CFont_Headless::draw(const Font::IDType handleID, const StringView s, const Array<GlyphCluster>& clusters, const Vec2& pos, const double fontSize, const TextStyle&, const ColorF&, const double lineHeightScale)
+	RectF CFont_Headless::draw(const Font::IDType handleID, const StringView s, const Array<GlyphCluster>& clusters, const Vec2& pos, const double fontSize, const TextStyle& textStyle, const ColorF& color, const double lineHeightScale)
 	{
 		const auto& font = m_fonts[handleID];
+
+		if (not m_pSoftwareRenderer2D)
 		{
 			return m_fonts[handleID]->getGlyphCache().region(*font, s, clusters, false, pos, fontSize, lineHeightScale);
 		}
+
+		const HasColor hasColor{ font->getProperty().hasColor };
+		const ScopedSoftwareFontShader ps{ *m_pSoftwareRenderer2D, *font, textStyle, hasColor };
+		return m_fonts[handleID]->getGlyphCache().draw(*font, s, clusters, false, pos, fontSize, textStyle, (hasColor ? ColorF{ 1.0, color.a } : color), lineHeightScale);
 	}
 
-	bool CFont_Headless::fits(const Font::IDType, const StringView, const Array<GlyphCluster>&, const RectF&, const double, const double)
+	bool CFont_Headless::fits(const Font::IDType handleID, const StringView s, const Array<GlyphCluster>& clusters, const RectF& area, const double fontSize, const double lineHeightScale)
 	{
-		// [Siv3D ToDo]
-		return false;
+		const auto& font = m_fonts[handleID];
+
+		return m_fonts[handleID]->getGlyphCache().fits(*font, s, clusters, area, fontSize, lineHeightScale);
 	}
 
-	bool CFont_Headless::draw(const Font::IDType, const StringView, const Array<GlyphCluster>&, const RectF&, const double, const TextStyle&, const ColorF&, const double)
+	bool CFont_Headless::draw(const Font::IDType handleID, const StringView s, const Array<GlyphCluster>& clusters, const RectF& area, const double fontSize, const TextStyle& textStyle, const ColorF& color, const double lineHeightScale)
 	{
-		// [Siv3D ToDo]
-		return false;
+		if (not m_pSoftwareRenderer2D)
+		{
+			return fits(handleID, s, clusters, area, fontSize, lineHeightScale);
+		}
+
+		const auto& font = m_fonts[handleID];
+		const HasColor hasColor{ font->getProperty().hasColor };
+		const ScopedSoftwareFontShader ps{ *m_pSoftwareRenderer2D, *font, textStyle, hasColor };
+		return m_fonts[handleID]->getGlyphCache().draw(*font, s, clusters, area, fontSize, textStyle, (hasColor ? ColorF{ 1.0, color.a } : color), lineHeightScale);
 	}
 
-	RectF CFont_Headless::drawBase(const Font::IDType handleID, const StringView s, const Array<GlyphCluster>& clusters, const Vec2& pos, const double fontSize, const TextStyle&, const ColorF&, const double lineHeightScale)
+	RectF CFont_Headless::drawBase(const Font::IDType handleID, const StringView s, const Array<GlyphCluster>& clusters, const Vec2& pos, const double fontSize, const TextStyle& textStyle, const ColorF& color, const double lineHeightScale)
 	{
 		const auto& font = m_fonts[handleID];
+
+		if (not m_pSoftwareRenderer2D)
 		{
 			return m_fonts[handleID]->getGlyphCache().region(*font, s, clusters, true, pos, fontSize, lineHeightScale);
 		}
+
+		const HasColor hasColor{ font->getProperty().hasColor };
+		const ScopedSoftwareFontShader ps{ *m_pSoftwareRenderer2D, *font, textStyle, hasColor };
+		return m_fonts[handleID]->getGlyphCache().draw(*font, s, clusters, true, pos, fontSize, textStyle, (hasColor ? ColorF{ 1.0, color.a } : color), lineHeightScale);
 	}
 
-	RectF CFont_Headless::drawFallback(const Font::IDType handleID, const GlyphCluster& cluster, const Vec2& pos, const double fontSize, const TextStyle&, const ColorF&, const double lineHeightScale)
+	RectF CFont_Headless::drawFallback(const Font::IDType handleID, const GlyphCluster& cluster, const Vec2& pos, const double fontSize, const TextStyle& textStyle, const ColorF& color, const double lineHeightScale)
 	{
 		const auto& font = m_fonts[handleID];
+
+		if (not m_pSoftwareRenderer2D)
 		{
 			return m_fonts[handleID]->getGlyphCache().regionFallback(*font, cluster, false, pos, fontSize, lineHeightScale);
 		}
+
+		const HasColor hasColor{ font->getProperty().hasColor };
+		const ScopedSoftwareFontShader ps{ *m_pSoftwareRenderer2D, *font, textStyle, hasColor };
+		return m_fonts[handleID]->getGlyphCache().drawFallback(*font, cluster, false, pos, fontSize, (hasColor ? ColorF{ 1.0, color.a } : color), lineHeightScale);
 	}
 
-	RectF CFont_Headless::drawBaseFallback(const Font::IDType handleID, const GlyphCluster& cluster, const Vec2& pos, const double fontSize, const TextStyle&, const ColorF&, const double lineHeightScale)
+	RectF CFont_Headless::drawBaseFallback(const Font::IDType handleID, const GlyphCluster& cluster, const Vec2& pos, const double fontSize, const TextStyle& textStyle, const ColorF& color, const double lineHeightScale)
 	{
 		const auto& font = m_fonts[handleID];
+
+		if (not m_pSoftwareRenderer2D)
 		{
 			return m_fonts[handleID]->getGlyphCache().regionFallback(*font, cluster, true, pos, fontSize, lineHeightScale);
 		}
+
+		const HasColor hasColor{ font->getProperty().hasColor };
+		const ScopedSoftwareFontShader ps{ *m_pSoftwareRenderer2D, *font, textStyle, hasColor };
+		return m_fonts[handleID]->getGlyphCache().drawFallback(*font, cluster, true, pos, fontSize, (hasColor ? ColorF{ 1.0, color.a } : color), lineHeightScale);
 	}
 
 	RectF CFont_Headless::regionFallback(const Font::IDType handleID, const GlyphCluster& cluster, const Vec2& pos, const double fontSize, double lineHeightScale)
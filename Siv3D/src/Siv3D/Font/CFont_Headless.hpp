@@ -21,6 +21,8 @@
 
 namespace s3d
 {
+	class CRenderer2D_Software;
+
 	class CFont_Headless final : public ISiv3DFont
 	{
 	public:
@@ -51,6 +53,12 @@ namespace s3d
 
 		int32 getBufferThickness(Font::IDType handleID) override;
 
+		void setMaxGlyphCachePages(Font::IDType handleID, size_t maxPages) override;
+
+		size_t getMaxGlyphCachePages(Font::IDType handleID) override;
+
+		GlyphCacheStats getGlyphCacheStats(Font::IDType handleID) override;
+
 		bool hasGlyph(Font::IDType handleID, StringView ch) override;
 
 		GlyphIndex getGlyphIndex(Font::IDType handleID, StringView ch) override;
@@ -87,7 +95,9 @@ namespace s3d
 	
 		bool preload(Font::IDType handleID, StringView chars) override;
 
-		const Texture& getTexture(Font::IDType handleID) override;
+		AsyncTask<bool> preloadAsync(Font::IDType handleID, StringView chars) override;
+
+		const Texture& getTexture(Font::IDType handleID, size_t page) override;
 
 		Glyph getGlyph(Font::IDType handleID, StringView ch) override;
 
@@ -150,5 +160,8 @@ namespace s3d
 		Array<std::unique_ptr<IconData>> m_defaultIcons;
 
 		std::unique_ptr<PixelShader> m_emptyPixelShader;
+
+		/// @brief ソフトウェアレンダラーを使う場合の 2D レンダラー。それ以外の場合は nullptr
+		CRenderer2D_Software* m_pSoftwareRenderer2D = nullptr;
 	};
 }
@@ -85,6 +85,22 @@ namespace s3d
 
 		m_method = fontMethod;
 
+		m_faceSource.path		= path;
+		m_faceSource.faceIndex	= faceIndex;
+		m_faceSource.fontSize	= fontSize;
+		m_faceSource.style		= style;
+		m_faceSource.method		= fontMethod;
+
+	# if SIV3D_PLATFORM(WINDOWS)
+
+		if (m_resource.data())
+		{
+			m_faceSource.data = m_resource.data();
+			m_faceSource.size = static_cast<size_t>(m_resource.size());
+		}
+
+	# endif
+
 		m_initialized = true;
 	}
 
@@ -328,6 +344,26 @@ namespace s3d
 		return *m_glyphCache;
 	}
 
+	FT_Face FontData::getFT_Face() const noexcept
+	{
+		return m_fontFace.getFT_Face();
+	}
+
+	std::shared_ptr<FontFacePool> FontData::getFacePool() const
+	{
+		if (not m_fontFace.getFT_Face())
+		{
+			return nullptr;
+		}
+
+		if (not m_facePool)
+		{
+			m_facePool = std::make_shared<FontFacePool>(m_faceSource);
+		}
+
+		return m_facePool;
+	}
+
 	bool FontData::addFallbackFont(const std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>& font)
 	{
 		m_fallbackFonts.push_back(font);
@@ -15,6 +15,7 @@
 # include <Siv3D/Font.hpp>
 # include "FontResourceHolder.hpp"
 # include "FontFace.hpp"
+# include "FontFacePool.hpp"
 
 namespace s3d
 {
@@ -81,6 +82,15 @@ namespace s3d
 		[[nodiscard]]
 		IGlyphCache& getGlyphCache() const;
 
+		[[nodiscard]]
+		FT_Face getFT_Face() const noexcept;
+
+		/// @brief ワーカースレッド用のフォントの複製の集合を返します。
+		/// @remark メインスレッドから呼ぶ必要があります。
+		/// @return フォントの複製の集合。複製を作成できないフォントの場合は nullptr
+		[[nodiscard]]
+		std::shared_ptr<FontFacePool> getFacePool() const;
+
 		[[nodiscard]]
 		bool addFallbackFont(const std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>& font);
 		
@@ -97,6 +107,10 @@ namespace s3d
 
 		FontFace m_fontFace;
 
+		FontFacePool::Source m_faceSource;
+
+		mutable std::shared_ptr<FontFacePool> m_facePool;
+
 		Array<std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>> m_fallbackFonts;
 
 		FontMethod m_method = FontMethod::Bitmap;
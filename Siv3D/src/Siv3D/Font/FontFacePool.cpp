@@ -0,0 +1,106 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "FontFacePool.hpp"
+# include "FreeType.hpp"
+
+namespace s3d
+{
+	bool FontFacePool::Face::load(const FT_Library library, const void* data, const size_t size, const Source& source)
+	{
+		return m_fontFace.load(library, data, size, source.faceIndex, source.fontSize, source.style, source.method);
+	}
+
+	FT_Face FontFacePool::Face::getFT_Face() const noexcept
+	{
+		return m_fontFace.getFT_Face();
+	}
+
+	FontFacePool::FontFacePool(const Source& source)
+		: m_source{ source } {}
+
+	FontFacePool::~FontFacePool()
+	{
+		// FT_Face を FT_Library より先に破棄する
+		m_faces.clear();
+
+		if (m_library)
+		{
+			::FT_Done_FreeType(m_library);
+		}
+	}
+
+	std::unique_ptr<FontFacePool::Face> FontFacePool::acquire()
+	{
+		std::lock_guard lock{ m_mutex };
+
+		if (m_faces)
+		{
+			std::unique_ptr<Face> face = std::move(m_faces.back());
+			m_faces.pop_back();
+			return face;
+		}
+
+		if (m_failed)
+		{
+			return nullptr;
+		}
+
+		// 同じ FT_Library に対して FT_New_Face を同時に呼べないため、ロックしたまま作成する。
+		// フォントデータはメモリ上にあるので、ファイルの読み込みは発生しない
+		if (not initLocked())
+		{
+			m_failed = true;
+			return nullptr;
+		}
+
+		auto face = std::make_unique<Face>();
+		const void* data = (m_source.data ? m_source.data : m_blob.data());
+		const size_t size = (m_source.data ? m_source.size : m_blob.size());
+
+		if (not face->load(m_library, data, size, m_source))
+		{
+			m_failed = true;
+			return nullptr;
+		}
+
+		return face;
+	}
+
+	void FontFacePool::release(std::unique_ptr<Face> face)
+	{
+		if (not face)
+		{
+			return;
+		}
+
+		std::lock_guard lock{ m_mutex };
+
+		m_faces << std::move(face);
+	}
+
+	bool FontFacePool::initLocked()
+	{
+		if (m_library)
+		{
+			return true;
+		}
+
+		// フォントファイルは最初の 1 回だけ読み込み、すべての複製で共有する
+		if ((not m_source.data)
+			&& (not m_blob.createFromFile(m_source.path)))
+		{
+			return false;
+		}
+
+		return (::FT_Init_FreeType(&m_library) == 0);
+	}
+}
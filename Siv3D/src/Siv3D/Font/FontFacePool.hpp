@@ -0,0 +1,107 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <mutex>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Blob.hpp>
+# include <Siv3D/FontStyle.hpp>
+# include <Siv3D/FontMethod.hpp>
+# include "FontFace.hpp"
+
+namespace s3d
+{
+	/// @brief ワーカースレッドでグリフをレンダリングするための、フォントの複製の集合
+	/// @remark FreeType のフェイスはスレッドセーフではないため、各複製は同時に 1 つのスレッドからのみ使われます。
+	/// すべての複製は 1 つの FT_Library と、メモリ上の 1 つのフォントデータを共有し、FT_Face の作成と破棄はプールのロック中に行います。
+	class FontFacePool
+	{
+	public:
+
+		struct Source
+		{
+			FilePath path;
+
+			/// @brief メモリ上のフォントデータ（プロセスの終了まで有効である必要があります）。nullptr の場合は `path` のファイルを読み込みます。
+			const void* data = nullptr;
+
+			size_t size = 0;
+
+			size_t faceIndex = 0;
+
+			int32 fontSize = 0;
+
+			FontStyle style = FontStyle::Default;
+
+			FontMethod method = FontMethod::Bitmap;
+		};
+
+		class Face
+		{
+		public:
+
+			Face() = default;
+
+			~Face() = default;
+
+			Face(const Face&) = delete;
+
+			Face& operator =(const Face&) = delete;
+
+			[[nodiscard]]
+			bool load(FT_Library library, const void* data, size_t size, const Source& source);
+
+			[[nodiscard]]
+			FT_Face getFT_Face() const noexcept;
+
+		private:
+
+			FontFace m_fontFace;
+		};
+
+		SIV3D_NODISCARD_CXX20
+		explicit FontFacePool(const Source& source);
+
+		~FontFacePool();
+
+		/// @brief 使われていない複製を取り出します。無い場合は新しく作成します。
+		/// @return 複製。作成に失敗した場合は nullptr
+		[[nodiscard]]
+		std::unique_ptr<Face> acquire();
+
+		/// @brief 複製を返却します。
+		/// @param face 複製
+		/// @remark 取り出した複製は、破棄せずに必ず返却する必要があります。
+		void release(std::unique_ptr<Face> face);
+
+	private:
+
+		Source m_source;
+
+		std::mutex m_mutex;
+
+		/// @brief `m_source.data` が無い場合に読み込んだフォントデータ
+		Blob m_blob;
+
+		FT_Library m_library = nullptr;
+
+		// m_library と m_blob より先に破棄されるよう、後に宣言する
+		Array<std::unique_ptr<Face>> m_faces;
+
+		bool m_failed = false;
+
+		[[nodiscard]]
+		bool initLocked();
+	};
+}
@@ -15,6 +15,7 @@
 # include <Siv3D/System.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
+# include "../GlyphRenderer/BitmapGlyphRenderer.hpp"
 # include "BitmapGlyphCache.hpp"
 
 namespace s3d
@@ -66,7 +67,7 @@ namespace s3d
 
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = GetGlyphTextureRegion(m_buffer, cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -93,16 +94,13 @@ namespace s3d
 
 	bool BitmapGlyphCache::fits(const FontData& font, const StringView s, const Array<GlyphCluster>& clusters, const RectF& area, const double size, const double lineHeightScale)
 	{
-		if (not prerender(font, clusters, true))
-		{
-			return false;
-		}
-
 		// 「.」のグリフ
 		const Array<GlyphCluster> dotGlyphCluster = font.getGlyphClusters(U".", false, Ligature::Yes);
-		if (not prerender(font, dotGlyphCluster, true))
+
+		// 「.」のグリフをキャッシュするときに文字列のグリフのページが破棄されないよう、まとめてキャッシュする
+		if (not prerender(font, Array<GlyphCluster>{ clusters }.append(dotGlyphCluster), true))
 		{
-			// do nothing
+			return false;
 		}
 		updateTexture();
 
@@ -207,16 +205,13 @@ namespace s3d
 
 	bool BitmapGlyphCache::draw(const FontData& font, const StringView s, const Array<GlyphCluster>& clusters, const RectF& area, const double size, const TextStyle& textStyle, const ColorF& color, const double lineHeightScale)
 	{
-		if (not prerender(font, clusters, true))
-		{
-			return false;
-		}
-
 		// 「.」のグリフ
 		const Array<GlyphCluster> dotGlyphCluster = font.getGlyphClusters(U".", false, Ligature::Yes);
-		if (not prerender(font, dotGlyphCluster, true))
+
+		// 「.」のグリフをキャッシュするときに文字列のグリフのページが破棄されないよう、まとめてキャッシュする
+		if (not prerender(font, Array<GlyphCluster>{ clusters }.append(dotGlyphCluster), true))
 		{
-			// do nothing
+			return false;
 		}
 		updateTexture();
 
@@ -370,7 +365,7 @@ namespace s3d
 			{
 				const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 				{
-					const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+					const TextureRegion textureRegion = GetGlyphTextureRegion(m_buffer, cache);
 					const Vec2 posOffset = cache.info.getOffset(scale);
 					const Vec2 drawPos = (newPenPositions[i] + posOffset);
 
@@ -411,7 +406,7 @@ namespace s3d
 		{
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = GetGlyphTextureRegion(m_buffer, cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -598,11 +593,19 @@ namespace s3d
 		return prerender(font, font.getGlyphClusters(s, false, Ligature::Yes), true);
 	}
 
-	const Texture& BitmapGlyphCache::getTexture() noexcept
+	AsyncTask<bool> BitmapGlyphCache::preloadAsync(const FontData& font, const StringView s)
+	{
+		BeginGlyphCaching(m_buffer, m_glyphTable);
+		FlushPendingGlyphs(font.getProperty(), m_buffer, m_glyphTable);
+
+		return RenderGlyphsAsync(font, m_buffer, GetUncachedGlyphIndices(m_buffer, m_glyphTable, font.getGlyphClusters(s, false, Ligature::Yes), true), getRenderFunction());
+	}
+
+	const Texture& BitmapGlyphCache::getTexture(const size_t page)
 	{
 		updateTexture();
 
-		return m_texture;
+		return GetBufferTexture(m_buffer, page);
 	}
 
 	TextureRegion BitmapGlyphCache::getTextureRegion(const FontData& font, const GlyphIndex glyphIndex)
@@ -614,7 +617,22 @@ namespace s3d
 		updateTexture();
 
 		const auto& cache = m_glyphTable.find(glyphIndex)->second;
-		return m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+		return GetGlyphTextureRegion(m_buffer, cache);
+	}
+
+	void BitmapGlyphCache::setMaxPages(const size_t maxPages)
+	{
+		SetMaxBufferPages(m_buffer, m_glyphTable, maxPages);
+	}
+
+	size_t BitmapGlyphCache::getMaxPages() const noexcept
+	{
+		return m_buffer.maxPages;
+	}
+
+	GlyphCacheStats BitmapGlyphCache::getStats() const
+	{
+		return GetBufferStats(m_buffer, m_glyphTable);
 	}
 
 	int32 BitmapGlyphCache::getBufferThickness(const GlyphIndex)
@@ -624,43 +642,34 @@ namespace s3d
 
 	bool BitmapGlyphCache::prerender(const FontData& font, const Array<GlyphCluster>& clusters, const bool isMainFont)
 	{
+		BeginGlyphCaching(m_buffer, m_glyphTable);
+		FlushPendingGlyphs(font.getProperty(), m_buffer, m_glyphTable);
+
 		if (m_glyphTable.empty())
 		{
 			const BitmapGlyph glyph = font.renderBitmapByGlyphIndex(0);
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not CacheGlyph(font.getProperty(), glyph.image, glyph, m_buffer, m_glyphTable))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
-		for (const auto& cluster : clusters)
+		if (const Array<GlyphIndex> glyphIndices = GetUncachedGlyphIndices(m_buffer, m_glyphTable, clusters, isMainFont))
 		{
-			if (isMainFont && (cluster.fontIndex != 0))
+			// グリフのレンダリングはワーカースレッドで並列に行い、キャッシュへの書き込みはこのスレッドで行う
+			for (const auto& glyph : RenderGlyphs(font, glyphIndices, getRenderFunction()))
 			{
-				continue;
-			}
-
-			if (m_glyphTable.contains(cluster.glyphIndex))
-			{
-				continue;
-			}
-
-			const BitmapGlyph glyph = font.renderBitmapByGlyphIndex(cluster.glyphIndex);
-
-			if (m_glyphTable.contains(glyph.glyphIndex))
-			{
-				continue;
-			}
+				if (UseCachedGlyph(m_buffer, m_glyphTable, glyph.info.glyphIndex))
+				{
+					continue;
+				}
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
-			{
-				return false;
+				if (not CacheGlyph(font.getProperty(), glyph.image, glyph.info, m_buffer, m_glyphTable))
+				{
+					return false;
+				}
 			}
-
-			m_hasDirty = true;
 		}
 
 		// texture content can be updated in a different thread
@@ -672,22 +681,17 @@ namespace s3d
 		return true;
 	}
 
-	void BitmapGlyphCache::updateTexture()
+	GlyphRenderFunction BitmapGlyphCache::getRenderFunction() const
 	{
-		if (not m_hasDirty)
-		{
-			return;
-		}
-
-		if (m_texture.size() == m_buffer.image.size())
+		return [](const FT_Face face, const GlyphIndex glyphIndex, const FontFaceProperty& prop)
 		{
-			m_texture.fill(m_buffer.image);
-		}
-		else
-		{
-			m_texture = DynamicTexture{ m_buffer.image };
-		}
+			BitmapGlyph glyph = RenderBitmapGlyph(face, glyphIndex, prop);
+			return RenderedGlyph{ glyph, std::move(glyph.image) };
+		};
+	}
 
-		m_hasDirty = false;
+	void BitmapGlyphCache::updateTexture()
+	{
+		UpdateBufferTextures(m_buffer);
 	}
 }
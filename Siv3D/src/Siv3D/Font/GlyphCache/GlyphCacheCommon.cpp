@@ -9,10 +9,219 @@
 //
 //-----------------------------------------------
 
+# include <atomic>
+# include <future>
+# include <Siv3D/Scene.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/HashSet.hpp>
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ProfilerZone.hpp>
+# include <Siv3D/TaskScheduler/ITaskScheduler.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
 # include "GlyphCacheCommon.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		[[nodiscard]]
+		static Size GetBasePageSize(const int32 fontSize) noexcept
+		{
+			const int32 baseWidth =
+				fontSize <= 16 ? 512 :
+				fontSize <= 32 ? 768 :
+				fontSize <= 48 ? 1024 :
+				fontSize <= 64 ? 1536 :
+				fontSize <= 256 ? 2048 : 4096;
+			const int32 baseHeight = (fontSize <= 256 ? 256 : 512);
+			return{ baseWidth, baseHeight };
+		}
+
+		static void AddDirtyRect(BufferPage& page, const Rect& rect)
+		{
+			if (not page.dirtyRect.hasArea())
+			{
+				page.dirtyRect = rect;
+				return;
+			}
+
+			const int32 left	= Min(page.dirtyRect.x, rect.x);
+			const int32 top		= Min(page.dirtyRect.y, rect.y);
+			const int32 right	= Max((page.dirtyRect.x + page.dirtyRect.w), (rect.x + rect.w));
+			const int32 bottom	= Max((page.dirtyRect.y + page.dirtyRect.h), (rect.y + rect.h));
+			page.dirtyRect = Rect{ left, top, (right - left), (bottom - top) };
+		}
+
+		static void EvictPage(BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable, const size_t pageIndex)
+		{
+			BufferPage& page = buffer.pages[pageIndex];
+
+			for (const auto& glyphIndex : page.glyphs)
+			{
+				glyphTable.erase(glyphIndex);
+			}
+
+			page.glyphs.clear();
+			page.image.fill(buffer.backgroundColor);
+			page.penPos = { 0, buffer.padding };
+			page.currentMaxHeight = 0;
+			page.lastUsedBatch = 0;
+			page.lastDrawnFrame = -1;
+
+			++buffer.evictionCount;
+		}
+
+		/// @brief ページを破棄し、画像とテクスチャのメモリを解放します。
+		static void ReleasePage(BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable, const size_t pageIndex)
+		{
+			BufferPage& page = buffer.pages[pageIndex];
+
+			if (page.glyphs)
+			{
+				EvictPage(buffer, glyphTable, pageIndex);
+			}
+
+			page.image = Image{};
+			page.texture = DynamicTexture{};
+			page.dirtyRect = Rect{ 0, 0, 0, 0 };
+		}
+
+		/// @brief 上限を超えたページのうち、現在のフレームで描画に使われていないものを解放します。
+		static void TrimPages(BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable, const int32 frame)
+		{
+			for (size_t i = buffer.maxPages; i < buffer.pages.size(); ++i)
+			{
+				if (buffer.pages[i].lastDrawnFrame != frame)
+				{
+					ReleasePage(buffer, glyphTable, i);
+				}
+			}
+
+			// 末尾のページだけを取り除き、残るグリフのページ番号を保つ
+			while ((buffer.maxPages < buffer.pages.size()) && (not buffer.pages.back().image))
+			{
+				buffer.pages.pop_back();
+			}
+
+			if (buffer.maxPages <= buffer.currentPage)
+			{
+				buffer.currentPage = 0;
+			}
+		}
+
+		/// @brief ページが使用中であるかを返します。
+		/// @remark 現在の処理で使われたページは、これから描画するグリフを含み、現在のフレームで描画に使われたページは、描画コマンドから参照されています。
+		[[nodiscard]]
+		static bool IsPageInUse(const BufferImage& buffer, const BufferPage& page, const int32 frame) noexcept
+		{
+			return ((page.lastUsedBatch == buffer.currentBatch)
+				|| (page.lastDrawnFrame == frame));
+		}
+
+		/// @brief 新しいグリフを書き込むページを切り替えます。
+		/// @return 切り替えに成功した場合 true, すべてのページが使用中で、ページを追加できない場合は false
+		[[nodiscard]]
+		static bool AdvancePage(BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable, const int32 frame)
+		{
+			// 上限に達していなければ、未使用のページか新しいページを使う
+			for (size_t i = 0; i < Min(buffer.pages.size(), buffer.maxPages); ++i)
+			{
+				if ((i != buffer.currentPage) && buffer.pages[i].glyphs.isEmpty())
+				{
+					buffer.currentPage = i;
+					return true;
+				}
+			}
+
+			if (buffer.pages.size() < buffer.maxPages)
+			{
+				buffer.pages.emplace_back();
+				buffer.currentPage = (buffer.pages.size() - 1);
+				return true;
+			}
+
+			// 使用中でないページのうち、最も長く使われていないものを破棄する
+			Optional<size_t> lruIndex;
+
+			for (size_t i = 0; i < buffer.pages.size(); ++i)
+			{
+				const BufferPage& page = buffer.pages[i];
+
+				if (IsPageInUse(buffer, page, frame) || page.glyphs.isEmpty())
+				{
+					continue;
+				}
+
+				if ((not lruIndex) || (page.lastUsedBatch < buffer.pages[*lruIndex].lastUsedBatch))
+				{
+					lruIndex = i;
+				}
+			}
+
+			if (lruIndex)
+			{
+				EvictPage(buffer, glyphTable, *lruIndex);
+				buffer.currentPage = *lruIndex;
+				return true;
+			}
+
+			// すべてのページが使用中の場合は、上限を超えてページを追加する。
+			// 超えた分のページは、描画に使われなくなった後の BeginGlyphCaching() で解放される
+			for (size_t i = buffer.maxPages; i < buffer.pages.size(); ++i)
+			{
+				if ((i != buffer.currentPage) && buffer.pages[i].glyphs.isEmpty())
+				{
+					buffer.currentPage = i;
+					return true;
+				}
+			}
+
+			if (buffer.pages.size() < BufferImage::HardMaxPages)
+			{
+				buffer.pages.emplace_back();
+				buffer.currentPage = (buffer.pages.size() - 1);
+				return true;
+			}
+
+			LOG_FAIL(U"Font: All {} pages of the glyph cache are in use in the current frame"_fmt(buffer.pages.size()));
+			return false;
+		}
+
+		/// @brief フォントの複製を使ってグリフを並列にレンダリングします。
+		/// @return すべてのグリフのレンダリングに成功した場合 true, フォントの複製を作成できなかった場合は false
+		[[nodiscard]]
+		static bool RenderGlyphsParallel(FontFacePool& pool, const Array<GlyphIndex>& glyphIndices,
+			const GlyphRenderFunction& render, const FontFaceProperty& prop, Array<RenderedGlyph>& results)
+		{
+			results.resize(glyphIndices.size());
+
+			std::atomic<bool> failed{ false };
+
+			Threading::ParallelFor(0, glyphIndices.size(), [&](const size_t first, const size_t last)
+			{
+				SIV3D_PROFILE_ZONE(U"Font::renderGlyphRange");
+
+				std::unique_ptr<FontFacePool::Face> face = pool.acquire();
+
+				if (not face)
+				{
+					failed.store(true, std::memory_order_relaxed);
+					return;
+				}
+
+				for (size_t i = first; i < last; ++i)
+				{
+					results[i] = render(face->getFT_Face(), glyphIndices[i], prop);
+				}
+
+				pool.release(std::move(face));
+			});
+
+			return (not failed.load(std::memory_order_relaxed));
+		}
+	}
+
 	double GetTabAdvance(const double spaceWidth, const double scale, const double baseX, const double currentX, const int32 indentSize)
 	{
 		const double maxTabWidth = (spaceWidth * scale * indentSize);
@@ -53,59 +262,304 @@ namespace s3d
 		return true;
 	}
 
-	bool CacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo,
-		BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	void BeginGlyphCaching(BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable)
 	{
-		if (not buffer.image)
+		++buffer.currentBatch;
+
+		if (buffer.maxPages < buffer.pages.size())
 		{
-			const int32 fontSize = font.getProperty().fontPixelSize;
-			const int32 baseWidth =
-				fontSize <= 16 ? 512 :
-				fontSize <= 32 ? 768 :
-				fontSize <= 48 ? 1024 :
-				fontSize <= 64 ? 1536 :
-				fontSize <= 256 ? 2048 : 4096;
-			const int32 baseHeight = (fontSize <= 256 ? 256 : 512);
-			buffer.image.resize(baseWidth, baseHeight, buffer.backgroundColor);
+			detail::TrimPages(buffer, glyphTable, Scene::FrameCount());
+		}
+	}
+
+	bool UseCachedGlyph(BufferImage& buffer, const HashTable<GlyphIndex, GlyphCache>& glyphTable, const GlyphIndex glyphIndex)
+	{
+		const auto it = glyphTable.find(glyphIndex);
+
+		if (it == glyphTable.end())
+		{
+			return false;
 		}
 
-		buffer.penPos.x += buffer.padding;
+		buffer.pages[it->second.page].lastUsedBatch = buffer.currentBatch;
+		++buffer.hitCount;
+
+		return true;
+	}
+
+	Array<GlyphIndex> GetUncachedGlyphIndices(BufferImage& buffer, const HashTable<GlyphIndex, GlyphCache>& glyphTable, const Array<GlyphCluster>& clusters, const bool isMainFont)
+	{
+		Array<GlyphIndex> glyphIndices;
+		HashSet<GlyphIndex> added;
+
+		for (const auto& cluster : clusters)
+		{
+			if (isMainFont && (cluster.fontIndex != 0))
+			{
+				continue;
+			}
+
+			if (UseCachedGlyph(buffer, glyphTable, cluster.glyphIndex))
+			{
+				continue;
+			}
+
+			if (added.insert(cluster.glyphIndex).second)
+			{
+				glyphIndices << cluster.glyphIndex;
+			}
+		}
+
+		return glyphIndices;
+	}
+
+	Array<RenderedGlyph> RenderGlyphs(const FontData& font, const Array<GlyphIndex>& glyphIndices, const GlyphRenderFunction& render)
+	{
+		SIV3D_PROFILE_ZONE(U"Font::renderGlyphs");
+
+		Array<RenderedGlyph> results;
+
+		if ((ParallelGlyphRenderThreshold <= glyphIndices.size())
+			&& (0 < Threading::GetWorkerCount()))
+		{
+			if (const auto pool = font.getFacePool())
+			{
+				if (detail::RenderGlyphsParallel(*pool, glyphIndices, render, font.getProperty(), results))
+				{
+					return results;
+				}
+			}
+		}
+
+		// フォントの複製を作成できない場合は、メインスレッドで順番にレンダリングする
+		results.clear();
+		results.reserve(glyphIndices.size());
+
+		for (const auto& glyphIndex : glyphIndices)
+		{
+			results << render(font.getFT_Face(), glyphIndex, font.getProperty());
+		}
+
+		return results;
+	}
+
+	AsyncTask<bool> RenderGlyphsAsync(const FontData& font, const BufferImage& buffer, Array<GlyphIndex> glyphIndices, GlyphRenderFunction render)
+	{
+		auto promise = std::make_shared<std::promise<bool>>();
+		AsyncTask<bool> task{ promise->get_future() };
+
+		if (not glyphIndices)
+		{
+			promise->set_value(true);
+			return task;
+		}
+
+		std::shared_ptr<FontFacePool> pool = font.getFacePool();
+
+		if (not pool)
+		{
+			promise->set_value(false);
+			return task;
+		}
+
+		// タスクはフォントより長く生存することがあるため、必要なものはすべて値で保持する
+		SIV3D_ENGINE(TaskScheduler)->submit(
+			[promise, pool = std::move(pool), pending = buffer.pending, glyphIndices = std::move(glyphIndices), render = std::move(render), prop = font.getProperty()]()
+			{
+				SIV3D_PROFILE_ZONE(U"Font::renderGlyphsAsync");
+
+				Array<RenderedGlyph> results;
+
+				if (not detail::RenderGlyphsParallel(*pool, glyphIndices, render, prop, results))
+				{
+					promise->set_value(false);
+					return;
+				}
+
+				{
+					std::lock_guard lock{ pending->mutex };
+
+					pending->glyphs.insert(pending->glyphs.end(), std::make_move_iterator(results.begin()), std::make_move_iterator(results.end()));
+				}
+
+				promise->set_value(true);
+			});
+
+		return task;
+	}
+
+	void FlushPendingGlyphs(const FontFaceProperty& prop, BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		Array<RenderedGlyph> glyphs;
+		{
+			std::lock_guard lock{ buffer.pending->mutex };
+
+			if (not buffer.pending->glyphs)
+			{
+				return;
+			}
+
+			glyphs.swap(buffer.pending->glyphs);
+		}
+
+		for (auto it = glyphs.begin(); it != glyphs.end(); ++it)
+		{
+			if (glyphTable.contains(it->info.glyphIndex))
+			{
+				continue;
+			}
+
+			if (not CacheGlyph(prop, it->image, it->info, buffer, glyphTable))
+			{
+				// 書き込めなかったグリフは捨てずに、次の処理で書き込む
+				std::lock_guard lock{ buffer.pending->mutex };
+
+				buffer.pending->glyphs.insert(buffer.pending->glyphs.begin(), std::make_move_iterator(it), std::make_move_iterator(glyphs.end()));
+				return;
+			}
+		}
+	}
+
+	bool CacheGlyph(const FontFaceProperty& prop, const Image& image, const GlyphInfo& glyphInfo,
+		BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		const Size baseSize = detail::GetBasePageSize(prop.fontPixelSize);
+		const int32 maxPageHeight = Min((baseSize.x * 2), BufferImage::MaxImageHeight);
+		const int32 frame = Scene::FrameCount();
 
 		const int32 bitmapWidth		= image.width();
 		const int32 bitmapHeight	= image.height();
 
-		if (buffer.image.width() < (buffer.penPos.x + (bitmapWidth + buffer.padding)))
+		for (;;)
 		{
-			buffer.penPos.x = buffer.padding;
-			buffer.penPos.y += (buffer.currentMaxHeight + (buffer.padding * 2));
-			buffer.currentMaxHeight = 0;
+			BufferPage& page = buffer.pages[buffer.currentPage];
+
+			if (not page.image)
+			{
+				page.image.resize(baseSize, buffer.backgroundColor);
+				page.penPos = { 0, buffer.padding };
+				page.currentMaxHeight = 0;
+			}
+
+			Point penPos = page.penPos.movedBy(buffer.padding, 0);
+			int32 currentMaxHeight = page.currentMaxHeight;
+
+			if (page.image.width() < (penPos.x + (bitmapWidth + buffer.padding)))
+			{
+				penPos.x = buffer.padding;
+				penPos.y += (currentMaxHeight + (buffer.padding * 2));
+				currentMaxHeight = 0;
+			}
+
+			if (page.image.height() < (penPos.y + (bitmapHeight + buffer.padding)))
+			{
+				const int32 newHeight = ((penPos.y + (bitmapHeight + buffer.padding)) + 255) / 256 * 256;
+
+				if (maxPageHeight < newHeight)
+				{
+					// 空のページにも収まらないグリフ
+					if (page.glyphs.isEmpty())
+					{
+						return false;
+					}
+
+					if (not detail::AdvancePage(buffer, glyphTable, frame))
+					{
+						return false;
+					}
+
+					continue;
+				}
+
+				page.image.resizeRows(newHeight, buffer.backgroundColor);
+			}
+
+			image.overwrite(page.image, penPos);
+
+			GlyphCache cache;
+			cache.info					= glyphInfo;
+			cache.textureRegionLeft		= static_cast<int16>(penPos.x);
+			cache.textureRegionTop		= static_cast<int16>(penPos.y);
+			cache.textureRegionWidth	= static_cast<int16>(bitmapWidth);
+			cache.textureRegionHeight	= static_cast<int16>(bitmapHeight);
+			cache.page					= static_cast<uint16>(buffer.currentPage);
+			glyphTable.emplace(glyphInfo.glyphIndex, cache);
+
+			// 余白も含めて転送し、破棄されたページの古い内容が残らないようにする
+			detail::AddDirtyRect(page, Rect{ (penPos.x - buffer.padding), (penPos.y - buffer.padding),
+				(bitmapWidth + buffer.padding * 2), (bitmapHeight + buffer.padding * 2) });
+
+			page.glyphs << glyphInfo.glyphIndex;
+			page.lastUsedBatch = buffer.currentBatch;
+			page.currentMaxHeight = Max(currentMaxHeight, bitmapHeight);
+			page.penPos = penPos.movedBy((bitmapWidth + buffer.padding), 0);
+			++buffer.missCount;
+
+			return true;
 		}
+	}
 
-		if (buffer.image.height() < (buffer.penPos.y + (bitmapHeight + buffer.padding)))
+	void UpdateBufferTextures(BufferImage& buffer)
+	{
+		for (auto& page : buffer.pages)
 		{
-			const int32 newHeight = ((buffer.penPos.y + (bitmapHeight + buffer.padding)) + 255) / 256 * 256;
+			if (not page.image)
+			{
+				continue;
+			}
 
-			if (BufferImage::MaxImageHeight < newHeight)
+			if (page.texture.size() != page.image.size())
 			{
-				return false;
+				page.texture = DynamicTexture{ page.image };
+				buffer.uploadedPixels += page.image.num_pixels();
 			}
+			else if (page.dirtyRect.hasArea())
+			{
+				page.texture.fillRegion(page.image, page.dirtyRect);
+				buffer.uploadedPixels += (static_cast<uint64>(page.dirtyRect.w) * page.dirtyRect.h);
+			}
+
+			page.dirtyRect = Rect{ 0, 0, 0, 0 };
+		}
+	}
 
-			buffer.image.resizeRows(newHeight, buffer.backgroundColor);
+	const Texture& GetBufferTexture(const BufferImage& buffer, const size_t page)
+	{
+		if (buffer.pages.size() <= page)
+		{
+			static const Texture emptyTexture;
+			return emptyTexture;
 		}
 
-		image.overwrite(buffer.image, buffer.penPos);
+		return buffer.pages[page].texture;
+	}
 
-		GlyphCache cache;
-		cache.info					= glyphInfo;
-		cache.textureRegionLeft		= static_cast<int16>(buffer.penPos.x);
-		cache.textureRegionTop		= static_cast<int16>(buffer.penPos.y);
-		cache.textureRegionWidth	= static_cast<int16>(bitmapWidth);
-		cache.textureRegionHeight	= static_cast<int16>(bitmapHeight);
-		glyphTable.emplace(glyphInfo.glyphIndex, cache);
+	TextureRegion GetGlyphTextureRegion(BufferImage& buffer, const GlyphCache& cache)
+	{
+		BufferPage& page = buffer.pages[cache.page];
+		page.lastDrawnFrame = Scene::FrameCount();
 
-		buffer.currentMaxHeight = Max(buffer.currentMaxHeight, bitmapHeight);
-		buffer.penPos.x += (bitmapWidth + buffer.padding);
+		return page.texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+	}
 
-		return true;
+	void SetMaxBufferPages(BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable, const size_t maxPages)
+	{
+		buffer.maxPages = Clamp<size_t>(maxPages, 1, BufferImage::HardMaxPages);
+
+		// 現在のフレームで描画に使われたページは、次のフレーム以降に解放する
+		detail::TrimPages(buffer, glyphTable, Scene::FrameCount());
+	}
+
+	GlyphCacheStats GetBufferStats(const BufferImage& buffer, const HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		GlyphCacheStats stats;
+		stats.pageCount			= buffer.pages.count_if([](const BufferPage& page) { return static_cast<bool>(page.image); });
+		stats.maxPageCount		= buffer.maxPages;
+		stats.glyphCount		= glyphTable.size();
+		stats.hitCount			= buffer.hitCount;
+		stats.missCount			= buffer.missCount;
+		stats.evictionCount		= buffer.evictionCount;
+		stats.uploadedPixels	= buffer.uploadedPixels;
+		return stats;
 	}
 }
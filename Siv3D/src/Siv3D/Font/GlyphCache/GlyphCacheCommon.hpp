@@ -10,11 +10,18 @@
 //-----------------------------------------------
 
 # pragma once
+# include <memory>
+# include <mutex>
+# include <functional>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/GlyphInfo.hpp>
 # include <Siv3D/Image.hpp>
 # include <Siv3D/HashTable.hpp>
 # include <Siv3D/Char.hpp>
+# include <Siv3D/DynamicTexture.hpp>
+# include <Siv3D/TextureRegion.hpp>
+# include <Siv3D/GlyphCacheStats.hpp>
+# include <Siv3D/AsyncTask.hpp>
 # include "../FontData.hpp"
 
 namespace s3d
@@ -30,13 +37,65 @@ namespace s3d
 		int16 textureRegionWidth = 0;
 
 		int16 textureRegionHeight = 0;
+
+		/// @brief グリフが格納されているページのインデックス
+		uint16 page = 0;
+	};
+
+	/// @brief レンダリングされたグリフ
+	struct RenderedGlyph
+	{
+		GlyphInfo info;
+
+		Image image;
+	};
+
+	/// @brief グリフをレンダリングする関数。ワーカースレッドから同時に呼ばれることがあります。
+	using GlyphRenderFunction = std::function<RenderedGlyph(FT_Face face, GlyphIndex glyphIndex, const FontFaceProperty& prop)>;
+
+	/// @brief ワーカースレッドでレンダリングされ、キャッシュへの書き込みを待っているグリフ
+	struct PendingGlyphs
+	{
+		std::mutex mutex;
+
+		Array<RenderedGlyph> glyphs;
+	};
+
+	/// @brief グリフキャッシュのテクスチャの 1 ページ
+	struct BufferPage
+	{
+		Image image;
+
+		DynamicTexture texture;
+
+		Point penPos = { 0, 0 };
+
+		int32 currentMaxHeight = 0;
+
+		/// @brief テクスチャに未転送の領域
+		Rect dirtyRect = { 0, 0, 0, 0 };
+
+		/// @brief ページが最後に使われた処理の番号
+		uint64 lastUsedBatch = 0;
+
+		/// @brief ページが最後に描画に使われたフレーム
+		int32 lastDrawnFrame = -1;
+
+		/// @brief ページに格納されているグリフ
+		Array<GlyphIndex> glyphs;
 	};
 
 	struct BufferImage
 	{
 		static constexpr int32 MaxImageHeight = 4096;
 
-		Image image;
+		/// @brief ページ数の上限のデフォルト値
+		static constexpr size_t DefaultMaxPages = 4;
+
+		/// @brief 使用中のページを破棄できない場合に、一時的に許容するページ数の上限
+		static constexpr size_t HardMaxPages = 64;
+
+		Array<BufferPage> pages = Array<BufferPage>(1);
 
 		Color backgroundColor{ 255, 0 };
 
@@ -44,18 +103,84 @@ namespace s3d
 
 		int32 padding = 1;
 
-		Point penPos = { 0, padding };
+		/// @brief 新しいグリフを書き込むページ
+		size_t currentPage = 0;
 
-		int32 currentMaxHeight = 0;
+		size_t maxPages = DefaultMaxPages;
+
+		/// @brief `BeginGlyphCaching()` のたびに増える処理の番号
+		uint64 currentBatch = 0;
+
+		uint64 hitCount = 0;
+
+		uint64 missCount = 0;
+
+		uint64 evictionCount = 0;
+
+		uint64 uploadedPixels = 0;
+
+		std::shared_ptr<PendingGlyphs> pending = std::make_shared<PendingGlyphs>();
 	};
 
+	/// @brief この数以上のグリフをまとめてレンダリングする場合、ワーカースレッドで並列に処理します。
+	inline constexpr size_t ParallelGlyphRenderThreshold = 8;
+
 	[[nodiscard]]
 	double GetTabAdvance(double spaceWidth, double scale, double baseX, double currentX, int32 indentSize);
 
 	[[nodiscard]]
 	bool ProcessControlCharacter(char32 ch, Vec2& penPos, int32& line, const Vec2& basePos, double scale, double lineHeightScale, const FontFaceProperty& prop);
 
+	/// @brief グリフをキャッシュする一連の処理を開始します。
+	/// @remark 上限を超えて追加されたページのうち、現在のフレームで描画に使われていないものを解放します。
+	void BeginGlyphCaching(BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+	/// @brief キャッシュ済みのグリフを探し、見つかった場合はそのページを使用中にします。
+	/// @return グリフがキャッシュされている場合 true, それ以外の場合は false
+	[[nodiscard]]
+	bool UseCachedGlyph(BufferImage& buffer, const HashTable<GlyphIndex, GlyphCache>& glyphTable, GlyphIndex glyphIndex);
+
+	/// @brief キャッシュされていないグリフのインデックスを重複なく返します。キャッシュされているグリフのページは使用中にします。
+	[[nodiscard]]
+	Array<GlyphIndex> GetUncachedGlyphIndices(BufferImage& buffer, const HashTable<GlyphIndex, GlyphCache>& glyphTable, const Array<GlyphCluster>& clusters, bool isMainFont);
+
+	/// @brief グリフをレンダリングします。グリフが多い場合はワーカースレッドで並列に処理します。
 	[[nodiscard]]
-	bool CacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo,
+	Array<RenderedGlyph> RenderGlyphs(const FontData& font, const Array<GlyphIndex>& glyphIndices, const GlyphRenderFunction& render);
+
+	/// @brief グリフをワーカースレッドでレンダリングし、結果を `buffer.pending` に追加します。
+	/// @remark キャッシュへの書き込みとテクスチャの更新は、メインスレッドで `FlushPendingGlyphs()` を呼んだときに行われます。
+	/// @return レンダリングが完了すると true を返すタスク。フォントの複製を作成できなかった場合は false
+	[[nodiscard]]
+	AsyncTask<bool> RenderGlyphsAsync(const FontData& font, const BufferImage& buffer, Array<GlyphIndex> glyphIndices, GlyphRenderFunction render);
+
+	/// @brief 非同期にレンダリングされたグリフをキャッシュに書き込みます。
+	/// @remark 書き込めなかったグリフは、次の処理で再び書き込みを試みます。
+	void FlushPendingGlyphs(const FontFaceProperty& prop, BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+	/// @brief グリフをキャッシュに書き込みます。
+	/// @remark 空きが無い場合は、使用中でないページのうち最も長く使われていないものを破棄して再利用します。
+	/// 使用中のページとは、現在の処理で使われたページと、現在のフレームで描画に使われたページです。
+	/// すべてのページが使用中の場合は、`BufferImage::HardMaxPages` まで一時的にページを追加します。
+	[[nodiscard]]
+	bool CacheGlyph(const FontFaceProperty& prop, const Image& image, const GlyphInfo& glyphInfo,
 		BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+	/// @brief 変更されたページの領域をテクスチャに転送します。
+	void UpdateBufferTextures(BufferImage& buffer);
+
+	/// @brief 指定したページのテクスチャを返します。
+	/// @return ページのテクスチャ。ページが存在しない場合は空のテクスチャ
+	[[nodiscard]]
+	const Texture& GetBufferTexture(const BufferImage& buffer, size_t page);
+
+	/// @brief グリフのテクスチャ領域を返し、そのページを現在のフレームで描画に使われたものとします。
+	[[nodiscard]]
+	TextureRegion GetGlyphTextureRegion(BufferImage& buffer, const GlyphCache& cache);
+
+	/// @brief ページ数の上限を設定し、上限を超えたページのうち現在のフレームで描画に使われていないものを解放します。
+	void SetMaxBufferPages(BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable, size_t maxPages);
+
+	[[nodiscard]]
+	GlyphCacheStats GetBufferStats(const BufferImage& buffer, const HashTable<GlyphIndex, GlyphCache>& glyphTable);
 }
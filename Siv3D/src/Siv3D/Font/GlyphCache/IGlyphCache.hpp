@@ -14,6 +14,8 @@
 # include <Siv3D/2DShapes.hpp>
 # include <Siv3D/Texture.hpp>
 # include <Siv3D/Font.hpp>
+# include <Siv3D/GlyphCacheStats.hpp>
+# include <Siv3D/AsyncTask.hpp>
 # include "../FontData.hpp"
 
 namespace s3d
@@ -50,13 +52,25 @@ namespace s3d
 
 		virtual bool preload(const FontData& font, StringView s) = 0;
 
+		/// @brief グリフをワーカースレッドでレンダリングします。キャッシュへの書き込みは、次にメインスレッドでグリフが必要になったときに行われます。
 		[[nodiscard]]
-		virtual const Texture& getTexture() noexcept = 0;
+		virtual AsyncTask<bool> preloadAsync(const FontData& font, StringView s) = 0;
+
+		[[nodiscard]]
+		virtual const Texture& getTexture(size_t page) = 0;
 
 		[[nodiscard]]
 		virtual TextureRegion getTextureRegion(const FontData& font, GlyphIndex glyphIndex) = 0;
 
 		[[nodiscard]]
 		virtual int32 getBufferThickness(GlyphIndex glyphIndex) = 0;
+
+		virtual void setMaxPages(size_t maxPages) = 0;
+
+		[[nodiscard]]
+		virtual size_t getMaxPages() const noexcept = 0;
+
+		[[nodiscard]]
+		virtual GlyphCacheStats getStats() const = 0;
 	};
 }
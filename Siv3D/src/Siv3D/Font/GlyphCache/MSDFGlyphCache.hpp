@@ -53,7 +53,10 @@ namespace s3d
 		bool preload(const FontData & font, StringView s) override;
 
 		[[nodiscard]]
-		const Texture& getTexture() noexcept override;
+		AsyncTask<bool> preloadAsync(const FontData& font, StringView s) override;
+
+		[[nodiscard]]
+		const Texture& getTexture(size_t page) override;
 
 		[[nodiscard]]
 		TextureRegion getTextureRegion(const FontData& font, GlyphIndex glyphIndex) override;
@@ -61,21 +64,28 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness(GlyphIndex glyphIndex) override;
 
+		void setMaxPages(size_t maxPages) override;
+
+		[[nodiscard]]
+		size_t getMaxPages() const noexcept override;
+
+		[[nodiscard]]
+		GlyphCacheStats getStats() const override;
+
 	private:
 
 		static constexpr int32 DefaultBuffer = 2;
 
 		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
 
-		DynamicTexture m_texture;
-
-		bool m_hasDirty = false;
-
-		BufferImage m_buffer = { .image = {}, .backgroundColor = Color{ 0, 0 } };
+		BufferImage m_buffer = { .backgroundColor = Color{ 0, 0 } };
 
 		[[nodiscard]]
 		bool prerender(const FontData& font, const Array<GlyphCluster>& clusters, bool isMainFont);
 
 		void updateTexture();
+
+		[[nodiscard]]
+		GlyphRenderFunction getRenderFunction() const;
 	};
 }
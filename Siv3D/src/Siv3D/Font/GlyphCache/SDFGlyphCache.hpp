@@ -53,7 +53,10 @@ namespace s3d
 		bool preload(const FontData& font, StringView s) override;
 
 		[[nodiscard]]
-		const Texture& getTexture() noexcept override;
+		AsyncTask<bool> preloadAsync(const FontData& font, StringView s) override;
+
+		[[nodiscard]]
+		const Texture& getTexture(size_t page) override;
 
 		[[nodiscard]]
 		TextureRegion getTextureRegion(const FontData& font, GlyphIndex glyphIndex) override;
@@ -61,13 +64,17 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness(GlyphIndex glyphIndex) override;
 
-	private:
+		void setMaxPages(size_t maxPages) override;
 
-		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
+		[[nodiscard]]
+		size_t getMaxPages() const noexcept override;
 
-		DynamicTexture m_texture;
+		[[nodiscard]]
+		GlyphCacheStats getStats() const override;
 
-		bool m_hasDirty = false;
+	private:
+
+		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
 
 		BufferImage m_buffer = {};
 	
@@ -75,5 +82,8 @@ namespace s3d
 		bool prerender(const FontData& font, const Array<GlyphCluster>& clusters, bool isMainFont);
 
 		void updateTexture();
+
+		[[nodiscard]]
+		GlyphRenderFunction getRenderFunction() const;
 	};
 }
@@ -48,6 +48,12 @@ namespace s3d
 
 		virtual int32 getBufferThickness(Font::IDType handleID) = 0;
 
+		virtual void setMaxGlyphCachePages(Font::IDType handleID, size_t maxPages) = 0;
+
+		virtual size_t getMaxGlyphCachePages(Font::IDType handleID) = 0;
+
+		virtual GlyphCacheStats getGlyphCacheStats(Font::IDType handleID) = 0;
+
 		virtual bool hasGlyph(Font::IDType handleID, StringView ch) = 0;
 
 		virtual GlyphIndex getGlyphIndex(Font::IDType handleID, StringView ch) = 0;
@@ -84,7 +90,9 @@ namespace s3d
 
 		virtual bool preload(Font::IDType handleID, StringView chars) = 0;
 
-		virtual const Texture& getTexture(Font::IDType handleID) = 0;
+		virtual AsyncTask<bool> preloadAsync(Font::IDType handleID, StringView chars) = 0;
+
+		virtual const Texture& getTexture(Font::IDType handleID, size_t page) = 0;
 
 		virtual Glyph getGlyph(Font::IDType handleID, StringView ch) = 0;
 
@@ -235,6 +235,23 @@ namespace s3d
 		return SIV3D_ENGINE(Font)->getBufferThickness(m_handle->id());
 	}
 
+	const Font& Font::setMaxGlyphCachePages(const size_t maxPages) const
+	{
+		SIV3D_ENGINE(Font)->setMaxGlyphCachePages(m_handle->id(), maxPages);
+
+		return *this;
+	}
+
+	size_t Font::getMaxGlyphCachePages() const
+	{
+		return SIV3D_ENGINE(Font)->getMaxGlyphCachePages(m_handle->id());
+	}
+
+	GlyphCacheStats Font::getGlyphCacheStats() const
+	{
+		return SIV3D_ENGINE(Font)->getGlyphCacheStats(m_handle->id());
+	}
+
 	bool Font::hasGlyph(const char32 ch) const
 	{
 		return SIV3D_ENGINE(Font)->hasGlyph(m_handle->id(), StringView(&ch, 1));
@@ -398,9 +415,19 @@ namespace s3d
 		return SIV3D_ENGINE(Font)->preload(m_handle->id(), chars);
 	}
 
+	AsyncTask<bool> Font::preloadAsync(const StringView chars) const
+	{
+		return SIV3D_ENGINE(Font)->preloadAsync(m_handle->id(), chars);
+	}
+
 	const Texture& Font::getTexture() const
 	{
-		return SIV3D_ENGINE(Font)->getTexture(m_handle->id());
+		return SIV3D_ENGINE(Font)->getTexture(m_handle->id(), 0);
+	}
+
+	const Texture& Font::getTexture(const size_t page) const
+	{
+		return SIV3D_ENGINE(Font)->getTexture(m_handle->id(), page);
 	}
 
 	Glyph Font::getGlyph(const char32 ch) const
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/FontAssetData.hpp>
+# include <Siv3D/Asset/AssetReload.hpp>
 
 namespace s3d
 {
@@ -32,39 +33,12 @@ namespace s3d
 
 	bool FontAssetData::load(const String& hint)
 	{
-		if (isUninitialized())
-		{
-			if (onLoad(*this, hint))
-			{
-				setState(AssetState::Loaded);
-				return true;
-			}
-			else
-			{
-				setState(AssetState::Failed);
-				return false;
-			}
-		}
-
-		if (isAsyncLoading())
-		{
-			wait();
-		}
-
-		return isLoaded();
+		return loadImpl(m_task, [this, &hint]() { return onLoad(*this, hint); });
 	}
 
 	void FontAssetData::loadAsync(const String& hint)
 	{
-		if (isUninitialized())
-		{
-			setState(AssetState::AsyncLoading);
-
-			m_task = Async([this, hint = hint]()
-				{
-					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
-				});
-		}
+		loadAsyncImpl(m_task, [this, hint = hint]() { return onLoad(*this, hint); });
 	}
 
 	void FontAssetData::wait()
@@ -77,19 +51,30 @@ namespace s3d
 
 	void FontAssetData::release()
 	{
-		if (isUninitialized())
-		{
-			return;
-		}
+		releaseImpl(m_task, [this]() { onRelease(*this); });
+	}
 
-		if (isAsyncLoading())
+	Array<FilePath> FontAssetData::getSourcePaths() const
+	{
+		if (not path)
 		{
-			wait();
+			return{};
 		}
 
-		onRelease(*this);
+		return{ path };
+	}
 
-		setState(AssetState::Uninitialized);
+	std::function<void()> FontAssetData::prepareReload(const String& hint)
+	{
+		auto staging = std::make_shared<FontAssetData>();
+		staging->fontMethod = fontMethod;
+		staging->fontSize = fontSize;
+		staging->path = path;
+		staging->faceIndex = faceIndex;
+		staging->typeface = typeface;
+		staging->style = style;
+
+		return detail::PrepareReload(*this, std::move(staging), &FontAssetData::font, hint);
 	}
 
 	bool FontAssetData::DefaultLoad(FontAssetData& asset, const String& hint)
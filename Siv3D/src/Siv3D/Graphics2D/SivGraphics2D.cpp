@@ -136,6 +136,26 @@ namespace s3d
 			SIV3D_ENGINE(Renderer2D)->addNullVertices(count * 3);
 		}
 
+		void DrawRects(const Array<RectF>& rects, const ColorF& color)
+		{
+			SIV3D_ENGINE(Renderer2D)->addRects(rects.data(), nullptr, rects.size(), color.toFloat4());
+		}
+
+		void DrawRects(const Array<RectF>& rects, const Array<ColorF>& colors)
+		{
+			SIV3D_ENGINE(Renderer2D)->addRects(rects.data(), colors.data(), Min(rects.size(), colors.size()), Float4{ 1.0f, 1.0f, 1.0f, 1.0f });
+		}
+
+		void DrawCircles(const Array<Circle>& circles, const ColorF& color)
+		{
+			SIV3D_ENGINE(Renderer2D)->addCircles(circles.data(), nullptr, circles.size(), color.toFloat4());
+		}
+
+		void DrawCircles(const Array<Circle>& circles, const Array<ColorF>& colors)
+		{
+			SIV3D_ENGINE(Renderer2D)->addCircles(circles.data(), colors.data(), Min(circles.size(), colors.size()), Float4{ 1.0f, 1.0f, 1.0f, 1.0f });
+		}
+
 		void SetSDFParameters(const TextStyle& textStyle)
 		{
 			Float4 param = textStyle.param;
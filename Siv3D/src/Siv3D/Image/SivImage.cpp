@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/Image.hpp>
+# include <Siv3D/ImageOps.hpp>
 # include <Siv3D/ImageROI.hpp>
 # include <Siv3D/Emoji.hpp>
 # include <Siv3D/Icon.hpp>
@@ -56,39 +57,6 @@ namespace s3d
 			return (px * py * (c1 - c2 - c3 + c4) + px * (c2 - c1) + py * (c3 - c1) + c1);
 		}
 
-		[[nodiscard]]
-		static Color MakeSepia(Color color) noexcept
-		{
-			const double tr = Min(((0.393 * color.r) + (0.769 * color.g) + (0.189 * color.b)), 255.0);
-			const double tg = Min(((0.349 * color.r) + (0.686 * color.g) + (0.168 * color.b)), 255.0);
-			const double tb = Min(((0.272 * color.r) + (0.534 * color.g) + (0.131 * color.b)), 255.0);
-
-			color.r = static_cast<uint8>(tr);
-			color.g = static_cast<uint8>(tg);
-			color.b = static_cast<uint8>(tb);
-			return color;
-		}
-
-		static void InitPosterizeTable(const int32 level, uint8 table[256]) noexcept
-		{
-			const int32 levN = Clamp(level, 2, 256) - 1;
-
-			for (size_t i = 0; i < 256; ++i)
-			{
-				table[i] = static_cast<uint8>(std::floor(i / 255.0 * levN + 0.5) / levN * 255);
-			}
-		}
-
-		static void InitGammmaTable(const double gamma, uint8 table[256])
-		{
-			const double gammaInv = (1.0 / gamma);
-
-			for (size_t i = 0; i < 256; ++i)
-			{
-				table[i] = static_cast<uint8>(std::pow(i / 255.0, gammaInv) * 255.0);
-			}
-		}
-
 		static Color GetAverage(const Image& src, const Rect& rect)
 		{
 			const int32 count = rect.area();
@@ -936,46 +904,14 @@ namespace s3d
 
 	Image& Image::negate()
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			for (auto& pixel : m_data)
-			{
-				pixel = ~pixel;
-			}
-		}
+		ImageOps{}.negate().apply(*this);
 
 		return *this;
 	}
 
 	Image Image::negated() const&
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			Image image{ *this };
-
-			for (auto& pixel : image)
-			{
-				pixel = ~pixel;
-			}
-
-			return image;
-		}
+		return ImageOps{}.negate().applied(*this);
 	}
 
 	Image Image::negated() &&
@@ -985,52 +921,14 @@ namespace s3d
 
 	Image& Image::grayscale()
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			for (auto& pixel : m_data)
-			{
-				const uint8 gray = pixel.grayscale0_255();
-				pixel.r = gray;
-				pixel.g = gray;
-				pixel.b = gray;
-			}
-		}
+		ImageOps{}.grayscale().apply(*this);
 
 		return *this;
 	}
 
 	Image Image::grayscaled() const&
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			Image image{ *this };
-
-			for (auto& pixel : image)
-			{
-				const uint8 gray = pixel.grayscale0_255();
-				pixel.r = gray;
-				pixel.g = gray;
-				pixel.b = gray;
-			}
-
-			return image;
-		}
+		return ImageOps{}.grayscale().applied(*this);
 	}
 
 	Image Image::grayscaled() &&
@@ -1040,46 +938,14 @@ namespace s3d
 
 	Image& Image::sepia()
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			for (auto& pixel : m_data)
-			{
-				pixel = detail::MakeSepia(pixel);
-			}
-		}
+		ImageOps{}.sepia().apply(*this);
 
 		return *this;
 	}
 
 	Image Image::sepiaed() const&
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			Image image{ *this };
-
-			for (auto& pixel : image)
-			{
-				pixel = detail::MakeSepia(pixel);
-			}
-
-			return image;
-		}
+		return ImageOps{}.sepia().applied(*this);
 	}
 
 	Image Image::sepiaed() &&
@@ -1089,56 +955,14 @@ namespace s3d
 
 	Image& Image::posterize(const int32 level)
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			uint8 colorTable[256];
-			detail::InitPosterizeTable(level, colorTable);
-
-			for (auto& pixel : m_data)
-			{
-				pixel.r = colorTable[pixel.r];
-				pixel.g = colorTable[pixel.g];
-				pixel.b = colorTable[pixel.b];
-			}
-		}
+		ImageOps{}.posterize(level).apply(*this);
 
 		return *this;
 	}
 
 	Image Image::posterized(const int32 level) const&
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			Image image{ *this };
-
-			uint8 colorTable[256];
-			detail::InitPosterizeTable(level, colorTable);
-
-			for (auto& pixel : image)
-			{
-				pixel.r = colorTable[pixel.r];
-				pixel.g = colorTable[pixel.g];
-				pixel.b = colorTable[pixel.b];
-			}
-
-			return image;
-		}
+		return ImageOps{}.posterize(level).applied(*this);
 	}
 
 	Image Image::posterized(const int32 level) &&
@@ -1148,74 +972,14 @@ namespace s3d
 
 	Image& Image::brighten(const int32 level)
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			if (level < 0)
-			{
-				for (auto& pixel : m_data)
-				{
-					pixel.r = static_cast<uint8>(Max(static_cast<int32>(pixel.r) + level, 0));
-					pixel.g = static_cast<uint8>(Max(static_cast<int32>(pixel.g) + level, 0));
-					pixel.b = static_cast<uint8>(Max(static_cast<int32>(pixel.b) + level, 0));
-				}
-			}
-			else if (level > 0)
-			{
-				for (auto& pixel : m_data)
-				{
-					pixel.r = static_cast<uint8>(Min(static_cast<int32>(pixel.r) + level, 255));
-					pixel.g = static_cast<uint8>(Min(static_cast<int32>(pixel.g) + level, 255));
-					pixel.b = static_cast<uint8>(Min(static_cast<int32>(pixel.b) + level, 255));
-				}
-			}
-		}
+		ImageOps{}.brighten(level).apply(*this);
 
 		return *this;
 	}
 
 	Image Image::brightened(const int32 level) const&
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			Image image{ *this };
-
-			if (level < 0)
-			{
-				for (auto& pixel : image)
-				{
-					pixel.r = static_cast<uint8>(Max(static_cast<int32>(pixel.r) + level, 0));
-					pixel.g = static_cast<uint8>(Max(static_cast<int32>(pixel.g) + level, 0));
-					pixel.b = static_cast<uint8>(Max(static_cast<int32>(pixel.b) + level, 0));
-				}
-			}
-			else if (level > 0)
-			{
-				for (auto& pixel : image)
-				{
-					pixel.r = static_cast<uint8>(Min(static_cast<int32>(pixel.r) + level, 255));
-					pixel.g = static_cast<uint8>(Min(static_cast<int32>(pixel.g) + level, 255));
-					pixel.b = static_cast<uint8>(Min(static_cast<int32>(pixel.b) + level, 255));
-				}
-			}
-
-			return image;
-		}
+		return ImageOps{}.brighten(level).applied(*this);
 	}
 
 	Image Image::brightened(const int32 level) &&
@@ -1792,56 +1556,14 @@ namespace s3d
 
 	Image& Image::gammaCorrect(const double gamma)
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			uint8 colorTable[256];
-			detail::InitGammmaTable(gamma, colorTable);
-
-			for (auto& pixel : m_data)
-			{
-				pixel.r = colorTable[pixel.r];
-				pixel.g = colorTable[pixel.g];
-				pixel.b = colorTable[pixel.b];
-			}
-		}
+		ImageOps{}.gammaCorrect(gamma).apply(*this);
 
 		return *this;
 	}
 
 	Image Image::gammaCorrected(const double gamma) const&
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			Image image{ *this };
-
-			uint8 colorTable[256];
-			detail::InitGammmaTable(gamma, colorTable);
-
-			for (auto& pixel : image)
-			{
-				pixel.r = colorTable[pixel.r];
-				pixel.g = colorTable[pixel.g];
-				pixel.b = colorTable[pixel.b];
-			}
-
-			return image;
-		}
+		return ImageOps{}.gammaCorrect(gamma).applied(*this);
 	}
 
 	Image Image::gammaCorrected(const double gamma) &&
@@ -1851,110 +1573,14 @@ namespace s3d
 
 	Image& Image::threshold(const uint8 threshold, const InvertColor invertColor)
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			Color* pDst = data();
-			const Color* pDstEnd = pDst + num_pixels();
-			const double thresholdF = (threshold / 255.0);
-
-			if (invertColor)
-			{
-				while (pDst != pDstEnd)
-				{
-					if (thresholdF < pDst->grayscale())
-					{
-						pDst->setRGB(0);
-					}
-					else
-					{
-						pDst->setRGB(255);
-					}
-
-					++pDst;
-				}
-			}
-			else
-			{
-				while (pDst != pDstEnd)
-				{
-					if (thresholdF < pDst->grayscale())
-					{
-						pDst->setRGB(255);
-					}
-					else
-					{
-						pDst->setRGB(0);
-					}
-
-					++pDst;
-				}
-			}
-		}
+		ImageOps{}.threshold(threshold, invertColor).apply(*this);
 
 		return *this;
 	}
 
 	Image Image::thresholded(const uint8 threshold, const InvertColor invertColor) const&
 	{
-		// 1. パラメータチェック
-		{
-			if (isEmpty())
-			{
-				return *this;
-			}
-		}
-
-		// 2. 処理
-		{
-			Image image{ *this };
-
-			Color* pDst = image.data();
-			const Color* pDstEnd = pDst + num_pixels();
-			const double thresholdF = (threshold / 255.0);
-
-			if (invertColor)
-			{
-				while (pDst != pDstEnd)
-				{
-					if (thresholdF < pDst->grayscale())
-					{
-						pDst->setRGB(0);
-					}
-					else
-					{
-						pDst->setRGB(255);
-					}
-
-					++pDst;
-				}
-			}
-			else
-			{
-				while (pDst != pDstEnd)
-				{
-					if (thresholdF < pDst->grayscale())
-					{
-						pDst->setRGB(255);
-					}
-					else
-					{
-						pDst->setRGB(0);
-					}
-
-					++pDst;
-				}
-			}
-
-			return image;
-		}
+		return ImageOps{}.threshold(threshold, invertColor).applied(*this);
 	}
 
 	Image Image::thresholded(const uint8 threshold, const InvertColor invertColor) &&
@@ -3353,88 +2979,21 @@ namespace s3d
 
 	ImageROI& ImageROI::sepia()
 	{
-		if (isEmpty())
-		{
-			return *this;
-		}
-
-		const size_t imageWidth = imageRef.width();
-		Color* pLine = &imageRef[region.y][region.x];
-
-		for (int32 y = 0; y < region.h; ++y)
-		{
-			Color* p = pLine;
-
-			for (int32 x = 0; x < region.w; ++x)
-			{
-				*p = detail::MakeSepia(*p);
-				++p;
-			}
-
-			pLine += imageWidth;
-		}
+		ImageOps{}.sepia().apply(*this);
 
 		return *this;
 	}
 
 	ImageROI& ImageROI::posterize(const int32 level)
 	{
-		if (isEmpty())
-		{
-			return *this;
-		}
-
-		uint8 colorTable[256];
-		detail::InitPosterizeTable(level, colorTable);
-
-		const size_t imageWidth = imageRef.width();
-		Color* pLine = &imageRef[region.y][region.x];
-
-		for (int32 y = 0; y < region.h; ++y)
-		{
-			Color* p = pLine;
-
-			for (int32 x = 0; x < region.w; ++x)
-			{
-				p->r = colorTable[p->r];
-				p->g = colorTable[p->g];
-				p->b = colorTable[p->b];
-				++p;
-			}
-
-			pLine += imageWidth;
-		}
+		ImageOps{}.posterize(level).apply(*this);
 
 		return *this;
 	}
 
 	ImageROI& ImageROI::gammaCorrect(const double gamma)
 	{
-		if (isEmpty())
-		{
-			return *this;
-		}
-
-		uint8 colorTable[256];
-		detail::InitGammmaTable(gamma, colorTable);
-
-		const size_t imageWidth = imageRef.width();
-		Color* pLine = &imageRef[region.y][region.x];
-
-		for (int32 y = 0; y < region.h; ++y)
-		{
-			Color* p = pLine;
-
-			for (int32 x = 0; x < region.w; ++x)
-			{
-				p->r = colorTable[p->r];
-				p->g = colorTable[p->g];
-				p->b = colorTable[p->b];
-				++p;
-			}
-
-			pLine += imageWidth;
-		}
+		ImageOps{}.gammaCorrect(gamma).apply(*this);
 
 		return *this;
 	}
@@ -0,0 +1,446 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cmath>
+# include <Siv3D/ImageOps.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/ImageROI.hpp>
+# include <Siv3D/SIMD.hpp>
+# include <Siv3D/Threading.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 並列処理を行うピクセル数の下限
+		static constexpr size_t ParallelImageOpsThreshold = (256 * 1024);
+
+		/// @brief 1 回の走査で処理するピクセル数。すべての段の処理がキャッシュに収まるようにする
+		static constexpr size_t ImageOpsTilePixels = (16 * 1024);
+
+		// Color::grayscale0_255() と同じ係数
+		static constexpr double GrayR = 0.299;
+		static constexpr double GrayG = 0.587;
+		static constexpr double GrayB = 0.114;
+
+		// Color::grayscale() と同じ係数
+		static constexpr double GrayNormR = (0.299 / 255.0);
+		static constexpr double GrayNormG = (0.587 / 255.0);
+		static constexpr double GrayNormB = (0.114 / 255.0);
+
+		[[nodiscard]]
+		inline Color MakeSepia(Color color) noexcept
+		{
+			const double tr = Min(((0.393 * color.r) + (0.769 * color.g) + (0.189 * color.b)), 255.0);
+			const double tg = Min(((0.349 * color.r) + (0.686 * color.g) + (0.168 * color.b)), 255.0);
+			const double tb = Min(((0.272 * color.r) + (0.534 * color.g) + (0.131 * color.b)), 255.0);
+
+			color.r = static_cast<uint8>(tr);
+			color.g = static_cast<uint8>(tg);
+			color.b = static_cast<uint8>(tb);
+			return color;
+		}
+
+		static void Table_Reference(const Color* pSrc, Color* pDst, const size_t count, const uint8* table) noexcept
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Color src = pSrc[i];
+				pDst[i] = Color{ table[src.r], table[src.g], table[src.b], src.a };
+			}
+		}
+
+		static void Grayscale_Reference(const Color* pSrc, Color* pDst, const size_t count) noexcept
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Color src = pSrc[i];
+				const uint8 gray = src.grayscale0_255();
+				pDst[i] = Color{ gray, gray, gray, src.a };
+			}
+		}
+
+		static void Sepia_Reference(const Color* pSrc, Color* pDst, const size_t count) noexcept
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				pDst[i] = MakeSepia(pSrc[i]);
+			}
+		}
+
+		static void Threshold_Reference(const Color* pSrc, Color* pDst, const size_t count, const uint8 threshold, const bool invertColor) noexcept
+		{
+			const double thresholdF = (threshold / 255.0);
+			const uint8 above = (invertColor ? 0 : 255);
+			const uint8 below = (invertColor ? 255 : 0);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Color src = pSrc[i];
+				const uint8 value = ((thresholdF < src.grayscale()) ? above : below);
+				pDst[i] = Color{ value, value, value, src.a };
+			}
+		}
+
+	# if SIV3D_INTRINSIC(SSE)
+
+		// Image のメンバ関数と結果を一致させるため、double で同じ順序で計算する
+
+		struct RGB4
+		{
+			__m128d r0, r1, g0, g1, b0, b1;
+
+			__m128i alpha;
+		};
+
+		[[nodiscard]]
+		inline RGB4 LoadRGB4(const Color* p) noexcept
+		{
+			const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const __m128i mask = _mm_set1_epi32(0xFF);
+
+			const __m128i r = _mm_and_si128(pixels, mask);
+			const __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 8), mask);
+			const __m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 16), mask);
+
+			return{
+				_mm_cvtepi32_pd(r), _mm_cvtepi32_pd(_mm_unpackhi_epi64(r, r)),
+				_mm_cvtepi32_pd(g), _mm_cvtepi32_pd(_mm_unpackhi_epi64(g, g)),
+				_mm_cvtepi32_pd(b), _mm_cvtepi32_pd(_mm_unpackhi_epi64(b, b)),
+				_mm_andnot_si128(_mm_set1_epi32(0x00FFFFFF), pixels) };
+		}
+
+		[[nodiscard]]
+		inline __m128d WeightedSum(const __m128d r, const __m128d g, const __m128d b, const __m128d wr, const __m128d wg, const __m128d wb) noexcept
+		{
+			return _mm_add_pd(_mm_add_pd(_mm_mul_pd(wr, r), _mm_mul_pd(wg, g)), _mm_mul_pd(wb, b));
+		}
+
+		/// @brief 2 組の double を切り捨てて 4 つの int32 にまとめる
+		[[nodiscard]]
+		inline __m128i TruncateToInt32x4(const __m128d lo, const __m128d hi) noexcept
+		{
+			return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+		}
+
+		[[nodiscard]]
+		inline __m128i MakeRGB(const __m128i r, const __m128i g, const __m128i b, const __m128i alpha) noexcept
+		{
+			return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(b, 16), alpha));
+		}
+
+		static void Grayscale_SSE2(const Color* pSrc, Color* pDst, const size_t count) noexcept
+		{
+			const __m128d wr = _mm_set1_pd(GrayR);
+			const __m128d wg = _mm_set1_pd(GrayG);
+			const __m128d wb = _mm_set1_pd(GrayB);
+
+			size_t i = 0;
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const RGB4 c = LoadRGB4(pSrc + i);
+				const __m128i gray = TruncateToInt32x4(WeightedSum(c.r0, c.g0, c.b0, wr, wg, wb), WeightedSum(c.r1, c.g1, c.b1, wr, wg, wb));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), MakeRGB(gray, gray, gray, c.alpha));
+			}
+
+			Grayscale_Reference((pSrc + i), (pDst + i), (count - i));
+		}
+
+		static void Sepia_SSE2(const Color* pSrc, Color* pDst, const size_t count) noexcept
+		{
+			const __m128d max = _mm_set1_pd(255.0);
+
+			size_t i = 0;
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const RGB4 c = LoadRGB4(pSrc + i);
+
+				const auto channel = [&](const double wr, const double wg, const double wb)
+				{
+					const __m128d r = _mm_set1_pd(wr), g = _mm_set1_pd(wg), b = _mm_set1_pd(wb);
+					return TruncateToInt32x4(_mm_min_pd(WeightedSum(c.r0, c.g0, c.b0, r, g, b), max),
+						_mm_min_pd(WeightedSum(c.r1, c.g1, c.b1, r, g, b), max));
+				};
+
+				const __m128i tr = channel(0.393, 0.769, 0.189);
+				const __m128i tg = channel(0.349, 0.686, 0.168);
+				const __m128i tb = channel(0.272, 0.534, 0.131);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), MakeRGB(tr, tg, tb, c.alpha));
+			}
+
+			Sepia_Reference((pSrc + i), (pDst + i), (count - i));
+		}
+
+		static void Threshold_SSE2(const Color* pSrc, Color* pDst, const size_t count, const uint8 threshold, const bool invertColor) noexcept
+		{
+			const __m128d wr = _mm_set1_pd(GrayNormR);
+			const __m128d wg = _mm_set1_pd(GrayNormG);
+			const __m128d wb = _mm_set1_pd(GrayNormB);
+			const __m128d thresholdF = _mm_set1_pd(threshold / 255.0);
+			const __m128i invert = (invertColor ? _mm_set1_epi32(0x00FFFFFF) : _mm_setzero_si128());
+			const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+
+			size_t i = 0;
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const RGB4 c = LoadRGB4(pSrc + i);
+
+				// 64 ビットの比較結果の下位 32 ビットを集める
+				const __m128i above0 = _mm_castpd_si128(_mm_cmplt_pd(thresholdF, WeightedSum(c.r0, c.g0, c.b0, wr, wg, wb)));
+				const __m128i above1 = _mm_castpd_si128(_mm_cmplt_pd(thresholdF, WeightedSum(c.r1, c.g1, c.b1, wr, wg, wb)));
+				const __m128i above = _mm_unpacklo_epi64(_mm_shuffle_epi32(above0, _MM_SHUFFLE(3, 1, 2, 0)), _mm_shuffle_epi32(above1, _MM_SHUFFLE(3, 1, 2, 0)));
+
+				const __m128i rgb = _mm_xor_si128(_mm_and_si128(above, rgbMask), invert);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_or_si128(rgb, c.alpha));
+			}
+
+			Threshold_Reference((pSrc + i), (pDst + i), (count - i), threshold, invertColor);
+		}
+
+	# endif
+	}
+
+	ImageOps& ImageOps::negate()
+	{
+		std::array<uint8, 256> table;
+
+		for (size_t i = 0; i < 256; ++i)
+		{
+			table[i] = static_cast<uint8>(~i);
+		}
+
+		addTable(table);
+
+		return *this;
+	}
+
+	ImageOps& ImageOps::grayscale()
+	{
+		m_stages.push_back(Stage{ .type = StageType::Grayscale });
+
+		return *this;
+	}
+
+	ImageOps& ImageOps::sepia()
+	{
+		m_stages.push_back(Stage{ .type = StageType::Sepia });
+
+		return *this;
+	}
+
+	ImageOps& ImageOps::posterize(const int32 level)
+	{
+		const int32 levN = Clamp(level, 2, 256) - 1;
+		std::array<uint8, 256> table;
+
+		for (size_t i = 0; i < 256; ++i)
+		{
+			table[i] = static_cast<uint8>(std::floor(i / 255.0 * levN + 0.5) / levN * 255);
+		}
+
+		addTable(table);
+
+		return *this;
+	}
+
+	ImageOps& ImageOps::brighten(const int32 level)
+	{
+		if (level == 0)
+		{
+			return *this;
+		}
+
+		std::array<uint8, 256> table;
+
+		for (int32 i = 0; i < 256; ++i)
+		{
+			table[i] = static_cast<uint8>(Clamp((i + level), 0, 255));
+		}
+
+		addTable(table);
+
+		return *this;
+	}
+
+	ImageOps& ImageOps::gammaCorrect(const double gamma)
+	{
+		const double gammaInv = (1.0 / gamma);
+		std::array<uint8, 256> table;
+
+		for (size_t i = 0; i < 256; ++i)
+		{
+			table[i] = static_cast<uint8>(std::pow(i / 255.0, gammaInv) * 255.0);
+		}
+
+		addTable(table);
+
+		return *this;
+	}
+
+	ImageOps& ImageOps::threshold(const uint8 threshold, const InvertColor invertColor)
+	{
+		m_stages.push_back(Stage{ .type = StageType::Threshold, .threshold = threshold, .invertColor = invertColor.getBool() });
+
+		return *this;
+	}
+
+	bool ImageOps::isEmpty() const noexcept
+	{
+		return m_stages.isEmpty();
+	}
+
+	size_t ImageOps::num_stages() const noexcept
+	{
+		return m_stages.size();
+	}
+
+	void ImageOps::clear()
+	{
+		m_stages.clear();
+	}
+
+	void ImageOps::apply(Image& image) const
+	{
+		apply(image, image);
+	}
+
+	void ImageOps::apply(const Image& src, Image& dst) const
+	{
+		if (&src != &dst)
+		{
+			dst.resize(src.size());
+		}
+
+		if (src.isEmpty())
+		{
+			return;
+		}
+
+		const Color* const pSrc = src.data();
+		Color* const pDst = dst.data();
+
+		// タイルごとに、すべての段を続けて適用する
+		const auto processTiles = [&](const size_t first, const size_t last)
+		{
+			for (size_t tileBegin = first; tileBegin < last; tileBegin += detail::ImageOpsTilePixels)
+			{
+				const size_t count = Min((last - tileBegin), detail::ImageOpsTilePixels);
+				applyStages((pSrc + tileBegin), (pDst + tileBegin), count);
+			}
+		};
+
+		const size_t num_pixels = src.num_pixels();
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if ((detail::ParallelImageOpsThreshold <= num_pixels) && (0 < Threading::GetWorkerCount()))
+		{
+			Threading::ParallelFor(0, num_pixels, processTiles, detail::ImageOpsTilePixels);
+			return;
+		}
+
+	# endif
+
+		processTiles(0, num_pixels);
+	}
+
+	void ImageOps::apply(const ImageROI& roi) const
+	{
+		if (roi.isEmpty() || m_stages.isEmpty())
+		{
+			return;
+		}
+
+		// 領域の各行は連続しているので、行ごとに適用する
+		const size_t imageWidth = roi.imageRef.width();
+		Color* pLine = &roi.imageRef[roi.region.y][roi.region.x];
+
+		for (int32 y = 0; y < roi.region.h; ++y)
+		{
+			applyStages(pLine, pLine, static_cast<size_t>(roi.region.w));
+			pLine += imageWidth;
+		}
+	}
+
+	Image ImageOps::applied(const Image& src) const
+	{
+		Image image;
+
+		apply(src, image);
+
+		return image;
+	}
+
+	void ImageOps::addTable(const std::array<uint8, 256>& table)
+	{
+		// 直前の段もルックアップテーブルであれば合成する
+		if ((not m_stages.isEmpty()) && (m_stages.back().type == StageType::Table))
+		{
+			auto& previous = m_stages.back().table;
+
+			for (auto& value : previous)
+			{
+				value = table[value];
+			}
+
+			return;
+		}
+
+		m_stages.push_back(Stage{ .type = StageType::Table, .table = table });
+	}
+
+	void ImageOps::applyStages(const Color* pIn, Color* const pOut, const size_t count) const
+	{
+		if (m_stages.isEmpty() && (pIn != pOut))
+		{
+			std::memcpy(pOut, pIn, (count * sizeof(Color)));
+			return;
+		}
+
+		for (const auto& stage : m_stages)
+		{
+			switch (stage.type)
+			{
+			case StageType::Table:
+				detail::Table_Reference(pIn, pOut, count, stage.table.data());
+				break;
+			case StageType::Grayscale:
+			# if SIV3D_INTRINSIC(SSE)
+				detail::Grayscale_SSE2(pIn, pOut, count);
+			# else
+				detail::Grayscale_Reference(pIn, pOut, count);
+			# endif
+				break;
+			case StageType::Sepia:
+			# if SIV3D_INTRINSIC(SSE)
+				detail::Sepia_SSE2(pIn, pOut, count);
+			# else
+				detail::Sepia_Reference(pIn, pOut, count);
+			# endif
+				break;
+			case StageType::Threshold:
+			# if SIV3D_INTRINSIC(SSE)
+				detail::Threshold_SSE2(pIn, pOut, count, stage.threshold, stage.invertColor);
+			# else
+				detail::Threshold_Reference(pIn, pOut, count, stage.threshold, stage.invertColor);
+			# endif
+				break;
+			}
+
+			// 2 段目以降は出力先で上書きする
+			pIn = pOut;
+		}
+	}
+}
@@ -0,0 +1,627 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cmath>
+# include <array>
+# include <Siv3D/CPUInfo.hpp>
+# include <Siv3D/SIMD.hpp>
+# include <Siv3D/SIMD_Float4.hpp>
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/MathConstants.hpp>
+# include "MipmapGenerator.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 並列処理を行う出力ピクセル数の下限
+		static constexpr size_t ParallelMipThreshold = (128 * 1024);
+
+		/// @brief 1 つのタスクで処理する出力ピクセル数の目安
+		static constexpr size_t MipTilePixels = (32 * 1024);
+
+		/// @brief カイザーフィルタの半径（出力ピクセル単位）
+		static constexpr double KaiserWidth = 3.0;
+
+		/// @brief カイザー窓の形状パラメータ
+		static constexpr double KaiserAlpha = 4.0;
+
+		/// @brief sRGB とリニアの変換テーブル
+		class SRGBTable
+		{
+		public:
+
+			SRGBTable()
+			{
+				for (int32 i = 0; i < 256; ++i)
+				{
+					m_toLinear[i] = static_cast<float>(ToLinear(i / 255.0));
+
+					// 量子化後の値が i と i + 1 の中間となるリニアの値
+					m_boundaries[i] = ((i < 255) ? static_cast<float>(ToLinear((i + 0.5) / 255.0)) : Math::InfF);
+				}
+
+				for (int32 i = 0, c = 0; i <= CoarseSize; ++i)
+				{
+					const float linear = (static_cast<float>(i) / CoarseSize);
+
+					while (m_boundaries[c] <= linear)
+					{
+						++c;
+					}
+
+					m_coarse[i] = static_cast<uint8>(c);
+				}
+			}
+
+			[[nodiscard]]
+			float toLinear(const uint8 value) const noexcept
+			{
+				return m_toLinear[value];
+			}
+
+			/// @brief リニアの値を、最も近い 8 ビットの sRGB の値に変換します。
+			[[nodiscard]]
+			uint8 toSRGB(float linear) const noexcept
+			{
+				linear = Clamp(linear, 0.0f, 1.0f);
+
+				// 粗いテーブルで候補を求め、境界値との比較で補正する
+				uint32 c = m_coarse[static_cast<uint32>(linear * CoarseSize)];
+
+				while (m_boundaries[c] <= linear)
+				{
+					++c;
+				}
+
+				return static_cast<uint8>(c);
+			}
+
+		private:
+
+			static constexpr int32 CoarseSize = 4096;
+
+			float m_toLinear[256];
+
+			float m_boundaries[256];
+
+			uint8 m_coarse[CoarseSize + 1];
+
+			[[nodiscard]]
+			static double ToLinear(const double c) noexcept
+			{
+				return ((c <= 0.04045) ? (c / 12.92) : std::pow(((c + 0.055) / 1.055), 2.4));
+			}
+		};
+
+		[[nodiscard]]
+		static const SRGBTable& GetSRGBTable()
+		{
+			static const SRGBTable table;
+			return table;
+		}
+
+		/// @brief 1 次元の縮小フィルタ
+		/// @remark 出力の 1 ピクセルあたり width 個のタップを持ち、入力のインデックスは端でクランプ済みです。
+		struct MipFilter1D
+		{
+			int32 width = 0;
+
+			Array<int32> indices;
+
+			Array<float> weights;
+		};
+
+		[[nodiscard]]
+		static double BesselI0(const double x) noexcept
+		{
+			const double q = (x * x * 0.25);
+			double sum = 1.0;
+			double term = 1.0;
+
+			for (int32 k = 1; k < 64; ++k)
+			{
+				term *= (q / (k * k));
+				sum += term;
+
+				if (term < (sum * 1e-12))
+				{
+					break;
+				}
+			}
+
+			return sum;
+		}
+
+		/// @brief カイザー窓を掛けた sinc 関数
+		/// @param t 出力ピクセル単位の距離
+		[[nodiscard]]
+		static double Kaiser(const double t) noexcept
+		{
+			if (KaiserWidth <= Abs(t))
+			{
+				return 0.0;
+			}
+
+			const double x = (t / KaiserWidth);
+			const double window = (BesselI0(KaiserAlpha * std::sqrt(1.0 - x * x)) / BesselI0(KaiserAlpha));
+			const double sinc = ((t == 0.0) ? 1.0 : (std::sin(Math::Pi * t) / (Math::Pi * t)));
+
+			return (sinc * window);
+		}
+
+		[[nodiscard]]
+		static MipFilter1D MakeMipFilter(const int32 srcSize, const int32 dstSize, const MipmapFilter filter)
+		{
+			const double scale = (static_cast<double>(srcSize) / dstSize);
+
+			Array<Array<std::pair<int32, double>>> taps(dstSize);
+
+			for (int32 x = 0; x < dstSize; ++x)
+			{
+				auto& dstTaps = taps[x];
+
+				if (scale <= 1.0)
+				{
+					dstTaps.emplace_back(Min(x, (srcSize - 1)), 1.0);
+				}
+				else if (filter == MipmapFilter::Box)
+				{
+					// 出力ピクセルが覆う入力の範囲 [begin, end) の面積平均
+					const double begin = (x * scale);
+					const double end = ((x + 1) * scale);
+
+					for (int32 s = static_cast<int32>(std::floor(begin)); s < static_cast<int32>(std::ceil(end)); ++s)
+					{
+						if (const double w = (Min(end, (s + 1.0)) - Max(begin, static_cast<double>(s)));
+							1e-6 < w)
+						{
+							dstTaps.emplace_back(Min(s, (srcSize - 1)), w);
+						}
+					}
+				}
+				else
+				{
+					const double center = (((x + 0.5) * scale) - 0.5);
+					const double radius = (KaiserWidth * scale);
+
+					for (int32 s = static_cast<int32>(std::ceil(center - radius)); s <= static_cast<int32>(std::floor(center + radius)); ++s)
+					{
+						if (const double w = Kaiser((s - center) / scale);
+							w != 0.0)
+						{
+							dstTaps.emplace_back(Clamp(s, 0, (srcSize - 1)), w);
+						}
+					}
+				}
+			}
+
+			MipFilter1D result;
+
+			for (const auto& dstTaps : taps)
+			{
+				result.width = Max(result.width, static_cast<int32>(dstTaps.size()));
+			}
+
+			result.indices.resize(dstSize * static_cast<size_t>(result.width));
+			result.weights.resize(dstSize * static_cast<size_t>(result.width));
+
+			for (int32 x = 0; x < dstSize; ++x)
+			{
+				const auto& dstTaps = taps[x];
+				int32* pIndex = (result.indices.data() + (x * static_cast<size_t>(result.width)));
+				float* pWeight = (result.weights.data() + (x * static_cast<size_t>(result.width)));
+
+				double sum = 0.0;
+
+				for (const auto& tap : dstTaps)
+				{
+					sum += tap.second;
+				}
+
+				for (int32 k = 0; k < result.width; ++k)
+				{
+					if (k < static_cast<int32>(dstTaps.size()))
+					{
+						pIndex[k] = dstTaps[k].first;
+						pWeight[k] = static_cast<float>(dstTaps[k].second / sum);
+					}
+					else
+					{
+						// タップ数をそろえるための重み 0 のタップ
+						pIndex[k] = dstTaps.back().first;
+						pWeight[k] = 0.0f;
+					}
+				}
+			}
+
+			return result;
+		}
+
+		static void DecodeRow(const Color* pSrc, const int32 width, Float4* pDst, const SRGBTable* sRGB) noexcept
+		{
+			constexpr float Inv255 = (1.0f / 255.0f);
+
+			if (sRGB)
+			{
+				for (int32 x = 0; x < width; ++x)
+				{
+					const Color c = pSrc[x];
+					pDst[x] = { sRGB->toLinear(c.r), sRGB->toLinear(c.g), sRGB->toLinear(c.b), (c.a * Inv255) };
+				}
+			}
+			else
+			{
+				for (int32 x = 0; x < width; ++x)
+				{
+					const Color c = pSrc[x];
+					pDst[x] = { (c.r * Inv255), (c.g * Inv255), (c.b * Inv255), (c.a * Inv255) };
+				}
+			}
+		}
+
+		[[nodiscard]]
+		static uint8 ToUnorm8(const float value) noexcept
+		{
+			return static_cast<uint8>(Clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+		}
+
+		[[nodiscard]]
+		static Color EncodePixel(const Float4& value, const SRGBTable* sRGB) noexcept
+		{
+			if (sRGB)
+			{
+				return{ sRGB->toSRGB(value.x), sRGB->toSRGB(value.y), sRGB->toSRGB(value.z), ToUnorm8(value.w) };
+			}
+			else
+			{
+				return{ ToUnorm8(value.x), ToUnorm8(value.y), ToUnorm8(value.z), ToUnorm8(value.w) };
+			}
+		}
+
+		/// @brief 任意のフィルタで出力の [dstY0, dstY1) 行を作成します。
+		/// @remark 必要な入力の行を横方向にフィルタしてから、縦方向にフィルタします。
+		static void GenerateMipRows_Filter(const Image& src, Image& dst, const MipFilter1D& filterX, const MipFilter1D& filterY,
+			const SRGBTable* sRGB, const int32 dstY0, const int32 dstY1)
+		{
+			const int32 srcWidth = src.width();
+			const int32 dstWidth = dst.width();
+
+			int32 rowMin = Largest<int32>;
+			int32 rowMax = 0;
+
+			for (size_t i = (dstY0 * static_cast<size_t>(filterY.width)); i < (dstY1 * static_cast<size_t>(filterY.width)); ++i)
+			{
+				rowMin = Min(rowMin, filterY.indices[i]);
+				rowMax = Max(rowMax, filterY.indices[i]);
+			}
+
+			Array<Float4> decoded(srcWidth);
+			Array<Float4> rows(static_cast<size_t>(rowMax - rowMin + 1) * dstWidth);
+
+			for (int32 y = rowMin; y <= rowMax; ++y)
+			{
+				DecodeRow(src[y], srcWidth, decoded.data(), sRGB);
+
+				Float4* pDst = (rows.data() + (static_cast<size_t>(y - rowMin) * dstWidth));
+
+				for (int32 x = 0; x < dstWidth; ++x)
+				{
+					const int32* pIndex = (filterX.indices.data() + (x * static_cast<size_t>(filterX.width)));
+					const float* pWeight = (filterX.weights.data() + (x * static_cast<size_t>(filterX.width)));
+
+					SIMD_Float4 sum = SIMD_Float4::Zero();
+
+					for (int32 k = 0; k < filterX.width; ++k)
+					{
+						sum += (SIMD_Float4{ decoded[pIndex[k]] } * pWeight[k]);
+					}
+
+					pDst[x] = sum.toFloat4();
+				}
+			}
+
+			Array<const Float4*> pRows(filterY.width);
+
+			for (int32 y = dstY0; y < dstY1; ++y)
+			{
+				const int32* pIndex = (filterY.indices.data() + (y * static_cast<size_t>(filterY.width)));
+				const float* pWeight = (filterY.weights.data() + (y * static_cast<size_t>(filterY.width)));
+
+				for (int32 k = 0; k < filterY.width; ++k)
+				{
+					pRows[k] = (rows.data() + (static_cast<size_t>(pIndex[k] - rowMin) * dstWidth));
+				}
+
+				Color* pDst = dst[y];
+
+				for (int32 x = 0; x < dstWidth; ++x)
+				{
+					SIMD_Float4 sum = SIMD_Float4::Zero();
+
+					for (int32 k = 0; k < filterY.width; ++k)
+					{
+						sum += (SIMD_Float4{ pRows[k][x] } * pWeight[k]);
+					}
+
+					pDst[x] = EncodePixel(sum.toFloat4(), sRGB);
+				}
+			}
+		}
+
+		static void BoxDownsample2x2_Reference(const Color* pSrc0, const Color* pSrc1, Color* pDst, const int32 dstWidth) noexcept
+		{
+			for (int32 x = 0; x < dstWidth; ++x)
+			{
+				const Color c0 = pSrc0[x * 2];
+				const Color c1 = pSrc0[x * 2 + 1];
+				const Color c2 = pSrc1[x * 2];
+				const Color c3 = pSrc1[x * 2 + 1];
+
+				pDst[x].set(static_cast<uint8>((c0.r + c1.r + c2.r + c3.r + 2) >> 2),
+					static_cast<uint8>((c0.g + c1.g + c2.g + c3.g + 2) >> 2),
+					static_cast<uint8>((c0.b + c1.b + c2.b + c3.b + 2) >> 2),
+					static_cast<uint8>((c0.a + c1.a + c2.a + c3.a + 2) >> 2));
+			}
+		}
+
+		static void BoxDownsample2x2_SRGB(const Color* pSrc0, const Color* pSrc1, Color* pDst, const int32 dstWidth, const SRGBTable& table) noexcept
+		{
+			for (int32 x = 0; x < dstWidth; ++x)
+			{
+				const Color c0 = pSrc0[x * 2];
+				const Color c1 = pSrc0[x * 2 + 1];
+				const Color c2 = pSrc1[x * 2];
+				const Color c3 = pSrc1[x * 2 + 1];
+
+				pDst[x].set(table.toSRGB((table.toLinear(c0.r) + table.toLinear(c1.r) + table.toLinear(c2.r) + table.toLinear(c3.r)) * 0.25f),
+					table.toSRGB((table.toLinear(c0.g) + table.toLinear(c1.g) + table.toLinear(c2.g) + table.toLinear(c3.g)) * 0.25f),
+					table.toSRGB((table.toLinear(c0.b) + table.toLinear(c1.b) + table.toLinear(c2.b) + table.toLinear(c3.b)) * 0.25f),
+					static_cast<uint8>((c0.a + c1.a + c2.a + c3.a + 2) >> 2));
+			}
+		}
+
+	# if SIV3D_INTRINSIC(SSE)
+
+		static void BoxDownsample2x2_SSE4_1(const Color* pSrc0, const Color* pSrc1, Color* pDst, const int32 dstWidth) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i two = _mm_set1_epi16(2);
+
+			int32 x = 0;
+
+			// 入力の 2 行 x 8 ピクセルから、出力の 4 ピクセルを作成する
+			for (; (x + 4) <= dstWidth; x += 4)
+			{
+				const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + x * 2));
+				const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + x * 2 + 4));
+				const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + x * 2));
+				const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + x * 2 + 4));
+
+				// 上下の行を 16 ビットで加算する
+				const __m128i s0 = _mm_add_epi16(_mm_cvtepu8_epi16(a0), _mm_cvtepu8_epi16(b0)); // SSE4.1
+				const __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+				const __m128i s2 = _mm_add_epi16(_mm_cvtepu8_epi16(a1), _mm_cvtepu8_epi16(b1)); // SSE4.1
+				const __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+				// 左右のピクセルを加算する
+				const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+				const __m128i hi = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+
+				const __m128i result = _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(lo, two), 2), _mm_srli_epi16(_mm_add_epi16(hi, two), 2));
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + x), result);
+			}
+
+			BoxDownsample2x2_Reference((pSrc0 + x * 2), (pSrc1 + x * 2), (pDst + x), (dstWidth - x));
+		}
+
+	# endif
+
+		/// @brief 幅と高さがちょうど半分になる場合のボックスフィルタで、出力の [dstY0, dstY1) 行を作成します。
+		static void GenerateMipRows_Box2x2(const Image& src, Image& dst, const SRGBTable* sRGB, const int32 dstY0, const int32 dstY1)
+		{
+			const int32 dstWidth = dst.width();
+
+			if (sRGB)
+			{
+				for (int32 y = dstY0; y < dstY1; ++y)
+				{
+					BoxDownsample2x2_SRGB(src[y * 2], src[y * 2 + 1], dst[y], dstWidth, *sRGB);
+				}
+
+				return;
+			}
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				for (int32 y = dstY0; y < dstY1; ++y)
+				{
+					BoxDownsample2x2_SSE4_1(src[y * 2], src[y * 2 + 1], dst[y], dstWidth);
+				}
+
+				return;
+			}
+
+		# endif
+
+			for (int32 y = dstY0; y < dstY1; ++y)
+			{
+				BoxDownsample2x2_Reference(src[y * 2], src[y * 2 + 1], dst[y], dstWidth);
+			}
+		}
+
+		/// @brief 出力の行をタイルに分割し、大きな画像では並列に処理します。
+		template <class Fty>
+		static void ForEachRowTile(const int32 width, const int32 height, Fty f)
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			if (((static_cast<size_t>(width) * height) >= ParallelMipThreshold) && (0 < Threading::GetWorkerCount()))
+			{
+				const size_t tileRows = Max<size_t>(1, (MipTilePixels / width));
+
+				Threading::ParallelFor(0, static_cast<size_t>(height), [&](const size_t first, const size_t last)
+				{
+					f(static_cast<int32>(first), static_cast<int32>(last));
+				}, tileRows);
+
+				return;
+			}
+
+		# endif
+
+			f(0, height);
+		}
+
+		Image GenerateMip(const Image& src, const MipmapConfig& config)
+		{
+			if (not src)
+			{
+				return{};
+			}
+
+			const int32 srcWidth = src.width();
+			const int32 srcHeight = src.height();
+			const int32 dstWidth = Max((srcWidth / 2), 1);
+			const int32 dstHeight = Max((srcHeight / 2), 1);
+
+			Image dst(dstWidth, dstHeight);
+
+			const SRGBTable* sRGB = (config.sRGB ? &GetSRGBTable() : nullptr);
+
+			if ((config.filter == MipmapFilter::Box)
+				&& (srcWidth == (dstWidth * 2))
+				&& (srcHeight == (dstHeight * 2)))
+			{
+				ForEachRowTile(dstWidth, dstHeight, [&](const int32 first, const int32 last)
+				{
+					GenerateMipRows_Box2x2(src, dst, sRGB, first, last);
+				});
+			}
+			else
+			{
+				const MipFilter1D filterX = MakeMipFilter(srcWidth, dstWidth, config.filter);
+				const MipFilter1D filterY = MakeMipFilter(srcHeight, dstHeight, config.filter);
+
+				ForEachRowTile(dstWidth, dstHeight, [&](const int32 first, const int32 last)
+				{
+					GenerateMipRows_Filter(src, dst, filterX, filterY, sRGB, first, last);
+				});
+			}
+
+			return dst;
+		}
+
+		[[nodiscard]]
+		static std::array<size_t, 256> MakeAlphaHistogram(const Image& image) noexcept
+		{
+			std::array<size_t, 256> histogram{};
+
+			for (const auto& pixel : image)
+			{
+				++histogram[pixel.a];
+			}
+
+			return histogram;
+		}
+
+		[[nodiscard]]
+		static uint8 ScaleAlpha(const uint8 alpha, const double scale) noexcept
+		{
+			return static_cast<uint8>(Min((alpha * scale + 0.5), 255.0));
+		}
+
+		[[nodiscard]]
+		static double CalculateAlphaCoverage(const std::array<size_t, 256>& histogram, const size_t num_pixels, const uint8 threshold, const double scale) noexcept
+		{
+			size_t count = 0;
+
+			for (int32 alpha = 0; alpha < 256; ++alpha)
+			{
+				if (threshold < ScaleAlpha(static_cast<uint8>(alpha), scale))
+				{
+					count += histogram[alpha];
+				}
+			}
+
+			return (static_cast<double>(count) / num_pixels);
+		}
+
+		double CalculateAlphaCoverage(const Image& image, const uint8 threshold)
+		{
+			if (not image)
+			{
+				return 0.0;
+			}
+
+			return CalculateAlphaCoverage(MakeAlphaHistogram(image), image.num_pixels(), threshold, 1.0);
+		}
+
+		void ScaleAlphaToCoverage(Image& image, const double coverage, const uint8 threshold)
+		{
+			if (not image)
+			{
+				return;
+			}
+
+			// アルファのヒストグラムから、目標の割合に最も近くなる倍率を二分探索する
+			const std::array<size_t, 256> histogram = MakeAlphaHistogram(image);
+			const size_t num_pixels = image.num_pixels();
+
+			double bestScale = 1.0;
+			double bestError = Abs(CalculateAlphaCoverage(histogram, num_pixels, threshold, 1.0) - coverage);
+			double minScale = 0.0;
+			double maxScale = 4.0;
+
+			for (int32 i = 0; (i < 16) && (0.0 < bestError); ++i)
+			{
+				const double scale = ((minScale + maxScale) * 0.5);
+				const double current = CalculateAlphaCoverage(histogram, num_pixels, threshold, scale);
+
+				if (const double error = Abs(current - coverage);
+					error < bestError)
+				{
+					bestScale = scale;
+					bestError = error;
+				}
+
+				if (current < coverage)
+				{
+					minScale = scale;
+				}
+				else
+				{
+					maxScale = scale;
+				}
+			}
+
+			if (bestScale == 1.0)
+			{
+				return;
+			}
+
+			std::array<uint8, 256> table;
+
+			for (int32 alpha = 0; alpha < 256; ++alpha)
+			{
+				table[alpha] = ScaleAlpha(static_cast<uint8>(alpha), bestScale);
+			}
+
+			for (auto& pixel : image)
+			{
+				pixel.a = table[pixel.a];
+			}
+		}
+	}
+}
@@ -0,0 +1,41 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Image.hpp>
+# include <Siv3D/MipmapConfig.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 画像の幅と高さを半分（最小 1）に縮小したミップマップ画像を作成します。
+		/// @param src 縮小元の画像
+		/// @param config ミップマップ生成の設定
+		/// @return ミップマップ画像
+		/// @remark 大きな画像は行ごとのタイルに分割して並列に処理します。
+		[[nodiscard]]
+		Image GenerateMip(const Image& src, const MipmapConfig& config);
+
+		/// @brief アルファが閾値を超えるピクセルの割合を返します。
+		/// @param image 画像
+		/// @param threshold アルファの閾値
+		/// @return アルファが閾値を超えるピクセルの割合
+		[[nodiscard]]
+		double CalculateAlphaCoverage(const Image& image, uint8 threshold);
+
+		/// @brief アルファが閾値を超えるピクセルの割合が目標値に近くなるよう、画像のアルファを定数倍します。
+		/// @param image 画像
+		/// @param coverage 目標とする割合
+		/// @param threshold アルファの閾値
+		void ScaleAlphaToCoverage(Image& image, double coverage, uint8 threshold);
+	}
+}
@@ -11,82 +11,28 @@
 
 # include <Siv3D/ImageProcessing.hpp>
 # include <Siv3D/OpenCV_Bridge.hpp>
+# include "MipmapGenerator.hpp"
 
 namespace s3d
 {
-	namespace detail
+	namespace ImageProcessing
 	{
-		static Image GenerateMip(const Image& src)
+		Array<Image> GenerateMips(const Image& src)
 		{
-			if (not src)
-			{
-				return{};
-			}
-
-			const Color* pSrc = src.data();
-			const int32 srcW = src.width();
-			const int32 srcH = src.height();
-
-			const int32 targetWidth = Max(src.width() / 2, 1);
-			const int32 targetHeight = Max(src.height() / 2, 1);
-			
-			if ((targetWidth <= 4) && (targetHeight <= 4))
-			{
-				return src.scaled(targetWidth, targetHeight, InterpolationAlgorithm::Area);
-			}
-			
-			Image result(targetWidth, targetHeight);
-			Color* pDst = result.data();
-
-			const float sddx = (srcW - 1.0f) / Max(targetWidth - 1, 1);
-			const float sddy = (srcH - 1.0f) / Max(targetHeight - 1, 1);
-
-			for (int32 y = 0; y < targetHeight; ++y)
-			{
-				float sy = y * sddy;
-
-				const int32 dy = static_cast<int32>(sy);
-
-				sy -= dy;
-
-				const int32 dyO = Min(dy + 1, srcH - 1);
-
-				for (int32 x = 0; x < targetWidth; ++x)
-				{
-					float sx = x * sddx;
-
-					const int32 dx = static_cast<int32>(sx);
-
-					sx -= dx;
-
-					const int32 dxO = Min(dx + 1, srcW - 1);
-
-					const Color& c0 = pSrc[dy * srcW + dx];
-					const Color& c1 = pSrc[dy * srcW + dxO];
-					const Color& c2 = pSrc[dyO * srcW + dx];
-					const Color& c3 = pSrc[dyO * srcW + dxO];
-
-					const uint8 r = static_cast<uint8>((c0.r * (1 - sx) + c1.r * sx) * (1 - sy) + (c2.r * (1 - sx) + c3.r * sx) * sy);
-					const uint8 g = static_cast<uint8>((c0.g * (1 - sx) + c1.g * sx) * (1 - sy) + (c2.g * (1 - sx) + c3.g * sx) * sy);
-					const uint8 b = static_cast<uint8>((c0.b * (1 - sx) + c1.b * sx) * (1 - sy) + (c2.b * (1 - sx) + c3.b * sx) * sy);
-					const uint8 a = static_cast<uint8>((c0.a * (1 - sx) + c1.a * sx) * (1 - sy) + (c2.a * (1 - sx) + c3.a * sx) * sy);
-
-					(pDst++)->set(r, g, b, a);
-				}
-			}
+			return GenerateMips(src, Largest<size_t>, MipmapConfig{});
+		}
 
-			return result;
+		Array<Image> GenerateMips(const Image& src, const size_t maxLevel)
+		{
+			return GenerateMips(src, maxLevel, MipmapConfig{});
 		}
-	}
 
-	namespace ImageProcessing
-	{
-		Array<Image> GenerateMips(const Image& src)
+		Array<Image> GenerateMips(const Image& src, const MipmapConfig& config)
 		{
-			return GenerateMips(src, Largest<size_t>);
+			return GenerateMips(src, Largest<size_t>, config);
 		}
 
-		Array<Image> GenerateMips(const Image& src, const size_t maxLevel)
+		Array<Image> GenerateMips(const Image& src, const size_t maxLevel, const MipmapConfig& config)
 		{
 			const size_t mipCount = std::min(maxLevel, (CalculateMipCount(src.width(), src.height()) - 1));
 
@@ -97,11 +43,22 @@ namespace s3d
 
 			Array<Image> mipImages(mipCount);
 
-			mipImages[0] = detail::GenerateMip(src);
+			mipImages[0] = detail::GenerateMip(src, config);
 
 			for (size_t i = 1; i < mipCount; ++i)
 			{
-				mipImages[i] = detail::GenerateMip(mipImages[i - 1]);
+				mipImages[i] = detail::GenerateMip(mipImages[i - 1], config);
+			}
+
+			if (config.preserveAlphaCoverage)
+			{
+				// すべてのレベルを作成してから調整し、調整後のアルファが次のレベルに影響しないようにする
+				const double coverage = detail::CalculateAlphaCoverage(src, config.alphaCoverageThreshold);
+
+				for (auto& mipImage : mipImages)
+				{
+					detail::ScaleAlphaToCoverage(mipImage, coverage, config.alphaCoverageThreshold);
+				}
 			}
 
 			return mipImages;
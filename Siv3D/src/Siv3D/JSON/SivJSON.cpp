@@ -14,6 +14,8 @@
 # include <Siv3D/JSONValidator.hpp>
 # include <Siv3D/TextReader.hpp>
 # include <Siv3D/TextWriter.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <ThirdParty/nlohmann/json.hpp>
 # include <ThirdParty/nlohmann/json-schema.hpp>
@@ -142,6 +144,104 @@ namespace s3d
 
 			JSONValidatorDetail& operator=(JSONValidatorDetail&&) = default;
 		};
+
+		/// @brief JSONVisitor を nlohmann::json の SAX インタフェースに適合させるアダプタ
+		struct JSONVisitorSAX
+		{
+			JSONVisitor& visitor;
+
+			Optional<std::string> error = none;
+
+			bool null() { return visitor.onNull(); }
+
+			bool boolean(const bool value) { return visitor.onBool(value); }
+
+			bool number_integer(const nlohmann::json::number_integer_t value) { return visitor.onInt(value); }
+
+			bool number_unsigned(const nlohmann::json::number_unsigned_t value) { return visitor.onUint(value); }
+
+			bool number_float(const nlohmann::json::number_float_t value, const nlohmann::json::string_t&) { return visitor.onFloat(value); }
+
+			bool string(nlohmann::json::string_t& value) { return visitor.onString(value); }
+
+			bool binary(nlohmann::json::binary_t&) { return true; }
+
+			bool start_object(std::size_t) { return visitor.onObjectBegin(); }
+
+			bool key(nlohmann::json::string_t& key) { return visitor.onKey(key); }
+
+			bool end_object() { return visitor.onObjectEnd(); }
+
+			bool start_array(std::size_t) { return visitor.onArrayBegin(); }
+
+			bool end_array() { return visitor.onArrayEnd(); }
+
+			bool parse_error(std::size_t, const std::string&, const nlohmann::json::exception& e)
+			{
+				error = e.what();
+				return false;
+			}
+		};
+
+		/// @brief BOM を除いた UTF-8 のバイト列を返します。UTF-16 の場合は UTF-8 に変換して buffer に格納します。
+		/// @param data テキストデータの先頭ポインタ
+		/// @param size テキストデータのサイズ（バイト）
+		/// @param buffer 変換が必要な場合に使用するバッファ
+		/// @return UTF-8 のバイト列
+		[[nodiscard]]
+		static std::string_view ToUTF8View(const void* data, const size_t size, std::string& buffer)
+		{
+			const char* p = static_cast<const char*>(data);
+
+			if ((3 <= size) && (p[0] == '\xEF') && (p[1] == '\xBB') && (p[2] == '\xBF'))
+			{
+				return{ (p + 3), (size - 3) };
+			}
+
+			if ((2 <= size)
+				&& (((p[0] == '\xFF') && (p[1] == '\xFE')) || ((p[0] == '\xFE') && (p[1] == '\xFF'))))
+			{
+				const bool bigEndian = (p[0] == '\xFE');
+				std::u16string utf16(((size - 2) / 2), u'\0');
+				std::memcpy(utf16.data(), (p + 2), (utf16.size() * sizeof(char16)));
+
+				if (bigEndian)
+				{
+					for (auto& ch : utf16)
+					{
+						ch = static_cast<char16>((ch << 8) | (ch >> 8));
+					}
+				}
+
+				buffer = Unicode::UTF16ToUTF8(utf16);
+				return buffer;
+			}
+
+			return{ p, size };
+		}
+
+		/// @brief IReader の現在位置から末尾までを読み込み、BOM を除いた UTF-8 のバイト列を返します。
+		/// @param reader IReader
+		/// @param buffer 読み込みに使用するバッファ
+		/// @return UTF-8 のバイト列
+		[[nodiscard]]
+		static std::string_view ReadUTF8(IReader& reader, std::string& buffer)
+		{
+			std::string bytes(static_cast<size_t>(Max<int64>((reader.size() - reader.getPos()), 0)), '\0');
+			bytes.resize(static_cast<size_t>(reader.read(bytes.data(), static_cast<int64>(bytes.size()))));
+
+			const std::string_view view = ToUTF8View(bytes.data(), bytes.size(), buffer);
+
+			if (view.data() == buffer.data())
+			{
+				return view;
+			}
+
+			// BOM を取り除いた位置を保ったまま、バイト列の所有権を buffer に移す
+			const size_t offset = (view.data() - bytes.data());
+			buffer = std::move(bytes);
+			return{ (buffer.data() + offset), (buffer.size() - offset) };
+		}
 	}
 
 	//////////////////////////////////////////////////
@@ -1155,7 +1255,14 @@ namespace s3d
 
 	JSON JSON::Load(const FilePathView path, const AllowExceptions allowExceptions)
 	{
-		TextReader reader{ path };
+		// ファイルをメモリマップし、UTF-8 のバイト列をそのままパーサに渡す
+		if (const MemoryMappedFileView file{ path })
+		{
+			std::string buffer;
+			return ParseUTF8(detail::ToUTF8View(file.data(), file.mappedSize(), buffer), allowExceptions);
+		}
+
+		BinaryReader reader{ path };
 
 		if (not reader)
 		{
@@ -1167,14 +1274,13 @@ namespace s3d
 			return JSON::Invalid();
 		}
 
-		return Parse(reader.readAll(), allowExceptions);
+		std::string buffer;
+		return ParseUTF8(detail::ReadUTF8(reader, buffer), allowExceptions);
 	}
 
 	JSON JSON::Load(std::unique_ptr<IReader>&& reader, const AllowExceptions allowExceptions)
 	{
-		TextReader textReader{ std::move(reader) };
-
-		if (not textReader)
+		if ((not reader) || (not reader->isOpen()))
 		{
 			if (allowExceptions)
 			{
@@ -1184,16 +1290,22 @@ namespace s3d
 			return JSON::Invalid();
 		}
 
-		return Parse(textReader.readAll(), allowExceptions);
+		std::string buffer;
+		return ParseUTF8(detail::ReadUTF8(*reader, buffer), allowExceptions);
 	}
 
 	JSON JSON::Parse(const StringView str, const AllowExceptions allowExceptions)
+	{
+		return ParseUTF8(Unicode::ToUTF8(str), allowExceptions);
+	}
+
+	JSON JSON::ParseUTF8(const std::string_view str, const AllowExceptions allowExceptions)
 	{
 		JSON value{ Invalid_{} };
 
 		try
 		{
-			value.m_detail = std::make_shared<detail::JSONDetail>(detail::JSONDetail::Value(), nlohmann::json::parse(Unicode::ToUTF8(str)));
+			value.m_detail = std::make_shared<detail::JSONDetail>(detail::JSONDetail::Value(), nlohmann::json::parse(str.begin(), str.end()));
 			value.m_isValid = true;
 		}
 		catch (const std::exception& e)
@@ -1209,6 +1321,63 @@ namespace s3d
 		return value;
 	}
 
+	bool JSON::Visit(const FilePathView path, JSONVisitor& visitor, const AllowExceptions allowExceptions)
+	{
+		if (const MemoryMappedFileView file{ path })
+		{
+			std::string buffer;
+			return VisitUTF8(detail::ToUTF8View(file.data(), file.mappedSize(), buffer), visitor, allowExceptions);
+		}
+
+		BinaryReader reader{ path };
+
+		if (not reader)
+		{
+			if (allowExceptions)
+			{
+				throw Error{ U"JSON::Visit(): failed to open `{}`"_fmt(path) };
+			}
+
+			return false;
+		}
+
+		std::string buffer;
+		return VisitUTF8(detail::ReadUTF8(reader, buffer), visitor, allowExceptions);
+	}
+
+	bool JSON::Visit(std::unique_ptr<IReader>&& reader, JSONVisitor& visitor, const AllowExceptions allowExceptions)
+	{
+		if ((not reader) || (not reader->isOpen()))
+		{
+			if (allowExceptions)
+			{
+				throw Error(U"JSON::Visit(): failed to open from IReader");
+			}
+
+			return false;
+		}
+
+		std::string buffer;
+		return VisitUTF8(detail::ReadUTF8(*reader, buffer), visitor, allowExceptions);
+	}
+
+	bool JSON::VisitUTF8(const std::string_view str, JSONVisitor& visitor, const AllowExceptions allowExceptions)
+	{
+		detail::JSONVisitorSAX sax{ visitor };
+
+		if (nlohmann::json::sax_parse(str.begin(), str.end(), &sax))
+		{
+			return true;
+		}
+
+		if (sax.error && allowExceptions)
+		{
+			throw Error{ U"JSON::Visit(): " + Unicode::Widen(*sax.error) };
+		}
+
+		return false;
+	}
+
 	JSON JSON::FromBSON(const Blob& bson, const AllowExceptions allowExceptions)
 	{
 		JSON value{ Invalid_{} };
@@ -0,0 +1,513 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <array>
+# include <charconv>
+# include <cstdlib>
+# include <cstring>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/FormatInt.hpp>
+# include <Siv3D/Time.hpp>
+# include <Siv3D/Utility.hpp>
+# include "AsyncLogWriter.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		constexpr std::array<std::string_view, 7> LogTypeNames =
+		{
+			"[error]   ",
+			"[fail]    ",
+			"[warning] ",
+			"",
+			"[info]    ",
+			"[trace]   ",
+			"[verbose] ",
+		};
+
+		/// @brief バイナリ形式のログファイルの先頭に書き込まれる識別子
+		constexpr std::array<char, 8> BinaryLogMagic = { 'S', 'I', 'V', '3', 'D', 'L', 'O', 'G' };
+
+		constexpr uint32 BinaryLogVersion = 1;
+
+		/// @brief この大きさを超えたら、読み出しの途中でも書き出す
+		constexpr size_t MaxBatchSize = (64 << 10);
+
+		/// @brief 書き出しスレッドが新しいログを待つ最大の時間
+		constexpr std::chrono::milliseconds WriterWaitTime{ 100 };
+
+		[[nodiscard]]
+		constexpr size_t FileHeaderSize(const LogFileFormat format) noexcept
+		{
+			return ((format == LogFileFormat::Binary) ? (BinaryLogMagic.size() + sizeof(BinaryLogVersion)) : 0);
+		}
+
+		static std::atomic<AsyncLogWriter*> g_writer{ nullptr };
+
+		static void OnExit()
+		{
+			if (AsyncLogWriter* writer = g_writer.load(std::memory_order_acquire))
+			{
+				writer->flushSynchronously();
+			}
+		}
+
+		static void AppendUTF8(std::string& dst, const StringView s)
+		{
+			for (const char32 ch : s)
+			{
+				if (ch < 0x80)
+				{
+					dst.push_back(static_cast<char>(ch));
+				}
+				else if (ch < 0x800)
+				{
+					dst.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+					dst.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+				}
+				else if (ch < 0x10000)
+				{
+					dst.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+					dst.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+					dst.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+				}
+				else
+				{
+					dst.push_back(static_cast<char>(0xF0 | (ch >> 18)));
+					dst.push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+					dst.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+					dst.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+				}
+			}
+		}
+
+		template <class Type>
+		static void AppendBytes(std::string& dst, const Type& value)
+		{
+			char bytes[sizeof(Type)];
+			std::memcpy(bytes, &value, sizeof(Type));
+			dst.append(bytes, sizeof(Type));
+		}
+	}
+
+	AsyncLogWriter::AsyncLogWriter(ConsoleOutput consoleOutput)
+		: m_consoleOutput{ std::move(consoleOutput) }
+		, m_slots{ std::make_unique<Slot[]>(Capacity) }
+	{
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+	# if !SIV3D_PLATFORM(WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+
+		{
+			std::lock_guard lock{ m_mutex };
+			m_thread = std::thread{ [this]() { run(); } };
+			m_threadID = m_thread.get_id();
+		}
+
+	# endif
+
+		detail::g_writer.store(this, std::memory_order_release);
+
+		static std::once_flag atExitFlag;
+		std::call_once(atExitFlag, []() { std::atexit(detail::OnExit); });
+	}
+
+	AsyncLogWriter::~AsyncLogWriter()
+	{
+		if (m_thread.joinable())
+		{
+			{
+				std::lock_guard lock{ m_mutex };
+				m_stop = true;
+			}
+
+			m_wakeCondition.notify_one();
+			m_thread.join();
+		}
+
+		drain(false);
+
+		detail::g_writer.store(nullptr, std::memory_order_release);
+	}
+
+	void AsyncLogWriter::write(const LogType type, const StringView s)
+	{
+		const int64 timeStamp = Time::GetMillisec();
+
+		while (not tryPush(type, timeStamp, s))
+		{
+			// 書き出しスレッド自身がバッファを待つとデッドロックするため、ログを捨てる
+			if ((not isRunning()) || (std::this_thread::get_id() == m_threadID))
+			{
+				return;
+			}
+
+			wake();
+			std::this_thread::yield();
+		}
+
+		if (not isRunning())
+		{
+			drain(false);
+		}
+		// スロットの公開 (tryPush) とこの読み出し、書き出しスレッドの m_sleeping への書き込みと述語の読み出しは、
+		// いずれも seq_cst で行う。どちらか一方は必ず相手の書き込みを観測するため、起床の取りこぼしが起こらない
+		else if (m_sleeping.load(std::memory_order_seq_cst))
+		{
+			wake();
+		}
+	}
+
+	bool AsyncLogWriter::setOutputFile(const FilePathView path, const LogFileFormat format, const size_t maxFileSize, const size_t maxBackupFiles)
+	{
+		// 開く前に溜まっているログは以前の出力先に書き出す
+		flush();
+
+		std::lock_guard lock{ m_fileMutex };
+
+		m_file.close();
+
+		if (not m_file.open(path, OpenMode::Append))
+		{
+			m_filePath.clear();
+			return false;
+		}
+
+		m_filePath			= path;
+		m_fileFormat		= format;
+		m_maxFileSize		= maxFileSize;
+		m_maxBackupFiles	= maxBackupFiles;
+
+		m_fileSize = static_cast<size_t>(m_file.size());
+
+		if (m_fileSize == 0)
+		{
+			writeFileHeader();
+		}
+
+		return true;
+	}
+
+	void AsyncLogWriter::closeOutputFile()
+	{
+		flush();
+
+		std::lock_guard lock{ m_fileMutex };
+
+		m_file.close();
+		m_filePath.clear();
+	}
+
+	void AsyncLogWriter::flush()
+	{
+		if (not isRunning())
+		{
+			return;
+		}
+
+		if (std::this_thread::get_id() == m_threadID)
+		{
+			return;
+		}
+
+		const size_t target = m_enqueuePos.load(std::memory_order_acquire);
+
+		std::unique_lock lock{ m_mutex };
+
+		while (m_writtenCount.load(std::memory_order_acquire) < target)
+		{
+			if (m_stop)
+			{
+				return;
+			}
+
+			lock.unlock();
+			wake();
+			lock.lock();
+
+			m_flushedCondition.wait_for(lock, std::chrono::milliseconds{ 10 });
+		}
+	}
+
+	void AsyncLogWriter::flushSynchronously()
+	{
+		// 書き出しスレッドが読み出し中であれば、それが終わるまで少し待つ
+		for (int32 i = 0; (i < 200) && m_consuming.load(std::memory_order_acquire); ++i)
+		{
+			if (std::this_thread::get_id() == m_threadID)
+			{
+				return;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+		}
+
+		drain(true);
+	}
+
+	bool AsyncLogWriter::tryPush(const LogType type, const int64 timeStamp, const StringView s)
+	{
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			Slot& slot = m_slots[pos & (Capacity - 1)];
+			const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t diff = (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos));
+
+			if (diff == 0)
+			{
+				if (m_enqueuePos.compare_exchange_weak(pos, (pos + 1), std::memory_order_relaxed))
+				{
+					slot.timeStamp = timeStamp;
+					slot.type = type;
+					slot.text.assign(s.begin(), s.end());
+					slot.sequence.store((pos + 1), std::memory_order_seq_cst);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool AsyncLogWriter::isRunning() const noexcept
+	{
+		return m_thread.joinable();
+	}
+
+	void AsyncLogWriter::run()
+	{
+		{
+			// コンストラクタで m_threadID が設定されるのを待つ
+			std::lock_guard lock{ m_mutex };
+		}
+
+		for (;;)
+		{
+			drain(false);
+
+			std::unique_lock lock{ m_mutex };
+
+			if (m_stop)
+			{
+				break;
+			}
+
+			const auto hasPending = [this]()
+			{
+				return (m_slots[m_dequeuePos & (Capacity - 1)].sequence.load(std::memory_order_seq_cst) == (m_dequeuePos + 1));
+			};
+
+			m_sleeping.store(true, std::memory_order_seq_cst);
+			m_wakeCondition.wait_for(lock, detail::WriterWaitTime, [&]() { return (m_stop || hasPending()); });
+			m_sleeping.store(false, std::memory_order_relaxed);
+		}
+
+		drain(false);
+	}
+
+	size_t AsyncLogWriter::drain(const bool fromExitHandler)
+	{
+		if (m_consuming.exchange(true, std::memory_order_acquire))
+		{
+			return 0;
+		}
+
+		// プロセスの終了時は、ファイルがロックされていればコンソールにのみ書き出す
+		std::unique_lock fileLock{ m_fileMutex, std::defer_lock };
+
+		if (fromExitHandler)
+		{
+			(void)fileLock.try_lock();
+		}
+		else
+		{
+			fileLock.lock();
+		}
+
+		const bool toFile = (fileLock.owns_lock() && m_file.isOpen());
+		const bool binary = (toFile && (m_fileFormat == LogFileFormat::Binary));
+		size_t count = 0;
+
+		m_textBuffer.clear();
+		m_binaryBuffer.clear();
+
+		for (;;)
+		{
+			Slot& slot = m_slots[m_dequeuePos & (Capacity - 1)];
+
+			if (slot.sequence.load(std::memory_order_acquire) != (m_dequeuePos + 1))
+			{
+				break;
+			}
+
+			{
+				m_record.clear();
+
+				char timeStamp[24];
+				const auto result = std::to_chars(std::begin(timeStamp), std::end(timeStamp), slot.timeStamp);
+				m_record.append(timeStamp, result.ptr);
+				m_record.append(": ");
+				m_record.append(detail::LogTypeNames[FromEnum(slot.type)]);
+
+				const size_t textBegin = m_record.size();
+				detail::AppendUTF8(m_record, slot.text);
+				const uint32 textLength = static_cast<uint32>(m_record.size() - textBegin);
+				m_record.push_back('\n');
+
+				if (toFile && m_maxFileSize)
+				{
+					const size_t recordSize = (binary ? (sizeof(int64) + sizeof(uint8) + sizeof(uint32) + textLength) : m_record.size());
+					const size_t fileSize = (m_fileSize + (binary ? m_binaryBuffer.size() : m_textBuffer.size()));
+
+					if ((m_maxFileSize < (fileSize + recordSize)) && (detail::FileHeaderSize(m_fileFormat) < fileSize))
+					{
+						writeBatch(toFile, binary);
+						rotate();
+					}
+				}
+
+				m_textBuffer.append(m_record);
+
+				if (binary)
+				{
+					detail::AppendBytes(m_binaryBuffer, slot.timeStamp);
+					detail::AppendBytes(m_binaryBuffer, FromEnum(slot.type));
+					detail::AppendBytes(m_binaryBuffer, textLength);
+					m_binaryBuffer.append(m_record, textBegin, textLength);
+				}
+			}
+
+			// capacity を残したまま空にして、次に書き込むスレッドの再確保を避ける
+			slot.text.clear();
+			slot.sequence.store((m_dequeuePos + Capacity), std::memory_order_release);
+
+			++m_dequeuePos;
+			++count;
+
+			if (detail::MaxBatchSize <= m_textBuffer.size())
+			{
+				writeBatch(toFile, binary);
+			}
+		}
+
+		writeBatch(toFile, binary);
+
+		if (fileLock.owns_lock())
+		{
+			fileLock.unlock();
+		}
+
+		m_writtenCount.store(m_dequeuePos, std::memory_order_release);
+		m_consuming.store(false, std::memory_order_release);
+
+		if (count && (not fromExitHandler))
+		{
+			m_flushedCondition.notify_all();
+		}
+
+		return count;
+	}
+
+	void AsyncLogWriter::writeBatch(const bool toFile, const bool binary)
+	{
+		if (m_textBuffer.empty())
+		{
+			return;
+		}
+
+		if (m_consoleOutput)
+		{
+			m_consoleOutput(m_textBuffer);
+		}
+
+		if (toFile)
+		{
+			const std::string& data = (binary ? m_binaryBuffer : m_textBuffer);
+
+			if (m_file && (not data.empty()))
+			{
+				m_file.write(data.data(), data.size());
+				m_file.flush();
+				m_fileSize += data.size();
+			}
+		}
+
+		m_textBuffer.clear();
+		m_binaryBuffer.clear();
+	}
+
+	void AsyncLogWriter::rotate()
+	{
+		m_file.close();
+
+		const auto backupPath = [this](const size_t index)
+		{
+			return (m_filePath + U'.' + ToString(index));
+		};
+
+		if (m_maxBackupFiles == 0)
+		{
+			FileSystem::Remove(m_filePath);
+		}
+		else
+		{
+			FileSystem::Remove(backupPath(m_maxBackupFiles));
+
+			for (size_t i = m_maxBackupFiles; 1 < i; --i)
+			{
+				if (FileSystem::Exists(backupPath(i - 1)))
+				{
+					FileSystem::Rename(backupPath(i - 1), backupPath(i));
+				}
+			}
+
+			FileSystem::Rename(m_filePath, backupPath(1));
+		}
+
+		m_fileSize = 0;
+
+		if (m_file.open(m_filePath, OpenMode::Trunc))
+		{
+			writeFileHeader();
+		}
+	}
+
+	void AsyncLogWriter::writeFileHeader()
+	{
+		if (m_fileFormat == LogFileFormat::Binary)
+		{
+			m_file.write(detail::BinaryLogMagic.data(), detail::BinaryLogMagic.size());
+			m_file.write(detail::BinaryLogVersion);
+			m_fileSize += detail::FileHeaderSize(m_fileFormat);
+		}
+	}
+
+	void AsyncLogWriter::wake()
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+		}
+
+		m_wakeCondition.notify_one();
+	}
+}
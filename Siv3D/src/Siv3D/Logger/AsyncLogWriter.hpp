@@ -0,0 +1,155 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <mutex>
+# include <thread>
+# include <condition_variable>
+# include <functional>
+# include <memory>
+# include <string>
+# include <string_view>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Logger.hpp>
+# include <Siv3D/LogType.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+
+namespace s3d
+{
+	/// @brief ログをリングバッファに積み、バックグラウンドのスレッドでまとめて書き出すクラス
+	/// @remark ログを出力するスレッドは、タイムスタンプの取得と文字列のコピーのみを行います。整形、UTF-8 への変換、出力先への書き込みは書き出しスレッドで行われます。
+	class AsyncLogWriter
+	{
+	public:
+
+		/// @brief 整形済みの UTF-8 テキストを出力する関数
+		using ConsoleOutput = std::function<void(std::string_view text)>;
+
+		/// @brief リングバッファの要素数（2 のべき乗）
+		static constexpr size_t Capacity = 4096;
+
+		explicit AsyncLogWriter(ConsoleOutput consoleOutput);
+
+		~AsyncLogWriter();
+
+		/// @brief ログを追加します。
+		/// @param type ログの種類
+		/// @param s ログの内容
+		void write(LogType type, StringView s);
+
+		/// @brief ログファイルへの出力を開始します。
+		/// @param path ファイルパス
+		/// @param format ファイルの形式
+		/// @param maxFileSize ファイルの最大サイズ（バイト）。0 の場合はローテーションしません。
+		/// @param maxBackupFiles ローテーションで残す古いファイルの数
+		/// @return ファイルを開けた場合 true, それ以外の場合は false
+		bool setOutputFile(FilePathView path, LogFileFormat format, size_t maxFileSize, size_t maxBackupFiles);
+
+		/// @brief ログファイルへの出力を終了します。
+		void closeOutputFile();
+
+		/// @brief それまでに追加されたログがすべて書き出されるまで待機します。
+		void flush();
+
+		/// @brief 書き出しスレッドを経由せずに、呼び出したスレッドで残りのログを書き出します。
+		/// @remark プロセスの終了時 (atexit) に呼ばれます。
+		void flushSynchronously();
+
+	private:
+
+		struct Slot
+		{
+			std::atomic<size_t> sequence{ 0 };
+
+			int64 timeStamp = 0;
+
+			LogType type = LogType::App;
+
+			String text;
+		};
+
+		ConsoleOutput m_consoleOutput;
+
+		std::unique_ptr<Slot[]> m_slots;
+
+		/// @brief 次に書き込むスロットの位置（複数のスレッドから更新される）
+		std::atomic<size_t> m_enqueuePos{ 0 };
+
+		/// @brief 次に読み出すスロットの位置（読み出し中のスレッドのみが更新する）
+		size_t m_dequeuePos = 0;
+
+		/// @brief 書き出しが完了したログの数
+		std::atomic<size_t> m_writtenCount{ 0 };
+
+		/// @brief リングバッファの読み出し中であるか
+		std::atomic<bool> m_consuming{ false };
+
+		std::thread m_thread;
+
+		std::thread::id m_threadID;
+
+		std::mutex m_mutex;
+
+		std::condition_variable m_wakeCondition;
+
+		std::condition_variable m_flushedCondition;
+
+		std::atomic<bool> m_sleeping{ false };
+
+		bool m_stop = false;
+
+		/// @brief 出力ファイルの状態（書き出しスレッドと setOutputFile() の間で m_fileMutex により保護される）
+		std::mutex m_fileMutex;
+
+		BinaryWriter m_file;
+
+		FilePath m_filePath;
+
+		LogFileFormat m_fileFormat = LogFileFormat::Text;
+
+		size_t m_maxFileSize = 0;
+
+		size_t m_maxBackupFiles = 0;
+
+		/// @brief 出力ファイルの現在のサイズ（バイト）
+		size_t m_fileSize = 0;
+
+		/// @brief 整形中の 1 件分のテキスト
+		std::string m_record;
+
+		std::string m_textBuffer;
+
+		std::string m_binaryBuffer;
+
+		[[nodiscard]]
+		bool tryPush(LogType type, int64 timeStamp, StringView s);
+
+		[[nodiscard]]
+		bool isRunning() const noexcept;
+
+		void run();
+
+		/// @brief リングバッファからログを取り出して書き出します。
+		/// @param fromExitHandler プロセスの終了時に呼ばれた場合 true
+		/// @return 取り出したログの数
+		size_t drain(bool fromExitHandler);
+
+		void writeBatch(bool toFile, bool binary);
+
+		void rotate();
+
+		void writeFileHeader();
+
+		void wake();
+	};
+}
@@ -15,6 +15,7 @@
 namespace s3d
 {
 	enum class LogType : uint8;
+	enum class LogFileFormat : uint8;
 	class StringView;
 
 	class SIV3D_NOVTABLE ISiv3DLogger
@@ -28,5 +29,11 @@ namespace s3d
 		virtual void write(LogType type, StringView s) = 0;
 
 		virtual void setEnabled(bool enabled) = 0;
+
+		virtual bool setOutputFile(StringView path, LogFileFormat format, size_t maxFileSize, size_t maxBackupFiles) = 0;
+
+		virtual void closeOutputFile() = 0;
+
+		virtual void flush() = 0;
 	};
 }
@@ -11,6 +11,7 @@
 
 # include <Siv3D/Logger.hpp>
 # include <Siv3D/LogType.hpp>
+# include <Siv3D/EngineLog.hpp>
 # include <Siv3D/Logger/ILogger.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
@@ -81,5 +82,58 @@ namespace s3d
 		{
 			SIV3D_ENGINE(Logger)->setEnabled(true);
 		}
+
+		void Logger_impl::setLogLevel(const LogLevel logLevel) const
+		{
+			LogType limit = LogType::Info;
+
+			switch (logLevel)
+			{
+			case LogLevel::Release:
+				limit = LogType::Info;
+				break;
+			case LogLevel::Debug:
+				limit = LogType::Trace;
+				break;
+			case LogLevel::Verbose:
+				limit = LogType::Verbose;
+				break;
+			}
+
+			Internal::g_engineLogTypeLimit.store(FromEnum(limit), std::memory_order_relaxed);
+		}
+
+		LogLevel Logger_impl::getLogLevel() const
+		{
+			const uint8 limit = Internal::g_engineLogTypeLimit.load(std::memory_order_relaxed);
+
+			if (FromEnum(LogType::Verbose) <= limit)
+			{
+				return LogLevel::Verbose;
+			}
+			else if (FromEnum(LogType::Trace) <= limit)
+			{
+				return LogLevel::Debug;
+			}
+			else
+			{
+				return LogLevel::Release;
+			}
+		}
+
+		bool Logger_impl::setOutputFile(const FilePathView path, const LogFileFormat format, const size_t maxFileSize, const size_t maxBackupFiles) const
+		{
+			return SIV3D_ENGINE(Logger)->setOutputFile(path, format, maxFileSize, maxBackupFiles);
+		}
+
+		void Logger_impl::closeOutputFile() const
+		{
+			SIV3D_ENGINE(Logger)->closeOutputFile();
+		}
+
+		void Logger_impl::flush() const
+		{
+			SIV3D_ENGINE(Logger)->flush();
+		}
 	}
 }
@@ -32,6 +32,8 @@ namespace s3d
 
 # if not SIV3D_PLATFORM(WEB)
 
+		m_httpClient.shutdown();
+
 		if (m_curlInitialized)
 		{
 			::curl_global_cleanup();
@@ -60,4 +62,18 @@ namespace s3d
 
 		m_curlInitialized = true;
 	}
+
+	const std::shared_ptr<TCPBufferPool>& CNetwork::getTCPBufferPool() noexcept
+	{
+		return m_tcpBufferPool;
+	}
+
+# if not SIV3D_PLATFORM(WEB)
+
+	HTTPClient& CNetwork::getHTTPClient() noexcept
+	{
+		return m_httpClient;
+	}
+
+# endif
 }
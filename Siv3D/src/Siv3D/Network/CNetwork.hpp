@@ -11,6 +11,11 @@
 
 # pragma once
 # include "INetwork.hpp"
+# include "TCPBuffer.hpp"
+
+# if not SIV3D_PLATFORM(WEB)
+#	include "HTTPClient.hpp"
+# endif
 
 namespace s3d
 {
@@ -24,8 +29,25 @@ namespace s3d
 
 		void init() override;
 
+		const std::shared_ptr<TCPBufferPool>& getTCPBufferPool() noexcept override;
+
+	# if not SIV3D_PLATFORM(WEB)
+
+		HTTPClient& getHTTPClient() noexcept override;
+
+	# endif
+
 	private:
 
 		bool m_curlInitialized = false;
+
+		/// @brief エンジンより長く生存する TCP セッションも使えるよう、共有で所有する
+		std::shared_ptr<TCPBufferPool> m_tcpBufferPool = std::make_shared<TCPBufferPool>();
+
+	# if not SIV3D_PLATFORM(WEB)
+
+		HTTPClient m_httpClient;
+
+	# endif
 	};
 }
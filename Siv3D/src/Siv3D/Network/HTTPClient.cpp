@@ -0,0 +1,537 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Profiler.hpp>
+# include "HTTPClient.hpp"
+
+# define CURL_STATICLIB
+# if SIV3D_PLATFORM(WINDOWS)
+#	include <ThirdParty-prebuilt/curl/curl.h>
+# else
+#	include <curl/curl.h>
+# endif
+
+namespace s3d
+{
+	struct HTTPClient::Transfer
+	{
+		Request request;
+
+		::CURL* curl = nullptr;
+
+		::curl_slist* headerList = nullptr;
+
+		std::string responseHeaders;
+	};
+
+	namespace detail
+	{
+		static size_t HTTPClientWriteCallback(const char* ptr, const size_t size, const size_t nmemb, IWriter* pWriter)
+		{
+			const size_t size_bytes = (size * nmemb);
+
+			pWriter->write(ptr, size_bytes);
+
+			return size_bytes;
+		}
+
+		static size_t HTTPClientHeaderCallback(const char* buffer, const size_t size, const size_t nitems, std::string* userData)
+		{
+			const size_t size_bytes = (size * nitems);
+
+			userData->append(buffer, size_bytes);
+
+			return size_bytes;
+		}
+
+		static int HTTPClientProgressCallback(const HTTPClient::Request* request, const curl_off_t dlTotal, const curl_off_t dlNow, const curl_off_t ulTotal, const curl_off_t ulNow)
+		{
+			if (request->abort && request->abort->load(std::memory_order_relaxed))
+			{
+				return CURLE_ABORTED_BY_CALLBACK;
+			}
+
+			if (request->onProgress)
+			{
+				request->onProgress(static_cast<int64>(dlTotal), static_cast<int64>(dlNow), static_cast<int64>(ulTotal), static_cast<int64>(ulNow));
+			}
+
+			return 0;
+		}
+
+		[[nodiscard]]
+		static bool IsAborted(const HTTPClient::Request& request) noexcept
+		{
+			return (request.abort && request.abort->load(std::memory_order_relaxed));
+		}
+
+		[[nodiscard]]
+		static HTTPAsyncStatus ToStatus(const ::CURLcode result)
+		{
+			if (result == ::CURLE_OK)
+			{
+				return HTTPAsyncStatus::Succeeded;
+			}
+
+			LOG_FAIL(U"curl failed (CURLcode: {})"_fmt(FromEnum(result)));
+
+			return ((result == ::CURLE_ABORTED_BY_CALLBACK) ? HTTPAsyncStatus::Canceled : HTTPAsyncStatus::Failed);
+		}
+	}
+
+	HTTPClient::HTTPClient() {}
+
+	HTTPClient::~HTTPClient()
+	{
+		shutdown();
+	}
+
+	void HTTPClient::submit(Request&& request)
+	{
+		bool performHere = false;
+		{
+			std::lock_guard lock{ m_mutex };
+
+			if (not m_stop)
+			{
+				if (not m_multi)
+				{
+					m_multi = ::curl_multi_init();
+					m_share = ::curl_share_init();
+
+					if (m_multi)
+					{
+						// HTTP/2 では 1 つの接続で複数のリクエストを同時に転送する
+						::curl_multi_setopt(m_multi, ::CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+					}
+
+					if (m_share)
+					{
+						// 新しい接続でも、同じホストとの TLS セッションを再開できるようにする
+						::curl_share_setopt(m_share, ::CURLSHOPT_SHARE, ::CURL_LOCK_DATA_SSL_SESSION);
+						::curl_share_setopt(m_share, ::CURLSHOPT_SHARE, ::CURL_LOCK_DATA_DNS);
+					}
+				}
+
+				if (m_multi)
+				{
+					if (not m_thread.joinable())
+					{
+						m_thread = std::thread{ &HTTPClient::run, this };
+					}
+
+					// クライアントのスレッドは submit() から戻るまで転送を進められないので、
+					// そこから追加された同期版のリクエストは、待機させずにこの場で転送を終える
+					performHere = (request.immediate && (std::this_thread::get_id() == m_thread.get_id()));
+
+					if (not performHere)
+					{
+						if (request.immediate)
+						{
+							m_immediate.push_back(std::move(request));
+						}
+						else
+						{
+							m_pending.push_back(Pending{ m_sequence++, std::move(request) });
+
+							std::push_heap(m_pending.begin(), m_pending.end(), PendingCompare{});
+						}
+
+						::curl_multi_wakeup(m_multi);
+
+						return;
+					}
+				}
+			}
+		}
+
+		if (performHere)
+		{
+			performOnClientThread(std::move(request));
+
+			return;
+		}
+
+		LOG_FAIL(U"HTTPClient: failed to submit a request");
+
+		Complete(request, HTTPAsyncStatus::Failed);
+	}
+
+	void HTTPClient::notifyAbort()
+	{
+		m_abortRequested = true;
+
+		std::lock_guard lock{ m_mutex };
+
+		if (m_multi)
+		{
+			::curl_multi_wakeup(m_multi);
+		}
+	}
+
+	void HTTPClient::setMaxConcurrency(const size_t maxConcurrency)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_maxConcurrency = Max<size_t>(maxConcurrency, 1);
+
+		if (m_multi)
+		{
+			::curl_multi_wakeup(m_multi);
+		}
+	}
+
+	size_t HTTPClient::getMaxConcurrency() const
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return m_maxConcurrency;
+	}
+
+	void HTTPClient::shutdown()
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+
+			if (m_stop)
+			{
+				return;
+			}
+
+			m_stop = true;
+
+			if (m_multi)
+			{
+				::curl_multi_wakeup(m_multi);
+			}
+		}
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+		for (void* curl : m_idleHandles)
+		{
+			::curl_easy_cleanup(curl);
+		}
+
+		m_idleHandles.clear();
+
+		if (m_multi)
+		{
+			::curl_multi_cleanup(m_multi);
+			m_multi = nullptr;
+		}
+
+		if (m_share)
+		{
+			::curl_share_cleanup(m_share);
+			m_share = nullptr;
+		}
+	}
+
+	void HTTPClient::run()
+	{
+		Profiler::SetThreadName(U"HTTP");
+
+		for (;;)
+		{
+			{
+				std::lock_guard lock{ m_mutex };
+
+				if (m_stop)
+				{
+					break;
+				}
+			}
+
+			if (m_abortRequested.exchange(false))
+			{
+				removeAborted();
+			}
+
+			startTransfers();
+
+			int runningHandles = 0;
+
+			::curl_multi_perform(m_multi, &runningHandles);
+
+			int messagesInQueue = 0;
+
+			bool finished = false;
+
+			while (const ::CURLMsg* message = ::curl_multi_info_read(m_multi, &messagesInQueue))
+			{
+				if (message->msg != ::CURLMSG_DONE)
+				{
+					continue;
+				}
+
+				char* privateData = nullptr;
+
+				::curl_easy_getinfo(message->easy_handle, ::CURLINFO_PRIVATE, &privateData);
+
+				finish(reinterpret_cast<Transfer*>(privateData), detail::ToStatus(message->data.result));
+
+				finished = true;
+			}
+
+			// 空いた枠で、待機中のリクエストをすぐに開始する
+			if (finished)
+			{
+				continue;
+			}
+
+			// 転送中のソケットへの入出力、curl_multi_wakeup()、またはタイムアウトまで待機する
+			::curl_multi_poll(m_multi, nullptr, 0, PollIntervalMillisec, nullptr);
+		}
+
+		while (m_transfers)
+		{
+			finish(m_transfers.back().get(), HTTPAsyncStatus::Canceled);
+		}
+
+		Array<Pending> pending;
+		Array<Request> immediate;
+		{
+			std::lock_guard lock{ m_mutex };
+
+			pending.swap(m_pending);
+			immediate.swap(m_immediate);
+		}
+
+		for (auto& p : pending)
+		{
+			Complete(p.request, HTTPAsyncStatus::Canceled);
+		}
+
+		for (auto& request : immediate)
+		{
+			Complete(request, HTTPAsyncStatus::Canceled);
+		}
+	}
+
+	void HTTPClient::startTransfers()
+	{
+		Array<Request> requests;
+		{
+			std::lock_guard lock{ m_mutex };
+
+			// 同期版のリクエストは上限に関係なく、待機中のリクエストより先に開始する
+			requests.swap(m_immediate);
+
+			// 上限は待機列から開始したリクエストだけで数える
+			size_t queuedTransfers = m_transfers.count_if([](const std::unique_ptr<Transfer>& t) { return (not t->request.immediate); });
+
+			while (m_pending && (queuedTransfers < m_maxConcurrency))
+			{
+				std::pop_heap(m_pending.begin(), m_pending.end(), PendingCompare{});
+
+				requests.push_back(std::move(m_pending.back().request));
+
+				m_pending.pop_back();
+
+				++queuedTransfers;
+			}
+		}
+
+		for (auto& request : requests)
+		{
+			if (detail::IsAborted(request))
+			{
+				Complete(request, HTTPAsyncStatus::Canceled);
+				continue;
+			}
+
+			startTransfer(std::move(request));
+		}
+	}
+
+	void HTTPClient::startTransfer(Request&& request)
+	{
+		::CURL* curl = acquireHandle();
+
+		if (not curl)
+		{
+			Complete(request, HTTPAsyncStatus::Failed);
+			return;
+		}
+
+		auto transfer = std::make_unique<Transfer>();
+		transfer->request = std::move(request);
+		transfer->curl = curl;
+
+		SetupHandle(*transfer, m_share);
+
+		::curl_easy_setopt(curl, ::CURLOPT_PIPEWAIT, 1L);
+
+		if (::curl_multi_add_handle(m_multi, curl) != ::CURLM_OK)
+		{
+			LOG_FAIL(U"HTTPClient: curl_multi_add_handle() failed");
+			::curl_slist_free_all(transfer->headerList);
+			m_idleHandles.push_back(curl);
+			Complete(transfer->request, HTTPAsyncStatus::Failed);
+			return;
+		}
+
+		m_transfers.push_back(std::move(transfer));
+	}
+
+	void HTTPClient::performOnClientThread(Request&& request)
+	{
+		::CURL* curl = acquireHandle();
+
+		if (not curl)
+		{
+			Complete(request, HTTPAsyncStatus::Failed);
+			return;
+		}
+
+		Transfer transfer;
+		transfer.request = std::move(request);
+		transfer.curl = curl;
+
+		SetupHandle(transfer, m_share);
+
+		// multi ハンドルの転送はこのスレッドでしか進まないので、共有ハンドルをそのまま使える
+		const HTTPAsyncStatus status = detail::ToStatus(::curl_easy_perform(curl));
+
+		m_idleHandles.push_back(curl);
+
+		::curl_slist_free_all(transfer.headerList);
+
+		Complete(transfer.request, status, std::move(transfer.responseHeaders));
+	}
+
+	void* HTTPClient::acquireHandle()
+	{
+		// 使い終わったハンドルを再利用する
+		if (m_idleHandles)
+		{
+			::CURL* curl = m_idleHandles.back();
+			m_idleHandles.pop_back();
+			::curl_easy_reset(curl);
+			return curl;
+		}
+
+		::CURL* curl = ::curl_easy_init();
+
+		if (not curl)
+		{
+			LOG_FAIL(U"HTTPClient: curl_easy_init() failed");
+		}
+
+		return curl;
+	}
+
+	void HTTPClient::removeAborted()
+	{
+		Array<Pending> aborted;
+		{
+			std::lock_guard lock{ m_mutex };
+
+			const auto it = std::partition(m_pending.begin(), m_pending.end(),
+				[](const Pending& p) { return (not detail::IsAborted(p.request)); });
+
+			aborted.assign(std::make_move_iterator(it), std::make_move_iterator(m_pending.end()));
+
+			m_pending.erase(it, m_pending.end());
+
+			std::make_heap(m_pending.begin(), m_pending.end(), PendingCompare{});
+		}
+
+		for (auto& p : aborted)
+		{
+			Complete(p.request, HTTPAsyncStatus::Canceled);
+		}
+
+		for (size_t i = m_transfers.size(); i--;)
+		{
+			if (detail::IsAborted(m_transfers[i]->request))
+			{
+				finish(m_transfers[i].get(), HTTPAsyncStatus::Canceled);
+			}
+		}
+	}
+
+	void HTTPClient::finish(Transfer* transfer, const HTTPAsyncStatus status)
+	{
+		const auto it = std::find_if(m_transfers.begin(), m_transfers.end(),
+			[=](const std::unique_ptr<Transfer>& t) { return (t.get() == transfer); });
+
+		if (it == m_transfers.end())
+		{
+			return;
+		}
+
+		std::unique_ptr<Transfer> finished = std::move(*it);
+
+		m_transfers.erase(it);
+
+		::curl_multi_remove_handle(m_multi, finished->curl);
+
+		// 接続は multi ハンドルの接続キャッシュに残るので、ハンドル自体は次のリクエストに使い回せる
+		m_idleHandles.push_back(finished->curl);
+
+		::curl_slist_free_all(finished->headerList);
+
+		Complete(finished->request, status, std::move(finished->responseHeaders));
+	}
+
+	void HTTPClient::SetupHandle(Transfer& transfer, void* share)
+	{
+		::CURL* curl = transfer.curl;
+
+		const Request& request = transfer.request;
+
+		for (const auto& header : request.headers)
+		{
+			transfer.headerList = ::curl_slist_append(transfer.headerList, header.c_str());
+		}
+
+		::curl_easy_setopt(curl, ::CURLOPT_URL, request.url.c_str());
+		::curl_easy_setopt(curl, ::CURLOPT_FOLLOWLOCATION, 1L);
+		::curl_easy_setopt(curl, ::CURLOPT_HTTPHEADER, transfer.headerList);
+		::curl_easy_setopt(curl, ::CURLOPT_NOSIGNAL, 1L);
+		::curl_easy_setopt(curl, ::CURLOPT_TCP_KEEPALIVE, 1L);
+		::curl_easy_setopt(curl, ::CURLOPT_PRIVATE, &transfer);
+
+		if (share)
+		{
+			::curl_easy_setopt(curl, ::CURLOPT_SHARE, share);
+		}
+
+		if (request.isPost)
+		{
+			::curl_easy_setopt(curl, ::CURLOPT_POST, 1L);
+			::curl_easy_setopt(curl, ::CURLOPT_POSTFIELDS, static_cast<const char*>(request.postData));
+			::curl_easy_setopt(curl, ::CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(request.postSize));
+		}
+
+		::curl_easy_setopt(curl, ::CURLOPT_WRITEFUNCTION, detail::HTTPClientWriteCallback);
+		::curl_easy_setopt(curl, ::CURLOPT_WRITEDATA, request.writer);
+		::curl_easy_setopt(curl, ::CURLOPT_HEADERFUNCTION, detail::HTTPClientHeaderCallback);
+		::curl_easy_setopt(curl, ::CURLOPT_HEADERDATA, &transfer.responseHeaders);
+		::curl_easy_setopt(curl, ::CURLOPT_XFERINFOFUNCTION, detail::HTTPClientProgressCallback);
+		::curl_easy_setopt(curl, ::CURLOPT_XFERINFODATA, &request);
+		::curl_easy_setopt(curl, ::CURLOPT_NOPROGRESS, 0L);
+	}
+
+	void HTTPClient::Complete(Request& request, const HTTPAsyncStatus status, std::string&& responseHeaders)
+	{
+		if (request.onComplete)
+		{
+			request.onComplete(status, std::move(responseHeaders));
+		}
+	}
+}
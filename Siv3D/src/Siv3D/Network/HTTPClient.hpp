@@ -0,0 +1,174 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <algorithm>
+# include <atomic>
+# include <mutex>
+# include <thread>
+# include <functional>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/IWriter.hpp>
+# include <Siv3D/HTTPAsyncStatus.hpp>
+
+namespace s3d
+{
+	/// @brief すべての HTTP リクエストを 1 つの curl multi ハンドルと 1 つのスレッドで処理するクライアント
+	/// @remark 接続は multi ハンドルの接続キャッシュに残り、同じホストへの後続のリクエストで再利用されます。
+	/// 同時に転送するリクエストの数には上限があり、上限を超えたリクエストは優先度順に待機します（Request::immediate が true のものを除く）。
+	class HTTPClient
+	{
+	public:
+
+		/// @brief 同時に転送するリクエストの数の既定の上限
+		static constexpr size_t DefaultMaxConcurrency = 8;
+
+		/// @brief リクエスト
+		struct Request
+		{
+			/// @brief URL (UTF-8)
+			std::string url;
+
+			/// @brief "Key: Value" 形式のヘッダ
+			Array<std::string> headers;
+
+			bool isPost = false;
+
+			/// @brief POST で送るデータ。転送が完了するまで有効である必要があります。
+			const void* postData = nullptr;
+
+			size_t postSize = 0;
+
+			/// @brief レスポンスのボディの書き込み先。転送が完了するまで有効である必要があります。
+			IWriter* writer = nullptr;
+
+			/// @brief 優先度。値が大きいほど先に転送を開始します。
+			int32 priority = 0;
+
+			/// @brief true の場合、同時に転送する数の上限と優先度の待機列を経由せず、すぐに転送を開始します。
+			/// @remark 完了を待ってブロックする同期版のリクエストに使います。クライアントのスレッドから追加された場合は、submit() の中で転送を完了させます。
+			bool immediate = false;
+
+			/// @brief true になると転送を中断します。nullptr の場合は中断しません。
+			const std::atomic<bool>* abort = nullptr;
+
+			/// @brief 進捗の通知 (dlTotal, dlNow, ulTotal, ulNow)
+			std::function<void(int64, int64, int64, int64)> onProgress;
+
+			/// @brief 完了の通知 (Succeeded, Failed, Canceled のいずれか, レスポンスヘッダ)
+			/// @remark クライアントのスレッドから、最後に 1 度だけ呼ばれます。
+			std::function<void(HTTPAsyncStatus, std::string&&)> onComplete;
+		};
+
+		HTTPClient();
+
+		~HTTPClient();
+
+		/// @brief リクエストを追加します。最初の追加時にスレッドを開始します。
+		/// @param request リクエスト
+		void submit(Request&& request);
+
+		/// @brief Request::abort を true にしたことを通知し、中断されたリクエストをすぐに取り除かせます。
+		void notifyAbort();
+
+		void setMaxConcurrency(size_t maxConcurrency);
+
+		[[nodiscard]]
+		size_t getMaxConcurrency() const;
+
+		/// @brief スレッドを終了し、残っているリクエストをすべて Canceled で完了させます。
+		/// @remark curl_global_cleanup() の前に呼ぶ必要があります。
+		void shutdown();
+
+	private:
+
+		struct Pending
+		{
+			uint64 sequence = 0;
+
+			Request request;
+		};
+
+		/// @brief 優先度が高く、先に追加されたものを先頭にするヒープの比較
+		struct PendingCompare
+		{
+			[[nodiscard]]
+			bool operator ()(const Pending& a, const Pending& b) const noexcept
+			{
+				if (a.request.priority != b.request.priority)
+				{
+					return (a.request.priority < b.request.priority);
+				}
+
+				return (b.sequence < a.sequence);
+			}
+		};
+
+		/// @brief 転送中のリクエスト
+		struct Transfer;
+
+		/// @brief 接続や中断を確認する最大の間隔 [ミリ秒]
+		static constexpr int32 PollIntervalMillisec = 100;
+
+		mutable std::mutex m_mutex;
+
+		Array<Pending> m_pending;
+
+		/// @brief 上限と待機列を経由せずに開始するリクエスト
+		Array<Request> m_immediate;
+
+		uint64 m_sequence = 0;
+
+		size_t m_maxConcurrency = DefaultMaxConcurrency;
+
+		bool m_stop = false;
+
+		std::atomic<bool> m_abortRequested{ false };
+
+		std::thread m_thread;
+
+		// 以下はスレッドだけが触れる
+		// （ハンドルの作成と破棄はスレッドの開始前と終了後に行う）
+
+		/// @brief CURLM*
+		void* m_multi = nullptr;
+
+		/// @brief CURLSH*（TLS セッションと DNS キャッシュを共有する）
+		void* m_share = nullptr;
+
+		/// @brief 再利用する CURL*
+		Array<void*> m_idleHandles;
+
+		Array<std::unique_ptr<Transfer>> m_transfers;
+
+		void run();
+
+		void startTransfers();
+
+		/// @brief multi ハンドルでの転送を開始します。開始できない場合は Failed で完了させます。
+		void startTransfer(Request&& request);
+
+		/// @brief クライアントのスレッドで、リクエストの転送を完了まで行います。
+		void performOnClientThread(Request&& request);
+
+		[[nodiscard]]
+		void* acquireHandle();
+
+		void removeAborted();
+
+		void finish(Transfer* transfer, HTTPAsyncStatus status);
+
+		static void SetupHandle(Transfer& transfer, void* share);
+
+		static void Complete(Request& request, HTTPAsyncStatus status, std::string&& responseHeaders = {});
+	};
+}
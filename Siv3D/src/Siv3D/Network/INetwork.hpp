@@ -10,10 +10,14 @@
 //-----------------------------------------------
 
 # pragma once
+# include <memory>
 # include <Siv3D/Common.hpp>
 
 namespace s3d
 {
+	class TCPBufferPool;
+	class HTTPClient;
+
 	class SIV3D_NOVTABLE ISiv3DNetwork
 	{
 	public:
@@ -23,5 +27,13 @@ namespace s3d
 		virtual ~ISiv3DNetwork() = default;
 
 		virtual void init() = 0;
+
+		virtual const std::shared_ptr<TCPBufferPool>& getTCPBufferPool() noexcept = 0;
+
+	# if not SIV3D_PLATFORM(WEB)
+
+		virtual HTTPClient& getHTTPClient() noexcept = 0;
+
+	# endif
 	};
 }
@@ -0,0 +1,357 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Common/Siv3DEngine.hpp>
+# include "INetwork.hpp"
+# include "TCPBuffer.hpp"
+
+namespace s3d
+{
+	namespace
+	{
+		[[nodiscard]]
+		static std::shared_ptr<TCPBufferPool> GetPool()
+		{
+			// エンジンの終了後に作られたバッファは、プールを共有しない
+			if (not Siv3DEngine::isActive())
+			{
+				return std::make_shared<TCPBufferPool>();
+			}
+
+			return SIV3D_ENGINE(Network)->getTCPBufferPool();
+		}
+	}
+
+	Array<Byte> TCPBufferPool::acquire()
+	{
+		{
+			std::lock_guard lock{ m_mutex };
+
+			if (m_blocks)
+			{
+				Array<Byte> block = std::move(m_blocks.back());
+				m_blocks.pop_back();
+				return block;
+			}
+		}
+
+		return Array<Byte>(BlockSize);
+	}
+
+	void TCPBufferPool::release(Array<Byte>&& block)
+	{
+		if (block.size() != BlockSize)
+		{
+			return;
+		}
+
+		std::lock_guard lock{ m_mutex };
+
+		if (m_blocks.size() < MaxPooledBlocks)
+		{
+			m_blocks.push_back(std::move(block));
+		}
+	}
+
+	namespace detail
+	{
+		////////////////////////////////////////////////////////////////
+		//
+		//	TCPReceiveBuffer
+		//
+		////////////////////////////////////////////////////////////////
+
+		TCPReceiveBuffer::TCPReceiveBuffer(const size_t maxSize)
+			: m_maxSize{ maxSize }
+			, m_pool{ GetPool() } {}
+
+		TCPReceiveBuffer::~TCPReceiveBuffer()
+		{
+			if (m_buffer)
+			{
+				m_pool->release(std::move(m_buffer));
+			}
+		}
+
+		size_t TCPReceiveBuffer::size() const noexcept
+		{
+			return m_size;
+		}
+
+		std::pair<Byte*, size_t> TCPReceiveBuffer::prepare()
+		{
+			if (not m_buffer)
+			{
+				m_buffer = m_pool->acquire();
+			}
+
+			if (m_size == m_buffer.size())
+			{
+				const size_t newCapacity = (m_buffer.size() * 2);
+
+				if (m_maxSize < newCapacity)
+				{
+					return{ nullptr, 0 };
+				}
+
+				grow(newCapacity);
+			}
+
+			if (m_size == 0)
+			{
+				m_head = 0;
+			}
+
+			const size_t capacity = m_buffer.size();
+			const size_t tail = ((m_head + m_size) & (capacity - 1));
+
+			if (m_head <= tail)
+			{
+				return{ (m_buffer.data() + tail), (capacity - tail) };
+			}
+			else
+			{
+				return{ (m_buffer.data() + tail), (m_head - tail) };
+			}
+		}
+
+		void TCPReceiveBuffer::commit(const size_t size) noexcept
+		{
+			assert((m_size + size) <= m_buffer.size());
+
+			m_size += size;
+		}
+
+		bool TCPReceiveBuffer::skip(const size_t size) noexcept
+		{
+			if (m_size < size)
+			{
+				return false;
+			}
+
+			if (size == 0)
+			{
+				return true;
+			}
+
+			m_head = ((m_head + size) & (m_buffer.size() - 1));
+			m_size -= size;
+
+			return true;
+		}
+
+		bool TCPReceiveBuffer::lookahead(void* dst, const size_t size) const noexcept
+		{
+			if (m_size < size)
+			{
+				return false;
+			}
+
+			copyOut(dst, size);
+
+			return true;
+		}
+
+		bool TCPReceiveBuffer::read(void* dst, const size_t size) noexcept
+		{
+			if (not lookahead(dst, size))
+			{
+				return false;
+			}
+
+			return skip(size);
+		}
+
+		bool TCPReceiveBuffer::hasMessage() const noexcept
+		{
+			uint32 messageSize;
+
+			if (not lookahead(&messageSize, sizeof(messageSize)))
+			{
+				return false;
+			}
+
+			return ((TCPMessageHeaderSize + messageSize) <= m_size);
+		}
+
+		bool TCPReceiveBuffer::readMessage(Array<Byte>& message)
+		{
+			if (not hasMessage())
+			{
+				return false;
+			}
+
+			uint32 messageSize;
+
+			read(&messageSize, sizeof(messageSize));
+
+			message.resize(messageSize);
+
+			return read(message.data(), messageSize);
+		}
+
+		void TCPReceiveBuffer::clear() noexcept
+		{
+			m_head = 0;
+			m_size = 0;
+		}
+
+		void TCPReceiveBuffer::copyOut(void* dst, const size_t size) const noexcept
+		{
+			if (size == 0)
+			{
+				return;
+			}
+
+			// リングの終端で 2 回に分けてコピーする
+			const size_t firstSize = Min(size, (m_buffer.size() - m_head));
+
+			std::memcpy(dst, (m_buffer.data() + m_head), firstSize);
+
+			if (firstSize < size)
+			{
+				std::memcpy((static_cast<Byte*>(dst) + firstSize), m_buffer.data(), (size - firstSize));
+			}
+		}
+
+		void TCPReceiveBuffer::grow(const size_t newCapacity)
+		{
+			Array<Byte> newBuffer(newCapacity);
+
+			copyOut(newBuffer.data(), m_size);
+
+			m_pool->release(std::move(m_buffer));
+
+			m_buffer = std::move(newBuffer);
+			m_head = 0;
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	TCPSendQueue
+		//
+		////////////////////////////////////////////////////////////////
+
+		TCPSendQueue::TCPSendQueue()
+			: m_pool{ GetPool() } {}
+
+		TCPSendQueue::~TCPSendQueue()
+		{
+			clear();
+		}
+
+		bool TCPSendQueue::isEmpty() const noexcept
+		{
+			return (m_size == 0);
+		}
+
+		size_t TCPSendQueue::size() const noexcept
+		{
+			return m_size;
+		}
+
+		void TCPSendQueue::push(const void* data, size_t size)
+		{
+			const Byte* src = static_cast<const Byte*>(data);
+
+			while (size)
+			{
+				if (m_chunks.empty() || (m_chunks.back().end == m_chunks.back().data.size()))
+				{
+					m_chunks.push_back(Chunk{ m_pool->acquire() });
+				}
+
+				Chunk& chunk = m_chunks.back();
+				const size_t copySize = Min(size, (chunk.data.size() - chunk.end));
+
+				std::memcpy((chunk.data.data() + chunk.end), src, copySize);
+
+				chunk.end += copySize;
+				src += copySize;
+				size -= copySize;
+				m_size += copySize;
+			}
+		}
+
+		void TCPSendQueue::pushMessage(const void* data, const size_t size)
+		{
+			assert(size <= TCPMaxMessageSize);
+
+			const uint32 messageSize = static_cast<uint32>(size);
+
+			push(&messageSize, sizeof(messageSize));
+
+			push(data, size);
+		}
+
+		size_t TCPSendQueue::gather(Region* regions, const size_t maxRegions) const noexcept
+		{
+			size_t count = 0;
+
+			for (const auto& chunk : m_chunks)
+			{
+				if (maxRegions <= count)
+				{
+					break;
+				}
+
+				if (chunk.begin < chunk.end)
+				{
+					regions[count++] = { (chunk.data.data() + chunk.begin), (chunk.end - chunk.begin) };
+				}
+			}
+
+			return count;
+		}
+
+		void TCPSendQueue::consume(size_t size)
+		{
+			assert(size <= m_size);
+
+			while (size && (not m_chunks.empty()))
+			{
+				Chunk& chunk = m_chunks.front();
+				const size_t consumeSize = Min(size, (chunk.end - chunk.begin));
+
+				chunk.begin += consumeSize;
+				size -= consumeSize;
+				m_size -= consumeSize;
+
+				if (chunk.begin < chunk.end)
+				{
+					break;
+				}
+
+				if (1 < m_chunks.size())
+				{
+					m_pool->release(std::move(chunk.data));
+					m_chunks.pop_front();
+				}
+				else
+				{
+					// 最後のブロックは次の送信のために残す
+					chunk.begin = chunk.end = 0;
+				}
+			}
+		}
+
+		void TCPSendQueue::clear()
+		{
+			for (auto& chunk : m_chunks)
+			{
+				m_pool->release(std::move(chunk.data));
+			}
+
+			m_chunks.clear();
+			m_size = 0;
+		}
+	}
+}
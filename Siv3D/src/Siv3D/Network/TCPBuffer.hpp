@@ -0,0 +1,197 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <mutex>
+# include <deque>
+# include <memory>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Byte.hpp>
+
+namespace s3d
+{
+	/// @brief TCP の送受信バッファに使う、固定サイズのメモリブロックのプール
+	/// @remark セッションの作成と破棄を繰り返しても、メモリの確保と解放が起こらないようにします。
+	class TCPBufferPool
+	{
+	public:
+
+		/// @brief メモリブロック 1 つのサイズ（バイト）
+		static constexpr size_t BlockSize = (64 * 1024);
+
+		/// @brief プールに保持するメモリブロックの最大数
+		static constexpr size_t MaxPooledBlocks = 256;
+
+		/// @brief メモリブロックを取得します。
+		/// @return サイズが BlockSize のメモリブロック
+		[[nodiscard]]
+		Array<Byte> acquire();
+
+		/// @brief メモリブロックをプールに戻します。
+		/// @param block メモリブロック。サイズが BlockSize でない場合は単に解放されます。
+		void release(Array<Byte>&& block);
+
+	private:
+
+		std::mutex m_mutex;
+
+		Array<Array<Byte>> m_blocks;
+	};
+
+	namespace detail
+	{
+		/// @brief メッセージの先頭に付けるヘッダ（メッセージのサイズを表す uint32）のサイズ
+		inline constexpr size_t TCPMessageHeaderSize = sizeof(uint32);
+
+		/// @brief 送受信できるメッセージの最大サイズ（バイト）
+		inline constexpr size_t TCPMaxMessageSize = (16 * 1024 * 1024);
+
+		/// @brief 受信したデータを保持するリングバッファ
+		/// @remark 受信スレッドは prepare() で得た領域にソケットから直接書き込み、commit() で確定します。
+		/// 読み出し側とは書き込み中の領域を共有しないため、commit() 以外の操作だけをロックで保護すれば十分です。
+		/// 容量は BlockSize から始まり、満杯になるたびに maxSize まで倍に増えます。
+		class TCPReceiveBuffer
+		{
+		public:
+
+			explicit TCPReceiveBuffer(size_t maxSize);
+
+			~TCPReceiveBuffer();
+
+			TCPReceiveBuffer(const TCPReceiveBuffer&) = delete;
+
+			TCPReceiveBuffer& operator =(const TCPReceiveBuffer&) = delete;
+
+			/// @brief 読み出し可能なデータのサイズ（バイト）を返します。
+			[[nodiscard]]
+			size_t size() const noexcept;
+
+			/// @brief 次に受信したデータを書き込む、連続した領域を返します。
+			/// @remark 空き領域が無い場合はバッファを拡張します。拡張できない場合は { nullptr, 0 } を返します。
+			/// @return 書き込み先の領域とそのサイズ
+			[[nodiscard]]
+			std::pair<Byte*, size_t> prepare();
+
+			/// @brief prepare() で得た領域に書き込んだデータを確定します。
+			/// @param size 書き込んだサイズ（バイト）
+			void commit(size_t size) noexcept;
+
+			bool skip(size_t size) noexcept;
+
+			bool lookahead(void* dst, size_t size) const noexcept;
+
+			bool read(void* dst, size_t size) noexcept;
+
+			/// @brief 先頭に、ヘッダとデータがすべて揃ったメッセージがあるかを返します。
+			[[nodiscard]]
+			bool hasMessage() const noexcept;
+
+			/// @brief 先頭のメッセージを取り出します。
+			/// @param message メッセージのデータの格納先
+			/// @return メッセージを取り出した場合 true, 揃ったメッセージが無い場合は false
+			bool readMessage(Array<Byte>& message);
+
+			void clear() noexcept;
+
+		private:
+
+			/// @brief 容量は常に 2 のべき乗
+			Array<Byte> m_buffer;
+
+			size_t m_maxSize = 0;
+
+			/// @brief 読み出し位置
+			size_t m_head = 0;
+
+			/// @brief 読み出し可能なデータのサイズ
+			size_t m_size = 0;
+
+			/// @brief メモリブロックの取得元
+			std::shared_ptr<TCPBufferPool> m_pool;
+
+			void copyOut(void* dst, size_t size) const noexcept;
+
+			void grow(size_t newCapacity);
+		};
+
+		/// @brief 送信待ちのデータを保持するキュー
+		/// @remark データは TCPBufferPool のメモリブロックにまとめて詰め、送信時には複数のブロックを 1 回の書き込みで送ります。
+		/// 送信中の領域の後ろへの追加は、送信中のデータを書き換えないため、いつでも行えます。
+		class TCPSendQueue
+		{
+		public:
+
+			/// @brief 送信待ちのデータの、連続した 1 つの領域
+			struct Region
+			{
+				const Byte* data = nullptr;
+
+				size_t size = 0;
+			};
+
+			TCPSendQueue();
+
+			~TCPSendQueue();
+
+			TCPSendQueue(const TCPSendQueue&) = delete;
+
+			TCPSendQueue& operator =(const TCPSendQueue&) = delete;
+
+			[[nodiscard]]
+			bool isEmpty() const noexcept;
+
+			/// @brief 送信待ちのデータのサイズ（バイト）を返します。
+			[[nodiscard]]
+			size_t size() const noexcept;
+
+			/// @brief データを末尾に追加します。
+			/// @param data データの先頭ポインタ
+			/// @param size データのサイズ（バイト）
+			void push(const void* data, size_t size);
+
+			/// @brief ヘッダを付けたメッセージを末尾に追加します。
+			/// @param data メッセージのデータの先頭ポインタ
+			/// @param size メッセージのサイズ（バイト）。TCPMaxMessageSize 以下である必要があります。
+			void pushMessage(const void* data, size_t size);
+
+			/// @brief 先頭から最大 maxRegions 個の領域を取得します。
+			/// @param regions 領域の格納先
+			/// @param maxRegions 取得する領域の最大数
+			/// @return 取得した領域の数
+			size_t gather(Region* regions, size_t maxRegions) const noexcept;
+
+			/// @brief 送信が完了したデータを先頭から取り除きます。
+			/// @param size 送信が完了したサイズ（バイト）
+			void consume(size_t size);
+
+			void clear();
+
+		private:
+
+			struct Chunk
+			{
+				Array<Byte> data;
+
+				size_t begin = 0;
+
+				size_t end = 0;
+			};
+
+			std::deque<Chunk> m_chunks;
+
+			size_t m_size = 0;
+
+			/// @brief メモリブロックの取得元
+			std::shared_ptr<TCPBufferPool> m_pool;
+		};
+	}
+}
@@ -0,0 +1,219 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <bit>
+# include <atomic>
+# include <Siv3D/SIMD.hpp>
+# include <Siv3D/Threading.hpp>
+# include "ParticleBuffer2D.hpp"
+
+namespace s3d
+{
+	size_t ParticleBuffer2D::size() const noexcept
+	{
+		return remainingLifeTime.size();
+	}
+
+	bool ParticleBuffer2D::isEmpty() const noexcept
+	{
+		return remainingLifeTime.isEmpty();
+	}
+
+	void ParticleBuffer2D::push_back(const Particle2D& particle)
+	{
+		positionX << particle.position.x;
+		positionY << particle.position.y;
+		velocityX << particle.velocity.x;
+		velocityY << particle.velocity.y;
+		startColor << particle.startColor;
+		startSize << particle.startSize;
+		rotation << particle.rotation;
+		startAngularVelocity << particle.startAngularVelocity;
+		startLifeTime << particle.startLifeTime;
+		remainingLifeTime << particle.remainingLifeTime;
+	}
+
+	Particle2D ParticleBuffer2D::getParticle(const size_t index) const noexcept
+	{
+		Particle2D particle;
+		particle.position				= Float2{ positionX[index], positionY[index] };
+		particle.velocity				= Float2{ velocityX[index], velocityY[index] };
+		particle.startColor				= startColor[index];
+		particle.startSize				= startSize[index];
+		particle.rotation				= rotation[index];
+		particle.startAngularVelocity	= startAngularVelocity[index];
+		particle.startLifeTime			= startLifeTime[index];
+		particle.remainingLifeTime		= remainingLifeTime[index];
+		return particle;
+	}
+
+	void ParticleBuffer2D::update(const float deltaTime, const Float2& deltaVelocity)
+	{
+		const size_t count = size();
+		size_t deadCount = 0;
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if ((ParallelUpdateThreshold <= count) && (0 < Threading::GetWorkerCount()))
+		{
+			std::atomic<size_t> totalDeadCount{ 0 };
+
+			Threading::ParallelFor(0, count, [&](const size_t first, const size_t last)
+			{
+				totalDeadCount.fetch_add(updateRange(first, last, deltaTime, deltaVelocity), std::memory_order_relaxed);
+			}, (ParallelUpdateThreshold / 4));
+
+			deadCount = totalDeadCount.load(std::memory_order_relaxed);
+		}
+		else
+		{
+			deadCount = updateRange(0, count, deltaTime, deltaVelocity);
+		}
+
+	# else
+
+		deadCount = updateRange(0, count, deltaTime, deltaVelocity);
+
+	# endif
+
+		if (deadCount)
+		{
+			removeDead();
+		}
+	}
+
+	void ParticleBuffer2D::removeOldest(const size_t count)
+	{
+		if (size() <= count)
+		{
+			positionX.clear();
+			positionY.clear();
+			velocityX.clear();
+			velocityY.clear();
+			startColor.clear();
+			startSize.clear();
+			rotation.clear();
+			startAngularVelocity.clear();
+			startLifeTime.clear();
+			remainingLifeTime.clear();
+			return;
+		}
+
+		positionX.pop_front_N(count);
+		positionY.pop_front_N(count);
+		velocityX.pop_front_N(count);
+		velocityY.pop_front_N(count);
+		startColor.pop_front_N(count);
+		startSize.pop_front_N(count);
+		rotation.pop_front_N(count);
+		startAngularVelocity.pop_front_N(count);
+		startLifeTime.pop_front_N(count);
+		remainingLifeTime.pop_front_N(count);
+	}
+
+	size_t ParticleBuffer2D::updateRange(const size_t first, const size_t last, const float deltaTime, const Float2& deltaVelocity) noexcept
+	{
+		float* pPositionX		= positionX.data();
+		float* pPositionY		= positionY.data();
+		float* pVelocityX		= velocityX.data();
+		float* pVelocityY		= velocityY.data();
+		float* pRotation		= rotation.data();
+		float* pRemaining		= remainingLifeTime.data();
+		const float* pAngularVelocity = startAngularVelocity.data();
+
+		size_t deadCount = 0;
+		size_t i = first;
+
+	# if SIV3D_INTRINSIC(SSE)
+
+		{
+			const __m128 dt		= ::_mm_set1_ps(deltaTime);
+			const __m128 dvx	= ::_mm_set1_ps(deltaVelocity.x);
+			const __m128 dvy	= ::_mm_set1_ps(deltaVelocity.y);
+			const __m128 zero	= ::_mm_setzero_ps();
+
+			for (; (i + 4) <= last; i += 4)
+			{
+				const __m128 remaining = ::_mm_sub_ps(::_mm_loadu_ps(pRemaining + i), dt);
+				::_mm_storeu_ps((pRemaining + i), remaining);
+
+				const __m128 vx = ::_mm_add_ps(::_mm_loadu_ps(pVelocityX + i), dvx);
+				const __m128 vy = ::_mm_add_ps(::_mm_loadu_ps(pVelocityY + i), dvy);
+				::_mm_storeu_ps((pVelocityX + i), vx);
+				::_mm_storeu_ps((pVelocityY + i), vy);
+
+				::_mm_storeu_ps((pPositionX + i), ::_mm_add_ps(::_mm_loadu_ps(pPositionX + i), ::_mm_mul_ps(vx, dt)));
+				::_mm_storeu_ps((pPositionY + i), ::_mm_add_ps(::_mm_loadu_ps(pPositionY + i), ::_mm_mul_ps(vy, dt)));
+				::_mm_storeu_ps((pRotation + i), ::_mm_add_ps(::_mm_loadu_ps(pRotation + i), ::_mm_mul_ps(::_mm_loadu_ps(pAngularVelocity + i), dt)));
+
+				const int32 deadMask = ::_mm_movemask_ps(::_mm_cmplt_ps(remaining, zero));
+				deadCount += static_cast<size_t>(std::popcount(static_cast<uint32>(deadMask)));
+			}
+		}
+
+	# endif
+
+		for (; i < last; ++i)
+		{
+			pRemaining[i] -= deltaTime;
+			pVelocityX[i] += deltaVelocity.x;
+			pVelocityY[i] += deltaVelocity.y;
+			pPositionX[i] += (pVelocityX[i] * deltaTime);
+			pPositionY[i] += (pVelocityY[i] * deltaTime);
+			pRotation[i] += (pAngularVelocity[i] * deltaTime);
+			deadCount += (pRemaining[i] < 0.0f);
+		}
+
+		return deadCount;
+	}
+
+	void ParticleBuffer2D::removeDead()
+	{
+		// 描画順と古い順を保つため、生きているパーティクルを前に詰める
+		const size_t count = size();
+		size_t alive = 0;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (remainingLifeTime[i] < 0.0f)
+			{
+				continue;
+			}
+
+			if (alive != i)
+			{
+				positionX[alive]			= positionX[i];
+				positionY[alive]			= positionY[i];
+				velocityX[alive]			= velocityX[i];
+				velocityY[alive]			= velocityY[i];
+				startColor[alive]			= startColor[i];
+				startSize[alive]			= startSize[i];
+				rotation[alive]				= rotation[i];
+				startAngularVelocity[alive]	= startAngularVelocity[i];
+				startLifeTime[alive]		= startLifeTime[i];
+				remainingLifeTime[alive]	= remainingLifeTime[i];
+			}
+
+			++alive;
+		}
+
+		positionX.resize(alive);
+		positionY.resize(alive);
+		velocityX.resize(alive);
+		velocityY.resize(alive);
+		startColor.resize(alive);
+		startSize.resize(alive);
+		rotation.resize(alive);
+		startAngularVelocity.resize(alive);
+		startLifeTime.resize(alive);
+		remainingLifeTime.resize(alive);
+	}
+}
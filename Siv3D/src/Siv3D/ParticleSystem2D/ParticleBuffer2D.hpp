@@ -0,0 +1,76 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/PointVector.hpp>
+# include <Siv3D/Particle2D.hpp>
+
+namespace s3d
+{
+	/// @brief パーティクルを要素ごとの配列（SoA）で保持するバッファ
+	/// @remark パーティクルは生成された順に並んでいます。
+	struct ParticleBuffer2D
+	{
+		/// @brief この数以上のパーティクルを更新する場合、ワーカースレッドで並列に処理します。
+		static constexpr size_t ParallelUpdateThreshold = 65536;
+
+		Array<float> positionX;
+
+		Array<float> positionY;
+
+		Array<float> velocityX;
+
+		Array<float> velocityY;
+
+		Array<Float4> startColor;
+
+		Array<float> startSize;
+
+		Array<float> rotation;
+
+		Array<float> startAngularVelocity;
+
+		Array<float> startLifeTime;
+
+		Array<float> remainingLifeTime;
+
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		void push_back(const Particle2D& particle);
+
+		/// @brief 指定したインデックスのパーティクルを返します。
+		[[nodiscard]]
+		Particle2D getParticle(size_t index) const noexcept;
+
+		/// @brief すべてのパーティクルの位置、速度、回転、残り寿命を更新し、寿命が尽きたパーティクルを取り除きます。
+		/// @param deltaTime 経過時間（秒）
+		/// @param deltaVelocity 速度の変化量
+		void update(float deltaTime, const Float2& deltaVelocity);
+
+		/// @brief 古い順にパーティクルを取り除きます。
+		/// @param count 取り除くパーティクルの数
+		void removeOldest(size_t count);
+
+	private:
+
+		/// @brief [first, last) の範囲のパーティクルを更新します。
+		/// @return 寿命が尽きたパーティクルの数
+		size_t updateRange(size_t first, size_t last, float deltaTime, const Float2& deltaVelocity) noexcept;
+
+		void removeDead();
+	};
+}
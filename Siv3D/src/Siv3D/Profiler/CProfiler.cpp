@@ -9,6 +9,7 @@
 //
 //-----------------------------------------------
 
+# include <cmath>
 # include <Siv3D/String.hpp>
 # include <Siv3D/PointVector.hpp>
 # include <Siv3D/FormatLiteral.hpp>
@@ -16,6 +17,8 @@
 # include <Siv3D/Time.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/GlobalAudio.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/Unicode.hpp>
 # include <Siv3D/Window/IWindow.hpp>
 # include <Siv3D/Renderer/IRenderer.hpp>
 # include <Siv3D/Renderer2D/IRenderer2D.hpp>
@@ -24,14 +27,91 @@
 # include <Siv3D/Audio/IAudio.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "CProfiler.hpp"
+# include "ProfilerZoneRecorder.hpp"
 
 namespace s3d
 {
+	namespace
+	{
+		/// @brief ナノ秒を、Chrome のトレース形式の時刻の単位（マイクロ秒）で追加します。
+		static void AppendMicrosec(std::string& json, const uint64 nanosec)
+		{
+			const std::string fraction = std::to_string(nanosec % 1000);
+
+			json += std::to_string(nanosec / 1000);
+			json += '.';
+			json.append((3 - fraction.size()), '0');
+			json += fraction;
+		}
+
+		static void AppendEscaped(std::string& json, const std::string& s)
+		{
+			constexpr char Hex[] = "0123456789ABCDEF";
+
+			json += '"';
+
+			for (const char ch : s)
+			{
+				if ((ch == '"') || (ch == '\\'))
+				{
+					json += '\\';
+					json += ch;
+				}
+				else if (static_cast<unsigned char>(ch) < 0x20)
+				{
+					json += "\\u00";
+					json += Hex[ch >> 4];
+					json += Hex[ch & 0xF];
+				}
+				else
+				{
+					json += ch;
+				}
+			}
+
+			json += '"';
+		}
+
+		static void AppendEvent(std::string& json, const std::string& escapedName, const uint32 threadIndex, const uint64 beginNanosec, const uint64 endNanosec)
+		{
+			json += ",\n{\"name\":";
+			json += escapedName;
+			json += ",\"ph\":\"X\",\"pid\":1,\"tid\":";
+			json += std::to_string(threadIndex);
+			json += ",\"ts\":";
+			AppendMicrosec(json, beginNanosec);
+			json += ",\"dur\":";
+			AppendMicrosec(json, (endNanosec - beginNanosec));
+			json += '}';
+		}
+
+		static void AppendThreadName(std::string& json, const uint32 threadIndex, const String& name)
+		{
+			json += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+			json += std::to_string(threadIndex);
+			json += ",\"args\":{\"name\":";
+			AppendEscaped(json, name.toUTF8());
+			json += "}}";
+		}
+
+		/// @brief 昇順に並んだ values の p パーセンタイル（nearest-rank 法）を返します。
+		[[nodiscard]]
+		static double Percentile(const Array<double>& values, const double p)
+		{
+			const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+
+			return values[Clamp<size_t>(rank, 1, values.size()) - 1];
+		}
+	}
+
 	void CProfiler::init()
 	{
 		LOG_SCOPED_TRACE(U"CProfiler::init()");
 
 		m_fpsTimestampMillisec = Time::GetMillisec();
+
+		ProfilerZoneRecorder& recorder = ProfilerZoneRecorder::Get();
+		recorder.setThreadName(ProfilerZoneRecorder::GetCurrentThreadIndex(), U"Main");
 	}
 
 	void CProfiler::beginFrame()
@@ -51,12 +131,26 @@ namespace s3d
 			}
 		}
 
+		// Frame time
+		{
+			const uint64 timestampNanosec = Time::GetNanosec();
+
+			if (m_frameBeginNanosec != 0)
+			{
+				m_frames[m_frameCount % m_frames.size()] = { m_frameCount, m_frameBeginNanosec, timestampNanosec };
+				++m_frameCount;
+			}
+
+			m_frameBeginNanosec = timestampNanosec;
+		}
+
 		// Stat
 		{
 			{
 				const auto stat = SIV3D_ENGINE(Renderer2D)->getStat();
 				m_stat.drawCalls = stat.drawCalls;
 				m_stat.triangleCount = stat.triangleCount;
+				m_stat.uploadedBytes = stat.uploadedBytes;
 			}
 
 			m_stat.textureCount	= static_cast<uint32>(SIV3D_ENGINE(Texture)->getTextureCount());
@@ -92,4 +186,135 @@ namespace s3d
 	{
 		return m_stat;
 	}
+
+	Array<ProfilerZoneRecord> CProfiler::getLastFrameZones() const
+	{
+		if (m_frameCount == 0)
+		{
+			return{};
+		}
+
+		const FrameRecord& frame = getRecordedFrame(numRecordedFrames() - 1);
+
+		Array<ProfilerZoneRecord> zones = ProfilerZoneRecorder::Get().snapshot(frame.beginNanosec);
+
+		zones.remove_if([end = frame.endNanosec](const ProfilerZoneRecord& zone) { return (end <= zone.beginNanosec); });
+
+		return zones;
+	}
+
+	FrameTimeHistogram CProfiler::getFrameTimeHistogram() const
+	{
+		FrameTimeHistogram histogram;
+
+		const size_t frameCount = numRecordedFrames();
+
+		if (frameCount == 0)
+		{
+			return histogram;
+		}
+
+		Array<double> frameTimes(Arg::reserve = frameCount);
+		double sum = 0.0;
+
+		for (size_t i = 0; i < frameCount; ++i)
+		{
+			const FrameRecord& frame = getRecordedFrame(i);
+			const double frameTime = ((frame.endNanosec - frame.beginNanosec) / 1'000'000.0);
+			const size_t bucket = Min(static_cast<size_t>(frameTime / FrameTimeHistogram::BucketWidthMillisec), (FrameTimeHistogram::BucketCount - 1));
+
+			++histogram.counts[bucket];
+			sum += frameTime;
+			frameTimes << frameTime;
+		}
+
+		frameTimes.sort();
+
+		histogram.frameCount	= static_cast<uint32>(frameCount);
+		histogram.minMillisec	= frameTimes.front();
+		histogram.maxMillisec	= frameTimes.back();
+		histogram.meanMillisec	= (sum / frameCount);
+		histogram.p50Millisec	= Percentile(frameTimes, 50.0);
+		histogram.p95Millisec	= Percentile(frameTimes, 95.0);
+		histogram.p99Millisec	= Percentile(frameTimes, 99.0);
+
+		return histogram;
+	}
+
+	bool CProfiler::saveChromeTrace(const FilePathView path) const
+	{
+		const ProfilerZoneRecorder& recorder = ProfilerZoneRecorder::Get();
+		const Array<ProfilerZoneRecord> zones = recorder.snapshot();
+		const HashTable<uint32, String> threadNames = recorder.getThreadNames();
+
+		std::string json;
+		json.reserve(4096 + (zones.size() * 96));
+		json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Siv3D\"}}";
+
+		uint32 threadCount = 0;
+
+		for (const auto& [threadIndex, name] : threadNames)
+		{
+			AppendThreadName(json, threadIndex, name);
+			threadCount = Max(threadCount, (threadIndex + 1));
+		}
+
+		// ゾーンの名前は同じ文字列リテラルを指すので、変換結果をポインタごとに使い回す
+		HashTable<const char32*, std::string> escapedNames;
+
+		for (const auto& zone : zones)
+		{
+			auto it = escapedNames.find(zone.name);
+
+			if (it == escapedNames.end())
+			{
+				std::string escaped;
+				AppendEscaped(escaped, Unicode::ToUTF8(StringView{ zone.name }));
+				it = escapedNames.emplace(zone.name, std::move(escaped)).first;
+			}
+
+			AppendEvent(json, it->second, zone.threadIndex, zone.beginNanosec, zone.endNanosec);
+			threadCount = Max(threadCount, (zone.threadIndex + 1));
+		}
+
+		// フレームは、すべてのスレッドの後ろに専用のトラックを作って並べる
+		if (const size_t frameCount = numRecordedFrames())
+		{
+			const uint32 frameTrack = threadCount;
+			AppendThreadName(json, frameTrack, U"Frames");
+
+			for (size_t i = 0; i < frameCount; ++i)
+			{
+				const FrameRecord& frame = getRecordedFrame(i);
+				std::string name;
+				AppendEscaped(name, "Frame " + std::to_string(frame.frameIndex));
+				AppendEvent(json, name, frameTrack, frame.beginNanosec, frame.endNanosec);
+			}
+		}
+
+		json += "\n]}\n";
+
+		BinaryWriter writer{ path };
+
+		if (not writer)
+		{
+			return false;
+		}
+
+		return (writer.write(json.data(), json.size()) == static_cast<int64>(json.size()));
+	}
+
+	size_t CProfiler::numRecordedFrames() const noexcept
+	{
+		return static_cast<size_t>(Min<uint64>(m_frameCount, m_frames.size()));
+	}
+
+	const CProfiler::FrameRecord& CProfiler::getRecordedFrame(const size_t index) const noexcept
+	{
+		// index 0 が最も古いフレーム
+		const uint64 oldest = (m_frameCount - numRecordedFrames());
+
+		return m_frames[(oldest + index) % m_frames.size()];
+	}
 }
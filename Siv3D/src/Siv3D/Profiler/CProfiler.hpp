@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <array>
 # include "IProfiler.hpp"
 
 namespace s3d
@@ -30,8 +31,23 @@ namespace s3d
 
 		const ProfilerStat& getStat() const override;
 
+		Array<ProfilerZoneRecord> getLastFrameZones() const override;
+
+		FrameTimeHistogram getFrameTimeHistogram() const override;
+
+		bool saveChromeTrace(FilePathView path) const override;
+
 	private:
 
+		struct FrameRecord
+		{
+			uint64 frameIndex = 0;
+
+			uint64 beginNanosec = 0;
+
+			uint64 endNanosec = 0;
+		};
+
 		//
 		//	FPS
 		//
@@ -45,5 +61,22 @@ namespace s3d
 		//	Stat
 		//
 		ProfilerStat m_stat;
+
+		//
+		//	Frame time
+		//
+		std::array<FrameRecord, FrameTimeHistogram::WindowSize> m_frames;
+
+		/// @brief これまでに m_frames に記録したフレームの数
+		uint64 m_frameCount = 0;
+
+		/// @brief 現在のフレームの開始時刻（最初の beginFrame() までは 0）
+		uint64 m_frameBeginNanosec = 0;
+
+		[[nodiscard]]
+		size_t numRecordedFrames() const noexcept;
+
+		[[nodiscard]]
+		const FrameRecord& getRecordedFrame(size_t index) const noexcept;
 	};
 }
@@ -11,7 +11,11 @@
 
 # pragma once
 # include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/StringView.hpp>
 # include <Siv3D/ProfilerStat.hpp>
+# include <Siv3D/ProfilerZone.hpp>
+# include <Siv3D/FrameTimeHistogram.hpp>
 
 namespace s3d
 {
@@ -36,5 +40,11 @@ namespace s3d
 		virtual String getSimpleStatistics() const = 0;
 
 		virtual const ProfilerStat& getStat() const = 0;
+
+		virtual Array<ProfilerZoneRecord> getLastFrameZones() const = 0;
+
+		virtual FrameTimeHistogram getFrameTimeHistogram() const = 0;
+
+		virtual bool saveChromeTrace(FilePathView path) const = 0;
 	};
 }
@@ -0,0 +1,258 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Time.hpp>
+# include "ProfilerZoneRecorder.hpp"
+
+namespace s3d
+{
+	namespace
+	{
+		/// @brief スレッドごとの状態
+		struct ThreadState
+		{
+			ProfilerZoneBuffer* buffer = nullptr;
+
+			uint32 threadIndex = 0;
+
+			uint32 depth = 0;
+
+			bool hasIndex = false;
+
+			~ThreadState()
+			{
+				// 記録は残したまま、新しいスレッドで再利用させる
+				if (buffer)
+				{
+					ProfilerZoneRecorder::Get().releaseBuffer(buffer);
+				}
+			}
+		};
+
+		[[nodiscard]]
+		static ThreadState& GetThreadState() noexcept
+		{
+			thread_local ThreadState state;
+
+			return state;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	ProfilerZoneBuffer
+	//
+	////////////////////////////////////////////////////////////////
+
+	ProfilerZoneBuffer::ProfilerZoneBuffer()
+		: m_records(std::make_unique<Record[]>(Capacity)) {}
+
+	void ProfilerZoneBuffer::record(const char32* name, const uint32 threadIndex, const uint32 depth, const uint64 beginNanosec, const uint64 endNanosec) noexcept
+	{
+		// 書き込むのは所有するスレッドだけなので、位置の更新に read-modify-write は要らない
+		const uint64 position = m_writePosition.load(std::memory_order_relaxed);
+		Record& record = m_records[position % Capacity];
+
+		record.sequence.store(((position * 2) + 1), std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		record.name.store(name, std::memory_order_relaxed);
+		record.header.store((static_cast<uint64>(threadIndex) << 32) | depth, std::memory_order_relaxed);
+		record.beginNanosec.store(beginNanosec, std::memory_order_relaxed);
+		record.endNanosec.store(endNanosec, std::memory_order_relaxed);
+
+		record.sequence.store(((position * 2) + 2), std::memory_order_release);
+		m_writePosition.store((position + 1), std::memory_order_release);
+	}
+
+	void ProfilerZoneBuffer::snapshot(Array<ProfilerZoneRecord>& out, const uint64 endNanosec) const
+	{
+		const uint64 end = m_writePosition.load(std::memory_order_acquire);
+		const uint64 begin = Max(((Capacity < end) ? (end - Capacity) : 0), m_clearPosition.load(std::memory_order_acquire));
+
+		for (uint64 position = begin; position < end; ++position)
+		{
+			const Record& record = m_records[position % Capacity];
+			const uint64 expected = ((position * 2) + 2);
+
+			if (record.sequence.load(std::memory_order_acquire) != expected)
+			{
+				continue;
+			}
+
+			ProfilerZoneRecord zone;
+			zone.name = record.name.load(std::memory_order_relaxed);
+			const uint64 header = record.header.load(std::memory_order_relaxed);
+			zone.threadIndex = static_cast<uint32>(header >> 32);
+			zone.depth = static_cast<uint32>(header & 0xFFFF'FFFF);
+			zone.beginNanosec = record.beginNanosec.load(std::memory_order_relaxed);
+			zone.endNanosec = record.endNanosec.load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			// 読み取り中に上書きされたゾーンは捨てる
+			if (record.sequence.load(std::memory_order_relaxed) != expected)
+			{
+				continue;
+			}
+
+			if (endNanosec < zone.endNanosec)
+			{
+				out << zone;
+			}
+		}
+	}
+
+	void ProfilerZoneBuffer::clear() noexcept
+	{
+		// 書き込み中のスレッドとは競合しないよう、バッファには触れずに読み出しの開始位置だけを進める
+		m_clearPosition.store(m_writePosition.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	ProfilerZoneRecorder
+	//
+	////////////////////////////////////////////////////////////////
+
+	ProfilerZoneRecorder& ProfilerZoneRecorder::Get()
+	{
+		static ProfilerZoneRecorder recorder;
+
+		return recorder;
+	}
+
+	uint32 ProfilerZoneRecorder::GetCurrentThreadIndex()
+	{
+		ThreadState& state = GetThreadState();
+
+		if (not state.hasIndex)
+		{
+			state.threadIndex = Get().newThreadIndex();
+			state.hasIndex = true;
+		}
+
+		return state.threadIndex;
+	}
+
+	uint32 ProfilerZoneRecorder::newThreadIndex()
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return m_threadCount++;
+	}
+
+	ProfilerZoneBuffer* ProfilerZoneRecorder::acquireBuffer()
+	{
+		std::lock_guard lock{ m_mutex };
+
+		if (m_freeBuffers)
+		{
+			ProfilerZoneBuffer* buffer = m_freeBuffers.back();
+			m_freeBuffers.pop_back();
+			return buffer;
+		}
+
+		m_buffers.push_back(std::make_unique<ProfilerZoneBuffer>());
+
+		return m_buffers.back().get();
+	}
+
+	void ProfilerZoneRecorder::releaseBuffer(ProfilerZoneBuffer* buffer)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_freeBuffers.push_back(buffer);
+	}
+
+	void ProfilerZoneRecorder::setThreadName(const uint32 threadIndex, const String& name)
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_threadNames[threadIndex] = name;
+	}
+
+	HashTable<uint32, String> ProfilerZoneRecorder::getThreadNames() const
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return m_threadNames;
+	}
+
+	Array<ProfilerZoneRecord> ProfilerZoneRecorder::snapshot(const uint64 endNanosec) const
+	{
+		Array<ProfilerZoneRecord> zones;
+		{
+			std::lock_guard lock{ m_mutex };
+
+			for (const auto& buffer : m_buffers)
+			{
+				buffer->snapshot(zones, endNanosec);
+			}
+		}
+
+		// 再利用されたバッファには、複数のスレッドのゾーンが含まれる
+		zones.sort_by([](const ProfilerZoneRecord& a, const ProfilerZoneRecord& b)
+			{
+				if (a.threadIndex != b.threadIndex)
+				{
+					return (a.threadIndex < b.threadIndex);
+				}
+
+				if (a.beginNanosec != b.beginNanosec)
+				{
+					return (a.beginNanosec < b.beginNanosec);
+				}
+
+				return (a.depth < b.depth);
+			});
+
+		return zones;
+	}
+
+	void ProfilerZoneRecorder::clear()
+	{
+		std::lock_guard lock{ m_mutex };
+
+		for (auto& buffer : m_buffers)
+		{
+			buffer->clear();
+		}
+	}
+
+	namespace detail
+	{
+		std::atomic<bool> g_profilerZoneEnabled{ false };
+
+		uint64 BeginProfilerZone() noexcept
+		{
+			++GetThreadState().depth;
+
+			return Time::GetNanosec();
+		}
+
+		void EndProfilerZone(const char32* name, const uint64 beginNanosec) noexcept
+		{
+			const uint64 endNanosec = Time::GetNanosec();
+			const uint32 threadIndex = ProfilerZoneRecorder::GetCurrentThreadIndex();
+			ThreadState& state = GetThreadState();
+
+			if (not state.buffer)
+			{
+				state.buffer = ProfilerZoneRecorder::Get().acquireBuffer();
+			}
+
+			const uint32 depth = ((0 < state.depth) ? --state.depth : 0);
+
+			state.buffer->record(name, threadIndex, depth, beginNanosec, endNanosec);
+		}
+	}
+}
@@ -0,0 +1,113 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <mutex>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/ProfilerZone.hpp>
+
+namespace s3d
+{
+	/// @brief 1 つのスレッドが書き込むゾーンのリングバッファ
+	/// @remark 書き込みは所有するスレッドだけが行い、読み出しは任意のスレッドから行えます。
+	class ProfilerZoneBuffer
+	{
+	public:
+
+		/// @brief 保持するゾーンの数
+		static constexpr size_t Capacity = 8192;
+
+		ProfilerZoneBuffer();
+
+		void record(const char32* name, uint32 threadIndex, uint32 depth, uint64 beginNanosec, uint64 endNanosec) noexcept;
+
+		/// @brief endNanosec より後に終了したゾーンを out に追加します。
+		void snapshot(Array<ProfilerZoneRecord>& out, uint64 endNanosec) const;
+
+		void clear() noexcept;
+
+	private:
+
+		/// @brief リングバッファの 1 ゾーン
+		/// @remark 書き込み中のゾーンを読み飛ばすため、sequence には書き込み開始時に奇数、完了時に偶数を格納します。
+		struct Record
+		{
+			std::atomic<uint64> sequence{ 0 };
+
+			std::atomic<const char32*> name{ nullptr };
+
+			/// @brief スレッド番号 (32 bit), 深さ (32 bit)
+			std::atomic<uint64> header{ 0 };
+
+			std::atomic<uint64> beginNanosec{ 0 };
+
+			std::atomic<uint64> endNanosec{ 0 };
+		};
+
+		std::unique_ptr<Record[]> m_records;
+
+		std::atomic<uint64> m_writePosition{ 0 };
+
+		/// @brief これより前の位置のゾーンは消去済み
+		std::atomic<uint64> m_clearPosition{ 0 };
+	};
+
+	/// @brief 全スレッドのゾーンのリングバッファを管理するクラス
+	/// @remark スレッドごとの深さとバッファは thread_local で保持し、スレッドの終了時にバッファを返却します。
+	class ProfilerZoneRecorder
+	{
+	public:
+
+		[[nodiscard]]
+		static ProfilerZoneRecorder& Get();
+
+		/// @brief 呼び出したスレッドの番号を返します。最初の呼び出しで番号を割り当てます。
+		[[nodiscard]]
+		static uint32 GetCurrentThreadIndex();
+
+		[[nodiscard]]
+		uint32 newThreadIndex();
+
+		[[nodiscard]]
+		ProfilerZoneBuffer* acquireBuffer();
+
+		void releaseBuffer(ProfilerZoneBuffer* buffer);
+
+		void setThreadName(uint32 threadIndex, const String& name);
+
+		[[nodiscard]]
+		HashTable<uint32, String> getThreadNames() const;
+
+		/// @brief endNanosec より後に終了したゾーンを、スレッド番号、開始時刻の順に並べて返します。
+		[[nodiscard]]
+		Array<ProfilerZoneRecord> snapshot(uint64 endNanosec = 0) const;
+
+		void clear();
+
+	private:
+
+		mutable std::mutex m_mutex;
+
+		/// @brief 作成したすべてのバッファ（終了したスレッドの記録を残すため、解放しない）
+		Array<std::unique_ptr<ProfilerZoneBuffer>> m_buffers;
+
+		/// @brief 終了したスレッドから返却され、新しいスレッドで再利用できるバッファ
+		Array<ProfilerZoneBuffer*> m_freeBuffers;
+
+		uint32 m_threadCount = 0;
+
+		HashTable<uint32, String> m_threadNames;
+	};
+}
@@ -11,6 +11,7 @@
 
 # include <Siv3D/Profiler.hpp>
 # include <Siv3D/Profiler/IProfiler.hpp>
+# include <Siv3D/Profiler/ProfilerZoneRecorder.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
@@ -32,5 +33,40 @@ namespace s3d
 		{
 			return SIV3D_ENGINE(Profiler)->getStat();
 		}
+
+		void EnableZoneRecording(const bool enabled) noexcept
+		{
+			detail::g_profilerZoneEnabled.store(enabled, std::memory_order_relaxed);
+		}
+
+		bool IsZoneRecordingEnabled() noexcept
+		{
+			return detail::g_profilerZoneEnabled.load(std::memory_order_relaxed);
+		}
+
+		void SetThreadName(const StringView name)
+		{
+			ProfilerZoneRecorder::Get().setThreadName(ProfilerZoneRecorder::GetCurrentThreadIndex(), String{ name });
+		}
+
+		Array<ProfilerZoneRecord> GetLastFrameZones()
+		{
+			return SIV3D_ENGINE(Profiler)->getLastFrameZones();
+		}
+
+		FrameTimeHistogram GetFrameTimeHistogram()
+		{
+			return SIV3D_ENGINE(Profiler)->getFrameTimeHistogram();
+		}
+
+		void ClearZones()
+		{
+			ProfilerZoneRecorder::Get().clear();
+		}
+
+		bool SaveChromeTrace(const FilePathView path)
+		{
+			return SIV3D_ENGINE(Profiler)->saveChromeTrace(path);
+		}
 	}
 }
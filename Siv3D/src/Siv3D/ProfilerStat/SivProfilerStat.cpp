@@ -18,6 +18,7 @@ namespace s3d
 	{
 		Print << U"Draw calls\t\t\t" << drawCalls;
 		Print << U"Triangle count\t\t" << triangleCount;
+		Print << U"Uploaded bytes\t\t" << uploadedBytes;
 		Print << U"Texture count\t\t" << textureCount;
 		Print << U"Font count\t\t\t" << fontCount;
 		Print << U"Audio count\t\t" << audioCount;
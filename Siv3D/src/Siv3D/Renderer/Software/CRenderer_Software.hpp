@@ -0,0 +1,101 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/Scene.hpp>
+# include <Siv3D/Renderer/IRenderer.hpp>
+
+namespace s3d
+{
+	class CRenderer2D_Software;
+	class CTexture_Software;
+
+	/// @brief Headless モードで、シーンを CPU 上の Image に描画するレンダラー
+	class CRenderer_Software final : public ISiv3DRenderer
+	{
+	private:
+
+		CRenderer2D_Software* pRenderer2D = nullptr;
+		CTexture_Software* pTexture = nullptr;
+
+		Image m_scene;
+
+		Image m_screenCapture;
+
+		ResizeMode m_sceneResizeMode = Scene::DefaultResizeMode;
+
+		TextureFilter m_sceneTextureFilter = Scene::DefaultTextureFilter;
+
+		ColorF m_backgroundColor = Scene::DefaultBackgroundColor;
+
+		ColorF m_letterboxColor = Scene::DefaultLetterBoxColor;
+
+	public:
+
+		CRenderer_Software();
+
+		~CRenderer_Software() override;
+
+		EngineOption::Renderer getRendererType() const noexcept override;
+
+		void init() override;
+
+		StringView getName() const override;
+
+		void clear() override;
+
+		void flush() override;
+
+		bool present() override;
+
+		void setVSyncEnabled(bool enabled) override;
+
+		bool isVSyncEnabled() const override;
+
+		void captureScreenshot() override;
+
+		const Image& getScreenCapture() const override;
+
+		void setSceneResizeMode(ResizeMode resizeMode) override;
+
+		ResizeMode getSceneResizeMode() const noexcept override;
+
+		void setSceneBufferSize(Size size) override;
+
+		Size getSceneBufferSize() const noexcept override;
+
+		void setSceneTextureFilter(TextureFilter textureFilter) override;
+
+		TextureFilter getSceneTextureFilter() const noexcept override;
+
+		void setBackgroundColor(const ColorF& color) override;
+
+		const ColorF& getBackgroundColor() const noexcept override;
+
+		void setLetterboxColor(const ColorF& color) override;
+
+		const ColorF& getLetterboxColor() const noexcept override;
+
+		std::pair<float, RectF> getLetterboxComposition() const noexcept override;
+
+		void updateSceneSize() override;
+
+		//
+		// Software
+		//
+
+		/// @brief シーンの描画先を返します。
+		[[nodiscard]]
+		Image& getSceneImage() noexcept;
+	};
+}
@@ -30,6 +30,7 @@
 # include <Siv3D/ConstantBuffer.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/Particle2D.hpp>
+# include <Siv3D/ParticleSystem2D/ParticleBuffer2D.hpp>
 # include <Siv3D/ParticleSystem2DParameters.hpp>
 
 namespace s3d
@@ -41,6 +42,8 @@ namespace s3d
 	{
 		uint32 drawCalls = 0;
 		uint32 triangleCount = 0;
+
+		uint32 uploadedBytes = 0;
 	};
 
 	class SIV3D_NOVTABLE ISiv3DRenderer2D
@@ -129,10 +132,16 @@ namespace s3d
 
 		virtual void addRoundRectShadow(const RoundRect& roundRect, float blur, const Float4& color, bool fill) = 0;
 
-		virtual void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+		virtual void addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles,
 			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) = 0;
 
+		virtual void addRects(const RectF* rects, const ColorF* colors, size_t count, const Float4& color) = 0;
+
+		virtual void addCircles(const Circle* circles, const ColorF* colors, size_t count, const Float4& color) = 0;
+
+		virtual void addTexturedQuads(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Mat3x2* transforms, const ColorF* colors, size_t count, const Float4& color) = 0;
+
 
 		virtual Float4 getColorMul() const = 0;
 
@@ -222,13 +222,28 @@ namespace s3d
 		// do nothing
 	}
 
-	void CRenderer2D_Null::addTexturedParticles(const Texture&, const Array<Particle2D>&,
+	void CRenderer2D_Null::addTexturedParticles(const Texture&, const ParticleBuffer2D&,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc)
 	{
 		// do nothing
 	}
 
+	void CRenderer2D_Null::addRects(const RectF*, const ColorF*, size_t, const Float4&)
+	{
+		// do nothing
+	}
+
+	void CRenderer2D_Null::addCircles(const Circle*, const ColorF*, size_t, const Float4&)
+	{
+		// do nothing
+	}
+
+	void CRenderer2D_Null::addTexturedQuads(const Texture&, const FloatRect&, const FloatRect&, const Mat3x2*, const ColorF*, size_t, const Float4&)
+	{
+		// do nothing
+	}
+
 
 	Float4 CRenderer2D_Null::getColorMul() const
 	{
@@ -42,5 +42,8 @@ namespace s3d
 		uint32 startIndexLocation = 0;
 
 		uint32 baseVertexLocation = 0;
+
+		/// @brief このバッチで GPU から参照できるメモリに書き込んだ頂点・インデックスのバイト数
+		uint32 uploadedBytes = 0;
 	};
 }
@@ -0,0 +1,739 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "CRenderer2D_Software.hpp"
+# include <Siv3D/Error.hpp>
+# include <Siv3D/Resource.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ScopeGuard.hpp>
+# include <Siv3D/ProfilerZone.hpp>
+# include <Siv3D/Mat3x2.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+# include <Siv3D/Renderer/Software/CRenderer_Software.hpp>
+# include <Siv3D/Texture/Software/CTexture_Software.hpp>
+
+namespace s3d
+{
+	CRenderer2D_Software::CRenderer2D_Software()
+	{
+		m_vsSamplerStates.fill(SamplerState::Default2D);
+	}
+
+	CRenderer2D_Software::~CRenderer2D_Software()
+	{
+		LOG_SCOPED_TRACE(U"CRenderer2D_Software::~CRenderer2D_Software()");
+	}
+
+	void CRenderer2D_Software::init()
+	{
+		LOG_SCOPED_TRACE(U"CRenderer2D_Software::init()");
+
+		pRenderer	= static_cast<CRenderer_Software*>(SIV3D_ENGINE(Renderer));
+		pTexture	= static_cast<CTexture_Software*>(SIV3D_ENGINE(Texture));
+
+		// シャドウ画像を作成
+		{
+			const Image boxShadowImage{ Resource(U"engine/texture/box-shadow/256.png") };
+
+			m_boxShadowTexture = std::make_unique<Texture>(boxShadowImage);
+
+			if (m_boxShadowTexture->isEmpty())
+			{
+				throw EngineError(U"Failed to create a box-shadow texture");
+			}
+		}
+	}
+
+	void CRenderer2D_Software::update()
+	{
+		m_stat = {};
+	}
+
+	const Renderer2DStat& CRenderer2D_Software::getStat() const
+	{
+		return m_stat;
+	}
+
+	void CRenderer2D_Software::addLine(const LineStyle& style, const Float2& begin, const Float2& end, const float thickness, const Float4(&colors)[2])
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildLine(style, m_bufferCreator, begin, end, thickness, colors, getMaxScaling()))
+		{
+			if (style.hasSquareDot())
+			{
+				pushStandardPS(SoftwarePixelShaderType::SquareDot);
+			}
+			else if (style.hasRoundDot())
+			{
+				pushStandardPS(SoftwarePixelShaderType::RoundDot);
+			}
+			else
+			{
+				pushStandardPS(SoftwarePixelShaderType::Shape);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addTriangle(const Float2(&points)[3], const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_batchBufferCreator, points, color))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addTriangle(const Float2(&points)[3], const Float4(&colors)[3])
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildTriangle(m_batchBufferCreator, points, colors))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRect(const FloatRect& rect, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_batchBufferCreator, rect, color))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRect(const FloatRect& rect, const Float4(&colors)[4])
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRect(m_batchBufferCreator, rect, colors))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRectFrame(const FloatRect& rect, const float thickness, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRectFrame(m_bufferCreator, rect, thickness, innerColor, outerColor))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRectFrameTB(const FloatRect& rect, const float thickness, const Float4& topColor, const Float4& bottomColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRectFrameTB(m_bufferCreator, rect, thickness, topColor, bottomColor))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addCircle(const Float2& center, const float r, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildCircle(m_bufferCreator, center, r, innerColor, outerColor, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addCircleFrame(const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildCircleFrame(m_bufferCreator, center, rInner, thickness, innerColor, outerColor, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addCirclePie(const Float2& center, const float r, const float startAngle, const float angle, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildCirclePie(m_bufferCreator, center, r, startAngle, angle, innerColor, outerColor, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addCircleArc(const LineStyle& style, const Float2& center, const float rInner, const float startAngle, const float angle, const float thickness, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildCircleArc(m_bufferCreator, style, center, rInner, startAngle, angle, thickness, innerColor, outerColor, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addCircleSegment(const Float2& center, const float r, const float startAngle, const float angle, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildCircleSegment(m_bufferCreator, center, r, startAngle, angle, color, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addEllipse(const Float2& center, const float a, const float b, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildEllipse(m_bufferCreator, center, a, b, innerColor, outerColor, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addEllipseFrame(const Float2& center, const float aInner, const float bInner, const float thickness, const Float4& innerColor, const Float4& outerColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildEllipseFrame(m_bufferCreator, center, aInner, bInner, thickness, innerColor, outerColor, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addQuad(const FloatQuad& quad, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_batchBufferCreator, quad, color))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addQuad(const FloatQuad& quad, const Float4(&colors)[4])
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildQuad(m_batchBufferCreator, quad, colors))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRoundRect(const FloatRect& rect, const float w, const float h, const float r, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRoundRect(m_bufferCreator, m_buffer, rect, w, h, r, color, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRoundRect(const FloatRect& rect, const float w, const float h, const float r, const Float4& topColor, const Float4& bottomColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRoundRect(m_bufferCreator, m_buffer, rect, w, h, r, topColor, bottomColor, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRoundRectFrame(const RoundRect& outer, const RoundRect& inner, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRoundRectFrame(m_bufferCreator, m_buffer, outer, inner, color, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRoundRectFrame(const RoundRect& outer, const RoundRect& inner, const Float4& topColor, const Float4& bottomColor)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRoundRectFrame(m_bufferCreator, m_buffer, outer, inner, topColor, bottomColor, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addLineString(const LineStyle& style, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const CloseRing closeRing)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildLineString(m_bufferCreator, m_buffer, style, points, size, offset, thickness, inner, color, closeRing, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addLineString(const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const CloseRing closeRing)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildDefaultLineString(m_bufferCreator, points, colors, size, offset, thickness, inner, closeRing, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addPolygon(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, const Optional<Float2>& offset, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildPolygon(m_bufferCreator, vertices, indices, offset, color))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addPolygon(const Vertex2D* vertices, const size_t vertexCount, const TriangleIndex* indices, const size_t num_triangles)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildPolygon(m_bufferCreator, vertices, vertexCount, indices, num_triangles))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addPolygonTransformed(const Array<Float2>& vertices, const Array<TriangleIndex>& indices, float s, float c, const Float2& offset, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildPolygonTransformed(m_bufferCreator, vertices, indices, s, c, offset, color))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addPolygonFrame(const Float2* points, const size_t size, const float thickness, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildPolygonFrame(m_bufferCreator, m_buffer, points, size, thickness, color, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addNullVertices(const uint32)
+	{
+		// 頂点の位置をカスタム頂点シェーダで生成する描画は行わない
+	}
+
+	void CRenderer2D_Software::addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildTextureRegion(m_batchBufferCreator, rect, uv, color))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, texture);
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildTextureRegion(m_batchBufferCreator, rect, uv, colors))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, texture);
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedCircle(const Texture& texture, const Circle& circle, const FloatRect& uv, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildTexturedCircle(m_bufferCreator, circle, uv, color, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, texture);
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedQuad(const Texture& texture, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildTexturedQuad(m_batchBufferCreator, quad, uv, color))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, texture);
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedRoundRect(const Texture& texture, const FloatRect& rect, const float w, const float h, const float r, const FloatRect& uvRect, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildTexturedRoundRect(m_bufferCreator, m_buffer, rect, w, h, r, uvRect, color, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, texture);
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedVertices(const Texture& texture, const Vertex2D* vertices, const size_t vertexCount, const TriangleIndex* indices, const size_t num_triangles)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildTexturedVertices(m_bufferCreator, vertices, vertexCount, indices, num_triangles))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, texture);
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRectShadow(const FloatRect& rect, const float blur, const Float4& color, const bool fill)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRectShadow(m_bufferCreator, rect, blur, color, fill))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, getBoxShadowTexture());
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addCircleShadow(const Circle& circle, const float blur, const Float4& color)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildCircleShadow(m_bufferCreator, circle, blur, color, getMaxScaling()))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, getBoxShadowTexture());
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRoundRectShadow(const RoundRect& roundRect, const float blur, const Float4& color, const bool fill)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildRoundRectShadow(m_bufferCreator, roundRect, blur, color, getMaxScaling(), fill))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, getBoxShadowTexture());
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles,
+		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
+		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
+	{
+		if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		{
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, texture);
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addRects(const RectF* rects, const ColorF* colors, const size_t count, const Float4& color)
+	{
+		// 状態の確認とコマンドの発行は、バッファ要求 1 回につき 1 度だけ行う
+		for (size_t i = 0; i < count; i += Vertex2DBuilder::MaxBulkQuadCount)
+		{
+			const size_t n = Min((count - i), Vertex2DBuilder::MaxBulkQuadCount);
+			const auto indexCount = Vertex2DBuilder::BuildRects(m_bufferCreator, (rects + i), (colors ? (colors + i) : nullptr), n, color);
+
+			if (not indexCount)
+			{
+				return;
+			}
+
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_Software::addCircles(const Circle* circles, const ColorF* colors, const size_t count, const Float4& color)
+	{
+		const float scale = getMaxScaling();
+
+		for (size_t i = 0; i < count;)
+		{
+			size_t n = 0;
+			const auto indexCount = Vertex2DBuilder::BuildCircles(m_bufferCreator, (circles + i), (colors ? (colors + i) : nullptr), (count - i), color, scale, n);
+
+			if (not indexCount)
+			{
+				return;
+			}
+
+			pushStandardPS(SoftwarePixelShaderType::Shape);
+
+			m_commandManager.pushDraw(indexCount);
+			i += n;
+		}
+	}
+
+	void CRenderer2D_Software::addTexturedQuads(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Mat3x2* transforms, const ColorF* colors, const size_t count, const Float4& color)
+	{
+		for (size_t i = 0; i < count; i += Vertex2DBuilder::MaxBulkQuadCount)
+		{
+			const size_t n = Min((count - i), Vertex2DBuilder::MaxBulkQuadCount);
+			const auto indexCount = Vertex2DBuilder::BuildTexturedQuads(m_bufferCreator, rect, uv, (transforms + i), (colors ? (colors + i) : nullptr), n, color);
+
+			if (not indexCount)
+			{
+				return;
+			}
+
+			pushStandardPS(SoftwarePixelShaderType::Texture);
+
+			m_commandManager.pushPSTexture(0, texture);
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	Float4 CRenderer2D_Software::getColorMul() const
+	{
+		return m_commandManager.getCurrentColorMul();
+	}
+
+	Float4 CRenderer2D_Software::getColorAdd() const
+	{
+		return m_commandManager.getCurrentState().colorAdd;
+	}
+
+	void CRenderer2D_Software::setColorMul(const Float4& color)
+	{
+		m_commandManager.pushColorMul(color);
+	}
+
+	void CRenderer2D_Software::setColorAdd(const Float4& color)
+	{
+		m_commandManager.pushColorAdd(color);
+	}
+
+	BlendState CRenderer2D_Software::getBlendState() const
+	{
+		return m_commandManager.getCurrentState().blendState;
+	}
+
+	RasterizerState CRenderer2D_Software::getRasterizerState() const
+	{
+		return m_commandManager.getCurrentState().rasterizerState;
+	}
+
+	SamplerState CRenderer2D_Software::getSamplerState(const ShaderStage shaderStage, const uint32 slot) const
+	{
+		if (shaderStage == ShaderStage::Vertex)
+		{
+			return m_vsSamplerStates[slot];
+		}
+		else
+		{
+			return m_commandManager.getCurrentSamplerState(slot);
+		}
+	}
+
+	void CRenderer2D_Software::setBlendState(const BlendState& state)
+	{
+		m_commandManager.pushBlendState(state);
+	}
+
+	void CRenderer2D_Software::setRasterizerState(const RasterizerState& state)
+	{
+		m_commandManager.pushRasterizerState(state);
+	}
+
+	void CRenderer2D_Software::setSamplerState(const ShaderStage shaderStage, const uint32 slot, const SamplerState& state)
+	{
+		if (shaderStage == ShaderStage::Vertex)
+		{
+			m_vsSamplerStates[slot] = state;
+		}
+		else
+		{
+			m_commandManager.pushSamplerState(state, slot);
+		}
+	}
+
+	void CRenderer2D_Software::setScissorRect(const Rect& rect)
+	{
+		m_commandManager.pushScissorRect(rect);
+	}
+
+	Rect CRenderer2D_Software::getScissorRect() const
+	{
+		return m_commandManager.getCurrentState().scissorRect;
+	}
+
+	void CRenderer2D_Software::setViewport(const Optional<Rect>& viewport)
+	{
+		m_commandManager.pushViewport(viewport);
+	}
+
+	Optional<Rect> CRenderer2D_Software::getViewport() const
+	{
+		return m_commandManager.getCurrentState().viewport;
+	}
+
+	void CRenderer2D_Software::setSDFParameters(const std::array<Float4, 3>& params)
+	{
+		m_commandManager.pushSDFParameters(params);
+	}
+
+	void CRenderer2D_Software::setInternalPSConstants(const Float4&)
+	{
+		// 標準のピクセルシェーダは使わない
+	}
+
+	Optional<VertexShader> CRenderer2D_Software::getCustomVS() const
+	{
+		return m_currentCustomVS;
+	}
+
+	Optional<PixelShader> CRenderer2D_Software::getCustomPS() const
+	{
+		return m_currentCustomPS;
+	}
+
+	void CRenderer2D_Software::setCustomVS(const Optional<VertexShader>& vs)
+	{
+		if (vs && (not vs->isEmpty()))
+		{
+			m_currentCustomVS = *vs;
+		}
+		else
+		{
+			m_currentCustomVS.reset();
+		}
+	}
+
+	void CRenderer2D_Software::setCustomPS(const Optional<PixelShader>& ps)
+	{
+		if (ps && (not ps->isEmpty()))
+		{
+			m_currentCustomPS = *ps;
+		}
+		else
+		{
+			m_currentCustomPS.reset();
+		}
+	}
+
+	const Mat3x2& CRenderer2D_Software::getLocalTransform() const
+	{
+		return m_commandManager.getCurrentLocalTransform();
+	}
+
+	const Mat3x2& CRenderer2D_Software::getCameraTransform() const
+	{
+		return m_commandManager.getCurrentCameraTransform();
+	}
+
+	void CRenderer2D_Software::setLocalTransform(const Mat3x2& matrix)
+	{
+		m_commandManager.pushLocalTransform(matrix);
+	}
+
+	void CRenderer2D_Software::setCameraTransform(const Mat3x2& matrix)
+	{
+		m_commandManager.pushCameraTransform(matrix);
+	}
+
+	float CRenderer2D_Software::getMaxScaling() const noexcept
+	{
+		return m_commandManager.getCurrentMaxScaling();
+	}
+
+	void CRenderer2D_Software::setVSTexture(const uint32, const Optional<Texture>&)
+	{
+		// 頂点シェーダは使わない
+	}
+
+	void CRenderer2D_Software::setPSTexture(const uint32 slot, const Optional<Texture>& texture)
+	{
+		if (texture)
+		{
+			m_commandManager.pushPSTexture(slot, *texture);
+		}
+		else
+		{
+			m_commandManager.pushPSTextureUnbind(slot);
+		}
+	}
+
+	void CRenderer2D_Software::setRenderTarget(const Optional<RenderTexture>& rt)
+	{
+		if (rt)
+		{
+			const Texture::IDType textureID = rt->id();
+
+			// バインドされていたら解除
+			for (uint32 slot = 0; slot < SamplerState::MaxSamplerCount; ++slot)
+			{
+				if (m_commandManager.getCurrentPSTexture(slot) == textureID)
+				{
+					m_commandManager.pushPSTextureUnbind(slot);
+				}
+			}
+		}
+
+		m_commandManager.pushRT(rt);
+	}
+
+	Optional<RenderTexture> CRenderer2D_Software::getRenderTarget() const
+	{
+		return m_commandManager.getCurrentRT();
+	}
+
+	void CRenderer2D_Software::setConstantBuffer(const ShaderStage, const uint32, const ConstantBufferBase&, const float*, const uint32)
+	{
+		// カスタムシェーダは使わない
+	}
+
+	const Texture& CRenderer2D_Software::getBoxShadowTexture() const noexcept
+	{
+		return *m_boxShadowTexture;
+	}
+
+	void CRenderer2D_Software::flush()
+	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
+		ScopeGuard cleanUp = [this]()
+		{
+			m_commandManager.reset();
+			m_currentCustomVS.reset();
+			m_currentCustomPS.reset();
+		};
+
+		m_rasterizer.draw(m_commandManager, pRenderer->getSceneImage(), *pTexture, m_stat);
+	}
+
+	void CRenderer2D_Software::setPixelShaderOverride(const Optional<SoftwarePixelShaderType>& type)
+	{
+		m_pixelShaderOverride = type;
+	}
+
+	void CRenderer2D_Software::pushStandardPS(const SoftwarePixelShaderType type)
+	{
+		m_commandManager.pushPixelShader(m_pixelShaderOverride.value_or(type));
+	}
+}
@@ -0,0 +1,1013 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cmath>
+# include "SoftwareRasterizer.hpp"
+# include <Siv3D/Math.hpp>
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/Renderer2D/IRenderer2D.hpp>
+# include <Siv3D/Texture/Software/CTexture_Software.hpp>
+
+namespace s3d
+{
+	namespace
+	{
+		/// @brief 頂点座標の小数部のビット数
+		constexpr int32 SubPixelBits = 8;
+
+		constexpr int64 SubPixelScale = (int64{ 1 } << SubPixelBits);
+
+		constexpr int64 HalfSubPixel = (SubPixelScale / 2);
+
+		/// @brief 辺関数が int64 に収まるよう、頂点座標の絶対値をこの値までに制限する
+		constexpr float MaxCoordinate = static_cast<float>(1 << 21);
+
+		/// @brief テクスチャ座標をテクセル単位にしたときの上限
+		constexpr float MaxTexelCoordinate = static_cast<float>(1 << 24);
+
+		/// @brief MSDF フォントの距離の範囲（engine/shader の pxRange）
+		constexpr float MSDFPixelRange = 4.0f;
+
+		[[nodiscard]]
+		constexpr int64 FloorDiv(const int64 a, const int64 b) noexcept
+		{
+			return (((a < 0) && (a % b)) ? ((a / b) - 1) : (a / b));
+		}
+
+		[[nodiscard]]
+		inline Float4 ToFloat4(const Color& c) noexcept
+		{
+			constexpr float s = (1.0f / 255.0f);
+			return{ (c.r * s), (c.g * s), (c.b * s), (c.a * s) };
+		}
+
+		[[nodiscard]]
+		inline uint8 ToUnorm8(const float v) noexcept
+		{
+			return static_cast<uint8>(Clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+		}
+
+		[[nodiscard]]
+		inline float Saturate(const float v) noexcept
+		{
+			return Clamp(v, 0.0f, 1.0f);
+		}
+
+		[[nodiscard]]
+		inline Float4 Saturate(const Float4& v) noexcept
+		{
+			return{ Saturate(v.x), Saturate(v.y), Saturate(v.z), Saturate(v.w) };
+		}
+
+		[[nodiscard]]
+		inline float SanitizeTexel(const float v) noexcept
+		{
+			// NaN は下限にまとめる
+			return ((-MaxTexelCoordinate <= v) ? ((v <= MaxTexelCoordinate) ? v : MaxTexelCoordinate) : -MaxTexelCoordinate);
+		}
+
+		[[nodiscard]]
+		inline float Median(const float r, const float g, const float b) noexcept
+		{
+			return Max(Min(r, g), Min(Max(r, g), b));
+		}
+
+		[[nodiscard]]
+		inline Float3 Mix(const Float3& a, const Float3& b, const float t) noexcept
+		{
+			return (a + (b - a) * t);
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	TextureSampler
+		//
+		////////////////////////////////////////////////////////////////
+
+		/// @brief SamplerState にしたがって Image からテクセルを読み取る
+		/// @remark ミップマップと異方性フィルタリングは扱いません。
+		class TextureSampler
+		{
+		public:
+
+			TextureSampler(const Image* image, const SamplerState& samplerState) noexcept
+				: m_pixels{ ((image && *image) ? image->data() : nullptr) }
+				, m_width{ m_pixels ? image->width() : 0 }
+				, m_height{ m_pixels ? image->height() : 0 }
+				, m_addressU{ samplerState.addressU }
+				, m_addressV{ samplerState.addressV }
+				, m_min{ samplerState.min }
+				, m_mag{ samplerState.mag }
+				, m_borderColor{ samplerState.borderColor } {}
+
+			[[nodiscard]]
+			Float2 size() const noexcept
+			{
+				return{ static_cast<float>(m_width), static_cast<float>(m_height) };
+			}
+
+			[[nodiscard]]
+			Float4 sample(const Float2 uv, const bool minification) const noexcept
+			{
+				if (not m_pixels)
+				{
+					return{ 0.0f, 0.0f, 0.0f, 0.0f };
+				}
+
+				const float u = SanitizeTexel(uv.x * m_width);
+				const float v = SanitizeTexel(uv.y * m_height);
+
+				if ((minification ? m_min : m_mag) == TextureFilter::Nearest)
+				{
+					return fetch(static_cast<int32>(std::floor(u)), static_cast<int32>(std::floor(v)));
+				}
+
+				const float fu = (u - 0.5f);
+				const float fv = (v - 0.5f);
+				const float x0f = std::floor(fu);
+				const float y0f = std::floor(fv);
+				const float tx = (fu - x0f);
+				const float ty = (fv - y0f);
+				const int32 x0 = static_cast<int32>(x0f);
+				const int32 y0 = static_cast<int32>(y0f);
+
+				const Float4 c00 = fetch(x0, y0);
+				const Float4 c10 = fetch((x0 + 1), y0);
+				const Float4 c01 = fetch(x0, (y0 + 1));
+				const Float4 c11 = fetch((x0 + 1), (y0 + 1));
+
+				const Float4 top = (c00 + (c10 - c00) * tx);
+				const Float4 bottom = (c01 + (c11 - c01) * tx);
+				return (top + (bottom - top) * ty);
+			}
+
+		private:
+
+			const Color* m_pixels = nullptr;
+
+			int32 m_width = 0;
+
+			int32 m_height = 0;
+
+			TextureAddressMode m_addressU = TextureAddressMode::Clamp;
+
+			TextureAddressMode m_addressV = TextureAddressMode::Clamp;
+
+			TextureFilter m_min = TextureFilter::Linear;
+
+			TextureFilter m_mag = TextureFilter::Linear;
+
+			Float4 m_borderColor{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+			[[nodiscard]]
+			static int32 Address(const int32 i, const int32 size, const TextureAddressMode mode) noexcept
+			{
+				switch (mode)
+				{
+				case TextureAddressMode::Repeat:
+					{
+						const int32 m = (i % size);
+						return ((m < 0) ? (m + size) : m);
+					}
+				case TextureAddressMode::Mirror:
+					{
+						const int32 period = (size * 2);
+						int32 m = (i % period);
+						m = ((m < 0) ? (m + period) : m);
+						return ((m < size) ? m : (period - 1 - m));
+					}
+				case TextureAddressMode::Clamp:
+					return Clamp(i, 0, (size - 1));
+				default: // Border
+					return (((0 <= i) && (i < size)) ? i : -1);
+				}
+			}
+
+			[[nodiscard]]
+			Float4 fetch(const int32 x, const int32 y) const noexcept
+			{
+				const int32 ix = Address(x, m_width, m_addressU);
+				const int32 iy = Address(y, m_height, m_addressV);
+
+				if ((ix < 0) || (iy < 0))
+				{
+					return m_borderColor;
+				}
+
+				return ToFloat4(m_pixels[(static_cast<size_t>(iy) * m_width) + ix]);
+			}
+		};
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	Pixel Shader
+		//
+		////////////////////////////////////////////////////////////////
+
+		/// @brief 三角形ごとに一定のピクセルシェーダの入力
+		struct ShadeContext
+		{
+			const TextureSampler* sampler;
+
+			const SoftwareRenderState* state;
+
+			Float2 uvDx;
+
+			Float2 uvDy;
+
+			/// @brief MSDF フォントの dot(msdfUnit, 0.5 / fwidth(UV))
+			float msdfScale;
+
+			bool minification;
+		};
+
+		[[nodiscard]]
+		inline float Coverage(const float distance, const float width) noexcept
+		{
+			if (width <= 0.0f)
+			{
+				return ((0.0f <= distance) ? 1.0f : 0.0f);
+			}
+
+			return Saturate(distance / width + 0.5f);
+		}
+
+		/// @brief テクスチャの値 f について、GPU の fwidth() を有限差分で求める
+		template <class Fty>
+		[[nodiscard]]
+		inline float FWidth(const ShadeContext& ctx, const Float2 uv, const float value, Fty f) noexcept
+		{
+			return (std::abs(f(uv + ctx.uvDx) - value) + std::abs(f(uv + ctx.uvDy) - value));
+		}
+
+		/// @brief テキストの色に影を合成する（engine/shader の *_shadow.frag と同じ計算）
+		/// @param textCoverage 影を隠すテキストの割合。影のみの場合は textAlpha, 輪郭と影の場合はテキストのアルファ
+		[[nodiscard]]
+		inline Float4 ComposeShadow(const Float4& textColor, const float textCoverage, const float shadowAlpha, const Float4& shadowColor) noexcept
+		{
+			const float sBase = (shadowAlpha * (1.0f - textCoverage));
+			const Float3 rgb = ((textCoverage == 0.0f) ? shadowColor.xyz() : Mix(textColor.xyz(), shadowColor.xyz(), sBase));
+			return{ rgb, ((sBase * shadowColor.w) + textColor.w) };
+		}
+
+		template <SoftwarePixelShaderType PS>
+		[[nodiscard]]
+		Float4 Shade(const ShadeContext& ctx, const Float4& color, const Float2 uv) noexcept
+		{
+			const auto& sdfParam = ctx.state->sdfParams[0];
+			const auto& outlineColor = ctx.state->sdfParams[1];
+			const auto& shadowColor = ctx.state->sdfParams[2];
+
+			if constexpr (PS == SoftwarePixelShaderType::Shape)
+			{
+				return color;
+			}
+			else if constexpr (PS == SoftwarePixelShaderType::SquareDot)
+			{
+				const float tr = uv.y;
+				const float d = std::abs(std::fmod(std::fmod(uv.x, 3.0f) + 3.0f, 3.0f) - 1.0f);
+				const float range = (1.0f - tr);
+				const float a = ((d < range) ? 1.0f : (d < 1.0f) ? ((1.0f - d) / tr) : 0.0f);
+				return{ color.xyz(), (color.w * a) };
+			}
+			else if constexpr (PS == SoftwarePixelShaderType::RoundDot)
+			{
+				const auto distance = [](const Float2 p)
+				{
+					const float t = std::fmod(std::fmod(p.x, 2.0f) + 2.0f, 2.0f);
+					const Float2 tex{ (std::abs(1.0f - t) * 2.0f), p.y };
+					return (tex.dot(tex) * 0.5f);
+				};
+
+				const float dist = distance(uv);
+				const float delta = FWidth(ctx, uv, dist, distance);
+				const float alpha = ((0.0f < delta) ? Math::Smoothstep((0.5f - delta), 0.5f, dist) : ((0.5f <= dist) ? 1.0f : 0.0f));
+				return{ color.xyz(), (color.w * (1.0f - alpha)) };
+			}
+			else if constexpr (PS == SoftwarePixelShaderType::Texture)
+			{
+				return (ctx.sampler->sample(uv, ctx.minification) * color);
+			}
+			else if constexpr (PS == SoftwarePixelShaderType::BitmapFont)
+			{
+				return{ color.xyz(), (color.w * ctx.sampler->sample(uv, ctx.minification).w) };
+			}
+			else if constexpr ((PS == SoftwarePixelShaderType::SDFFont) || (PS == SoftwarePixelShaderType::SDFFontOutline) || (PS == SoftwarePixelShaderType::SDFFontShadow) || (PS == SoftwarePixelShaderType::SDFFontOutlineShadow))
+			{
+				const auto distance = [&ctx](const Float2 p)
+				{
+					return ctx.sampler->sample(p, ctx.minification).w;
+				};
+
+				const float d = distance(uv);
+				const float fw = FWidth(ctx, uv, d, distance);
+
+				Float4 textColor;
+				float textCoverage;
+
+				if constexpr ((PS == SoftwarePixelShaderType::SDFFont) || (PS == SoftwarePixelShaderType::SDFFontShadow))
+				{
+					const float textAlpha = Coverage((d - 0.5f), fw);
+					textColor = Float4{ color.xyz(), (color.w * textAlpha) };
+					textCoverage = textAlpha;
+				}
+				else
+				{
+					const float outlineAlpha = Coverage((d - sdfParam.y), fw);
+					const float textAlpha = Coverage((d - sdfParam.x), fw);
+					const float baseAlpha = (outlineAlpha - textAlpha);
+					textColor = Float4{ Mix(outlineColor.xyz(), color.xyz(), textAlpha), ((baseAlpha * outlineColor.w) + (textAlpha * color.w)) };
+					textCoverage = textColor.w;
+				}
+
+				if constexpr ((PS == SoftwarePixelShaderType::SDFFontShadow) || (PS == SoftwarePixelShaderType::SDFFontOutlineShadow))
+				{
+					const Float2 shadowUV = (uv - (Float2{ sdfParam.z, sdfParam.w } / ctx.sampler->size()));
+					const float d2 = distance(shadowUV);
+					const float threshold = ((PS == SoftwarePixelShaderType::SDFFontShadow) ? 0.5f : sdfParam.y);
+					const float shadowAlpha = Coverage((d2 - threshold), FWidth(ctx, shadowUV, d2, distance));
+					return ComposeShadow(textColor, textCoverage, shadowAlpha, shadowColor);
+				}
+				else
+				{
+					return textColor;
+				}
+			}
+			else
+			{
+				const auto distance = [&ctx](const Float2 p)
+				{
+					const Float4 s = ctx.sampler->sample(p, ctx.minification);
+					return Median(s.x, s.y, s.z);
+				};
+
+				const float d = distance(uv);
+				const float scale = ctx.msdfScale;
+
+				Float4 textColor;
+				float textCoverage;
+
+				if constexpr ((PS == SoftwarePixelShaderType::MSDFFont) || (PS == SoftwarePixelShaderType::MSDFFontShadow))
+				{
+					const float textAlpha = Saturate((d - 0.5f) * scale + 0.5f);
+					textColor = Float4{ color.xyz(), (color.w * textAlpha) };
+					textCoverage = textAlpha;
+				}
+				else
+				{
+					const float outlineAlpha = Saturate((d - sdfParam.y) * scale + 0.5f);
+					const float textAlpha = Saturate((d - sdfParam.x) * scale + 0.5f);
+					const float baseAlpha = (outlineAlpha - textAlpha);
+					textColor = Float4{ Mix(outlineColor.xyz(), color.xyz(), textAlpha), ((baseAlpha * outlineColor.w) + (textAlpha * color.w)) };
+					textCoverage = textColor.w;
+				}
+
+				if constexpr ((PS == SoftwarePixelShaderType::MSDFFontShadow) || (PS == SoftwarePixelShaderType::MSDFFontOutlineShadow))
+				{
+					const Float2 shadowUV = (uv - (Float2{ sdfParam.z, sdfParam.w } / ctx.sampler->size()));
+					const float d2 = distance(shadowUV);
+					const float shadowAlpha = Saturate((d2 - 0.5f) * scale + 0.5f);
+					return ComposeShadow(textColor, textCoverage, shadowAlpha, shadowColor);
+				}
+				else
+				{
+					return textColor;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	Blend
+		//
+		////////////////////////////////////////////////////////////////
+
+		enum class BlendMode : uint8
+		{
+			/// @brief ブレンドなしで全チャンネルに書き込む
+			Opaque,
+
+			/// @brief BlendState::NonPremultiplied (Default2D)
+			NonPremultiplied,
+
+			/// @brief それ以外
+			Generic,
+		};
+
+		[[nodiscard]]
+		inline BlendMode GetBlendMode(const BlendState& state) noexcept
+		{
+			const bool writeAll = (state.writeR && state.writeG && state.writeB && state.writeA);
+
+			if ((not state.enable) && writeAll)
+			{
+				return BlendMode::Opaque;
+			}
+
+			if (state.enable && writeAll
+				&& (state.src == Blend::SrcAlpha) && (state.dst == Blend::InvSrcAlpha) && (state.op == BlendOp::Add)
+				&& (state.srcAlpha == Blend::Zero) && (state.dstAlpha == Blend::One) && (state.opAlpha == BlendOp::Add))
+			{
+				return BlendMode::NonPremultiplied;
+			}
+
+			return BlendMode::Generic;
+		}
+
+		/// @brief ブレンド係数を返す
+		/// @remark BlendFactor と Src1 系の係数は、このレンダラーでは One として扱います。
+		[[nodiscard]]
+		inline float BlendFactor(const Blend blend, const float s, const float d, const float sa, const float da, const bool alphaChannel) noexcept
+		{
+			switch (blend)
+			{
+			case Blend::Zero:
+				return 0.0f;
+			case Blend::SrcColor:
+				return s;
+			case Blend::InvSrcColor:
+				return (1.0f - s);
+			case Blend::SrcAlpha:
+				return sa;
+			case Blend::InvSrcAlpha:
+				return (1.0f - sa);
+			case Blend::DestAlpha:
+				return da;
+			case Blend::InvDestAlpha:
+				return (1.0f - da);
+			case Blend::DestColor:
+				return d;
+			case Blend::InvDestColor:
+				return (1.0f - d);
+			case Blend::SrcAlphaSat:
+				return (alphaChannel ? 1.0f : Min(sa, (1.0f - da)));
+			default:
+				return 1.0f;
+			}
+		}
+
+		[[nodiscard]]
+		inline float BlendChannel(const BlendOp op, const float s, const float fs, const float d, const float fd) noexcept
+		{
+			switch (op)
+			{
+			case BlendOp::Subtract:
+				return ((s * fs) - (d * fd));
+			case BlendOp::RevSubtract:
+				return ((d * fd) - (s * fs));
+			case BlendOp::Min:
+				return Min(s, d);
+			case BlendOp::Max:
+				return Max(s, d);
+			default:
+				return ((s * fs) + (d * fd));
+			}
+		}
+
+		template <BlendMode Mode>
+		inline void BlendPixel(Color& dst, const Float4& shaded, const BlendState& blendState) noexcept
+		{
+			// UNORM の描画先では、シェーダの出力は [0, 1] に丸められてからブレンドされる
+			const Float4 src = Saturate(shaded);
+
+			if constexpr (Mode == BlendMode::Opaque)
+			{
+				dst = Color{ ToUnorm8(src.x), ToUnorm8(src.y), ToUnorm8(src.z), ToUnorm8(src.w) };
+			}
+			else if constexpr (Mode == BlendMode::NonPremultiplied)
+			{
+				const Float4 d = ToFloat4(dst);
+				const float sa = src.w;
+				dst.r = ToUnorm8(src.x * sa + d.x * (1.0f - sa));
+				dst.g = ToUnorm8(src.y * sa + d.y * (1.0f - sa));
+				dst.b = ToUnorm8(src.z * sa + d.z * (1.0f - sa));
+			}
+			else
+			{
+				const Float4 d = ToFloat4(dst);
+				Float4 result = src;
+
+				if (blendState.enable)
+				{
+					const float sa = src.w;
+					const float da = d.w;
+					result.x = BlendChannel(blendState.op, src.x, BlendFactor(blendState.src, src.x, d.x, sa, da, false), d.x, BlendFactor(blendState.dst, src.x, d.x, sa, da, false));
+					result.y = BlendChannel(blendState.op, src.y, BlendFactor(blendState.src, src.y, d.y, sa, da, false), d.y, BlendFactor(blendState.dst, src.y, d.y, sa, da, false));
+					result.z = BlendChannel(blendState.op, src.z, BlendFactor(blendState.src, src.z, d.z, sa, da, false), d.z, BlendFactor(blendState.dst, src.z, d.z, sa, da, false));
+					result.w = BlendChannel(blendState.opAlpha, sa, BlendFactor(blendState.srcAlpha, sa, da, sa, da, true), da, BlendFactor(blendState.dstAlpha, sa, da, sa, da, true));
+				}
+
+				if (blendState.writeR)
+				{
+					dst.r = ToUnorm8(result.x);
+				}
+
+				if (blendState.writeG)
+				{
+					dst.g = ToUnorm8(result.y);
+				}
+
+				if (blendState.writeB)
+				{
+					dst.b = ToUnorm8(result.z);
+				}
+
+				if (blendState.writeA)
+				{
+					dst.a = ToUnorm8(result.w);
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	Triangle
+		//
+		////////////////////////////////////////////////////////////////
+
+		[[nodiscard]]
+		bool SetupTriangle(const Vertex2D& v0, const Vertex2D& v1, const Vertex2D& v2,
+			const SoftwareRasterizer::ResolvedState& resolved, const uint32 stateIndex, SoftwareRasterizer::Triangle& triangle)
+		{
+			const Vertex2D* vertices[3] = { &v0, &v1, &v2 };
+			int64 X[3], Y[3];
+
+			for (size_t i = 0; i < 3; ++i)
+			{
+				const Float2 pos = (vertices[i]->pos + resolved.offset);
+
+				// NaN もここで除外される
+				if (not ((std::abs(pos.x) <= MaxCoordinate) && (std::abs(pos.y) <= MaxCoordinate)))
+				{
+					return false;
+				}
+
+				X[i] = std::llround(pos.x * SubPixelScale);
+				Y[i] = std::llround(pos.y * SubPixelScale);
+			}
+
+			// 画面座標（y 軸が下向き）で時計回りのとき正
+			int64 area = (((X[1] - X[0]) * (Y[2] - Y[0])) - ((X[2] - X[0]) * (Y[1] - Y[0])));
+
+			if (area == 0)
+			{
+				return false;
+			}
+
+			switch (resolved.state->rasterizerState.cullMode)
+			{
+			case CullMode::Front:
+				if (0 < area)
+				{
+					return false;
+				}
+				break;
+			case CullMode::Back:
+				if (area < 0)
+				{
+					return false;
+				}
+				break;
+			default:
+				break;
+			}
+
+			if (area < 0)
+			{
+				std::swap(X[1], X[2]);
+				std::swap(Y[1], Y[2]);
+				std::swap(vertices[1], vertices[2]);
+				area = -area;
+			}
+
+			// 中心が三角形の外接矩形に含まれるピクセルの範囲
+			{
+				const int64 minX = Min({ X[0], X[1], X[2] });
+				const int64 minY = Min({ Y[0], Y[1], Y[2] });
+				const int64 maxX = Max({ X[0], X[1], X[2] });
+				const int64 maxY = Max({ Y[0], Y[1], Y[2] });
+
+				triangle.minX = static_cast<int32>(Max<int64>(-FloorDiv(-(minX - HalfSubPixel), SubPixelScale), resolved.clipX0));
+				triangle.minY = static_cast<int32>(Max<int64>(-FloorDiv(-(minY - HalfSubPixel), SubPixelScale), resolved.clipY0));
+				triangle.maxX = static_cast<int32>(Min<int64>(FloorDiv((maxX - HalfSubPixel), SubPixelScale), (resolved.clipX1 - 1)));
+				triangle.maxY = static_cast<int32>(Min<int64>(FloorDiv((maxY - HalfSubPixel), SubPixelScale), (resolved.clipY1 - 1)));
+
+				if ((triangle.maxX < triangle.minX) || (triangle.maxY < triangle.minY))
+				{
+					return false;
+				}
+			}
+
+			// 辺関数とトップレフトルール
+			for (size_t i = 0; i < 3; ++i)
+			{
+				const size_t k = ((i + 1) % 3);
+				const int64 a = (Y[i] - Y[k]);
+				const int64 b = (X[k] - X[i]);
+				int64 c = -((a * X[i]) + (b * Y[i]));
+
+				// 左辺と上辺の上にあるピクセルだけを含める
+				if (not ((0 < a) || ((a == 0) && (0 < b))))
+				{
+					c -= 1;
+				}
+
+				triangle.a[i] = a;
+				triangle.b[i] = b;
+				triangle.c[i] = c;
+			}
+
+			// 頂点属性の平面
+			{
+				const double x0 = (static_cast<double>(X[0]) / SubPixelScale);
+				const double y0 = (static_cast<double>(Y[0]) / SubPixelScale);
+				const double x1 = (static_cast<double>(X[1]) / SubPixelScale);
+				const double y1 = (static_cast<double>(Y[1]) / SubPixelScale);
+				const double x2 = (static_cast<double>(X[2]) / SubPixelScale);
+				const double y2 = (static_cast<double>(Y[2]) / SubPixelScale);
+				const double det = (static_cast<double>(area) / (SubPixelScale * SubPixelScale));
+				const double cx = ((triangle.minX + 0.5) - x0);
+				const double cy = ((triangle.minY + 0.5) - y0);
+
+				const auto plane = [&](const float f0, const float f1, const float f2, float& base, float& dx, float& dy)
+				{
+					const double ddx = (((f1 - f0) * (y2 - y0)) - ((f2 - f0) * (y1 - y0))) / det;
+					const double ddy = (((f2 - f0) * (x1 - x0)) - ((f1 - f0) * (x2 - x0))) / det;
+					base = static_cast<float>(f0 + (ddx * cx) + (ddy * cy));
+					dx = static_cast<float>(ddx);
+					dy = static_cast<float>(ddy);
+				};
+
+				const Vertex2D& p0 = *vertices[0];
+				const Vertex2D& p1 = *vertices[1];
+				const Vertex2D& p2 = *vertices[2];
+
+				plane(p0.color.x, p1.color.x, p2.color.x, triangle.color.x, triangle.colorDx.x, triangle.colorDy.x);
+				plane(p0.color.y, p1.color.y, p2.color.y, triangle.color.y, triangle.colorDx.y, triangle.colorDy.y);
+				plane(p0.color.z, p1.color.z, p2.color.z, triangle.color.z, triangle.colorDx.z, triangle.colorDy.z);
+				plane(p0.color.w, p1.color.w, p2.color.w, triangle.color.w, triangle.colorDx.w, triangle.colorDy.w);
+				plane(p0.tex.x, p1.tex.x, p2.tex.x, triangle.uv.x, triangle.uvDx.x, triangle.uvDy.x);
+				plane(p0.tex.y, p1.tex.y, p2.tex.y, triangle.uv.y, triangle.uvDx.y, triangle.uvDy.y);
+			}
+
+			// 1 ピクセルあたりのテクセル数が 1 を超えるときは縮小
+			if (resolved.texture && *resolved.texture)
+			{
+				const Float2 size{ resolved.texture->width(), resolved.texture->height() };
+				const float fx = (triangle.uvDx * size).lengthSq();
+				const float fy = (triangle.uvDy * size).lengthSq();
+				triangle.minification = (1.0f < Max(fx, fy));
+			}
+			else
+			{
+				triangle.minification = false;
+			}
+
+			triangle.stateIndex = stateIndex;
+			return true;
+		}
+
+		/// @brief 三角形の、タイルに含まれる部分を描画する
+		template <SoftwarePixelShaderType PS, BlendMode Mode>
+		void RasterizeTriangle(const SoftwareRasterizer::Triangle& triangle, const SoftwareRasterizer::ResolvedState& resolved,
+			Image& target, const int32 tileX0, const int32 tileY0, const int32 tileX1, const int32 tileY1)
+		{
+			const int32 xs = Max(triangle.minX, tileX0);
+			const int32 xe = Min(triangle.maxX, (tileX1 - 1));
+			const int32 ys = Max(triangle.minY, tileY0);
+			const int32 ye = Min(triangle.maxY, (tileY1 - 1));
+
+			if ((xe < xs) || (ye < ys))
+			{
+				return;
+			}
+
+			const TextureSampler sampler{ resolved.texture, resolved.state->samplerState };
+			const BlendState& blendState = resolved.state->blendState;
+			const Float4 colorAdd = resolved.state->colorAdd;
+
+			ShadeContext ctx{ &sampler, resolved.state, triangle.uvDx, triangle.uvDy, 0.0f, triangle.minification };
+
+			if constexpr ((PS == SoftwarePixelShaderType::MSDFFont) || (PS == SoftwarePixelShaderType::MSDFFontOutline)
+				|| (PS == SoftwarePixelShaderType::MSDFFontShadow) || (PS == SoftwarePixelShaderType::MSDFFontOutlineShadow))
+			{
+				const Float2 size = sampler.size();
+				const float fwx = Max((std::abs(triangle.uvDx.x) + std::abs(triangle.uvDy.x)), 1e-12f);
+				const float fwy = Max((std::abs(triangle.uvDx.y) + std::abs(triangle.uvDy.y)), 1e-12f);
+				ctx.msdfScale = (((MSDFPixelRange / size.x) * (0.5f / fwx)) + ((MSDFPixelRange / size.y) * (0.5f / fwy)));
+			}
+
+			const int64 stepX0 = (triangle.a[0] * SubPixelScale);
+			const int64 stepX1 = (triangle.a[1] * SubPixelScale);
+			const int64 stepX2 = (triangle.a[2] * SubPixelScale);
+			const int64 px = ((xs * SubPixelScale) + HalfSubPixel);
+			const float ox = static_cast<float>(xs - triangle.minX);
+
+			for (int32 y = ys; y <= ye; ++y)
+			{
+				const int64 py = ((y * SubPixelScale) + HalfSubPixel);
+				int64 e0 = ((triangle.a[0] * px) + (triangle.b[0] * py) + triangle.c[0]);
+				int64 e1 = ((triangle.a[1] * px) + (triangle.b[1] * py) + triangle.c[1]);
+				int64 e2 = ((triangle.a[2] * px) + (triangle.b[2] * py) + triangle.c[2]);
+
+				const float oy = static_cast<float>(y - triangle.minY);
+				Float4 color = (triangle.color + (triangle.colorDx * ox) + (triangle.colorDy * oy));
+				Float2 uv = (triangle.uv + (triangle.uvDx * ox) + (triangle.uvDy * oy));
+				Color* pDst = (target[y] + xs);
+
+				for (int32 x = xs; x <= xe; ++x)
+				{
+					// いずれかの辺関数が負であれば OR も負になる
+					if (0 <= (e0 | e1 | e2))
+					{
+						const Float4 shaded = (Shade<PS>(ctx, color, uv) + colorAdd);
+						BlendPixel<Mode>(*pDst, shaded, blendState);
+					}
+
+					e0 += stepX0;
+					e1 += stepX1;
+					e2 += stepX2;
+					color += triangle.colorDx;
+					uv += triangle.uvDx;
+					++pDst;
+				}
+			}
+		}
+
+		using RasterizeFunc = void(*)(const SoftwareRasterizer::Triangle&, const SoftwareRasterizer::ResolvedState&, Image&, int32, int32, int32, int32);
+
+		template <SoftwarePixelShaderType PS>
+		[[nodiscard]]
+		RasterizeFunc SelectRasterizer(const BlendMode mode) noexcept
+		{
+			switch (mode)
+			{
+			case BlendMode::Opaque:
+				return &RasterizeTriangle<PS, BlendMode::Opaque>;
+			case BlendMode::NonPremultiplied:
+				return &RasterizeTriangle<PS, BlendMode::NonPremultiplied>;
+			default:
+				return &RasterizeTriangle<PS, BlendMode::Generic>;
+			}
+		}
+
+		[[nodiscard]]
+		RasterizeFunc SelectRasterizer(const SoftwarePixelShaderType ps, const BlendMode mode) noexcept
+		{
+			switch (ps)
+			{
+			case SoftwarePixelShaderType::SquareDot:
+				return SelectRasterizer<SoftwarePixelShaderType::SquareDot>(mode);
+			case SoftwarePixelShaderType::RoundDot:
+				return SelectRasterizer<SoftwarePixelShaderType::RoundDot>(mode);
+			case SoftwarePixelShaderType::Texture:
+				return SelectRasterizer<SoftwarePixelShaderType::Texture>(mode);
+			case SoftwarePixelShaderType::BitmapFont:
+				return SelectRasterizer<SoftwarePixelShaderType::BitmapFont>(mode);
+			case SoftwarePixelShaderType::SDFFont:
+				return SelectRasterizer<SoftwarePixelShaderType::SDFFont>(mode);
+			case SoftwarePixelShaderType::SDFFontOutline:
+				return SelectRasterizer<SoftwarePixelShaderType::SDFFontOutline>(mode);
+			case SoftwarePixelShaderType::SDFFontShadow:
+				return SelectRasterizer<SoftwarePixelShaderType::SDFFontShadow>(mode);
+			case SoftwarePixelShaderType::SDFFontOutlineShadow:
+				return SelectRasterizer<SoftwarePixelShaderType::SDFFontOutlineShadow>(mode);
+			case SoftwarePixelShaderType::MSDFFont:
+				return SelectRasterizer<SoftwarePixelShaderType::MSDFFont>(mode);
+			case SoftwarePixelShaderType::MSDFFontOutline:
+				return SelectRasterizer<SoftwarePixelShaderType::MSDFFontOutline>(mode);
+			case SoftwarePixelShaderType::MSDFFontShadow:
+				return SelectRasterizer<SoftwarePixelShaderType::MSDFFontShadow>(mode);
+			case SoftwarePixelShaderType::MSDFFontOutlineShadow:
+				return SelectRasterizer<SoftwarePixelShaderType::MSDFFontOutlineShadow>(mode);
+			default:
+				return SelectRasterizer<SoftwarePixelShaderType::Shape>(mode);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::draw(const SoftwareRenderer2DCommandManager& commandManager, Image& scene, CTexture_Software& texture, Renderer2DStat& stat)
+	{
+		const auto& draws = commandManager.getDraws();
+		const auto& states = commandManager.getStates();
+
+		for (const auto& draw : draws)
+		{
+			++stat.drawCalls;
+			stat.triangleCount += (draw.indexCount / 3);
+		}
+
+		// 描画先が同じ描画コマンドの並びごとに描画する
+		for (size_t i = 0; i < draws.size();)
+		{
+			const Texture::IDType targetID = states[draws[i].stateIndex].renderTarget;
+			size_t k = (i + 1);
+
+			while ((k < draws.size()) && (states[draws[k].stateIndex].renderTarget == targetID))
+			{
+				++k;
+			}
+
+			Image* pTarget = (targetID.isInvalid() ? &scene : texture.getRenderTargetImage(targetID));
+
+			if (pTarget && *pTarget)
+			{
+				drawTarget(commandManager, (draws.data() + i), (k - i), targetID, *pTarget, texture);
+			}
+
+			i = k;
+		}
+	}
+
+	void SoftwareRasterizer::drawTarget(const SoftwareRenderer2DCommandManager& commandManager, const SoftwareDrawCommand* pDraws, const size_t drawCount,
+		const Texture::IDType targetID, Image& target, CTexture_Software& texture)
+	{
+		const auto& vertices = commandManager.getVertices();
+		const auto& indices = commandManager.getIndices();
+
+		m_resolvedStates.assign(commandManager.getStates().size(), ResolvedState{});
+		m_targetSnapshot.clear();
+		m_triangles.clear();
+
+		// 三角形のセットアップ
+		for (size_t i = 0; i < drawCount; ++i)
+		{
+			const SoftwareDrawCommand& draw = pDraws[i];
+			const ResolvedState& resolved = resolveState(commandManager, draw.stateIndex, targetID, target, texture);
+
+			if ((resolved.clipX1 <= resolved.clipX0) || (resolved.clipY1 <= resolved.clipY0))
+			{
+				continue;
+			}
+
+			const Vertex2D* pVertex = (vertices.data() + draw.baseVertex);
+			const Vertex2D::IndexType* pIndex = (indices.data() + draw.startIndex);
+
+			for (uint32 t = 0; (t + 2) < draw.indexCount; t += 3)
+			{
+				Triangle triangle;
+
+				if (SetupTriangle(pVertex[pIndex[t]], pVertex[pIndex[t + 1]], pVertex[pIndex[t + 2]], resolved, draw.stateIndex, triangle))
+				{
+					m_triangles.push_back(triangle);
+				}
+			}
+		}
+
+		if (not m_triangles)
+		{
+			return;
+		}
+
+		// 三角形をタイルに振り分ける（各タイルの中では描画順を保つ）
+		const int32 tilesX = ((target.width() + TileSize - 1) / TileSize);
+		const int32 tilesY = ((target.height() + TileSize - 1) / TileSize);
+		const size_t tileCount = (static_cast<size_t>(tilesX) * tilesY);
+
+		m_tileOffsets.assign((tileCount + 1), 0);
+
+		for (const auto& triangle : m_triangles)
+		{
+			for (int32 ty = (triangle.minY / TileSize); ty <= (triangle.maxY / TileSize); ++ty)
+			{
+				for (int32 tx = (triangle.minX / TileSize); tx <= (triangle.maxX / TileSize); ++tx)
+				{
+					++m_tileOffsets[(static_cast<size_t>(ty) * tilesX) + tx + 1];
+				}
+			}
+		}
+
+		m_activeTiles.clear();
+
+		for (size_t i = 0; i < tileCount; ++i)
+		{
+			if (m_tileOffsets[i + 1])
+			{
+				m_activeTiles.push_back(static_cast<uint32>(i));
+			}
+
+			m_tileOffsets[i + 1] += m_tileOffsets[i];
+		}
+
+		m_tileTriangles.resize(m_tileOffsets.back());
+
+		{
+			Array<uint32> writePos(m_tileOffsets.begin(), (m_tileOffsets.end() - 1));
+
+			for (uint32 triangleIndex = 0; triangleIndex < m_triangles.size(); ++triangleIndex)
+			{
+				const Triangle& triangle = m_triangles[triangleIndex];
+
+				for (int32 ty = (triangle.minY / TileSize); ty <= (triangle.maxY / TileSize); ++ty)
+				{
+					for (int32 tx = (triangle.minX / TileSize); tx <= (triangle.maxX / TileSize); ++tx)
+					{
+						m_tileTriangles[writePos[(static_cast<size_t>(ty) * tilesX) + tx]++] = triangleIndex;
+					}
+				}
+			}
+		}
+
+		const auto drawTiles = [&](const size_t first, const size_t last)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				const uint32 tileIndex = m_activeTiles[i];
+				const int32 tileX0 = static_cast<int32>((tileIndex % tilesX) * TileSize);
+				const int32 tileY0 = static_cast<int32>((tileIndex / tilesX) * TileSize);
+				const int32 tileX1 = Min((tileX0 + TileSize), target.width());
+				const int32 tileY1 = Min((tileY0 + TileSize), target.height());
+
+				for (uint32 n = m_tileOffsets[tileIndex]; n < m_tileOffsets[tileIndex + 1]; ++n)
+				{
+					const Triangle& triangle = m_triangles[m_tileTriangles[n]];
+					const ResolvedState& resolved = m_resolvedStates[triangle.stateIndex];
+					const RasterizeFunc rasterize = SelectRasterizer(resolved.state->pixelShader, GetBlendMode(resolved.state->blendState));
+					rasterize(triangle, resolved, target, tileX0, tileY0, tileX1, tileY1);
+				}
+			}
+		};
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if ((1 < m_activeTiles.size()) && (0 < Threading::GetWorkerCount()))
+		{
+			Threading::ParallelFor(0, m_activeTiles.size(), drawTiles);
+			return;
+		}
+
+	# endif
+
+		drawTiles(0, m_activeTiles.size());
+	}
+
+	const SoftwareRasterizer::ResolvedState& SoftwareRasterizer::resolveState(const SoftwareRenderer2DCommandManager& commandManager, const uint32 stateIndex,
+		const Texture::IDType targetID, const Image& target, CTexture_Software& texture)
+	{
+		ResolvedState& resolved = m_resolvedStates[stateIndex];
+
+		if (resolved.resolved)
+		{
+			return resolved;
+		}
+
+		const SoftwareRenderState& state = commandManager.getStates()[stateIndex];
+		resolved.state = &state;
+		resolved.resolved = true;
+
+		// 描画範囲: 描画先 ∩ ビューポート ∩ シザー矩形
+		int32 x0 = 0, y0 = 0, x1 = target.width(), y1 = target.height();
+
+		if (state.viewport)
+		{
+			const Rect& viewport = *state.viewport;
+			x0 = Max(x0, viewport.x);
+			y0 = Max(y0, viewport.y);
+			x1 = Min(x1, (viewport.x + viewport.w));
+			y1 = Min(y1, (viewport.y + viewport.h));
+			resolved.offset = Float2{ viewport.x, viewport.y };
+		}
+
+		if (state.rasterizerState.scissorEnable)
+		{
+			const Rect& scissor = state.scissorRect;
+			x0 = Max(x0, scissor.x);
+			y0 = Max(y0, scissor.y);
+			x1 = Min(x1, (scissor.x + scissor.w));
+			y1 = Min(y1, (scissor.y + scissor.h));
+		}
+
+		resolved.clipX0 = x0;
+		resolved.clipY0 = y0;
+		resolved.clipX1 = x1;
+		resolved.clipY1 = y1;
+
+		if (not state.texture.isInvalid())
+		{
+			if ((state.texture == targetID) && (not targetID.isInvalid()))
+			{
+				// 描画中の画像を読み取らないよう、描画前の内容を使う
+				if (not m_targetSnapshot)
+				{
+					m_targetSnapshot = target;
+				}
+
+				resolved.texture = &m_targetSnapshot;
+			}
+			else
+			{
+				resolved.texture = &texture.getImage(state.texture);
+			}
+		}
+
+		return resolved;
+	}
+}
@@ -0,0 +1,97 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Image.hpp>
+# include "SoftwareRenderer2DCommand.hpp"
+
+namespace s3d
+{
+	class CTexture_Software;
+	struct Renderer2DStat;
+
+	/// @brief 記録された 2D 描画コマンドを CPU で Image に描画するラスタライザ
+	/// @remark 描画先を TileSize x TileSize ピクセルのタイルに分割し、タイルごとに並列に処理します。
+	/// 各タイルの中では三角形を記録された順に描画するため、描画結果はスレッド数によらず同じです。
+	class SoftwareRasterizer
+	{
+	public:
+
+		/// @brief タイルの一辺のピクセル数
+		static constexpr int32 TileSize = 64;
+
+		/// @brief 描画コマンドを描画します。
+		/// @param commandManager 描画コマンド
+		/// @param scene シーンの画像
+		/// @param texture テクスチャの管理
+		/// @param stat 描画の統計情報
+		void draw(const SoftwareRenderer2DCommandManager& commandManager, Image& scene, CTexture_Software& texture, Renderer2DStat& stat);
+
+		/// @brief 描画前の三角形の情報
+		struct Triangle
+		{
+			/// @brief 3 辺の辺関数 E(x, y) = a * x + b * y + c の係数（座標は 1/256 ピクセル単位）
+			std::array<int64, 3> a, b, c;
+
+			/// @brief 描画するピクセルの範囲（両端を含む）
+			int32 minX, minY, maxX, maxY;
+
+			/// @brief ピクセル (minX, minY) の中心での頂点色と UV, および 1 ピクセルあたりの変化量
+			Float4 color, colorDx, colorDy;
+
+			Float2 uv, uvDx, uvDy;
+
+			/// @brief テクスチャの縮小時に true
+			bool minification;
+
+			uint32 stateIndex;
+		};
+
+		/// @brief 描画先ごとに解決した描画ステート
+		struct ResolvedState
+		{
+			const SoftwareRenderState* state = nullptr;
+
+			const Image* texture = nullptr;
+
+			/// @brief 描画できる範囲（右端と下端を含まない）
+			int32 clipX0 = 0, clipY0 = 0, clipX1 = 0, clipY1 = 0;
+
+			/// @brief ビューポートによる座標のオフセット
+			Float2 offset{ 0.0f, 0.0f };
+
+			bool resolved = false;
+		};
+
+	private:
+
+		Array<Triangle> m_triangles;
+
+		Array<ResolvedState> m_resolvedStates;
+
+		Array<uint32> m_tileOffsets;
+
+		Array<uint32> m_tileTriangles;
+
+		Array<uint32> m_activeTiles;
+
+		/// @brief 描画先と同じテクスチャを参照する場合に使う、描画前の描画先のコピー
+		Image m_targetSnapshot;
+
+		void drawTarget(const SoftwareRenderer2DCommandManager& commandManager, const SoftwareDrawCommand* pDraws, size_t drawCount,
+			Texture::IDType targetID, Image& target, CTexture_Software& texture);
+
+		const ResolvedState& resolveState(const SoftwareRenderer2DCommandManager& commandManager, uint32 stateIndex,
+			Texture::IDType targetID, const Image& target, CTexture_Software& texture);
+	};
+}
@@ -0,0 +1,310 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "SoftwareRenderer2DCommand.hpp"
+# include <Siv3D/Renderer2D/CurrentBatchStateChanges.hpp>
+
+namespace s3d
+{
+	namespace
+	{
+		/// @brief 16-bit インデックスで参照できる頂点の数
+		constexpr uint32 MaxBatchVertexCount = 65535;
+	}
+
+	SoftwareRenderer2DCommandManager::SoftwareRenderer2DCommandManager()
+	{
+		m_currentPSSamplerStates.fill(SamplerState::Default2D);
+
+		reset();
+	}
+
+	void SoftwareRenderer2DCommandManager::reset()
+	{
+		// clear buffers
+		{
+			m_vertices.clear();
+			m_indices.clear();
+			m_draws.clear();
+			m_states.clear();
+			m_baseVertex = 0;
+			m_processedVertexCount = 0;
+		}
+
+		// clear reserves
+		{
+			m_reservedTextures.clear();
+		}
+
+		// Begin a new frame
+		{
+			m_currentPSTextures.fill(Texture::IDType::InvalidValue());
+			m_currentState.texture = Texture::IDType::InvalidValue();
+			m_stateChanged = true;
+		}
+	}
+
+	Vertex2DBufferPointer SoftwareRenderer2DCommandManager::requestBuffer(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+	{
+		// インデックスが 16-bit に収まらない場合は、基準となる頂点の位置を進める
+		if (MaxBatchVertexCount < ((m_vertices.size() - m_baseVertex) + vertexSize))
+		{
+			m_baseVertex = static_cast<uint32>(m_vertices.size());
+		}
+
+		const size_t vertexPos = m_vertices.size();
+		const size_t indexPos = m_indices.size();
+
+		m_vertices.resize(vertexPos + vertexSize);
+		m_indices.resize(indexPos + indexSize);
+
+		return{ (m_vertices.data() + vertexPos), (m_indices.data() + indexPos), static_cast<Vertex2D::IndexType>(vertexPos - m_baseVertex) };
+	}
+
+	void SoftwareRenderer2DCommandManager::pushDraw(const Vertex2D::IndexType indexCount)
+	{
+		// 新しく書き込まれた頂点に、現在の座標変換と乗算色を適用する
+		{
+			const Mat3x2& mat = m_currentCombinedTransform;
+			const Float4 colorMul = m_currentColorMul;
+
+			for (size_t i = m_processedVertexCount; i < m_vertices.size(); ++i)
+			{
+				Vertex2D& v = m_vertices[i];
+				v.pos = mat.transformPoint(v.pos);
+				v.color *= colorMul;
+			}
+
+			m_processedVertexCount = static_cast<uint32>(m_vertices.size());
+		}
+
+		if (m_stateChanged)
+		{
+			if (m_states.isEmpty() || (m_states.back() != m_currentState))
+			{
+				m_states.push_back(m_currentState);
+			}
+
+			m_stateChanged = false;
+		}
+
+		const uint32 stateIndex = static_cast<uint32>(m_states.size() - 1);
+		const uint32 startIndex = static_cast<uint32>(m_indices.size() - indexCount);
+
+		// 直前の描画と連続していれば、まとめる
+		if (m_draws)
+		{
+			SoftwareDrawCommand& last = m_draws.back();
+
+			if ((last.stateIndex == stateIndex)
+				&& (last.baseVertex == m_baseVertex)
+				&& ((last.startIndex + last.indexCount) == startIndex))
+			{
+				last.indexCount += indexCount;
+				return;
+			}
+		}
+
+		m_draws.push_back({ startIndex, indexCount, m_baseVertex, stateIndex });
+	}
+
+	const Array<Vertex2D>& SoftwareRenderer2DCommandManager::getVertices() const noexcept
+	{
+		return m_vertices;
+	}
+
+	const Array<Vertex2D::IndexType>& SoftwareRenderer2DCommandManager::getIndices() const noexcept
+	{
+		return m_indices;
+	}
+
+	const Array<SoftwareDrawCommand>& SoftwareRenderer2DCommandManager::getDraws() const noexcept
+	{
+		return m_draws;
+	}
+
+	const Array<SoftwareRenderState>& SoftwareRenderer2DCommandManager::getStates() const noexcept
+	{
+		return m_states;
+	}
+
+	const SoftwareRenderState& SoftwareRenderer2DCommandManager::getCurrentState() const noexcept
+	{
+		return m_currentState;
+	}
+
+	void SoftwareRenderer2DCommandManager::pushColorMul(const Float4& color)
+	{
+		m_currentColorMul = color;
+	}
+
+	const Float4& SoftwareRenderer2DCommandManager::getCurrentColorMul() const noexcept
+	{
+		return m_currentColorMul;
+	}
+
+	void SoftwareRenderer2DCommandManager::pushColorAdd(const Float4& color)
+	{
+		setState(&SoftwareRenderState::colorAdd, color);
+	}
+
+	void SoftwareRenderer2DCommandManager::pushBlendState(const BlendState& state)
+	{
+		setState(&SoftwareRenderState::blendState, state);
+	}
+
+	void SoftwareRenderer2DCommandManager::pushRasterizerState(const RasterizerState& state)
+	{
+		setState(&SoftwareRenderState::rasterizerState, state);
+	}
+
+	void SoftwareRenderer2DCommandManager::pushSamplerState(const SamplerState& state, const uint32 slot)
+	{
+		assert(slot < SamplerState::MaxSamplerCount);
+
+		m_currentPSSamplerStates[slot] = state;
+
+		if (slot == 0)
+		{
+			setState(&SoftwareRenderState::samplerState, state);
+		}
+	}
+
+	const SamplerState& SoftwareRenderer2DCommandManager::getCurrentSamplerState(const uint32 slot) const
+	{
+		assert(slot < SamplerState::MaxSamplerCount);
+
+		return m_currentPSSamplerStates[slot];
+	}
+
+	void SoftwareRenderer2DCommandManager::pushScissorRect(const Rect& rect)
+	{
+		setState(&SoftwareRenderState::scissorRect, rect);
+	}
+
+	void SoftwareRenderer2DCommandManager::pushViewport(const Optional<Rect>& viewport)
+	{
+		setState(&SoftwareRenderState::viewport, viewport);
+	}
+
+	void SoftwareRenderer2DCommandManager::pushSDFParameters(const std::array<Float4, 3>& params)
+	{
+		setState(&SoftwareRenderState::sdfParams, params);
+	}
+
+	void SoftwareRenderer2DCommandManager::pushPixelShader(const SoftwarePixelShaderType type)
+	{
+		setState(&SoftwareRenderState::pixelShader, type);
+	}
+
+	void SoftwareRenderer2DCommandManager::pushLocalTransform(const Mat3x2& local)
+	{
+		m_currentLocalTransform = local;
+		m_currentCombinedTransform = (local * m_currentCameraTransform);
+		m_currentMaxScaling = detail::CalculateMaxScaling(m_currentCombinedTransform);
+	}
+
+	const Mat3x2& SoftwareRenderer2DCommandManager::getCurrentLocalTransform() const noexcept
+	{
+		return m_currentLocalTransform;
+	}
+
+	void SoftwareRenderer2DCommandManager::pushCameraTransform(const Mat3x2& camera)
+	{
+		m_currentCameraTransform = camera;
+		m_currentCombinedTransform = (m_currentLocalTransform * camera);
+		m_currentMaxScaling = detail::CalculateMaxScaling(m_currentCombinedTransform);
+	}
+
+	const Mat3x2& SoftwareRenderer2DCommandManager::getCurrentCameraTransform() const noexcept
+	{
+		return m_currentCameraTransform;
+	}
+
+	float SoftwareRenderer2DCommandManager::getCurrentMaxScaling() const noexcept
+	{
+		return m_currentMaxScaling;
+	}
+
+	void SoftwareRenderer2DCommandManager::pushPSTextureUnbind(const uint32 slot)
+	{
+		assert(slot < SamplerState::MaxSamplerCount);
+
+		m_currentPSTextures[slot] = Texture::IDType::InvalidValue();
+
+		if (slot == 0)
+		{
+			setState(&SoftwareRenderState::texture, Texture::IDType::InvalidValue());
+		}
+	}
+
+	void SoftwareRenderer2DCommandManager::pushPSTexture(const uint32 slot, const Texture& texture)
+	{
+		assert(slot < SamplerState::MaxSamplerCount);
+
+		const auto id = texture.id();
+		m_currentPSTextures[slot] = id;
+
+		// flush() までテクスチャが解放されないよう保持する
+		if (m_reservedTextures.find(id) == m_reservedTextures.end())
+		{
+			m_reservedTextures.emplace(id, texture);
+		}
+
+		if (slot == 0)
+		{
+			setState(&SoftwareRenderState::texture, id);
+		}
+	}
+
+	Texture::IDType SoftwareRenderer2DCommandManager::getCurrentPSTexture(const uint32 slot) const
+	{
+		assert(slot < SamplerState::MaxSamplerCount);
+
+		return m_currentPSTextures[slot];
+	}
+
+	void SoftwareRenderer2DCommandManager::pushRT(const Optional<RenderTexture>& rt)
+	{
+		m_currentRT = rt;
+
+		if (rt)
+		{
+			const auto id = rt->id();
+
+			if (m_reservedTextures.find(id) == m_reservedTextures.end())
+			{
+				m_reservedTextures.emplace(id, *rt);
+			}
+
+			setState(&SoftwareRenderState::renderTarget, id);
+		}
+		else
+		{
+			setState(&SoftwareRenderState::renderTarget, Texture::IDType::InvalidValue());
+		}
+	}
+
+	const Optional<RenderTexture>& SoftwareRenderer2DCommandManager::getCurrentRT() const noexcept
+	{
+		return m_currentRT;
+	}
+
+	template <class Type>
+	void SoftwareRenderer2DCommandManager::setState(Type SoftwareRenderState::* member, const Type& value)
+	{
+		if (not (m_currentState.*member == value))
+		{
+			m_currentState.*member = value;
+			m_stateChanged = true;
+		}
+	}
+}
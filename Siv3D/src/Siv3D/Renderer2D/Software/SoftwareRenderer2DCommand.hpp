@@ -0,0 +1,205 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/Vertex2D.hpp>
+# include <Siv3D/BlendState.hpp>
+# include <Siv3D/RasterizerState.hpp>
+# include <Siv3D/SamplerState.hpp>
+# include <Siv3D/Texture.hpp>
+# include <Siv3D/RenderTexture.hpp>
+# include <Siv3D/Mat3x2.hpp>
+# include <Siv3D/Renderer2D/Vertex2DBufferPointer.hpp>
+
+namespace s3d
+{
+	/// @brief ソフトウェアレンダラーが CPU で実行するピクセルシェーダの種類
+	/// @remark それぞれ engine/shader/glsl/ の同名のシェーダと同じ計算を行います。
+	enum class SoftwarePixelShaderType : uint8
+	{
+		Shape,
+
+		SquareDot,
+
+		RoundDot,
+
+		Texture,
+
+		BitmapFont,
+
+		SDFFont,
+
+		SDFFontOutline,
+
+		SDFFontShadow,
+
+		SDFFontOutlineShadow,
+
+		MSDFFont,
+
+		MSDFFontOutline,
+
+		MSDFFontShadow,
+
+		MSDFFontOutlineShadow,
+	};
+
+	/// @brief 描画コマンドに適用される描画ステート
+	struct SoftwareRenderState
+	{
+		BlendState blendState				= BlendState::Default2D;
+
+		RasterizerState rasterizerState		= RasterizerState::Default2D;
+
+		SamplerState samplerState			= SamplerState::Default2D;
+
+		Rect scissorRect					= Rect{ 0 };
+
+		Optional<Rect> viewport;
+
+		Float4 colorAdd						= Float4{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+		std::array<Float4, 3> sdfParams		= { Float4{ 0.5f, 0.5f, 0.0f, 0.0f }, Float4{ 0.0f, 0.0f, 0.0f, 1.0f }, Float4{ 0.0f, 0.0f, 0.0f, 0.5f } };
+
+		/// @brief PS のテクスチャスロット 0
+		Texture::IDType texture				= Texture::IDType::InvalidValue();
+
+		/// @brief 描画先のレンダーテクスチャ。シーンに描画する場合は InvalidValue
+		Texture::IDType renderTarget		= Texture::IDType::InvalidValue();
+
+		SoftwarePixelShaderType pixelShader	= SoftwarePixelShaderType::Shape;
+
+		[[nodiscard]]
+		bool operator ==(const SoftwareRenderState&) const noexcept = default;
+	};
+
+	/// @brief 同じ描画ステートで描画する三角形の範囲
+	struct SoftwareDrawCommand
+	{
+		uint32 startIndex = 0;
+
+		uint32 indexCount = 0;
+
+		uint32 baseVertex = 0;
+
+		uint32 stateIndex = 0;
+	};
+
+	/// @brief 1 フレームの 2D 描画の頂点と描画コマンドを記録するクラス
+	/// @remark 頂点の座標変換と乗算色の適用は、記録時に済ませます。
+	class SoftwareRenderer2DCommandManager
+	{
+	public:
+
+		SoftwareRenderer2DCommandManager();
+
+		void reset();
+
+		[[nodiscard]]
+		Vertex2DBufferPointer requestBuffer(Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize);
+
+		void pushDraw(Vertex2D::IndexType indexCount);
+
+		[[nodiscard]]
+		const Array<Vertex2D>& getVertices() const noexcept;
+
+		[[nodiscard]]
+		const Array<Vertex2D::IndexType>& getIndices() const noexcept;
+
+		[[nodiscard]]
+		const Array<SoftwareDrawCommand>& getDraws() const noexcept;
+
+		[[nodiscard]]
+		const Array<SoftwareRenderState>& getStates() const noexcept;
+
+		[[nodiscard]]
+		const SoftwareRenderState& getCurrentState() const noexcept;
+
+		void pushColorMul(const Float4& color);
+		[[nodiscard]]
+		const Float4& getCurrentColorMul() const noexcept;
+
+		void pushColorAdd(const Float4& color);
+
+		void pushBlendState(const BlendState& state);
+
+		void pushRasterizerState(const RasterizerState& state);
+
+		void pushSamplerState(const SamplerState& state, uint32 slot);
+		[[nodiscard]]
+		const SamplerState& getCurrentSamplerState(uint32 slot) const;
+
+		void pushScissorRect(const Rect& rect);
+
+		void pushViewport(const Optional<Rect>& viewport);
+
+		void pushSDFParameters(const std::array<Float4, 3>& params);
+
+		void pushPixelShader(SoftwarePixelShaderType type);
+
+		void pushLocalTransform(const Mat3x2& local);
+		[[nodiscard]]
+		const Mat3x2& getCurrentLocalTransform() const noexcept;
+
+		void pushCameraTransform(const Mat3x2& camera);
+		[[nodiscard]]
+		const Mat3x2& getCurrentCameraTransform() const noexcept;
+
+		[[nodiscard]]
+		float getCurrentMaxScaling() const noexcept;
+
+		void pushPSTextureUnbind(uint32 slot);
+		void pushPSTexture(uint32 slot, const Texture& texture);
+		[[nodiscard]]
+		Texture::IDType getCurrentPSTexture(uint32 slot) const;
+
+		void pushRT(const Optional<RenderTexture>& rt);
+		[[nodiscard]]
+		const Optional<RenderTexture>& getCurrentRT() const noexcept;
+
+	private:
+
+		// buffer
+		Array<Vertex2D> m_vertices;
+		Array<Vertex2D::IndexType> m_indices;
+		Array<SoftwareDrawCommand> m_draws;
+		Array<SoftwareRenderState> m_states;
+
+		/// @brief 現在のインデックスが基準とする頂点の位置
+		uint32 m_baseVertex = 0;
+
+		/// @brief 座標変換済みの頂点の数
+		uint32 m_processedVertexCount = 0;
+
+		// current
+		SoftwareRenderState m_currentState;
+		bool m_stateChanged = true;
+		Float4 m_currentColorMul				= Float4{ 1.0f, 1.0f, 1.0f, 1.0f };
+		std::array<SamplerState, SamplerState::MaxSamplerCount> m_currentPSSamplerStates;
+		std::array<Texture::IDType, SamplerState::MaxSamplerCount> m_currentPSTextures;
+		Optional<RenderTexture> m_currentRT;
+		Mat3x2 m_currentLocalTransform			= Mat3x2::Identity();
+		Mat3x2 m_currentCameraTransform			= Mat3x2::Identity();
+		Mat3x2 m_currentCombinedTransform		= Mat3x2::Identity();
+		float m_currentMaxScaling				= 1.0f;
+
+		// reserved
+		HashTable<Texture::IDType, Texture> m_reservedTextures;
+
+		template <class Type>
+		void setState(Type SoftwareRenderState::* member, const Type& value);
+	};
+}
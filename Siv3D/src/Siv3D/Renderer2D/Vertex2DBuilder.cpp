@@ -13,13 +13,12 @@
 # include <Siv3D/FastMath.hpp>
 # include <Siv3D/Math.hpp>
 # include <Siv3D/OffsetCircular.hpp>
+# include <Siv3D/SIMD.hpp>
 
 namespace s3d
 {
 	namespace detail
 	{
-		static constexpr Vertex2D::IndexType RectIndexTable[6] = { 0, 1, 2, 2, 1, 3 };
-
 		static constexpr Vertex2D::IndexType RectFrameIndexTable[24] = { 0, 1, 2, 3, 2, 1, 0, 4, 1, 5, 1, 4, 5, 4, 7, 6, 7, 4, 3, 7, 2, 6, 2, 7 };
 
 		static constexpr Vertex2D::IndexType MaxSinCosTableQuality = 40;
@@ -116,6 +115,46 @@ namespace s3d
 				: r <= 12.0f ? 8
 				: static_cast<Vertex2D::IndexType>(Min(64.0f, r * 0.2f + 6));
 		}
+
+		/// @brief 長方形 quadCount 個分のインデックスを書き込みます。
+		inline void WriteQuadIndices(Vertex2D::IndexType* pIndex, const Vertex2D::IndexType indexOffset, const size_t quadCount) noexcept
+		{
+			// 4 個の長方形（24 インデックス）をまとめて書き込む
+			const __m128i pattern0 = _mm_setr_epi16(0, 1, 2, 2, 1, 3, 4, 5);
+			const __m128i pattern1 = _mm_setr_epi16(6, 6, 5, 7, 8, 9, 10, 10);
+			const __m128i pattern2 = _mm_setr_epi16(9, 11, 12, 13, 14, 14, 13, 15);
+			const __m128i step = _mm_set1_epi16(16);
+			__m128i base = _mm_set1_epi16(static_cast<int16>(indexOffset));
+
+			size_t n = 0;
+
+			for (; (n + 4) <= quadCount; n += 4)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pIndex + 0), _mm_add_epi16(base, pattern0));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pIndex + 8), _mm_add_epi16(base, pattern1));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pIndex + 16), _mm_add_epi16(base, pattern2));
+				pIndex += 24;
+				base = _mm_add_epi16(base, step);
+			}
+
+			Vertex2D::IndexType indexBase = static_cast<Vertex2D::IndexType>(indexOffset + n * 4);
+
+			for (; n < quadCount; ++n)
+			{
+				for (Vertex2D::IndexType i = 0; i < 6; ++i)
+				{
+					*pIndex++ = (indexBase + RectIndexTable[i]);
+				}
+
+				indexBase += 4;
+			}
+		}
+
+		[[nodiscard]]
+		inline __m128 ToFloat4(const ColorF& color) noexcept
+		{
+			return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(&color.r)), _mm_cvtpd_ps(_mm_loadu_pd(&color.b)));
+		}
 	}
 
 	namespace Vertex2DBuilder
@@ -328,94 +367,6 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4& color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(points[0], color);
-			pVertex[1].set(points[1], color);
-			pVertex[2].set(points[2], color);
-
-			pIndex[0] = indexOffset;
-			pIndex[1] = (indexOffset + 1);
-			pIndex[2] = (indexOffset + 2);
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3])
-		{
-			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(points[0], colors[0]);
-			pVertex[1].set(points[1], colors[1]);
-			pVertex[2].set(points[2], colors[2]);
-
-			pIndex[0] = indexOffset;
-			pIndex[1] = (indexOffset + 1);
-			pIndex[2] = (indexOffset + 2);
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4& color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(rect.left, rect.top, color);
-			pVertex[1].set(rect.right, rect.top, color);
-			pVertex[2].set(rect.left, rect.bottom, color);
-			pVertex[3].set(rect.right, rect.bottom, color);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(rect.left, rect.top, colors[0]);
-			pVertex[1].set(rect.right, rect.top, colors[1]);
-			pVertex[2].set(rect.left, rect.bottom, colors[3]);
-			pVertex[3].set(rect.right, rect.bottom, colors[2]);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
 		Vertex2D::IndexType BuildRectFrame(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 8, indexSize = 24;
@@ -990,52 +941,6 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4 color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(quad.p[0], color);
-			pVertex[1].set(quad.p[1], color);
-			pVertex[2].set(quad.p[3], color);
-			pVertex[3].set(quad.p[2], color);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(quad.p[0], colors[0]);
-			pVertex[1].set(quad.p[1], colors[1]);
-			pVertex[2].set(quad.p[3], colors[3]);
-			pVertex[3].set(quad.p[2], colors[2]);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
 		Vertex2D::IndexType BuildRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale)
 		{
 			const float rr = Min({ w * 0.5f, h * 0.5f, Max(0.0f, r) });
@@ -2668,52 +2573,6 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(rect.left, rect.top, uv.left, uv.top, color);
-			pVertex[1].set(rect.right, rect.top, uv.right, uv.top, color);
-			pVertex[2].set(rect.left, rect.bottom, uv.left, uv.bottom, color);
-			pVertex[3].set(rect.right, rect.bottom, uv.right, uv.bottom, color);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(rect.left, rect.top, uv.left, uv.top, colors[0]);
-			pVertex[1].set(rect.right, rect.top, uv.right, uv.top, colors[1]);
-			pVertex[2].set(rect.left, rect.bottom, uv.left, uv.bottom, colors[3]);
-			pVertex[3].set(rect.right, rect.bottom, uv.right, uv.bottom, colors[2]);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
 		Vertex2D::IndexType BuildTexturedCircle(const BufferCreatorFunc& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, const float scale)
 		{
 			const float rf = static_cast<float>(circle.r);
@@ -2772,29 +2631,6 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTexturedQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
-		{
-			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
-
-			if (not pVertex)
-			{
-				return 0;
-			}
-
-			pVertex[0].set(quad.p[0], uv.left, uv.top, color);
-			pVertex[1].set(quad.p[1], uv.right, uv.top, color);
-			pVertex[2].set(quad.p[3], uv.left, uv.bottom, color);
-			pVertex[3].set(quad.p[2], uv.right, uv.bottom, color);
-
-			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
-			{
-				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
-			}
-
-			return indexSize;
-		}
-
 		Vertex2D::IndexType BuildTexturedRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, const float w, const float h, const float r, const FloatRect& uvRect, const Float4& color, const float scale)
 		{
 			const float rr = Min({ w * 0.5f, h * 0.5f, Max(0.0f, r) });
@@ -3512,7 +3348,7 @@ namespace s3d
 			return indexCount;
 		}
 
-		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Array<Particle2D>& particles,
+		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const ParticleBuffer2D& particles,
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc)
 		{
 			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(particles.size() * 4);
@@ -3524,17 +3360,21 @@ namespace s3d
 				return 0;
 			}
 
-			for (const auto& particle : particles)
+			const size_t particleCount = particles.size();
+
+			for (size_t n = 0; n < particleCount; ++n)
 			{
-				const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-				const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
+				const float startLifeTime = particles.startLifeTime[n];
+				const float remainingLifeTime = particles.remainingLifeTime[n];
+				const float size = sizeOverLifeTimeFunc(particles.startSize[n], startLifeTime, remainingLifeTime);
+				const Float4 color = colorOverLifeTimeFunc(particles.startColor[n], startLifeTime, remainingLifeTime);
 
 				const float size_half = (size * 0.5f);
-				const float cx = particle.position.x;
-				const float cy = particle.position.y;
+				const float cx = particles.positionX[n];
+				const float cy = particles.positionY[n];
 
 				const float x = size_half;
-				const auto [s, c] = FastMath::SinCos(particle.rotation);
+				const auto [s, c] = FastMath::SinCos(particles.rotation[n]);
 				const float xc = x * c;
 				const float xs = x * s;
 
@@ -3561,5 +3401,186 @@ namespace s3d
 
 			return indexSize;
 		}
+
+		Vertex2D::IndexType BuildRects(const BufferCreatorFunc& bufferCreator, const RectF* rects, const ColorF* colors, const size_t count, const Float4& color)
+		{
+			assert(count <= MaxBulkQuadCount);
+
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(count * 4);
+			const Vertex2D::IndexType indexSize = static_cast<Vertex2D::IndexType>(count * 6);
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			const __m128 zero = _mm_setzero_ps();
+			__m128 col = _mm_loadu_ps(&color.x);
+
+			for (size_t n = 0; n < count; ++n)
+			{
+				const RectF& rect = rects[n];
+				const __m128d xy = _mm_loadu_pd(&rect.x);
+				const __m128d wh = _mm_loadu_pd(&rect.w);
+				const __m128 ltrb = _mm_movelh_ps(_mm_cvtpd_ps(xy), _mm_cvtpd_ps(_mm_add_pd(xy, wh))); // (l, t, r, b)
+
+				if (colors)
+				{
+					col = detail::ToFloat4(colors[n]);
+				}
+
+				// (pos, tex) と color をそれぞれ 16 バイトで書き込む
+				float* const p = &pVertex->pos.x;
+				_mm_storeu_ps((p + 0), _mm_shuffle_ps(ltrb, zero, _MM_SHUFFLE(0, 0, 1, 0)));
+				_mm_storeu_ps((p + 4), col);
+				_mm_storeu_ps((p + 8), _mm_shuffle_ps(ltrb, zero, _MM_SHUFFLE(0, 0, 1, 2)));
+				_mm_storeu_ps((p + 12), col);
+				_mm_storeu_ps((p + 16), _mm_shuffle_ps(ltrb, zero, _MM_SHUFFLE(0, 0, 3, 0)));
+				_mm_storeu_ps((p + 20), col);
+				_mm_storeu_ps((p + 24), _mm_shuffle_ps(ltrb, zero, _MM_SHUFFLE(0, 0, 3, 2)));
+				_mm_storeu_ps((p + 28), col);
+				pVertex += 4;
+			}
+
+			detail::WriteQuadIndices(pIndex, indexOffset, count);
+
+			return indexSize;
+		}
+
+		Vertex2D::IndexType BuildCircles(const BufferCreatorFunc& bufferCreator, const Circle* circles, const ColorF* colors, const size_t count, const Float4& color, const float scale, size_t& builtCount)
+		{
+			builtCount = 0;
+
+			// 1 回のバッファ要求に収まる個数を求める
+			size_t vertexSize = 0, indexSize = 0;
+
+			for (; builtCount < count; ++builtCount)
+			{
+				const Vertex2D::IndexType quality = detail::CalculateCircleQuality(Abs(static_cast<float>(circles[builtCount].r)) * scale);
+
+				if (((MaxBulkQuadCount * 4) < (vertexSize + quality + 1))
+					|| ((MaxBulkQuadCount * 6) < (indexSize + quality * 3)))
+				{
+					break;
+				}
+
+				vertexSize += (quality + 1);
+				indexSize += (quality * 3);
+			}
+
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(static_cast<Vertex2D::IndexType>(vertexSize), static_cast<Vertex2D::IndexType>(indexSize));
+
+			if (not pVertex)
+			{
+				builtCount = 0;
+				return 0;
+			}
+
+			for (size_t n = 0; n < builtCount; ++n)
+			{
+				const float r = static_cast<float>(circles[n].r);
+				const Vertex2D::IndexType quality = detail::CalculateCircleQuality(Abs(r) * scale);
+				const float centerX = static_cast<float>(circles[n].x);
+				const float centerY = static_cast<float>(circles[n].y);
+				const Float4 circleColor = (colors ? colors[n].toFloat4() : color);
+
+				pVertex[0].set(centerX, centerY, circleColor);
+
+				if (quality <= detail::MaxSinCosTableQuality)
+				{
+					const Float2* pCS = detail::GetSinCosTableStartPtr(quality);
+
+					for (Vertex2D::IndexType i = 1; i <= quality; ++i)
+					{
+						pVertex[i].set((r * pCS->x + centerX), (r * pCS->y + centerY), circleColor);
+						++pCS;
+					}
+				}
+				else
+				{
+					const float radDelta = (Math::TwoPiF / quality);
+
+					for (Vertex2D::IndexType i = 0; i < quality; ++i)
+					{
+						const auto [s, c] = FastMath::SinCos(radDelta * i);
+						pVertex[i + 1].set((centerX + r * c), (centerY - r * s), circleColor);
+					}
+				}
+
+				for (Vertex2D::IndexType i = 0; i < (quality - 1); ++i)
+				{
+					*pIndex++ = indexOffset + (i + 1);
+					*pIndex++ = indexOffset;
+					*pIndex++ = indexOffset + (i + 2);
+				}
+
+				*pIndex++ = (indexOffset + quality);
+				*pIndex++ = indexOffset;
+				*pIndex++ = (indexOffset + 1);
+
+				pVertex += (quality + 1);
+				indexOffset += (quality + 1);
+			}
+
+			return static_cast<Vertex2D::IndexType>(indexSize);
+		}
+
+		Vertex2D::IndexType BuildTexturedQuads(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Mat3x2* transforms, const ColorF* colors, const size_t count, const Float4& color)
+		{
+			assert(count <= MaxBulkQuadCount);
+
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(count * 4);
+			const Vertex2D::IndexType indexSize = static_cast<Vertex2D::IndexType>(count * 6);
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			// 変換前の左端・右端の x 座標と、(上端, 上端, 下端, 下端) の y 座標
+			const __m128 xLeft = _mm_set1_ps(rect.left);
+			const __m128 xRight = _mm_set1_ps(rect.right);
+			const __m128 yTopBottom = _mm_setr_ps(rect.top, rect.top, rect.bottom, rect.bottom);
+			const __m128 uvLeftTop = _mm_setr_ps(uv.left, uv.top, 0.0f, 0.0f);
+			const __m128 uvRightTop = _mm_setr_ps(uv.right, uv.top, 0.0f, 0.0f);
+			const __m128 uvLeftBottom = _mm_setr_ps(uv.left, uv.bottom, 0.0f, 0.0f);
+			const __m128 uvRightBottom = _mm_setr_ps(uv.right, uv.bottom, 0.0f, 0.0f);
+			__m128 col = _mm_loadu_ps(&color.x);
+
+			for (size_t n = 0; n < count; ++n)
+			{
+				const Mat3x2& mat = transforms[n];
+				const __m128 m0 = _mm_setr_ps(mat._11, mat._12, mat._11, mat._12);
+				const __m128 m1 = _mm_setr_ps(mat._21, mat._22, mat._21, mat._22);
+				const __m128 t = _mm_setr_ps(mat._31, mat._32, mat._31, mat._32);
+				const __m128 yTerm = _mm_add_ps(_mm_mul_ps(yTopBottom, m1), t);
+
+				// (左上, 左下) と (右上, 右下) の 2 頂点ずつ変換する
+				const __m128 left = _mm_add_ps(_mm_mul_ps(xLeft, m0), yTerm);
+				const __m128 right = _mm_add_ps(_mm_mul_ps(xRight, m0), yTerm);
+
+				if (colors)
+				{
+					col = detail::ToFloat4(colors[n]);
+				}
+
+				float* const p = &pVertex->pos.x;
+				_mm_storeu_ps((p + 0), _mm_movelh_ps(left, uvLeftTop));
+				_mm_storeu_ps((p + 4), col);
+				_mm_storeu_ps((p + 8), _mm_movelh_ps(right, uvRightTop));
+				_mm_storeu_ps((p + 12), col);
+				_mm_storeu_ps((p + 16), _mm_movelh_ps(_mm_movehl_ps(left, left), uvLeftBottom));
+				_mm_storeu_ps((p + 20), col);
+				_mm_storeu_ps((p + 24), _mm_movelh_ps(_mm_movehl_ps(right, right), uvRightBottom));
+				_mm_storeu_ps((p + 28), col);
+				pVertex += 4;
+			}
+
+			detail::WriteQuadIndices(pIndex, indexOffset, count);
+
+			return indexSize;
+		}
 	}
 }
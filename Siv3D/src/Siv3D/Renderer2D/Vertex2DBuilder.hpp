@@ -10,23 +10,64 @@
 //-----------------------------------------------
 
 # pragma once
+# include <memory>
+# include <type_traits>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Vertex2D.hpp>
 # include <Siv3D/FloatRect.hpp>
 # include <Siv3D/FloatQuad.hpp>
 # include <Siv3D/TriangleIndex.hpp>
 # include <Siv3D/ColorHSV.hpp>
+# include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/Optional.hpp>
 # include <Siv3D/LineStyle.hpp>
 # include <Siv3D/YesNo.hpp>
 # include <Siv3D/PredefinedYesNo.hpp>
 # include <Siv3D/Particle2D.hpp>
 # include <Siv3D/ParticleSystem2DParameters.hpp>
+# include <Siv3D/ParticleSystem2D/ParticleBuffer2D.hpp>
 # include "Vertex2DBufferPointer.hpp"
 
 namespace s3d
 {
-	using BufferCreatorFunc = std::function<Vertex2DBufferPointer(Vertex2D::IndexType, Vertex2D::IndexType)>;
+	/// @brief 頂点バッファ・インデックスバッファの領域を確保する関数オブジェクトへの、所有権を持たない参照
+	/// @remark 関数ポインタ 1 回の間接呼び出しで済むため、`std::function` よりも軽量です。参照先の関数オブジェクトは、この参照よりも長く存在する必要があります。
+	class BufferCreatorFunc
+	{
+	public:
+
+		BufferCreatorFunc() = default;
+
+		template <class Fty, std::enable_if_t<(not std::is_same_v<std::decay_t<Fty>, BufferCreatorFunc>) && std::is_invocable_r_v<Vertex2DBufferPointer, const Fty&, Vertex2D::IndexType, Vertex2D::IndexType>>* = nullptr>
+		BufferCreatorFunc(const Fty& f) noexcept
+			: m_object{ std::addressof(f) }
+			, m_function{ [](const void* object, Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize) -> Vertex2DBufferPointer
+				{
+					return (*static_cast<const Fty*>(object))(vertexSize, indexSize);
+				} } {}
+
+		template <class Fty, std::enable_if_t<(not std::is_same_v<std::decay_t<Fty>, BufferCreatorFunc>) && (not std::is_lvalue_reference_v<Fty>)>* = nullptr>
+		BufferCreatorFunc(Fty&&) = delete;
+
+		[[nodiscard]]
+		Vertex2DBufferPointer operator ()(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize) const
+		{
+			return m_function(m_object, vertexSize, indexSize);
+		}
+
+	private:
+
+		using FunctionType = Vertex2DBufferPointer(*)(const void*, Vertex2D::IndexType, Vertex2D::IndexType);
+
+		const void* m_object = nullptr;
+
+		FunctionType m_function = nullptr;
+	};
+
+	namespace detail
+	{
+		inline constexpr Vertex2D::IndexType RectIndexTable[6] = { 0, 1, 2, 2, 1, 3 };
+	}
 
 	namespace Vertex2DBuilder
 	{
@@ -48,17 +89,21 @@ namespace s3d
 		[[nodiscard]]
 		Vertex2D::IndexType BuildRoundDotLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, bool hasAlignedDot);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4& color);
+		Vertex2D::IndexType BuildTriangle(const BufferCreator& bufferCreator, const Float2(&points)[3], const Float4& color);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3]);
+		Vertex2D::IndexType BuildTriangle(const BufferCreator& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3]);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4& color);
+		Vertex2D::IndexType BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4& color);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
+		Vertex2D::IndexType BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildRectFrame(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor);
@@ -93,11 +138,13 @@ namespace s3d
 		[[nodiscard]]
 		Vertex2D::IndexType BuildEllipseFrame(const BufferCreatorFunc& bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4 color);
+		Vertex2D::IndexType BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4 color);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
+		Vertex2D::IndexType BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale);
@@ -138,17 +185,20 @@ namespace s3d
 		[[nodiscard]]
 		Vertex2D::IndexType BuildPolygonFrame(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Float2* points, size_t size, float thickness, const Float4& color, float scale);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
+		Vertex2D::IndexType BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
+		Vertex2D::IndexType BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildTexturedCircle(const BufferCreatorFunc& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, float scale);
 
+		template <class BufferCreator>
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
+		Vertex2D::IndexType BuildTexturedQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
 
 		[[nodiscard]]
 		Vertex2D::IndexType BuildTexturedRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const FloatRect& uvRect, const Float4& color, float scale);
@@ -166,7 +216,244 @@ namespace s3d
 		Vertex2D::IndexType BuildRoundRectShadow(const BufferCreatorFunc& bufferCreator, const RoundRect& roundRect, float blur, const Float4& color, float scale, bool fill);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Array<Particle2D>& particles,
+		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const ParticleBuffer2D& particles,
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc);
+
+		/// @brief 一括描画で 1 回のバッファ要求にまとめる長方形の最大個数
+		/// @remark インデックス数が `Vertex2D::IndexType` に収まるようにします。
+		inline constexpr size_t MaxBulkQuadCount = 8192;
+
+		/// @brief 複数の長方形の頂点を一度に生成します。
+		/// @param colors 各長方形の色。nullptr の場合はすべて `color` を使います。
+		/// @remark count は `MaxBulkQuadCount` 以下である必要があります。
+		[[nodiscard]]
+		Vertex2D::IndexType BuildRects(const BufferCreatorFunc& bufferCreator, const RectF* rects, const ColorF* colors, size_t count, const Float4& color);
+
+		/// @brief 複数の円の頂点を、1 回のバッファ要求に収まる個数だけ生成します。
+		/// @param colors 各円の色。nullptr の場合はすべて `color` を使います。
+		/// @param builtCount 頂点を生成した円の個数
+		[[nodiscard]]
+		Vertex2D::IndexType BuildCircles(const BufferCreatorFunc& bufferCreator, const Circle* circles, const ColorF* colors, size_t count, const Float4& color, float scale, size_t& builtCount);
+
+		/// @brief 同じテクスチャ領域を、それぞれの座標変換を適用した複数の四角形として一度に生成します。
+		/// @param colors 各四角形の色。nullptr の場合はすべて `color` を使います。
+		/// @remark count は `MaxBulkQuadCount` 以下である必要があります。
+		[[nodiscard]]
+		Vertex2D::IndexType BuildTexturedQuads(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Mat3x2* transforms, const ColorF* colors, size_t count, const Float4& color);
+	}
+
+	namespace Vertex2DBuilder
+	{
+		template <class BufferCreator>
+		Vertex2D::IndexType BuildTriangle(const BufferCreator& bufferCreator, const Float2(&points)[3], const Float4& color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(points[0], color);
+			pVertex[1].set(points[1], color);
+			pVertex[2].set(points[2], color);
+
+			pIndex[0] = indexOffset;
+			pIndex[1] = (indexOffset + 1);
+			pIndex[2] = (indexOffset + 2);
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		Vertex2D::IndexType BuildTriangle(const BufferCreator& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3])
+		{
+			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(points[0], colors[0]);
+			pVertex[1].set(points[1], colors[1]);
+			pVertex[2].set(points[2], colors[2]);
+
+			pIndex[0] = indexOffset;
+			pIndex[1] = (indexOffset + 1);
+			pIndex[2] = (indexOffset + 2);
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		Vertex2D::IndexType BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4& color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(rect.left, rect.top, color);
+			pVertex[1].set(rect.right, rect.top, color);
+			pVertex[2].set(rect.left, rect.bottom, color);
+			pVertex[3].set(rect.right, rect.bottom, color);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		Vertex2D::IndexType BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(rect.left, rect.top, colors[0]);
+			pVertex[1].set(rect.right, rect.top, colors[1]);
+			pVertex[2].set(rect.left, rect.bottom, colors[3]);
+			pVertex[3].set(rect.right, rect.bottom, colors[2]);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		Vertex2D::IndexType BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4 color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(quad.p[0], color);
+			pVertex[1].set(quad.p[1], color);
+			pVertex[2].set(quad.p[3], color);
+			pVertex[3].set(quad.p[2], color);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		Vertex2D::IndexType BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(quad.p[0], colors[0]);
+			pVertex[1].set(quad.p[1], colors[1]);
+			pVertex[2].set(quad.p[3], colors[3]);
+			pVertex[3].set(quad.p[2], colors[2]);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		Vertex2D::IndexType BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(rect.left, rect.top, uv.left, uv.top, color);
+			pVertex[1].set(rect.right, rect.top, uv.right, uv.top, color);
+			pVertex[2].set(rect.left, rect.bottom, uv.left, uv.bottom, color);
+			pVertex[3].set(rect.right, rect.bottom, uv.right, uv.bottom, color);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		Vertex2D::IndexType BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(rect.left, rect.top, uv.left, uv.top, colors[0]);
+			pVertex[1].set(rect.right, rect.top, uv.right, uv.top, colors[1]);
+			pVertex[2].set(rect.left, rect.bottom, uv.left, uv.bottom, colors[3]);
+			pVertex[3].set(rect.right, rect.bottom, uv.right, uv.bottom, colors[2]);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
+
+		template <class BufferCreator>
+		Vertex2D::IndexType BuildTexturedQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
+		{
+			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			pVertex[0].set(quad.p[0], uv.left, uv.top, color);
+			pVertex[1].set(quad.p[1], uv.right, uv.top, color);
+			pVertex[2].set(quad.p[3], uv.left, uv.bottom, color);
+			pVertex[3].set(quad.p[2], uv.right, uv.bottom, color);
+
+			for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+			{
+				*pIndex++ = (indexOffset + detail::RectIndexTable[i]);
+			}
+
+			return indexSize;
+		}
 	}
 }
@@ -15,6 +15,7 @@
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/Logger.hpp>
+# include <Siv3D/CacheDirectory/CacheDirectory.hpp>
 # include "angelscript/scriptarray.h"
 # include "angelscript/scriptgrid.h"
 # include "angelscript/scriptstdstring.h"
@@ -50,7 +51,11 @@ namespace s3d
 		}
 	}
 
-	CScript::CScript() {}
+	CScript::CScript()
+	{
+		// 他のユーザーから書き換えられないよう、ユーザーごとのキャッシュディレクトリに保存する
+		m_bytecodeCache.setDirectory(CacheDirectory::Engine() + U"script/");
+	}
 
 	CScript::~CScript()
 	{
@@ -411,4 +416,9 @@ namespace s3d
 
 		return m_engine;
 	}
+
+	ScriptBytecodeCache& CScript::getBytecodeCache()
+	{
+		return m_bytecodeCache;
+	}
 }
@@ -59,6 +59,8 @@ namespace s3d
 
 		AngelScript::asIScriptEngine* getEngine() override;
 
+		ScriptBytecodeCache& getBytecodeCache() override;
+
 	private:
 
 		AngelScript::asIScriptEngine* m_engine = nullptr;
@@ -68,5 +70,7 @@ namespace s3d
 		bool m_initialized = false;
 
 		Array<String> m_messages;
+
+		ScriptBytecodeCache m_bytecodeCache;
 	};
 }
@@ -14,6 +14,7 @@
 # include <Siv3D/Array.hpp>
 # include <Siv3D/String.hpp>
 # include <Siv3D/Script.hpp>
+# include "ScriptBytecodeCache.hpp"
 
 namespace s3d
 {
@@ -58,5 +59,7 @@ namespace s3d
 		virtual const std::function<bool()>& getSystemUpdateCallback(uint64 scriptID) = 0;
 
 		virtual AngelScript::asIScriptEngine* getEngine() = 0;
+
+		virtual ScriptBytecodeCache& getBytecodeCache() = 0;
 	};
 }
@@ -0,0 +1,529 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Blob.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Hash.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include "ScriptBytecodeCache.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief キャッシュファイルの先頭の識別子
+		constexpr char BytecodeCacheMagic[8] = { 'S', '3', 'D', 'A', 'S', 'B', 'C', '\0' };
+
+		/// @brief キャッシュファイルの形式のバージョン。形式を変更したら増やす
+		constexpr uint32 BytecodeCacheFormatVersion = 1;
+
+		constexpr StringView BytecodeCacheExtension = U"asbc";
+
+		[[nodiscard]]
+		inline constexpr uint64 MixHash(const uint64 seed, const uint64 value) noexcept
+		{
+			return (seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+		}
+
+		[[nodiscard]]
+		inline uint64 HashString(const uint64 seed, const char* s) noexcept
+		{
+			if (s == nullptr)
+			{
+				return MixHash(seed, 0);
+			}
+
+			return MixHash(seed, Hash::XXHash3(s, std::strlen(s)));
+		}
+
+		[[nodiscard]]
+		static Optional<uint64> HashFile(const FilePathView path)
+		{
+			const Blob blob{ path };
+
+			if ((not blob) && (not FileSystem::IsFile(path)))
+			{
+				return none;
+			}
+
+			return Hash::XXHash3(blob.data(), blob.size());
+		}
+
+		[[nodiscard]]
+		static uint64 HashSource(const ScriptBytecodeCache::Source& source)
+		{
+			if (source.path)
+			{
+				return HashFile(source.path).value_or(0);
+			}
+
+			return Hash::XXHash3(source.code.data(), source.code.size());
+		}
+
+		/// @brief メモリ上のバイト列を読み書きする asIBinaryStream
+		class BytecodeStream : public AngelScript::asIBinaryStream
+		{
+		public:
+
+			BytecodeStream() = default;
+
+			BytecodeStream(const Byte* data, const size_t size)
+				: m_readData{ data }
+				, m_readSize{ size } {}
+
+			int Read(void* ptr, const AngelScript::asUINT size) override
+			{
+				if ((m_readSize - m_readPos) < size)
+				{
+					return -1;
+				}
+
+				std::memcpy(ptr, (m_readData + m_readPos), size);
+				m_readPos += size;
+				return 0;
+			}
+
+			int Write(const void* ptr, const AngelScript::asUINT size) override
+			{
+				m_writeData.append(ptr, size);
+				return 0;
+			}
+
+			[[nodiscard]]
+			const Blob& getWrittenData() const noexcept
+			{
+				return m_writeData;
+			}
+
+		private:
+
+			const Byte* m_readData = nullptr;
+
+			size_t m_readSize = 0;
+
+			size_t m_readPos = 0;
+
+			Blob m_writeData;
+		};
+
+		/// @brief キャッシュファイルを先頭から読むためのカーソル
+		class CacheReader
+		{
+		public:
+
+			explicit CacheReader(const Blob& blob)
+				: m_data{ blob.data() }
+				, m_size{ blob.size() } {}
+
+			template <class Type>
+			[[nodiscard]]
+			bool read(Type& value)
+			{
+				static_assert(std::is_trivially_copyable_v<Type>);
+
+				if ((m_size - m_pos) < sizeof(Type))
+				{
+					return false;
+				}
+
+				std::memcpy(&value, (m_data + m_pos), sizeof(Type));
+				m_pos += sizeof(Type);
+				return true;
+			}
+
+			[[nodiscard]]
+			bool read(std::string& value)
+			{
+				uint32 length = 0;
+
+				if ((not read(length))
+					|| ((m_size - m_pos) < length))
+				{
+					return false;
+				}
+
+				value.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+				m_pos += length;
+				return true;
+			}
+
+			[[nodiscard]]
+			const Byte* current() const noexcept
+			{
+				return (m_data + m_pos);
+			}
+
+			[[nodiscard]]
+			size_t remaining() const noexcept
+			{
+				return (m_size - m_pos);
+			}
+
+		private:
+
+			const Byte* m_data = nullptr;
+
+			size_t m_size = 0;
+
+			size_t m_pos = 0;
+		};
+
+		static void WriteString(Blob& blob, const std::string& value)
+		{
+			const uint32 length = static_cast<uint32>(value.size());
+			blob.append(&length, sizeof(length));
+			blob.append(value.data(), value.size());
+		}
+
+		template <class Type>
+		static void WriteValue(Blob& blob, const Type& value)
+		{
+			static_assert(std::is_trivially_copyable_v<Type>);
+			blob.append(&value, sizeof(Type));
+		}
+
+		[[nodiscard]]
+		static uint64 HashFunction(const uint64 seed, const AngelScript::asIScriptFunction* function)
+		{
+			if (function == nullptr)
+			{
+				return MixHash(seed, 0);
+			}
+
+			return HashString(seed, function->GetDeclaration(true, true, false));
+		}
+
+		[[nodiscard]]
+		static uint64 HashTypeInfo(uint64 seed, const AngelScript::asITypeInfo* type)
+		{
+			seed = HashString(seed, type->GetNamespace());
+			seed = HashString(seed, type->GetName());
+			seed = MixHash(seed, type->GetFlags());
+			seed = MixHash(seed, type->GetSize());
+
+			for (AngelScript::asUINT i = 0; i < type->GetFactoryCount(); ++i)
+			{
+				seed = HashFunction(seed, type->GetFactoryByIndex(i));
+			}
+
+			for (AngelScript::asUINT i = 0; i < type->GetBehaviourCount(); ++i)
+			{
+				AngelScript::asEBehaviours behaviour{};
+				const AngelScript::asIScriptFunction* function = type->GetBehaviourByIndex(i, &behaviour);
+				seed = MixHash(seed, static_cast<uint64>(behaviour));
+				seed = HashFunction(seed, function);
+			}
+
+			for (AngelScript::asUINT i = 0; i < type->GetMethodCount(); ++i)
+			{
+				seed = HashFunction(seed, type->GetMethodByIndex(i, false));
+			}
+
+			for (AngelScript::asUINT i = 0; i < type->GetPropertyCount(); ++i)
+			{
+				int32 offset = 0;
+				type->GetProperty(i, nullptr, nullptr, nullptr, nullptr, &offset);
+				seed = HashString(seed, type->GetPropertyDeclaration(i, true));
+				seed = MixHash(seed, static_cast<uint64>(offset));
+			}
+
+			for (AngelScript::asUINT i = 0; i < type->GetEnumValueCount(); ++i)
+			{
+				int32 value = 0;
+				seed = HashString(seed, type->GetEnumValueByIndex(i, &value));
+				seed = MixHash(seed, static_cast<uint64>(value));
+			}
+
+			if (const AngelScript::asIScriptFunction* signature = type->GetFuncdefSignature())
+			{
+				seed = HashFunction(seed, signature);
+			}
+
+			return seed;
+		}
+	}
+
+	AngelScript::asIScriptModule* ScriptBytecodeCache::load(AngelScript::asIScriptEngine* const engine, const char* const moduleName, const Source& source, const ScriptCompileOption compileOption, Array<FilePath>& includedFiles)
+	{
+		const FilePath cachePath = getCachePath(source, compileOption);
+
+		if (not FileSystem::IsFile(cachePath))
+		{
+			return nullptr;
+		}
+
+		const Blob blob{ cachePath };
+		detail::CacheReader reader{ blob };
+
+		// ヘッダが一致するかを確認する
+		{
+			char magic[sizeof(detail::BytecodeCacheMagic)]{};
+			uint32 formatVersion = 0;
+			uint64 engineFingerprint = 0;
+			uint32 option = 0;
+			uint64 sourceHash = 0;
+
+			if ((not reader.read(magic))
+				|| (std::memcmp(magic, detail::BytecodeCacheMagic, sizeof(magic)) != 0)
+				|| (not reader.read(formatVersion))
+				|| (formatVersion != detail::BytecodeCacheFormatVersion)
+				|| (not reader.read(engineFingerprint))
+				|| (engineFingerprint != getEngineFingerprint(engine))
+				|| (not reader.read(option))
+				|| (option != FromEnum(compileOption))
+				|| (not reader.read(sourceHash))
+				|| (sourceHash != detail::HashSource(source)))
+			{
+				LOG_TRACE(U"ScriptBytecodeCache: `{}` is out of date"_fmt(cachePath));
+				return nullptr;
+			}
+		}
+
+		// インクルードされたファイルが変更されていないかを確認する
+		Array<FilePath> cachedIncludedFiles;
+		{
+			uint32 includedFileCount = 0;
+
+			if (not reader.read(includedFileCount))
+			{
+				return nullptr;
+			}
+
+			for (uint32 i = 0; i < includedFileCount; ++i)
+			{
+				std::string path;
+				uint64 fileHash = 0;
+
+				if ((not reader.read(path))
+					|| (not reader.read(fileHash)))
+				{
+					return nullptr;
+				}
+
+				FilePath includedFile = Unicode::FromUTF8(path);
+
+				if (detail::HashFile(includedFile) != fileHash)
+				{
+					LOG_TRACE(U"ScriptBytecodeCache: `{}` is out of date (`{}` has been modified)"_fmt(cachePath, includedFile));
+					return nullptr;
+				}
+
+				cachedIncludedFiles << std::move(includedFile);
+			}
+		}
+
+		uint64 bytecodeSize = 0;
+
+		if ((not reader.read(bytecodeSize))
+			|| (reader.remaining() < bytecodeSize))
+		{
+			return nullptr;
+		}
+
+		AngelScript::asIScriptModule* module = engine->GetModule(moduleName, AngelScript::asGM_ALWAYS_CREATE);
+
+		if (module == nullptr)
+		{
+			return nullptr;
+		}
+
+		detail::BytecodeStream stream{ reader.current(), static_cast<size_t>(bytecodeSize) };
+
+		if (module->LoadByteCode(&stream) < 0)
+		{
+			LOG_FAIL(U"❌ ScriptBytecodeCache: Failed to load bytecode from `{}`"_fmt(cachePath));
+			module->Discard();
+			return nullptr;
+		}
+
+		includedFiles = std::move(cachedIncludedFiles);
+
+		++m_hitCount;
+
+		LOG_TRACE(U"ScriptBytecodeCache: Loaded `{}`"_fmt(cachePath));
+
+		return module;
+	}
+
+	void ScriptBytecodeCache::save(const AngelScript::asIScriptModule* const module, const Source& source, const ScriptCompileOption compileOption, const Array<FilePath>& includedFiles)
+	{
+		detail::BytecodeStream stream;
+
+		if (module->SaveByteCode(&stream) < 0)
+		{
+			LOG_FAIL(U"❌ ScriptBytecodeCache: Failed to save bytecode");
+			return;
+		}
+
+		Blob blob;
+		blob.append(detail::BytecodeCacheMagic, sizeof(detail::BytecodeCacheMagic));
+		detail::WriteValue(blob, detail::BytecodeCacheFormatVersion);
+		detail::WriteValue(blob, getEngineFingerprint(module->GetEngine()));
+		detail::WriteValue(blob, FromEnum(compileOption));
+		detail::WriteValue(blob, detail::HashSource(source));
+		detail::WriteValue(blob, static_cast<uint32>(includedFiles.size()));
+
+		for (const auto& includedFile : includedFiles)
+		{
+			detail::WriteString(blob, includedFile.toUTF8());
+			detail::WriteValue(blob, detail::HashFile(includedFile).value_or(0));
+		}
+
+		const Blob& bytecode = stream.getWrittenData();
+		detail::WriteValue(blob, static_cast<uint64>(bytecode.size()));
+		blob.append(bytecode.data(), bytecode.size());
+
+		const FilePath cachePath = getCachePath(source, compileOption);
+
+		if (not FileSystem::CreateDirectories(m_directory))
+		{
+			LOG_FAIL(U"❌ ScriptBytecodeCache: Failed to create `{}`"_fmt(m_directory));
+			return;
+		}
+
+		// 書き込み途中のファイルが読まれないよう、一時ファイルに書いてから置き換える
+		const FilePath temporaryPath = (cachePath + U".tmp");
+
+		if ((not blob.save(temporaryPath))
+			|| ((FileSystem::Exists(cachePath)) && (not FileSystem::Remove(cachePath)))
+			|| (not FileSystem::Rename(temporaryPath, cachePath)))
+		{
+			LOG_FAIL(U"❌ ScriptBytecodeCache: Failed to write `{}`"_fmt(cachePath));
+			FileSystem::Remove(temporaryPath);
+			return;
+		}
+
+		LOG_TRACE(U"ScriptBytecodeCache: Saved `{}` ({} bytes)"_fmt(cachePath, blob.size()));
+	}
+
+	void ScriptBytecodeCache::setDirectory(const FilePathView directory)
+	{
+		m_directory = FileSystem::FullPath(directory);
+
+		if (m_directory && (not m_directory.ends_with(U'/')))
+		{
+			m_directory.push_back(U'/');
+		}
+	}
+
+	const FilePath& ScriptBytecodeCache::getDirectory() const noexcept
+	{
+		return m_directory;
+	}
+
+	size_t ScriptBytecodeCache::getHitCount() const noexcept
+	{
+		return m_hitCount;
+	}
+
+	uint64 ScriptBytecodeCache::getEngineFingerprint(const AngelScript::asIScriptEngine* const engine)
+	{
+		const RegistrationCounts counts = GetRegistrationCounts(engine);
+
+		if ((m_engineFingerprint != 0) && (counts == m_counts))
+		{
+			return m_engineFingerprint;
+		}
+
+		uint64 seed = detail::HashString(0, ANGELSCRIPT_VERSION_STRING);
+		seed = detail::HashString(seed, AngelScript::asGetLibraryOptions());
+		seed = detail::MixHash(seed, sizeof(void*));
+
+		for (AngelScript::asUINT i = 0; i < engine->GetGlobalFunctionCount(); ++i)
+		{
+			seed = detail::HashFunction(seed, engine->GetGlobalFunctionByIndex(i));
+		}
+
+		for (AngelScript::asUINT i = 0; i < engine->GetGlobalPropertyCount(); ++i)
+		{
+			const char* name = nullptr;
+			const char* nameSpace = nullptr;
+			int32 typeID = 0;
+			bool isConst = false;
+			engine->GetGlobalPropertyByIndex(i, &name, &nameSpace, &typeID, &isConst);
+
+			seed = detail::HashString(seed, nameSpace);
+			seed = detail::HashString(seed, name);
+			seed = detail::HashString(seed, engine->GetTypeDeclaration(typeID, true));
+			seed = detail::MixHash(seed, isConst);
+		}
+
+		for (AngelScript::asUINT i = 0; i < engine->GetObjectTypeCount(); ++i)
+		{
+			seed = detail::HashTypeInfo(seed, engine->GetObjectTypeByIndex(i));
+		}
+
+		for (AngelScript::asUINT i = 0; i < engine->GetEnumCount(); ++i)
+		{
+			seed = detail::HashTypeInfo(seed, engine->GetEnumByIndex(i));
+		}
+
+		for (AngelScript::asUINT i = 0; i < engine->GetFuncdefCount(); ++i)
+		{
+			seed = detail::HashTypeInfo(seed, engine->GetFuncdefByIndex(i));
+		}
+
+		for (AngelScript::asUINT i = 0; i < engine->GetTypedefCount(); ++i)
+		{
+			const AngelScript::asITypeInfo* type = engine->GetTypedefByIndex(i);
+			seed = detail::HashString(seed, type->GetName());
+			seed = detail::MixHash(seed, static_cast<uint64>(type->GetTypedefTypeId()));
+		}
+
+		// 0 は未計算を表すため避ける
+		m_engineFingerprint = ((seed == 0) ? 1 : seed);
+		m_counts = counts;
+
+		return m_engineFingerprint;
+	}
+
+	FilePath ScriptBytecodeCache::getCachePath(const Source& source, const ScriptCompileOption compileOption) const
+	{
+		uint64 key = detail::MixHash(0, FromEnum(compileOption));
+
+		if (source.path)
+		{
+			const std::string path = source.path.toUTF8();
+			key = detail::MixHash(key, Hash::XXHash3(path.data(), path.size()));
+		}
+		else
+		{
+			key = detail::MixHash(key, Hash::XXHash3(source.code.data(), source.code.size()));
+		}
+
+		return U"{}{:016x}.{}"_fmt(m_directory, key, detail::BytecodeCacheExtension);
+	}
+
+	ScriptBytecodeCache::RegistrationCounts ScriptBytecodeCache::GetRegistrationCounts(const AngelScript::asIScriptEngine* const engine)
+	{
+		RegistrationCounts counts
+		{
+			.globalFunctions	= engine->GetGlobalFunctionCount(),
+			.globalProperties	= engine->GetGlobalPropertyCount(),
+			.objectTypes		= engine->GetObjectTypeCount(),
+			.enums				= engine->GetEnumCount(),
+			.funcdefs			= engine->GetFuncdefCount(),
+			.typedefs			= engine->GetTypedefCount(),
+		};
+
+		// 既存の型へのメソッドやプロパティの追加を検出する
+		for (AngelScript::asUINT i = 0; i < counts.objectTypes; ++i)
+		{
+			const AngelScript::asITypeInfo* type = engine->GetObjectTypeByIndex(i);
+			counts.objectMembers += (type->GetMethodCount() + type->GetPropertyCount() + type->GetBehaviourCount() + type->GetFactoryCount());
+		}
+
+		return counts;
+	}
+}
@@ -0,0 +1,108 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/ScriptCompileOption.hpp>
+# include <ThirdParty/angelscript/angelscript.h>
+
+namespace s3d
+{
+	/// @brief コンパイル済みのバイトコードをファイルに保存し、次回のロード時にソースからのコンパイルを省略するキャッシュ
+	/// @remark キャッシュは、ソース（インクルードされたファイルを含む）の内容のハッシュ、コンパイルオプション、エンジンに登録された型や関数の構成が一致する場合にのみ使われます。
+	class ScriptBytecodeCache
+	{
+	public:
+
+		/// @brief スクリプトのソース
+		struct Source
+		{
+			/// @brief スクリプトファイルのフルパス（コードからコンパイルする場合は空）
+			FilePathView path;
+
+			/// @brief スクリプトのコード（UTF-8）
+			std::string_view code;
+		};
+
+		/// @brief キャッシュからモジュールを復元します。
+		/// @param engine エンジン
+		/// @param moduleName 作成するモジュールの名前
+		/// @param source スクリプトのソース
+		/// @param compileOption コンパイルオプション
+		/// @param includedFiles インクルードされていたファイルの一覧を格納する配列
+		/// @return 復元したモジュール。キャッシュが無いか一致しない場合は nullptr
+		[[nodiscard]]
+		AngelScript::asIScriptModule* load(AngelScript::asIScriptEngine* engine, const char* moduleName, const Source& source, ScriptCompileOption compileOption, Array<FilePath>& includedFiles);
+
+		/// @brief コンパイルしたモジュールをキャッシュに保存します。
+		/// @param module 保存するモジュール
+		/// @param source スクリプトのソース
+		/// @param compileOption コンパイルオプション
+		/// @param includedFiles インクルードされたファイルの一覧
+		void save(const AngelScript::asIScriptModule* module, const Source& source, ScriptCompileOption compileOption, const Array<FilePath>& includedFiles);
+
+		void setDirectory(FilePathView directory);
+
+		[[nodiscard]]
+		const FilePath& getDirectory() const noexcept;
+
+		/// @brief キャッシュからモジュールを復元できた回数を返します。
+		/// @return キャッシュからモジュールを復元できた回数
+		[[nodiscard]]
+		size_t getHitCount() const noexcept;
+
+		/// @brief エンジンに登録された型や関数の構成のハッシュを返します。
+		/// @param engine エンジン
+		/// @return エンジンに登録された型や関数の構成のハッシュ
+		/// @remark 登録数が変わらない限り、前回の計算結果を返します。
+		[[nodiscard]]
+		uint64 getEngineFingerprint(const AngelScript::asIScriptEngine* engine);
+
+	private:
+
+		/// @brief フィンガープリントを計算し直す必要があるかを判定するための、登録数の合計
+		struct RegistrationCounts
+		{
+			uint32 globalFunctions = 0;
+
+			uint32 globalProperties = 0;
+
+			uint32 objectTypes = 0;
+
+			uint32 objectMembers = 0;
+
+			uint32 enums = 0;
+
+			uint32 funcdefs = 0;
+
+			uint32 typedefs = 0;
+
+			[[nodiscard]]
+			friend bool operator ==(const RegistrationCounts& lhs, const RegistrationCounts& rhs) noexcept = default;
+		};
+
+		FilePath m_directory;
+
+		RegistrationCounts m_counts;
+
+		uint64 m_engineFingerprint = 0;
+
+		size_t m_hitCount = 0;
+
+		[[nodiscard]]
+		FilePath getCachePath(const Source& source, ScriptCompileOption compileOption) const;
+
+		[[nodiscard]]
+		static RegistrationCounts GetRegistrationCounts(const AngelScript::asIScriptEngine* engine);
+	};
+}
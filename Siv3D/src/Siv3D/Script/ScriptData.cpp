@@ -50,44 +50,7 @@ namespace s3d
 	{
 		m_initialized = true;
 
-		const bool withLineCues = static_cast<bool>(m_compileOption & ScriptCompileOption::BuildWithLineCues);
-		m_engine->SetEngineProperty(AngelScript::asEP_BUILD_WITHOUT_LINE_CUES, (not withLineCues));
-
-		AngelScript::CScriptBuilder builder;
-		int32 r = 0;
-
-		if (builder.StartNewModule(m_engine, m_moduleName.c_str());
-			(r < 0))
-		{
-			LOG_FAIL(U"Unrecoverable error while starting a new module.");
-			return;
-		}
-
-		const std::string codeUTF8 = code.toUTF8();
-		std::vector<std::string> includedFiles;
-
-		if (r = builder.AddSectionFromMemory(includedFiles, "", codeUTF8.c_str(), static_cast<uint32>(codeUTF8.length()), 0);
-			(r < 0))
-		{
-			m_includedFiles.clear();
-			m_messages = SIV3D_ENGINE(Script)->retrieveMessages_internal();
-			return;
-		}
-
-		m_includedFiles = detail::ConvertIncludedFiles(includedFiles);
-
-		if (r = builder.BuildModule();
-			(r < 0))
-		{
-			m_messages = SIV3D_ENGINE(Script)->retrieveMessages_internal();
-			return;
-		}
-
-		m_module->module = m_engine->GetModule(m_moduleName.c_str());
-		m_module->context = m_engine->CreateContext();
-		m_module->withLineCues = withLineCues;
-
-		m_complieSucceeded = true;
+		m_complieSucceeded = build(code.toUTF8());
 	}
 
 	ScriptData::ScriptData(File, const FilePathView path, AngelScript::asIScriptEngine* const engine, const ScriptCompileOption compileOption)
@@ -104,44 +67,7 @@ namespace s3d
 
 		m_initialized = true;
 
-		const bool withLineCues = static_cast<bool>(m_compileOption & ScriptCompileOption::BuildWithLineCues);
-		m_engine->SetEngineProperty(AngelScript::asEP_BUILD_WITHOUT_LINE_CUES, (not withLineCues));
-
-		AngelScript::CScriptBuilder builder;
-		int32 r = 0;
-		
-		if (builder.StartNewModule(m_engine, m_moduleName.c_str()); 
-			(r < 0))
-		{
-			LOG_FAIL(U"Unrecoverable error while starting a new module.");
-			return;
-		}
-
-		std::vector<std::string> includedFiles;
-
-		if (r = builder.AddSectionFromFile(m_fullpath, includedFiles);
-			(r < 0))
-		{
-			m_includedFiles.clear();
-			m_messages = SIV3D_ENGINE(Script)->retrieveMessages_internal();
-			return;
-		}
-
-		m_includedFiles = detail::ConvertIncludedFiles(includedFiles);
-
-		if (r = builder.BuildModule(); 
-			(r < 0))
-		{
-			m_messages = SIV3D_ENGINE(Script)->retrieveMessages_internal();
-			return;
-		}
-
-		m_module->module = m_engine->GetModule(m_moduleName.c_str());
-		m_moduleName = UUIDValue::Generate().to_string();
-		m_module->context = m_engine->CreateContext();
-		m_module->withLineCues = withLineCues;
-
-		m_complieSucceeded = true;
+		m_complieSucceeded = build({});
 	}
 
 	bool ScriptData::isInitialized() const noexcept
@@ -168,46 +94,16 @@ namespace s3d
 
 		m_module = std::make_shared<ScriptModule>();
 		m_functions.clear();
-		m_moduleName.clear();
+		m_moduleName = UUIDValue::Generate().to_string();
 		m_messages.clear();
 		m_complieSucceeded = false;
 		m_compileOption = compileOption;
 
-		const bool withLineCues = static_cast<bool>(m_compileOption & ScriptCompileOption::BuildWithLineCues);
-		m_engine->SetEngineProperty(AngelScript::asEP_BUILD_WITHOUT_LINE_CUES, (not withLineCues));
-
-		AngelScript::CScriptBuilder builder;
-		int32 r = 0;
-
-		if (builder.StartNewModule(m_engine, m_moduleName.c_str());
-			(r < 0))
-		{
-			LOG_FAIL(U"Unrecoverable error while starting a new module.");
-			return false;
-		}
-
-		std::vector<std::string> includedFiles;
-
-		if (r = builder.AddSectionFromFile(m_fullpath, includedFiles);
-			(r < 0))
-		{
-			m_includedFiles.clear();
-			m_messages = SIV3D_ENGINE(Script)->retrieveMessages_internal();
-			return false;
-		}
-
-		m_includedFiles = detail::ConvertIncludedFiles(includedFiles);
-
-		if (r = builder.BuildModule();
-			(r < 0))
+		if (not build({}))
 		{
-			m_messages = SIV3D_ENGINE(Script)->retrieveMessages_internal();
 			return false;
 		}
 
-		m_module->module = m_engine->GetModule(m_moduleName.c_str());
-		m_module->context = m_engine->CreateContext();
-		m_module->withLineCues = withLineCues;
 		m_module->scriptID = scriptID;
 
 		m_complieSucceeded = true;
@@ -302,4 +198,72 @@ namespace s3d
 	{
 		return m_systemUpdateCallback;
 	}
+
+	bool ScriptData::build(const std::string& codeUTF8)
+	{
+		const bool withLineCues = static_cast<bool>(m_compileOption & ScriptCompileOption::BuildWithLineCues);
+		m_engine->SetEngineProperty(AngelScript::asEP_BUILD_WITHOUT_LINE_CUES, (not withLineCues));
+
+		const bool useBytecodeCache = static_cast<bool>(m_compileOption & ScriptCompileOption::UseBytecodeCache);
+		const ScriptBytecodeCache::Source source{ m_fullpath, codeUTF8 };
+
+		if (useBytecodeCache)
+		{
+			if (AngelScript::asIScriptModule* module = SIV3D_ENGINE(Script)->getBytecodeCache().load(m_engine, m_moduleName.c_str(), source, m_compileOption, m_includedFiles))
+			{
+				m_module->module = module;
+				m_module->context = m_engine->CreateContext();
+				m_module->withLineCues = withLineCues;
+				return true;
+			}
+		}
+
+		AngelScript::CScriptBuilder builder;
+		int32 r = 0;
+
+		if (r = builder.StartNewModule(m_engine, m_moduleName.c_str());
+			(r < 0))
+		{
+			LOG_FAIL(U"Unrecoverable error while starting a new module.");
+			return false;
+		}
+
+		std::vector<std::string> includedFiles;
+
+		if (m_fullpath)
+		{
+			r = builder.AddSectionFromFile(m_fullpath, includedFiles);
+		}
+		else
+		{
+			r = builder.AddSectionFromMemory(includedFiles, "", codeUTF8.c_str(), static_cast<uint32>(codeUTF8.length()), 0);
+		}
+
+		if (r < 0)
+		{
+			m_includedFiles.clear();
+			m_messages = SIV3D_ENGINE(Script)->retrieveMessages_internal();
+			return false;
+		}
+
+		m_includedFiles = detail::ConvertIncludedFiles(includedFiles);
+
+		if (r = builder.BuildModule();
+			(r < 0))
+		{
+			m_messages = SIV3D_ENGINE(Script)->retrieveMessages_internal();
+			return false;
+		}
+
+		m_module->module = m_engine->GetModule(m_moduleName.c_str());
+		m_module->context = m_engine->CreateContext();
+		m_module->withLineCues = withLineCues;
+
+		if (useBytecodeCache)
+		{
+			SIV3D_ENGINE(Script)->getBytecodeCache().save(m_module->module, source, m_compileOption, m_includedFiles);
+		}
+
+		return true;
+	}
 }
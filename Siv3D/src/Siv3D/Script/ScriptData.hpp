@@ -89,5 +89,11 @@ namespace s3d
 		bool m_complieSucceeded = false;
 
 		bool m_initialized = false;
+
+		/// @brief モジュールをビルドします。`m_fullpath` が空の場合は `codeUTF8` から、それ以外の場合はファイルからビルドします。
+		/// @param codeUTF8 スクリプトのコード
+		/// @return ビルドに成功した場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool build(const std::string& codeUTF8);
 	};
 }
@@ -114,6 +114,16 @@ namespace s3d
 		return SIV3D_ENGINE(Script)->getEngine();
 	}
 
+	void Script::SetBytecodeCacheDirectory(const FilePathView directory)
+	{
+		SIV3D_ENGINE(Script)->getBytecodeCache().setDirectory(directory);
+	}
+
+	const FilePath& Script::GetBytecodeCacheDirectory()
+	{
+		return SIV3D_ENGINE(Script)->getBytecodeCache().getDirectory();
+	}
+
 	const std::shared_ptr<ScriptModule>& Script::_getModule() const
 	{
 		return SIV3D_ENGINE(Script)->getModule(m_handle->id());
@@ -9,6 +9,7 @@
 //
 //-----------------------------------------------
 
+# include <future>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/SimpleHTTP.hpp>
 # include <Siv3D/BinaryWriter.hpp>
@@ -17,35 +18,57 @@
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/Network/INetwork.hpp>
+# include <Siv3D/Network/HTTPClient.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
-# define CURL_STATICLIB
-# if SIV3D_PLATFORM(WINDOWS) | SIV3D_PLATFORM(WEB)
-#	include <ThirdParty-prebuilt/curl/curl.h>
-# else
-#	include <curl/curl.h>
-# endif
-
 namespace s3d
 {
 	namespace detail
 	{
-		static size_t WriteCallback(const char* ptr, const size_t size, const size_t nmemb, IWriter* pWriter)
+		[[nodiscard]]
+		static HTTPClient::Request MakeRequest(const URLView url, const HashTable<String, String>& headers, IWriter& writer)
 		{
-			const size_t size_bytes = (size * nmemb);
+			HTTPClient::Request request;
+			request.url = Unicode::ToUTF8(url);
 
-			pWriter->write(ptr, size_bytes);
+			// ヘッダの追加
+			for (auto&& [key, value] : headers)
+			{
+				request.headers.push_back(key.toUTF8() + ": " + value.toUTF8());
+			}
 
-			return size_bytes;
+			request.writer = &writer;
+
+			return request;
 		}
 
-		static size_t HeaderCallback(const char* buffer, const size_t size, const size_t nitems, std::string* userData)
+		/// @brief エンジンの HTTPClient でリクエストを処理し、完了まで待ちます。
+		/// @remark 同期版も非同期版と同じ接続を再利用します。
+		[[nodiscard]]
+		static HTTPResponse Perform(HTTPClient::Request&& request)
 		{
-			const size_t size_bytes = (size * nitems);
+			auto promise = std::make_shared<std::promise<HTTPResponse>>();
+
+			std::future<HTTPResponse> future = promise->get_future();
+
+			request.onComplete = [promise](const HTTPAsyncStatus status, std::string&& responseHeaders)
+				{
+					if (status == HTTPAsyncStatus::Succeeded)
+					{
+						promise->set_value(HTTPResponse{ responseHeaders });
+					}
+					else
+					{
+						promise->set_value({});
+					}
+				};
+
+			// 完了を待ってブロックするので、非同期のリクエストの後ろに並ばせない
+			request.immediate = true;
 
-			userData->append(buffer, size_bytes);
+			SIV3D_ENGINE(Network)->getHTTPClient().submit(std::move(request));
 
-			return size_bytes;
+			return future.get();
 		}
 	}
 
@@ -116,49 +139,7 @@ namespace s3d
 				return{};
 			}
 
-			::CURL* curl = ::curl_easy_init();
-			{
-				if (not curl)
-				{
-					return{};
-				}
-			}
-
-			// ヘッダの追加
-			::curl_slist* header_slist = nullptr;
-			{
-				for (auto&& [key, value] : headers)
-				{
-					const std::string header = (key.toUTF8() + ": " + value.toUTF8());
-					header_slist = ::curl_slist_append(header_slist, header.c_str());
-				}
-			}
-
-			const std::string urlUTF8 = Unicode::ToUTF8(url);
-			::curl_easy_setopt(curl, ::CURLOPT_URL, urlUTF8.c_str());
-			::curl_easy_setopt(curl, ::CURLOPT_FOLLOWLOCATION, 1L);
-			::curl_easy_setopt(curl, ::CURLOPT_HTTPHEADER, header_slist);
-			::curl_easy_setopt(curl, ::CURLOPT_WRITEFUNCTION, detail::WriteCallback);
-			::curl_easy_setopt(curl, ::CURLOPT_WRITEDATA, &writer);
-
-			// レスポンスヘッダーの設定
-			std::string responseHeaders;
-			{
-				::curl_easy_setopt(curl, ::CURLOPT_HEADERFUNCTION, detail::HeaderCallback);
-				::curl_easy_setopt(curl, ::CURLOPT_HEADERDATA, &responseHeaders);
-			}
-
-			const ::CURLcode result = ::curl_easy_perform(curl);
-			::curl_easy_cleanup(curl);
-			::curl_slist_free_all(header_slist);
-
-			if (result != ::CURLE_OK)
-			{
-				LOG_FAIL(U"curl failed (CURLcode: {})"_fmt(FromEnum(result)));
-				return{};
-			}
-
-			return HTTPResponse{ responseHeaders };
+			return detail::Perform(detail::MakeRequest(url, headers, writer));
 		}
 
 		HTTPResponse Post(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const FilePathView filePath)
@@ -205,90 +186,60 @@ namespace s3d
 				return{};
 			}
 
-			::CURL* curl = ::curl_easy_init();
-			{
-				if (not curl)
-				{
-					return{};
-				}
-			}
-
-			// ヘッダの追加
-			::curl_slist* header_slist = nullptr;
-			{
-				for (auto&& [key, value] : headers)
-				{
-					const std::string header = (key.toUTF8() + ": " + value.toUTF8());
-					header_slist = ::curl_slist_append(header_slist, header.c_str());
-				}
-			}
+			HTTPClient::Request request = detail::MakeRequest(url, headers, writer);
+			request.isPost = true;
+			request.postData = src;
+			request.postSize = size;
 
-			const std::string urlUTF8 = Unicode::ToUTF8(url);
-			::curl_easy_setopt(curl, ::CURLOPT_URL, urlUTF8.c_str());
-			::curl_easy_setopt(curl, ::CURLOPT_FOLLOWLOCATION, 1L);
-			::curl_easy_setopt(curl, ::CURLOPT_HTTPHEADER, header_slist);
-			::curl_easy_setopt(curl, ::CURLOPT_POST, 1L);
-			::curl_easy_setopt(curl, ::CURLOPT_POSTFIELDS, const_cast<char*>(static_cast<const char*>(src)));
-			::curl_easy_setopt(curl, ::CURLOPT_POSTFIELDSIZE, static_cast<long>(size));
-			::curl_easy_setopt(curl, ::CURLOPT_WRITEFUNCTION, detail::WriteCallback);
-			::curl_easy_setopt(curl, ::CURLOPT_WRITEDATA, &writer);
-
-			// レスポンスヘッダーの設定
-			std::string responseHeaders;
-			{
-				::curl_easy_setopt(curl, ::CURLOPT_HEADERFUNCTION, detail::HeaderCallback);
-				::curl_easy_setopt(curl, ::CURLOPT_HEADERDATA, &responseHeaders);
-			}
-
-			const ::CURLcode result = ::curl_easy_perform(curl);
-			::curl_easy_cleanup(curl);
-			::curl_slist_free_all(header_slist);
-
-			if (result != ::CURLE_OK)
-			{
-				LOG_FAIL(U"curl failed (CURLcode: {})"_fmt(FromEnum(result)));
-				return{};
-			}
-
-			return HTTPResponse{ responseHeaders };
+			return detail::Perform(std::move(request));
 		}
 
-		AsyncHTTPTask SaveAsync(const URLView url, const FilePathView filePath)
+		AsyncHTTPTask SaveAsync(const URLView url, const FilePathView filePath, const int32 priority)
 		{
-			return GetAsync(url, {}, filePath);
+			return GetAsync(url, {}, filePath, priority);
 		}
 
-		AsyncHTTPTask LoadAsync(const URLView url)
+		AsyncHTTPTask LoadAsync(const URLView url, const int32 priority)
 		{
-			return GetAsync(url, {});
+			return GetAsync(url, {}, priority);
 		}
 
-		AsyncHTTPTask GetAsync(const URLView url, const HashTable<String, String>& headers, const FilePathView filePath)
+		AsyncHTTPTask GetAsync(const URLView url, const HashTable<String, String>& headers, const FilePathView filePath, const int32 priority)
 		{
 			SIV3D_ENGINE(Network)->init();
 
-			return AsyncHTTPTask{ url, headers, filePath };
+			return AsyncHTTPTask{ url, headers, filePath, priority };
 		}
 
-		AsyncHTTPTask GetAsync(const URLView url, const HashTable<String, String>& headers)
+		AsyncHTTPTask GetAsync(const URLView url, const HashTable<String, String>& headers, const int32 priority)
 		{
 			SIV3D_ENGINE(Network)->init();
 
-			return AsyncHTTPTask{ url, headers };
+			return AsyncHTTPTask{ url, headers, priority };
 		}
 
-		AsyncHTTPTask PostAsync(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const FilePathView filePath)
+		AsyncHTTPTask PostAsync(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const FilePathView filePath, const int32 priority)
 		{
 			SIV3D_ENGINE(Network)->init();
 
-			return AsyncHTTPTask{ url, headers, src, size, filePath };
+			return AsyncHTTPTask{ url, headers, src, size, filePath, priority };
 		}
 
-		AsyncHTTPTask PostAsync(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size)
+		AsyncHTTPTask PostAsync(const URLView url, const HashTable<String, String>& headers, const void* src, const size_t size, const int32 priority)
 		{
 			SIV3D_ENGINE(Network)->init();
 
-			return AsyncHTTPTask{ url, headers, src, size };
+			return AsyncHTTPTask{ url, headers, src, size, priority };
+		}
+
+		void SetMaxConcurrency(const size_t maxConcurrency)
+		{
+			SIV3D_ENGINE(Network)->getHTTPClient().setMaxConcurrency(maxConcurrency);
+		}
+
+		size_t GetMaxConcurrency()
+		{
+			return SIV3D_ENGINE(Network)->getHTTPClient().getMaxConcurrency();
 		}
 	}
 }
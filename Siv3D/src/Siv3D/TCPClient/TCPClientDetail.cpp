@@ -221,4 +221,24 @@ namespace s3d
 
 		return m_session->send(data, size);
 	}
+
+	bool TCPClient::TCPClientDetail::sendMessage(const void* data, const size_t size)
+	{
+		if (!m_session)
+		{
+			return false;
+		}
+
+		return m_session->sendMessage(data, size);
+	}
+
+	bool TCPClient::TCPClientDetail::tryReceiveMessage(Array<Byte>& message)
+	{
+		if (!m_session)
+		{
+			return false;
+		}
+
+		return m_session->readMessage(message);
+	}
 }
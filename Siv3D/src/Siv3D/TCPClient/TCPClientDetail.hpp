@@ -15,6 +15,7 @@
 # include <Siv3D/Byte.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Network/TCPBuffer.hpp>
 
 # define _WINSOCK_DEPRECATED_NO_WARNINGS
 # ifndef _WIN32_WINNT
@@ -40,29 +41,41 @@ namespace s3d
 
 			bool m_isActive = false;
 
-			asio::streambuf m_streamBuffer;
-
 			// 受信	
 			static constexpr size_t maxBufferSize = 32 * 1024 * 1024;
 
 			std::mutex m_mutexReceivedBuffer;
 
-			Array<Byte> m_receivedBuffer;
+			TCPReceiveBuffer m_receivedBuffer{ maxBufferSize };
 
 
 			// 送信
+			static constexpr size_t maxSendBufferCount = 16;
+
 			std::mutex m_mutexSendingBuffer;
 
-			Array<Array<Byte>> m_sendingBuffer;
+			TCPSendQueue m_sendingBuffer;
+
+			std::array<asio::const_buffer, maxSendBufferCount> m_sendingBufferSequence;
 
 			bool m_isSending = false;
 
 
+			// m_mutexSendingBuffer をロックした状態で呼ぶ
 			void send_internal()
 			{
+				std::array<TCPSendQueue::Region, maxSendBufferCount> regions;
+
+				const size_t count = m_sendingBuffer.gather(regions.data(), regions.size());
+
+				for (size_t i = 0; i < maxSendBufferCount; ++i)
+				{
+					m_sendingBufferSequence[i] = ((i < count) ? asio::const_buffer{ regions[i].data, regions[i].size } : asio::const_buffer{});
+				}
+
 				m_isSending = true;
 
-				asio::async_write(m_socket, asio::buffer(m_sendingBuffer.front().data(), m_sendingBuffer.front().size()),
+				asio::async_write(m_socket, m_sendingBufferSequence,
 					std::bind(&ClientSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
 			}
 
@@ -100,16 +113,19 @@ namespace s3d
 
 				m_socket.close();
 
-				if (!m_isSending)
 				{
 					std::lock_guard lock{ m_mutexSendingBuffer };
-					m_sendingBuffer.clear();
+
+					// 送信中のデータは onSend() で破棄する
+					if (!m_isSending)
+					{
+						m_sendingBuffer.clear();
+					}
 				}
 
 				{
 					std::lock_guard lock{ m_mutexReceivedBuffer };
 					m_receivedBuffer.clear();
-					m_streamBuffer.consume(m_streamBuffer.size());
 				}
 
 				if (m_isActive)
@@ -117,7 +133,6 @@ namespace s3d
 					LOG_TRACE(U"Session closed");
 				}
 
-				m_isSending = false;
 				m_isActive = false;
 			}
 
@@ -140,11 +155,30 @@ namespace s3d
 
 			void startReceive()
 			{
-				asio::async_read(m_socket, m_streamBuffer, asio::transfer_at_least(1),
+				std::pair<Byte*, size_t> buffer;
+				{
+					std::lock_guard lock{ m_mutexReceivedBuffer };
+
+					buffer = m_receivedBuffer.prepare();
+				}
+
+				if (buffer.first == nullptr)
+				{
+					LOG_FAIL(U"TCPClient: onReceive exceeded the maximum buffer size");
+
+					m_error = TCPError::NoBufferSpaceAvailable;
+
+					close();
+
+					return;
+				}
+
+				// リングバッファの空き領域に直接受信する
+				m_socket.async_read_some(asio::buffer(buffer.first, buffer.second),
 					std::bind(&ClientSession::onReceive, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
 			}
 
-			void onReceive(const asio::error_code& error, size_t, const std::shared_ptr<ClientSession>&)
+			void onReceive(const asio::error_code& error, const size_t bytesTransferred, const std::shared_ptr<ClientSession>&)
 			{
 				if (error)
 				{
@@ -161,53 +195,41 @@ namespace s3d
 						m_error = TCPError::EoF;
 					}
 
-					m_streamBuffer.consume(m_streamBuffer.size());
-
 					close();
 
 					return;
 				}
 
-				const Byte* data = asio::buffer_cast<const Byte*>(m_streamBuffer.data());
-				const size_t size = m_streamBuffer.size();
+				if (!m_isActive)
+				{
+					return;
+				}
 
 				{
 					std::lock_guard lock{ m_mutexReceivedBuffer };
 
-					if (m_receivedBuffer.size() + size > maxBufferSize)
-					{
-						LOG_FAIL(U"TCPClient: onReceive exceeded the maximum buffer size");
-
-						m_error = TCPError::NoBufferSpaceAvailable;
-
-						m_streamBuffer.consume(m_streamBuffer.size());
-
-						close();
-
-						return;
-					}
-
-					m_receivedBuffer.insert(m_receivedBuffer.end(), data, data + size);
+					m_receivedBuffer.commit(bytesTransferred);
 				}
 
-				m_streamBuffer.consume(m_streamBuffer.size());
-
 				startReceive();
 			}
 
-			void onSend(const asio::error_code& error, size_t, const std::shared_ptr<ClientSession>&)
+			void onSend(const asio::error_code& error, const size_t bytesTransferred, const std::shared_ptr<ClientSession>&)
 			{
+				std::unique_lock lock{ m_mutexSendingBuffer };
+
 				m_isSending = false;
 
 				if (!m_isActive)
 				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
 					m_sendingBuffer.clear();
 					return;
 				}
 
 				if (error)
 				{
+					lock.unlock();
+
 					LOG_FAIL(U"TCPClient: send failed: {}"_fmt(Unicode::Widen(error.message())));
 
 					m_error = TCPError::Error;
@@ -217,18 +239,11 @@ namespace s3d
 					return;
 				}
 
-				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
+				m_sendingBuffer.consume(bytesTransferred);
 
-					if (!m_sendingBuffer.empty())
-					{
-						m_sendingBuffer.erase(m_sendingBuffer.begin());
-					}
-
-					if (!m_sendingBuffer.empty())
-					{
-						send_internal();
-					}
+				if (!m_sendingBuffer.isEmpty())
+				{
+					send_internal();
 				}
 			}
 
@@ -239,23 +254,11 @@ namespace s3d
 					return false;
 				}
 
-				if (size == 0)
-				{
-					return true;
-				}
-
 				{
 					std::lock_guard lock{ m_mutexReceivedBuffer };
 
-					if (size > m_receivedBuffer.size())
-					{
-						return false;
-					}
-
-					m_receivedBuffer.pop_front_N(size);
+					return m_receivedBuffer.skip(size);
 				}
-
-				return true;
 			}
 
 			bool lookahead(void* dst, const size_t size)
@@ -265,26 +268,28 @@ namespace s3d
 					return false;
 				}
 
-				if (size == 0)
 				{
-					return true;
+					std::lock_guard lock{ m_mutexReceivedBuffer };
+
+					return m_receivedBuffer.lookahead(dst, size);
 				}
+			}
 
+			bool read(void* dst, const size_t size)
+			{
+				if (!m_isActive)
 				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+					return false;
+				}
 
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
+				{
+					std::lock_guard lock{ m_mutexReceivedBuffer };
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
+					return m_receivedBuffer.read(dst, size);
 				}
-
-				return true;
 			}
 
-			bool read(void* dst, const size_t size)
+			bool send(const void* data, const size_t size)
 			{
 				if (!m_isActive)
 				{
@@ -297,37 +302,50 @@ namespace s3d
 				}
 
 				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+					std::lock_guard lock{ m_mutexSendingBuffer };
+
+					m_sendingBuffer.push(data, size);
 
-					if (m_receivedBuffer.size() < size)
+					if (!m_isSending)
 					{
-						return false;
+						send_internal();
 					}
+				}
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
+				return true;
+			}
 
-					m_receivedBuffer.pop_front_N(size);
+			bool readMessage(Array<Byte>& message)
+			{
+				if (!m_isActive)
+				{
+					return false;
 				}
 
-				return true;
+				{
+					std::lock_guard lock{ m_mutexReceivedBuffer };
+
+					return m_receivedBuffer.readMessage(message);
+				}
 			}
 
-			bool send(const void* data, const size_t size)
+			bool sendMessage(const void* data, const size_t size)
 			{
 				if (!m_isActive)
 				{
 					return false;
 				}
 
-				if (size == 0)
+				if (TCPMaxMessageSize < size)
 				{
-					return true;
+					LOG_FAIL(U"TCPClient: sendMessage() failed: the message size ({} bytes) exceeds the limit"_fmt(size));
+					return false;
 				}
 
 				{
 					std::lock_guard lock{ m_mutexSendingBuffer };
 
-					m_sendingBuffer.emplace_back(static_cast<const Byte*>(data), static_cast<const Byte*>(data) + size);
+					m_sendingBuffer.pushMessage(data, size);
 
 					if (!m_isSending)
 					{
@@ -391,5 +409,9 @@ namespace s3d
 		bool read(void* dst, size_t size);
 
 		bool send(const void* data, size_t size);
+
+		bool sendMessage(const void* data, size_t size);
+
+		bool tryReceiveMessage(Array<Byte>& message);
 	};
 }
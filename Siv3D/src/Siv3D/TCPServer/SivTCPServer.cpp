@@ -15,7 +15,10 @@
 namespace s3d
 {
 	TCPServer::TCPServer()
-		: pImpl{ std::make_shared<TCPServerDetail>() } {}
+		: pImpl{ std::make_shared<TCPServerDetail>(1) } {}
+
+	TCPServer::TCPServer(const size_t ioThreadCount)
+		: pImpl{ std::make_shared<TCPServerDetail>(ioThreadCount) } {}
 	
 	TCPServer::~TCPServer() {}
 
@@ -93,4 +96,19 @@ namespace s3d
 	{
 		return pImpl->send(data, size, id);
 	}
+
+	bool TCPServer::sendMessage(const void* data, const size_t size, const Optional<TCPSessionID>& id)
+	{
+		return pImpl->sendMessage(data, size, id);
+	}
+
+	bool TCPServer::tryReceiveMessage(Array<Byte>& message, const Optional<TCPSessionID>& id)
+	{
+		return pImpl->tryReceiveMessage(message, id);
+	}
+
+	bool TCPServer::tryReceiveAnyMessage(TCPSessionID& id, Array<Byte>& message)
+	{
+		return pImpl->tryReceiveAnyMessage(id, message);
+	}
 }
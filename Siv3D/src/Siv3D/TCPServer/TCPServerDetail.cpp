@@ -13,10 +13,14 @@
 
 namespace s3d
 {
-	TCPServer::TCPServerDetail::TCPServerDetail()
-		: m_io_service(std::make_shared<asio::io_service>())
+	TCPServer::TCPServerDetail::TCPServerDetail(const size_t ioThreadCount)
 	{
+		m_ioContexts.resize(Max<size_t>(ioThreadCount, 1));
 
+		for (auto& context : m_ioContexts)
+		{
+			context.io_service = std::make_shared<asio::io_service>();
+		}
 	}
 
 	TCPServer::TCPServerDetail::~TCPServerDetail()
@@ -26,58 +30,12 @@ namespace s3d
 
 	void TCPServer::TCPServerDetail::startAccept(const uint16 port)
 	{
-		if (m_accepting)
-		{
-			cancelAccept();
-		}
-
-		m_accepting = true;
-
-		m_allowMulti = false;
-
-		m_port = port;
-
-		if (!m_work)
-		{
-			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
-
-			m_io_service_thread = Async([this] { m_io_service->run(); });
-		}
-
-		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
-
-		std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_service);
-
-		m_acceptor->async_accept(newSession->socket(),
-			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
+		startAcceptInternal(port, false);
 	}
 
 	void TCPServer::TCPServerDetail::startAcceptMulti(const uint16 port)
 	{
-		if (m_accepting)
-		{
-			cancelAccept();
-		}
-
-		m_accepting = true;
-
-		m_allowMulti = true;
-
-		m_port = port;
-
-		if (!m_work)
-		{
-			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
-
-			m_io_service_thread = Async([this] { m_io_service->run(); });
-		}
-
-		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
-
-		std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_service);
-
-		m_acceptor->async_accept(newSession->socket(),
-			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
+		startAcceptInternal(port, true);
 	}
 
 	void TCPServer::TCPServerDetail::cancelAccept()
@@ -99,22 +57,32 @@ namespace s3d
 	{
 		cancelAccept();
 
-		for (auto& session : m_sessions)
+		HashTable<TCPSessionID, std::shared_ptr<detail::ServerSession>> sessions;
+		{
+			std::lock_guard lock{ m_mutexSessions };
+
+			sessions.swap(m_sessions);
+		}
+
+		for (auto& session : sessions)
 		{
 			session.second->close();
 		}
 
-		m_sessions.clear();
+		sessions.clear();
+
+		stopIOThreads();
 
-		if (m_work)
 		{
-			m_work.reset();
+			std::lock_guard lock{ m_mutexClosedSessions };
 
-			m_io_service->stop();
+			m_closedSessions.clear();
+		}
 
-			m_io_service_thread.wait();
+		{
+			std::lock_guard lock{ m_mutexMessageSessions };
 
-			m_io_service->restart();
+			m_messageSessions.clear();
 		}
 	}
 
@@ -122,28 +90,49 @@ namespace s3d
 	{
 		updateSession();
 
-		return m_sessions.any([](const auto& session) { return session.second->isActive(); });
+		std::lock_guard lock{ m_mutexSessions };
+
+		return (not m_sessions.empty());
 	}
 
 	bool TCPServer::TCPServerDetail::hasSession(const TCPSessionID id)
 	{
 		updateSession();
 
-		return m_sessions.contains_if([=](const auto& session) { return session.first == id; });
+		std::lock_guard lock{ m_mutexSessions };
+
+		return m_sessions.contains(id);
 	}
 
 	size_t TCPServer::TCPServerDetail::num_sessions()
 	{
 		updateSession();
 
-		return m_sessions.count_if([](const auto& session) { return session.second->isActive(); });
+		std::lock_guard lock{ m_mutexSessions };
+
+		return m_sessions.size();
 	}
 
 	Array<TCPSessionID> TCPServer::TCPServerDetail::getSessionIDs()
 	{
 		updateSession();
 
-		return m_sessions.map([](const auto& session) { return session.first; });
+		Array<TCPSessionID> ids;
+		{
+			std::lock_guard lock{ m_mutexSessions };
+
+			ids.reserve(m_sessions.size());
+
+			for (const auto& session : m_sessions)
+			{
+				ids.push_back(session.first);
+			}
+		}
+
+		// 接続した順に並べる
+		ids.sort();
+
+		return ids;
 	}
 
 	uint16 TCPServer::TCPServerDetail::port() const
@@ -153,102 +142,194 @@ namespace s3d
 
 	size_t TCPServer::TCPServerDetail::available(const Optional<TCPSessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = getSession(id))
 		{
-			return 0;
+			return session->available();
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return 0;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::skip(const size_t size, const Optional<TCPSessionID>& id)
+	{
+		if (const auto session = getSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->available();
-			}
+			return session->skip(size);
 		}
 
-		return 0;
+		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::skip(const size_t size, const Optional<TCPSessionID>& id)
+	bool TCPServer::TCPServerDetail::lookahead(void* dst, const size_t size, const Optional<TCPSessionID>& id) const
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = getSession(id))
 		{
-			return false;
+			return session->lookahead(dst, size);
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::read(void* dst, const size_t size, const Optional<TCPSessionID>& id)
+	{
+		if (const auto session = getSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->skip(size);
-			}
+			return session->read(dst, size);
 		}
 
 		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::lookahead(void* dst, const size_t size, const Optional<TCPSessionID>& id) const
+	bool TCPServer::TCPServerDetail::send(const void* data, const size_t size, const Optional<TCPSessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = getSession(id))
 		{
-			return false;
+			return session->send(data, size);
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::sendMessage(const void* data, const size_t size, const Optional<TCPSessionID>& id)
+	{
+		if (const auto session = getSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->lookahead(dst, size);
-			}
+			return session->sendMessage(data, size);
 		}
 
 		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::read(void* dst, const size_t size, const Optional<TCPSessionID>& id)
+	bool TCPServer::TCPServerDetail::tryReceiveMessage(Array<Byte>& message, const Optional<TCPSessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = getSession(id))
 		{
-			return false;
+			return session->readMessage(message);
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::tryReceiveAnyMessage(TCPSessionID& id, Array<Byte>& message)
+	{
+		for (;;)
 		{
-			if (session.first == sessionID)
+			TCPSessionID sessionID;
+			{
+				std::lock_guard lock{ m_mutexMessageSessions };
+
+				if (m_messageSessions.empty())
+				{
+					return false;
+				}
+
+				sessionID = m_messageSessions.front();
+
+				m_messageSessions.pop_front();
+			}
+
+			const auto session = getSession(sessionID);
+
+			if (not session)
+			{
+				continue;
+			}
+
+			// 以降に揃ったメッセージは、I/O スレッドが改めて通知する
+			session->clearMessageNotified();
+
+			// 通知の後に、セッション ID を指定した tryReceiveMessage() で読まれていることがある
+			if (not session->readMessage(message))
 			{
-				return session.second->read(dst, size);
+				continue;
 			}
+
+			// 続きのメッセージが揃っていれば、他のセッションの後ろに並び直す
+			if (session->hasMessage() && session->markMessageNotified())
+			{
+				onSessionMessage(sessionID);
+			}
+
+			id = sessionID;
+
+			return true;
+		}
+	}
+
+	void TCPServer::TCPServerDetail::startIOThreads()
+	{
+		if (m_ioContexts.front().work)
+		{
+			return;
 		}
 
-		return false;
+		for (auto& context : m_ioContexts)
+		{
+			context.work = std::make_unique<asio::io_service::work>(*context.io_service);
+
+			context.thread = Async([io_service = context.io_service.get()] { io_service->run(); });
+		}
 	}
 
-	bool TCPServer::TCPServerDetail::send(const void* data, const size_t size, const Optional<TCPSessionID>& id)
+	void TCPServer::TCPServerDetail::stopIOThreads()
 	{
-		if (m_sessions.isEmpty())
+		if (not m_ioContexts.front().work)
 		{
-			return false;
+			return;
 		}
 
-		const TCPSessionID sessionID = id.value_or(m_sessions.front().first);
+		for (auto& context : m_ioContexts)
+		{
+			context.work.reset();
+
+			context.io_service->stop();
+		}
 
-		for (auto& session : m_sessions)
+		for (auto& context : m_ioContexts)
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->send(data, size);
-			}
+			context.thread.wait();
+
+			context.io_service->restart();
 		}
+	}
 
-		return false;
+	asio::io_service& TCPServer::TCPServerDetail::nextIOService()
+	{
+		asio::io_service& io_service = *m_ioContexts[m_nextIOContextIndex].io_service;
+
+		m_nextIOContextIndex = ((m_nextIOContextIndex + 1) % m_ioContexts.size());
+
+		return io_service;
+	}
+
+	void TCPServer::TCPServerDetail::startAcceptInternal(const uint16 port, const bool allowMulti)
+	{
+		if (m_accepting)
+		{
+			cancelAccept();
+		}
+
+		m_accepting = true;
+
+		m_allowMulti = allowMulti;
+
+		m_port = port;
+
+		startIOThreads();
+
+		// 接続の受け付けは最初の I/O スレッドで行う
+		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_ioContexts.front().io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+
+		asyncAccept();
+	}
+
+	void TCPServer::TCPServerDetail::asyncAccept()
+	{
+		// セッションは、受け付けとは別の I/O スレッドで動かしてもよい
+		std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(nextIOService());
+
+		m_acceptor->async_accept(newSession->socket(),
+			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
 	}
 
 	void TCPServer::TCPServerDetail::onAccept(const asio::error_code& error, const std::shared_ptr<detail::ServerSession>& session)
@@ -271,7 +352,9 @@ namespace s3d
 
 		const TCPSessionID id = ++m_currentTCPSessionID;
 
-		session->init(id);
+		session->init(id,
+			[this](const TCPSessionID sessionID) { onSessionMessage(sessionID); },
+			[this](const TCPSessionID sessionID) { onSessionClose(sessionID); });
 
 		{
 			const auto& socket = session->socket();
@@ -283,18 +366,24 @@ namespace s3d
 				socket.local_endpoint().port()));
 		}
 
-		m_sessions.push_back({ id, session });
+		{
+			std::lock_guard lock{ m_mutexSessions };
+
+			if (m_sessions.empty())
+			{
+				m_frontSessionID = id;
+			}
+
+			m_sessions.emplace(id, session);
+		}
 
 		LOG_TRACE(U"TCPServer session [{}] created"_fmt(id));
 
-		m_sessions.back().second->startReceive();
+		session->startReceive();
 
 		if (m_allowMulti)
 		{
-			std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_service);
-
-			m_acceptor->async_accept(newSession->socket(),
-				std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
+			asyncAccept();
 		}
 		else
 		{
@@ -302,8 +391,76 @@ namespace s3d
 		}
 	}
 
+	void TCPServer::TCPServerDetail::onSessionMessage(const TCPSessionID id)
+	{
+		std::lock_guard lock{ m_mutexMessageSessions };
+
+		m_messageSessions.push_back(id);
+	}
+
+	void TCPServer::TCPServerDetail::onSessionClose(const TCPSessionID id)
+	{
+		std::lock_guard lock{ m_mutexClosedSessions };
+
+		m_closedSessions.push_back(id);
+	}
+
 	void TCPServer::TCPServerDetail::updateSession()
 	{
-		m_sessions.remove_if([](const auto& session) { return !session.second->isActive(); });
+		Array<TCPSessionID> closedSessions;
+		{
+			std::lock_guard lock{ m_mutexClosedSessions };
+
+			if (not m_closedSessions)
+			{
+				return;
+			}
+
+			closedSessions.swap(m_closedSessions);
+		}
+
+		std::lock_guard lock{ m_mutexSessions };
+
+		bool frontClosed = false;
+
+		for (const auto id : closedSessions)
+		{
+			m_sessions.erase(id);
+
+			frontClosed |= (id == m_frontSessionID);
+		}
+
+		// 最も古いセッションが閉じた場合に限り、次に古いセッションを探す
+		if (frontClosed)
+		{
+			m_frontSessionID = 0;
+
+			for (const auto& session : m_sessions)
+			{
+				if ((m_frontSessionID == 0) || (session.first < m_frontSessionID))
+				{
+					m_frontSessionID = session.first;
+				}
+			}
+		}
+	}
+
+	std::shared_ptr<detail::ServerSession> TCPServer::TCPServerDetail::getSession(const Optional<TCPSessionID>& id) const
+	{
+		std::lock_guard lock{ m_mutexSessions };
+
+		if (m_sessions.empty())
+		{
+			return nullptr;
+		}
+
+		const auto it = m_sessions.find(id.value_or(m_frontSessionID));
+
+		if (it == m_sessions.end())
+		{
+			return nullptr;
+		}
+
+		return it->second;
 	}
 }
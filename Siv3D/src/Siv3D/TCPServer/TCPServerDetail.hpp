@@ -10,11 +10,14 @@
 //-----------------------------------------------
 
 # pragma once
+# include <deque>
 # include <Siv3D/TCPServer.hpp>
 # include <Siv3D/AsyncTask.hpp>
+# include <Siv3D/HashTable.hpp>
 # include <Siv3D/Byte.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Network/TCPBuffer.hpp>
 
 # define _WINSOCK_DEPRECATED_NO_WARNINGS
 # ifndef _WIN32_WINNT
@@ -42,29 +45,48 @@ namespace s3d
 
 			bool m_eof = false;
 
-			asio::streambuf m_streamBuffer;
+			/// @brief 揃ったメッセージがあることを、サーバに通知済みであるか
+			std::atomic<bool> m_messageNotified = false;
+
+			std::function<void(TCPSessionID)> m_onMessage;
+
+			std::function<void(TCPSessionID)> m_onClose;
 
 			// 受信	
 			static constexpr size_t maxBufferSize = 32 * 1024 * 1024;
 
 			std::mutex m_mutexReceivedBuffer;
 
-			Array<Byte> m_receivedBuffer;
+			TCPReceiveBuffer m_receivedBuffer{ maxBufferSize };
 
 
 			// 送信
+			static constexpr size_t maxSendBufferCount = 16;
+
 			std::mutex m_mutexSendingBuffer;
 
-			Array<Array<Byte>> m_sendingBuffer;
+			TCPSendQueue m_sendingBuffer;
+
+			std::array<asio::const_buffer, maxSendBufferCount> m_sendingBufferSequence;
 
 			bool m_isSending = false;
 
 
+			// m_mutexSendingBuffer をロックした状態で呼ぶ
 			void send_internal()
 			{
+				std::array<TCPSendQueue::Region, maxSendBufferCount> regions;
+
+				const size_t count = m_sendingBuffer.gather(regions.data(), regions.size());
+
+				for (size_t i = 0; i < maxSendBufferCount; ++i)
+				{
+					m_sendingBufferSequence[i] = ((i < count) ? asio::const_buffer{ regions[i].data, regions[i].size } : asio::const_buffer{});
+				}
+
 				m_isSending = true;
 
-				asio::async_write(m_socket, asio::buffer(m_sendingBuffer.front().data(), m_sendingBuffer.front().size()),
+				asio::async_write(m_socket, m_sendingBufferSequence,
 					std::bind(&ServerSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
 			}
 
@@ -95,34 +117,49 @@ namespace s3d
 
 				m_socket.close();
 
-				if (!m_isSending)
 				{
 					std::lock_guard lock{ m_mutexSendingBuffer };
-					m_sendingBuffer.clear();
+
+					// 送信中のデータは onSend() で破棄する
+					if (!m_isSending)
+					{
+						m_sendingBuffer.clear();
+					}
 				}
 
 				{
 					std::lock_guard lock{ m_mutexReceivedBuffer };
 					m_receivedBuffer.clear();
-					m_streamBuffer.consume(m_streamBuffer.size());
 				}
 
-				m_isSending = false;
 				m_isActive = false;
 				m_eof = false;
 
 				if (m_id)
 				{
 					LOG_TRACE(U"Session [{}] closed"_fmt(m_id));
+
+					if (m_onClose)
+					{
+						m_onClose(m_id);
+					}
 				}
 
 				m_id = 0;
 			}
 
-			void init(const TCPSessionID id)
+			/// @brief セッションを開始します。
+			/// @param id セッション ID
+			/// @param onMessage 揃ったメッセージが届いたときに、I/O スレッドから呼ばれる関数
+			/// @param onClose セッションが閉じたときに呼ばれる関数
+			void init(const TCPSessionID id, std::function<void(TCPSessionID)> onMessage, std::function<void(TCPSessionID)> onClose)
 			{
 				m_id = id;
 
+				m_onMessage = std::move(onMessage);
+
+				m_onClose = std::move(onClose);
+
 				m_isActive = true;
 
 				LOG_TRACE(U"Session [{}] created"_fmt(id));
@@ -147,11 +184,28 @@ namespace s3d
 
 			void startReceive()
 			{
-				asio::async_read(m_socket, m_streamBuffer, asio::transfer_at_least(1),
+				std::pair<Byte*, size_t> buffer;
+				{
+					std::lock_guard lock{ m_mutexReceivedBuffer };
+
+					buffer = m_receivedBuffer.prepare();
+				}
+
+				if (buffer.first == nullptr)
+				{
+					LOG_FAIL(U"TCPServer: onReceive exceeded the maximum buffer size");
+
+					close();
+
+					return;
+				}
+
+				// リングバッファの空き領域に直接受信する
+				m_socket.async_read_some(asio::buffer(buffer.first, buffer.second),
 					std::bind(&ServerSession::onReceive, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
 			}
 
-			void onReceive(const asio::error_code& error, size_t, const std::shared_ptr<ServerSession>&)
+			void onReceive(const asio::error_code& error, const size_t bytesTransferred, const std::shared_ptr<ServerSession>&)
 			{
 				if (error)
 				{
@@ -166,51 +220,49 @@ namespace s3d
 						m_eof = true;
 					}
 
-					m_streamBuffer.consume(m_streamBuffer.size());
-
 					close();
 
 					return;
 				}
 
-				const Byte* data = asio::buffer_cast<const Byte*>(m_streamBuffer.data());
-				const size_t size = m_streamBuffer.size();
+				if (!m_isActive)
+				{
+					return;
+				}
 
+				bool hasMessage;
 				{
 					std::lock_guard lock{ m_mutexReceivedBuffer };
 
-					if (m_receivedBuffer.size() + size > maxBufferSize)
-					{
-						LOG_FAIL(U"TCPServer: onReceive exceeded the maximum buffer size");
-
-						m_streamBuffer.consume(m_streamBuffer.size());
-
-						close();
+					m_receivedBuffer.commit(bytesTransferred);
 
-						return;
-					}
-
-					m_receivedBuffer.insert(m_receivedBuffer.end(), data, data + size);
+					hasMessage = m_receivedBuffer.hasMessage();
 				}
 
-				m_streamBuffer.consume(m_streamBuffer.size());
+				if (hasMessage && markMessageNotified())
+				{
+					m_onMessage(m_id);
+				}
 
 				startReceive();
 			}
 
-			void onSend(const asio::error_code& error, size_t, const std::shared_ptr<ServerSession>&)
+			void onSend(const asio::error_code& error, const size_t bytesTransferred, const std::shared_ptr<ServerSession>&)
 			{
+				std::unique_lock lock{ m_mutexSendingBuffer };
+
 				m_isSending = false;
 
 				if (!m_isActive)
 				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
 					m_sendingBuffer.clear();
 					return;
 				}
 
 				if (error)
 				{
+					lock.unlock();
+
 					LOG_FAIL(U"TCPServer: send failed: {}"_fmt(Unicode::Widen(error.message())));
 
 					close();
@@ -218,18 +270,11 @@ namespace s3d
 					return;
 				}
 
-				{
-					std::lock_guard lock{ m_mutexSendingBuffer };
-
-					if (!m_sendingBuffer.empty())
-					{
-						m_sendingBuffer.erase(m_sendingBuffer.begin());
-					}
+				m_sendingBuffer.consume(bytesTransferred);
 
-					if (!m_sendingBuffer.empty())
-					{
-						send_internal();
-					}
+				if (!m_sendingBuffer.isEmpty())
+				{
+					send_internal();
 				}
 			}
 
@@ -240,23 +285,11 @@ namespace s3d
 					return false;
 				}
 
-				if (size == 0)
-				{
-					return true;
-				}
-
 				{
 					std::lock_guard lock{ m_mutexReceivedBuffer };
 
-					if (size > m_receivedBuffer.size())
-					{
-						return false;
-					}
-
-					m_receivedBuffer.pop_front_N(size);
+					return m_receivedBuffer.skip(size);
 				}
-
-				return true;
 			}
 
 			bool lookahead(void* dst, const size_t size)
@@ -266,26 +299,28 @@ namespace s3d
 					return false;
 				}
 
-				if (size == 0)
 				{
-					return true;
+					std::lock_guard lock{ m_mutexReceivedBuffer };
+
+					return m_receivedBuffer.lookahead(dst, size);
 				}
+			}
 
+			bool read(void* dst, const size_t size)
+			{
+				if (!m_isActive)
 				{
-					std::lock_guard lock{ m_mutexReceivedBuffer };
+					return false;
+				}
 
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
+				{
+					std::lock_guard lock{ m_mutexReceivedBuffer };
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
+					return m_receivedBuffer.read(dst, size);
 				}
-
-				return true;
 			}
 
-			bool read(void* dst, const size_t size)
+			bool send(const void* data, const size_t size)
 			{
 				if (!m_isActive)
 				{
@@ -298,32 +333,57 @@ namespace s3d
 				}
 
 				{
-					std::lock_guard<std::mutex> lock{ m_mutexReceivedBuffer };
+					std::lock_guard lock{ m_mutexSendingBuffer };
+
+					m_sendingBuffer.push(data, size);
 
-					if (m_receivedBuffer.size() < size)
+					if (!m_isSending)
 					{
-						return false;
+						send_internal();
 					}
+				}
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
+				return true;
+			}
 
-					m_receivedBuffer.pop_front_N(size);
+			bool hasMessage()
+			{
+				std::lock_guard lock{ m_mutexReceivedBuffer };
+
+				return m_receivedBuffer.hasMessage();
+			}
+
+			bool readMessage(Array<Byte>& message)
+			{
+				if (!m_isActive)
+				{
+					return false;
 				}
 
-				return true;
+				{
+					std::lock_guard lock{ m_mutexReceivedBuffer };
+
+					return m_receivedBuffer.readMessage(message);
+				}
 			}
 
-			bool send(const void* data, const size_t size)
+			bool sendMessage(const void* data, const size_t size)
 			{
 				if (!m_isActive)
 				{
 					return false;
 				}
 
+				if (TCPMaxMessageSize < size)
+				{
+					LOG_FAIL(U"TCPServer: sendMessage() failed: the message size ({} bytes) exceeds the limit"_fmt(size));
+					return false;
+				}
+
 				{
 					std::lock_guard lock{ m_mutexSendingBuffer };
 
-					m_sendingBuffer.emplace_back(static_cast<const Byte*>(data), static_cast<const Byte*>(data) + size);
+					m_sendingBuffer.pushMessage(data, size);
 
 					if (!m_isSending)
 					{
@@ -333,6 +393,18 @@ namespace s3d
 
 				return true;
 			}
+
+			/// @brief メッセージの到着をサーバに通知済みとしてマークします。
+			/// @return 新たにマークした場合 true, すでに通知済みだった場合 false
+			bool markMessageNotified() noexcept
+			{
+				return (not m_messageNotified.exchange(true));
+			}
+
+			void clearMessageNotified() noexcept
+			{
+				m_messageNotified = false;
+			}
 		};
 	}
 
@@ -340,15 +412,38 @@ namespace s3d
 	{
 	private:
 
-		std::shared_ptr<asio::io_service> m_io_service;
+		struct IOContext
+		{
+			std::shared_ptr<asio::io_service> io_service;
+
+			std::unique_ptr<asio::io_service::work> work;
+
+			AsyncTask<void> thread;
+		};
+
+		/// @brief I/O スレッドごとの io_service. セッションは順番に割り当てられる
+		Array<IOContext> m_ioContexts;
 
-		std::unique_ptr<asio::io_service::work> m_work;
+		size_t m_nextIOContextIndex = 0;
 
 		std::unique_ptr<asio::ip::tcp::acceptor> m_acceptor;
 
-		AsyncTask<void> m_io_service_thread;
+		mutable std::mutex m_mutexSessions;
+
+		HashTable<TCPSessionID, std::shared_ptr<detail::ServerSession>> m_sessions;
+
+		/// @brief セッション ID を省略したときに使う、最も古いセッションの ID
+		TCPSessionID m_frontSessionID = 0;
+
+		/// @brief 閉じたが、まだ m_sessions から取り除いていないセッション
+		std::mutex m_mutexClosedSessions;
+
+		Array<TCPSessionID> m_closedSessions;
 
-		Array<std::pair<TCPSessionID, std::shared_ptr<detail::ServerSession>>> m_sessions;
+		/// @brief 揃ったメッセージが届いているセッションの、届いた順のキュー
+		std::mutex m_mutexMessageSessions;
+
+		std::deque<TCPSessionID> m_messageSessions;
 
 		std::atomic<TCPSessionID> m_currentTCPSessionID = 0;
 
@@ -358,13 +453,31 @@ namespace s3d
 
 		bool m_allowMulti = false;
 
+		void startIOThreads();
+
+		void stopIOThreads();
+
+		[[nodiscard]]
+		asio::io_service& nextIOService();
+
+		void startAcceptInternal(uint16 port, bool allowMulti);
+
+		void asyncAccept();
+
 		void onAccept(const asio::error_code& error, const std::shared_ptr<detail::ServerSession>& session);
 
+		void onSessionMessage(TCPSessionID id);
+
+		void onSessionClose(TCPSessionID id);
+
 		void updateSession();
 
+		[[nodiscard]]
+		std::shared_ptr<detail::ServerSession> getSession(const Optional<TCPSessionID>& id) const;
+
 	public:
 
-		TCPServerDetail();
+		explicit TCPServerDetail(size_t ioThreadCount);
 
 		~TCPServerDetail();
 
@@ -397,5 +510,11 @@ namespace s3d
 		bool read(void* dst, size_t size, const Optional<TCPSessionID>& id);
 
 		bool send(const void* data, size_t size, const Optional<TCPSessionID>& id);
+
+		bool sendMessage(const void* data, size_t size, const Optional<TCPSessionID>& id);
+
+		bool tryReceiveMessage(Array<Byte>& message, const Optional<TCPSessionID>& id);
+
+		bool tryReceiveAnyMessage(TCPSessionID& id, Array<Byte>& message);
 	};
 }
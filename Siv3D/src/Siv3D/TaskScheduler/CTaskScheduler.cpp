@@ -0,0 +1,241 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Profiler.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include "CTaskScheduler.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 現在のスレッドを所有するスケジューラ（ワーカースレッドでない場合は nullptr）
+		static thread_local const CTaskScheduler* tl_scheduler = nullptr;
+
+		/// @brief 現在のスレッドのワーカー番号
+		static thread_local size_t tl_workerIndex = 0;
+	}
+
+	CTaskScheduler::CTaskScheduler()
+	{
+	# if !SIV3D_PLATFORM(WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+
+		// 呼び出し元のスレッドも待機中にタスクを処理するため、ワーカーは 1 つ少なくする
+		m_workerCount = Max<size_t>(1, (Threading::GetConcurrency() - 1));
+
+	# endif
+	}
+
+	CTaskScheduler::~CTaskScheduler()
+	{
+		LOG_SCOPED_TRACE(U"CTaskScheduler::~CTaskScheduler()");
+
+		{
+			std::lock_guard lock{ m_sleepMutex };
+			m_stop = true;
+		}
+
+		m_sleepCondition.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			if (worker->thread.joinable())
+			{
+				worker->thread.join();
+			}
+		}
+	}
+
+	size_t CTaskScheduler::getWorkerCount() const noexcept
+	{
+		return m_workerCount;
+	}
+
+	void CTaskScheduler::submit(Task task)
+	{
+		if (m_workerCount == 0)
+		{
+			task();
+			return;
+		}
+
+		std::call_once(m_startFlag, [this]() { start(); });
+
+		if (detail::tl_scheduler == this)
+		{
+			Worker& worker = *m_workers[detail::tl_workerIndex];
+			std::lock_guard lock{ worker.mutex };
+			worker.tasks.push_back(std::move(task));
+		}
+		else
+		{
+			std::lock_guard lock{ m_sharedMutex };
+			m_sharedTasks.push_back(std::move(task));
+		}
+
+		m_queuedCount.fetch_add(1, std::memory_order_release);
+
+		notifyOne();
+	}
+
+	bool CTaskScheduler::runPendingTask()
+	{
+		if (m_queuedCount.load(std::memory_order_acquire) == 0)
+		{
+			return false;
+		}
+
+		Task task;
+
+		if (detail::tl_scheduler == this)
+		{
+			if (not tryPop(detail::tl_workerIndex, task))
+			{
+				return false;
+			}
+		}
+		else if (not tryPopShared(task))
+		{
+			if (not trySteal(m_workers.size(), task))
+			{
+				return false;
+			}
+		}
+
+		task();
+
+		return true;
+	}
+
+	void CTaskScheduler::start()
+	{
+		LOG_SCOPED_TRACE(U"CTaskScheduler::start()");
+
+		for (size_t i = 0; i < m_workerCount; ++i)
+		{
+			m_workers.push_back(std::make_unique<Worker>());
+		}
+
+		for (size_t i = 0; i < m_workerCount; ++i)
+		{
+			m_workers[i]->thread = std::thread{ [this, i]() { run(i); } };
+		}
+
+		LOG_INFO(U"ℹ️ Task scheduler started with {} worker threads"_fmt(m_workerCount));
+	}
+
+	void CTaskScheduler::run(const size_t workerIndex)
+	{
+		detail::tl_scheduler = this;
+		detail::tl_workerIndex = workerIndex;
+
+		Profiler::SetThreadName(U"Worker {}"_fmt(workerIndex));
+
+		for (;;)
+		{
+			Task task;
+
+			if (tryPop(workerIndex, task))
+			{
+				task();
+				continue;
+			}
+
+			std::unique_lock lock{ m_sleepMutex };
+
+			m_sleepCondition.wait(lock, [this]() { return (m_stop || (m_queuedCount.load(std::memory_order_acquire) != 0)); });
+
+			if (m_stop && (m_queuedCount.load(std::memory_order_acquire) == 0))
+			{
+				return;
+			}
+		}
+	}
+
+	bool CTaskScheduler::tryPop(const size_t workerIndex, Task& task)
+	{
+		if (m_queuedCount.load(std::memory_order_acquire) == 0)
+		{
+			return false;
+		}
+
+		// 自身のキューからは新しいタスクを優先する（キャッシュ局所性、入れ子の並列処理の早期完了のため）
+		{
+			Worker& worker = *m_workers[workerIndex];
+			std::lock_guard lock{ worker.mutex };
+
+			if (not worker.tasks.empty())
+			{
+				task = std::move(worker.tasks.back());
+				worker.tasks.pop_back();
+				m_queuedCount.fetch_sub(1, std::memory_order_acq_rel);
+				return true;
+			}
+		}
+
+		return (tryPopShared(task) || trySteal(workerIndex, task));
+	}
+
+	bool CTaskScheduler::tryPopShared(Task& task)
+	{
+		std::lock_guard lock{ m_sharedMutex };
+
+		if (m_sharedTasks.empty())
+		{
+			return false;
+		}
+
+		task = std::move(m_sharedTasks.front());
+		m_sharedTasks.pop_front();
+		m_queuedCount.fetch_sub(1, std::memory_order_acq_rel);
+		return true;
+	}
+
+	bool CTaskScheduler::trySteal(const size_t workerIndex, Task& task)
+	{
+		const size_t workerCount = m_workers.size();
+
+		for (size_t i = 1; i <= workerCount; ++i)
+		{
+			const size_t victimIndex = ((workerIndex + i) % workerCount);
+
+			if (victimIndex == workerIndex)
+			{
+				continue;
+			}
+
+			Worker& victim = *m_workers[victimIndex];
+			std::lock_guard lock{ victim.mutex };
+
+			if (not victim.tasks.empty())
+			{
+				// 他のワーカーからは古いタスクを奪う
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				m_queuedCount.fetch_sub(1, std::memory_order_acq_rel);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void CTaskScheduler::notifyOne()
+	{
+		{
+			std::lock_guard lock{ m_sleepMutex };
+		}
+
+		m_sleepCondition.notify_one();
+	}
+}
@@ -0,0 +1,80 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <deque>
+# include <mutex>
+# include <thread>
+# include <atomic>
+# include <condition_variable>
+# include <Siv3D/Array.hpp>
+# include "ITaskScheduler.hpp"
+
+namespace s3d
+{
+	/// @brief ワークスティーリング方式のスレッドプール
+	/// @remark ワーカーは自身のキューの末尾から、外部スレッドから投入されたタスクは共有キューから、それ以外は他のワーカーのキューの先頭から取り出します。
+	class CTaskScheduler final : public ISiv3DTaskScheduler
+	{
+	public:
+
+		CTaskScheduler();
+
+		~CTaskScheduler() override;
+
+		size_t getWorkerCount() const noexcept override;
+
+		void submit(Task task) override;
+
+		bool runPendingTask() override;
+
+	private:
+
+		struct Worker
+		{
+			std::thread thread;
+
+			std::mutex mutex;
+
+			std::deque<Task> tasks;
+		};
+
+		size_t m_workerCount = 0;
+
+		Array<std::unique_ptr<Worker>> m_workers;
+
+		std::once_flag m_startFlag;
+
+		std::mutex m_sharedMutex;
+
+		std::deque<Task> m_sharedTasks;
+
+		std::mutex m_sleepMutex;
+
+		std::condition_variable m_sleepCondition;
+
+		std::atomic<size_t> m_queuedCount{ 0 };
+
+		std::atomic<bool> m_stop{ false };
+
+		void start();
+
+		void run(size_t workerIndex);
+
+		bool tryPop(size_t workerIndex, Task& task);
+
+		bool tryPopShared(Task& task);
+
+		bool trySteal(size_t workerIndex, Task& task);
+
+		void notifyOne();
+	};
+}
@@ -0,0 +1,36 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <functional>
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	class SIV3D_NOVTABLE ISiv3DTaskScheduler
+	{
+	public:
+
+		using Task = std::function<void()>;
+
+		static ISiv3DTaskScheduler* Create();
+
+		virtual ~ISiv3DTaskScheduler() = default;
+
+		virtual size_t getWorkerCount() const noexcept = 0;
+
+		virtual void submit(Task task) = 0;
+
+		/// @brief 未実行のタスクを 1 つ取り出し、呼び出したスレッドで実行します。
+		/// @return タスクを実行した場合 true, 未実行のタスクが無かった場合 false
+		virtual bool runPendingTask() = 0;
+	};
+}
@@ -396,6 +396,36 @@ namespace s3d
 		return drawAtClipped(pos.x, pos.y, clipRect, diffuse);
 	}
 
+	void Texture::drawInstanced(const Array<Mat3x2>& transforms, const ColorF& diffuse) const
+	{
+		const Size size = SIV3D_ENGINE(Texture)->getSize(m_handle->id());
+
+		SIV3D_ENGINE(Renderer2D)->addTexturedQuads(
+			*this,
+			FloatRect{ 0.0f, 0.0f, static_cast<float>(size.x), static_cast<float>(size.y) },
+			FloatRect{ 0.0f, 0.0f, 1.0f, 1.0f },
+			transforms.data(),
+			nullptr,
+			transforms.size(),
+			diffuse.toFloat4()
+		);
+	}
+
+	void Texture::drawInstanced(const Array<Mat3x2>& transforms, const Array<ColorF>& colors) const
+	{
+		const Size size = SIV3D_ENGINE(Texture)->getSize(m_handle->id());
+
+		SIV3D_ENGINE(Renderer2D)->addTexturedQuads(
+			*this,
+			FloatRect{ 0.0f, 0.0f, static_cast<float>(size.x), static_cast<float>(size.y) },
+			FloatRect{ 0.0f, 0.0f, 1.0f, 1.0f },
+			transforms.data(),
+			colors.data(),
+			Min(transforms.size(), colors.size()),
+			Float4{ 1.0f, 1.0f, 1.0f, 1.0f }
+		);
+	}
+
 	TextureRegion Texture::operator ()(const double x, const double y, const double w, const double h) const
 	{
 		const Size size = SIV3D_ENGINE(Texture)->getSize(m_handle->id());
@@ -0,0 +1,210 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "SoftwareTexture.hpp"
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/2DShapes.hpp>
+
+namespace s3d
+{
+	SoftwareTexture::SoftwareTexture(const Image& image, const TextureDesc desc)
+		: m_image{ image }
+		, m_format{ detail::IsSRGB(desc) ? TextureFormat::R8G8B8A8_Unorm_SRGB : TextureFormat::R8G8B8A8_Unorm }
+		, m_textureDesc{ desc }
+		, m_type{ TextureType::Default }
+		, m_initialized{ true } {}
+
+	SoftwareTexture::SoftwareTexture(Dynamic, const Size& size, const void* pData, const uint32 stride, const TextureFormat& format, const TextureDesc desc)
+		: m_image{ size, Color{ 0, 0 } }
+		, m_format{ format }
+		, m_textureDesc{ desc }
+		, m_type{ TextureType::Dynamic }
+		, m_initialized{ true }
+	{
+		if (pData && isRGBA8())
+		{
+			fill(pData, stride);
+		}
+	}
+
+	SoftwareTexture::SoftwareTexture(Render, const Size& size, const TextureFormat& format, const TextureDesc desc, const HasDepth hasDepth)
+		: m_image{ size, Color{ 0, 0 } }
+		, m_format{ format }
+		, m_textureDesc{ desc }
+		, m_type{ TextureType::Render }
+		, m_hasDepth{ hasDepth.getBool() }
+		, m_initialized{ true } {}
+
+	SoftwareTexture::SoftwareTexture(Render, const Image& image, const TextureFormat& format, const TextureDesc desc, const HasDepth hasDepth)
+		: m_image{ image }
+		, m_format{ format }
+		, m_textureDesc{ desc }
+		, m_type{ TextureType::Render }
+		, m_hasDepth{ hasDepth.getBool() }
+		, m_initialized{ true } {}
+
+	bool SoftwareTexture::isInitialized() const noexcept
+	{
+		return m_initialized;
+	}
+
+	Size SoftwareTexture::getSize() const noexcept
+	{
+		return m_image.size();
+	}
+
+	TextureDesc SoftwareTexture::getDesc() const noexcept
+	{
+		return m_textureDesc;
+	}
+
+	TextureFormat SoftwareTexture::getFormat() const noexcept
+	{
+		return m_format;
+	}
+
+	bool SoftwareTexture::hasDepth() const noexcept
+	{
+		return m_hasDepth;
+	}
+
+	bool SoftwareTexture::isRenderTarget() const noexcept
+	{
+		return (m_type == TextureType::Render);
+	}
+
+	bool SoftwareTexture::fill(const ColorF& color)
+	{
+		if (m_type != TextureType::Dynamic)
+		{
+			return false;
+		}
+
+		m_image.fill(color);
+
+		return true;
+	}
+
+	bool SoftwareTexture::fillRegion(const ColorF& color, const Rect& rect)
+	{
+		if (m_type != TextureType::Dynamic)
+		{
+			return false;
+		}
+
+		if ((m_image.width() < (rect.x + rect.w))
+			|| (m_image.height() < (rect.y + rect.h)))
+		{
+			return false;
+		}
+
+		rect.overwrite(m_image, color);
+
+		return true;
+	}
+
+	bool SoftwareTexture::fill(const void* src, const uint32 stride)
+	{
+		if (m_type != TextureType::Dynamic)
+		{
+			return false;
+		}
+
+		if (not isRGBA8())
+		{
+			LOG_FAIL(U"DynamicTexture image fill for {0} is not yet implemented"_fmt(m_format.name()));
+			return false;
+		}
+
+		const size_t rowBytes = (m_image.width() * sizeof(Color));
+
+		for (int32 y = 0; y < m_image.height(); ++y)
+		{
+			std::memcpy(m_image[y], (static_cast<const Byte*>(src) + (stride * y)), rowBytes);
+		}
+
+		return true;
+	}
+
+	bool SoftwareTexture::fillRegion(const void* src, const uint32 stride, const Rect& rect)
+	{
+		if (m_type != TextureType::Dynamic)
+		{
+			return false;
+		}
+
+		if (not isRGBA8())
+		{
+			LOG_FAIL(U"DynamicTexture image fill for {0} is not yet implemented"_fmt(m_format.name()));
+			return false;
+		}
+
+		if ((rect.x < 0) || (rect.y < 0)
+			|| (m_image.width() < (rect.x + rect.w))
+			|| (m_image.height() < (rect.y + rect.h)))
+		{
+			return false;
+		}
+
+		// src は テクスチャ全体の画像で、rect の範囲だけをコピーする
+		const size_t rowBytes = (rect.w * sizeof(Color));
+
+		for (int32 y = rect.y; y < (rect.y + rect.h); ++y)
+		{
+			const Color* line = reinterpret_cast<const Color*>(static_cast<const Byte*>(src) + (stride * y));
+			std::memcpy((m_image[y] + rect.x), (line + rect.x), rowBytes);
+		}
+
+		return true;
+	}
+
+	void SoftwareTexture::clearRT(const ColorF& color)
+	{
+		if (m_type != TextureType::Render)
+		{
+			return;
+		}
+
+		m_image.fill(m_format.isSRGB() ? color.applySRGBCurve() : color);
+	}
+
+	void SoftwareTexture::readRT(Image& image) const
+	{
+		if (m_type != TextureType::Render)
+		{
+			return;
+		}
+
+		if (not isRGBA8()) // RGBA8 形式以外なら失敗
+		{
+			LOG_FAIL(U"SoftwareTexture::readRT(): Image is not supported in this format");
+			return;
+		}
+
+		image = m_image;
+	}
+
+	const Image& SoftwareTexture::getImage() const noexcept
+	{
+		return m_image;
+	}
+
+	Image& SoftwareTexture::getRenderTargetImage() noexcept
+	{
+		return m_image;
+	}
+
+	bool SoftwareTexture::isRGBA8() const noexcept
+	{
+		return ((m_format == TextureFormat::R8G8B8A8_Unorm)
+			|| (m_format == TextureFormat::R8G8B8A8_Unorm_SRGB));
+	}
+}
@@ -0,0 +1,112 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/TextureFormat.hpp>
+# include <Siv3D/TextureDesc.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/Grid.hpp>
+# include <Siv3D/PredefinedYesNo.hpp>
+
+namespace s3d
+{
+	/// @brief CPU のメモリ上に画素を保持するテクスチャ
+	/// @remark 画素は RGBA8 形式で保持します。ミップマップは保持せず、常に最も大きいレベルを使います。
+	class SoftwareTexture
+	{
+	public:
+
+		struct Dynamic {};
+		struct Render {};
+
+		SIV3D_NODISCARD_CXX20
+		SoftwareTexture(const Image& image, TextureDesc desc);
+
+		SIV3D_NODISCARD_CXX20
+		SoftwareTexture(Dynamic, const Size& size, const void* pData, uint32 stride, const TextureFormat& format, TextureDesc desc);
+
+		SIV3D_NODISCARD_CXX20
+		SoftwareTexture(Render, const Size& size, const TextureFormat& format, TextureDesc desc, HasDepth hasDepth);
+
+		SIV3D_NODISCARD_CXX20
+		SoftwareTexture(Render, const Image& image, const TextureFormat& format, TextureDesc desc, HasDepth hasDepth);
+
+		[[nodiscard]]
+		bool isInitialized() const noexcept;
+
+		[[nodiscard]]
+		Size getSize() const noexcept;
+
+		[[nodiscard]]
+		TextureDesc getDesc() const noexcept;
+
+		[[nodiscard]]
+		TextureFormat getFormat() const noexcept;
+
+		[[nodiscard]]
+		bool hasDepth() const noexcept;
+
+		[[nodiscard]]
+		bool isRenderTarget() const noexcept;
+
+		// 動的テクスチャを指定した色で塗りつぶす
+		bool fill(const ColorF& color);
+
+		bool fillRegion(const ColorF& color, const Rect& rect);
+
+		bool fill(const void* src, uint32 stride);
+
+		bool fillRegion(const void* src, uint32 stride, const Rect& rect);
+
+		// レンダーテクスチャを指定した色でクリアする
+		void clearRT(const ColorF& color);
+
+		// レンダーテクスチャの内容を Image にコピーする
+		void readRT(Image& image) const;
+
+		[[nodiscard]]
+		const Image& getImage() const noexcept;
+
+		// レンダーテクスチャの描画先
+		[[nodiscard]]
+		Image& getRenderTargetImage() noexcept;
+
+	private:
+
+		enum class TextureType : uint8
+		{
+			// 通常テクスチャ
+			Default,
+
+			// 動的テクスチャ
+			Dynamic,
+
+			// レンダーテクスチャ
+			Render,
+		};
+
+		Image m_image;
+
+		TextureFormat m_format = TextureFormat::Unknown;
+
+		TextureDesc m_textureDesc = TextureDesc::Unmipped;
+
+		TextureType m_type = TextureType::Default;
+
+		bool m_hasDepth = false;
+
+		bool m_initialized = false;
+
+		[[nodiscard]]
+		bool isRGBA8() const noexcept;
+	};
+}
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/TextureAssetData.hpp>
+# include <Siv3D/Asset/AssetReload.hpp>
 
 namespace s3d
 {
@@ -45,39 +46,12 @@ namespace s3d
 
 	bool TextureAssetData::load(const String& hint)
 	{
-		if (isUninitialized())
-		{
-			if (onLoad(*this, hint))
-			{
-				setState(AssetState::Loaded);
-				return true;
-			}
-			else
-			{
-				setState(AssetState::Failed);
-				return false;
-			}
-		}
-
-		if (isAsyncLoading())
-		{
-			wait();
-		}
-
-		return isLoaded();
+		return loadImpl(m_task, [this, &hint]() { return onLoad(*this, hint); });
 	}
 
 	void TextureAssetData::loadAsync(const String& hint)
 	{
-		if (isUninitialized())
-		{
-			setState(AssetState::AsyncLoading);
-
-			m_task = Async([this, hint = hint]()
-				{
-					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
-				});
-		}
+		loadAsyncImpl(m_task, [this, hint = hint]() { return onLoad(*this, hint); });
 	}
 
 	void TextureAssetData::wait()
@@ -90,19 +64,38 @@ namespace s3d
 
 	void TextureAssetData::release()
 	{
-		if (isUninitialized())
+		releaseImpl(m_task, [this]() { onRelease(*this); });
+	}
+
+	Array<FilePath> TextureAssetData::getSourcePaths() const
+	{
+		Array<FilePath> paths;
+
+		if (path)
 		{
-			return;
+			paths << path;
 		}
 
-		if (isAsyncLoading())
+		if (secondaryPath)
 		{
-			wait();
+			paths << secondaryPath;
 		}
 
-		onRelease(*this);
+		return paths;
+	}
 
-		setState(AssetState::Uninitialized);
+	std::function<void()> TextureAssetData::prepareReload(const String& hint)
+	{
+		auto staging = std::make_shared<TextureAssetData>();
+		staging->path = path;
+		staging->secondaryPath = secondaryPath;
+		staging->rgbColor = rgbColor;
+		staging->desc = desc;
+		staging->emoji = emoji;
+		staging->icon = icon;
+		staging->iconSize = iconSize;
+
+		return detail::PrepareReload(*this, std::move(staging), &TextureAssetData::texture, hint);
 	}
 
 	bool TextureAssetData::DefaultLoad(TextureAssetData& asset, const String&)
@@ -299,6 +299,32 @@ namespace s3d
 		return drawAtClipped(pos.x, pos.y, clipRect, diffuse);
 	}
 
+	void TextureRegion::drawInstanced(const Array<Mat3x2>& transforms, const ColorF& diffuse) const
+	{
+		SIV3D_ENGINE(Renderer2D)->addTexturedQuads(
+			texture,
+			FloatRect{ 0.0f, 0.0f, size.x, size.y },
+			uvRect,
+			transforms.data(),
+			nullptr,
+			transforms.size(),
+			diffuse.toFloat4()
+		);
+	}
+
+	void TextureRegion::drawInstanced(const Array<Mat3x2>& transforms, const Array<ColorF>& colors) const
+	{
+		SIV3D_ENGINE(Renderer2D)->addTexturedQuads(
+			texture,
+			FloatRect{ 0.0f, 0.0f, size.x, size.y },
+			uvRect,
+			transforms.data(),
+			colors.data(),
+			Min(transforms.size(), colors.size()),
+			Float4{ 1.0f, 1.0f, 1.0f, 1.0f }
+		);
+	}
+
 	TextureRegion TextureRegion::mirrored() const
 	{
 		return{ texture,
@@ -10,8 +10,11 @@
 //-----------------------------------------------
 
 # include <thread>
+# include <utility>
 # include <Siv3D/Threading.hpp>
 # include <Siv3D/Utility.hpp>
+# include <Siv3D/TaskScheduler/ITaskScheduler.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
 
 namespace s3d
 {
@@ -22,5 +25,94 @@ namespace s3d
 			static const size_t n = Max<size_t>(1, std::thread::hardware_concurrency());
 			return n;
 		}
+
+		size_t GetWorkerCount() noexcept
+		{
+			if (not Siv3DEngine::isActive())
+			{
+				return 0;
+			}
+
+			return SIV3D_ENGINE(TaskScheduler)->getWorkerCount();
+		}
+
+		void TaskGroup::wait()
+		{
+			waitPending();
+
+			std::exception_ptr exception;
+			{
+				std::lock_guard lock{ m_mutex };
+				exception = std::exchange(m_exception, nullptr);
+			}
+
+			if (exception)
+			{
+				std::rethrow_exception(exception);
+			}
+		}
+
+		void TaskGroup::submit(std::function<void()> task)
+		{
+			m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+
+			auto wrapped = [this, task = std::move(task)]()
+			{
+				std::exception_ptr exception;
+
+				try
+				{
+					task();
+				}
+				catch (...)
+				{
+					exception = std::current_exception();
+				}
+
+				// カウントが 0 になってもこのロックを保持している間は、待機側が TaskGroup を破棄しないよう
+				// waitPending() の最後でロックを取り直させる
+				std::lock_guard lock{ m_mutex };
+
+				if (exception && (not m_exception))
+				{
+					m_exception = exception;
+				}
+
+				if (m_pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					m_condition.notify_all();
+				}
+			};
+
+			// エンジンの初期化前・終了後は呼び出したスレッドで実行する
+			if (not Siv3DEngine::isActive())
+			{
+				wrapped();
+				return;
+			}
+
+			SIV3D_ENGINE(TaskScheduler)->submit(std::move(wrapped));
+		}
+
+		void TaskGroup::waitPending()
+		{
+			while (not isDone())
+			{
+				// 待機中は未実行のタスクを処理する（入れ子の並列処理でワーカーが枯渇しないように）
+				if (Siv3DEngine::isActive()
+					&& SIV3D_ENGINE(TaskScheduler)->runPendingTask())
+				{
+					continue;
+				}
+
+				std::unique_lock lock{ m_mutex };
+
+				m_condition.wait_for(lock, std::chrono::milliseconds{ 1 }, [this]() { return isDone(); });
+			}
+
+			// 最後のタスクは、カウントを 0 にした後もロックを保持したまま m_condition に通知している。
+			// ロックを取れた時点で、そのタスクが m_mutex と m_condition に触れ終えたことが保証される
+			std::lock_guard lock{ m_mutex };
+		}
 	}
 }
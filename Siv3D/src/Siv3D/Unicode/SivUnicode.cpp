@@ -13,9 +13,25 @@
 # include <Siv3D/String.hpp>
 # include <Siv3D/Unicode.hpp>
 # include "UnicodeUtility.hpp"
+# include "UnicodeTranscoder.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief 上限の文字数で確保した文字列について、実際の文字数が半分に満たない場合はメモリを解放します。
+		/// @param s 文字列
+		/// @param reservedLength 確保した文字数
+		template <class StringType>
+		static void ShrinkToFitIfSparse(StringType& s, const size_t reservedLength)
+		{
+			if ((s.size() * 2) < reservedLength)
+			{
+				s.shrink_to_fit();
+			}
+		}
+	}
+
 	namespace Unicode
 	{
 		String WidenAscii(const std::string_view asciiText)
@@ -25,36 +41,21 @@ namespace s3d
 
 		String FromUTF8(const std::string_view s)
 		{
-			String result(detail::UTF32_Length(s), '0');
+			// 1 文字は 1 バイト以上なので、入力のバイト数が文字数の上限になる
+			String result(s.size(), U'\0');
 
-			const char8* pSrc = s.data();
-			const char8* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
+			result.resize(detail::UTF8ToUTF32(s.data(), s.size(), result.data()));
 
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-				*pDst++ = detail::utf8_decode(pSrc, pSrcEnd - pSrc, offset);
-				pSrc += offset;
-			}
+			detail::ShrinkToFitIfSparse(result, s.size());
 
 			return result;
 		}
 
 		String FromUTF16(const std::u16string_view s)
 		{
-			String result(detail::UTF32_Length(s), '0');
+			String result(s.size(), U'\0');
 
-			const char16* pSrc = s.data();
-			const char16* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-				*pDst++ = detail::utf16_decode(pSrc, pSrcEnd - pSrc, offset);
-				pSrc += offset;
-			}
+			result.resize(detail::UTF16ToUTF32(s.data(), s.size(), result.data()));
 
 			return result;
 		}
@@ -82,16 +83,9 @@ namespace s3d
 
 		std::string ToUTF8(const StringView s)
 		{
-			std::string result(detail::UTF8_Length(s), '0');
+			std::string result(detail::UTF8_Length(s.data(), s.size()), '\0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF32ToUTF8(s.data(), s.size(), result.data());
 
 			return result;
 		}
@@ -139,20 +133,11 @@ namespace s3d
 
 		std::u32string UTF8ToUTF32(const std::string_view s)
 		{
-			std::u32string result(detail::UTF32_Length(s), '0');
-
-			const char8* pSrc = s.data();
-			const char8* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
+			std::u32string result(s.size(), U'\0');
 
-				*pDst++ = detail::utf8_decode(pSrc, pSrcEnd - pSrc, offset);
+			result.resize(detail::UTF8ToUTF32(s.data(), s.size(), result.data()));
 
-				pSrc += offset;
-			}
+			detail::ShrinkToFitIfSparse(result, s.size());
 
 			return result;
 		}
@@ -179,36 +164,18 @@ namespace s3d
 
 		std::u32string UTF16ToUTF32(const std::u16string_view s)
 		{
-			std::u32string result(detail::UTF32_Length(s), '0');
-
-			const char16* pSrc = s.data();
-			const char16* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
+			std::u32string result(s.size(), U'\0');
 
-				*pDst++ = detail::utf16_decode(pSrc, pSrcEnd - pSrc, offset);
-
-				pSrc += offset;
-			}
+			result.resize(detail::UTF16ToUTF32(s.data(), s.size(), result.data()));
 
 			return result;
 		}
 
 		std::string UTF32ToUTF8(const std::u32string_view s)
 		{
-			std::string result(detail::UTF8_Length(s), '0');
+			std::string result(detail::UTF8_Length(s.data(), s.size()), '\0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF32ToUTF8(s.data(), s.size(), result.data());
 
 			return result;
 		}
@@ -0,0 +1,527 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <bit>
+# include <array>
+# include <algorithm>
+# include <Siv3D/CPUInfo.hpp>
+# include <Siv3D/SIMD.hpp>
+# include <ThirdParty/miniutf/miniutf.hpp>
+# include "UnicodeTranscoder.hpp"
+# include "UnicodeUtility.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		static size_t UTF8ToUTF32_Reference(const char8* pSrc, const size_t size, char32* pDst) noexcept
+		{
+			const char8* const pSrcEnd = (pSrc + size);
+			char32* const pDstBegin = pDst;
+
+			while (pSrc != pSrcEnd)
+			{
+				int32 offset;
+				*pDst++ = utf8_decode(pSrc, (pSrcEnd - pSrc), offset);
+				pSrc += offset;
+			}
+
+			return (pDst - pDstBegin);
+		}
+
+		[[nodiscard]]
+		static size_t UTF16ToUTF32_Reference(const char16* pSrc, const size_t size, char32* pDst) noexcept
+		{
+			const char16* const pSrcEnd = (pSrc + size);
+			char32* const pDstBegin = pDst;
+
+			while (pSrc != pSrcEnd)
+			{
+				int32 offset;
+				*pDst++ = utf16_decode(pSrc, (pSrcEnd - pSrc), offset);
+				pSrc += offset;
+			}
+
+			return (pDst - pDstBegin);
+		}
+
+		static void UTF32ToUTF8_Reference(const char32* pSrc, const size_t size, char8* pDst) noexcept
+		{
+			const char32* const pSrcEnd = (pSrc + size);
+
+			while (pSrc != pSrcEnd)
+			{
+				UTF8_Encode(&pDst, *pSrc++);
+			}
+		}
+
+		[[nodiscard]]
+		static size_t UTF8_Length_Reference(const char32* pSrc, const size_t size) noexcept
+		{
+			const char32* const pSrcEnd = (pSrc + size);
+			size_t result = 0;
+
+			while (pSrc != pSrcEnd)
+			{
+				result += UTF8_Length(*pSrc++);
+			}
+
+			return result;
+		}
+
+	# if SIV3D_INTRINSIC(SSE)
+
+		/// @brief UTF-8 から UTF-32 への変換に使う表
+		struct UTF8DecodeTable
+		{
+			struct Entry
+			{
+				/// @brief 各文字のバイト数の組み合わせの番号
+				uint16 pattern = 0;
+
+				/// @brief 読み込むバイト数
+				uint8 byteLength = 0;
+
+				/// @brief 文字数
+				uint8 length = 0;
+			};
+
+			/// @brief 先頭 12 バイトの「文字の最後のバイト」のビットマスクごとの、先頭から最大 4 文字の情報
+			std::array<Entry, 4096> entries;
+
+			/// @brief 各文字のバイトを 32-bit レーンに並べるシャッフル
+			__m128i shuffles[625];
+
+			/// @brief 各レーンから UTF-8 のタグビットを取り除くマスク
+			__m128i masks[625];
+		};
+
+		/// @brief UTF-32 から UTF-8 への変換に使う表
+		struct UTF8EncodeTable
+		{
+			/// @brief 4 文字のバイト数の組み合わせごとの、各レーンのバイトを詰めるシャッフル
+			__m128i shuffles[256];
+
+			/// @brief 4 文字のバイト数の組み合わせごとの、合計バイト数
+			std::array<uint8, 256> byteLengths;
+
+			/// @brief 4-bit のレーンマスクを、レーンごとに 2-bit の値に広げる表
+			std::array<uint8, 16> spreads;
+		};
+
+		[[nodiscard]]
+		static const UTF8DecodeTable& GetUTF8DecodeTable()
+		{
+			static const UTF8DecodeTable table = []()
+			{
+				UTF8DecodeTable result;
+
+				// 最大 4 文字の、それぞれ 0 ～ 4 バイトの組み合わせ
+				for (int32 pattern = 0; pattern < 625; ++pattern)
+				{
+					alignas(16) int8 shuffle[16];
+					alignas(16) uint8 mask[16] = {};
+					std::fill(std::begin(shuffle), std::end(shuffle), int8(-1));
+
+					for (int32 lane = 0, start = 0, rest = pattern; lane < 4; ++lane, rest /= 5)
+					{
+						const int32 byteLength = (rest % 5);
+
+						// レーンの最下位バイトに文字の最後のバイトを置く
+						for (int32 k = 0; k < byteLength; ++k)
+						{
+							shuffle[lane * 4 + k] = static_cast<int8>(start + byteLength - 1 - k);
+							mask[lane * 4 + k] = ((k < (byteLength - 1)) ? 0x3F : (byteLength == 1) ? 0x7F : (0xFF >> (byteLength + 1)));
+						}
+
+						start += byteLength;
+					}
+
+					result.shuffles[pattern] = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle));
+					result.masks[pattern] = _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+				}
+
+				for (uint32 endMask = 0; endMask < 4096; ++endMask)
+				{
+					int32 pos = 0, pattern = 0, scale = 1, length = 0;
+
+					while (length < 4)
+					{
+						int32 end = pos;
+
+						while ((end < 12) && (((endMask >> end) & 1) == 0))
+						{
+							++end;
+						}
+
+						if ((end == 12) || (4 < (end - pos + 1)))
+						{
+							break;
+						}
+
+						pattern += ((end - pos + 1) * scale);
+						scale *= 5;
+						++length;
+						pos = (end + 1);
+					}
+
+					result.entries[endMask] = { static_cast<uint16>(pattern), static_cast<uint8>(pos), static_cast<uint8>(length) };
+				}
+
+				return result;
+			}();
+
+			return table;
+		}
+
+		[[nodiscard]]
+		static const UTF8EncodeTable& GetUTF8EncodeTable()
+		{
+			static const UTF8EncodeTable table = []()
+			{
+				UTF8EncodeTable result;
+
+				// 4 文字の、それぞれ 1 ～ 4 バイトの組み合わせ
+				for (uint32 index = 0; index < 256; ++index)
+				{
+					alignas(16) int8 shuffle[16];
+					std::fill(std::begin(shuffle), std::end(shuffle), int8(-1));
+					int32 pos = 0;
+
+					for (int32 lane = 0; lane < 4; ++lane)
+					{
+						const int32 byteLength = (((index >> (lane * 2)) & 0b11) + 1);
+
+						for (int32 k = 0; k < byteLength; ++k)
+						{
+							shuffle[pos++] = static_cast<int8>(lane * 4 + k);
+						}
+					}
+
+					result.shuffles[index] = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle));
+					result.byteLengths[index] = static_cast<uint8>(pos);
+				}
+
+				for (uint32 laneMask = 0; laneMask < 16; ++laneMask)
+				{
+					result.spreads[laneMask] = static_cast<uint8>((laneMask & 1) | ((laneMask & 2) << 1) | ((laneMask & 4) << 2) | ((laneMask & 8) << 3));
+				}
+
+				return result;
+			}();
+
+			return table;
+		}
+
+		/// @brief 1 ～ 4 バイトの文字が混在する UTF-8 文字列の先頭から、12 バイト以内の最大 4 文字をデコードします。
+		/// @param v UTF-8 文字列の先頭 16 バイト
+		/// @param table 表
+		/// @param pDst 出力先。4 文字分の領域が必要です。
+		/// @param length デコードした文字数の格納先
+		/// @return 読み込んだバイト数。先頭の文字に不正なバイト列が含まれる場合は 0
+		[[nodiscard]]
+		static int32 DecodeMixed_SSE4_1(const __m128i v, const UTF8DecodeTable& table, char32* pDst, int32& length) noexcept
+		{
+			// 0x80 ～ 0xBF
+			const __m128i continuations = _mm_cmplt_epi8(v, _mm_set1_epi8(-64));
+			const uint32 continuationMask = _mm_movemask_epi8(continuations);
+
+			if (continuationMask & 1)
+			{
+				return 0;
+			}
+
+			// 次のバイトが継続バイトでないバイトが、文字の最後のバイト
+			const auto& entry = table.entries[((~continuationMask) >> 1) & 0xFFF];
+
+			if (entry.length == 0)
+			{
+				return 0;
+			}
+
+			// 先頭バイトから求めた各文字のバイト数と、実際の継続バイトの並びが一致するか
+			const __m128i byteLengths = _mm_shuffle_epi8(_mm_setr_epi8(1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 2, 2, 3, 4),
+				_mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)));
+			const __m128i expectedContinuations = _mm_or_si128(_mm_or_si128(
+				_mm_cmpgt_epi8(_mm_slli_si128(byteLengths, 1), _mm_set1_epi8(1)),
+				_mm_cmpgt_epi8(_mm_slli_si128(byteLengths, 2), _mm_set1_epi8(2))),
+				_mm_cmpgt_epi8(_mm_slli_si128(byteLengths, 3), _mm_set1_epi8(3)));
+			__m128i error = _mm_xor_si128(expectedContinuations, continuations);
+
+			// 冗長な表現と範囲外のコードポイント（C0, C1, E0 + 80..9F, F0 + 80..8F, F4 + 90..BF, F5..FF）
+			const __m128i next = _mm_srli_si128(v, 1);
+			error = _mm_or_si128(error, _mm_cmpeq_epi8(_mm_and_si128(v, _mm_set1_epi8(static_cast<int8>(0xFE))), _mm_set1_epi8(static_cast<int8>(0xC0))));
+			error = _mm_or_si128(error, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<int8>(0xE0))), _mm_cmpeq_epi8(_mm_min_epu8(next, _mm_set1_epi8(static_cast<int8>(0x9F))), next)));
+			error = _mm_or_si128(error, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<int8>(0xF0))), _mm_cmpeq_epi8(_mm_min_epu8(next, _mm_set1_epi8(static_cast<int8>(0x8F))), next)));
+			error = _mm_or_si128(error, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<int8>(0xF4))), _mm_cmpeq_epi8(_mm_max_epu8(next, _mm_set1_epi8(static_cast<int8>(0x90))), next)));
+			error = _mm_or_si128(error, _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(static_cast<int8>(0xF5))), v));
+
+			// 読み込む範囲と、その次のバイト（最後の文字が途切れていないか）を調べる
+			if (_mm_movemask_epi8(error) & ((2u << entry.byteLength) - 1))
+			{
+				return 0;
+			}
+
+			const __m128i lanes = _mm_and_si128(_mm_shuffle_epi8(v, table.shuffles[entry.pattern]), table.masks[entry.pattern]);
+			const __m128i codePoints = _mm_or_si128(_mm_or_si128(
+				_mm_and_si128(lanes, _mm_set1_epi32(0x000000FF)),
+				_mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x0000FF00)), 2)), _mm_or_si128(
+				_mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x00FF0000)), 4),
+				_mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(static_cast<int32>(0xFF000000))), 6)));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), codePoints);
+			length = entry.length;
+			return entry.byteLength;
+		}
+
+		[[nodiscard]]
+		static size_t UTF8ToUTF32_SSE4_1(const char8* pSrc, const size_t size, char32* pDst) noexcept
+		{
+			const UTF8DecodeTable& table = GetUTF8DecodeTable();
+			const char8* const pSrcEnd = (pSrc + size);
+			char32* const pDstBegin = pDst;
+
+			// 出力した文字数は常に読み込んだバイト数以下であるため、残りの入力が 16 バイト以上あれば、出力先にも 16 文字以上の余裕がある。
+			// そのため、有効な文字数にかかわらずレジスタ全体を書き込み、有効な文字数だけ進める。
+			while (16 <= (pSrcEnd - pSrc))
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+
+				// 先頭から 4 文字以上続く ASCII 文字
+				if (const uint32 nonASCIIMask = _mm_movemask_epi8(v);
+					(nonASCIIMask & 0xF) == 0) SIV3D_LIKELY
+				{
+					const int32 asciiLength = std::countr_zero(nonASCIIMask | 0x10000);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 0), _mm_cvtepu8_epi32(v));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 4), _mm_cvtepu8_epi32(_mm_srli_si128(v, 4)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 8), _mm_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 12), _mm_cvtepu8_epi32(_mm_srli_si128(v, 12)));
+					pSrc += asciiLength;
+					pDst += asciiLength;
+					continue;
+				}
+
+				int32 length;
+
+				if (const int32 byteLength = DecodeMixed_SSE4_1(v, table, pDst, length))
+				{
+					pSrc += byteLength;
+					pDst += length;
+					continue;
+				}
+
+				// 不正なバイト列
+				int32 offset;
+				*pDst++ = utf8_decode(pSrc, (pSrcEnd - pSrc), offset);
+				pSrc += offset;
+			}
+
+			return ((pDst - pDstBegin) + UTF8ToUTF32_Reference(pSrc, (pSrcEnd - pSrc), pDst));
+		}
+
+		[[nodiscard]]
+		static size_t UTF16ToUTF32_SSE4_1(const char16* pSrc, const size_t size, char32* pDst) noexcept
+		{
+			const char16* const pSrcEnd = (pSrc + size);
+			char32* const pDstBegin = pDst;
+
+			// 出力した文字数は常に読み込んだ要素数以下であるため、残りの入力が 8 要素以上あれば、出力先にも 8 文字以上の余裕がある
+			while (8 <= (pSrcEnd - pSrc))
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+				const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(static_cast<int16>(0xF800))), _mm_set1_epi16(static_cast<int16>(0xD800)));
+
+				// 先頭から続くサロゲート以外の文字
+				if (const uint32 surrogateMask = _mm_movemask_epi8(surrogates);
+					(surrogateMask & 0b11) == 0)
+				{
+					const int32 bmpLength = ((surrogateMask == 0) ? 8 : (std::countr_zero(surrogateMask) / 2));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 0), _mm_cvtepu16_epi32(v));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 4), _mm_cvtepu16_epi32(_mm_srli_si128(v, 8)));
+					pSrc += bmpLength;
+					pDst += bmpLength;
+					continue;
+				}
+
+				int32 offset;
+				*pDst++ = utf16_decode(pSrc, (pSrcEnd - pSrc), offset);
+				pSrc += offset;
+			}
+
+			return ((pDst - pDstBegin) + UTF16ToUTF32_Reference(pSrc, (pSrcEnd - pSrc), pDst));
+		}
+
+		static void UTF32ToUTF8_SSE4_1(const char32* pSrc, const size_t size, char8* pDst) noexcept
+		{
+			const UTF8EncodeTable& table = GetUTF8EncodeTable();
+			const char32* const pSrcEnd = (pSrc + size);
+
+			// 1 文字は 1 バイト以上になるため、残りの入力が 16 文字以上あれば、出力先にも 16 バイト以上の余裕がある。
+			// そのため、有効なバイト数にかかわらずレジスタ全体を書き込み、有効なバイト数だけ進める。
+			while (16 <= (pSrcEnd - pSrc))
+			{
+				const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 0));
+				const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 4));
+				const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 8));
+				const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 12));
+
+				// ASCII 文字 16 個
+				if (_mm_testz_si128(_mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3)), _mm_set1_epi32(~0x7F)))
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_packus_epi16(_mm_packus_epi32(v0, v1), _mm_packus_epi32(v2, v3)));
+					pSrc += 16;
+					pDst += 16;
+					continue;
+				}
+
+				const __m128i atLeast2 = _mm_cmpeq_epi32(_mm_max_epu32(v0, _mm_set1_epi32(0x80)), v0);
+				const __m128i atLeast3 = _mm_cmpeq_epi32(_mm_max_epu32(v0, _mm_set1_epi32(0x800)), v0);
+				const __m128i atLeast4 = _mm_cmpeq_epi32(_mm_max_epu32(v0, _mm_set1_epi32(0x10000)), v0);
+				const __m128i outOfRange = _mm_cmpeq_epi32(_mm_max_epu32(v0, _mm_set1_epi32(0x110000)), v0);
+
+				// 範囲外のコードポイント
+				if (not _mm_testz_si128(outOfRange, outOfRange))
+				{
+					for (int32 i = 0; i < 4; ++i)
+					{
+						UTF8_Encode(&pDst, *pSrc++);
+					}
+
+					continue;
+				}
+
+				// 各レーンの下位バイトから順に UTF-8 のバイト列を作る
+				const __m128i low6 = _mm_or_si128(_mm_and_si128(v0, _mm_set1_epi32(0x3F)), _mm_set1_epi32(0x80));
+				const __m128i middle6 = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v0, 6), _mm_set1_epi32(0x3F)), _mm_set1_epi32(0x80));
+				const __m128i high6 = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v0, 12), _mm_set1_epi32(0x3F)), _mm_set1_epi32(0x80));
+				const __m128i encoded2 = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(v0, 6), _mm_set1_epi32(0xC0)), _mm_slli_epi32(low6, 8));
+				const __m128i encoded3 = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(v0, 12), _mm_set1_epi32(0xE0)),
+					_mm_or_si128(_mm_slli_epi32(middle6, 8), _mm_slli_epi32(low6, 16)));
+				const __m128i encoded4 = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(v0, 18), _mm_set1_epi32(0xF0)),
+					_mm_or_si128(_mm_slli_epi32(high6, 8), _mm_or_si128(_mm_slli_epi32(middle6, 16), _mm_slli_epi32(low6, 24))));
+
+				__m128i encoded = _mm_blendv_epi8(v0, encoded2, atLeast2);
+				encoded = _mm_blendv_epi8(encoded, encoded3, atLeast3);
+				encoded = _mm_blendv_epi8(encoded, encoded4, atLeast4);
+
+				// 各レーンのバイト数（1 ～ 4）から表の番号を求め、バイト列を詰める
+				const uint32 index = (table.spreads[_mm_movemask_ps(_mm_castsi128_ps(atLeast2))]
+					+ table.spreads[_mm_movemask_ps(_mm_castsi128_ps(atLeast3))]
+					+ table.spreads[_mm_movemask_ps(_mm_castsi128_ps(atLeast4))]);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_shuffle_epi8(encoded, table.shuffles[index]));
+				pSrc += 4;
+				pDst += table.byteLengths[index];
+			}
+
+			UTF32ToUTF8_Reference(pSrc, (pSrcEnd - pSrc), pDst);
+		}
+
+		[[nodiscard]]
+		static size_t UTF8_Length_SSE4_1(const char32* pSrc, const size_t size) noexcept
+		{
+			const char32* const pSrcEnd = (pSrc + (size & ~size_t{ 3 }));
+			const __m128i k0x80 = _mm_set1_epi32(0x80);
+			const __m128i k0x800 = _mm_set1_epi32(0x800);
+			const __m128i k0x10000 = _mm_set1_epi32(0x10000);
+			const __m128i k0x110000 = _mm_set1_epi32(0x110000);
+
+			// 各レーンの値は 1 回あたり最大 3 増えるため、オーバーフローする前に合計する
+			constexpr size_t BlockSize = (1 << 28);
+
+			size_t result = size;
+
+			while (pSrc != pSrcEnd)
+			{
+				const char32* const pBlockEnd = (pSrc + Min<size_t>((pSrcEnd - pSrc), (BlockSize * 4)));
+				__m128i extra = _mm_setzero_si128();
+
+				for (; pSrc != pBlockEnd; pSrc += 4)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+
+					// 比較結果は真のとき -1 になるので、引くと 1 加算される
+					extra = _mm_sub_epi32(extra, _mm_cmpeq_epi32(_mm_max_epu32(v, k0x80), v));
+					extra = _mm_sub_epi32(extra, _mm_cmpeq_epi32(_mm_max_epu32(v, k0x800), v));
+					extra = _mm_sub_epi32(extra, _mm_cmpeq_epi32(_mm_max_epu32(v, k0x10000), v));
+
+					// 範囲外のコードポイントは U+FFFD（3 バイト）になる
+					extra = _mm_add_epi32(extra, _mm_cmpeq_epi32(_mm_max_epu32(v, k0x110000), v));
+				}
+
+				alignas(16) uint32 lanes[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(lanes), extra);
+				result += (size_t{ lanes[0] } + lanes[1] + lanes[2] + lanes[3]);
+			}
+
+			return (result - (size & 3) + UTF8_Length_Reference(pSrc, (size & 3)));
+		}
+
+	# endif
+
+		size_t UTF8ToUTF32(const char8* pSrc, const size_t size, char32* pDst) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return UTF8ToUTF32_SSE4_1(pSrc, size, pDst);
+			}
+
+		# endif
+
+			return UTF8ToUTF32_Reference(pSrc, size, pDst);
+		}
+
+		size_t UTF16ToUTF32(const char16* pSrc, const size_t size, char32* pDst) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return UTF16ToUTF32_SSE4_1(pSrc, size, pDst);
+			}
+
+		# endif
+
+			return UTF16ToUTF32_Reference(pSrc, size, pDst);
+		}
+
+		void UTF32ToUTF8(const char32* pSrc, const size_t size, char8* pDst) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return UTF32ToUTF8_SSE4_1(pSrc, size, pDst);
+			}
+
+		# endif
+
+			UTF32ToUTF8_Reference(pSrc, size, pDst);
+		}
+
+		size_t UTF8_Length(const char32* pSrc, const size_t size) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			if (GetCPUInfo().features.sse4_1)
+			{
+				return UTF8_Length_SSE4_1(pSrc, size);
+			}
+
+		# endif
+
+			return UTF8_Length_Reference(pSrc, size);
+		}
+	}
+}
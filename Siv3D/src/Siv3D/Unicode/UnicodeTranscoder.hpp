@@ -0,0 +1,50 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief UTF-8 文字列を UTF-32 文字列に変換します。
+		/// @param pSrc UTF-8 文字列の先頭ポインタ
+		/// @param size UTF-8 文字列のバイト数
+		/// @param pDst 出力先。size 要素以上の領域が必要です。
+		/// @return 出力した文字数
+		/// @remark 不正なバイト列は 1 バイトごとに U+FFFD に置き換えます。
+		[[nodiscard]]
+		size_t UTF8ToUTF32(const char8* pSrc, size_t size, char32* pDst) noexcept;
+
+		/// @brief UTF-16 文字列を UTF-32 文字列に変換します。
+		/// @param pSrc UTF-16 文字列の先頭ポインタ
+		/// @param size UTF-16 文字列の要素数
+		/// @param pDst 出力先。size 要素以上の領域が必要です。
+		/// @return 出力した文字数
+		/// @remark 対になっていないサロゲートは U+FFFD に置き換えます。
+		[[nodiscard]]
+		size_t UTF16ToUTF32(const char16* pSrc, size_t size, char32* pDst) noexcept;
+
+		/// @brief UTF-32 文字列を UTF-8 文字列に変換します。
+		/// @param pSrc UTF-32 文字列の先頭ポインタ
+		/// @param size UTF-32 文字列の文字数
+		/// @param pDst 出力先。UTF8_Length() バイトの領域が必要です。
+		void UTF32ToUTF8(const char32* pSrc, size_t size, char8* pDst) noexcept;
+
+		/// @brief UTF-32 文字列を UTF-8 に変換したときのバイト数を返します。
+		/// @param pSrc UTF-32 文字列の先頭ポインタ
+		/// @param size UTF-32 文字列の文字数
+		/// @return UTF-8 に変換したときのバイト数
+		[[nodiscard]]
+		size_t UTF8_Length(const char32* pSrc, size_t size) noexcept;
+	}
+}
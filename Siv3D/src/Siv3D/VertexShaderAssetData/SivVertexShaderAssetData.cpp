@@ -11,6 +11,7 @@
 
 # include <Siv3D/VertexShaderAssetData.hpp>
 # include <Siv3D/System.hpp>
+# include <Siv3D/Asset/AssetReload.hpp>
 
 namespace s3d
 {
@@ -55,39 +56,12 @@ namespace s3d
 
 	bool VertexShaderAssetData::load(const String& hint)
 	{
-		if (isUninitialized())
-		{
-			if (onLoad(*this, hint))
-			{
-				setState(AssetState::Loaded);
-				return true;
-			}
-			else
-			{
-				setState(AssetState::Failed);
-				return false;
-			}
-		}
-
-		if (isAsyncLoading())
-		{
-			wait();
-		}
-
-		return isLoaded();
+		return loadImpl(m_task, [this, &hint]() { return onLoad(*this, hint); });
 	}
 
 	void VertexShaderAssetData::loadAsync(const String& hint)
 	{
-		if (isUninitialized())
-		{
-			setState(AssetState::AsyncLoading);
-
-			m_task = Async([this, hint = hint]()
-				{
-					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
-				});
-		}
+		loadAsyncImpl(m_task, [this, hint = hint]() { return onLoad(*this, hint); });
 	}
 
 	void VertexShaderAssetData::wait()
@@ -100,19 +74,27 @@ namespace s3d
 
 	void VertexShaderAssetData::release()
 	{
-		if (isUninitialized())
-		{
-			return;
-		}
+		releaseImpl(m_task, [this]() { onRelease(*this); });
+	}
 
-		if (isAsyncLoading())
+	Array<FilePath> VertexShaderAssetData::getSourcePaths() const
+	{
+		if (not path)
 		{
-			wait();
+			return{};
 		}
 
-		onRelease(*this);
+		return{ path };
+	}
+
+	std::function<void()> VertexShaderAssetData::prepareReload(const String& hint)
+	{
+		auto staging = std::make_shared<VertexShaderAssetData>();
+		staging->path = path;
+		staging->entryPoint = entryPoint;
+		staging->bindings = bindings;
 
-		setState(AssetState::Uninitialized);
+		return detail::PrepareReload(*this, std::move(staging), &VertexShaderAssetData::vs, hint);
 	}
 
 	bool VertexShaderAssetData::DefaultLoad(VertexShaderAssetData& asset, const String&)
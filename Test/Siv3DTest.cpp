@@ -17,6 +17,7 @@
 # include <unordered_map>
 
 // SIV3D_SET(EngineOption::Renderer::Headless) // Force non-graphical mode
+// SIV3D_SET(EngineOption::HeadlessRenderer::Software) // Draw 2D graphics on the CPU in non-graphical mode
 
 void Main()
 {
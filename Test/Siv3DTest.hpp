@@ -24,6 +24,25 @@ std::tuple<std::string, std::string> CaptureStandardOutput(const std::function<v
 
 void AssertImagesAreEqual(const Image& target, const Image& checked);
 
+// predicate が true を返すまで待つ。timeout までに満たされなければ false を返す
+template <class Predicate>
+bool WaitUntil(Predicate predicate, const Duration& timeout = 10s)
+{
+	const Stopwatch stopwatch{ StartImmediately::Yes };
+
+	while (not predicate())
+	{
+		if (timeout <= stopwatch.elapsed())
+		{
+			return false;
+		}
+
+		System::Sleep(1ms);
+	}
+
+	return true;
+}
+
 class EngineErrorMatcher : public Catch::MatcherBase<s3d::EngineError> {    
     s3d::String description;
 public:
@@ -0,0 +1,214 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <thread>
+# include <Siv3D/AssetHandleManager/AssetHandleManager.hpp>
+
+namespace
+{
+	struct TestAssetTag {};
+
+	using TestAssetID = AssetID<TestAssetTag>;
+
+	struct TestAssetData
+	{
+		int32 value = 0;
+
+		explicit TestAssetData(const int32 _value)
+			: value{ _value } {}
+	};
+
+	using TestAssetManager = AssetHandleManager<TestAssetID, TestAssetData>;
+}
+
+TEST_CASE("AssetHandleManager")
+{
+	SECTION("add() and operator[]")
+	{
+		TestAssetManager manager{ U"TestAsset" };
+		manager.setNullData(std::make_unique<TestAssetData>(-1));
+
+		const TestAssetID a = manager.add(std::make_unique<TestAssetData>(10));
+		const TestAssetID b = manager.add(std::make_unique<TestAssetData>(20));
+
+		REQUIRE(not a.isNull());
+		REQUIRE(not b.isNull());
+		REQUIRE(a != b);
+		REQUIRE(manager.size() == 3);
+		REQUIRE(manager[TestAssetID::NullAsset()]->value == -1);
+		REQUIRE(manager[a]->value == 10);
+		REQUIRE(manager[b]->value == 20);
+		REQUIRE(manager[TestAssetID::InvalidValue()] == nullptr);
+
+		manager.destroy();
+
+		REQUIRE(manager.size() == 0);
+		REQUIRE(manager[a] == nullptr);
+	}
+
+	SECTION("erase() invalidates the old ID")
+	{
+		TestAssetManager manager{ U"TestAsset" };
+		manager.setNullData(std::make_unique<TestAssetData>(-1));
+
+		const TestAssetID a = manager.add(std::make_unique<TestAssetData>(10));
+		manager.erase(a);
+
+		REQUIRE(manager.size() == 1);
+		REQUIRE(manager[a] == nullptr);
+
+		// 解放されたスロットは再利用されるが、世代が異なるため ID は一致しない
+		const TestAssetID b = manager.add(std::make_unique<TestAssetData>(20));
+
+		REQUIRE(a != b);
+		REQUIRE(manager[a] == nullptr);
+		REQUIRE(manager[b]->value == 20);
+	}
+
+	SECTION("many assets")
+	{
+		TestAssetManager manager{ U"TestAsset" };
+		manager.setNullData(std::make_unique<TestAssetData>(-1));
+
+		Array<TestAssetID> ids;
+
+		for (int32 i = 0; i < 10000; ++i)
+		{
+			ids << manager.add(std::make_unique<TestAssetData>(i));
+		}
+
+		for (int32 i = 0; i < 10000; i += 2)
+		{
+			manager.erase(ids[i]);
+		}
+
+		REQUIRE(manager.size() == (1 + 5000));
+
+		for (int32 i = 0; i < 10000; ++i)
+		{
+			if (i % 2)
+			{
+				REQUIRE(manager[ids[i]]->value == i);
+			}
+			else
+			{
+				REQUIRE(manager[ids[i]] == nullptr);
+			}
+		}
+
+		int64 sum = 0;
+		size_t count = 0;
+
+		for (auto& data : manager)
+		{
+			REQUIRE(manager[data.first] == data.second);
+			sum += data.second->value;
+			++count;
+		}
+
+		REQUIRE(count == manager.size());
+		REQUIRE(sum == (-1 + (5000LL * 5000LL)));
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+namespace
+{
+	/// @brief 比較用: ミューテックスと HashTable によるアセット管理
+	class MutexHashTableManager
+	{
+	public:
+
+		TestAssetID add(std::unique_ptr<TestAssetData>&& data)
+		{
+			std::lock_guard lock{ m_mutex };
+			const TestAssetID id{ ++m_idCount };
+			m_data.emplace(id, std::move(data));
+			return id;
+		}
+
+		TestAssetData* operator [](const TestAssetID id)
+		{
+			std::lock_guard lock{ m_mutex };
+			return m_data[id].get();
+		}
+
+	private:
+
+		HashTable<TestAssetID, std::unique_ptr<TestAssetData>> m_data;
+
+		TestAssetID::value_type m_idCount = 0;
+
+		std::mutex m_mutex;
+	};
+
+	template <class Manager>
+	int64 ContendedLookups(Manager& manager, const Array<TestAssetID>& ids, const size_t numThreads, const size_t lookupsPerThread)
+	{
+		std::atomic<int64> total = 0;
+		Array<std::thread> threads;
+
+		for (size_t t = 0; t < numThreads; ++t)
+		{
+			threads.emplace_back([&, t]()
+			{
+				int64 sum = 0;
+
+				for (size_t i = 0; i < lookupsPerThread; ++i)
+				{
+					sum += manager[ids[(i * 7 + t) % ids.size()]]->value;
+				}
+
+				total += sum;
+			});
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		return total;
+	}
+}
+
+TEST_CASE("AssetHandleManager : benchmark")
+{
+	constexpr size_t NumAssets = 4096;
+	constexpr size_t NumThreads = 8;
+	constexpr size_t LookupsPerThread = 200'000;
+
+	TestAssetManager slotMap{ U"TestAsset" };
+	MutexHashTableManager hashTable;
+	Array<TestAssetID> slotMapIDs, hashTableIDs;
+
+	for (size_t i = 0; i < NumAssets; ++i)
+	{
+		slotMapIDs << slotMap.add(std::make_unique<TestAssetData>(static_cast<int32>(i)));
+		hashTableIDs << hashTable.add(std::make_unique<TestAssetData>(static_cast<int32>(i)));
+	}
+
+	REQUIRE(ContendedLookups(slotMap, slotMapIDs, NumThreads, 1000) == ContendedLookups(hashTable, hashTableIDs, NumThreads, 1000));
+
+	BENCHMARK("std::mutex + HashTable | 8 threads x 200K lookups")
+	{
+		return ContendedLookups(hashTable, hashTableIDs, NumThreads, LookupsPerThread);
+	};
+
+	BENCHMARK("AssetHandleManager | 8 threads x 200K lookups")
+	{
+		return ContendedLookups(slotMap, slotMapIDs, NumThreads, LookupsPerThread);
+	};
+}
+
+# endif
@@ -0,0 +1,603 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <mutex>
+# include <future>
+# include <thread>
+# include <Siv3D/Asset/IAsset.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+// スレッドを使えない環境では、非同期ロードが要求した時点で実行される
+# if not (SIV3D_PLATFORM(WEB) && !defined(__EMSCRIPTEN_PTHREADS__))
+
+namespace
+{
+	/// @brief ロード処理を差し替えられるテスト用のアセット
+	class TestAsset final : public IAsset
+	{
+	public:
+
+		explicit TestAsset(std::function<bool()> body = []() { return true; }, const int32 priority = 0)
+			: m_body{ std::move(body) }
+		{
+			setLoadPriority(priority);
+		}
+
+		~TestAsset() override
+		{
+			release();
+		}
+
+		bool load(const String& = {}) override
+		{
+			return loadImpl(m_task, [this]() { return onLoad(); });
+		}
+
+		void loadAsync(const String& = {}) override
+		{
+			loadAsyncImpl(m_task, [this]() { return onLoad(); });
+		}
+
+		void wait() override
+		{
+			if (m_task.isValid())
+			{
+				m_task.get();
+			}
+		}
+
+		void release() override
+		{
+			releaseImpl(m_task, [this]() { ++m_releaseCount; });
+		}
+
+		[[nodiscard]]
+		int32 loadCount() const noexcept
+		{
+			return m_loadCount;
+		}
+
+		[[nodiscard]]
+		int32 releaseCount() const noexcept
+		{
+			return m_releaseCount;
+		}
+
+		/// @remark load() または wait() の後に呼ぶ必要があります。
+		[[nodiscard]]
+		std::thread::id loadThreadID() const noexcept
+		{
+			return m_loadThreadID;
+		}
+
+	private:
+
+		std::function<bool()> m_body;
+
+		AsyncTask<void> m_task;
+
+		std::atomic<int32> m_loadCount = 0;
+
+		std::atomic<int32> m_releaseCount = 0;
+
+		std::thread::id m_loadThreadID;
+
+		bool onLoad()
+		{
+			m_loadThreadID = std::this_thread::get_id();
+			++m_loadCount;
+			return m_body();
+		}
+	};
+
+	/// @brief open() されるまでロード処理を終えず、非同期ロードの枠を 1 つ占有するアセット
+	class BlockingAsset
+	{
+	public:
+
+		BlockingAsset()
+		{
+			m_asset.loadAsync();
+		}
+
+		~BlockingAsset()
+		{
+			open();
+			m_asset.wait();
+		}
+
+		void open()
+		{
+			if (not m_opened)
+			{
+				m_opened = true;
+				m_promise.set_value();
+			}
+		}
+
+		[[nodiscard]]
+		TestAsset& asset() noexcept
+		{
+			return m_asset;
+		}
+
+	private:
+
+		std::promise<void> m_promise;
+
+		std::shared_future<void> m_future = m_promise.get_future().share();
+
+		bool m_opened = false;
+
+		TestAsset m_asset{ [future = m_future]() { future.wait(); return true; } };
+	};
+
+	/// @brief 非同期ロードの同時実行数を一時的に変更する
+	class ScopedMaxConcurrency
+	{
+	public:
+
+		explicit ScopedMaxConcurrency(const size_t maxConcurrency)
+			: m_previous{ AssetLoader::GetMaxConcurrency() }
+		{
+			AssetLoader::SetMaxConcurrency(maxConcurrency);
+			AssetLoader::ResetProgress();
+		}
+
+		~ScopedMaxConcurrency()
+		{
+			AssetLoader::SetMaxConcurrency(m_previous);
+			AssetLoader::ResetProgress();
+		}
+
+	private:
+
+		size_t m_previous;
+	};
+
+	[[nodiscard]]
+	bool WaitUntilLoading(const size_t loading)
+	{
+		return WaitUntil([=]() { return (AssetLoader::GetProgress().loading == loading); });
+	}
+
+	/// @brief 再ロードの回数を数えるテスト用のアセット
+	class ReloadAsset final : public IAsset
+	{
+	public:
+
+		ReloadAsset(const FilePathView path, std::shared_future<void> gate)
+			: m_path{ path }
+			, m_gate{ std::move(gate) } {}
+
+		~ReloadAsset() override
+		{
+			release();
+		}
+
+		bool load(const String& = {}) override
+		{
+			return loadImpl(m_task, []() { return true; });
+		}
+
+		void loadAsync(const String& = {}) override
+		{
+			loadAsyncImpl(m_task, []() { return true; });
+		}
+
+		void wait() override
+		{
+			if (m_task.isValid())
+			{
+				m_task.get();
+			}
+		}
+
+		void release() override
+		{
+			releaseImpl(m_task, [this]() { ++m_releaseCount; });
+		}
+
+		Array<FilePath> getSourcePaths() const override
+		{
+			return{ m_path };
+		}
+
+		/// @remark gate が準備できるまで、再ロードを終えません。
+		std::function<void()> prepareReload(const String&) override
+		{
+			++m_reloadCount;
+			m_gate.wait();
+			return [this]() { ++m_commitCount; };
+		}
+
+		[[nodiscard]]
+		int32 reloadCount() const noexcept
+		{
+			return m_reloadCount;
+		}
+
+		[[nodiscard]]
+		int32 commitCount() const noexcept
+		{
+			return m_commitCount;
+		}
+
+		[[nodiscard]]
+		int32 releaseCount() const noexcept
+		{
+			return m_releaseCount;
+		}
+
+	private:
+
+		FilePath m_path;
+
+		std::shared_future<void> m_gate;
+
+		AsyncTask<void> m_task;
+
+		std::atomic<int32> m_reloadCount = 0;
+
+		std::atomic<int32> m_commitCount = 0;
+
+		std::atomic<int32> m_releaseCount = 0;
+	};
+
+	void Touch(const FilePathView path)
+	{
+		TextWriter{ path }.writeln(Time::GetMicrosec());
+	}
+
+	/// @brief ReloadAsset を登録し、ホットリロードを有効にする
+	/// @remark 再ロードは open() されるまで完了しません。
+	class HotReloadFixture
+	{
+	public:
+
+		static constexpr AssetType Type = AssetType::Texture;
+
+		static constexpr StringView Name = U"Siv3DTest.HotReload";
+
+		HotReloadFixture()
+		{
+			FileSystem::CreateDirectories(Directory);
+			Touch(path());
+
+			auto asset = std::make_unique<ReloadAsset>(path(), m_future);
+			m_asset = asset.get();
+
+			SIV3D_ENGINE(Asset)->registerAsset(Type, Name, std::move(asset));
+			SIV3D_ENGINE(Asset)->load(Type, Name, U"");
+			AssetLoader::EnableHotReload(Directory);
+		}
+
+		~HotReloadFixture()
+		{
+			open();
+			AssetLoader::DisableHotReload();
+			SIV3D_ENGINE(Asset)->unregister(Type, Name);
+			FileSystem::Remove(Directory);
+		}
+
+		void open()
+		{
+			if (not m_opened.exchange(true))
+			{
+				m_promise.set_value();
+			}
+		}
+
+		[[nodiscard]]
+		ReloadAsset& asset() noexcept
+		{
+			return *m_asset;
+		}
+
+		[[nodiscard]]
+		FilePath path() const
+		{
+			return (Directory + U"asset.txt");
+		}
+
+		/// @brief predicate が true を返すまで、アセットの更新を続けます。
+		template <class Predicate>
+		static bool UpdateUntil(Predicate predicate, const Duration& timeout = 10s)
+		{
+			return WaitUntil([&]() { SIV3D_ENGINE(Asset)->update(); return predicate(); }, timeout);
+		}
+
+		/// @brief 指定した時間、アセットの更新を続けます。
+		static void UpdateFor(const Duration& duration)
+		{
+			UpdateUntil([]() { return false; }, duration);
+		}
+
+	private:
+
+		static constexpr StringView Directory = U"test/hotreload/";
+
+		std::promise<void> m_promise;
+
+		std::shared_future<void> m_future = m_promise.get_future().share();
+
+		std::atomic<bool> m_opened = false;
+
+		ReloadAsset* m_asset = nullptr;
+	};
+}
+
+TEST_CASE("AssetLoader : priority ordering")
+{
+	const ScopedMaxConcurrency maxConcurrency{ 1 };
+	BlockingAsset blocker;
+	REQUIRE(WaitUntilLoading(1));
+
+	std::mutex mutex;
+	Array<int32> order;
+	auto record = [&](const int32 id)
+	{
+		return [&, id]()
+		{
+			std::lock_guard lock{ mutex };
+			order << id;
+			return true;
+		};
+	};
+
+	TestAsset a{ record(0), 0 };
+	TestAsset b{ record(1), 5 };
+	TestAsset c{ record(2), 1 };
+	TestAsset d{ record(3), 5 };
+
+	for (auto* asset : { &a, &b, &c, &d })
+	{
+		asset->loadAsync();
+	}
+
+	REQUIRE(AssetLoader::GetProgress().queued == 4);
+
+	blocker.open();
+
+	for (auto* asset : { &a, &b, &c, &d })
+	{
+		asset->wait();
+		REQUIRE(asset->getState() == AssetState::Loaded);
+	}
+
+	// 優先度の高い順、同じ優先度では要求した順にロードされる
+	const Array<int32> expected = { 1, 3, 2, 0 };
+	REQUIRE(order == expected);
+}
+
+TEST_CASE("AssetLoader : load() cancels a queued request")
+{
+	const ScopedMaxConcurrency maxConcurrency{ 1 };
+	BlockingAsset blocker;
+	REQUIRE(WaitUntilLoading(1));
+
+	TestAsset asset;
+	asset.loadAsync();
+	REQUIRE(asset.isAsyncLoading());
+
+	// ロード待ちの要求を取り消し、呼び出したスレッドでロードする
+	REQUIRE(asset.load());
+	REQUIRE(asset.getState() == AssetState::Loaded);
+	REQUIRE(asset.loadCount() == 1);
+	REQUIRE(asset.loadThreadID() == std::this_thread::get_id());
+
+	const AssetLoadProgress progress = AssetLoader::GetProgress();
+	REQUIRE(progress.queued == 0);
+	REQUIRE(progress.canceled == 1);
+}
+
+TEST_CASE("AssetLoader : release() cancels a queued request")
+{
+	const ScopedMaxConcurrency maxConcurrency{ 1 };
+	BlockingAsset blocker;
+	REQUIRE(WaitUntilLoading(1));
+
+	TestAsset asset;
+	asset.loadAsync();
+	asset.release();
+
+	REQUIRE(asset.getState() == AssetState::Uninitialized);
+	REQUIRE(asset.loadCount() == 0);
+	REQUIRE(asset.releaseCount() == 0);
+	REQUIRE(AssetLoader::GetProgress().canceled == 1);
+
+	// 取り消された後も再びロードできる
+	blocker.open();
+	asset.loadAsync();
+	asset.wait();
+	REQUIRE(asset.getState() == AssetState::Loaded);
+	REQUIRE(asset.loadCount() == 1);
+
+	asset.release();
+	REQUIRE(asset.getState() == AssetState::Uninitialized);
+	REQUIRE(asset.releaseCount() == 1);
+}
+
+TEST_CASE("AssetLoader : CancelAll()")
+{
+	const ScopedMaxConcurrency maxConcurrency{ 1 };
+	BlockingAsset blocker;
+	REQUIRE(WaitUntilLoading(1));
+
+	Array<std::unique_ptr<TestAsset>> assets;
+
+	for (int32 i = 0; i < 3; ++i)
+	{
+		assets << std::make_unique<TestAsset>();
+		assets.back()->loadAsync();
+	}
+
+	AssetLoader::CancelAll();
+
+	for (const auto& asset : assets)
+	{
+		REQUIRE(asset->getState() == AssetState::Uninitialized);
+		REQUIRE(asset->loadCount() == 0);
+	}
+
+	// 実行中のロードは取り消されない
+	const AssetLoadProgress progress = AssetLoader::GetProgress();
+	REQUIRE(progress.queued == 0);
+	REQUIRE(progress.loading == 1);
+	REQUIRE(progress.canceled == 3);
+	REQUIRE(blocker.asset().isAsyncLoading());
+
+	blocker.open();
+	blocker.asset().wait();
+	REQUIRE(blocker.asset().getState() == AssetState::Loaded);
+}
+
+TEST_CASE("AssetLoader : GetProgress()")
+{
+	const ScopedMaxConcurrency maxConcurrency{ 1 };
+	BlockingAsset blocker;
+	REQUIRE(WaitUntilLoading(1));
+
+	TestAsset succeeded{ []() { return true; } };
+	TestAsset failed{ []() { return false; } };
+	succeeded.loadAsync();
+	failed.loadAsync();
+
+	{
+		const AssetLoadProgress progress = AssetLoader::GetProgress();
+		REQUIRE(progress.queued == 2);
+		REQUIRE(progress.loading == 1);
+		REQUIRE(progress.succeeded == 0);
+		REQUIRE(progress.failed == 0);
+		REQUIRE(not progress.isDone());
+		REQUIRE(progress.progress() == 0.0);
+	}
+
+	blocker.open();
+	blocker.asset().wait();
+	succeeded.wait();
+	failed.wait();
+
+	REQUIRE(succeeded.getState() == AssetState::Loaded);
+	REQUIRE(failed.getState() == AssetState::Failed);
+
+	REQUIRE(WaitUntil([]() { return AssetLoader::GetProgress().isDone(); }));
+
+	{
+		const AssetLoadProgress progress = AssetLoader::GetProgress();
+		REQUIRE(progress.succeeded == 2);
+		REQUIRE(progress.failed == 1);
+		REQUIRE(progress.canceled == 0);
+		REQUIRE(progress.progress() == 1.0);
+	}
+
+	AssetLoader::ResetProgress();
+	REQUIRE(AssetLoader::GetProgress().succeeded == 0);
+}
+
+TEST_CASE("AssetLoader : SetMaxConcurrency() lowers the limit")
+{
+	const ScopedMaxConcurrency maxConcurrency{ 4 };
+
+	{
+		Array<std::unique_ptr<BlockingAsset>> blockers;
+
+		for (int32 i = 0; i < 4; ++i)
+		{
+			blockers << std::make_unique<BlockingAsset>();
+		}
+
+		REQUIRE(WaitUntilLoading(4));
+
+		// 実行中のロードを終えたスレッドから終了する
+		AssetLoader::SetMaxConcurrency(1);
+	}
+
+	std::atomic<int32> running = 0;
+	std::atomic<int32> maxRunning = 0;
+	Array<std::unique_ptr<TestAsset>> assets;
+
+	for (int32 i = 0; i < 8; ++i)
+	{
+		assets << std::make_unique<TestAsset>([&]()
+			{
+				const int32 current = ++running;
+				maxRunning = Max<int32>(maxRunning, current);
+				System::Sleep(2ms);
+				--running;
+				return true;
+			});
+		assets.back()->loadAsync();
+	}
+
+	for (const auto& asset : assets)
+	{
+		asset->wait();
+		REQUIRE(asset->getState() == AssetState::Loaded);
+	}
+
+	REQUIRE(maxRunning == 1);
+}
+
+TEST_CASE("AssetLoader : a change during a hot reload triggers exactly one more reload")
+{
+	HotReloadFixture fixture;
+	ReloadAsset& asset = fixture.asset();
+	REQUIRE(asset.getState() == AssetState::Loaded);
+
+	Touch(fixture.path());
+	REQUIRE(HotReloadFixture::UpdateUntil([&]() { return (asset.reloadCount() == 1); }));
+
+	// 再ロード中に 2 回変更する
+	Touch(fixture.path());
+	HotReloadFixture::UpdateFor(200ms);
+	Touch(fixture.path());
+	HotReloadFixture::UpdateFor(200ms);
+
+	REQUIRE(asset.reloadCount() == 1);
+	REQUIRE(asset.commitCount() == 0);
+
+	fixture.open();
+
+	REQUIRE(HotReloadFixture::UpdateUntil([&]() { return (asset.commitCount() == 2); }));
+	HotReloadFixture::UpdateFor(300ms);
+
+	REQUIRE(asset.reloadCount() == 2);
+	REQUIRE(asset.commitCount() == 2);
+	REQUIRE(asset.getState() == AssetState::Loaded);
+}
+
+TEST_CASE("AssetLoader : release() during a hot reload")
+{
+	HotReloadFixture fixture;
+	ReloadAsset& asset = fixture.asset();
+
+	Touch(fixture.path());
+	REQUIRE(HotReloadFixture::UpdateUntil([&]() { return (asset.reloadCount() == 1); }));
+
+	// release() は実行中の再ロードの完了を待つ
+	std::thread opener{ [&]() { System::Sleep(100ms); fixture.open(); } };
+	SIV3D_ENGINE(Asset)->release(HotReloadFixture::Type, HotReloadFixture::Name);
+	opener.join();
+
+	REQUIRE(asset.getState() == AssetState::Uninitialized);
+	REQUIRE(asset.releaseCount() == 1);
+
+	// 再ロードの結果は破棄され、未ロードのアセットは再ロードされない
+	Touch(fixture.path());
+	HotReloadFixture::UpdateFor(300ms);
+
+	REQUIRE(asset.reloadCount() == 1);
+	REQUIRE(asset.commitCount() == 0);
+}
+
+# endif
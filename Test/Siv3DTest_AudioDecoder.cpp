@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include "Siv3DTest.hpp"
+# include <Siv3D/Audio/AudioStreamWorker.hpp>
 
 TEST_CASE("Audio")
 {
@@ -56,4 +57,147 @@ TEST_CASE("Audio")
 		REQUIRE(wave.sampleRate() == 44100);
 		REQUIRE(wave.samples() == 87813);
 	}
+
+	SECTION("StreamDecoder OggVorbis")
+	{
+		const FilePathView path = U"test/audio/sample.ogg";
+		const Wave wave(path);
+
+		auto decoder = AudioDecoder::CreateStreamDecoder(path);
+		REQUIRE(decoder != nullptr);
+		REQUIRE(decoder->sampleRate() == wave.sampleRate());
+		REQUIRE(decoder->lengthSample() == wave.samples());
+
+		Array<WaveSample> samples(wave.samples());
+		size_t count = 0;
+
+		while (count < samples.size())
+		{
+			const size_t read = decoder->read((samples.data() + count), Min<size_t>(4096, (samples.size() - count)));
+
+			if (read == 0)
+			{
+				break;
+			}
+
+			count += read;
+		}
+
+		REQUIRE(count == wave.samples());
+		REQUIRE(decoder->read(samples.data(), 1) == 0);
+		REQUIRE(std::equal(samples.begin(), samples.end(), wave.begin(), wave.end(),
+			[](const WaveSample& a, const WaveSample& b) { return ((a.left == b.left) && (a.right == b.right)); }));
+
+		const size_t pos = (wave.samples() / 2);
+		REQUIRE(decoder->seek(pos));
+
+		WaveSample sample;
+		REQUIRE(decoder->read(&sample, 1) == 1);
+		REQUIRE(sample.left == wave[pos].left);
+		REQUIRE(sample.right == wave[pos].right);
+	}
+
+	SECTION("StreamDecoder MP3")
+	{
+		// ストリーミングでは、どのプラットフォームでも dr_mp3 でデコードする
+		const FilePathView path = U"test/audio/sample.mp3";
+
+		auto decoder = AudioDecoder::CreateStreamDecoder(path);
+		REQUIRE(decoder != nullptr);
+		REQUIRE(decoder->sampleRate() == 44100);
+		REQUIRE(decoder->lengthSample() == 91008);
+
+		Array<WaveSample> samples(decoder->lengthSample());
+		size_t count = 0;
+
+		while (count < samples.size())
+		{
+			const size_t read = decoder->read((samples.data() + count), Min<size_t>(4096, (samples.size() - count)));
+
+			if (read == 0)
+			{
+				break;
+			}
+
+			count += read;
+		}
+
+		REQUIRE(count == samples.size());
+		REQUIRE(decoder->read(samples.data(), 1) == 0);
+
+		// 後方へのシークでも、先頭から読んだものと同じサンプルになる
+		for (const size_t pos : { (samples.size() / 2), (samples.size() / 3), size_t{ 10 } })
+		{
+			REQUIRE(decoder->seek(pos));
+
+			WaveSample sample;
+			REQUIRE(decoder->read(&sample, 1) == 1);
+			REQUIRE(sample.left == samples[pos].left);
+			REQUIRE(sample.right == samples[pos].right);
+		}
+	}
+
+	SECTION("AudioFileStream seek")
+	{
+		const FilePathView path = U"test/audio/sample.mp3";
+		constexpr uint64 SeekPos = 30000;
+
+		WaveSample expected;
+		{
+			auto decoder = AudioDecoder::CreateStreamDecoder(path);
+			REQUIRE(decoder->seek(SeekPos));
+			REQUIRE(decoder->read(&expected, 1) == 1);
+		}
+
+		AudioFileStream stream{ AudioDecoder::CreateStreamDecoder(path), std::make_shared<AudioStreamLoop>() };
+		stream.fill();
+
+		float left = 0.0f, right = 0.0f;
+		uint32 loopCount = 0;
+		REQUIRE(stream.read(&left, &right, 1, loopCount) == 1);
+
+		// seek() はデコードせずに戻り、fill() が新しい位置をデコードするまでは古い位置の音声も読み出さない
+		stream.seek(SeekPos);
+		REQUIRE(stream.read(&left, &right, 1, loopCount) == 0);
+		REQUIRE(not stream.hasEnded());
+
+		stream.fill();
+		REQUIRE(stream.read(&left, &right, 1, loopCount) == 1);
+		REQUIRE(left == expected.left);
+		REQUIRE(right == expected.right);
+	}
+
+	SECTION("StreamDecoder unsupported format")
+	{
+		REQUIRE(AudioDecoder::CreateStreamDecoder(U"test/audio/sample.wav") == nullptr);
+		REQUIRE(AudioDecoder::CreateStreamDecoder(U"test/audio/nonexist.ogg") == nullptr);
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Audio.StreamDecoder.Benchmark")
+{
+	const FilePathView path = U"test/audio/sample.ogg";
+
+	BENCHMARK("Wave (full decode)")
+	{
+		return Wave{ path }.samples();
+	};
+
+	BENCHMARK("StreamDecoder (4096 samples per read)")
+	{
+		auto decoder = AudioDecoder::CreateStreamDecoder(path);
+		Array<WaveSample> buffer(4096);
+		size_t total = 0;
+
+		while (const size_t read = decoder->read(buffer.data(), buffer.size()))
+		{
+			total += read;
+		}
+
+		return total;
+	};
 }
+
+# endif
@@ -0,0 +1,82 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("CSVTable")
+{
+	const FilePath path = FileSystem::FullPath(U"test/runtime/csvtable/table.csv");
+	{
+		TextWriter writer{ path, TextEncoding::UTF8_WITH_BOM };
+		writer.write(U"id,name,score\r\n");
+		writer.write(U"1,\"Siv3D, Engine\",3.5\r\n");
+		writer.write(U"2,\"multi\nline\",  -7 \r\n");
+		writer.write(U"3,\"\\\"quoted\\\"\"\r\n");
+		writer.write(U"あ,い\r\n");
+	}
+
+	const CSVTable csv{ path, HasHeader::Yes };
+	REQUIRE(not csv.isEmpty());
+	REQUIRE(csv.rows() == 4);
+	REQUIRE(csv.columns() == 3);
+	REQUIRE(csv.columns(2) == 2);
+	REQUIRE(csv.columnNames() == Array<String>{ U"id", U"name", U"score" });
+	REQUIRE(csv.findColumn(U"score") == 2u);
+	REQUIRE(csv.findColumn(U"none") == none);
+
+	SECTION("getString()")
+	{
+		REQUIRE(csv.getString(0, 1) == U"Siv3D, Engine");
+		REQUIRE(csv.getString(1, 1) == U"multi\nline");
+		REQUIRE(csv.getString(2, 1) == U"\"quoted\"");
+		REQUIRE(csv.getString(3, 0) == U"あ");
+		REQUIRE(csv.getString(2, 2) == U"");
+		REQUIRE(csv.getView(0, 1) == "Siv3D, Engine");
+	}
+
+	SECTION("getInt64() / getDouble()")
+	{
+		REQUIRE(csv.getInt64(0, 0) == 1);
+		REQUIRE(csv.getInt64(3, 0) == none);
+		REQUIRE(csv.getDouble(0, 2) == 3.5);
+		REQUIRE(csv.getDouble(1, 2) == -7.0);
+		REQUIRE(csv.getDouble(2, 2) == none);
+	}
+
+	SECTION("Column")
+	{
+		REQUIRE(csv.column(0).parseInt64(-1) == Array<int64>{ 1, 2, 3, -1 });
+		REQUIRE(csv.column(2).parseDouble() == Array<double>{ 3.5, -7.0, 0.0, 0.0 });
+	}
+}
+
+TEST_CASE("CSVTable : large file")
+{
+	const FilePath path = FileSystem::FullPath(U"test/runtime/csvtable/large.csv");
+	constexpr int64 N = 200'000;
+	{
+		TextWriter writer{ path, TextEncoding::UTF8_NO_BOM };
+
+		for (int64 i = 0; i < N; ++i)
+		{
+			writer.writeln(U"{},\"text,\n{}\",{}"_fmt(i, i, i * 0.5));
+		}
+	}
+
+	const CSVTable csv{ path };
+	REQUIRE(csv.rows() == N);
+
+	const Array<int64> ids = csv.column(0).parseInt64(-1);
+	REQUIRE(ids.size() == N);
+	REQUIRE(ids.sum() == (N * (N - 1) / 2));
+	REQUIRE(csv.getString((N - 1), 1) == U"text,\n{}"_fmt(N - 1));
+	REQUIRE(csv.getDouble((N - 1), 2) == ((N - 1) * 0.5));
+}
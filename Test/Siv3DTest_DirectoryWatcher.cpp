@@ -0,0 +1,97 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+// 同じファイルへの連続した変更をまとめるのは Linux の実装のみ
+# if SIV3D_PLATFORM(LINUX)
+
+namespace
+{
+	constexpr StringView WatchedDirectory = U"test/watcher/";
+
+	void Touch(const FilePathView path)
+	{
+		TextWriter{ path }.writeln(Time::GetMicrosec());
+	}
+
+	/// @brief marker への変更が報告されるまでの変更をすべて返す
+	[[nodiscard]]
+	Array<FileChange> RetrieveChangesUntil(const DirectoryWatcher& watcher, const FilePath& marker)
+	{
+		Array<FileChange> changes;
+
+		const bool found = WaitUntil([&]()
+			{
+				changes.append(watcher.retrieveChanges());
+				return changes.any([&](const FileChange& change) { return (change.path == marker); });
+			});
+
+		REQUIRE(found);
+
+		// marker より後に確定した変更も拾う
+		System::Sleep(100ms);
+		changes.append(watcher.retrieveChanges());
+
+		return changes;
+	}
+}
+
+TEST_CASE("DirectoryWatcher : Added then Removed cancel out")
+{
+	FileSystem::CreateDirectories(WatchedDirectory);
+	const FilePath temporary = (FileSystem::FullPath(WatchedDirectory) + U"temporary.txt");
+	const FilePath marker = (FileSystem::FullPath(WatchedDirectory) + U"marker.txt");
+
+	{
+		const DirectoryWatcher watcher{ WatchedDirectory };
+		REQUIRE(watcher);
+
+		// 作成してすぐに削除された一時ファイル
+		Touch(temporary);
+		FileSystem::Remove(temporary);
+
+		Touch(marker);
+
+		const Array<FileChange> changes = RetrieveChangesUntil(watcher, marker);
+		REQUIRE(changes.none([&](const FileChange& change) { return (change.path == temporary); }));
+	}
+
+	FileSystem::Remove(WatchedDirectory);
+}
+
+TEST_CASE("DirectoryWatcher : Removed then Added collapse to Modified")
+{
+	FileSystem::CreateDirectories(WatchedDirectory);
+	const FilePath replaced = (FileSystem::FullPath(WatchedDirectory) + U"replaced.txt");
+	const FilePath marker = (FileSystem::FullPath(WatchedDirectory) + U"marker.txt");
+	Touch(replaced);
+
+	{
+		const DirectoryWatcher watcher{ WatchedDirectory };
+		REQUIRE(watcher);
+
+		// 削除と作成による置き換え（アトミックな保存）
+		FileSystem::Remove(replaced);
+		Touch(replaced);
+
+		Touch(marker);
+
+		const Array<FileChange> changes = RetrieveChangesUntil(watcher, marker)
+			.filter([&](const FileChange& change) { return (change.path == replaced); });
+		REQUIRE(changes.size() == 1);
+		REQUIRE(changes.front().action == FileAction::Modified);
+	}
+
+	FileSystem::Remove(WatchedDirectory);
+}
+
+# endif
@@ -0,0 +1,133 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/EngineLog.hpp>
+
+TEST_CASE("EngineTrace")
+{
+	const LogLevel logLevel = Logger.getLogLevel();
+	Logger.setLogLevel(LogLevel::Release);
+
+	EngineTrace::SetEnabled(true);
+	EngineTrace::Clear();
+
+	const FilePath path = FileSystem::FullPath(U"test/runtime/enginetrace/trace.bin");
+
+	SECTION("Save() and Decode()")
+	{
+		for (int32 i = 0; i < 3; ++i)
+		{
+			LOG_TRACE_EVENT(U"event {} ({}, {:.2f}, {})", i, size_t{ 100 }, 0.25, (i == 1));
+		}
+
+		LOG_TRACE_EVENT(U"no arguments");
+
+		REQUIRE(EngineTrace::Save(path));
+
+		const Array<String> lines = EngineTrace::Decode(path);
+		REQUIRE(lines.size() == 4);
+		REQUIRE(lines[0].includes(U"event 0 (100, 0.25, false)"));
+		REQUIRE(lines[1].includes(U"event 1 (100, 0.25, true)"));
+		REQUIRE(lines[2].includes(U"event 2 (100, 0.25, false)"));
+		REQUIRE(lines[3].includes(U"no arguments"));
+		REQUIRE(lines[3].includes(U"Siv3DTest_EngineTrace.cpp:"));
+	}
+
+	SECTION("ring buffer")
+	{
+		for (size_t i = 0; i < (EngineTrace::Capacity + 10); ++i)
+		{
+			LOG_TRACE_EVENT(U"index {}", i);
+		}
+
+		REQUIRE(EngineTrace::Save(path));
+
+		const Array<String> lines = EngineTrace::Decode(path);
+		REQUIRE(lines.size() == EngineTrace::Capacity);
+		REQUIRE(lines.front().includes(U"index 10 "));
+		REQUIRE(lines.back().includes(U"index {} "_fmt(EngineTrace::Capacity + 9)));
+	}
+
+	SECTION("SetEnabled(false)")
+	{
+		EngineTrace::SetEnabled(false);
+		LOG_TRACE_EVENT(U"disabled {}", 1);
+		EngineTrace::SetEnabled(true);
+
+		REQUIRE(EngineTrace::Save(path));
+		REQUIRE(EngineTrace::Decode(path).isEmpty());
+	}
+
+	SECTION("Decode() corrupt file")
+	{
+		LOG_TRACE_EVENT(U"event {}", 1);
+		REQUIRE(EngineTrace::Save(path));
+
+		Blob blob{ path };
+		REQUIRE(1 <= EngineTrace::Decode(path).size());
+
+		// 先頭のイベントの書式: magic (8), version (4), イベント数 (4), line (4), argCount (1), argTypes (MaxArgs)
+		constexpr size_t ArgCountOffset = 20;
+		const FilePath corruptPath = FileSystem::FullPath(U"test/runtime/enginetrace/corrupt.bin");
+
+		Blob argCount = blob;
+		argCount[ArgCountOffset] = Byte{ 255 };
+		REQUIRE(argCount.save(corruptPath));
+		REQUIRE(EngineTrace::Decode(corruptPath).isEmpty());
+
+		Blob argType = blob;
+		argType[ArgCountOffset + 1] = Byte{ 200 };
+		REQUIRE(argType.save(corruptPath));
+		REQUIRE(EngineTrace::Decode(corruptPath).isEmpty());
+	}
+
+	SECTION("Decode() invalid file")
+	{
+		REQUIRE(EngineTrace::Decode(U"test/runtime/enginetrace/not_found.bin").isEmpty());
+	}
+
+	Logger.setLogLevel(logLevel);
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("EngineTrace.Benchmark")
+{
+	const LogLevel logLevel = Logger.getLogLevel();
+	Logger.setLogLevel(LogLevel::Release);
+
+	size_t size = 1024;
+
+	BENCHMARK("LOG_TRACE() | disabled")
+	{
+		LOG_TRACE(U"ℹ️ Resized Vertex2DBatch::m_vertexArray (size: {} -> {})"_fmt(size, (size * 2)));
+		return ++size;
+	};
+
+	BENCHMARK("LOG_TRACE_EVENT()")
+	{
+		LOG_TRACE_EVENT(U"ℹ️ Resized Vertex2DBatch::m_vertexArray (size: {} -> {})", size, (size * 2));
+		return ++size;
+	};
+
+	Logger.setLogLevel(LogLevel::Debug);
+
+	BENCHMARK("LOG_TRACE() | formatted")
+	{
+		const String s = U"ℹ️ Resized Vertex2DBatch::m_vertexArray (size: {} -> {})"_fmt(size, (size * 2));
+		return s.size();
+	};
+
+	Logger.setLogLevel(logLevel);
+}
+
+# endif
@@ -0,0 +1,321 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/Font/FreeType.hpp>
+# include <Siv3D/Font/FontCommon.hpp>
+# include <Siv3D/Font/GlyphCache/GlyphCacheCommon.hpp>
+# include <Siv3D/Font/GlyphRenderer/BitmapGlyphRenderer.hpp>
+# include <Siv3D/Scene/IScene.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+namespace
+{
+	/// @brief ページの大きさが 512x256 (高さは最大 1024) になるフォントの設定
+	[[nodiscard]]
+	FontFaceProperty MakeProperty()
+	{
+		FontFaceProperty prop;
+		prop.fontPixelSize = 16;
+		return prop;
+	}
+
+	class GlyphCacheFixture
+	{
+	public:
+
+		GlyphCacheFixture()
+		{
+			SetMaxBufferPages(m_buffer, m_glyphTable, 2);
+		}
+
+		void begin()
+		{
+			BeginGlyphCaching(m_buffer, m_glyphTable);
+		}
+
+		/// @brief 1 ページに 3 つだけ入る大きさのグリフを、新しい処理としてキャッシュします。
+		[[nodiscard]]
+		bool cache(const GlyphIndex glyphIndex)
+		{
+			begin();
+			return cacheInCurrentBatch(glyphIndex);
+		}
+
+		/// @brief 1 ページに 3 つだけ入る大きさのグリフを、現在の処理の中でキャッシュします。
+		[[nodiscard]]
+		bool cacheInCurrentBatch(const GlyphIndex glyphIndex)
+		{
+			GlyphInfo info;
+			info.glyphIndex = glyphIndex;
+			return CacheGlyph(m_prop, m_image, info, m_buffer, m_glyphTable);
+		}
+
+		/// @brief キャッシュ済みのグリフを、新しい処理で使います。
+		[[nodiscard]]
+		bool use(const GlyphIndex glyphIndex)
+		{
+			begin();
+			return UseCachedGlyph(m_buffer, m_glyphTable, glyphIndex);
+		}
+
+		/// @brief キャッシュ済みのグリフを、現在のフレームで描画に使います。
+		void draw(const GlyphIndex glyphIndex)
+		{
+			UpdateBufferTextures(m_buffer);
+			[[maybe_unused]] const TextureRegion region = GetGlyphTextureRegion(m_buffer, m_glyphTable.find(glyphIndex)->second);
+		}
+
+		[[nodiscard]]
+		bool contains(const GlyphIndex glyphIndex) const
+		{
+			return m_glyphTable.contains(glyphIndex);
+		}
+
+		[[nodiscard]]
+		GlyphCacheStats stats() const
+		{
+			return GetBufferStats(m_buffer, m_glyphTable);
+		}
+
+	private:
+
+		FontFaceProperty m_prop = MakeProperty();
+
+		Image m_image{ 500, 300, Palette::White };
+
+		BufferImage m_buffer;
+
+		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
+	};
+
+	void AdvanceFrame()
+	{
+		++SIV3D_ENGINE(Scene)->getFrameCounter();
+	}
+
+	void RequireSameGlyph(const RenderedGlyph& glyph, const BitmapGlyph& expected)
+	{
+		REQUIRE(glyph.info.glyphIndex == expected.glyphIndex);
+		REQUIRE(glyph.info.left == expected.left);
+		REQUIRE(glyph.info.top == expected.top);
+		REQUIRE(glyph.info.width == expected.width);
+		REQUIRE(glyph.info.height == expected.height);
+		REQUIRE(glyph.info.xAdvance == expected.xAdvance);
+		REQUIRE(glyph.info.yAdvance == expected.yAdvance);
+		REQUIRE(glyph.image == expected.image);
+	}
+}
+
+TEST_CASE("GlyphCache")
+{
+	SECTION("evicts the least recently used page")
+	{
+		GlyphCacheFixture cache;
+
+		for (GlyphIndex i = 0; i < 6; ++i)
+		{
+			REQUIRE(cache.cache(i));
+		}
+
+		REQUIRE(cache.stats().pageCount == 2);
+
+		// ページ 0 のほうが最近使われたので、ページ 1 が破棄される
+		REQUIRE(cache.use(0));
+		REQUIRE(cache.cache(6));
+
+		REQUIRE(cache.contains(0));
+		REQUIRE(cache.contains(6));
+		REQUIRE_FALSE(cache.contains(3));
+		REQUIRE_FALSE(cache.contains(5));
+		REQUIRE(cache.stats().evictionCount == 1);
+	}
+
+	SECTION("stays within maxPages without advancing the frame")
+	{
+		GlyphCacheFixture cache;
+
+		for (GlyphIndex i = 0; i < 30; ++i)
+		{
+			REQUIRE(cache.cache(i));
+			REQUIRE(cache.stats().pageCount <= 2);
+		}
+
+		REQUIRE(cache.stats().glyphCount <= 6);
+		REQUIRE(cache.contains(29));
+	}
+
+	SECTION("pages added by one batch are released by the next batch")
+	{
+		GlyphCacheFixture cache;
+		cache.begin();
+
+		// 同じ処理の中でキャッシュしたグリフは、描画されるまで破棄できないので、一時的に上限を超える
+		for (GlyphIndex i = 0; i < 9; ++i)
+		{
+			REQUIRE(cache.cacheInCurrentBatch(i));
+		}
+
+		REQUIRE(cache.stats().pageCount == 3);
+
+		for (GlyphIndex i = 0; i < 9; ++i)
+		{
+			REQUIRE(cache.contains(i));
+		}
+
+		// 描画に使われなかったページは、次の処理で解放される
+		REQUIRE(cache.cache(9));
+		REQUIRE(cache.stats().pageCount == 2);
+		REQUIRE_FALSE(cache.contains(8));
+		REQUIRE(cache.contains(9));
+	}
+
+	SECTION("keeps pages drawn in the current frame")
+	{
+		GlyphCacheFixture cache;
+
+		for (GlyphIndex i = 0; i < 6; ++i)
+		{
+			REQUIRE(cache.cache(i));
+			cache.draw(i);
+		}
+
+		// 描画に使われたページは破棄できないので、一時的に上限を超える
+		REQUIRE(cache.cache(6));
+		cache.draw(6);
+		REQUIRE(cache.stats().pageCount == 3);
+		REQUIRE(cache.stats().evictionCount == 0);
+
+		for (GlyphIndex i = 0; i <= 6; ++i)
+		{
+			REQUIRE(cache.contains(i));
+		}
+
+		// 次のフレームでは、上限を超えたページが解放される
+		AdvanceFrame();
+		REQUIRE(cache.cache(7));
+		REQUIRE(cache.stats().pageCount == 2);
+		REQUIRE_FALSE(cache.contains(6));
+		REQUIRE(cache.contains(7));
+	}
+}
+
+TEST_CASE("Font.getGlyphCacheStats")
+{
+	const Font font{ FontMethod::Bitmap, 16 };
+
+	// 最初のキャッシュでは、.notdef のグリフも書き込まれる
+	REQUIRE(font.preload(U"abc"));
+	{
+		const GlyphCacheStats stats = font.getGlyphCacheStats();
+		REQUIRE(stats.glyphCount == 4);
+		REQUIRE(stats.missCount == 4);
+		REQUIRE(stats.hitCount == 0);
+		REQUIRE(stats.pageCount == 1);
+		REQUIRE(stats.maxPageCount == BufferImage::DefaultMaxPages);
+	}
+
+	REQUIRE(font.preload(U"abca"));
+	{
+		const GlyphCacheStats stats = font.getGlyphCacheStats();
+		REQUIRE(stats.glyphCount == 4);
+		REQUIRE(stats.missCount == 4);
+		REQUIRE(stats.hitCount == 4);
+		REQUIRE(stats.hitRate() == 0.5);
+		REQUIRE(stats.evictionCount == 0);
+	}
+
+	REQUIRE(font.getTexture(0).id() == font.getTexture().id());
+	REQUIRE(font.getTexture(1).isEmpty());
+	REQUIRE(0 < font.getGlyphCacheStats().uploadedPixels);
+
+	font.setMaxGlyphCachePages(1);
+	REQUIRE(font.getGlyphCacheStats().maxPageCount == 1);
+}
+
+TEST_CASE("Font parallel glyph rendering")
+{
+	FT_Library library = nullptr;
+	REQUIRE(::FT_Init_FreeType(&library) == 0);
+	{
+		const detail::TypefaceInfo typeface = detail::GetTypefaceInfo(Typeface::Regular);
+		const FontData font{ library, typeface.path, typeface.faceIndex, FontMethod::Bitmap, 24, FontStyle::Default };
+		REQUIRE(font.isInitialized());
+
+		Array<GlyphIndex> glyphIndices;
+
+		for (const auto& cluster : font.getGlyphClusters(U"Siv3D glyph cache 0123456789", false, Ligature::No))
+		{
+			glyphIndices << cluster.glyphIndex;
+		}
+
+		REQUIRE(ParallelGlyphRenderThreshold <= glyphIndices.size());
+
+		// メインスレッドのフォントで順番にレンダリングした結果
+		Array<BitmapGlyph> expected;
+
+		for (const auto& glyphIndex : glyphIndices)
+		{
+			expected << RenderBitmapGlyph(font.getFT_Face(), glyphIndex, font.getProperty());
+		}
+
+		const GlyphRenderFunction render = [](const FT_Face face, const GlyphIndex glyphIndex, const FontFaceProperty& prop)
+		{
+			BitmapGlyph glyph = RenderBitmapGlyph(face, glyphIndex, prop);
+			return RenderedGlyph{ glyph, std::move(glyph.image) };
+		};
+
+		SECTION("RenderGlyphs")
+		{
+			const Array<RenderedGlyph> glyphs = RenderGlyphs(font, glyphIndices, render);
+			REQUIRE(glyphs.size() == expected.size());
+
+			for (size_t i = 0; i < glyphs.size(); ++i)
+			{
+				RequireSameGlyph(glyphs[i], expected[i]);
+			}
+		}
+
+		SECTION("RenderGlyphsAsync")
+		{
+			BufferImage buffer;
+			REQUIRE(RenderGlyphsAsync(font, buffer, glyphIndices, render).get());
+
+			const Array<RenderedGlyph>& glyphs = buffer.pending->glyphs;
+			REQUIRE(glyphs.size() == expected.size());
+
+			for (size_t i = 0; i < glyphs.size(); ++i)
+			{
+				RequireSameGlyph(glyphs[i], expected[i]);
+			}
+		}
+	}
+	::FT_Done_FreeType(library);
+}
+
+TEST_CASE("Font.preloadAsync")
+{
+	const Font font{ FontMethod::Bitmap, 24 };
+	const String text = U"Siv3D preloadAsync 0123456789";
+
+	REQUIRE(font.preloadAsync(text).get());
+
+	// ワーカースレッドでレンダリングしたグリフが、メインスレッドでレンダリングしたものと同じ大きさでキャッシュされる
+	for (const auto& ch : text)
+	{
+		const Glyph glyph = font.getGlyph(ch);
+		const BitmapGlyph expected = font.renderBitmap(ch);
+
+		REQUIRE(glyph.glyphIndex == expected.glyphIndex);
+		REQUIRE(glyph.xAdvance == expected.xAdvance);
+		REQUIRE(glyph.texture.size == Float2{ expected.image.size() });
+	}
+}
@@ -0,0 +1,219 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	[[nodiscard]]
+	Image MakeRandomImage(const Size& size, SmallRNG& rng)
+	{
+		Image image{ size };
+
+		for (auto& pixel : image)
+		{
+			pixel = Color{ static_cast<uint8>(rng()), static_cast<uint8>(rng()), static_cast<uint8>(rng()), static_cast<uint8>(rng()) };
+		}
+
+		return image;
+	}
+
+	// 1 ピクセルずつ計算する参照実装
+	[[nodiscard]]
+	Color Grayscale(const Color c)
+	{
+		const uint8 gray = c.grayscale0_255();
+		return Color{ gray, gray, gray, c.a };
+	}
+
+	[[nodiscard]]
+	Color Sepia(const Color c)
+	{
+		return Color{
+			static_cast<uint8>(Min(((0.393 * c.r) + (0.769 * c.g) + (0.189 * c.b)), 255.0)),
+			static_cast<uint8>(Min(((0.349 * c.r) + (0.686 * c.g) + (0.168 * c.b)), 255.0)),
+			static_cast<uint8>(Min(((0.272 * c.r) + (0.534 * c.g) + (0.131 * c.b)), 255.0)),
+			c.a };
+	}
+
+	[[nodiscard]]
+	Color Threshold(const Color c, const uint8 threshold, const bool invert)
+	{
+		const uint8 value = (((threshold / 255.0) < c.grayscale()) != invert) ? 255 : 0;
+		return Color{ value, value, value, c.a };
+	}
+
+	[[nodiscard]]
+	Color Brighten(const Color c, const int32 level)
+	{
+		return Color{
+			static_cast<uint8>(Clamp((c.r + level), 0, 255)),
+			static_cast<uint8>(Clamp((c.g + level), 0, 255)),
+			static_cast<uint8>(Clamp((c.b + level), 0, 255)),
+			c.a };
+	}
+
+	[[nodiscard]]
+	Image Map(const Image& image, Color f(Color))
+	{
+		Image result{ image };
+
+		for (auto& pixel : result)
+		{
+			pixel = f(pixel);
+		}
+
+		return result;
+	}
+}
+
+TEST_CASE("ImageOps")
+{
+	SmallRNG rng{ 2023 };
+
+	// 端数のピクセルが出るサイズと、並列処理されるサイズ
+	for (const Size size : { Size{ 1, 1 }, Size{ 37, 11 }, Size{ 1024, 1023 } })
+	{
+		const Image src = MakeRandomImage(size, rng);
+
+		SECTION(U"grayscale() | {}"_fmt(size).narrow())
+		{
+			REQUIRE(ImageOps{}.grayscale().applied(src) == Map(src, Grayscale));
+			REQUIRE(src.grayscaled() == Map(src, Grayscale));
+		}
+
+		SECTION(U"sepia() | {}"_fmt(size).narrow())
+		{
+			REQUIRE(ImageOps{}.sepia().applied(src) == Map(src, Sepia));
+			REQUIRE(src.sepiaed() == Map(src, Sepia));
+		}
+
+		SECTION(U"threshold() | {}"_fmt(size).narrow())
+		{
+			for (const uint8 threshold : { 0, 1, 100, 128, 254, 255 })
+			{
+				for (const bool invert : { false, true })
+				{
+					Image expected{ src };
+
+					for (auto& pixel : expected)
+					{
+						pixel = Threshold(pixel, threshold, invert);
+					}
+
+					REQUIRE(ImageOps{}.threshold(threshold, InvertColor{ invert }).applied(src) == expected);
+				}
+			}
+		}
+
+		SECTION(U"chain | {}"_fmt(size).narrow())
+		{
+			ImageOps ops;
+			ops.negate().brighten(30).grayscale().brighten(-20).sepia().threshold(90);
+
+			REQUIRE(ops.num_stages() == 5);
+
+			Image expected{ src };
+
+			for (auto& pixel : expected)
+			{
+				pixel = Threshold(Sepia(Brighten(Grayscale(Brighten(~pixel, 30)), -20)), 90, false);
+			}
+
+			REQUIRE(ops.applied(src) == expected);
+
+			Image dst;
+			ops.apply(src, dst);
+			REQUIRE(dst == expected);
+
+			Image image{ src };
+			ops.apply(image);
+			REQUIRE(image == expected);
+		}
+	}
+
+	SECTION("table stages are fused")
+	{
+		const Image src = MakeRandomImage(Size{ 64, 64 }, rng);
+
+		ImageOps ops;
+		ops.negate().posterize(5).brighten(12).gammaCorrect(1.6);
+
+		REQUIRE(ops.num_stages() == 1);
+		REQUIRE(ops.applied(src) == src.negated().posterized(5).brightened(12).gammaCorrected(1.6));
+	}
+
+	SECTION("region")
+	{
+		const Image src = MakeRandomImage(Size{ 64, 48 }, rng);
+		const Rect region{ 5, 7, 30, 20 };
+
+		// 領域内は画像全体に適用した結果と一致し、領域外は変わらない
+		const auto check = [&](Image image, const Image& whole)
+		{
+			REQUIRE(image.clipped(region) == whole.clipped(region));
+			src.clipped(region).overwrite(image, region.pos);
+			REQUIRE(image == src);
+		};
+
+		{
+			Image image{ src };
+			image(region).sepia();
+			check(image, src.sepiaed());
+		}
+
+		{
+			Image image{ src };
+			image(region).posterize(5);
+			check(image, src.posterized(5));
+		}
+
+		{
+			Image image{ src };
+			image(region).gammaCorrect(1.6);
+			check(image, src.gammaCorrected(1.6));
+		}
+	}
+
+	SECTION("empty")
+	{
+		const Image src = MakeRandomImage(Size{ 20, 20 }, rng);
+
+		REQUIRE(ImageOps{}.isEmpty());
+		REQUIRE(ImageOps{}.applied(src) == src);
+		REQUIRE(ImageOps{}.grayscale().applied(Image{}).isEmpty());
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("ImageOps.Benchmark")
+{
+	SmallRNG rng{ 1 };
+
+	const Image src = MakeRandomImage(Size{ 3840, 2160 }, rng);
+	Image dst;
+
+	BENCHMARK("Image | grayscaled().brightened().posterized().gammaCorrected() | 3840x2160")
+	{
+		return src.grayscaled().brightened(20).posterized(4).gammaCorrected(1.4);
+	};
+
+	ImageOps ops;
+	ops.grayscale().brighten(20).posterize(4).gammaCorrect(1.4);
+
+	BENCHMARK("ImageOps | grayscale().brighten().posterize().gammaCorrect() | 3840x2160")
+	{
+		ops.apply(src, dst);
+	};
+}
+
+# endif
@@ -0,0 +1,182 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	[[nodiscard]]
+	Image MakeCheckerImage(const int32 width, const int32 height, const Color& c0, const Color& c1)
+	{
+		Image image(width, height);
+
+		for (int32 y = 0; y < height; ++y)
+		{
+			for (int32 x = 0; x < width; ++x)
+			{
+				image[y][x] = (IsEven(x + y) ? c0 : c1);
+			}
+		}
+
+		return image;
+	}
+
+	[[nodiscard]]
+	bool AllPixelsAre(const Image& image, const Color& color)
+	{
+		for (const auto& pixel : image)
+		{
+			if (pixel != color)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+TEST_CASE("ImageProcessing::GenerateMips")
+{
+	SECTION("mip sizes")
+	{
+		const Image image(100, 37, Palette::White);
+		const Array<Image> mips = ImageProcessing::GenerateMips(image);
+
+		REQUIRE(mips.size() == (ImageProcessing::CalculateMipCount(100, 37) - 1));
+		REQUIRE(mips[0].size() == Size{ 50, 18 });
+		REQUIRE(mips[1].size() == Size{ 25, 9 });
+		REQUIRE(mips.back().height() == 1);
+
+		REQUIRE(ImageProcessing::GenerateMips(image, 2).size() == 2);
+		REQUIRE(ImageProcessing::GenerateMips(Image{}).isEmpty());
+	}
+
+	SECTION("box filter")
+	{
+		const Image image = MakeCheckerImage(64, 64, Color{ 0, 100, 200, 255 }, Color{ 255, 101, 0, 0 });
+		const Array<Image> mips = ImageProcessing::GenerateMips(image);
+
+		// (0 + 255 + 0 + 255 + 2) / 4 = 128
+		REQUIRE(AllPixelsAre(mips[0], Color{ 128, 101, 100, 128 }));
+		REQUIRE(AllPixelsAre(mips.back(), Color{ 128, 101, 100, 128 }));
+	}
+
+	SECTION("odd sizes keep a constant image constant")
+	{
+		for (const auto filter : { MipmapFilter::Box, MipmapFilter::Kaiser })
+		{
+			for (const bool sRGB : { false, true })
+			{
+				const Color color{ 10, 120, 250, 77 };
+				const Image image(123, 45, color);
+
+				MipmapConfig config;
+				config.filter = filter;
+				config.sRGB = sRGB;
+
+				for (const auto& mip : ImageProcessing::GenerateMips(image, config))
+				{
+					REQUIRE(AllPixelsAre(mip, color));
+				}
+			}
+		}
+	}
+
+	SECTION("sRGB")
+	{
+		const Image image = MakeCheckerImage(32, 32, Color{ 0, 0, 0, 0 }, Color{ 255, 255, 255, 255 });
+
+		MipmapConfig config;
+		config.sRGB = true;
+
+		const Array<Image> mips = ImageProcessing::GenerateMips(image, 1, config);
+
+		// リニアで 0.5 の灰色は sRGB で約 188
+		REQUIRE(AllPixelsAre(mips[0], Color{ 188, 188, 188, 128 }));
+
+		// Kaiser フィルタでも、端の影響を受けないピクセルは同じ結果になる
+		config.filter = MipmapFilter::Kaiser;
+		REQUIRE(ImageProcessing::GenerateMips(image, 1, config)[0][8][8] == Color{ 188, 188, 188, 128 });
+	}
+
+	SECTION("alpha coverage")
+	{
+		// 細かい模様でアルファが 0 と x を交互にとり、アルファテストを通過するピクセルが約 1/4 の画像
+		Image image(256, 256, Color{ 255, 255, 255, 0 });
+
+		for (int32 y = 0; y < 256; ++y)
+		{
+			for (int32 x = 0; x < 256; ++x)
+			{
+				if (IsEven(x + y))
+				{
+					image[y][x].a = static_cast<uint8>(x);
+				}
+			}
+		}
+
+		const auto countCovered = [](const Image& mip)
+		{
+			size_t count = 0;
+
+			for (const auto& pixel : mip)
+			{
+				count += (128 < pixel.a);
+			}
+
+			return (static_cast<double>(count) / mip.num_pixels());
+		};
+
+		const double coverage = countCovered(image);
+
+		// 平均化によってアルファが半分になり、アルファテストを通過するピクセルが無くなる
+		MipmapConfig config;
+		REQUIRE(countCovered(ImageProcessing::GenerateMips(image, 1, config)[0]) == 0.0);
+
+		config.preserveAlphaCoverage = true;
+		config.alphaCoverageThreshold = 128;
+
+		for (const auto& mip : ImageProcessing::GenerateMips(image, 3, config))
+		{
+			REQUIRE(countCovered(mip) == Approx(coverage).margin(0.02));
+		}
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("ImageProcessing::GenerateMips : benchmark")
+{
+	const Image image = MakeCheckerImage(4096, 4096, Palette::Orange, Palette::Skyblue);
+
+	BENCHMARK("GenerateMips() | 4096x4096 Box")
+	{
+		return ImageProcessing::GenerateMips(image);
+	};
+
+	MipmapConfig config;
+	config.sRGB = true;
+
+	BENCHMARK("GenerateMips() | 4096x4096 Box sRGB")
+	{
+		return ImageProcessing::GenerateMips(image, config);
+	};
+
+	config.filter = MipmapFilter::Kaiser;
+
+	BENCHMARK("GenerateMips() | 4096x4096 Kaiser sRGB")
+	{
+		return ImageProcessing::GenerateMips(image, config);
+	};
+}
+
+# endif
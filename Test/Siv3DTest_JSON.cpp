@@ -0,0 +1,105 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	struct CountingVisitor : JSONVisitor
+	{
+		Array<String> keys;
+
+		size_t values = 0;
+
+		int32 depth = 0;
+
+		bool stopAtKey = false;
+
+		bool onNull() override { ++values; return true; }
+
+		bool onBool(bool) override { ++values; return true; }
+
+		bool onInt(int64) override { ++values; return true; }
+
+		bool onUint(uint64) override { ++values; return true; }
+
+		bool onFloat(double) override { ++values; return true; }
+
+		bool onString(std::string_view) override { ++values; return true; }
+
+		bool onKey(std::string_view key) override
+		{
+			keys << Unicode::FromUTF8(key);
+			return (not stopAtKey);
+		}
+
+		bool onObjectBegin() override { ++depth; return true; }
+
+		bool onObjectEnd() override { --depth; return true; }
+	};
+}
+
+TEST_CASE("JSON")
+{
+	const FilePath path = FileSystem::FullPath(U"test/runtime/json/data.json");
+	{
+		TextWriter writer{ path, TextEncoding::UTF8_WITH_BOM };
+		writer.write(U"{ \"name\": \"シーブスリーディー\", \"version\": 6, \"scale\": 1.5, \"tags\": [null, true, -3] }");
+	}
+
+	SECTION("Load")
+	{
+		const JSON json = JSON::Load(path);
+		REQUIRE(json);
+		REQUIRE(json[U"name"].getString() == U"シーブスリーディー");
+		REQUIRE(json[U"version"].get<int32>() == 6);
+		REQUIRE(json[U"scale"].get<double>() == 1.5);
+		REQUIRE(json[U"tags"].size() == 3);
+		REQUIRE(JSON::Load(std::make_unique<BinaryReader>(path)) == json);
+		REQUIRE(JSON::Parse(U"{ \"name\": \"シーブスリーディー\", \"version\": 6, \"scale\": 1.5, \"tags\": [null, true, -3] }") == json);
+	}
+
+	SECTION("Load UTF-16")
+	{
+		const FilePath path16 = FileSystem::FullPath(U"test/runtime/json/data16.json");
+		{
+			TextWriter writer{ path16, TextEncoding::UTF16BE };
+			writer.write(U"{ \"name\": \"シーブスリーディー\" }");
+		}
+
+		REQUIRE(JSON::Load(path16)[U"name"].getString() == U"シーブスリーディー");
+	}
+
+	SECTION("Load failure")
+	{
+		REQUIRE(not JSON::Load(U"test/runtime/json/nonexistent.json"));
+		REQUIRE(not JSON::ParseUTF8("{ \"a\": "));
+		REQUIRE_THROWS_AS(JSON::ParseUTF8("{ \"a\": ", AllowExceptions::Yes), Error);
+	}
+
+	SECTION("Visit")
+	{
+		CountingVisitor visitor;
+		REQUIRE(JSON::Visit(path, visitor));
+		REQUIRE(visitor.keys == Array<String>{ U"name", U"version", U"scale", U"tags" });
+		REQUIRE(visitor.values == 6);
+		REQUIRE(visitor.depth == 0);
+
+		CountingVisitor stopVisitor;
+		stopVisitor.stopAtKey = true;
+		REQUIRE(not JSON::Visit(path, stopVisitor));
+		REQUIRE(stopVisitor.keys.size() == 1);
+
+		CountingVisitor errorVisitor;
+		REQUIRE(not JSON::VisitUTF8("[1, 2", errorVisitor));
+		REQUIRE_THROWS_AS(JSON::VisitUTF8("[1, 2", errorVisitor, AllowExceptions::Yes), Error);
+	}
+}
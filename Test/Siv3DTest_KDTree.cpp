@@ -0,0 +1,312 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	struct Vec2Adapter : KDTreeAdapter<Array<Vec2>, Vec2>
+	{
+		static const element_type* GetPointer(const point_type& point)
+		{
+			return &point.x;
+		}
+
+		static element_type GetElement(const dataset_type& dataset, size_t index, size_t dim)
+		{
+			return dataset[index].elem(dim);
+		}
+	};
+
+	[[nodiscard]]
+	Array<Vec2> MakePoints(const size_t count, SmallRNG& rng)
+	{
+		Array<Vec2> points(count);
+
+		for (auto& point : points)
+		{
+			point.set(Random(0.0, 1000.0, rng), Random(0.0, 1000.0, rng));
+		}
+
+		return points;
+	}
+
+	[[nodiscard]]
+	Array<size_t> BruteForceRadius(const Array<Vec2>& points, const Array<bool>& active, const Vec2& center, const double radius)
+	{
+		Array<size_t> results;
+
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			if (active[i] && (points[i].distanceFromSq(center) < (radius * radius)))
+			{
+				results << i;
+			}
+		}
+
+		return results;
+	}
+
+	[[nodiscard]]
+	size_t BruteForceNearest(const Array<Vec2>& points, const Array<bool>& active, const Vec2& center)
+	{
+		size_t result = 0;
+		double minDistanceSq = Inf<double>;
+
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			if (active[i] && (points[i].distanceFromSq(center) < minDistanceSq))
+			{
+				result = i;
+				minDistanceSq = points[i].distanceFromSq(center);
+			}
+		}
+
+		return result;
+	}
+}
+
+TEST_CASE("KDTree")
+{
+	SmallRNG rng{ 12345 };
+
+	const Array<Vec2> points = MakePoints(5000, rng);
+	const Array<Vec2> queries = MakePoints(300, rng);
+
+	KDTree<Vec2Adapter> kdTree{ points };
+
+	SECTION("knnSearchAll()")
+	{
+		Array<size_t> results;
+		Array<double> distanceSqs;
+		kdTree.knnSearchAll(results, distanceSqs, 5, queries);
+
+		REQUIRE(results.size() == (queries.size() * 5));
+		REQUIRE(distanceSqs.size() == (queries.size() * 5));
+
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			const Array<size_t> expected = kdTree.knnSearch(5, queries[i]);
+
+			REQUIRE(Array<size_t>(results.begin() + (i * 5), results.begin() + ((i + 1) * 5)) == expected);
+			REQUIRE(distanceSqs[i * 5] == Approx(points[expected[0]].distanceFromSq(queries[i])));
+		}
+	}
+
+	SECTION("knnSearchAll() with fewer elements than k")
+	{
+		const Array<Vec2> fewPoints = { Vec2{ 0, 0 }, Vec2{ 10, 0 } };
+		KDTree<Vec2Adapter> fewTree{ fewPoints };
+
+		Array<size_t> results;
+		fewTree.knnSearchAll(results, 4, { Vec2{ 9, 0 } });
+
+		REQUIRE(results == Array<size_t>{ 1, 0, KDTree<Vec2Adapter>::InvalidIndex, KDTree<Vec2Adapter>::InvalidIndex });
+	}
+
+	SECTION("radiusSearchAll()")
+	{
+		Array<Array<size_t>> results;
+		kdTree.radiusSearchAll(results, queries, 40.0, SortByDistance::Yes);
+
+		REQUIRE(results.size() == queries.size());
+
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			REQUIRE(results[i] == kdTree.radiusSearch(queries[i], 40.0, SortByDistance::Yes));
+		}
+	}
+}
+
+TEST_CASE("DynamicKDTree")
+{
+	SmallRNG rng{ 67890 };
+
+	Array<Vec2> points = MakePoints(3000, rng);
+	const Array<Vec2> queries = MakePoints(200, rng);
+
+	Array<bool> active(points.size(), true);
+
+	DynamicKDTree<Vec2Adapter> kdTree{ points };
+
+	const auto check = [&]()
+	{
+		REQUIRE(kdTree.size() == static_cast<size_t>(active.count(true)));
+
+		for (const auto& query : queries)
+		{
+			REQUIRE(kdTree.radiusSearch(query, 50.0).sorted() == BruteForceRadius(points, active, query, 50.0));
+
+			const Array<size_t> nearest = kdTree.knnSearch(1, query);
+			REQUIRE(nearest.size() == 1);
+			REQUIRE(nearest[0] == BruteForceNearest(points, active, query));
+		}
+	};
+
+	SECTION("construct")
+	{
+		check();
+	}
+
+	SECTION("insert() and remove()")
+	{
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			kdTree.remove(i * 3);
+			active[i * 3] = false;
+		}
+
+		REQUIRE_FALSE(kdTree.contains(0));
+		REQUIRE(kdTree.contains(1));
+
+		check();
+
+		const Array<Vec2> added = MakePoints(2000, rng);
+
+		for (const auto& point : added)
+		{
+			points << point;
+			active << true;
+			kdTree.insert(points.size() - 1);
+		}
+
+		check();
+	}
+
+	SECTION("update()")
+	{
+		for (size_t i = 0; i < points.size(); i += 2)
+		{
+			points[i].moveBy(Random(-100.0, 100.0, rng), Random(-100.0, 100.0, rng));
+			kdTree.update(i);
+		}
+
+		check();
+	}
+
+	SECTION("refit()")
+	{
+		for (auto& point : points)
+		{
+			point.moveBy(Random(-20.0, 20.0, rng), Random(-20.0, 20.0, rng));
+		}
+
+		kdTree.refit();
+
+		check();
+	}
+
+	SECTION("knnSearchAll() and radiusSearchAll()")
+	{
+		Array<size_t> knnResults;
+		kdTree.knnSearchAll(knnResults, 4, queries);
+
+		Array<Array<size_t>> radiusResults;
+		kdTree.radiusSearchAll(radiusResults, queries, 30.0, SortByDistance::Yes);
+
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			REQUIRE(Array<size_t>(knnResults.begin() + (i * 4), knnResults.begin() + ((i + 1) * 4)) == kdTree.knnSearch(4, queries[i]));
+			REQUIRE(radiusResults[i] == kdTree.radiusSearch(queries[i], 30.0, SortByDistance::Yes));
+		}
+	}
+
+	SECTION("insert into empty tree")
+	{
+		Array<Vec2> dataset;
+		DynamicKDTree<Vec2Adapter> emptyTree{ dataset };
+
+		REQUIRE(emptyTree.isEmpty());
+		REQUIRE(emptyTree.knnSearch(1, Vec2{ 0, 0 }).isEmpty());
+
+		for (int32 i = 0; i < 100; ++i)
+		{
+			dataset << Vec2{ i, 0 };
+			emptyTree.insert(i);
+		}
+
+		REQUIRE(emptyTree.size() == 100);
+		REQUIRE(emptyTree.knnSearch(2, Vec2{ 42.2, 1.0 }) == Array<size_t>{ 42, 43 });
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("KDTree.Benchmark")
+{
+	for (const size_t count : { 10'000, 100'000, 1'000'000 })
+	{
+		SmallRNG rng{ 1 };
+
+		Array<Vec2> points = MakePoints(count, rng);
+		const Array<Vec2> velocities = MakePoints(count, rng).map([](const Vec2& v) { return ((v / 500.0) - Vec2{ 1, 1 }); });
+		const Array<Vec2> queries = points.take(10'000);
+
+		KDTree<Vec2Adapter> kdTree{ points };
+		DynamicKDTree<Vec2Adapter> dynamicTree{ points };
+
+		Array<size_t> results;
+		Array<Array<size_t>> radiusResults;
+
+		BENCHMARK(U"KDTree::rebuildIndex() | {}"_fmt(count).narrow())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				points[i] += velocities[i];
+			}
+
+			kdTree.rebuildIndex();
+		};
+
+		BENCHMARK(U"DynamicKDTree::refit() | {}"_fmt(count).narrow())
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				points[i] += velocities[i];
+			}
+
+			dynamicTree.refit();
+		};
+
+		kdTree.rebuildIndex();
+		dynamicTree.rebuildIndex();
+
+		BENCHMARK(U"KDTree::knnSearch() x10000 | {}"_fmt(count).narrow())
+		{
+			for (const auto& query : queries)
+			{
+				kdTree.knnSearch(results, 8, query);
+			}
+		};
+
+		BENCHMARK(U"KDTree::knnSearchAll() x10000 | {}"_fmt(count).narrow())
+		{
+			kdTree.knnSearchAll(results, 8, queries);
+		};
+
+		BENCHMARK(U"DynamicKDTree::knnSearchAll() x10000 | {}"_fmt(count).narrow())
+		{
+			dynamicTree.knnSearchAll(results, 8, queries);
+		};
+
+		BENCHMARK(U"KDTree::radiusSearchAll() x10000 | {}"_fmt(count).narrow())
+		{
+			kdTree.radiusSearchAll(radiusResults, queries, 5.0);
+		};
+
+		BENCHMARK(U"DynamicKDTree::radiusSearchAll() x10000 | {}"_fmt(count).narrow())
+		{
+			dynamicTree.radiusSearchAll(radiusResults, queries, 5.0);
+		};
+	}
+}
+
+# endif
@@ -0,0 +1,111 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/EngineLog.hpp>
+
+TEST_CASE("Logger")
+{
+	SECTION("setOutputFile() and flush()")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/runtime/logger/text.log");
+		REQUIRE(Logger.setOutputFile(path) == true);
+
+		Logger << U"Logger test message";
+		Logger.flush();
+		Logger.closeOutputFile();
+
+		TextReader reader{ path };
+		String s;
+		REQUIRE(reader.readAll(s) == true);
+		REQUIRE(s.includes(U"Logger test message"));
+	}
+
+	SECTION("rotation")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/runtime/logger/rotate.log");
+		REQUIRE(Logger.setOutputFile(path, LogFileFormat::Text, 1024, 2) == true);
+
+		for (int32 i = 0; i < 200; ++i)
+		{
+			Logger << U"rotation test message " << i;
+		}
+
+		Logger.flush();
+		Logger.closeOutputFile();
+
+		REQUIRE(FileSystem::Exists(path + U".1"));
+		REQUIRE(FileSystem::Exists(path + U".3") == false);
+		REQUIRE(FileSystem::FileSize(path) <= 1024);
+	}
+
+	SECTION("LogFileFormat::Binary")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/runtime/logger/binary.log");
+		REQUIRE(Logger.setOutputFile(path, LogFileFormat::Binary) == true);
+
+		Logger << U"binary";
+		Logger.flush();
+		Logger.closeOutputFile();
+
+		BinaryReader reader{ path };
+		char magic[8];
+		uint32 version = 0;
+		REQUIRE(reader.read(magic, sizeof(magic)) == sizeof(magic));
+		REQUIRE(std::string_view(magic, sizeof(magic)) == "SIV3DLOG");
+		REQUIRE(reader.read(version));
+		REQUIRE(version == 1);
+
+		// エンジンのログが先に書き込まれている場合があるため、目的のログまで読み進める
+		bool found = false;
+		int64 timeStamp = 0;
+		uint8 type = 0;
+		uint32 length = 0;
+
+		while (reader.read(timeStamp) && reader.read(type) && reader.read(length))
+		{
+			std::string text(length, '\0');
+			REQUIRE(reader.read(text.data(), length) == length);
+
+			if (text == "binary")
+			{
+				REQUIRE(type == FromEnum(LogType::App));
+				found = true;
+				break;
+			}
+		}
+
+		REQUIRE(found);
+	}
+
+	SECTION("setLogLevel()")
+	{
+		const LogLevel logLevel = Logger.getLogLevel();
+
+		Logger.setLogLevel(LogLevel::Release);
+		REQUIRE(Logger.getLogLevel() == LogLevel::Release);
+
+		// 出力されないログの引数は評価されない
+		int32 evaluated = 0;
+		LOG_TRACE(U"{}"_fmt(++evaluated));
+		LOG_VERBOSE(U"{}"_fmt(++evaluated));
+		LOG_SCOPED_TRACE(U"{}"_fmt(++evaluated));
+		REQUIRE(evaluated == 0);
+
+		Logger.setLogLevel(LogLevel::Debug);
+		REQUIRE(Logger.getLogLevel() == LogLevel::Debug);
+		LOG_TRACE(U"{}"_fmt(++evaluated));
+		LOG_VERBOSE(U"{}"_fmt(++evaluated));
+		REQUIRE(evaluated == 1);
+
+		Logger.setLogLevel(logLevel);
+	}
+}
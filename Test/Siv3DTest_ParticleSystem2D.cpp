@@ -0,0 +1,101 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("ParticleSystem2D")
+{
+	ParticleSystem2DParameters parameters;
+	parameters.rate = 1000.0;
+	parameters.maxParticles = 10000.0;
+	parameters.startLifeTime = 1.0;
+
+	ParticleSystem2D particleSystem{ Vec2{ 0, 0 }, Vec2{ 0, 100 } };
+	particleSystem.setEmitter(CircleEmitter2D{});
+	particleSystem.setParameters(parameters);
+	particleSystem.prewarm();
+
+	const size_t initialCount = particleSystem.num_particles();
+	REQUIRE(990 <= initialCount);
+	REQUIRE(initialCount <= 1000);
+
+	parameters.rate = 0.0;
+	particleSystem.setParameters(parameters);
+
+	SECTION("update() removes expired particles")
+	{
+		particleSystem.update(0.5);
+		REQUIRE(0 < particleSystem.num_particles());
+		REQUIRE(particleSystem.num_particles() < initialCount);
+
+		particleSystem.update(1.0);
+		REQUIRE(particleSystem.num_particles() == 0);
+	}
+
+	SECTION("maxParticles keeps the newest particles")
+	{
+		parameters.rate = 1000.0;
+		parameters.maxParticles = 100.0;
+		particleSystem.setParameters(parameters);
+		particleSystem.update(0.01);
+		REQUIRE(particleSystem.num_particles() == 100);
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("ParticleSystem2D : benchmark")
+{
+	constexpr size_t N = 100'000;
+	constexpr float DeltaTime = 1e-6f;
+	const Float2 deltaVelocity{ 0.0f, (100.0f * DeltaTime) };
+
+	// 時間あたりの処理パーティクル数 (particles/ms) = N / (1 回あたりの時間 [ms])
+	{
+		Array<Particle2D> particles(N, Particle2D{ Emission2D{ Vec2{ 0, 0 }, Vec2{ 10, 0 } }, Float4{ 1, 1, 1, 1 }, 10.0f, 0.0f, 0.0f, 1.0f, 1.0f });
+
+		BENCHMARK("Array<Particle2D> (AoS) | 100K particles")
+		{
+			for (auto& particle : particles)
+			{
+				particle.update(DeltaTime, deltaVelocity);
+			}
+
+			particles.remove_if([](const Particle2D& p) { return p.isDead(); });
+
+			return particles.size();
+		};
+	}
+
+	{
+		ParticleSystem2DParameters parameters;
+		parameters.rate = static_cast<double>(N);
+		parameters.maxParticles = static_cast<double>(N);
+		parameters.startLifeTime = 1.0;
+
+		ParticleSystem2D particleSystem{ Vec2{ 0, 0 }, Vec2{ 0, 100 } };
+		particleSystem.setEmitter(CircleEmitter2D{});
+		particleSystem.setParameters(parameters);
+		particleSystem.prewarm();
+
+		parameters.rate = 0.0;
+		particleSystem.setParameters(parameters);
+
+		BENCHMARK("ParticleSystem2D (SoA) | 100K particles")
+		{
+			particleSystem.update(DeltaTime);
+
+			return particleSystem.num_particles();
+		};
+	}
+}
+
+# endif
@@ -0,0 +1,199 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	[[nodiscard]]
+	Optional<ProfilerZoneRecord> FindZone(const Array<ProfilerZoneRecord>& zones, const StringView name)
+	{
+		for (const auto& zone : zones)
+		{
+			if (StringView{ zone.name } == name)
+			{
+				return zone;
+			}
+		}
+
+		return none;
+	}
+}
+
+TEST_CASE("Profiler : zones")
+{
+	Profiler::EnableZoneRecording(true);
+	Profiler::ClearZones();
+
+	SECTION("nesting")
+	{
+		REQUIRE(System::Update());
+		{
+			SIV3D_PROFILE_ZONE(U"outer");
+			{
+				SIV3D_PROFILE_ZONE(U"inner");
+				System::Sleep(1ms);
+			}
+		}
+		REQUIRE(System::Update());
+
+		const Array<ProfilerZoneRecord> zones = Profiler::GetLastFrameZones();
+		const Optional<ProfilerZoneRecord> outer = FindZone(zones, U"outer");
+		const Optional<ProfilerZoneRecord> inner = FindZone(zones, U"inner");
+		REQUIRE(outer.has_value());
+		REQUIRE(inner.has_value());
+		REQUIRE(inner->threadIndex == outer->threadIndex);
+		REQUIRE(inner->depth == (outer->depth + 1));
+		REQUIRE(outer->beginNanosec <= inner->beginNanosec);
+		REQUIRE(inner->endNanosec <= outer->endNanosec);
+		REQUIRE(1.0 <= inner->durationMillisec());
+
+		// エンジンのゾーン
+		REQUIRE(FindZone(zones, U"Input::update").has_value());
+	}
+
+	SECTION("EnableZoneRecording(false)")
+	{
+		REQUIRE(System::Update());
+		Profiler::EnableZoneRecording(false);
+		{
+			SIV3D_PROFILE_ZONE(U"disabled");
+		}
+		Profiler::EnableZoneRecording(true);
+		REQUIRE(System::Update());
+
+		REQUIRE(not FindZone(Profiler::GetLastFrameZones(), U"disabled").has_value());
+	}
+
+	SECTION("SaveChromeTrace()")
+	{
+		std::thread thread{ []()
+		{
+			Profiler::SetThreadName(U"Test \"thread\"");
+			SIV3D_PROFILE_ZONE(U"thread zone");
+		} };
+		thread.join();
+
+		{
+			SIV3D_PROFILE_ZONE(U"main zone");
+		}
+		REQUIRE(System::Update());
+
+		const FilePath path = FileSystem::FullPath(U"test/runtime/profiler/trace.json");
+		REQUIRE(Profiler::SaveChromeTrace(path));
+
+		const JSON json = JSON::Load(path);
+		REQUIRE(json);
+
+		Optional<int32> mainThread, otherThread, namedThread;
+		bool hasFrame = false;
+
+		for (const auto& event : json[U"traceEvents"].arrayView())
+		{
+			const String name = event[U"name"].getString();
+			const String phase = event[U"ph"].getString();
+
+			if (name == U"main zone")
+			{
+				REQUIRE(phase == U"X");
+				REQUIRE(0.0 <= event[U"dur"].get<double>());
+				mainThread = event[U"tid"].get<int32>();
+			}
+			else if (name == U"thread zone")
+			{
+				otherThread = event[U"tid"].get<int32>();
+			}
+			else if ((name == U"thread_name") && (event[U"args"][U"name"].getString() == U"Test \"thread\""))
+			{
+				REQUIRE(phase == U"M");
+				namedThread = event[U"tid"].get<int32>();
+			}
+			else if (name.starts_with(U"Frame "))
+			{
+				hasFrame = true;
+			}
+		}
+
+		REQUIRE(mainThread);
+		REQUIRE(otherThread);
+		REQUIRE(mainThread != otherThread);
+		REQUIRE(namedThread == otherThread);
+		REQUIRE(hasFrame);
+	}
+
+	SECTION("ClearZones()")
+	{
+		{
+			SIV3D_PROFILE_ZONE(U"cleared");
+		}
+		Profiler::ClearZones();
+		REQUIRE(System::Update());
+
+		REQUIRE(not FindZone(Profiler::GetLastFrameZones(), U"cleared").has_value());
+	}
+
+	Profiler::EnableZoneRecording(false);
+}
+
+TEST_CASE("Profiler : frame time histogram")
+{
+	for (int32 i = 0; i < 5; ++i)
+	{
+		REQUIRE(System::Update());
+	}
+
+	const FrameTimeHistogram histogram = Profiler::GetFrameTimeHistogram();
+	REQUIRE(5 <= histogram.frameCount);
+	REQUIRE(histogram.frameCount <= FrameTimeHistogram::WindowSize);
+
+	uint32 total = 0;
+
+	for (const auto count : histogram.counts)
+	{
+		total += count;
+	}
+
+	REQUIRE(total == histogram.frameCount);
+	REQUIRE(histogram.minMillisec <= histogram.p50Millisec);
+	REQUIRE(histogram.p50Millisec <= histogram.p95Millisec);
+	REQUIRE(histogram.p95Millisec <= histogram.p99Millisec);
+	REQUIRE(histogram.p99Millisec <= histogram.maxMillisec);
+	REQUIRE(histogram.minMillisec <= histogram.meanMillisec);
+	REQUIRE(histogram.meanMillisec <= histogram.maxMillisec);
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Profiler : zone overhead")
+{
+	size_t count = 0;
+
+	Profiler::EnableZoneRecording(false);
+
+	BENCHMARK("SIV3D_PROFILE_ZONE() | disabled")
+	{
+		SIV3D_PROFILE_ZONE(U"benchmark");
+		return ++count;
+	};
+
+	Profiler::EnableZoneRecording(true);
+
+	BENCHMARK("SIV3D_PROFILE_ZONE() | enabled")
+	{
+		SIV3D_PROFILE_ZONE(U"benchmark");
+		return ++count;
+	};
+
+	Profiler::EnableZoneRecording(false);
+	Profiler::ClearZones();
+}
+
+# endif
@@ -0,0 +1,169 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/Script/IScript.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+namespace
+{
+	[[nodiscard]]
+	size_t CacheHitCount()
+	{
+		return SIV3D_ENGINE(Script)->getBytecodeCache().getHitCount();
+	}
+
+	[[nodiscard]]
+	size_t CountCacheFiles(const FilePathView directory)
+	{
+		return FileSystem::DirectoryContents(directory, Recursive::No)
+			.count_if([](const FilePath& path) { return (FileSystem::Extension(path) == U"asbc"); });
+	}
+
+	void WriteScript(const FilePathView path, const StringView code)
+	{
+		TextWriter writer{ path };
+		writer.write(code);
+	}
+}
+
+TEST_CASE("Script.BytecodeCache")
+{
+	const FilePath cacheDirectory = FileSystem::FullPath(U"test/runtime/script/cache/");
+	FileSystem::Remove(cacheDirectory);
+	Script::SetBytecodeCacheDirectory(cacheDirectory);
+
+	REQUIRE(Script::GetBytecodeCacheDirectory() == cacheDirectory);
+
+	const FilePath mainPath = FileSystem::FullPath(U"test/runtime/script/main.as");
+	const FilePath includePath = FileSystem::FullPath(U"test/runtime/script/sub.as");
+
+	WriteScript(includePath, U"int32 Sub() { return 20; }");
+	WriteScript(mainPath, U"#include \"sub.as\"\nint32 Main() { return Sub() + 1; }");
+
+	SECTION("cache round-trip")
+	{
+		const size_t hitCount = CacheHitCount();
+
+		{
+			const Script script{ mainPath, ScriptCompileOption::UseBytecodeCache };
+			REQUIRE(script.compiled());
+			REQUIRE(script.getFunction<int32()>(U"Main")() == 21);
+			REQUIRE(CountCacheFiles(cacheDirectory) == 1);
+			REQUIRE(CacheHitCount() == hitCount);
+		}
+
+		{
+			const Script script{ mainPath, ScriptCompileOption::UseBytecodeCache };
+			REQUIRE(script.compiled());
+			REQUIRE(CacheHitCount() == (hitCount + 1));
+			REQUIRE(script.getIncludedFiles().size() == 1);
+			REQUIRE(script.getFunction<int32()>(U"Main")() == 21);
+			REQUIRE(CountCacheFiles(cacheDirectory) == 1);
+		}
+	}
+
+	SECTION("modified include falls back to compiling from source")
+	{
+		{
+			const Script script{ mainPath, ScriptCompileOption::UseBytecodeCache };
+			REQUIRE(script.getFunction<int32()>(U"Main")() == 21);
+		}
+
+		WriteScript(includePath, U"int32 Sub() { return 40; }");
+
+		{
+			const size_t hitCount = CacheHitCount();
+			const Script script{ mainPath, ScriptCompileOption::UseBytecodeCache };
+			REQUIRE(script.compiled());
+			REQUIRE(CacheHitCount() == hitCount);
+			REQUIRE(script.getFunction<int32()>(U"Main")() == 41);
+		}
+	}
+
+	SECTION("code and compile option are part of the key")
+	{
+		const Script a{ Arg::code = U"int32 Main() { return 1; }", ScriptCompileOption::UseBytecodeCache };
+		const Script b{ Arg::code = U"int32 Main() { return 2; }", ScriptCompileOption::UseBytecodeCache };
+		const Script c{ Arg::code = U"int32 Main() { return 2; }", (ScriptCompileOption::UseBytecodeCache | ScriptCompileOption::BuildWithLineCues) };
+
+		REQUIRE(a.getFunction<int32()>(U"Main")() == 1);
+		REQUIRE(b.getFunction<int32()>(U"Main")() == 2);
+		REQUIRE(c.getFunction<int32()>(U"Main")() == 2);
+		REQUIRE(CountCacheFiles(cacheDirectory) == 3);
+	}
+
+	SECTION("corrupted cache is ignored")
+	{
+		{
+			const Script script{ mainPath, ScriptCompileOption::UseBytecodeCache };
+			REQUIRE(script.compiled());
+		}
+
+		for (const auto& path : FileSystem::DirectoryContents(cacheDirectory, Recursive::No))
+		{
+			Blob blob{ path };
+			blob.resize(blob.size() / 2);
+			blob.save(path);
+		}
+
+		const Script script{ mainPath, ScriptCompileOption::UseBytecodeCache };
+		REQUIRE(script.compiled());
+		REQUIRE(script.getFunction<int32()>(U"Main")() == 21);
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Script.BytecodeCache.Benchmark")
+{
+	const FilePath cacheDirectory = FileSystem::FullPath(U"test/runtime/script/benchmark_cache/");
+	FileSystem::Remove(cacheDirectory);
+	Script::SetBytecodeCacheDirectory(cacheDirectory);
+
+	// 起動時に多数のモジュールをロードする状況を想定する
+	Array<String> codes;
+
+	for (int32 i = 0; i < 50; ++i)
+	{
+		String code;
+
+		for (int32 k = 0; k < 40; ++k)
+		{
+			code += U"double F{}(double x) {{ double s = 0; for (int32 i = 0; i < 10; ++i) {{ s += Math::Sin(x * i) * {}; }} return s; }}\n"_fmt(k, (i + k));
+		}
+
+		codes << code;
+	}
+
+	for (const auto& code : codes)
+	{
+		const Script script{ Arg::code = code, ScriptCompileOption::UseBytecodeCache };
+	}
+
+	BENCHMARK("Script | compile 50 modules")
+	{
+		for (const auto& code : codes)
+		{
+			const Script script{ Arg::code = code };
+		}
+	};
+
+	BENCHMARK("Script | load 50 modules from bytecode cache")
+	{
+		for (const auto& code : codes)
+		{
+			const Script script{ Arg::code = code, ScriptCompileOption::UseBytecodeCache };
+		}
+	};
+}
+
+# endif
@@ -39,3 +39,339 @@ TEST_CASE("SimpleHTTP::Post with headers")
     REQUIRE(response.getStatusLine().rtrimmed() == U"HTTP/1.1 200 OK");
     REQUIRE(FromEnum(response.getStatusCode()) == 200);
 }
+
+# if not SIV3D_PLATFORM(WEB)
+
+namespace
+{
+	constexpr uint16 LocalHTTPPort = 50090;
+
+	/// @brief テスト用の、keep-alive に対応した最小限の HTTP/1.1 サーバ
+	/// @remark GET /bytes/N には N バイトのデータを返します。GET /hold は release() まで応答を保留します。
+	class LocalHTTPServer
+	{
+	public:
+
+		explicit LocalHTTPServer(const uint16 port)
+			: m_port{ port }
+		{
+			m_server.startAcceptMulti(port);
+
+			m_task = Async([this]() { run(); });
+		}
+
+		~LocalHTTPServer()
+		{
+			m_stop = true;
+
+			m_task.wait();
+
+			m_server.disconnect();
+		}
+
+		[[nodiscard]]
+		URL url(const StringView path) const
+		{
+			return U"http://127.0.0.1:{}{}"_fmt(m_port, path);
+		}
+
+		/// @brief これまでに受け付けた接続の数
+		[[nodiscard]]
+		size_t numConnections() const
+		{
+			return m_connections;
+		}
+
+		/// @brief 受け取ったリクエストのパス（受け取った順）
+		[[nodiscard]]
+		Array<std::string> requestedPaths() const
+		{
+			std::lock_guard lock{ m_mutex };
+
+			return m_paths;
+		}
+
+		void release()
+		{
+			m_released = true;
+		}
+
+		[[nodiscard]]
+		static Byte ExpectedByte(const size_t index)
+		{
+			return Byte(index % 251);
+		}
+
+	private:
+
+		uint16 m_port;
+
+		TCPServer m_server;
+
+		AsyncTask<void> m_task;
+
+		mutable std::mutex m_mutex;
+
+		Array<std::string> m_paths;
+
+		std::atomic<size_t> m_connections{ 0 };
+
+		std::atomic<bool> m_released{ false };
+
+		std::atomic<bool> m_stop{ false };
+
+		void run()
+		{
+			HashTable<TCPSessionID, std::string> buffers;
+
+			Array<TCPSessionID> held;
+
+			while (not m_stop)
+			{
+				bool idle = true;
+
+				for (const auto id : m_server.getSessionIDs())
+				{
+					if (buffers.emplace(id, std::string{}).second)
+					{
+						++m_connections;
+					}
+
+					const size_t available = m_server.available(id);
+
+					if (available == 0)
+					{
+						continue;
+					}
+
+					idle = false;
+
+					std::string& buffer = buffers[id];
+					const size_t oldSize = buffer.size();
+					buffer.resize(oldSize + available);
+					m_server.read(buffer.data() + oldSize, available, id);
+
+					for (size_t end; (end = buffer.find("\r\n\r\n")) != std::string::npos;)
+					{
+						// "GET /path HTTP/1.1"
+						const size_t pathBegin = (buffer.find(' ') + 1);
+						const std::string path = buffer.substr(pathBegin, (buffer.find(' ', pathBegin) - pathBegin));
+						buffer.erase(0, (end + 4));
+
+						{
+							std::lock_guard lock{ m_mutex };
+
+							m_paths.push_back(path);
+						}
+
+						if ((path == "/hold") && (not m_released))
+						{
+							held.push_back(id);
+						}
+						else
+						{
+							respond(id, path);
+						}
+					}
+				}
+
+				if (m_released && held)
+				{
+					for (const auto id : held)
+					{
+						respond(id, "/hold");
+					}
+
+					held.clear();
+				}
+
+				if (idle)
+				{
+					System::Sleep(1ms);
+				}
+			}
+		}
+
+		void respond(const TCPSessionID id, const std::string& path)
+		{
+			size_t size = 0;
+
+			if (path.starts_with("/bytes/"))
+			{
+				size = ParseOr<size_t>(Unicode::WidenAscii(path.substr(7)), 0);
+			}
+
+			std::string response = (U"HTTP/1.1 200 OK\r\nContent-Length: {}\r\n\r\n"_fmt(size)).narrow();
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				response.push_back(static_cast<char>(ExpectedByte(i)));
+			}
+
+			m_server.send(response.data(), response.size(), id);
+		}
+	};
+
+	[[nodiscard]]
+	bool IsExpectedBody(const Blob& blob, const size_t size)
+	{
+		if (blob.size() != size)
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (blob[i] != LocalHTTPServer::ExpectedByte(i))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+TEST_CASE("SimpleHTTP : connection reuse")
+{
+	LocalHTTPServer server{ LocalHTTPPort };
+
+	{
+		MemoryWriter writer;
+		const auto response = SimpleHTTP::Get(server.url(U"/bytes/100000"), {}, writer);
+		REQUIRE(response.isOK());
+		REQUIRE(IsExpectedBody(writer.getBlob(), 100'000));
+	}
+
+	Array<AsyncHTTPTask> tasks;
+
+	for (size_t i = 0; i < 64; ++i)
+	{
+		tasks << SimpleHTTP::LoadAsync(server.url(U"/bytes/{}"_fmt(i * 100)));
+	}
+
+	REQUIRE(WaitUntil([&]() { return tasks.all([](const AsyncHTTPTask& task) { return (not task.isDownloading()); }); }));
+
+	for (size_t i = 0; i < tasks.size(); ++i)
+	{
+		REQUIRE(tasks[i].isSucceeded());
+		REQUIRE(IsExpectedBody(tasks[i].getBlob(), (i * 100)));
+	}
+
+	// 65 個のリクエストが、同時に転送する数の上限以下の接続で処理される
+	REQUIRE(server.numConnections() <= SimpleHTTP::GetMaxConcurrency());
+}
+
+TEST_CASE("SimpleHTTP : priority and cancel")
+{
+	LocalHTTPServer server{ LocalHTTPPort + 1 };
+
+	const size_t maxConcurrency = SimpleHTTP::GetMaxConcurrency();
+	SimpleHTTP::SetMaxConcurrency(1);
+
+	// 1 つしかない枠を埋めて、以降のリクエストを待機させる
+	AsyncHTTPTask hold = SimpleHTTP::LoadAsync(server.url(U"/hold"));
+	REQUIRE(WaitUntil([&]() { return server.requestedPaths().includes("/hold"); }));
+
+	AsyncHTTPTask low = SimpleHTTP::LoadAsync(server.url(U"/bytes/1"), 0);
+	AsyncHTTPTask canceled = SimpleHTTP::LoadAsync(server.url(U"/bytes/3"), 5);
+	AsyncHTTPTask high = SimpleHTTP::LoadAsync(server.url(U"/bytes/2"), 10);
+
+	REQUIRE(low.isDownloading());
+	REQUIRE(canceled.isDownloading());
+
+	// 待機中のリクエストは、転送の枠が空くのを待たずに中断できる
+	canceled.cancel();
+	REQUIRE(canceled.isCanceled());
+
+	server.release();
+
+	REQUIRE(WaitUntil([&]() { return (low.isSucceeded() && high.isSucceeded() && hold.isSucceeded()); }));
+
+	// 後から要求した優先度の高いリクエストが先に転送される
+	const Array<std::string> paths = server.requestedPaths();
+	REQUIRE(paths.size() == 3);
+	REQUIRE(paths[0] == "/hold");
+	REQUIRE(paths[1] == "/bytes/2");
+	REQUIRE(paths[2] == "/bytes/1");
+
+	SimpleHTTP::SetMaxConcurrency(maxConcurrency);
+}
+
+TEST_CASE("SimpleHTTP : synchronous request bypasses the queue")
+{
+	LocalHTTPServer server{ LocalHTTPPort + 3 };
+
+	// 同時に転送する数の上限を超える、応答を保留されるリクエストを先に要求する
+	Array<AsyncHTTPTask> holds;
+
+	for (size_t i = 0; i < 20; ++i)
+	{
+		holds << SimpleHTTP::LoadAsync(server.url(U"/hold"));
+	}
+
+	REQUIRE(WaitUntil([&]() { return (server.requestedPaths().count("/hold") == SimpleHTTP::GetMaxConcurrency()); }));
+
+	// 待機列に並んでしまうとブロックし続けるので、別のスレッドで呼ぶ
+	AsyncTask<bool> sync = Async([&]()
+		{
+			MemoryWriter writer;
+			const auto response = SimpleHTTP::Get(server.url(U"/bytes/1000"), {}, writer);
+			return (response.isOK() && IsExpectedBody(writer.getBlob(), 1000));
+		});
+
+	const bool completed = WaitUntil([&]() { return sync.isReady(); }, 5s);
+	const bool holding = holds.all([](const AsyncHTTPTask& task) { return task.isDownloading(); });
+
+	server.release();
+
+	// 同期版のリクエストは、先に要求された非同期のリクエストを待たずに完了する
+	REQUIRE(completed);
+	REQUIRE(holding);
+	REQUIRE(sync.get());
+
+	REQUIRE(WaitUntil([&]() { return holds.all([](const AsyncHTTPTask& task) { return task.isSucceeded(); }); }));
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("SimpleHTTP : concurrent downloads")
+{
+	LocalHTTPServer server{ LocalHTTPPort + 2 };
+
+	constexpr size_t RequestCount = 200;
+
+	const size_t maxConcurrency = SimpleHTTP::GetMaxConcurrency();
+
+	Logger.disable();
+
+	for (const size_t concurrency : { 1, 8, 32 })
+	{
+		SimpleHTTP::SetMaxConcurrency(concurrency);
+
+		BENCHMARK(U"{} x 16 KiB | max concurrency {}"_fmt(RequestCount, concurrency).narrow())
+		{
+			Array<AsyncHTTPTask> tasks;
+
+			for (size_t i = 0; i < RequestCount; ++i)
+			{
+				tasks << SimpleHTTP::LoadAsync(server.url(U"/bytes/16384"));
+			}
+
+			while (tasks.any([](const AsyncHTTPTask& task) { return task.isDownloading(); }))
+			{
+				System::Sleep(0ms);
+			}
+
+			return tasks.count_if([](const AsyncHTTPTask& task) { return task.isSucceeded(); });
+		};
+	}
+
+	Logger.enable();
+
+	SimpleHTTP::SetMaxConcurrency(maxConcurrency);
+}
+
+# endif
+
+# endif
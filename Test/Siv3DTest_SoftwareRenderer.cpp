@@ -0,0 +1,168 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+// SIV3D_SET(EngineOption::HeadlessRenderer::Software) を有効にした場合のみ実行される
+
+static bool IsSoftwareRenderer()
+{
+	return ((g_engineOptions.renderer == EngineOption::Renderer::Headless)
+		&& (g_engineOptions.headlessRenderer == EngineOption::HeadlessRenderer::Software));
+}
+
+static Image RenderToImage(const Size& size, const ColorF& background, const std::function<void(void)>& draw)
+{
+	const RenderTexture renderTexture{ size, background };
+	{
+		const ScopedRenderTarget2D target{ renderTexture };
+
+		draw();
+	}
+
+	Graphics2D::Flush();
+
+	Image image;
+	renderTexture.readAsImage(image);
+	return image;
+}
+
+TEST_CASE("SoftwareRenderer: Rect")
+{
+	if (not IsSoftwareRenderer())
+	{
+		return;
+	}
+
+	const Image image = RenderToImage(Size{ 16, 16 }, Palette::Black, []
+	{
+		Rect{ 4, 4, 8, 8 }.draw(Palette::Red);
+	});
+
+	REQUIRE(image.size() == Size{ 16, 16 });
+	REQUIRE(image[4][4] == Color{ 255, 0, 0 });
+	REQUIRE(image[11][11] == Color{ 255, 0, 0 });
+	REQUIRE(image[3][3] == Color{ 0, 0, 0 });
+	REQUIRE(image[12][12] == Color{ 0, 0, 0 });
+	REQUIRE(image[4][12] == Color{ 0, 0, 0 });
+}
+
+TEST_CASE("SoftwareRenderer: shared edges are filled once")
+{
+	if (not IsSoftwareRenderer())
+	{
+		return;
+	}
+
+	// 半透明の四角形 (2 つの三角形) を隣接して描き、すべてのピクセルがちょうど 1 回塗られることを確かめる
+	const Image image = RenderToImage(Size{ 32, 32 }, Palette::Black, []
+	{
+		for (int32 y = 0; y < 4; ++y)
+		{
+			for (int32 x = 0; x < 4; ++x)
+			{
+				RectF{ (x * 8.0), (y * 8.0), 8.0 }.draw(ColorF{ 1.0, 0.5 });
+			}
+		}
+
+		Triangle{ Vec2{ 0, 32 }, Vec2{ 0, 0 }, Vec2{ 32, 32 } }.draw(ColorF{ 0.0, 0.0, 1.0, 0.5 });
+		Triangle{ Vec2{ 0, 0 }, Vec2{ 32, 0 }, Vec2{ 32, 32 } }.draw(ColorF{ 0.0, 0.0, 1.0, 0.5 });
+	});
+
+	const Color expected = image[0][0];
+
+	REQUIRE(expected.r != 0);
+	REQUIRE(expected.b != 0);
+
+	for (const auto& pixel : image)
+	{
+		REQUIRE(pixel == expected);
+	}
+}
+
+TEST_CASE("SoftwareRenderer: Viewport and scissor")
+{
+	if (not IsSoftwareRenderer())
+	{
+		return;
+	}
+
+	const Image image = RenderToImage(Size{ 16, 16 }, Palette::Black, []
+	{
+		{
+			const ScopedViewport2D viewport{ Rect{ 8, 0, 8, 8 } };
+			Rect{ 0, 0, 16, 16 }.draw(Palette::Red);
+		}
+
+		{
+			Graphics2D::SetScissorRect(Rect{ 0, 8, 4, 4 });
+			const ScopedRenderStates2D rasterizer{ RasterizerState::SolidCullNoneScissor };
+			Rect{ 0, 0, 16, 16 }.draw(Palette::Blue);
+		}
+	});
+
+	REQUIRE(image[0][8] == Color{ 255, 0, 0 });
+	REQUIRE(image[7][15] == Color{ 255, 0, 0 });
+	REQUIRE(image[0][7] == Color{ 0, 0, 0 });
+	REQUIRE(image[8][8] == Color{ 0, 0, 0 });
+	REQUIRE(image[8][0] == Color{ 0, 0, 255 });
+	REQUIRE(image[11][3] == Color{ 0, 0, 255 });
+	REQUIRE(image[12][3] == Color{ 0, 0, 0 });
+	REQUIRE(image[8][4] == Color{ 0, 0, 0 });
+}
+
+TEST_CASE("SoftwareRenderer: Texture")
+{
+	if (not IsSoftwareRenderer())
+	{
+		return;
+	}
+
+	Image source{ 2, 2 };
+	source[0][0] = Color{ 255, 0, 0 };
+	source[0][1] = Color{ 0, 255, 0 };
+	source[1][0] = Color{ 0, 0, 255 };
+	source[1][1] = Color{ 255, 255, 255 };
+
+	const Texture texture{ source };
+
+	const Image image = RenderToImage(Size{ 8, 8 }, Palette::Black, [&]
+	{
+		const ScopedRenderStates2D sampler{ SamplerState::ClampNearest };
+		texture.scaled(4).draw();
+	});
+
+	REQUIRE(image[0][0] == Color{ 255, 0, 0 });
+	REQUIRE(image[3][3] == Color{ 255, 0, 0 });
+	REQUIRE(image[0][4] == Color{ 0, 255, 0 });
+	REQUIRE(image[7][0] == Color{ 0, 0, 255 });
+	REQUIRE(image[7][7] == Color{ 255, 255, 255 });
+}
+
+TEST_CASE("SoftwareRenderer: ScreenCapture")
+{
+	if (not IsSoftwareRenderer())
+	{
+		return;
+	}
+
+	Rect{ 0, 0, 10, 10 }.draw(Palette::Orange);
+
+	ScreenCapture::RequestCurrentFrame();
+
+	REQUIRE(System::Update());
+
+	const Image& image = ScreenCapture::GetFrame();
+
+	REQUIRE(image.size() == Scene::Size());
+	REQUIRE(image[0][0] == Color{ Palette::Orange });
+	REQUIRE(image[10][10] == Scene::GetBackground().toColor());
+}
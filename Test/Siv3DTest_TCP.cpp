@@ -0,0 +1,276 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+# if not SIV3D_PLATFORM(WEB)
+
+namespace
+{
+	constexpr uint16 TestPort = 50080;
+
+	bool Connect(TCPServer& server, TCPClient& client)
+	{
+		server.startAccept(TestPort);
+
+		client.connect(IPv4Address::Localhost(), TestPort);
+
+		return WaitUntil([&]() { return (client.isConnected() && server.hasSession()); });
+	}
+}
+
+TEST_CASE("TCPServer / TCPClient : loopback")
+{
+	TCPServer server;
+	TCPClient client;
+	REQUIRE(Connect(server, client));
+
+	// 受信バッファの初期容量 (64 KiB) を超えるデータを、半端なサイズに分けて送る
+	Array<uint8> data(300'000);
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<uint8>(i * 7);
+	}
+
+	for (size_t pos = 0; pos < data.size(); pos += 1'000)
+	{
+		REQUIRE(client.send(data.data() + pos, Min<size_t>(1'000, (data.size() - pos))));
+	}
+
+	REQUIRE(WaitUntil([&]() { return (data.size() <= server.available()); }));
+	REQUIRE(server.available() == data.size());
+
+	uint8 first = 0;
+	REQUIRE(server.lookahead(first));
+	REQUIRE(first == data[0]);
+
+	// 読み出しと受信を交互に行い、リングバッファの折り返しを経由させる
+	Array<uint8> received(data.size());
+	REQUIRE(server.read(received.data(), 100'000));
+	REQUIRE(server.skip(100'000));
+	REQUIRE(server.read(received.data() + 200'000, 100'000));
+	REQUIRE(server.available() == 0);
+	REQUIRE(std::equal(received.begin(), received.begin() + 100'000, data.begin()));
+	REQUIRE(std::equal(received.begin() + 200'000, received.end(), data.begin() + 200'000));
+
+	REQUIRE(not server.read(first));
+
+	// サーバからクライアントへ
+	REQUIRE(server.send(static_cast<const void*>(data.data()), data.size()));
+	REQUIRE(WaitUntil([&]() { return (data.size() <= client.available()); }));
+	REQUIRE(client.read(received.data(), received.size()));
+	REQUIRE(received == data);
+
+	client.disconnect();
+	server.disconnect();
+}
+
+TEST_CASE("TCPServer / TCPClient : framed messages")
+{
+	constexpr uint16 Port = (TestPort + 1);
+	constexpr size_t ClientCount = 3;
+	constexpr size_t MessageCount = 10;
+
+	TCPServer server{ 2 };
+	server.startAcceptMulti(Port);
+
+	Array<TCPClient> clients(ClientCount);
+
+	for (auto& client : clients)
+	{
+		client.connect(IPv4Address::Localhost(), Port);
+	}
+
+	REQUIRE(WaitUntil([&]() { return ((server.num_sessions() == ClientCount) && clients.all([](const TCPClient& c) { return c.isConnected(); })); }));
+
+	// メッセージの先頭バイトはクライアント番号, 2 バイト目は通し番号
+	for (size_t k = 0; k < MessageCount; ++k)
+	{
+		for (size_t i = 0; i < ClientCount; ++i)
+		{
+			Array<Byte> message((k * 10'000) + 2, Byte{ 0xCC });
+			message[0] = Byte(i);
+			message[1] = Byte(k);
+			REQUIRE(clients[i].sendMessage(message.data(), message.size()));
+		}
+	}
+
+	HashTable<TCPSessionID, size_t> sessionToClient;
+	Array<size_t> nextIndices(ClientCount, 0);
+	size_t receivedCount = 0;
+	Array<Byte> message;
+
+	REQUIRE(WaitUntil([&]()
+	{
+		TCPSessionID id;
+
+		while (server.tryReceiveAnyMessage(id, message))
+		{
+			const size_t i = static_cast<size_t>(message[0]);
+			const size_t k = nextIndices[i]++;
+
+			// 同じセッションのメッセージは送った順に届く
+			REQUIRE(static_cast<size_t>(message[1]) == k);
+			REQUIRE(message.size() == ((k * 10'000) + 2));
+			REQUIRE(message.back() == Byte{ 0xCC });
+
+			sessionToClient[id] = i;
+			++receivedCount;
+		}
+
+		return (receivedCount == (ClientCount * MessageCount));
+	}));
+
+	REQUIRE(sessionToClient.size() == ClientCount);
+	{
+		TCPSessionID id;
+		REQUIRE(not server.tryReceiveAnyMessage(id, message));
+	}
+
+	// 返信
+	for (const auto& [id, i] : sessionToClient)
+	{
+		const uint64 value = (i * 100);
+		REQUIRE(server.sendMessage(&value, sizeof(value), id));
+	}
+
+	for (size_t i = 0; i < ClientCount; ++i)
+	{
+		REQUIRE(WaitUntil([&]() { return clients[i].tryReceiveMessage(message); }));
+		REQUIRE(message.size() == sizeof(uint64));
+
+		uint64 value;
+		std::memcpy(&value, message.data(), sizeof(value));
+		REQUIRE(value == (i * 100));
+	}
+
+	for (auto& client : clients)
+	{
+		client.disconnect();
+	}
+
+	REQUIRE(WaitUntil([&]() { return (not server.hasSession()); }));
+
+	server.disconnect();
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("TCPServer / TCPClient : loopback throughput")
+{
+	TCPServer server;
+	TCPClient client;
+	REQUIRE(Connect(server, client));
+
+	Logger.disable();
+
+	for (const size_t messageSize : { 16, 256, 4096 })
+	{
+		constexpr size_t TotalSize = (64 * 1024 * 1024);
+		const Array<Byte> message(messageSize);
+		Array<Byte> received(messageSize);
+
+		BENCHMARK(U"client -> server | {} bytes / message"_fmt(messageSize).narrow())
+		{
+			size_t readSize = 0;
+
+			for (size_t sent = 0; sent < TotalSize; sent += messageSize)
+			{
+				client.send(message.data(), message.size());
+
+				while (server.read(received.data(), received.size()))
+				{
+					readSize += messageSize;
+				}
+			}
+
+			while (readSize < TotalSize)
+			{
+				if (server.read(received.data(), received.size()))
+				{
+					readSize += messageSize;
+				}
+			}
+
+			return readSize;
+		};
+	}
+
+	Logger.enable();
+
+	client.disconnect();
+	server.disconnect();
+}
+
+TEST_CASE("TCPServer : framed message stress")
+{
+	constexpr uint16 Port = (TestPort + 2);
+	constexpr size_t ClientCount = 64;
+	constexpr size_t MessageCountPerClient = 2'000;
+	constexpr size_t MessageSize = 64;
+
+	Logger.disable();
+
+	for (const size_t ioThreadCount : { 1, 4 })
+	{
+		TCPServer server{ ioThreadCount };
+		server.startAcceptMulti(Port);
+
+		Array<TCPClient> clients(ClientCount);
+
+		for (auto& client : clients)
+		{
+			client.connect(IPv4Address::Localhost(), Port);
+		}
+
+		REQUIRE(WaitUntil([&]() { return ((server.num_sessions() == ClientCount) && clients.all([](const TCPClient& c) { return c.isConnected(); })); }, 10s));
+
+		const Array<Byte> message(MessageSize);
+
+		BENCHMARK(U"{} clients x {} messages | {} I/O threads"_fmt(ClientCount, MessageCountPerClient, ioThreadCount).narrow())
+		{
+			for (size_t k = 0; k < MessageCountPerClient; ++k)
+			{
+				for (auto& client : clients)
+				{
+					client.sendMessage(message.data(), message.size());
+				}
+			}
+
+			TCPSessionID id;
+			Array<Byte> received;
+			size_t receivedCount = 0;
+
+			while (receivedCount < (ClientCount * MessageCountPerClient))
+			{
+				if (server.tryReceiveAnyMessage(id, received))
+				{
+					++receivedCount;
+				}
+			}
+
+			return receivedCount;
+		};
+
+		for (auto& client : clients)
+		{
+			client.disconnect();
+		}
+
+		server.disconnect();
+	}
+
+	Logger.enable();
+}
+
+# endif
+
+# endif
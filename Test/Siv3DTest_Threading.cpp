@@ -0,0 +1,137 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("Threading::TaskGroup")
+{
+	SECTION("run() and wait()")
+	{
+		std::atomic<int32> count = 0;
+
+		Threading::TaskGroup group;
+
+		for (int32 i = 0; i < 100; ++i)
+		{
+			group.run([&count]() { ++count; });
+		}
+
+		group.wait();
+
+		REQUIRE(group.isDone());
+		REQUIRE(count == 100);
+	}
+
+	SECTION("exception")
+	{
+		Threading::TaskGroup group;
+
+		group.run([]() { throw std::runtime_error{ "TaskGroup" }; });
+
+		REQUIRE_THROWS_AS(group.wait(), std::runtime_error);
+	}
+
+	SECTION("destroyed without wait()")
+	{
+		// デストラクタは、最後のタスクが TaskGroup に触れ終えるまで待つ
+		std::atomic<int32> count = 0;
+
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			Threading::TaskGroup group;
+
+			group.run([&count]() { ++count; });
+		}
+
+		REQUIRE(count == 1000);
+	}
+}
+
+TEST_CASE("Threading::ParallelFor")
+{
+	SECTION("index")
+	{
+		Array<int32> v(10000);
+
+		Threading::ParallelFor(0, v.size(), [&v](size_t i) { v[i] = static_cast<int32>(i); });
+
+		REQUIRE(v == Iota(10000).asArray());
+	}
+
+	SECTION("range")
+	{
+		std::atomic<size_t> count = 0;
+
+		Threading::ParallelFor(100, 1100, [&count](size_t first, size_t last) { count += (last - first); });
+
+		REQUIRE(count == 1000);
+	}
+
+	SECTION("nested")
+	{
+		std::atomic<size_t> count = 0;
+
+		Threading::ParallelFor(0, 16, [&count](size_t)
+		{
+			Threading::ParallelFor(0, 64, [&count](size_t) { ++count; }, 1);
+		}, 1);
+
+		REQUIRE(count == (16 * 64));
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Threading::TaskGroup : benchmark")
+{
+	const size_t numThreads = Threading::GetConcurrency();
+
+	BENCHMARK("std::async() | per-call overhead")
+	{
+		Array<std::future<void>> futures;
+
+		for (size_t i = 0; i < numThreads; ++i)
+		{
+			futures.push_back(std::async(std::launch::async, []() {}));
+		}
+
+		for (auto& future : futures)
+		{
+			future.get();
+		}
+	};
+
+	BENCHMARK("Threading::TaskGroup | per-call overhead")
+	{
+		Threading::TaskGroup group;
+
+		for (size_t i = 0; i < numThreads; ++i)
+		{
+			group.run([]() {});
+		}
+
+		group.wait();
+	};
+
+	{
+		Array<double> v(64 * 1024);
+
+		BENCHMARK("Array::parallel_each() | 64K x 3")
+		{
+			for (int32 i = 0; i < 3; ++i)
+			{
+				v.parallel_each([](double& x) { x += 1.0; });
+			}
+		};
+	}
+}
+
+# endif
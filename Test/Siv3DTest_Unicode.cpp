@@ -51,4 +51,78 @@ TEST_CASE("Unicode")
 		REQUIRE(Unicode::ToUTF32(U"OpenSiv3D") == U"OpenSiv3D");
 		REQUIRE(Unicode::ToUTF32(U"あいうえお") == U"あいうえお");
 	}
+
+	SECTION("FromUTF8 / ToUTF8 (long mixed text)")
+	{
+		String text;
+
+		for (int32 i = 0; i < 8; ++i)
+		{
+			text.append(U"OpenSiv3D は C++20 で書かれた Café のための Привет 🎉✨ ライブラリです。\n");
+		}
+
+		const std::string utf8 = Unicode::ToUTF8(text);
+		REQUIRE(Unicode::FromUTF8(utf8) == text);
+		REQUIRE(Unicode::UTF8ToUTF32(utf8) == text.toUTF32());
+		REQUIRE(Unicode::UTF32ToUTF8(text.toUTF32()) == utf8);
+		REQUIRE(Unicode::FromUTF16(Unicode::ToUTF16(text)) == text);
+	}
+
+	SECTION("FromUTF8 (invalid sequences)")
+	{
+		// 不正なバイト列は 1 バイトごとに U+FFFD になる
+		const std::string invalid = "0123456789abcdef\xC0\x80\xE0\x80\x80\xE3\x81\xF0\x9F\x98\xF5\x80\x80\x80\xBF\xE3\x81\x82";
+		REQUIRE(Unicode::FromUTF8(invalid) == U"0123456789abcdef\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\uFFFDあ");
+		REQUIRE(Unicode::FromUTF16(u"abcdefgh\xD800ijklmnop") == U"abcdefgh\uFFFDijklmnop");
+
+		std::string replacements;
+
+		for (int32 i = 0; i < 20; ++i)
+		{
+			replacements.append("\xEF\xBF\xBD");
+		}
+
+		REQUIRE(Unicode::ToUTF8(String(20, char32(0x110000))) == replacements);
+	}
 }
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Unicode : benchmark")
+{
+	// 各 1 MiB のテキスト（スループット = 1 MiB / 平均時間）
+	const auto makeText = [](const StringView piece)
+	{
+		const std::string utf8 = Unicode::ToUTF8(piece);
+		std::string text;
+
+		while (text.size() < (1024 * 1024))
+		{
+			text.append(utf8);
+		}
+
+		return text;
+	};
+
+	const std::string ascii = makeText(U"{ \"name\": \"OpenSiv3D\", \"version\": 6 },\n");
+	const std::string latin = makeText(U"Ça déjà naïve Привет мир, ");
+	const std::string cjk = makeText(U"吾輩は猫である。名前はまだ無い。\n");
+	const std::string emoji = makeText(U"🎉✨ good 😀👍\n");
+
+	BENCHMARK("Unicode::FromUTF8() | ASCII 1 MiB") { return Unicode::FromUTF8(ascii); };
+	BENCHMARK("Unicode::FromUTF8() | Latin 1 MiB") { return Unicode::FromUTF8(latin); };
+	BENCHMARK("Unicode::FromUTF8() | CJK 1 MiB") { return Unicode::FromUTF8(cjk); };
+	BENCHMARK("Unicode::FromUTF8() | Emoji 1 MiB") { return Unicode::FromUTF8(emoji); };
+
+	const String asciiText = Unicode::FromUTF8(ascii);
+	const String latinText = Unicode::FromUTF8(latin);
+	const String cjkText = Unicode::FromUTF8(cjk);
+	const String emojiText = Unicode::FromUTF8(emoji);
+
+	BENCHMARK("Unicode::ToUTF8() | ASCII 1 MiB") { return Unicode::ToUTF8(asciiText); };
+	BENCHMARK("Unicode::ToUTF8() | Latin 1 MiB") { return Unicode::ToUTF8(latinText); };
+	BENCHMARK("Unicode::ToUTF8() | CJK 1 MiB") { return Unicode::ToUTF8(cjkText); };
+	BENCHMARK("Unicode::ToUTF8() | Emoji 1 MiB") { return Unicode::ToUTF8(emojiText); };
+}
+
+# endif
@@ -0,0 +1,284 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/Renderer2D/Vertex2DBuilder.hpp>
+
+namespace
+{
+	/// @brief 描画バッチの代わりに、あらかじめ確保した配列に頂点とインデックスを書き込むバッファ
+	struct RecordingBuffer
+	{
+		Array<Vertex2D> vertices;
+
+		Array<Vertex2D::IndexType> indices;
+
+		size_t vertexPos = 0;
+
+		size_t indexPos = 0;
+
+		RecordingBuffer(const size_t maxVertices, const size_t maxIndices)
+			: vertices(maxVertices)
+			, indices(maxIndices) {}
+
+		void reset() noexcept
+		{
+			vertexPos = 0;
+			indexPos = 0;
+		}
+
+		[[nodiscard]]
+		Vertex2DBufferPointer request(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize) noexcept
+		{
+			if ((vertices.size() < (vertexPos + vertexSize))
+				|| (indices.size() < (indexPos + indexSize)))
+			{
+				return{ nullptr, nullptr, 0 };
+			}
+
+			const Vertex2DBufferPointer result{ (vertices.data() + vertexPos), (indices.data() + indexPos), static_cast<Vertex2D::IndexType>(vertexPos) };
+			vertexPos += vertexSize;
+			indexPos += indexSize;
+			return result;
+		}
+	};
+
+	struct RecordingBufferCreator
+	{
+		RecordingBuffer* pBuffer = nullptr;
+
+		[[nodiscard]]
+		Vertex2DBufferPointer operator ()(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize) const noexcept
+		{
+			return pBuffer->request(vertexSize, indexSize);
+		}
+	};
+}
+
+TEST_CASE("Vertex2DBuilder")
+{
+	RecordingBuffer buffer{ 8, 12 };
+	const RecordingBufferCreator creator{ &buffer };
+	const FloatRect rect{ 10.0f, 20.0f, 30.0f, 40.0f };
+	const Float4 color{ 1.0f, 0.5f, 0.25f, 1.0f };
+
+	SECTION("BuildRect() with a direct creator")
+	{
+		REQUIRE(Vertex2DBuilder::BuildRect(creator, rect, color) == 6);
+		REQUIRE(Vertex2DBuilder::BuildRect(creator, rect, color) == 6);
+
+		REQUIRE(buffer.vertices[0].pos == Float2{ 10.0f, 20.0f });
+		REQUIRE(buffer.vertices[3].pos == Float2{ 30.0f, 40.0f });
+		REQUIRE(buffer.vertices[3].color == color);
+		REQUIRE(buffer.indices[5] == 3);
+		REQUIRE(buffer.indices[6] == 4);
+		REQUIRE(buffer.indices[11] == 7);
+
+		// バッファが足りない場合は何も書き込まない
+		REQUIRE(Vertex2DBuilder::BuildRect(creator, rect, color) == 0);
+	}
+
+	SECTION("BufferCreatorFunc forwards to the referenced creator")
+	{
+		const BufferCreatorFunc bufferCreator{ creator };
+
+		REQUIRE(Vertex2DBuilder::BuildTriangle(bufferCreator, { Float2{ 0, 0 }, Float2{ 1, 0 }, Float2{ 0, 1 } }, color) == 3);
+		REQUIRE(Vertex2DBuilder::BuildRect(bufferCreator, rect, color) == 6);
+
+		REQUIRE(buffer.vertexPos == 7);
+		REQUIRE(buffer.indexPos == 9);
+		REQUIRE(buffer.indices[3] == 3);
+	}
+}
+
+TEST_CASE("Vertex2DBuilder : bulk")
+{
+	constexpr size_t N = 7;
+
+	Array<RectF> rects;
+	Array<ColorF> colors;
+
+	for (size_t i = 0; i < N; ++i)
+	{
+		rects << RectF{ (i * 10.0), (i * 5.0), 8.0, 4.0 };
+		colors << ColorF{ (i / 10.0), 0.5, 0.25, 1.0 };
+	}
+
+	RecordingBuffer expected{ (N * 4), (N * 6) };
+	RecordingBuffer actual{ (N * 4), (N * 6) };
+
+	SECTION("BuildRects() matches BuildRect()")
+	{
+		for (size_t i = 0; i < N; ++i)
+		{
+			REQUIRE(Vertex2DBuilder::BuildRect(RecordingBufferCreator{ &expected }, FloatRect{ rects[i].x, rects[i].y, (rects[i].x + rects[i].w), (rects[i].y + rects[i].h) }, colors[i].toFloat4()) == 6);
+		}
+
+		const RecordingBufferCreator creator{ &actual };
+		REQUIRE(Vertex2DBuilder::BuildRects(BufferCreatorFunc{ creator }, rects.data(), colors.data(), N, Float4{ 1, 1, 1, 1 }) == (N * 6));
+
+		for (size_t i = 0; i < (N * 4); ++i)
+		{
+			REQUIRE(actual.vertices[i].pos == expected.vertices[i].pos);
+			REQUIRE(actual.vertices[i].color == expected.vertices[i].color);
+		}
+
+		REQUIRE(actual.indices == expected.indices);
+	}
+
+	SECTION("BuildTexturedQuads() matches BuildTexturedQuad()")
+	{
+		const FloatRect rect{ 0.0f, 0.0f, 16.0f, 8.0f };
+		const FloatRect uv{ 0.25f, 0.0f, 0.5f, 1.0f };
+		Array<Mat3x2> transforms;
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			transforms << (Mat3x2::Rotate(i * 0.5) * Mat3x2::Translate((i * 3.0), 20.0));
+
+			const FloatQuad quad{
+				transforms[i].transformPoint(Vec2{ rect.left, rect.top }),
+				transforms[i].transformPoint(Vec2{ rect.right, rect.top }),
+				transforms[i].transformPoint(Vec2{ rect.right, rect.bottom }),
+				transforms[i].transformPoint(Vec2{ rect.left, rect.bottom }) };
+
+			REQUIRE(Vertex2DBuilder::BuildTexturedQuad(RecordingBufferCreator{ &expected }, quad, uv, colors[i].toFloat4()) == 6);
+		}
+
+		const RecordingBufferCreator creator{ &actual };
+		REQUIRE(Vertex2DBuilder::BuildTexturedQuads(BufferCreatorFunc{ creator }, rect, uv, transforms.data(), colors.data(), N, Float4{ 1, 1, 1, 1 }) == (N * 6));
+
+		for (size_t i = 0; i < (N * 4); ++i)
+		{
+			REQUIRE(actual.vertices[i].pos.x == Approx(expected.vertices[i].pos.x).margin(1e-4));
+			REQUIRE(actual.vertices[i].pos.y == Approx(expected.vertices[i].pos.y).margin(1e-4));
+			REQUIRE(actual.vertices[i].tex == expected.vertices[i].tex);
+			REQUIRE(actual.vertices[i].color == expected.vertices[i].color);
+		}
+
+		REQUIRE(actual.indices == expected.indices);
+	}
+
+	SECTION("BuildCircles() stops at the buffer request limit")
+	{
+		RecordingBuffer buffer{ (Vertex2DBuilder::MaxBulkQuadCount * 4), (Vertex2DBuilder::MaxBulkQuadCount * 6) };
+		const RecordingBufferCreator creator{ &buffer };
+		const Array<Circle> circles(1000, Circle{ 0, 0, 1000 });
+
+		size_t builtCount = 0;
+		const auto indexCount = Vertex2DBuilder::BuildCircles(BufferCreatorFunc{ creator }, circles.data(), nullptr, circles.size(), Float4{ 1, 1, 1, 1 }, 1.0f, builtCount);
+
+		REQUIRE(0 < builtCount);
+		REQUIRE(builtCount < circles.size());
+		REQUIRE(indexCount == buffer.indexPos);
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Vertex2DBuilder : benchmark")
+{
+	constexpr size_t N = 50'000;
+
+	RecordingBuffer buffer{ (N * 4), (N * 6) };
+	const RecordingBufferCreator creator{ &buffer };
+	const Float4 color{ 1.0f, 1.0f, 1.0f, 1.0f };
+
+	Array<FloatRect> rects(N);
+
+	for (size_t i = 0; i < N; ++i)
+	{
+		const float x = static_cast<float>(i % 256);
+		const float y = static_cast<float>(i / 256);
+		rects[i] = FloatRect{ x, y, (x + 4.0f), (y + 4.0f) };
+	}
+
+	// 1 回あたりの時間 [ms] / N = 1 矩形あたりの頂点生成コスト
+	{
+		const std::function<Vertex2DBufferPointer(Vertex2D::IndexType, Vertex2D::IndexType)> bufferCreator = creator;
+
+		BENCHMARK("std::function | 50K rects")
+		{
+			buffer.reset();
+
+			Vertex2D::IndexType indexCount = 0;
+
+			for (const auto& rect : rects)
+			{
+				indexCount += Vertex2DBuilder::BuildRect(bufferCreator, rect, color);
+			}
+
+			return indexCount;
+		};
+	}
+
+	{
+		const BufferCreatorFunc bufferCreator{ creator };
+
+		BENCHMARK("BufferCreatorFunc | 50K rects")
+		{
+			buffer.reset();
+
+			Vertex2D::IndexType indexCount = 0;
+
+			for (const auto& rect : rects)
+			{
+				indexCount += Vertex2DBuilder::BuildRect(bufferCreator, rect, color);
+			}
+
+			return indexCount;
+		};
+	}
+
+	{
+		Array<RectF> rectFs(N);
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			rectFs[i] = RectF{ rects[i].left, rects[i].top, (rects[i].right - rects[i].left), (rects[i].bottom - rects[i].top) };
+		}
+
+		const BufferCreatorFunc bufferCreator{ creator };
+
+		BENCHMARK("BuildRects (bulk) | 50K rects")
+		{
+			buffer.reset();
+
+			size_t indexCount = 0;
+
+			for (size_t i = 0; i < N; i += Vertex2DBuilder::MaxBulkQuadCount)
+			{
+				const size_t n = Min((N - i), Vertex2DBuilder::MaxBulkQuadCount);
+				indexCount += Vertex2DBuilder::BuildRects(bufferCreator, (rectFs.data() + i), nullptr, n, color);
+			}
+
+			return indexCount;
+		};
+	}
+
+	{
+		BENCHMARK("direct | 50K rects")
+		{
+			buffer.reset();
+
+			Vertex2D::IndexType indexCount = 0;
+
+			for (const auto& rect : rects)
+			{
+				indexCount += Vertex2DBuilder::BuildRect(creator, rect, color);
+			}
+
+			return indexCount;
+		};
+	}
+}
+
+# endif